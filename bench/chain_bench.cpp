@@ -0,0 +1,328 @@
+/**
+ * @file chain_bench.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief End to end benchmarks of representative chains
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Micro benchmarks measure each module on its own,
+ * and miss the cost of the framework that ties them together:
+ * meta_process() recursion, buffers moving through the pool,
+ * and ModuleParam side chains.
+ * These benchmarks build chains that resemble real patches,
+ * and render them block by block like a sink would.
+ *
+ * Real-time performance is decided by the slowest blocks, not the average,
+ * so each block is timed on its own and the distribution is reported
+ * through the p50_us, p99_us and max_us counters.
+ * The budget_us counter is the duration of audio in each block,
+ * any block that takes longer would miss its deadline.
+ * The argument of each benchmark is the buffer size.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "amp_module.hpp"
+#include "chrono.hpp"
+#include "envelope.hpp"
+#include "filter_module.hpp"
+#include "fund_oscillator.hpp"
+#include "io/mstream.hpp"
+#include "io/wav.hpp"
+#include "module_mixer.hpp"
+#include "resample_module.hpp"
+#include "sink_module.hpp"
+#include "voice.hpp"
+
+namespace {
+
+/// Number of blocks to render in each benchmark
+constexpr int BLOCKS = 4096;
+
+/// Sample rate of the chains we render
+constexpr double RATE = 48000;
+
+/**
+ * @brief Renders a chain and reports the distribution of block times
+ *
+ * We start the chain and render a few blocks to settle it,
+ * then time each block with get_time().
+ *
+ * @param state Benchmark state
+ * @param sink Sink at the front of the chain, configured and bound
+ * @param ready Called once the chain is started, such as to play notes
+ */
+void run_chain(benchmark::State& state, SinkModule& sink, const std::function<void()>& ready = nullptr) {
+
+    const auto size = static_cast<int>(state.range(0));
+
+    std::vector<int64_t> times;
+
+    times.reserve(BLOCKS);
+
+    sink.meta_info_sync();
+    sink.meta_start();
+
+    if (ready) {
+
+        ready();
+    }
+
+    // Settle the chain, so the pool is full and the IIRs are warm:
+
+    for (int i = 0; i < 16; ++i) {
+
+        sink.meta_process();
+    }
+
+    for (auto _ : state) {
+
+        const int64_t start = get_time();
+
+        sink.meta_process();
+
+        times.push_back(get_time() - start);
+
+        benchmark::DoNotOptimize(sink.get_buffer()->data());
+    }
+
+    sink.meta_stop();
+
+    // Report the distribution:
+
+    std::ranges::sort(times);
+
+    const auto rank = [&times](double frac) { return static_cast<double>(times[static_cast<std::size_t>(frac * static_cast<double>(times.size() - 1))]) / 1000; };
+
+    state.counters["p50_us"] = rank(0.5);
+    state.counters["p99_us"] = rank(0.99);
+    state.counters["max_us"] = rank(1);
+    state.counters["budget_us"] = size * 1e6 / RATE;
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * size);
+}
+
+/**
+ * @brief Configures a sink for a benchmark
+ *
+ * @param state Benchmark state
+ * @param sink Sink to configure
+ */
+void conf_sink(benchmark::State& state, SinkModule& sink) {
+
+    sink.get_chain_info()->buffer_size = static_cast<int>(state.range(0));
+    sink.get_chain_info()->sample_rate = RATE;
+}
+
+/**
+ * @brief A voice of a subtractive synth
+ *
+ * A sawtooth runs through a resonant lowpass,
+ * whose cutoff is swept by an ADSR envelope through a ModuleParam:
+ *
+ * saw -> filter -> level
+ *          ^
+ *  adsr -> depth -> base
+ */
+struct SynthVoice {
+
+    /// Oscillator of the voice
+    SawtoothOscillator osc;
+
+    /// Lowpass swept by the envelope
+    ModulatedFilter filter{FilterType::LowPass, 200, 4};
+
+    /// Envelope sweeping the filter
+    ADSREnvelope env{NANO / 100, NANO / 5, 0.4, NANO / 4};
+
+    /// Scales the envelope to a sweep in hertz
+    AmplitudeScale depth{4000};
+
+    /// Lowest cutoff in hertz
+    AmplitudeAdd base{200};
+
+    /// Level of the voice
+    AmplitudeScale level{1.0 / 64};
+
+    SynthVoice() {
+
+        this->depth.bind(&this->env);
+        this->base.bind(&this->depth);
+        this->filter.get_cutoff()->bind(&this->base);
+
+        this->filter.bind(&this->osc);
+        this->level.bind(&this->filter);
+    }
+};
+
+/**
+ * @brief Benchmarks a 64 voice subtractive synth with every voice held
+ *
+ * @param state Benchmark state
+ */
+void BM_SubtractiveSynth(benchmark::State& state) {
+
+    auto voices = std::make_unique<std::array<SynthVoice, 64>>();
+
+    VoiceManager manager;
+
+    for (auto& voice : *voices) {
+
+        manager.add_voice(&voice.level, &voice.env);
+    }
+
+    manager.set_trigger([&voices](Voice& voice, int note, double) {
+
+        for (auto& synth : *voices) {
+
+            if (&synth.level == voice.output) {
+
+                synth.osc.set_frequency(440 * std::pow(2.0, (note - 69) / 12.0));
+            }
+        }
+    });
+
+    SinkModule sink;
+
+    conf_sink(state, sink);
+    sink.bind(&manager);
+
+    run_chain(state, sink, [&manager]() {
+
+        for (int i = 0; i < 64; ++i) {
+
+            manager.note_on(36 + i);
+        }
+    });
+}
+
+/**
+ * @brief A channel of a mixing bus
+ *
+ * saw -> eq -> fader
+ */
+struct BusChannel {
+
+    /// Source of the channel
+    SawtoothOscillator osc;
+
+    /// Channel EQ
+    BiquadFilter eq{FilterType::HighPass, 80, 0, 2};
+
+    /// Channel fader
+    AmplitudeScale fader{1.0 / 32};
+
+    /**
+     * @brief Attaches this channel to a mixer
+     *
+     * @param mix Mixer to attach to
+     */
+    void attach(ModuleMixDown& mix) {
+
+        mix.bind(&this->fader);
+
+        this->fader.bind(&this->eq);
+        this->eq.bind(&this->osc);
+    }
+};
+
+/**
+ * @brief Benchmarks a 32 channel mixing bus
+ *
+ * Each channel is mixed down, and the sum runs through a master EQ.
+ *
+ * @param state Benchmark state
+ */
+void BM_MixingBus(benchmark::State& state) {
+
+    auto channels = std::make_unique<std::array<BusChannel, 32>>();
+
+    ModuleMixDown mix;
+    BiquadFilter master(FilterType::LowPass, 16000, 0, 4);
+    SinkModule sink;
+
+    conf_sink(state, sink);
+
+    sink.bind(&master);
+    master.bind(&mix);
+
+    for (std::size_t i = 0; i < channels->size(); ++i) {
+
+        (*channels)[i].osc.set_frequency(55.0 * static_cast<double>(i + 1));
+        (*channels)[i].attach(mix);
+    }
+
+    run_chain(state, sink);
+}
+
+/**
+ * @brief Benchmarks playing back a sample with resampling and filtering
+ *
+ * A 44.1 kHz wave is decoded, resampled to 48 kHz and lowpassed:
+ *
+ * wave -> resample -> filter
+ *
+ * The wave is long enough that we never run out of audio.
+ *
+ * @param state Benchmark state
+ */
+void BM_SamplePlayback(benchmark::State& state) {
+
+    const auto size = static_cast<int>(state.range(0));
+    const auto frames = static_cast<int>((BLOCKS + 64) * static_cast<double>(size) * SAMPLE_RATE / RATE);
+
+    // Write the sample:
+
+    CharOStream ostream;
+    WaveWriter writer(&ostream);
+
+    writer.set_bits_per_sample(16);
+    writer.set_channels(1);
+    writer.set_samplerate(SAMPLE_RATE);
+
+    writer.start();
+
+    auto data = std::make_unique<AudioBuffer>(frames, 1);
+
+    for (int i = 0; i < frames; ++i) {
+
+        data->at(0, i) = static_cast<sample_t>(0.5 * std::sin(2 * M_PI * 220 * i / SAMPLE_RATE));
+    }
+
+    writer.write_data(std::move(data));
+    writer.stop();
+
+    // Build the chain:
+
+    CharIStream istream;
+
+    istream.get_array() = ostream.get_array();
+
+    WaveSource source(&istream);
+    ResampleModule resamp;
+    BiquadFilter filter(FilterType::LowPass, 8000, 0, 2);
+    SinkModule sink;
+
+    conf_sink(state, sink);
+
+    sink.bind(&filter);
+    filter.bind(&resamp);
+    resamp.bind(&source);
+
+    run_chain(state, sink);
+}
+
+}  // namespace
+
+BENCHMARK(BM_SubtractiveSynth)->RangeMultiplier(2)->Range(32, 256)->Iterations(BLOCKS);
+BENCHMARK(BM_MixingBus)->RangeMultiplier(2)->Range(32, 256)->Iterations(BLOCKS);
+BENCHMARK(BM_SamplePlayback)->RangeMultiplier(2)->Range(32, 256)->Iterations(BLOCKS);
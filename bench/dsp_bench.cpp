@@ -0,0 +1,212 @@
+/**
+ * @file dsp_bench.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Benchmarks for DSP kernels
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * These benchmarks measure the raw DSP kernels,
+ * across a range of sizes and sample types.
+ * Throughput is reported in items (samples) per second.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <complex>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "dsp/conv.hpp"
+#include "dsp/ft.hpp"
+#include "dsp/iir.hpp"
+#include "dsp/matrix.hpp"
+
+namespace {
+
+/**
+ * @brief Generates random values between -1 and 1
+ *
+ * We use a fixed seed, so every run measures the same data.
+ *
+ * @tparam T Type of value to generate
+ * @param size Number of values to generate
+ * @return std::vector<T> Random values
+ */
+template <typename T>
+std::vector<T> random_values(std::size_t size) {
+
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<double> dist(-1, 1);
+
+    std::vector<T> out(size);
+
+    for (auto& val : out) {
+
+        val = static_cast<T>(dist(gen));
+    }
+
+    return out;
+}
+
+/**
+ * @brief Benchmarks input side convolution
+ *
+ * The first argument is the input size,
+ * the second is the kernel size.
+ *
+ * @tparam T Type of sample to work with
+ * @param state Benchmark state
+ */
+template <typename T>
+void BM_InputConv(benchmark::State& state) {
+
+    const auto size = static_cast<std::size_t>(state.range(0));
+    const auto ksize = static_cast<std::size_t>(state.range(1));
+
+    const auto input = random_values<T>(size);
+    const auto kernel = random_values<T>(ksize);
+
+    std::vector<T> output(size + ksize - 1);
+
+    for (auto _ : state) {
+
+        input_conv(input.begin(), size, kernel.begin(), ksize, output.begin());
+
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(size));
+}
+
+/**
+ * @brief Benchmarks the recursive radix 2 FFT
+ *
+ * The argument is the transform size.
+ *
+ * @tparam T Type of sample to work with
+ * @param state Benchmark state
+ */
+template <typename T>
+void BM_FFTRadix2(benchmark::State& state) {
+
+    const auto size = static_cast<int>(state.range(0));
+
+    const auto values = random_values<T>(size);
+
+    std::vector<std::complex<T>> input(values.begin(), values.end());
+    std::vector<std::complex<T>> output(size);
+
+    for (auto _ : state) {
+
+        fft_c_radix2(input.begin(), size, output.begin());
+
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * size);
+}
+
+/**
+ * @brief Benchmarks the direct form IIR recursion
+ *
+ * The argument is the number of poles.
+ *
+ * @tparam T Type of sample to work with
+ * @param state Benchmark state
+ */
+template <typename T>
+void BM_IIRRecursiveSingle(benchmark::State& state) {
+
+    const auto poles = static_cast<int>(state.range(0));
+    const int size = 1024;
+
+    const auto input = random_values<T>(size);
+    auto aco = random_values<T>(poles);
+
+    // Keep the feedback small, so the filter stays stable:
+
+    auto bco = random_values<T>(poles);
+
+    for (auto& val : bco) {
+
+        val /= static_cast<T>(4 * poles);
+    }
+
+    std::deque<T> inputs(poles, 0);
+    std::deque<T> outputs(poles, 0);
+
+    for (auto _ : state) {
+
+        T total = 0;
+
+        for (int i = 0; i < size; ++i) {
+
+            total += iir_recursive_single(input[i], inputs, outputs, aco.begin(), bco.begin(), poles, poles);
+        }
+
+        benchmark::DoNotOptimize(total);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * size);
+}
+
+/**
+ * @brief Benchmarks applying a channel matrix to a block
+ *
+ * This is the shape of a routing, downmix or ambisonic decoding matrix,
+ * a square matrix of gains applied to every frame of a block.
+ * The first argument is the number of channels,
+ * the second is the number of samples in each channel.
+ *
+ * @tparam T Type of sample to work with
+ * @tparam L Layout of the buffers
+ * @param state Benchmark state
+ */
+template <typename T, typename L>
+void BM_ChannelMatrix(benchmark::State& state) {
+
+    const auto channels = static_cast<int>(state.range(0));
+    const auto size = static_cast<int>(state.range(1));
+
+    Buffer<T, L> gains(random_values<T>(static_cast<std::size_t>(channels) * channels), channels);
+    Buffer<T, L> input(random_values<T>(static_cast<std::size_t>(channels) * size), channels);
+    Buffer<T, L> output(size, channels);
+
+    const MatrixView<const T> gview = matrix_view(gains);
+    const MatrixView<const T> iview = matrix_view(input);
+    const auto oview = matrix_view(output);
+
+    for (auto _ : state) {
+
+        gemm(oview, gview, iview);
+
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * channels * size);
+}
+
+}  // namespace
+
+BENCHMARK(BM_InputConv<float>)->ArgsProduct({{256, 4096}, {8, 64, 512}});
+BENCHMARK(BM_InputConv<double>)->ArgsProduct({{256, 4096}, {8, 64, 512}});
+BENCHMARK(BM_InputConv<long double>)->ArgsProduct({{256, 4096}, {8, 64, 512}});
+
+BENCHMARK(BM_FFTRadix2<float>)->RangeMultiplier(4)->Range(64, 16384);
+BENCHMARK(BM_FFTRadix2<double>)->RangeMultiplier(4)->Range(64, 16384);
+BENCHMARK(BM_FFTRadix2<long double>)->RangeMultiplier(4)->Range(64, 16384);
+
+BENCHMARK(BM_IIRRecursiveSingle<float>)->Arg(2)->Arg(4)->Arg(8);
+BENCHMARK(BM_IIRRecursiveSingle<double>)->Arg(2)->Arg(4)->Arg(8);
+BENCHMARK(BM_IIRRecursiveSingle<long double>)->Arg(2)->Arg(4)->Arg(8);
+
+BENCHMARK(BM_ChannelMatrix<float, Interleaved>)->ArgsProduct({{16, 64}, {256, 1024}});
+BENCHMARK(BM_ChannelMatrix<float, Planar>)->ArgsProduct({{16, 64}, {256, 1024}});
+BENCHMARK(BM_ChannelMatrix<double, Interleaved>)->ArgsProduct({{16, 64}, {256, 1024}});
+BENCHMARK(BM_ChannelMatrix<double, Planar>)->ArgsProduct({{16, 64}, {256, 1024}});
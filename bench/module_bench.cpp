@@ -0,0 +1,268 @@
+/**
+ * @file module_bench.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Benchmarks for modules
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * These benchmarks measure modules as they would run in a chain,
+ * processed by a sink that shares a buffer pool with them,
+ * so the numbers reflect steady state processing rather than allocations.
+ * The argument of each benchmark is the buffer size.
+ *
+ * Modules work with sample_t, so to benchmark other sample types
+ * configure the build with a different MAEC_SAMPLE_TYPE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "envelope.hpp"
+#include "fund_oscillator.hpp"
+#include "io/mstream.hpp"
+#include "io/wav.hpp"
+#include "meta_audio.hpp"
+#include "module_mixer.hpp"
+#include "sink_module.hpp"
+
+namespace {
+
+/**
+ * @brief Runs a module in a chain
+ *
+ * We bind the module to a sink, start the chain,
+ * and then process the sink once per iteration.
+ *
+ * @param state Benchmark state
+ * @param mod Module to run
+ */
+void run_module(benchmark::State& state, AudioModule& mod) {
+
+    const auto size = static_cast<int>(state.range(0));
+
+    SinkModule sink;
+
+    sink.get_chain_info()->buffer_size = size;
+    sink.bind(&mod);
+
+    sink.meta_info_sync();
+    sink.meta_start();
+
+    for (auto _ : state) {
+
+        sink.meta_process();
+
+        benchmark::DoNotOptimize(sink.get_buffer()->data());
+    }
+
+    sink.meta_stop();
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * size);
+}
+
+/**
+ * @brief Benchmarks an oscillator
+ *
+ * @tparam O Oscillator to benchmark
+ * @param state Benchmark state
+ */
+template <typename O>
+void BM_Oscillator(benchmark::State& state) {
+
+    O osc(440);
+
+    run_module(state, osc);
+}
+
+/**
+ * @brief Benchmarks a band-limited wavetable oscillator
+ *
+ * @param state Benchmark state
+ */
+void BM_WavetableOscillator(benchmark::State& state) {
+
+    WavetableOscillator osc(Waveform::Sawtooth, 440);
+
+    run_module(state, osc);
+}
+
+/**
+ * @brief Benchmarks a PolyBLEP band-limited oscillator
+ *
+ * @param state Benchmark state
+ */
+void BM_BLEPOscillator(benchmark::State& state) {
+
+    BLEPOscillator osc(Waveform::Sawtooth, 440);
+
+    run_module(state, osc);
+}
+
+/**
+ * @brief Benchmarks a modulated oscillator with an audio rate frequency
+ *
+ * @tparam O Oscillator to benchmark
+ * @param state Benchmark state
+ */
+template <typename O>
+void BM_ModOscillator(benchmark::State& state) {
+
+    SineOscillator lfo(5);
+    O osc;
+
+    osc.get_frequency()->bind(&lfo);
+
+    run_module(state, osc);
+}
+
+/**
+ * @brief Benchmarks an envelope in the middle of its ramp
+ *
+ * @tparam E Envelope to benchmark
+ * @param state Benchmark state
+ */
+template <typename E>
+void BM_Envelope(benchmark::State& state) {
+
+    E env;
+
+    env.set_start_value(SMALL);
+    env.set_stop_value(1);
+    env.set_stop_time(NANO * 3600);
+
+    run_module(state, env);
+}
+
+/**
+ * @brief Benchmarks an ADSR envelope during its attack
+ *
+ * @param state Benchmark state
+ */
+void BM_ADSREnvelope(benchmark::State& state) {
+
+    ADSREnvelope env(NANO * 3600, NANO, 0.5, NANO);
+
+    run_module(state, env);
+}
+
+/**
+ * @brief Benchmarks mixing down a number of inputs
+ *
+ * The second argument is the number of inputs.
+ *
+ * @param state Benchmark state
+ */
+void BM_ModuleMixDown(benchmark::State& state) {
+
+    const auto inputs = static_cast<int>(state.range(1));
+
+    std::vector<std::unique_ptr<ConstModule>> consts;
+    ModuleMixDown mix;
+
+    for (int i = 0; i < inputs; ++i) {
+
+        consts.push_back(std::make_unique<ConstModule>(0.1));
+
+        mix.bind(consts.back().get());
+    }
+
+    run_module(state, mix);
+}
+
+/**
+ * @brief Benchmarks decoding wave data
+ *
+ * The first argument is the number of frames per call,
+ * the second is the bits per sample.
+ *
+ * @param state Benchmark state
+ */
+void BM_WaveReaderGetData(benchmark::State& state) {
+
+    const auto size = static_cast<int>(state.range(0));
+    const auto bits = static_cast<int>(state.range(1));
+    const int frames = 1 << 16;
+
+    // Write a wave file to read from:
+
+    CharOStream ostream;
+    WaveWriter writer(&ostream);
+
+    writer.set_bits_per_sample(bits);
+    writer.set_channels(2);
+    writer.set_samplerate(SAMPLE_RATE);
+
+    writer.start();
+
+    auto data = std::make_unique<AudioBuffer>(frames, 2);
+
+    for (int i = 0; i < frames; ++i) {
+
+        data->at(0, i) = static_cast<sample_t>((i % 200) / 100.0 - 1);
+        data->at(1, i) = static_cast<sample_t>(1 - (i % 200) / 100.0);
+    }
+
+    writer.write_data(std::move(data));
+    writer.stop();
+
+    // Read it back, starting over when we run out:
+
+    CharIStream istream;
+
+    istream.get_array() = ostream.get_array();
+
+    WaveReader reader(&istream);
+
+    reader.start();
+    reader.set_buffer_size(size);
+
+    int64_t frame = 0;
+
+    for (auto _ : state) {
+
+        if (frame + size > frames) {
+
+            reader.seek_frame(0);
+
+            frame = 0;
+        }
+
+        auto out = reader.get_data();
+
+        benchmark::DoNotOptimize(out->data());
+
+        frame += size;
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * size * 2);
+}
+
+}  // namespace
+
+BENCHMARK(BM_Oscillator<SineOscillator>)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK(BM_Oscillator<SquareOscillator>)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK(BM_Oscillator<SawtoothOscillator>)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK(BM_Oscillator<TriangleOscillator>)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK(BM_WavetableOscillator)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK(BM_BLEPOscillator)->RangeMultiplier(4)->Range(64, 4096);
+
+BENCHMARK(BM_ModOscillator<ModSineOscillator>)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK(BM_ModOscillator<ModSquareOscillator>)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK(BM_ModOscillator<ModSawtoothOscillator>)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK(BM_ModOscillator<ModTriangleOscillator>)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK(BM_ModOscillator<ModWavetableOscillator>)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK(BM_ModOscillator<ModBLEPOscillator>)->RangeMultiplier(4)->Range(64, 4096);
+
+BENCHMARK(BM_Envelope<ConstantEnvelope>)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK(BM_Envelope<LinearRamp>)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK(BM_Envelope<ExponentialRamp>)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK(BM_ADSREnvelope)->RangeMultiplier(4)->Range(64, 4096);
+
+BENCHMARK(BM_ModuleMixDown)->ArgsProduct({{64, 1024}, {2, 8, 32}});
+
+BENCHMARK(BM_WaveReaderGetData)->ArgsProduct({{256, 4096}, {8, 16, 24, 32}});
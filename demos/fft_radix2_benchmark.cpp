@@ -341,6 +341,72 @@ long double benchmark_radix2() {
     return total_time / repeat;
 }
 
+/**
+ * @brief Benchmarks the FFTPlan implementation
+ * 
+ * The plan is prepared once outside of the timed region,
+ * which is how spectral components use it.
+ * 
+ * @return long double Average computation time
+ */
+long double benchmark_plan() {
+
+    std::cout << "+=================================+" << std::endl;
+    std::cout << "     !Benchmarking FFTPlan!" << std::endl;
+    std::cout << "+=================================+" << std::endl;
+
+    // Define some values:
+
+    long double total_time = 0;
+
+    FFTPlan<long double> plan(num);
+
+    std::vector<std::complex<long double>> idata(num);
+    std::vector<std::complex<long double>> odata(num);
+
+    // Ok, iterate a number of times:
+
+    for(int i = 0; i < repeat; ++i) {
+
+        // Generate random complex data:
+
+        rand_complex(num, idata.begin());
+
+        // Start the clock:
+    
+        auto start = std::chrono::high_resolution_clock::now();
+
+        // Compute the value:
+
+        plan.forward(idata.begin(), odata.begin());
+
+        // Stop the clock:
+
+        auto stop = std::chrono::high_resolution_clock::now();
+
+        // Calculate the time:
+    
+        auto diff = stop - start;
+
+        // Print the time:
+    
+        std::cout << "FFTPlan Time [" << i << "]: " << std::chrono::duration <double, std::milli> (diff).count() << " ms" << std::endl;
+
+        // Add to the total:
+
+        total_time += std::chrono::duration <double, std::milli> (diff).count();
+    }
+
+    // Output some stats:
+
+    std::cout << "Total FFTPlan time: " << total_time << " ms" << std::endl;
+    std::cout << "Average FFTPlan time: " << total_time / repeat << " ms" << std::endl;
+
+    // Finally, return average time:
+
+    return total_time / repeat;
+}
+
 int main() {
 
     // First, check outputs:
@@ -365,6 +431,10 @@ int main() {
 
     long double avg = benchmark_radix2();
 
+    // Run benchmark for FFTPlan:
+
+    long double plan_avg = benchmark_plan();
+
     // Output some data:
 
     std::cout << "+========================================+" << std::endl;
@@ -372,4 +442,5 @@ int main() {
 
     std::cout << "Radix2 Average is: " << avg << " ms" << std::endl;
     std::cout << "Radix2-Alt Average is: " << alt_avg << " ms" << std::endl;
+    std::cout << "FFTPlan Average is: " << plan_avg << " ms" << std::endl;
 }
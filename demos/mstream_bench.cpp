@@ -18,6 +18,10 @@
  * The second method has the benefit of minimizing expensive IO system calls,
  * which is generally preferred when it comes to IO operations.
  * The down side is extra time is spend processing the data in an intermediate format.
+ *
+ * We also compare reading data already in memory by copying it into a CharIStream,
+ * vs. borrowing it with a SpanIStream,
+ * and time many small writes to a CharOStream.
  */
 
 #include <chrono>
@@ -193,4 +197,70 @@ int main() {
     const long double per = diff / ((total1 + total2) / 2) * 100;
 
     std::cout << "Percent Difference: " << per << std::endl;
+
+    // Now compare copying memory into a stream vs. borrowing it:
+
+    std::cout << "+================================================+"
+              << std::endl;
+    std::cout << "       --== [ In Memory mstream Times ] ==--" << std::endl;
+
+    const std::size_t mem_size = static_cast<std::size_t>(64) << 20;
+    const int mem_chunk = 4096;
+
+    std::vector<unsigned char> mem(mem_size, 1);
+    std::vector<char> out(mem_chunk);
+
+    long sum = 0;
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    CharIStream copied;
+
+    copied.get_array() = mem;
+
+    for (std::size_t i = 0; i < mem_size; i += mem_chunk) {
+
+        copied.read(out.data(), mem_chunk);
+        sum += out[0];
+    }
+
+    auto stop = std::chrono::high_resolution_clock::now();
+
+    const double copy_time = std::chrono::duration<double, std::milli>(stop - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+
+    SpanIStream borrowed(mem);
+
+    for (std::size_t i = 0; i < mem_size; i += mem_chunk) {
+
+        sum += borrowed.contiguous()[i];
+    }
+
+    stop = std::chrono::high_resolution_clock::now();
+
+    const double borrow_time = std::chrono::duration<double, std::milli>(stop - start).count();
+
+    std::cout << "Copy into CharIStream and read: " << copy_time << " ms" << std::endl;
+    std::cout << "Borrow with SpanIStream: " << borrow_time << " ms" << std::endl;
+
+    // Finally, time many small writes:
+
+    start = std::chrono::high_resolution_clock::now();
+
+    CharOStream ostream;
+
+    for (std::size_t i = 0; i < mem_size; i += 4) {
+
+        ostream.write(out.data(), 4);
+    }
+
+    stop = std::chrono::high_resolution_clock::now();
+
+    std::cout << "CharOStream 4 byte writes: " << std::chrono::duration<double, std::milli>(stop - start).count()
+              << " ms" << std::endl;
+
+    // Keep the compiler from removing our reads:
+
+    std::cout << "Checksum: " << sum + ostream.get_array().size() << std::endl;
 }
@@ -62,6 +62,42 @@ class BaseAmplitude : public AudioModule {
          */
         void set_value(double val) { this->value = val; }
 
+        /**
+         * @brief Determines if this module processes in place
+         * 
+         * We alter the incoming buffer directly.
+         * 
+         * @return true Always
+         */
+        bool in_place() const override { return true; }
+
+        /**
+         * @brief Handles an event
+         *
+         * Parameter events set our value.
+         *
+         * @param event Event to handle
+         */
+        void on_event(const Event& event) override;
+
+    protected:
+
+        /**
+         * @brief Folds a constant buffer into a new constant
+         *
+         * If the incoming buffer is marked as constant (see BaseBuffer::set_constant()),
+         * then every output value is the same, and we fill the block with it
+         * rather than reading the input.
+         * This only applies when the range is the whole block,
+         * otherwise the block will hold more than one value and the mark is cleared.
+         *
+         * @param offset Index of the first sample to render
+         * @param num Number of samples to render
+         * @param value Output value for the constant input
+         * @return true If the range was folded, and no more work is necessary
+         * @return false If the range must be processed
+         */
+        bool fold(int offset, int num, sample_t value);
 };
 
 /**
@@ -84,10 +120,27 @@ class AmplitudeScale : public BaseAmplitude {
         /**
          * @brief Scale the incoming audio data
          * 
-         * We multiply the incoming buffer by the given value.
+         * We multiply the incoming buffer by the given value,
+         * changing the value at each event.
          * 
          */
         void process() override;
+
+        /**
+         * @brief Processes part of the incoming buffer
+         * 
+         * @param offset Index of the first frame to process
+         * @param num Number of frames to process
+         */
+        void render(int offset, int num) override;
+
+        /**
+         * @brief Processes a single sample of a fused block
+         * 
+         * @param input Incoming sample
+         * @return sample_t Processed sample
+         */
+        sample_t fused_tick(sample_t input) const { return static_cast<sample_t>(this->get_value() * input); }
 };
 
 /**
@@ -110,8 +163,25 @@ class AmplitudeAdd : public BaseAmplitude {
         /**
          * @brief Add the value to the incoming audio data
          * 
-         * We add our value to the incoming audio data.
+         * We add our value to the incoming audio data,
+         * changing the value at each event.
          * 
          */
         void process() override;
+
+        /**
+         * @brief Processes part of the incoming buffer
+         * 
+         * @param offset Index of the first frame to process
+         * @param num Number of frames to process
+         */
+        void render(int offset, int num) override;
+
+        /**
+         * @brief Processes a single sample of a fused block
+         * 
+         * @param input Incoming sample
+         * @return sample_t Processed sample
+         */
+        sample_t fused_tick(sample_t input) const { return static_cast<sample_t>(this->get_value() + input); }
 };
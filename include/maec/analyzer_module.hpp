@@ -0,0 +1,436 @@
+/**
+ * @file analyzer_module.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief A module that measures the spectrum and levels of audio data
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Monitoring tools often want to display what is passing through a chain,
+ * such as spectrum displays and level meters.
+ * The SpectrumAnalyzer measures audio as it passes through,
+ * and publishes the results so another thread (such as a UI) can read them
+ * without ever blocking the thread rendering the chain.
+ *
+ * When only a few frequencies are of interest, such as when detecting tones,
+ * the ToneDetector measures just those frequencies for much less work.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "audio_module.hpp"
+#include "dsp/goertzel.hpp"
+#include "dsp/ring.hpp"
+#include "dsp/stft.hpp"
+
+/**
+ * @brief Measurements published by a SpectrumAnalyzer
+ *
+ * Magnitudes are stored channel by channel,
+ * each channel holding (bins) values from DC to the Nyquist frequency.
+ * Magnitudes are normalized so a full scale sine gives a value of about 1.
+ */
+struct SpectrumSnapshot {
+
+    /// Number of channels measured
+    int channels = 0;
+
+    /// Number of bins per channel
+    int bins = 0;
+
+    /// Chain sample time at the end of the measured audio
+    int64_t sample = 0;
+
+    /// Number of snapshots published before this one
+    uint64_t sequence = 0;
+
+    /// Average magnitude of each bin since the last snapshot
+    std::vector<float> magnitude;
+
+    /// Largest absolute sample of each channel since the last snapshot
+    std::vector<float> peak;
+
+    /// RMS level of each channel since the last snapshot
+    std::vector<float> rms;
+
+    /**
+     * @brief Gets the magnitudes of a channel
+     *
+     * @param channel Channel to get
+     * @return std::span<const float> Magnitudes of the channel
+     */
+    std::span<const float> channel(int channel) const { return std::span<const float>(this->magnitude).subspan(static_cast<std::size_t>(channel) * this->bins, this->bins); }
+};
+
+/**
+ * @brief Measures the spectrum and levels of audio passing through
+ *
+ * We pass audio along untouched, and measure each channel as we go:
+ *
+ * - Frames of (size) samples are windowed and transformed every (hop) samples,
+ *   and the magnitudes of the bins are averaged
+ * - The peak and RMS levels of all samples are tracked
+ *
+ * At the end of each block in which at least one frame was completed,
+ * we publish a SpectrumSnapshot through a triple buffer and reset the measurements.
+ * Another thread may call poll() at any pace to pick up the latest snapshot.
+ *
+ * All memory is allocated when we are started,
+ * after which processing is wait-free and allocation-free.
+ * Starting resizes the snapshots, so the reader must not poll while we are started.
+ */
+class SpectrumAnalyzer : public AudioModule {
+
+    public:
+
+        SpectrumAnalyzer() =default;
+
+        /**
+         * @brief Construct a new SpectrumAnalyzer object
+         *
+         * @param size Size of each frame
+         * @param hop Number of samples between frames
+         */
+        SpectrumAnalyzer(int size, int hop) {
+
+            this->set_size(size);
+            this->set_hop(hop);
+        }
+
+        /**
+         * @brief Measures the current buffer
+         *
+         */
+        void process() override;
+
+        /**
+         * @brief Starts this module
+         *
+         * We allocate the frames and snapshots for the channels we expect.
+         */
+        void start() override;
+
+        /**
+         * @brief Adds the memory held by this analyzer
+         *
+         * We count the transform, along with the frames and spectrum of each channel.
+         *
+         * @param usage Footprint to add to
+         */
+        void footprint(MemoryFootprint& usage) const override;
+
+        /// We pass the buffer we are given along
+        bool in_place() const override { return true; }
+
+        /**
+         * @brief Picks up the latest snapshot, if there is one
+         *
+         * This should only be called by a single reader thread.
+         *
+         * @return true If a new snapshot is available via snapshot()
+         * @return false If nothing was published since the last call
+         */
+        bool poll() { return this->snapshots.update(); }
+
+        /**
+         * @brief Gets the last snapshot picked up by poll()
+         *
+         * @return const SpectrumSnapshot& Latest snapshot
+         */
+        const SpectrumSnapshot& snapshot() const { return this->snapshots.read_buffer(); }
+
+        /**
+         * @brief Sets the size of each frame
+         *
+         * This must be set before we are started.
+         *
+         * @param num Size of each frame, rounded up to an even number
+         */
+        void set_size(int num) {
+
+            this->size = std::max(2, num + (num % 2));
+            this->hop = std::min(this->hop, this->size);
+        }
+
+        /**
+         * @brief Gets the size of each frame
+         *
+         * @return int Size of each frame
+         */
+        int get_size() const { return this->size; }
+
+        /**
+         * @brief Sets the number of samples between frames
+         *
+         * This must be set before we are started.
+         *
+         * @param num Hop size, clamped to the frame size
+         */
+        void set_hop(int num) { this->hop = std::clamp(num, 1, this->size); }
+
+        /**
+         * @brief Gets the number of samples between frames
+         *
+         * @return int Hop size
+         */
+        int get_hop() const { return this->hop; }
+
+        /**
+         * @brief Sets the window applied to each frame
+         *
+         * This must be set before we are started.
+         *
+         * @param type Type of window
+         */
+        void set_window(WindowType type) { this->window = type; }
+
+        /**
+         * @brief Gets the window applied to each frame
+         *
+         * @return WindowType Type of window
+         */
+        WindowType get_window() const { return this->window; }
+
+        /**
+         * @brief Gets the number of bins in each spectrum
+         *
+         * @return int Number of bins
+         */
+        int bins() const { return this->size / 2 + 1; }
+
+    private:
+
+        /**
+         * @brief Allocates all memory for the given number of channels
+         *
+         * @param channels Number of channels
+         */
+        void prepare(int channels);
+
+        /**
+         * @brief Analyzes the current frame of a channel
+         *
+         * @param channel Channel to analyze
+         */
+        void analyze(int channel);
+
+        /**
+         * @brief Publishes the current measurements
+         *
+         */
+        void publish();
+
+        /// Size of each frame
+        int size = 2048;
+
+        /// Number of samples between frames
+        int hop = 1024;
+
+        /// Window applied to each frame
+        WindowType window = WindowType::Hann;
+
+        /// Analysis shared by all channels
+        STFTAnalysis analysis;
+
+        /// Scale that normalizes magnitudes to full scale
+        sample_t scale = 1;
+
+        /// Last (size) samples of each channel
+        std::vector<sample_t> frames;
+
+        /// Number of samples in the frame of each channel
+        std::vector<int> fill;
+
+        /// Spectrum of the current frame
+        std::vector<std::complex<sample_t>> spectrum;
+
+        /// Number of frames averaged into the current measurements
+        int averaged = 0;
+
+        /// Number of samples measured for the current levels
+        int64_t measured = 0;
+
+        /// Sum of squares of each channel
+        std::vector<double> power;
+
+        /// Number of snapshots published
+        uint64_t sequence = 0;
+
+        /// Snapshots handed to the reader
+        TripleBuffer<SpectrumSnapshot> snapshots;
+};
+
+/**
+ * @brief Measurements published by a ToneDetector
+ *
+ * Magnitudes are stored channel by channel,
+ * each channel holding one value for each frequency in the order they were given.
+ */
+struct ToneSnapshot {
+
+    /// Number of channels measured
+    int channels = 0;
+
+    /// Number of frequencies per channel
+    int bins = 0;
+
+    /// Chain sample time at the end of the measured audio
+    int64_t sample = 0;
+
+    /// Number of snapshots published before this one
+    uint64_t sequence = 0;
+
+    /// Frequencies measured in hertz
+    std::vector<double> frequencies;
+
+    /// Magnitude of each frequency over the last window
+    std::vector<float> magnitude;
+
+    /**
+     * @brief Gets the magnitudes of a channel
+     *
+     * @param channel Channel to get
+     * @return std::span<const float> Magnitudes of the channel
+     */
+    std::span<const float> channel(int channel) const { return std::span<const float>(this->magnitude).subspan(static_cast<std::size_t>(channel) * this->bins, this->bins); }
+};
+
+/**
+ * @brief Measures a set of frequencies of audio passing through
+ *
+ * We pass audio along untouched, and run a GoertzelBank on each channel.
+ * This costs O(K) for each sample when measuring K frequencies,
+ * which is far cheaper than a SpectrumAnalyzer when K is small.
+ *
+ * At the end of each block in which a window was completed,
+ * we publish a ToneSnapshot through a triple buffer.
+ * Another thread may call poll() at any pace to pick up the latest snapshot.
+ *
+ * All memory is allocated when we are started,
+ * after which processing is wait-free and allocation-free.
+ * Starting resizes the snapshots, so the reader must not poll while we are started.
+ */
+class ToneDetector : public AudioModule {
+
+    public:
+
+        ToneDetector() =default;
+
+        /**
+         * @brief Construct a new ToneDetector object
+         *
+         * @param freqs Frequencies to measure in hertz
+         * @param window Number of samples in each window
+         */
+        ToneDetector(std::vector<double> freqs, int window) {
+
+            this->set_frequencies(std::move(freqs));
+            this->set_window(window);
+        }
+
+        /**
+         * @brief Measures the current buffer
+         *
+         */
+        void process() override;
+
+        /**
+         * @brief Starts this module
+         *
+         * We configure the banks and snapshots for the channels we expect.
+         */
+        void start() override;
+
+        /**
+         * @brief Adds the memory held by this detector
+         *
+         * We count the resonators of each channel.
+         *
+         * @param usage Footprint to add to
+         */
+        void footprint(MemoryFootprint& usage) const override;
+
+        /// We pass the buffer we are given along
+        bool in_place() const override { return true; }
+
+        /**
+         * @brief Picks up the latest snapshot, if there is one
+         *
+         * This should only be called by a single reader thread.
+         *
+         * @return true If a new snapshot is available via snapshot()
+         * @return false If nothing was published since the last call
+         */
+        bool poll() { return this->snapshots.update(); }
+
+        /**
+         * @brief Gets the last snapshot picked up by poll()
+         *
+         * @return const ToneSnapshot& Latest snapshot
+         */
+        const ToneSnapshot& snapshot() const { return this->snapshots.read_buffer(); }
+
+        /**
+         * @brief Sets the frequencies to measure
+         *
+         * This must be set before we are started.
+         *
+         * @param freqs Frequencies in hertz
+         */
+        void set_frequencies(std::vector<double> freqs) { this->frequencies = std::move(freqs); }
+
+        /**
+         * @brief Gets the frequencies we measure
+         *
+         * @return const std::vector<double>& Frequencies in hertz
+         */
+        const std::vector<double>& get_frequencies() const { return this->frequencies; }
+
+        /**
+         * @brief Sets the number of samples in each window
+         *
+         * This must be set before we are started.
+         *
+         * @param num Window size, at least 1
+         */
+        void set_window(int num) { this->window = std::max(num, 1); }
+
+        /**
+         * @brief Gets the number of samples in each window
+         *
+         * @return int Window size
+         */
+        int get_window() const { return this->window; }
+
+    private:
+
+        /**
+         * @brief Allocates all memory for the given number of channels
+         *
+         * @param channels Number of channels
+         */
+        void prepare(int channels);
+
+        /// Frequencies to measure
+        std::vector<double> frequencies;
+
+        /// Number of samples in each window
+        int window = 1024;
+
+        /// Bank of resonators for each channel
+        std::vector<GoertzelBank> banks;
+
+        /// Number of snapshots published
+        uint64_t sequence = 0;
+
+        /// Snapshots handed to the reader
+        TripleBuffer<ToneSnapshot> snapshots;
+};
@@ -18,14 +18,76 @@
 #include <algorithm>
 #include <memory>
 
+#include "dsp/alloc.hpp"
 #include "dsp/buffer.hpp"
 
-/// A typedef representing an AudioBuffer
-using AudioBuffer = Buffer<long double>;
+/**
+ * @brief The internal maec sample format (mf)
+ *
+ * This is the type every sample in the module framework is stored as.
+ * It can be selected at configure time via the MAEC_SAMPLE_TYPE option,
+ * which defaults to float.
+ * float is the best choice for real time processing, as it is half the size
+ * of a double and can be processed many samples at a time by the CPU.
+ * double or long double can be selected if precision is more important.
+ */
+#ifdef MAEC_SAMPLE_TYPE
+using sample_t = MAEC_SAMPLE_TYPE;
+#else
+using sample_t = float;
+#endif
+
+/**
+ * @brief The layout of samples in AudioBuffers
+ *
+ * This can be selected at configure time via the MAEC_PLANAR option.
+ * By default we use the interleaved layout, which matches most devices and files.
+ * If enabled, each channel is stored contiguously which makes
+ * per channel processing faster, at the cost of converting at the I/O modules.
+ */
+#ifdef MAEC_PLANAR
+using sample_layout = Planar;
+#else
+using sample_layout = Interleaved;
+#endif
+
+/**
+ * @brief A typedef representing an AudioBuffer
+ *
+ * AudioBuffers use the AlignedAllocator,
+ * so their storage is always aligned and padded for SIMD kernels (see dsp/alloc.hpp).
+ */
+using AudioBuffer = Buffer<sample_t, sample_layout, AlignedAllocator<sample_t>>;
+
+/**
+ * @brief Level under which a decaying signal is considered silent
+ *
+ * This is roughly -180 dB, far below what any output format can represent.
+ * Filters use this to determine when their tails have decayed,
+ * so silent input may produce silent output (see BaseBuffer::is_silent()).
+ */
+constexpr double SILENCE_LEVEL = 1e-9;
 
 /// Alias for a unique pointer to an AudioBuffer
 using BufferPointer = std::unique_ptr<AudioBuffer>;
 
+/**
+ * @brief Alias for a shared pointer to an immutable AudioBuffer
+ *
+ * This is used for data that is computed once and then
+ * read by many components, such as filter kernels.
+ * A BufferPointer can be moved into one of these.
+ */
+using KernelPointer = std::shared_ptr<const AudioBuffer>;
+
+/**
+ * @brief Alias for a shared pointer to a read only AudioBuffer
+ *
+ * This is used when one buffer is read by many modules,
+ * see AudioModule::share_buffer().
+ */
+using SharedBuffer = std::shared_ptr<const AudioBuffer>;
+
 /**
  * @brief Creates an AudioBuffer
  *
@@ -134,7 +196,7 @@ void squish_null(AudioBuffer* buff, const It& iter, Func oper) {}  // NOLINT(cla
  * 
  * This section contains components for converting audio data.
  * These are used to convert audio data from one format to another.
- * Most audio libraries do not work well with the internal maec audio format, long double,
+ * Most audio libraries do not work well with the internal maec audio format, sample_t,
  * so it is necessary to provide components for transforming between the two.
  * 
  * It is recommended to use these functions with the squishers/splitters
@@ -145,16 +207,16 @@ void squish_null(AudioBuffer* buff, const It& iter, Func oper) {}  // NOLINT(cla
  * 
  * For converting the maec format (mf) into another:
  * 
- * [OTHER] mf_[OTHER](long double val)
+ * [OTHER] mf_[OTHER](sample_t val)
  * 
  * For converting other format into mf:
  * 
- * long double [OTHER]_mf([OTHER] val)
+ * sample_t [OTHER]_mf([OTHER] val)
  * 
  * Where [OTHER] is the name of the other format to work with.
  * For example, converting mf to int and vice versa:
  * 
- * mf_int(long double val)
+ * mf_int(sample_t val)
  * int_mf(int val)
  * 
  * It is also worth mentioning that 'null' means the function will do nothing.
@@ -172,7 +234,7 @@ void squish_null(AudioBuffer* buff, const It& iter, Func oper) {}  // NOLINT(cla
  * @param val Value to convert
  * @return float Converted float value
  */
-float mf_float(long double val);
+float mf_float(sample_t val);
 
 /**
  * @brief Does nothing
@@ -180,9 +242,9 @@ float mf_float(long double val);
  * This function simply returns the value provided.
  * 
  * @param val Value to convert
- * @return long double Value provided
+ * @return sample_t Value provided
  */
-long double mf_null(long double val);
+sample_t mf_null(sample_t val);
 
 /**
  * @brief Converts mf to a 16bit integer
@@ -193,7 +255,7 @@ long double mf_null(long double val);
  * @param val Value to convert
  * @return int16_t Converted int16_t
  */
-int16_t mf_int16(long double val);
+int16_t mf_int16(sample_t val);
 
 /**
  * @brief Converts mf to a unsigned 16bit integer
@@ -205,7 +267,7 @@ int16_t mf_int16(long double val);
  * @param val Value to convert 
  * @return uint16_t Converted uint16_t
  */
-uint16_t mf_uint16(long double val);
+uint16_t mf_uint16(sample_t val);
 
 /**
  * @brief Converts mf to a char
@@ -216,7 +278,7 @@ uint16_t mf_uint16(long double val);
  * @param val Value to convert
  * @return char Converted uint16_t
  */
-char mf_char(long double val);
+char mf_char(sample_t val);
 
 /**
  * @brief Converts mf to an unsigned char
@@ -229,7 +291,7 @@ char mf_char(long double val);
  * @param val Value to convert
  * @return uchar Converted uchar
  */
-unsigned char mf_uchar(long double val);
+unsigned char mf_uchar(sample_t val);
 
 // other -> mf
 
@@ -240,9 +302,9 @@ unsigned char mf_uchar(long double val);
  * and then cast to mf
  *
  * @param val Value to convert
- * @return long double Converted mf
+ * @return sample_t Converted mf
  */
-long double int16_mf(int16_t val);
+sample_t int16_mf(int16_t val);
 
 /**
  * @brief Converts an unsigned 16bit integer to mf 
@@ -251,9 +313,9 @@ long double int16_mf(int16_t val);
  * double it, and then subtract by 1.
  * 
  * @param val Value to convert
- * @return long double 
+ * @return sample_t 
  */
-long double uint16_mf(uint16_t val);
+sample_t uint16_mf(uint16_t val);
 
 /**
  * @brief Converts a char to mf
@@ -262,9 +324,9 @@ long double uint16_mf(uint16_t val);
  * and then divide by 127;
  * 
  * @param val Value to convert
- * @return long double Converted mf
+ * @return sample_t Converted mf
  */
-long double char_mf(char val);
+sample_t char_mf(char val);
 
 /**
  * @brief Converts a unsigned char to mf
@@ -273,9 +335,9 @@ long double char_mf(char val);
  * double it, and then subtract 1. 
  * 
  * @param val Value to convert
- * @return long double Converted mf
+ * @return sample_t Converted mf
  */
-long double uchar_mf(unsigned char val);
+sample_t uchar_mf(unsigned char val);
 
 /**
  * @brief Components for byte conversions
@@ -461,3 +523,26 @@ void uint32_char(uint32_t val, T byts) {
 
     int32_char(static_cast<int32_t>(val), byts);
 }
+
+/**
+ * @brief Converts an unsigned 64bit integer into byte data
+ * 
+ * This function utilizes endian safe methods for conversions.
+ * The value is written least significant byte first.
+ * 
+ * We will place the result into the provided iterable.
+ * We require 8 bytes to make this conversion, so your pointer should
+ * have space for 8 values!
+ * 
+ * @tparam T Iterator type of output byte data
+ * @param val Value to convert
+ * @param byts Iterator to output byte data
+ */
+template<typename T>
+void uint64_char(uint64_t val, T byts) {
+
+    // Write each half:
+
+    uint32_char(static_cast<uint32_t>(val), byts);
+    uint32_char(static_cast<uint32_t>(val >> 32), byts + 4);
+}
@@ -11,11 +11,18 @@
 
 #pragma once
 
+#include <algorithm>
 #include <memory>
+#include <typeinfo>
+#include <vector>
 
 #include "audio_buffer.hpp"
 #include "base_module.hpp"
+#include "buffer_pool.hpp"
 #include "const.hpp"
+#include "event.hpp"
+#include "instrument.hpp"
+#include "trace.hpp"
 
 /**
  * @brief Structure for holding information about an AudioChain
@@ -42,6 +49,12 @@ struct ChainInfo {
     /// Size of buffer entering the sink
     int buffer_size = BUFF_SIZE;
 
+    /// Largest number of frames a single block may have, 0 to use buffer_size
+    int max_buffer = 0;
+
+    /// Number of frames in the block being processed, 0 to use buffer_size
+    int frames = 0;
+
     /// Number of audio channels
     int channels = 1;
 
@@ -50,6 +63,47 @@ struct ChainInfo {
 
     // Number of modules ready to stop:
     int module_finish = 0;
+
+    /// Value determining if the chain is rendering warm-up blocks, sources output zeros and events are held back (see warm_chain())
+    bool warming = false;
+
+    /// Value determining if the thread processing the chain flushes denormals, see dsp/denormal.hpp
+    bool flush_denormals = true;
+
+    /// Largest number of bytes the chain may hold once started, 0 for no limit (see chain_footprint())
+    std::size_t memory_budget = 0;
+
+    /// Number of bytes the chain held when it was last started with a budget
+    std::size_t memory_used = 0;
+
+    /// Value determining if the chain was stopped at start, as it was over budget
+    bool over_budget = false;
+
+    /// Pool of buffers shared by all modules in the chain
+    BufferPool pool;
+
+    /// Sample time at the start of the block being processed
+    int64_t sample = 0;
+
+    /// Events scheduled on this chain
+    EventQueue events;
+
+    /**
+     * @brief Gets the number of frames in the block being processed
+     *
+     * @return int Frames in the current block
+     */
+    int block_size() const { return this->frames > 0 ? this->frames : this->buffer_size; }
+
+    /**
+     * @brief Gets the largest number of frames a block may have
+     *
+     * Modules should size any storage that depends on the block size using this value,
+     * so changing the frame count never allocates.
+     *
+     * @return int Largest frames per block
+     */
+    int max_block_size() const { return std::max(this->max_buffer, this->buffer_size); }
 };
 
 /**
@@ -79,9 +133,12 @@ struct ModuleInfo {
     /// Channels of audio data
     int channels = 1;
 
+    /// Latency added by this module in samples, not shared with other modules
+    int latency = 0;
+
     ModuleInfo() = default;
 
-    ModuleInfo(ChainInfo cinfo) : sample_rate(cinfo.sample_rate), in_buffer(cinfo.buffer_size), out_buffer(cinfo.buffer_size), channels(cinfo.channels) {}
+    ModuleInfo(const ChainInfo& cinfo) : sample_rate(cinfo.sample_rate), in_buffer(cinfo.buffer_size), out_buffer(cinfo.buffer_size), channels(cinfo.channels) {}
 
     /**
      * @brief Configures the ModuleInfo from ChainInfo
@@ -91,7 +148,7 @@ struct ModuleInfo {
      * 
      * @param cinfo ChainInfo to get data from
      */
-    void from_chain(ChainInfo& cinfo) {
+    void from_chain(const ChainInfo& cinfo) {
 
         sample_rate = cinfo.sample_rate;
         in_buffer = cinfo.buffer_size;
@@ -124,6 +181,15 @@ private:
     /// Information for the chain this module is apart of
     ChainInfo* chain = nullptr;
 
+    /// Measurements of this module, nullptr if we are not instrumented
+    std::unique_ptr<ModuleProfile> profile = nullptr;
+
+    /**
+     * @brief Calls process(), and records measurements
+     *
+     */
+    void profiled_process();
+
     /// Pointer to the audio module we are attached to
     AudioModule* forward = nullptr;
 
@@ -134,6 +200,19 @@ protected:
     /// Pointer to the audio buffer we are working with
     std::unique_ptr<AudioBuffer> buff = nullptr;
 
+    /// Shared, read only buffer we are working with, see read_only()
+    SharedBuffer sbuff = nullptr;
+
+    /**
+     * @brief Gets the buffer we are reading from
+     *
+     * Read only modules should use this instead of 'buff',
+     * as their input may be shared with other modules.
+     *
+     * @return const AudioBuffer* Buffer we are reading from
+     */
+    const AudioBuffer* input_buffer() const { return this->buff != nullptr ? this->buff.get() : this->sbuff.get(); }
+
 public:
 
     /// Default Constructor
@@ -175,9 +254,153 @@ public:
      *
      * Most users will not need to alter the code in this module,
      * but some advanced modules will need to, such as the audio mixers.
+     * 
+     * By default, we meta process the backward module,
+     * and then call step().
      */
     virtual void meta_process();
 
+    /**
+     * @brief Calls process()
+     *
+     * All meta processing code should use this method to invoke process(),
+     * as we record measurements here if we are instrumented.
+     */
+    void run_process() {
+
+        MAEC_TRACE_SCOPE("process", typeid(*this).name());
+
+        if (this->profile == nullptr) {
+
+            this->process();
+
+            return;
+        }
+
+        this->profiled_process();
+    }
+
+    /**
+     * @brief Sets if this module is instrumented
+     *
+     * Instrumented modules time each call to process(),
+     * and record the allocations made and the size of the buffers produced.
+     * Enabling clears any previous measurements.
+     * This should not be called while we are being processed.
+     *
+     * @param enable true to instrument, false to remove instrumentation
+     */
+    void set_instrumented(bool enable) { this->profile = enable ? std::make_unique<ModuleProfile>() : nullptr; }
+
+    /**
+     * @brief Gets our measurements
+     *
+     * @return ModuleProfile* Measurements, nullptr if we are not instrumented
+     */
+    ModuleProfile* get_profile() const { return this->profile.get(); }
+
+    /**
+     * @brief Processes this module without processing any others
+     *
+     * This is the part of meta_process() that does not recurse,
+     * which means we expect all modules we pull buffers from
+     * to have been processed already.
+     * By default, we take the buffer from the backward module,
+     * and call process().
+     *
+     * This is used by compiled chains (see ChainPlan),
+     * which process each module in a flat schedule.
+     * Modules that alter meta_process() should alter this method as well.
+     */
+    virtual void step();
+
+    /**
+     * @brief Determines the modules we pull buffers from
+     *
+     * We add each module that must be processed before we can be stepped.
+     * By default, this is the backward module.
+     * Modules that pull from other places, such as mixers or parameters,
+     * should add those modules as well.
+     *
+     * Some modules can't be flattened,
+     * for example modules that process backward modules a varying number of times.
+     * These modules return false, and compiled chains will meta process them
+     * (and the modules behind them) as a whole.
+     *
+     * @param inputs Vector to add modules to
+     * @return true If this module can be stepped
+     * @return false If this module must be meta processed
+     */
+    virtual bool plan_inputs(std::vector<AudioModule*>& inputs);
+
+    /**
+     * @brief Determines if this module processes in place
+     *
+     * A module that processes in place alters the buffer
+     * it takes from its backward module, and passes it along,
+     * instead of creating a new buffer.
+     * Compiled chains use this to determine which buffers are alive
+     * at each point in the schedule (see ChainPlan).
+     *
+     * By default, we assume a new buffer is created.
+     *
+     * @return true If we process in place
+     * @return false If we create a new buffer
+     */
+    virtual bool in_place() const { return false; }
+
+    /**
+     * @brief Handles an event
+     *
+     * This method is called by render_events() when an event
+     * for this module is reached.
+     * By default, we ignore all events.
+     *
+     * @param event Event to handle
+     */
+    virtual void on_event(const Event& /*event*/) {}
+
+    /**
+     * @brief Renders part of our buffer
+     *
+     * Modules that handle events should render the given range
+     * of their buffer here, using their current settings.
+     * No events will occur inside this range.
+     *
+     * @param offset Index of the first sample to render
+     * @param num Number of samples to render
+     */
+    virtual void render(int /*offset*/, int /*num*/) {}
+
+    /**
+     * @brief Renders our buffer, splitting it at each event
+     *
+     * We walk through the current block,
+     * handing each event for this module to on_event()
+     * at the sample it occurs on,
+     * and calling render() for each range between events.
+     * Modules that handle events should call this in process().
+     *
+     * If we are not attached to a chain, then the whole block is rendered.
+     *
+     * @param size Number of samples in the block
+     */
+    void render_events(int size);
+
+    /**
+     * @brief Schedules an event for this module
+     *
+     * We add the event to the queue of our chain.
+     * The sample time is relative to the start of the chain,
+     * see ChainInfo::sample for the current time.
+     *
+     * @param type Type of event
+     * @param sample Chain sample time of the event
+     * @param id ID of the event
+     * @param value Value of the event
+     */
+    void schedule(EventType type, int64_t sample, int id = 0, double value = 0);
+
     /**
      * @brief Meta start method
      *
@@ -206,6 +429,33 @@ public:
      */
     virtual void meta_start();
 
+    /**
+     * @brief Prepares this module for real-time use
+     *
+     * This is called once the chain is started,
+     * but before real-time processing begins (see Engine::prepare()).
+     * It is run off the audio deadline, so modules should do
+     * any work here that would otherwise make their first blocks slow,
+     * such as rendering caches or waiting for background threads to fill queues.
+     * Unlike start(), no module may rely on this being called.
+     *
+     * By default, we do nothing.
+     */
+    virtual void prepare() {}
+
+    /**
+     * @brief Adds the memory held by this module
+     *
+     * This is used to measure the footprint of a chain (see chain_footprint()).
+     * By default, we count the buffer we are holding.
+     * Modules that hold kernels, FFT plans, samples or other large state
+     * should add them to the matching part of the footprint,
+     * and call the parent version of this method.
+     *
+     * @param usage Footprint to add to
+     */
+    virtual void footprint(MemoryFootprint& usage) const;
+
     /**
      * @brief Meta stop method
      *
@@ -318,6 +568,9 @@ public:
      * This method is called when modules are attempting to set the buffer
      * for this audio module.
      *
+     * If we are already holding a buffer,
+     * then it is handed back to the chain buffer pool.
+     *
      * @param inbuff Pointer to an audio buffer
      */
     void set_buffer(std::unique_ptr<AudioBuffer> inbuff);
@@ -342,6 +595,52 @@ public:
      */
     virtual std::unique_ptr<AudioBuffer> get_buffer();
 
+    /**
+     * @brief Hands back any buffer we are holding
+     *
+     * Most modules give up their buffer when it is taken by get_buffer(),
+     * but some hold onto it (such as ModuleMixUp, which hands out copies).
+     * Compiled chains call this once all forward modules are done with our buffer,
+     * so it can be reused sooner.
+     */
+    void release_buffer() { this->reclaim_buffer(std::move(this->buff)); }
+
+    /**
+     * @brief Shares our buffer without copying it
+     *
+     * This is used by read only modules (see read_only()),
+     * which only need to look at our buffer.
+     * The returned buffer must not be altered!
+     *
+     * By default, we only pass along a buffer that was shared with us,
+     * so chains of read only modules never copy.
+     * If we own our buffer then we return nullptr,
+     * as moving it forward with get_buffer() is just as cheap.
+     * Modules that fan out to many others (such as ModuleMixUp)
+     * share the same buffer with everyone.
+     *
+     * @return SharedBuffer Shared buffer, nullptr if we can't share
+     */
+    virtual SharedBuffer share_buffer();
+
+    /**
+     * @brief Determines if this module only reads the buffer it is given
+     *
+     * Read only modules never alter their input,
+     * so when stepped they ask the backward module for a shared buffer
+     * (see share_buffer()) instead of taking ownership of one.
+     * If the backward module can't share, we take ownership as usual.
+     * They should read their input using input_buffer().
+     * If a forward module wants to own our buffer,
+     * then it is copied at that point.
+     *
+     * By default, we assume the input is altered.
+     *
+     * @return true If we only read our input
+     * @return false If we may alter our input
+     */
+    virtual bool read_only() const { return false; }
+
     /**
      * @brief Binds another module to us
      *
@@ -407,10 +706,34 @@ public:
      * You can also specify the default number of channels,
      * but by default this will be 1.
      *
+     * If we are attached to a chain, then the buffer
+     * is taken from the chain buffer pool,
+     * which avoids an allocation if a spare buffer is present.
+     * The size of the buffer is the frames of the current block, see block_size().
+     *
      * @return The newly created buffer
      */
     std::unique_ptr<AudioBuffer> create_buffer(int channels = 1);
 
+    /**
+     * @brief Gets the number of frames we output for the current block
+     *
+     * Chains may process each block with a different number of frames,
+     * up to a declared maximum (see ChainInfo::frames and ChainInfo::max_buffer).
+     * Modules that output blocks the size of the chain follow the current frame count,
+     * and modules that use a size of their own (such as resampled sources) keep it.
+     *
+     * @return int Frames to output for this block
+     */
+    int block_size() const;
+
+    /**
+     * @brief Gets the largest number of frames we may output in a block
+     *
+     * @return int Largest frames per block
+     */
+    int max_block_size() const;
+
     /**
      * @brief Creates an AudioBuffer
      *
@@ -425,6 +748,21 @@ public:
      */
     static std::unique_ptr<AudioBuffer> create_buffer(int size, int channels);
 
+    /**
+     * @brief Reclaims an AudioBuffer
+     *
+     * Hands a buffer we are done with back to the chain buffer pool,
+     * so it can be reused by a later call to create_buffer().
+     * Modules that consume buffers (mixers, filters, sinks)
+     * should call this once they are done with them.
+     *
+     * If we are not attached to a chain,
+     * then the buffer is simply freed.
+     *
+     * @param rbuff Buffer to reclaim
+     */
+    void reclaim_buffer(std::unique_ptr<AudioBuffer> rbuff);
+
     /**
      * @brief Get the backward object
      *
@@ -432,7 +770,7 @@ public:
      *
      * @return AudioModule* Pointer to the backward module
      */
-    AudioModule* get_backward() { return this->backward; }
+    AudioModule* get_backward() const { return this->backward; }
 
     /**
      * @brief Get the module info object
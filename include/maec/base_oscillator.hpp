@@ -11,6 +11,12 @@
 
 #pragma once
 
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <utility>
+
 #include "source_module.hpp"
 #include "module_param.hpp"
 
@@ -43,6 +49,15 @@ private:
     /// Frequency Parameter
     double freq = 0;
 
+    /// Starting phase in turns of the current fused block
+    double fused_start = 0;
+
+    /// Phase increment in turns of the current fused block
+    double fused_inc = 0;
+
+    /// Index of the next sample in the current fused block
+    int fused_index = 0;
+
 public:
     BaseOscillator() = default;
 
@@ -53,7 +68,7 @@ public:
      * @param ph The phase of the oscillator
      *
      */
-    BaseOscillator(long double freq, double pha) : phase(pha), freq(freq) {}
+    BaseOscillator(sample_t freq, double pha) : phase(pha), freq(freq) {}
 
     /**
      * @brief Construct a new Sine Oscillator object, but only define the
@@ -62,7 +77,7 @@ public:
      * @param freq The frequency of the oscillator
      *
      */
-    BaseOscillator(long double freq) : freq(freq) {}
+    BaseOscillator(sample_t freq) : freq(freq) {}
 
     /**
      * @brief Gets the frequency of this oscillator
@@ -98,6 +113,75 @@ public:
      * @param inc Value to increment phase by
      */
     void inc_phase(double inc) { this->phase += inc; }
+
+    /**
+     * @brief Prepares this oscillator for generating a fused block
+     *
+     * Fused blocks are generated one sample at a time
+     * (see StaticChain), so we determine the starting phase
+     * and increment here.
+     *
+     * @param sample_rate Sample rate of the block
+     */
+    void fused_prepare(double sample_rate) {
+
+        double placeholder = 0.0;
+
+        this->fused_inc = this->freq / sample_rate;
+        this->fused_start = std::modf(this->phase * this->fused_inc, &placeholder);
+        this->fused_index = 0;
+    }
+
+    /**
+     * @brief Determines the phase of the next sample in turns
+     *
+     * We compute the phase from the start of the block,
+     * exactly like the batch kernels do.
+     *
+     * @param offset Value to add to the phase
+     * @return double Phase of the next sample in [0, 1)
+     */
+    double fused_turn(double offset = 0) {
+
+        const double turn = this->fused_start + offset + this->fused_inc * this->fused_index++;
+
+        return turn - std::floor(turn);
+    }
+
+    /**
+     * @brief Fills a fused block with a waveform
+     *
+     * We compute the same phases as fused_turn(),
+     * but keep the index local to the loop,
+     * so blocks of a known size can be vectorized (see StaticBlockChain).
+     *
+     * @tparam N Number of samples in the block
+     * @tparam F Waveform type
+     * @param data Block to fill
+     * @param offset Value to add to the phase
+     * @param wave Waveform, given a phase in [0, 1) and returning a sample
+     */
+    template <std::size_t N, typename F>
+    void fused_fill(std::span<sample_t, N> data, double offset, F wave) {
+
+        const int base = this->fused_index;
+
+        for (std::size_t i = 0; i < N; ++i) {
+
+            const double turn = this->fused_start + offset + this->fused_inc * (base + static_cast<int>(i));
+
+            data[i] = wave(turn - std::floor(turn));
+        }
+
+        this->fused_index += static_cast<int>(N);
+    }
+
+    /**
+     * @brief Finishes a fused block
+     *
+     * @param num Number of samples generated
+     */
+    void fused_commit(int num) { this->inc_phase(static_cast<double>(num)); }
 };
 
 class BaseModulatedOscillator : public ParamSource<1> {
@@ -120,7 +204,7 @@ class BaseModulatedOscillator : public ParamSource<1> {
          * @param ph The phase of the oscillator
          *
          */
-        BaseModulatedOscillator(long double freqv, double pha)
+        BaseModulatedOscillator(sample_t freqv, double pha)
             : ParamSource<1>(&freq), phase(pha), freq(freqv) {}
 
         /**
@@ -129,7 +213,7 @@ class BaseModulatedOscillator : public ParamSource<1> {
          * @param freq The frequency of the oscillator
          * 
          */
-        BaseModulatedOscillator(long double freqv)
+        BaseModulatedOscillator(sample_t freqv)
             : ParamSource<1>(&freq), freq(freqv) {}
 
         /**
@@ -162,4 +246,126 @@ class BaseModulatedOscillator : public ParamSource<1> {
          * @param inc Value to increment phase by
          */
         void inc_phase(double inc) { this->phase += inc; }
+
+    protected:
+
+        /**
+         * @brief Computes a single sample of a waveform at the current phase
+         *
+         * @tparam Wave Function taking a phase (and optionally an increment), returning a sample
+         * @param wave Function computing a single sample
+         * @param inc Phase increment of the sample in turns
+         * @return sample_t Computed sample
+         */
+        template <typename Wave>
+        sample_t wave_sample(Wave& wave, double inc) const {
+
+            const double turn = this->phase - std::floor(this->phase);
+
+            if constexpr (std::is_invocable_v<Wave&, double, double>) {
+
+                return wave(turn, inc);
+            }
+
+            else {
+
+                return wave(turn);
+            }
+        }
+
+        /**
+         * @brief Fills a new buffer with a waveform
+         *
+         * We pick a path based upon the rate of the frequency parameter:
+         *
+         * - Constant - The batch kernel fills the whole buffer, no frequency buffer is generated
+         * - Control - The frequency is interpolated across the block, no frequency buffer is generated
+         * - Audio - The frequency buffer is generated, and read for every sample without bounds checks
+         *
+         * The waveform and kernel should produce the same values,
+         * the phase given to them is in turns, wrapped into [0, 1).
+         * Waveforms that depend on the frequency (such as band-limited ones)
+         * may also take the phase increment of the sample in turns.
+         *
+         * @tparam Wave Function taking a phase (and optionally an increment), returning a sample
+         * @tparam Kernel Batch kernel, see dsp/osc.hpp
+         * @param wave Function computing a single sample
+         * @param kernel Function filling a block with a constant frequency
+         */
+        template <typename Wave, typename Kernel>
+        void render_wave(Wave wave, Kernel kernel) {
+
+            // Get sample rate:
+
+            const double sampler = this->get_info()->sample_rate;
+
+            // Create a new buffer:
+
+            this->set_buffer(this->create_buffer());
+
+            const int size = static_cast<int>(this->buff->size());
+            sample_t* out = this->buff->data();
+
+            switch (this->freq.get_rate()) {
+
+                case ParamRate::Constant: {
+
+                    // Fill the entire buffer in one go:
+
+                    const double inc = this->freq.get_constant() / sampler;
+
+                    kernel(out, size, this->phase - std::floor(this->phase), inc);
+
+                    this->phase += inc * size;
+
+                    break;
+                }
+
+                case ParamRate::Control: {
+
+                    // Interpolate the frequency across the block:
+
+                    auto [start, end] = this->freq.get_control();
+
+                    double inc = start / sampler;
+                    const double step = (end - start) / sampler / size;
+
+                    for (int i = 0; i < size; ++i) {
+
+                        out[i] = this->wave_sample(wave, inc);
+
+                        this->phase += inc;
+                        inc += step;
+                    }
+
+                    break;
+                }
+
+                default: {
+
+                    // Get the frequency data:
+
+                    const SharedBuffer fdata = this->freq.share();
+
+                    // Parameter buffers are mono, so read them directly:
+
+                    const sample_t* freqs = fdata->data();
+
+                    for (int i = 0; i < size; ++i) {
+
+                        const double inc = freqs[i] / sampler;
+
+                        out[i] = this->wave_sample(wave, inc);
+
+                        this->phase += inc;
+                    }
+
+                    break;
+                }
+            }
+
+            // Keep the phase small, so we don't lose precision:
+
+            this->phase -= std::floor(this->phase);
+        }
 };
@@ -0,0 +1,182 @@
+/**
+ * @file buffer_pool.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Components for recycling AudioBuffers
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This file contains components for pooling AudioBuffers.
+ * Modules create a new buffer each time they process,
+ * which results in many allocations per second.
+ * A pool allows these buffers to be handed back
+ * once they are consumed, and then reused later.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "audio_buffer.hpp"
+
+/**
+ * @brief A pool of reusable AudioBuffers
+ *
+ * This class keeps a collection of AudioBuffers that are not currently in use.
+ * When a buffer is requested, we first check if we have any spare buffers on hand,
+ * and if so we configure and return one of those.
+ * If no spare buffers are available, then we allocate a new one.
+ *
+ * Once a buffer is no longer needed, it can be reclaimed by the pool.
+ * This allows a steady-state chain to perform no heap allocations,
+ * as buffers are simply passed around in a circle.
+ *
+ * Buffers handed out by this pool are always zeroed,
+ * just like a newly allocated buffer would be.
+ * Buffers are resized upon request, which does not allocate
+ * so long as the buffer has seen this size before.
+ *
+ * We only hold a certain number of buffers at once.
+ * Any buffers reclaimed past this limit are simply freed.
+ * This prevents unbounded growth if buffers are reclaimed
+ * into a different pool than the one they originated from.
+ */
+class BufferPool {
+private:
+
+    /// Collection of buffers ready for use
+    std::vector<BufferPointer> free;
+
+    /// Maximum number of buffers we will hold
+    std::size_t max_size = 32;
+
+    /// Number of buffers we have allocated
+    int allocated = 0;
+
+    /// Frames per channel that new buffers have room for
+    int capacity = 0;
+
+public:
+
+    BufferPool() = default;
+
+    /**
+     * @brief Construct a new Buffer Pool object
+     *
+     * @param max Maximum number of buffers to hold
+     */
+    explicit BufferPool(std::size_t max) : max_size(max) {}
+
+    /**
+     * @brief Gets a buffer from the pool
+     *
+     * We return a buffer with the given size and number of channels,
+     * zeroed and ready for use.
+     * The size provided is the size of each channel,
+     * so the final buffer will contain size * channels values.
+     *
+     * If we have spare buffers, one of those is reused.
+     * Otherwise, a new buffer is allocated,
+     * with room for at least the capacity of the pool (see set_capacity()).
+     *
+     * @param size Size of each channel in the buffer
+     * @param channels Number of channels in the buffer
+     * @param sample_rate Sample rate of the buffer
+     * @return BufferPointer Buffer ready for use
+     */
+    BufferPointer get(int size, int channels, double sample_rate);
+
+    /**
+     * @brief Reclaims a buffer
+     *
+     * We take ownership of the given buffer
+     * and save it for later use.
+     * If we are already holding the max number of buffers,
+     * or if the pointer is empty, then we do nothing.
+     *
+     * @param buff Buffer to reclaim
+     */
+    void reclaim(BufferPointer buff);
+
+    /**
+     * @brief Allocates buffers ahead of time
+     *
+     * We allocate the given number of buffers with the given size,
+     * and place them in the pool.
+     * This is useful for doing all allocations before
+     * real time processing occurs.
+     *
+     * @param num Number of buffers to allocate
+     * @param size Size of each channel in the buffer
+     * @param channels Number of channels in each buffer
+     */
+    void reserve(int num, int size, int channels);
+
+    /**
+     * @brief Frees all held buffers
+     *
+     */
+    void clear() { this->free.clear(); }
+
+    /**
+     * @brief Gets the number of buffers available for use
+     *
+     * @return std::size_t Number of buffers in the pool
+     */
+    std::size_t available() const { return this->free.size(); }
+
+    /**
+     * @brief Gets the number of buffers this pool has allocated
+     *
+     * This value is useful for determining if a chain is
+     * performing allocations in a steady state.
+     *
+     * @return int Number of allocations
+     */
+    int allocations() const { return this->allocated; }
+
+    /**
+     * @brief Gets the number of bytes held by the buffers in the pool
+     *
+     * Buffers that have been handed out are not counted.
+     *
+     * @return std::size_t Number of bytes held
+     */
+    std::size_t bytes() const;
+
+    /**
+     * @brief Gets the max number of buffers we will hold
+     *
+     * @return std::size_t Max number of buffers
+     */
+    std::size_t get_max() const { return this->max_size; }
+
+    /**
+     * @brief Sets the max number of buffers we will hold
+     *
+     * If we are holding more buffers than the new limit,
+     * then the extra buffers are freed.
+     *
+     * @param max New max number of buffers
+     */
+    void set_max(std::size_t max);
+
+    /**
+     * @brief Sets the number of frames new buffers have room for
+     *
+     * Chains that change the size of each block use this,
+     * so a buffer can grow to the largest block without reallocating.
+     *
+     * @param frames Frames per channel to make room for
+     */
+    void set_capacity(int frames) { this->capacity = frames; }
+
+    /**
+     * @brief Gets the number of frames new buffers have room for
+     *
+     * @return int Frames per channel
+     */
+    int get_capacity() const { return this->capacity; }
+};
@@ -0,0 +1,213 @@
+/**
+ * @file chain_plan.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Compiled execution plans for chains
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Normally, a chain is processed by calling meta_process() on the sink,
+ * which recurses through each backward module.
+ * This file contains components that compile a chain into a flat schedule,
+ * which is then processed with a simple loop.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "audio_module.hpp"
+
+class PeriodSink;
+
+/**
+ * @brief A chain compiled into a flat schedule
+ *
+ * We take the module at the front of a chain (usually a sink),
+ * and walk the graph of modules behind it.
+ * This includes mixers, and the side-chains of any parameters.
+ * Each module is placed in the schedule after all the modules it pulls buffers from,
+ * so processing a block is a single loop over the schedule,
+ * calling AudioModule::step() on each module.
+ *
+ * Modules reachable through many paths (such as modules behind a ModuleMixUp)
+ * are only scheduled, and therefore processed, once per block.
+ *
+ * Some modules can't be flattened (see AudioModule::plan_inputs()).
+ * These modules are meta processed as a whole,
+ * so the modules behind them are processed as usual.
+ *
+ * If the front module is a PeriodSink, then the schedule is run once per period,
+ * just like PeriodSink::meta_process().
+ *
+ * When compiled, we also determine the lifetime of each buffer.
+ * Modules that process in place (see AudioModule::in_place())
+ * pass their input buffer along, so it keeps living,
+ * while other modules create a new buffer.
+ * A buffer lives until the last module that reads it has been stepped,
+ * at which point we release it from the module that produced it.
+ * Buffers whose lifetimes don't overlap are then reused through the buffer pool,
+ * so a large chain only needs a handful of buffers, which stay in the cache.
+ * All modules in the schedule without a chain share the pool of the front module,
+ * and the pool is filled with the peak number of live buffers when compiled.
+ *
+ * The plan must be compiled again if the chain changes!
+ * The chain should be synced and started before it is processed,
+ * just like a normal chain.
+ */
+class ChainPlan {
+
+   private:
+
+    /**
+     * @brief A single entry in the schedule
+     */
+    struct Step {
+
+        /// Module to process
+        AudioModule* mod = nullptr;
+
+        /// Determines if the module is meta processed as a whole
+        bool opaque = false;
+
+        /// ID of the buffer this module outputs
+        int buffer = 0;
+
+        /// Position of the last module that reads our buffer
+        int last_use = 0;
+
+        /// Modules whose buffers are no longer needed after this step
+        std::vector<AudioModule*> release;
+    };
+
+    /// Module at the front of the chain
+    AudioModule* front = nullptr;
+
+    /// Modules in the order they are processed
+    std::vector<Step> schedule;
+
+    /// Number of times to run the schedule per block
+    int repeat = 1;
+
+    /// Front module if it is a PeriodSink, so we can report the load to it
+    PeriodSink* sink = nullptr;
+
+    /// Number of distinct buffers in the schedule
+    int buffers = 0;
+
+    /// Largest number of buffers alive at once
+    int peak = 0;
+
+    /**
+     * @brief Determines buffer lifetimes and shares the buffer pool
+     */
+    void analyze();
+
+    /**
+     * @brief Releases any parameters we have planned
+     */
+    void release();
+
+   public:
+
+    ChainPlan() = default;
+
+    /**
+     * @brief Construct a new ChainPlan object and compiles it
+     *
+     * @param mod Module at the front of the chain
+     */
+    explicit ChainPlan(AudioModule* mod) { this->compile(mod); }
+
+    /**
+     * @brief Destroy the ChainPlan object
+     *
+     * Any parameters in the plan go back to processing themselves.
+     */
+    ~ChainPlan() { this->release(); }
+
+    ChainPlan(const ChainPlan&) = delete;
+    ChainPlan& operator=(const ChainPlan&) = delete;
+
+    /**
+     * @brief Compiles the chain into a schedule
+     *
+     * @param mod Module at the front of the chain
+     */
+    void compile(AudioModule* mod);
+
+    /**
+     * @brief Processes one block
+     *
+     * This is identical to calling meta_process() on the front module.
+     */
+    void process();
+
+    /**
+     * @brief Gets the number of modules in the schedule
+     *
+     * @return int Number of modules
+     */
+    int size() const { return static_cast<int>(this->schedule.size()); }
+
+    /**
+     * @brief Gets the module at the given position in the schedule
+     *
+     * @param index Position in the schedule
+     * @return AudioModule* Module at the position
+     */
+    AudioModule* get_module(int index) const { return this->schedule.at(index).mod; }
+
+    /**
+     * @brief Determines if the module at the given position is meta processed
+     *
+     * @param index Position in the schedule
+     * @return true If the module is meta processed as a whole
+     * @return false If the module is stepped
+     */
+    bool is_opaque(int index) const { return this->schedule.at(index).opaque; }
+
+    /**
+     * @brief Gets the ID of the buffer output by the module at the given position
+     *
+     * Modules that share an ID pass the same buffer along.
+     *
+     * @param index Position in the schedule
+     * @return int Buffer ID
+     */
+    int get_buffer_id(int index) const { return this->schedule.at(index).buffer; }
+
+    /**
+     * @brief Gets the position of the last module that reads the given module's buffer
+     *
+     * @param index Position in the schedule
+     * @return int Position of the last reader
+     */
+    int get_last_use(int index) const { return this->schedule.at(index).last_use; }
+
+    /**
+     * @brief Gets the number of distinct buffers in the schedule
+     *
+     * @return int Number of buffers
+     */
+    int buffer_count() const { return this->buffers; }
+
+    /**
+     * @brief Gets the largest number of buffers alive at once
+     *
+     * This is the working set of the chain.
+     * Modules that hand out copies of their buffer (such as ModuleMixUp)
+     * are not accounted for, so this is a lower bound in that case.
+     *
+     * @return int Peak number of live buffers
+     */
+    int peak_buffers() const { return this->peak; }
+
+    /**
+     * @brief Gets the module at the front of the chain
+     *
+     * @return AudioModule* Front module
+     */
+    AudioModule* get_front() const { return this->front; }
+};
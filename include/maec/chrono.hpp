@@ -23,6 +23,8 @@
  * We measure time values in nanoseconds.
  */
 
+#pragma once
+
 #include <chrono>
 #include <ctime>
 
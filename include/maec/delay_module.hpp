@@ -0,0 +1,319 @@
+/**
+ * @file delay_module.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief A multi-tap delay module
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This file contains a module that delays audio data.
+ * It is the building block for echoes, chorus, flangers and the like.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "audio_module.hpp"
+#include "module_param.hpp"
+
+#include "dsp/delay.hpp"
+
+/**
+ * @brief Delays the incoming audio by one or more taps
+ *
+ * Each channel is written into one DelayLine,
+ * and every tap reads from it, so adding taps does not add buffers.
+ * A tap has a delay time (in seconds), a gain, and a modulation depth.
+ *
+ * The delay of every tap can be modulated through a ModuleParam (in seconds).
+ * The delay of each tap is its time, plus the modulation scaled by its depth,
+ * so a single LFO can sweep a group of chorus voices by different amounts.
+ * Constant modulation reads each tap with the same delay for the whole block,
+ * which is the cheapest case, while modulated delays are interpolated per sample.
+ *
+ * The taps are summed into the wet signal, which is mixed with the dry signal (see set_mix()),
+ * and may be fed back into the line (see set_feedback()).
+ * With feedback, the block is processed in pieces no longer than the shortest delay,
+ * and delays are kept at least one sample longer than the interpolation needs.
+ *
+ * Delays are limited to the maximum delay, which must be set before we are started.
+ * We process our buffer in place.
+ */
+class DelayModule : public AudioModule, public BaseParamModule<1> {
+
+    public:
+
+        /**
+         * @brief A single read from the delay line
+         */
+        struct Tap {
+
+            /// Delay in seconds
+            double time = 0;
+
+            /// Gain applied to the tap
+            double gain = 1;
+
+            /// Amount of modulation applied to the tap
+            double depth = 1;
+        };
+
+        DelayModule() : BaseParamModule<1>(&modulation), modulation(0.0) {}
+
+        /**
+         * @brief Construct a new DelayModule object with a single tap
+         *
+         * @param time Delay of the tap in seconds
+         * @param fback Amount of the wet signal fed back into the line
+         * @param wet Amount of wet signal in the output
+         */
+        explicit DelayModule(double time, double fback = 0, double wet = 1)
+            : BaseParamModule<1>(&modulation), modulation(0.0), feedback(fback), mix(wet) { this->add_tap(time); }
+
+        /**
+         * @brief Starts this module and the modulation parameter
+         *
+         */
+        void meta_start() override {
+
+            AudioModule::meta_start();
+
+            this->param_start();
+        }
+
+        /**
+         * @brief Stops this module and the modulation parameter
+         *
+         */
+        void meta_stop() override {
+
+            AudioModule::meta_stop();
+
+            this->param_stop();
+        }
+
+        /**
+         * @brief Preforms a meta info sync operation
+         *
+         * We sync ourselves, and then the modulation parameter.
+         */
+        void meta_info_sync() override {
+
+            AudioModule::meta_info_sync();
+
+            this->param_info(this);
+        }
+
+        /**
+         * @brief Determines the modules we pull buffers from
+         *
+         * @param inputs Vector to add modules to
+         * @return true If we can be stepped
+         */
+        bool plan_inputs(std::vector<AudioModule*>& inputs) override {
+
+            this->param_inputs(inputs);
+
+            return AudioModule::plan_inputs(inputs);
+        }
+
+        /**
+         * @brief Starts this module
+         *
+         * We create a silent delay line for each channel.
+         */
+        void start() override;
+
+        /**
+         * @brief Adds the memory held by this module
+         *
+         * We count the delay line and working memory of each channel.
+         *
+         * @param usage Footprint to add to
+         */
+        void footprint(MemoryFootprint& usage) const override;
+
+        /**
+         * @brief Delays the current buffer
+         *
+         */
+        void process() override;
+
+        /// We alter the buffer we are given
+        bool in_place() const override { return true; }
+
+        /**
+         * @brief Adds a tap
+         *
+         * @param time Delay in seconds
+         * @param gain Gain applied to the tap
+         * @param depth Amount of modulation applied to the tap
+         * @return int Index of the new tap
+         */
+        int add_tap(double time, double gain = 1, double depth = 1);
+
+        /**
+         * @brief Sets a tap
+         *
+         * @param index Index of the tap
+         * @param tap New tap values
+         */
+        void set_tap(int index, const Tap& tap) { this->taps.at(index) = tap; }
+
+        /**
+         * @brief Gets the taps
+         *
+         * @return const std::vector<Tap>& Every tap
+         */
+        const std::vector<Tap>& get_taps() const { return this->taps; }
+
+        /**
+         * @brief Removes every tap
+         */
+        void clear_taps() { this->taps.clear(); }
+
+        /**
+         * @brief Gets the modulation parameter
+         *
+         * This value (in seconds) is scaled by the depth of each tap,
+         * and added to its delay.
+         *
+         * @return ModuleParam* Modulation parameter
+         */
+        ModuleParam* get_modulation() { return &(this->modulation); }
+
+        /**
+         * @brief Sets the maximum delay
+         *
+         * This must be set before we are started.
+         *
+         * @param sec Maximum delay in seconds
+         */
+        void set_max_delay(double sec) { this->max_delay = std::max(0.0, sec); }
+
+        /**
+         * @brief Gets the maximum delay
+         *
+         * @return double Maximum delay in seconds
+         */
+        double get_max_delay() const { return this->max_delay; }
+
+        /**
+         * @brief Sets the interpolation method
+         *
+         * @param interp New interpolation method
+         */
+        void set_interpolation(DelayInterp interp) { this->interpolation = interp; }
+
+        /**
+         * @brief Gets the interpolation method
+         *
+         * @return DelayInterp Current interpolation method
+         */
+        DelayInterp get_interpolation() const { return this->interpolation; }
+
+        /**
+         * @brief Sets the amount of the wet signal fed back into the line
+         *
+         * Values at or above 1 will grow without bound!
+         *
+         * @param val Feedback gain
+         */
+        void set_feedback(double val) { this->feedback = val; }
+
+        /**
+         * @brief Gets the amount of the wet signal fed back into the line
+         *
+         * @return double Feedback gain
+         */
+        double get_feedback() const { return this->feedback; }
+
+        /**
+         * @brief Sets the amount of wet signal in the output
+         *
+         * 0 outputs only the dry signal, and 1 outputs only the wet signal.
+         *
+         * @param val Wet amount
+         */
+        void set_mix(double val) { this->mix = val; }
+
+        /**
+         * @brief Gets the amount of wet signal in the output
+         *
+         * @return double Wet amount
+         */
+        double get_mix() const { return this->mix; }
+
+    private:
+
+        /**
+         * @brief Creates the delay lines and scratch space
+         *
+         * @param channels Number of channels
+         * @param block Largest number of samples in a block
+         */
+        void prepare(int channels, int block);
+
+        /**
+         * @brief Delays a single channel
+         *
+         * @param chan Index of the channel
+         * @param data Pointer to the samples of the channel, replaced with the output
+         * @param num Number of samples
+         * @return true If we wrote anything audible into the line
+         */
+        bool process_channel(int chan, sample_t* data, int num);
+
+        /// Modulation parameter
+        ModuleParam modulation;
+
+        /// Taps reading from the line
+        std::vector<Tap> taps;
+
+        /// Maximum delay in seconds
+        double max_delay = 1;
+
+        /// Interpolation method
+        DelayInterp interpolation = DelayInterp::Linear;
+
+        /// Amount of wet signal fed back
+        double feedback = 0;
+
+        /// Amount of wet signal in the output
+        double mix = 1;
+
+        /// Delay line for each channel
+        std::vector<DelayLine<sample_t>> lines;
+
+        /// Allpass state of each tap, for each channel
+        std::vector<sample_t> states;
+
+        /// Delay of each tap, or of each tap and sample when modulated
+        std::vector<sample_t> delays;
+
+        /// Modulation of each sample in the block
+        std::vector<sample_t> mods;
+
+        /// Determines if the delays change within the block
+        bool moving = false;
+
+        /// Shortest delay of any tap in this block
+        double shortest = 0;
+
+        /// Number of samples since we last wrote anything audible
+        std::size_t quiet = 0;
+
+        /// Output of a single tap
+        std::vector<sample_t> tap_out;
+
+        /// Sum of every tap
+        std::vector<sample_t> wet;
+
+        /// Samples written into the line when there is feedback
+        std::vector<sample_t> fed;
+
+        /// Samples of a single channel when buffers are interleaved
+        std::vector<sample_t> chan_data;
+};
@@ -0,0 +1,394 @@
+/**
+ * @file device_mixer.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief A service that mixes many chains into one device
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Some setups run many independent chains, such as one per client.
+ * Each chain could end in its own ALSASink, but most devices can only be opened once,
+ * and the chains would fight over it.
+ *
+ * The DeviceMixer owns the device instead.
+ * Each chain ends in a MixerSink, which hands its blocks to the mixer through a lock-free ring.
+ * A single real-time thread adds the rings together and writes one period to the device,
+ * so the chains themselves can render in parallel on separate cores
+ * (see Engine), and never touch the device.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "dsp/ring.hpp"
+#include "engine.hpp"
+#include "sink_module.hpp"
+
+/**
+ * @brief Mixes the output of many chains, and writes it to one device
+ *
+ * The mixer works on interleaved frames, with a fixed channel count and period.
+ * The device is reached through an output function,
+ * which is given each mixed period and should block until the device has room
+ * (such as ALSASink::write() on a started ALSASink).
+ *
+ * Chains are attached as clients, each with their own ring.
+ * When started, the mixer thread waits until every client has a period queued,
+ * or until a period of time has passed, then mixes what it has.
+ * A client that had less than a period is counted as an underrun,
+ * and the frames it was missing are silent.
+ * The mixer can also be driven by hand with mix(), which never waits.
+ *
+ * Clients are held in a fixed number of slots, so the mixer thread never locks or allocates.
+ * Attaching and detaching may allocate, and should not be done from a real-time thread.
+ */
+class DeviceMixer {
+
+    public:
+
+        /// Function that writes interleaved frames to the device
+        using Output = std::function<void(const sample_t*, int)>;
+
+        /// Largest number of clients
+        static constexpr int MAX_CLIENTS = 32;
+
+        /**
+         * @brief A chain feeding the mixer
+         *
+         * The chain writes frames with write(), and the mixer thread reads them.
+         */
+        class Client {
+
+            public:
+
+                /**
+                 * @brief Writes interleaved frames for the mixer
+                 *
+                 * This will not block.
+                 * Only whole frames are written,
+                 * so a frame is never split between writes.
+                 *
+                 * @param data Pointer to interleaved frames
+                 * @param frames Number of frames to write
+                 * @return int Number of frames written
+                 */
+                int write(const sample_t* data, int frames);
+
+                /**
+                 * @brief Gets the number of frames that can be written
+                 *
+                 * @return int Number of frames
+                 */
+                int space() const { return static_cast<int>(this->ring.write_available()) / this->channels; }
+
+                /**
+                 * @brief Gets the number of frames waiting to be mixed
+                 *
+                 * @return int Number of frames
+                 */
+                int queued() const { return static_cast<int>(this->ring.read_available()) / this->channels; }
+
+                /**
+                 * @brief Gets the number of periods this client fell behind on
+                 *
+                 * @return uint64_t Number of underruns
+                 */
+                uint64_t get_underruns() const { return this->underruns.load(std::memory_order_relaxed); }
+
+                /**
+                 * @brief Sets the gain of this client in the mix
+                 *
+                 * @param val Gain to apply
+                 */
+                void set_gain(sample_t val) { this->gain.store(val, std::memory_order_relaxed); }
+
+            private:
+
+                /// Interleaved frames waiting to be mixed
+                SPSCRing<sample_t> ring;
+
+                /// Number of interleaved channels
+                int channels = 1;
+
+                /// Gain of this client in the mix
+                std::atomic<sample_t> gain{1};
+
+                /// Number of underruns
+                std::atomic<uint64_t> underruns{0};
+
+                friend class DeviceMixer;
+        };
+
+        /**
+         * @brief Construct a new DeviceMixer object
+         *
+         * @param channels Number of interleaved channels
+         * @param period Number of frames mixed and written at once
+         * @param rate Sample rate in hertz, used to time out waiting on clients
+         */
+        DeviceMixer(int channels, int period, double rate = SAMPLE_RATE);
+
+        /// Destructor, stops the mixer thread
+        ~DeviceMixer();
+
+        DeviceMixer(const DeviceMixer&) = delete;
+        DeviceMixer& operator=(const DeviceMixer&) = delete;
+        DeviceMixer(DeviceMixer&&) = delete;
+        DeviceMixer& operator=(DeviceMixer&&) = delete;
+
+        /**
+         * @brief Sets the function that writes to the device
+         *
+         * This must be set before we are started.
+         *
+         * @param func Output function
+         */
+        void set_output(Output func) { this->output = std::move(func); }
+
+        /**
+         * @brief Sets the real-time options of the mixer thread
+         *
+         * This must be set before we are started.
+         *
+         * @param conf Options to apply
+         */
+        void set_rt_config(const RTConfig& conf) { this->config = conf; }
+
+        /**
+         * @brief Gets the real-time options applied to the mixer thread
+         *
+         * @return RTStatus Options that were applied
+         */
+        RTStatus get_rt_status() const { return this->status; }
+
+        /**
+         * @brief Attaches a new client
+         *
+         * @param capacity Number of frames the ring of the client can hold, at least one period
+         * @return std::shared_ptr<Client> New client, or nullptr if every slot is taken
+         */
+        std::shared_ptr<Client> attach(int capacity);
+
+        /**
+         * @brief Detaches a client
+         *
+         * Once this returns, the mixer thread no longer reads from the client.
+         *
+         * @param client Client to detach
+         */
+        void detach(const std::shared_ptr<Client>& client);
+
+        /**
+         * @brief Gets the number of attached clients
+         *
+         * @return int Number of clients
+         */
+        int clients() const;
+
+        /**
+         * @brief Mixes one period and writes it to the output
+         *
+         * Clients with less than a period queued give what they have,
+         * and count an underrun.
+         * This does not wait, and may be called by hand when the mixer thread is not running.
+         *
+         * @return int Number of clients mixed
+         */
+        int mix();
+
+        /**
+         * @brief Starts the mixer thread
+         */
+        void start();
+
+        /**
+         * @brief Stops the mixer thread
+         */
+        void stop();
+
+        /**
+         * @brief Determines if the mixer thread is running
+         *
+         * @return true If running
+         */
+        bool is_running() const { return this->running.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Gets the number of periods written to the output
+         *
+         * @return uint64_t Number of periods
+         */
+        uint64_t get_periods() const { return this->periods.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Gets the number of interleaved channels
+         *
+         * @return int Number of channels
+         */
+        int get_channels() const { return this->channels; }
+
+        /**
+         * @brief Gets the number of frames mixed at once
+         *
+         * @return int Number of frames
+         */
+        int get_period() const { return this->period; }
+
+        /**
+         * @brief Gets the sample rate of the mixer
+         *
+         * @return double Sample rate in hertz
+         */
+        double get_rate() const { return this->rate; }
+
+    private:
+
+        /**
+         * @brief Determines if every client has a period queued
+         *
+         * Like mix(), we hold off detach() while reading the clients.
+         *
+         * @return true If we can mix without underruns
+         */
+        bool clients_ready();
+
+        /**
+         * @brief Main loop of the mixer thread
+         */
+        void run();
+
+        /// Number of interleaved channels
+        int channels = 1;
+
+        /// Number of frames mixed at once
+        int period = BUFF_SIZE;
+
+        /// Sample rate in hertz
+        double rate = SAMPLE_RATE;
+
+        /// Function that writes to the device
+        Output output;
+
+        /// Clients being mixed, nullptr if the slot is free
+        std::array<std::atomic<Client*>, MAX_CLIENTS> slots{};
+
+        /// Owners of the attached clients
+        std::vector<std::shared_ptr<Client>> owners;
+
+        /// Lock protecting the owners
+        mutable std::mutex lock;
+
+        /// Mixed period
+        std::vector<sample_t> mixed;
+
+        /// Period read from a single client
+        std::vector<sample_t> scratch;
+
+        /// Value determining if mix() or clients_ready() is reading the slots
+        std::atomic<bool> mixing{false};
+
+        /// Mixer thread
+        std::thread mixer;
+
+        /// Value determining if the mixer thread should keep running
+        std::atomic<bool> running{false};
+
+        /// Number of periods written
+        std::atomic<uint64_t> periods{0};
+
+        /// Real-time options of the mixer thread
+        RTConfig config;
+
+        /// Real-time options that were applied
+        RTStatus status;
+};
+
+/**
+ * @brief A sink that feeds a DeviceMixer
+ *
+ * Use this in place of a device sink when the device is shared,
+ * the chain behind us is then mixed with the other clients of the mixer.
+ * Our channel count must match the mixer.
+ *
+ * When started, we attach to the mixer with a ring of a few periods.
+ * Each block we receive is written to the ring,
+ * and if the ring is full we wait for the mixer to make room,
+ * which paces the chain to the device.
+ * If the mixer is not running, blocks that don't fit are dropped.
+ */
+class MixerSink : public SinkModule {
+
+    public:
+
+        /**
+         * @brief Construct a new MixerSink object
+         *
+         * @param target Mixer to feed
+         * @param depth Number of mixer periods our ring can hold
+         */
+        explicit MixerSink(DeviceMixer& target, int depth = 4) : mixer(&target), depth(std::max(depth, 1)) {}
+
+        /// Destructor, detaches from the mixer
+        ~MixerSink() override;
+
+        MixerSink(const MixerSink&) = delete;
+        MixerSink& operator=(const MixerSink&) = delete;
+        MixerSink(MixerSink&&) = delete;
+        MixerSink& operator=(MixerSink&&) = delete;
+
+        /**
+         * @brief Writes the block we received into our ring
+         */
+        void process() override;
+
+        /**
+         * @brief Attaches to the mixer
+         */
+        void start() override;
+
+        /**
+         * @brief Detaches from the mixer
+         */
+        void stop() override;
+
+        /**
+         * @brief Gets our client of the mixer
+         *
+         * @return const DeviceMixer::Client* Client, or nullptr if not started
+         */
+        const DeviceMixer::Client* get_client() const { return this->client.get(); }
+
+        /**
+         * @brief Gets the number of frames dropped as the ring was full
+         *
+         * @return uint64_t Number of frames
+         */
+        uint64_t get_dropped() const { return this->dropped; }
+
+    private:
+
+        /// Mixer we feed
+        DeviceMixer* mixer = nullptr;
+
+        /// Number of mixer periods our ring can hold
+        int depth = 4;
+
+        /// Our client of the mixer
+        std::shared_ptr<DeviceMixer::Client> client;
+
+        /// Interleaved frames when buffers are planar
+        std::vector<sample_t> frames;
+
+        /// Number of frames dropped
+        uint64_t dropped = 0;
+};
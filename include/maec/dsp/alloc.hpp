@@ -0,0 +1,375 @@
+/**
+ * @file alloc.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Aligned allocators and arenas for buffers
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This file contains an allocator for buffer storage
+ * that makes guarantees SIMD kernels can rely on:
+ *
+ * - Every allocation starts on a BUFFER_ALIGN (64 byte) boundary,
+ *   which is the size of a cache line and of the widest vector registers
+ * - Every allocation is padded up to a multiple of BUFFER_ALIGN bytes,
+ *   so kernels may run full vectors past the end of the data without faulting
+ *
+ * The values in the padding are meaningless, kernels may read or clobber them freely.
+ * For planar buffers, each channel is also aligned
+ * when the number of samples in a channel is a multiple of aligned_width<T>()
+ * (which is true for all of the usual block sizes).
+ *
+ * Allocations can optionally be taken from a HugePageArena,
+ * which is useful for large offline renders where TLB misses add up.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/// Alignment of buffer storage in bytes
+constexpr std::size_t BUFFER_ALIGN = 64;
+
+/**
+ * @brief Determines the number of values of a type in one aligned block
+ *
+ * @tparam T Type of value
+ * @tparam Align Alignment in bytes
+ * @return std::size_t Number of values in an aligned block
+ */
+template <typename T, std::size_t Align = BUFFER_ALIGN>
+constexpr std::size_t aligned_width() {
+    return Align >= sizeof(T) ? Align / sizeof(T) : 1;
+}
+
+/**
+ * @brief Rounds a number of values up to the aligned width
+ *
+ * @tparam T Type of value
+ * @tparam Align Alignment in bytes
+ * @param num Number of values
+ * @return std::size_t Number of values after padding
+ */
+template <typename T, std::size_t Align = BUFFER_ALIGN>
+constexpr std::size_t aligned_size(std::size_t num) {
+
+    constexpr std::size_t width = aligned_width<T, Align>();
+
+    return ((num + width - 1) / width) * width;
+}
+
+/**
+ * @brief Determines the number of bytes held by a vector
+ *
+ * We count the capacity of the vector rather than its size,
+ * as that is what was allocated.
+ *
+ * @tparam T Type of value
+ * @tparam A Allocator type
+ * @param vec Vector to measure
+ * @return std::size_t Number of bytes held
+ */
+template <typename T, typename A>
+constexpr std::size_t heap_bytes(const std::vector<T, A>& vec) { return vec.capacity() * sizeof(T); }
+
+/**
+ * @brief A simple arena backed by huge pages
+ *
+ * We reserve one large region of memory up front,
+ * and hand out pieces of it in order.
+ * Individual allocations are never freed,
+ * all memory is released at once when the arena is reset or destroyed.
+ * This fits offline rendering well, where many large buffers are created
+ * and then thrown away together.
+ *
+ * On Linux we first try to map explicit huge pages,
+ * and fall back to normal pages with transparent huge pages requested.
+ * Elsewhere we simply use aligned memory.
+ * Use huge() to see if explicit huge pages were obtained.
+ *
+ * The arena must outlive all buffers allocated from it!
+ *
+ * Allocators pick up the 'current' arena of the calling thread when they are constructed.
+ * Use ArenaScope to set it:
+ *
+ * HugePageArena arena(1 << 30);
+ * {
+ *     ArenaScope scope(&arena);
+ *     // Buffers created here use the arena
+ * }
+ */
+class HugePageArena {
+public:
+
+    /**
+     * @brief Construct a new Huge Page Arena object
+     *
+     * @param bytes Number of bytes to reserve
+     */
+    explicit HugePageArena(std::size_t bytes);
+
+    /// Destructor, releases all memory
+    ~HugePageArena();
+
+    /// Arenas can not be copied
+    HugePageArena(const HugePageArena&) = delete;
+
+    /// Arenas can not be copied
+    HugePageArena& operator=(const HugePageArena&) = delete;
+
+    /**
+     * @brief Allocates memory from this arena
+     *
+     * @param bytes Number of bytes to allocate
+     * @param align Alignment of the memory
+     * @return void* Pointer to memory, nullptr if the arena is full
+     */
+    void* allocate(std::size_t bytes, std::size_t align);
+
+    /**
+     * @brief Determines if a pointer was allocated from this arena
+     *
+     * @param ptr Pointer to check
+     * @return true If the pointer lives in this arena
+     * @return false If not
+     */
+    bool owns(const void* ptr) const;
+
+    /**
+     * @brief Releases every allocation at once
+     *
+     * Only call this once no buffers are using the arena!
+     */
+    void reset() { this->used = 0; }
+
+    /**
+     * @brief Gets the number of bytes reserved by this arena
+     *
+     * @return std::size_t Number of bytes reserved
+     */
+    std::size_t capacity() const { return this->size; }
+
+    /**
+     * @brief Gets the number of bytes handed out
+     *
+     * @return std::size_t Number of bytes used
+     */
+    std::size_t allocated() const { return this->used; }
+
+    /**
+     * @brief Determines if explicit huge pages back this arena
+     *
+     * @return true If huge pages were obtained
+     * @return false If normal pages are in use
+     */
+    bool huge() const { return this->hugetlb; }
+
+    /**
+     * @brief Gets the current arena of this thread
+     *
+     * @return HugePageArena* Current arena, nullptr if none
+     */
+    static HugePageArena* current();
+
+    /**
+     * @brief Sets the current arena of this thread
+     *
+     * @param arena Arena to use, nullptr for none
+     */
+    static void set_current(HugePageArena* arena);
+
+private:
+
+    /// Start of the region
+    unsigned char* base = nullptr;
+
+    /// Size of the region in bytes
+    std::size_t size = 0;
+
+    /// Number of bytes handed out
+    std::size_t used = 0;
+
+    /// Determines if the region was mapped with explicit huge pages
+    bool hugetlb = false;
+
+    /// Determines if the region was mapped, rather than allocated
+    bool mapped = false;
+};
+
+/**
+ * @brief Sets the current arena for the lifetime of this object
+ *
+ * The previous arena is restored when we are destroyed.
+ */
+class ArenaScope {
+public:
+
+    /**
+     * @brief Construct a new Arena Scope object
+     *
+     * @param arena Arena to use in this scope
+     */
+    explicit ArenaScope(HugePageArena* arena) : previous(HugePageArena::current()) { HugePageArena::set_current(arena); }
+
+    /// Destructor, restores the previous arena
+    ~ArenaScope() { HugePageArena::set_current(this->previous); }
+
+    /// Scopes can not be copied
+    ArenaScope(const ArenaScope&) = delete;
+
+    /// Scopes can not be copied
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+private:
+
+    /// Arena to restore
+    HugePageArena* previous = nullptr;
+};
+
+/**
+ * @brief Allocations made by a thread
+ *
+ * Each thread counts the allocations made through the AlignedAllocator,
+ * which is used by all buffers.
+ * Instrumentation reads these before and after some work
+ * to determine how much that work allocated.
+ */
+struct AllocStats {
+
+    /// Number of allocations made
+    uint64_t count = 0;
+
+    /// Number of bytes allocated
+    uint64_t bytes = 0;
+};
+
+/**
+ * @brief Gets the allocations made by the calling thread
+ *
+ * @return AllocStats Allocations made so far
+ */
+AllocStats thread_alloc_stats();
+
+/**
+ * @brief Records an allocation made by the calling thread
+ *
+ * This is called by the AlignedAllocator,
+ * users should not need to call this!
+ *
+ * @param bytes Number of bytes allocated
+ */
+void count_allocation(std::size_t bytes);
+
+/**
+ * @brief Allocator that aligns and pads all allocations
+ *
+ * See the top of this file for the guarantees we make.
+ * If an arena was current when we were constructed,
+ * memory is taken from it when possible.
+ *
+ * @tparam T Type to allocate
+ * @tparam Align Alignment in bytes
+ */
+template <typename T, std::size_t Align = BUFFER_ALIGN>
+class AlignedAllocator {
+public:
+
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    /**
+     * @brief Rebinds this allocator to another type
+     *
+     * @tparam U Type to rebind to
+     */
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Align>;
+    };
+
+    /// Default constructor, picks up the current arena
+    AlignedAllocator() noexcept : arena(HugePageArena::current()) {}
+
+    /**
+     * @brief Constructs from an allocator of another type
+     *
+     * @tparam U Type of the other allocator
+     * @param other Allocator to copy
+     */
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Align>& other) noexcept : arena(other.get_arena()) {}  // NOLINT(google-explicit-constructor): Allocators must convert implicitly
+
+    /**
+     * @brief Allocates aligned and padded memory
+     *
+     * @param num Number of values to allocate
+     * @return T* Pointer to memory
+     */
+    T* allocate(std::size_t num) {
+
+        const std::size_t bytes = aligned_size<T, Align>(num) * sizeof(T);
+
+        count_allocation(bytes);
+
+        // Try the arena first:
+
+        if (this->arena != nullptr) {
+
+            void* ptr = this->arena->allocate(bytes, Align);
+
+            if (ptr != nullptr) {
+
+                return static_cast<T*>(ptr);
+            }
+        }
+
+        return static_cast<T*>(::operator new(bytes, std::align_val_t(Align)));
+    }
+
+    /**
+     * @brief Frees memory
+     *
+     * Memory from an arena is left alone, as it is released with the arena.
+     *
+     * @param ptr Pointer to free
+     * @param num Number of values allocated
+     */
+    void deallocate(T* ptr, [[maybe_unused]] std::size_t num) noexcept {
+
+        if (this->arena != nullptr && this->arena->owns(ptr)) {
+
+            return;
+        }
+
+        ::operator delete(ptr, std::align_val_t(Align));
+    }
+
+    /**
+     * @brief Gets the arena we allocate from
+     *
+     * @return HugePageArena* Arena in use, nullptr if none
+     */
+    HugePageArena* get_arena() const { return this->arena; }
+
+    /**
+     * @brief Determines if two allocators can free each other's memory
+     *
+     * @param other Allocator to compare
+     * @return true If both use the same arena
+     */
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Align>& other) const { return this->arena == other.get_arena(); }
+
+private:
+
+    /// Arena to allocate from
+    HugePageArena* arena = nullptr;
+};
@@ -0,0 +1,187 @@
+/**
+ * @file blep.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief PolyBLEP band-limited oscillator kernels
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The naive waveforms in dsp/osc.hpp jump (or bend) instantly,
+ * which produces harmonics far past the Nyquist frequency that fold back as aliasing.
+ * Wavetables (see dsp/wavetable.hpp) avoid this entirely, at the cost of memory.
+ * PolyBLEP is a lighter alternative: the naive waveform is kept,
+ * and the samples on either side of each discontinuity are corrected
+ * by a polynomial approximation of a band-limited step (BLEP).
+ *
+ * - Square and sawtooth waves jump, so they are corrected by a PolyBLEP
+ * - Triangle waves bend, so they are corrected by the integral of a PolyBLEP (PolyBLAMP)
+ *
+ * Aliasing is greatly reduced but not removed, mostly in the top octave.
+ * Only the two samples around each discontinuity are touched,
+ * so these are barely more expensive than the naive waveforms.
+ *
+ * The kernels follow the same rules as the ones in dsp/osc.hpp:
+ * phase is in turns, computed for each sample from the start phase,
+ * and every branch is a select.
+ * The waveforms match the phase and polarity of the naive ones.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Determines the width of the corrections for a phase increment
+ *
+ * Corrections span one sample on either side of a discontinuity,
+ * so the width is the absolute increment.
+ * We clamp it so the corrections of neighbouring discontinuities never overlap,
+ * and so a frequency of 0 never divides by 0.
+ *
+ * @param inc Phase increment per sample in turns
+ * @return double Width of the corrections in turns
+ */
+inline double blep_width(double inc) { return std::clamp(std::fabs(inc), 1e-12, 0.25); }
+
+/**
+ * @brief Computes the PolyBLEP correction for a step of 2
+ *
+ * The step happens at a phase of 0, rising from -1 to 1.
+ * Samples within one width after the step are pulled down,
+ * samples within one width before it are pulled up.
+ *
+ * @tparam T Type to work with
+ * @param turn Phase relative to the step in turns, wrapped into [0, 1)
+ * @param width Width of the correction, see blep_width()
+ * @return T Value to add to the naive sample
+ */
+template <typename T>
+inline T poly_blep(T turn, T width) {
+
+    const T head = turn / width;
+    const T tail = (turn - T(1)) / width;
+
+    const T after = head + head - head * head - T(1);
+    const T before = tail * tail + tail + tail + T(1);
+
+    return turn < width ? after : (turn > T(1) - width ? before : T(0));
+}
+
+/**
+ * @brief Computes the PolyBLAMP correction for a change in slope of 1 per sample
+ *
+ * This is the integral of poly_blep(),
+ * and smooths a corner at a phase of 0 where the slope rises.
+ * Scale the result by the change in slope in units per sample.
+ *
+ * @tparam T Type to work with
+ * @param turn Phase relative to the corner in turns, wrapped into [0, 1)
+ * @param width Width of the correction, see blep_width()
+ * @return T Value to add to the naive sample
+ */
+template <typename T>
+inline T poly_blamp(T turn, T width) {
+
+    const T head = T(1) - turn / width;
+    const T tail = T(1) - (T(1) - turn) / width;
+
+    const T after = head * head * head / T(6);
+    const T before = tail * tail * tail / T(6);
+
+    return turn < width ? after : (turn > T(1) - width ? before : T(0));
+}
+
+/**
+ * @brief Computes a single sample of a PolyBLEP square wave
+ *
+ * @param turn Phase in turns, wrapped into [0, 1)
+ * @param width Width of the corrections, see blep_width()
+ * @return double Band-limited sample
+ */
+inline double blep_square_turns(double turn, double width) {
+
+    const double half = turn < 0.5 ? turn + 0.5 : turn - 0.5;
+
+    return (turn < 0.5 ? 1.0 : -1.0) + poly_blep(turn, width) - poly_blep(half, width);
+}
+
+/**
+ * @brief Computes a single sample of a PolyBLEP sawtooth wave
+ *
+ * @param turn Phase in turns, wrapped into [0, 1)
+ * @param width Width of the corrections, see blep_width()
+ * @return double Band-limited sample
+ */
+inline double blep_sawtooth_turns(double turn, double width) {
+
+    const double half = turn < 0.5 ? turn + 0.5 : turn - 0.5;
+
+    return 2.0 * half - 1.0 - poly_blep(half, width);
+}
+
+/**
+ * @brief Computes a single sample of a PolyBLAMP triangle wave
+ *
+ * The slope is 4 turns per cycle, so each corner changes it by 8 * width per sample.
+ *
+ * @param turn Phase in turns, wrapped into [0, 1)
+ * @param width Width of the corrections, see blep_width()
+ * @return double Band-limited sample
+ */
+inline double blep_triangle_turns(double turn, double width) {
+
+    const double peak = turn < 0.25 ? turn + 0.75 : turn - 0.25;
+    const double trough = turn < 0.75 ? turn + 0.25 : turn - 0.75;
+
+    return 1.0 - 4.0 * std::fabs(trough - 0.5) + 8.0 * width * (poly_blamp(trough, width) - poly_blamp(peak, width));
+}
+
+/**
+ * @brief Fills a block with a PolyBLEP square wave
+ *
+ * @param out Pointer to output data
+ * @param size Number of samples to generate
+ * @param start Starting phase in turns
+ * @param inc Phase increment per sample in turns
+ */
+void osc_blep_square(float* out, int size, double start, double inc);
+
+/// @copydoc osc_blep_square(float*, int, double, double)
+void osc_blep_square(double* out, int size, double start, double inc);
+
+/// @copydoc osc_blep_square(float*, int, double, double)
+void osc_blep_square(long double* out, int size, double start, double inc);
+
+/**
+ * @brief Fills a block with a PolyBLEP sawtooth wave
+ *
+ * @param out Pointer to output data
+ * @param size Number of samples to generate
+ * @param start Starting phase in turns
+ * @param inc Phase increment per sample in turns
+ */
+void osc_blep_sawtooth(float* out, int size, double start, double inc);
+
+/// @copydoc osc_blep_sawtooth(float*, int, double, double)
+void osc_blep_sawtooth(double* out, int size, double start, double inc);
+
+/// @copydoc osc_blep_sawtooth(float*, int, double, double)
+void osc_blep_sawtooth(long double* out, int size, double start, double inc);
+
+/**
+ * @brief Fills a block with a PolyBLAMP triangle wave
+ *
+ * @param out Pointer to output data
+ * @param size Number of samples to generate
+ * @param start Starting phase in turns
+ * @param inc Phase increment per sample in turns
+ */
+void osc_blep_triangle(float* out, int size, double start, double inc);
+
+/// @copydoc osc_blep_triangle(float*, int, double, double)
+void osc_blep_triangle(double* out, int size, double start, double inc);
+
+/// @copydoc osc_blep_triangle(float*, int, double, double)
+void osc_blep_triangle(long double* out, int size, double start, double inc);
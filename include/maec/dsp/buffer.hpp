@@ -16,11 +16,13 @@
 
 #pragma once
 
+#include <algorithm>
 #include <iterator>
 #include <vector>
 #include <array>
 #include <initializer_list>
 #include <concepts>
+#include <span>
 
 #include "const.hpp"
 #include "util.hpp"
@@ -485,6 +487,72 @@ concept BufferContainer = requires(T typ) {
     typ.data();  // Access underlying data
 };
 
+/**
+ * @brief Layout policy for interleaved buffers
+ *
+ * Samples that occur at the same time are stored next to each other:
+ *
+ * [1,4,7,2,5,8,3,6,9]
+ *
+ * This is the format most audio devices and files use,
+ * and is the default layout of all maec buffers.
+ */
+struct Interleaved {
+
+    /// Determines if each channel is contiguous
+    static constexpr bool planar = false;
+
+    /**
+     * @brief Determines the offset of a sample in the underlying container
+     *
+     * @param channel Channel of the sample
+     * @param sample Index of the sample in the channel
+     * @param channels Number of channels in the buffer
+     * @param capacity Number of samples in each channel
+     * @return std::size_t Offset of the sample
+     */
+    static constexpr std::size_t offset(std::size_t channel, std::size_t sample, std::size_t channels, [[maybe_unused]] std::size_t capacity) {
+        return channel + (channels * sample);
+    }
+};
+
+/**
+ * @brief Layout policy for planar buffers
+ *
+ * Each channel is stored contiguously, one after the other:
+ *
+ * [1,2,3,4,5,6,7,8,9]
+ *
+ * This is the sequential format described below.
+ * Per channel operations (filters, envelopes, analysis)
+ * can then run over plain contiguous memory,
+ * which is much friendlier to the vectorizer than striding over interleaved data.
+ * Use the interleave kernels in dsp/interleave.hpp
+ * to convert at the boundaries of the graph.
+ */
+struct Planar {
+
+    /// Determines if each channel is contiguous
+    static constexpr bool planar = true;
+
+    /// @copydoc Interleaved::offset()
+    static constexpr std::size_t offset(std::size_t channel, std::size_t sample, [[maybe_unused]] std::size_t channels, std::size_t capacity) {
+        return (channel * capacity) + sample;
+    }
+};
+
+/**
+ * @brief A concept that defines a valid buffer layout
+ *
+ * @tparam L Type to check
+ */
+template <typename L>
+concept BufferLayout = requires(std::size_t val) {
+
+    { L::planar } -> std::convertible_to<bool>;  // Determines if channels are contiguous
+    { L::offset(val, val, val, val) } -> std::convertible_to<std::size_t>;  // Maps a position to an offset
+};
+
 /**
  * 
  * @brief Class for holding signal data
@@ -504,6 +572,12 @@ concept BufferContainer = requires(T typ) {
  * but we also provide methods and iterators to offer easy access into this data.
  * You could also implement this buffer as a type of matrix pretty easily.
  * 
+ * The order of samples in this array is determined by the layout policy 'L'.
+ * By default this is Interleaved, but Planar can be used
+ * to make each channel contiguous (see below for the formats).
+ * All iterators and accessors take the layout into account,
+ * so the only difference to users is the order of data().
+ * 
  * This buffer offers methods to determine the capacity of the vector
  * if every channel and sample was filled in.
  * It is recommended to NEVER iterate over a buffer that is only
@@ -601,7 +675,7 @@ concept BufferContainer = requires(T typ) {
  * Also implement reverse constant iterators?
  *
  */
-template <BufferContainer B, typename T = B::value_type>
+template <BufferContainer B, typename T = B::value_type, BufferLayout L = Interleaved>
 class BaseBuffer {
 public:
 
@@ -618,6 +692,7 @@ public:
     using const_pointer = const value_type*;
 
     using container = B;  /// Container this class utilizes
+    using layout = L;  /// Layout of samples in the container
 
     /**
      * @brief An iterator that iterates over signal data sequentially
@@ -659,7 +734,7 @@ public:
     class SeqIterator : public BaseMAECIterator<BaseBuffer::SeqIterator<IsConst>, T, IsConst> {
 
        public:
-        using BufferType = typename ChooseType<IsConst, const BaseBuffer<B, T>, BaseBuffer<B, T>>::type;
+        using BufferType = typename ChooseType<IsConst, const BaseBuffer<B, T, L>, BaseBuffer<B, T, L>>::type;
         using reference = typename BaseMAECIterator<BaseBuffer::SeqIterator<IsConst>, T, IsConst>::reference;
         using pointer = typename BaseMAECIterator<BaseBuffer::SeqIterator<IsConst>, T, IsConst>::pointer;
 
@@ -733,7 +808,18 @@ public:
          *
          */
         pointer resolve_pointer(int index) const {
-            return this->buff->buff.data() + (this->get_channel(index) + this->buff->channels() * this->get_sample(index));
+
+            if constexpr (L::planar) {
+
+                // Sequential order is the storage order:
+
+                return this->buff->buff.data() + index;
+            }
+
+            else {
+
+                return this->buff->buff.data() + L::offset(this->get_channel(index), this->get_sample(index), this->buff->channels(), this->buff->channel_capacity());
+            }
         }
 
         /**
@@ -872,7 +958,7 @@ public:
     class InterIterator : public BaseMAECIterator<InterIterator<IsConst>, T, IsConst> {
     public:
 
-        using BufferType = typename ChooseType<IsConst, const BaseBuffer<B, T>, BaseBuffer<B, T>>::type;
+        using BufferType = typename ChooseType<IsConst, const BaseBuffer<B, T, L>, BaseBuffer<B, T, L>>::type;
         using reference = typename BaseMAECIterator<InterIterator<IsConst>, T, IsConst>::reference;
         using pointer = typename BaseMAECIterator<InterIterator<IsConst>, T, IsConst>::pointer;
 
@@ -921,7 +1007,20 @@ public:
          * and return it many times.
          *
          */
-        pointer resolve_pointer(int index) const { return this->buff->buff.data() + index; }
+        pointer resolve_pointer(int index) const {
+
+            if constexpr (L::planar) {
+
+                return this->buff->buff.data() + L::offset(this->get_channel(index), this->get_sample(index), this->buff->channels(), this->buff->channel_capacity());
+            }
+
+            else {
+
+                // Interleaved order is the storage order:
+
+                return this->buff->buff.data() + index;
+            }
+        }
 
         /**
          * @brief Gets the current channel we are on
@@ -1208,6 +1307,66 @@ public:
      */
     constexpr double get_samplerate() const { return this->sample_rate; }
 
+    /**
+     * @brief Marks every value of this buffer as the given value
+     *
+     * This is a hint for the components that read this buffer,
+     * which may skip work that would produce the same result for each value
+     * (such as scaling or filtering silence).
+     * We do not change the contents, they must already hold the value!
+     * See fill_constant() for filling and marking in one go.
+     *
+     * Components that change the contents without
+     * honoring this hint must call clear_constant().
+     *
+     * @param val Value held by every element
+     */
+    constexpr void set_constant(T val) { this->constant = true; this->constant_value = val; }
+
+    /**
+     * @brief Fills this buffer with a value and marks it as constant
+     *
+     * @param val Value to fill with
+     */
+    constexpr void fill_constant(T val) {
+
+        std::ranges::fill(this->buff, val);
+
+        this->set_constant(val);
+    }
+
+    /**
+     * @brief Removes the constant hint
+     *
+     * The contents are left alone.
+     */
+    constexpr void clear_constant() { this->constant = false; }
+
+    /**
+     * @brief Determines if every value of this buffer is the same
+     *
+     * @return true If this buffer is marked as constant
+     * @return false If the contents are unknown
+     */
+    constexpr bool is_constant() const { return this->constant; }
+
+    /**
+     * @brief Determines if every value of this buffer is zero
+     *
+     * @return true If this buffer is marked as constant with a value of zero
+     * @return false If the contents are unknown or not zero
+     */
+    constexpr bool is_silent() const { return this->constant && this->constant_value == T{}; }
+
+    /**
+     * @brief Gets the value every element holds
+     *
+     * This is only meaningful if is_constant() is true.
+     *
+     * @return T Constant value
+     */
+    constexpr T get_constant() const { return this->constant_value; }
+
     /**
      * @brief Gets the size of this buffer.
      * 
@@ -1264,7 +1423,7 @@ public:
      * 
      * @param other Container to copy from
      */
-    constexpr void assign(const B& other) { this->buff = other; }
+    constexpr void assign(const B& other) { this->buff = other; this->constant = false; }
 
     /**
      * @brief Move assignment operation
@@ -1275,7 +1434,7 @@ public:
      * 
      * @param other Container to move from
      */
-    constexpr void assign(B&& other) { this->buff = std::move(other); }
+    constexpr void assign(B&& other) { this->buff = std::move(other); this->constant = false; }
 
     /**
      * @brief Gets the value at the given channel and sample.
@@ -1290,7 +1449,7 @@ public:
      * @return Value at the given channel and sample
      */
     constexpr reference at(int channel, int sample) {
-        return this->buff[channel + (this->channels() * sample)];
+        return this->buff[L::offset(channel, sample, this->channels(), this->channel_capacity())];
     }
 
     /**
@@ -1304,7 +1463,7 @@ public:
      * @return Value at the given channel and sample
      */
     constexpr const_reference at(int channel, int sample) const {
-        return this->buff[channel + (this->channels() * sample)];
+        return this->buff[L::offset(channel, sample, this->channels(), this->channel_capacity())];
     }
 
     /**
@@ -1517,6 +1676,84 @@ public:
      */
     constexpr BaseBuffer::InterIterator<> end() { return this->iend(); }
 
+    /**
+     * @brief Gets a pointer to the underlying data
+     *
+     * The data is stored in the format of our layout,
+     * and is contiguous in memory.
+     * This is useful for kernels that want to operate
+     * on raw memory without the overhead of iterators.
+     *
+     * @return T* Pointer to the first value
+     */
+    constexpr T* data() { return this->buff.data(); }
+
+    /**
+     * @brief Gets a const pointer to the underlying data
+     *
+     * @return const T* Pointer to the first value
+     */
+    constexpr const T* data() const { return this->buff.data(); }
+
+    /**
+     * @brief Gets a pointer to the start of a channel
+     *
+     * This is only available for planar buffers,
+     * where every channel is a contiguous span of channel_capacity() samples.
+     *
+     * @param channel Channel to get
+     * @return T* Pointer to the first sample in the channel
+     */
+    constexpr T* channel_data(int channel) requires(L::planar) { return this->buff.data() + (channel * this->channel_capacity()); }
+
+    /**
+     * @brief Gets a const pointer to the start of a channel
+     *
+     * @param channel Channel to get
+     * @return const T* Pointer to the first sample in the channel
+     */
+    constexpr const T* channel_data(int channel) const requires(L::planar) { return this->buff.data() + (channel * this->channel_capacity()); }
+
+    /**
+     * @brief Gets a view of all values in the buffer
+     *
+     * The view is in the order of our layout, see data().
+     * Spans are plain pointers with a size,
+     * so loops over them carry no iterator bookkeeping and vectorize well.
+     * Operations that treat every value the same (fills, gains, mixing)
+     * should work through this view.
+     *
+     * @return std::span<T> View of all values
+     */
+    constexpr std::span<T> span() { return std::span<T>(this->buff.data(), this->size()); }
+
+    /**
+     * @brief Gets a const view of all values in the buffer
+     *
+     * @return std::span<const T> View of all values
+     */
+    constexpr std::span<const T> span() const { return std::span<const T>(this->buff.data(), this->size()); }
+
+    /**
+     * @brief Gets a view of a single channel
+     *
+     * This is only available for planar buffers,
+     * as the channels of interleaved buffers are not contiguous.
+     * Interleaved buffers should use span() and step by channels().
+     *
+     * @param channel Channel to get
+     * @return std::span<T> View of the channel
+     */
+    constexpr std::span<T> channel_span(int channel) requires(L::planar) { return std::span<T>(this->channel_data(channel), this->channel_capacity()); }
+
+    /**
+     * @brief Gets a const view of a single channel
+     *
+     * @param channel Channel to get
+     * @return std::span<const T> View of the channel
+     */
+    constexpr std::span<const T> channel_span(int channel) const requires(L::planar) { return std::span<const T>(this->channel_data(channel), this->channel_capacity()); }
+
 protected:
     /**
      * @brief Gets the underlying buffer container
@@ -1528,6 +1765,9 @@ protected:
      */
     constexpr B& get_buff() { return this->buff; }
 
+    /// @copydoc get_buff()
+    constexpr const B& get_buff() const { return this->buff; }
+
 private:
     /// Underlying container holding data
     B buff;
@@ -1538,6 +1778,12 @@ private:
     /// Sample rate in Hertz
     double sample_rate = SAMPLE_RATE;
 
+    /// Value held by every element, if constant
+    T constant_value{};
+
+    /// Determines if every element holds the constant value
+    bool constant = false;
+
     /// Various friend defintions
     friend class BaseBuffer::SeqIterator<>;
     friend class BaseBuffer::SeqIterator<true>;
@@ -1545,8 +1791,8 @@ private:
     friend class BaseBuffer::InterIterator<true>;
 };
 
-template<typename T>
-class Buffer : public BaseBuffer<std::vector<T>> {
+template<typename T, BufferLayout L = Interleaved, typename Alloc = std::allocator<T>>
+class Buffer : public BaseBuffer<std::vector<T, Alloc>, T, L> {
 public:
 
     Buffer() = default;
@@ -1564,7 +1810,7 @@ public:
      */
     constexpr explicit Buffer(int size, int channels = 1,
                              double sra = SAMPLE_RATE)
-        : BaseBuffer<std::vector<T>>(size, channels, sra) {}
+        : BaseBuffer<std::vector<T, Alloc>, T, L>(size, channels, sra) {}
 
     /**
      * @brief Construct a new Audio Buffer object
@@ -1579,7 +1825,7 @@ public:
      */
     constexpr explicit Buffer(std::size_t size, int channels = 1,
                              double sra = SAMPLE_RATE)
-        : BaseBuffer<std::vector<T>>(size, channels, sra) {}
+        : BaseBuffer<std::vector<T, Alloc>, T, L>(size, channels, sra) {}
 
     /**
      * @brief Construct a new Audio Buffer object
@@ -1593,9 +1839,27 @@ public:
      * @param vect Vector of samples
      * @param channels Number of channels
      */
-    constexpr explicit Buffer(const std::vector<T>& vect, int channels = 1,
+    constexpr explicit Buffer(const std::vector<T, Alloc>& vect, int channels = 1,
                              double sra = SAMPLE_RATE)
-        : BaseBuffer<std::vector<T>>(vect, channels, sra) {}
+        : BaseBuffer<std::vector<T, Alloc>, T, L>(vect, channels, sra) {}
+
+    /**
+     * @brief Construct a new Audio Buffer object
+     *
+     * Identical to the above constructor,
+     * but accepts vectors that use a different allocator.
+     * The contents are copied into our own storage.
+     *
+     * @tparam A Allocator of the given vector
+     * @param vect Vector of samples
+     * @param channels Number of channels
+     * @param sra The sample rate to utilize in this buffer
+     */
+    template <typename A>
+        requires(!std::same_as<Alloc, A>)
+    constexpr explicit Buffer(const std::vector<T, A>& vect, int channels = 1,
+                             double sra = SAMPLE_RATE)
+        : BaseBuffer<std::vector<T, Alloc>, T, L>(vect.begin(), vect.end(), channels, sra) {}
 
     /**
      * @brief Constructs using the iterator constructor of the undelying
@@ -1617,7 +1881,7 @@ public:
     template <class ITER1, class ITER2>
     constexpr explicit Buffer(const ITER1& begin, const ITER2& end,
                              int channels = 1, double sra = SAMPLE_RATE)
-        : BaseBuffer<std::vector<T>>(begin, end, channels, sra) {}
+        : BaseBuffer<std::vector<T, Alloc>, T, L>(begin, end, channels, sra) {}
 
     /**
      * @brief Constructs using an initializer list
@@ -1632,7 +1896,7 @@ public:
      */
     constexpr Buffer(const std::initializer_list<T>& list, int channels = 1,
                     double sra = SAMPLE_RATE)
-        : BaseBuffer<std::vector<T>>(list, channels, sra) {}
+        : BaseBuffer<std::vector<T, Alloc>, T, L>(list, channels, sra) {}
 
     /**
      * @brief Constructs using variadic templates
@@ -1643,7 +1907,7 @@ public:
      */
     template <typename... A>
         requires(std::convertible_to<A, T> && ...)
-    constexpr Buffer(A... vals) : BaseBuffer<std::vector<T>>(vals...) {}
+    constexpr Buffer(A... vals) : BaseBuffer<std::vector<T, Alloc>, T, L>(vals...) {}
 
     /// Destructor
     constexpr ~Buffer() = default;
@@ -1661,7 +1925,7 @@ public:
     constexpr Buffer& operator=(Buffer&&) noexcept = default;
 
     /// Container copy assignment TODO: TEST
-    constexpr Buffer& operator=(const BaseBuffer<std::vector<T>>::container& other) {
+    constexpr Buffer& operator=(const BaseBuffer<std::vector<T, Alloc>, T, L>::container& other) {
 
         this->assign(other);
 
@@ -1669,7 +1933,7 @@ public:
     }
 
     /// Container move assignment TODO: TEST
-    constexpr Buffer& operator=(BaseBuffer<std::vector<T>>::container&& other) {
+    constexpr Buffer& operator=(BaseBuffer<std::vector<T, Alloc>, T, L>::container&& other) {
 
         this->assign(std::move(other));
 
@@ -1693,15 +1957,27 @@ public:
      */
     constexpr void reserve(std::size_t size) { this->get_buff().reserve(size); }
 
+    /**
+     * @brief Gets the number of bytes held by this buffer
+     *
+     * We count the capacity of the vector rather than its size,
+     * as that is what was allocated.
+     *
+     * @return std::size_t Number of bytes held
+     */
+    constexpr std::size_t bytes() const { return this->get_buff().capacity() * sizeof(T); }
+
     /**
      * @brief Resizes the vector size
      *
      * This method resizes the vector to the provided elements.
      * https://en.cppreference.com/w/cpp/container/vector/resize
      *
+     * New values are zero, so the constant hint is removed.
+     *
      * @param size Size to resize vector to
      */
-    constexpr void resize(int size) { this->get_buff().resize(size); }
+    constexpr void resize(int size) { this->get_buff().resize(size); this->clear_constant(); }
 
     /**
      * @brief Shrinks the vector to it's current size
@@ -1750,8 +2026,8 @@ public:
     constexpr void push_back(const T& val) { this->get_buff().push_back(val); }
 };
 
-template<typename T, std::size_t SIZE>
-class StaticBuffer : public BaseBuffer<std::array<T, SIZE>> {
+template<typename T, std::size_t SIZE, BufferLayout L = Interleaved>
+class StaticBuffer : public BaseBuffer<std::array<T, SIZE>, T, L> {
 public:
 
     StaticBuffer() = default;
@@ -1781,7 +2057,7 @@ public:
      */
     template<typename... A>
         requires (std::convertible_to<A, T> && ...)
-    StaticBuffer(A... vals) : BaseBuffer<std::array<T, SIZE>>(vals...) {}
+    StaticBuffer(A... vals) : BaseBuffer<std::array<T, SIZE>, T, L>(vals...) {}
 
     /// Destructor
     ~StaticBuffer() = default;
@@ -1799,7 +2075,7 @@ public:
     StaticBuffer& operator=(StaticBuffer&&) noexcept = default;
 
     /// Container copy assignment TODO: TEST
-    constexpr StaticBuffer& operator=(const BaseBuffer<std::array<T, SIZE>>::container& other) {
+    constexpr StaticBuffer& operator=(const BaseBuffer<std::array<T, SIZE>, T, L>::container& other) {
 
         this->assign(other);
 
@@ -1808,7 +2084,7 @@ public:
 
     /// Container move assignment TODO: TEST
     constexpr StaticBuffer& operator=(
-        BaseBuffer<std::array<T, SIZE>>::container&& other) {
+        BaseBuffer<std::array<T, SIZE>, T, L>::container&& other) {
 
         this->assign(std::move(other));
 
@@ -26,9 +26,13 @@
 
 #pragma once
 
+#include <algorithm>
+#include <complex>
 #include <memory>
+#include <vector>
 
 #include "audio_buffer.hpp"
+#include "dsp/fft_backend.hpp"
 #include "dsp/ft.hpp"
 
 /**
@@ -274,44 +278,902 @@ BufferPointer output_conv(BufferPointer input, BufferPointer kernel);
  * removing much of the complexities involved with FFT convolution.
  */
 
+/**
+ * @brief Preforms a convolution via frequency domain multiplication
+ *
+ * We zero pad the input and kernel to a power of two
+ * that is large enough to hold the full result,
+ * transform both using the real FFT backend, multiply,
+ * and transform back.
+ * The output will contain length_conv(input_size, kernel_size) values.
+ *
+ * This function allocates working memory and prepares a backend on each call,
+ * so it is best for one-off convolutions.
+ * If you are convolving a stream with the same kernel,
+ * then OverlapSave or PartitionedConv will be much faster.
+ *
+ * @tparam I Input iterator type
+ * @tparam K Kernel iterator type
+ * @tparam O Output iterator type
+ * @param input Start iterator of input data
+ * @param input_size Size of input data
+ * @param kernel Start iterator of kernel
+ * @param kernel_size Size of kernel
+ * @param output Start iterator of output data
+ */
 template<typename I, typename K, typename O>
 void conv_fft(I input, int input_size, K kernel, int kernel_size, O output) {
 
     // First, determine output size:
 
-    int output_size = length_conv(input_size, kernel_size);
+    const int output_size = length_conv(input_size, kernel_size);
 
-    // Next, create new vectors for input and kernel
-    // TODO: RESEARCH OTHER METHODS! This can take a lot of memory...
-    // Not to mention being super slow in theory...
+    int fsize = 2;
 
-    std::vector<long double> pinput(output_size);
-    std::vector<long double> pkernel(output_size);
+    while (fsize < output_size) {
 
-    // Fill normal content:
+        fsize *= 2;
+    }
+
+    const int bins = length_ft(fsize);
+
+    // Create padded input and kernel:
+
+    std::vector<long double> pinput(fsize);
+    std::vector<long double> pkernel(fsize);
 
     std::copy_n(input, input_size, pinput.begin());
     std::copy_n(kernel, kernel_size, pkernel.begin());
 
-    // Fill in zero components:
-
-    std::fill_n(pinput.begin() + input_size, output_size - input_size, 0.0);
-    std::fill_n(pkernel.begin() + kernel_size, output_size - kernel_size, 0.0);
+    // Transform both signals:
 
-    // For now, define array for output data:
+    std::vector<std::complex<long double>> finput(bins);
+    std::vector<std::complex<long double>> fkernel(bins);
 
-    std::vector<std::complex<long double>> infp(output_size);
-    std::vector<std::complex<long double>> kernfp(output_size);
-    std::vector<std::complex<long double>> outf(output_size);
+    RealFFTBackend<long double> backend(fsize);
 
-    fft_r_radix2(input, input_size, infp.begin());
-    fft_r_radix2(kernel, kernel_size, kernfp.begin());
+    backend.forward(pinput.data(), finput.data());
+    backend.forward(pkernel.data(), fkernel.data());
 
     // Multiply signals:
 
-    multiply_signals(output_size, infp.begin(), kernfp.begin(), outf.begin());
+    multiply_signals(bins, finput.begin(), fkernel.begin(), finput.begin());
+
+    // Send result back through inverse FFT:
+
+    backend.inverse(finput.data(), pinput.data());
+
+    std::copy_n(pinput.begin(), output_size, output);
+}
+
+/**
+ * @brief Computes the dot product of two contiguous arrays
+ *
+ * We keep four independent accumulators,
+ * which breaks the dependency between each multiply-add.
+ * This allows the compiler to vectorize the loop
+ * and keeps the pipeline full, even without fast math.
+ *
+ * @tparam T Type of data to work with
+ * @param aval Pointer to first array
+ * @param bval Pointer to second array
+ * @param size Number of values to use
+ * @return T Dot product of the two arrays
+ */
+template <typename T>
+T fir_dot(const T* aval, const T* bval, int size) {
+
+    T acc0 = 0;
+    T acc1 = 0;
+    T acc2 = 0;
+    T acc3 = 0;
+
+    int i = 0;
 
-    // Send inputs back through inverse FFT:
+    // Multiply-add four values at once:
+
+    for (; i + 4 <= size; i += 4) {
+
+        acc0 += aval[i] * bval[i];
+        acc1 += aval[i + 1] * bval[i + 1];
+        acc2 += aval[i + 2] * bval[i + 2];
+        acc3 += aval[i + 3] * bval[i + 3];
+    }
+
+    // Handle the remainder:
+
+    for (; i < size; ++i) {
+
+        acc0 += aval[i] * bval[i];
+    }
 
-    ifft_r_radix2(outf.begin(), output_size, output);
+    return (acc0 + acc1) + (acc2 + acc3);
 }
+
+/**
+ * @brief Streaming direct form FIR filter
+ *
+ * Direct convolution outputs the full convolution of each block,
+ * including the tail, which makes each output block larger than the input.
+ * This class instead keeps the last (kernel size - 1) input samples as history,
+ * and carries them over to the next block.
+ * The result is that each input block produces exactly one block of output,
+ * and the output is identical to filtering the signal all at once.
+ *
+ * The history and the new block are kept in one contiguous window,
+ * and the kernel is stored reversed.
+ * This allows each output sample to be computed as a single
+ * dot product over contiguous memory, which vectorizes nicely.
+ * A RingBuffer would save the history shift at the end of each block,
+ * but the wrap around would break up the dot product.
+ *
+ * This is best for small to medium kernels,
+ * for large kernels check out OverlapSave.
+ *
+ * @tparam T Type of data to work with
+ */
+template <typename T>
+class StreamFIR {
+
+    private:
+
+        /// Kernel, stored in reverse order
+        std::vector<T> rkernel;
+
+        /// Kernel being faded to, stored in reverse order
+        std::vector<T> rnext;
+
+        /// Window of history followed by the current block
+        std::vector<T> window;
+
+    public:
+
+        StreamFIR() =default;
+
+        /**
+         * @brief Construct a new StreamFIR object
+         *
+         * @param kbegin Start iterator of the kernel
+         * @param ksize Size of the kernel
+         * @param block Expected size of each block
+         */
+        template <typename K>
+        StreamFIR(K kbegin, int ksize, int block) { this->set_kernel(kbegin, ksize, block); }
+
+        /**
+         * @brief Sets the kernel to utilize
+         *
+         * We copy the kernel and allocate the window.
+         * The block size is only a hint, larger blocks may be processed
+         * but will cause the window to be reallocated.
+         * Any previous input history is cleared.
+         *
+         * @tparam K Kernel iterator type
+         * @param kbegin Start iterator of the kernel
+         * @param ksize Size of the kernel
+         * @param block Expected size of each block
+         */
+        template <typename K>
+        void set_kernel(K kbegin, int ksize, int block) {
+
+            // Copy the kernel in reverse:
+
+            this->rkernel.resize(ksize);
+            this->rnext.resize(ksize);
+
+            std::reverse_copy(kbegin, kbegin + ksize, this->rkernel.begin());
+
+            // Allocate the window:
+
+            this->window.assign(this->history() + block, T(0));
+        }
+
+        /**
+         * @brief Processes incoming samples
+         *
+         * We filter the input samples and place the result in the output.
+         * The output must have room for size samples,
+         * and may be the same as the input.
+         *
+         * @tparam I Input iterator type
+         * @tparam O Output iterator type
+         * @param input Start iterator of input data
+         * @param size Number of samples to process
+         * @param output Start iterator of output data
+         */
+        template <typename I, typename O>
+        void process(I input, int size, O output) {
+
+            const int hist = this->history();
+            const int ksize = static_cast<int>(this->rkernel.size());
+
+            // Ensure the window is large enough:
+
+            if (static_cast<int>(this->window.size()) < hist + size) {
+
+                this->window.resize(hist + size);
+            }
+
+            // Copy the block after the history:
+
+            std::copy_n(input, size, this->window.begin() + hist);
+
+            // Compute each output sample:
+
+            const T* wdata = this->window.data();
+            const T* kdata = this->rkernel.data();
+
+            for (int i = 0; i < size; ++i) {
+
+                *(output + i) = fir_dot(wdata + i, kdata, ksize);
+            }
+
+            // Carry the end of the window over as history:
+
+            std::copy(this->window.begin() + size, this->window.begin() + size + hist, this->window.begin());
+        }
+
+        /**
+         * @brief Processes incoming samples while fading to a new kernel
+         *
+         * The output is computed with both the current and the new kernel,
+         * and is faded linearly from the current to the new over this block.
+         * Afterwards the new kernel is used.
+         *
+         * The new kernel MUST be the same size as the current one,
+         * which keeps the history intact and avoids any allocation.
+         *
+         * @tparam K Kernel iterator type
+         * @tparam I Input iterator type
+         * @tparam O Output iterator type
+         * @param next Start iterator of the new kernel
+         * @param input Start iterator of input data
+         * @param size Number of samples to process
+         * @param output Start iterator of output data
+         */
+        template <typename K, typename I, typename O>
+        void fade(K next, I input, int size, O output) {
+
+            const int hist = this->history();
+            const int ksize = static_cast<int>(this->rkernel.size());
+
+            if (static_cast<int>(this->window.size()) < hist + size) {
+
+                this->window.resize(hist + size);
+            }
+
+            std::reverse_copy(next, next + ksize, this->rnext.begin());
+
+            std::copy_n(input, size, this->window.begin() + hist);
+
+            const T* wdata = this->window.data();
+            const T* kdata = this->rkernel.data();
+            const T* ndata = this->rnext.data();
+
+            const T step = T(1) / static_cast<T>(std::max(size, 1));
+
+            for (int i = 0; i < size; ++i) {
+
+                const T gain = step * static_cast<T>(i + 1);
+
+                const T first = fir_dot(wdata + i, kdata, ksize);
+                const T second = fir_dot(wdata + i, ndata, ksize);
+
+                *(output + i) = first + (second - first) * gain;
+            }
+
+            std::copy(this->window.begin() + size, this->window.begin() + size + hist, this->window.begin());
+
+            // Adopt the new kernel:
+
+            std::swap(this->rkernel, this->rnext);
+        }
+
+        /**
+         * @brief Clears the input history
+         *
+         * After this call, processing behaves as if
+         * the signal was silent before the next block.
+         */
+        void reset() { std::fill(this->window.begin(), this->window.end(), T(0)); }
+
+        /**
+         * @brief Gets the number of history samples carried between blocks
+         *
+         * @return int Number of history samples
+         */
+        int history() const { return this->rkernel.empty() ? 0 : static_cast<int>(this->rkernel.size()) - 1; }
+
+        /**
+         * @brief Gets the number of bytes held by the kernels
+         *
+         * @return std::size_t Number of bytes held
+         */
+        std::size_t kernel_bytes() const { return heap_bytes(this->rkernel) + heap_bytes(this->rnext); }
+
+        /**
+         * @brief Gets the number of bytes held by the history window
+         *
+         * @return std::size_t Number of bytes held
+         */
+        std::size_t bytes() const { return heap_bytes(this->window); }
+};
+
+/**
+ * @brief Shared pointer to the spectrum of a kernel
+ *
+ * Kernel spectra are immutable once computed,
+ * so many convolution engines (i.e one per channel)
+ * can share a single copy.
+ * Spectra are kept in sample_t precision,
+ * the same as the signals they are applied to.
+ */
+using SpectrumPointer = std::shared_ptr<const std::vector<std::complex<sample_t>>>;
+
+/**
+ * @brief Streaming FFT convolution via the overlap-save method
+ *
+ * Convolving long kernels directly costs O(N*M) per block,
+ * which gets very expensive once kernels reach hundreds of taps.
+ * This class preforms block convolution in the frequency domain,
+ * and keeps state between blocks so a continuous signal can be filtered
+ * one block at a time.
+ *
+ * The overlap-save algorithm works like so:
+ *
+ * - Keep the last N input samples in a window, where N is the FFT size
+ * - When new samples arrive, shift them into the window
+ * - Transform the window, multiply by the kernel spectrum, and transform back
+ * - The last samples of the result are valid convolution output,
+ *   the rest are corrupted by circular wrap-around and discarded
+ *
+ * The FFT size is chosen to be the smallest power of two
+ * that can fit a block and the kernel (block + kernel - 1).
+ * The kernel spectrum is computed once when the kernel is set,
+ * and is reused for every block.
+ *
+ * For every input sample we produce exactly one output sample,
+ * with no added latency.
+ * Blocks of any size can be processed,
+ * they are split into chunks no larger than the configured block size.
+ *
+ * https://en.wikipedia.org/wiki/Overlap%E2%80%93save_method
+ */
+class OverlapSave {
+
+    private:
+
+        /// Size of the FFT
+        int fft_size = 0;
+
+        /// Max number of samples per chunk
+        int block_size = 0;
+
+        /// Cached spectrum of the kernel
+        SpectrumPointer kernel_freq = nullptr;
+
+        /// Window of previous input samples
+        std::vector<sample_t> window;
+
+        /// Working buffer for frequency data
+        std::vector<std::complex<sample_t>> freq;
+
+        /// Working buffer for time data
+        std::vector<sample_t> time;
+
+        /// Backend for the forward and inverse transforms
+        RealFFTBackend<sample_t> plan;
+
+        /**
+         * @brief Runs a chunk of samples through the convolution
+         *
+         * The new samples must already be present at the end of the window.
+         * The output is placed at the end of the time buffer.
+         *
+         */
+        void run();
+
+        /**
+         * @brief Shifts the window to make room for new samples
+         *
+         * @param num Number of new samples
+         */
+        void shift(int num);
+
+        /**
+         * @brief Allocates working memory for the current FFT size
+         *
+         */
+        void allocate();
+
+    public:
+
+        OverlapSave() =default;
+
+        /**
+         * @brief Construct a new Overlap Save object
+         *
+         * @param kbegin Start iterator of the kernel
+         * @param ksize Size of the kernel
+         * @param block Max size of each block
+         */
+        template <typename K>
+        OverlapSave(K kbegin, int ksize, int block) { this->set_kernel(kbegin, ksize, block); }
+
+        /**
+         * @brief Sets the kernel to utilize
+         *
+         * We determine the FFT size, allocate all working memory,
+         * and compute the spectrum of the kernel.
+         * This should be done before processing starts,
+         * as it requires allocation and an FFT.
+         * Any previous input history is cleared.
+         *
+         * @tparam K Kernel iterator type
+         * @param kbegin Start iterator of the kernel
+         * @param ksize Size of the kernel
+         * @param block Max size of each block
+         */
+        template <typename K>
+        void set_kernel(K kbegin, int ksize, int block) {
+
+            // Allocate and fill in the padded kernel:
+
+            std::vector<sample_t> pkern(this->prepare(ksize, block));
+
+            std::copy_n(kbegin, ksize, pkern.begin());
+
+            // Compute the kernel spectrum:
+
+            auto spec = std::make_shared<std::vector<std::complex<sample_t>>>(length_ft(this->fft_size));
+
+            this->plan.forward(pkern.data(), spec->data());
+
+            this->kernel_freq = std::move(spec);
+        }
+
+        /**
+         * @brief Shares the kernel of another engine
+         *
+         * We take on the kernel spectrum and sizes of the other engine,
+         * without copying or recomputing the spectrum.
+         * Each engine still keeps its own input history,
+         * so this is great for filtering many channels with the same kernel.
+         *
+         * @param other Engine to share the kernel with
+         */
+        void share_kernel(const OverlapSave& other);
+
+        /**
+         * @brief Gets the kernel spectrum in use
+         *
+         * @return SpectrumPointer Shared kernel spectrum
+         */
+        SpectrumPointer get_spectrum() const { return this->kernel_freq; }
+
+        /**
+         * @brief Processes incoming samples
+         *
+         * We convolve the input samples with the kernel
+         * and place the result in the output.
+         * The output must have room for size samples.
+         *
+         * @tparam I Input iterator type
+         * @tparam O Output iterator type
+         * @param input Start iterator of input data
+         * @param size Number of samples to process
+         * @param output Start iterator of output data
+         */
+        template <typename I, typename O>
+        void process(I input, int size, O output) {
+
+            int done = 0;
+
+            while (done < size) {
+
+                // Determine the size of this chunk:
+
+                const int num = std::min(this->block_size, size - done);
+
+                // Shift the new samples into the window:
+
+                this->shift(num);
+
+                std::copy_n(input + done, num, this->window.end() - num);
+
+                // Run the convolution:
+
+                this->run();
+
+                // Copy the valid samples to the output:
+
+                std::copy(this->time.end() - num, this->time.end(), output + done);
+
+                done += num;
+            }
+        }
+
+        /**
+         * @brief Processes incoming samples while fading to a new kernel spectrum
+         *
+         * Each chunk is convolved with both the current and the new spectrum,
+         * and the output is faded linearly from the current to the new over this block.
+         * Afterwards the new spectrum is used.
+         *
+         * The new spectrum MUST be computed for the same FFT size,
+         * for example by another engine given a kernel of the same size and block size.
+         *
+         * @tparam I Input iterator type
+         * @tparam O Output iterator type
+         * @param next New kernel spectrum
+         * @param input Start iterator of input data
+         * @param size Number of samples to process
+         * @param output Start iterator of output data
+         */
+        template <typename I, typename O>
+        void fade(SpectrumPointer next, I input, int size, O output) {
+
+            SpectrumPointer current = this->kernel_freq;
+
+            const sample_t step = sample_t(1) / static_cast<sample_t>(std::max(size, 1));
+
+            int done = 0;
+
+            while (done < size) {
+
+                const int num = std::min(this->block_size, size - done);
+
+                this->shift(num);
+
+                std::copy_n(input + done, num, this->window.end() - num);
+
+                // Convolve with the current spectrum:
+
+                this->kernel_freq = current;
+
+                this->run();
+
+                std::copy(this->time.end() - num, this->time.end(), output + done);
+
+                // Convolve with the new spectrum, and fade between them:
+
+                this->kernel_freq = next;
+
+                this->run();
+
+                const auto* ndata = this->time.data() + (this->time.size() - num);
+
+                for (int i = 0; i < num; ++i) {
+
+                    const sample_t first = *(output + done + i);
+                    const sample_t gain = step * static_cast<sample_t>(done + i + 1);
+
+                    *(output + done + i) = first + (ndata[i] - first) * gain;
+                }
+
+                done += num;
+            }
+
+            this->kernel_freq = std::move(next);
+        }
+
+        /**
+         * @brief Prepares internal state for a kernel
+         *
+         * We determine the FFT size and allocate working memory.
+         * This is called for you by set_kernel().
+         *
+         * @param ksize Size of the kernel
+         * @param block Max size of each block
+         * @return int Size of the FFT
+         */
+        int prepare(int ksize, int block);
+
+        /**
+         * @brief Clears the input history
+         *
+         * After this call, processing behaves as if
+         * the signal was silent before the next block.
+         */
+        void reset();
+
+        /**
+         * @brief Gets the FFT size in use
+         *
+         * @return int FFT size
+         */
+        int get_fft_size() const { return this->fft_size; }
+
+        /**
+         * @brief Gets the max block size
+         *
+         * @return int Max size of each chunk
+         */
+        int get_block_size() const { return this->block_size; }
+
+        /**
+         * @brief Gets the number of bytes held by the kernel spectrum
+         *
+         * The spectrum may be shared with other engines,
+         * in which case each of them counts it.
+         *
+         * @return std::size_t Number of bytes held
+         */
+        std::size_t kernel_bytes() const { return this->kernel_freq != nullptr ? heap_bytes(*this->kernel_freq) : 0; }
+
+        /**
+         * @brief Gets the number of bytes held by the transforms
+         *
+         * @return std::size_t Number of bytes held
+         */
+        std::size_t plan_bytes() const { return this->plan.bytes(); }
+
+        /**
+         * @brief Gets the number of bytes held by the working buffers
+         *
+         * @return std::size_t Number of bytes held
+         */
+        std::size_t bytes() const { return heap_bytes(this->window) + heap_bytes(this->freq) + heap_bytes(this->time); }
+};
+
+/**
+ * @brief Uniformly partitioned FFT convolution
+ *
+ * Very long kernels, such as reverb impulse responses several seconds long,
+ * are too large to convolve with a single FFT per block at low latency.
+ * Instead, we split the kernel into partitions the size of a block,
+ * and keep the spectra of past input blocks in a frequency domain delay line.
+ * Each block, we only transform the new input once,
+ * and then multiply-accumulate it against every kernel partition.
+ *
+ * The work per block is one forward and one inverse real FFT of twice the block size,
+ * plus one complex multiply-add per bin (block size + 1) per partition.
+ * No FFT work depends upon the length of the kernel,
+ * and latency is zero (beyond the block itself).
+ *
+ * Blocks of any size can be processed.
+ * Input that does not fill a partition is transformed as it arrives,
+ * with the rest of the partition left as zeros,
+ * and is committed to the delay line once the partition is full.
+ * The sum over older partitions only changes once per partition,
+ * so it is computed once and reused for the rest of the partition.
+ * Blocks of the partition size are the cheapest,
+ * smaller blocks cost one forward and inverse FFT each.
+ */
+class PartitionedConv {
+
+    private:
+
+        /// Size of each partition (and block)
+        int part_size = 0;
+
+        /// Number of partitions
+        int part_num = 0;
+
+        /// Position of the newest spectrum in the delay line
+        int head = 0;
+
+        /// Number of samples in the current partition
+        int fill = 0;
+
+        /// Spectra of each kernel partition
+        SpectrumPointer kernel_freq = nullptr;
+
+        /// Frequency domain delay line of input spectra
+        std::vector<std::complex<sample_t>> fdl;
+
+        /// Window of the last two input blocks
+        std::vector<sample_t> window;
+
+        /// Accumulator for frequency data
+        std::vector<std::complex<sample_t>> accum;
+
+        /// Sum of the older partitions, for the current partition
+        std::vector<std::complex<sample_t>> tail;
+
+        /// Working buffer for time data
+        std::vector<sample_t> time;
+
+        /// Backend for the forward and inverse transforms
+        RealFFTBackend<sample_t> plan;
+
+        /**
+         * @brief Processes the current partition of input
+         *
+         * The input so far must already be present in the second half of the window,
+         * with the rest of the partition zeroed.
+         * The output is placed in the second half of the time buffer.
+         */
+        void run();
+
+        /**
+         * @brief Moves on to the next partition
+         *
+         * The current partition is left in the delay line,
+         * and the window is shifted to make room for new input.
+         */
+        void commit();
+
+        /**
+         * @brief Allocates working memory for the current sizes
+         *
+         */
+        void allocate();
+
+    public:
+
+        PartitionedConv() =default;
+
+        /**
+         * @brief Construct a new Partitioned Conv object
+         *
+         * @tparam K Kernel iterator type
+         * @param kbegin Start iterator of kernel
+         * @param ksize Size of kernel
+         * @param psize Size of each partition
+         */
+        template <typename K>
+        PartitionedConv(K kbegin, int ksize, int psize) { this->set_kernel(kbegin, ksize, psize); }
+
+        /**
+         * @brief Sets the kernel to utilize
+         *
+         * We split the kernel into partitions and compute the spectrum of each one.
+         * All working memory is allocated here,
+         * so this should be called before processing starts.
+         * Any previous input history is cleared.
+         *
+         * @tparam K Kernel iterator type
+         * @param kbegin Start iterator of kernel
+         * @param ksize Size of kernel
+         * @param psize Size of each partition, should be a power of two
+         */
+        template <typename K>
+        void set_kernel(K kbegin, int ksize, int psize) {
+
+            this->prepare(ksize, psize);
+
+            const int fsize = 2 * this->part_size;
+            const int bins = this->part_size + 1;
+
+            std::vector<sample_t> pkern(fsize);
+
+            auto spec = std::make_shared<std::vector<std::complex<sample_t>>>(static_cast<std::size_t>(bins) * this->part_num);
+
+            for (int p = 0; p < this->part_num; ++p) {
+
+                // Copy this partition into the first half of padded buffer:
+
+                std::fill(pkern.begin(), pkern.end(), 0);
+
+                const int num = std::min(this->part_size, ksize - p * this->part_size);
+
+                std::copy_n(kbegin + p * this->part_size, num, pkern.begin());
+
+                // Compute the spectrum of this partition:
+
+                this->plan.forward(pkern.data(), spec->data() + p * bins);
+            }
+
+            this->kernel_freq = std::move(spec);
+        }
+
+        /**
+         * @brief Shares the kernel of another engine
+         *
+         * We take on the partition spectra and sizes of the other engine,
+         * without copying or recomputing them.
+         * Each engine still keeps its own delay line.
+         *
+         * @param other Engine to share the kernel with
+         */
+        void share_kernel(const PartitionedConv& other);
+
+        /**
+         * @brief Gets the partition spectra in use
+         *
+         * @return SpectrumPointer Shared partition spectra
+         */
+        SpectrumPointer get_spectrum() const { return this->kernel_freq; }
+
+        /**
+         * @brief Processes incoming samples
+         *
+         * We convolve the input samples with the kernel
+         * and place the result in the output.
+         * The output must have room for size samples.
+         *
+         * @tparam I Input iterator type
+         * @tparam O Output iterator type
+         * @param input Start iterator of input data
+         * @param size Number of samples to process
+         * @param output Start iterator of output data
+         */
+        template <typename I, typename O>
+        void process(I input, int size, O output) {
+
+            int done = 0;
+
+            while (done < size) {
+
+                // Determine how much of the partition we can fill:
+
+                const int num = std::min(this->part_size - this->fill, size - done);
+                const int start = this->part_size + this->fill;
+
+                // Add the new input to the window:
+
+                std::copy_n(input + done, num, this->window.begin() + start);
+
+                // Run the convolution:
+
+                this->run();
+
+                // Copy out the valid samples:
+
+                std::copy_n(this->time.begin() + start, num, output + done);
+
+                this->fill += num;
+                done += num;
+
+                if (this->fill == this->part_size) {
+
+                    this->commit();
+                }
+            }
+        }
+
+        /**
+         * @brief Allocates working memory for a kernel
+         *
+         * This is called for you by set_kernel().
+         *
+         * @param ksize Size of the kernel
+         * @param psize Size of each partition
+         */
+        void prepare(int ksize, int psize);
+
+        /**
+         * @brief Clears the input history
+         *
+         */
+        void reset();
+
+        /**
+         * @brief Gets the partition size
+         *
+         * @return int Size of each partition
+         */
+        int get_partition_size() const { return this->part_size; }
+
+        /**
+         * @brief Gets the number of partitions
+         *
+         * @return int Number of partitions
+         */
+        int get_partitions() const { return this->part_num; }
+
+        /**
+         * @brief Gets the number of bytes held by the partition spectra
+         *
+         * The spectra may be shared with other engines,
+         * in which case each of them counts it.
+         *
+         * @return std::size_t Number of bytes held
+         */
+        std::size_t kernel_bytes() const { return this->kernel_freq != nullptr ? heap_bytes(*this->kernel_freq) : 0; }
+
+        /**
+         * @brief Gets the number of bytes held by the transforms
+         *
+         * @return std::size_t Number of bytes held
+         */
+        std::size_t plan_bytes() const { return this->plan.bytes(); }
+
+        /**
+         * @brief Gets the number of bytes held by the delay line and working buffers
+         *
+         * @return std::size_t Number of bytes held
+         */
+        std::size_t bytes() const { return heap_bytes(this->fdl) + heap_bytes(this->window) + heap_bytes(this->accum) + heap_bytes(this->tail) + heap_bytes(this->time); }
+};
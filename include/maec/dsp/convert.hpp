@@ -0,0 +1,317 @@
+/**
+ * @file convert.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Batch sample format converters
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This file contains kernels that convert a block of mf samples
+ * into the formats audio devices and files expect.
+ * These are much faster than calling a conversion function per sample
+ * (like mf_int16() with squish_inter()),
+ * as the whole block is converted in one tight loop that the compiler can vectorize.
+ * Like the oscillator kernels, these are built for multiple instruction sets
+ * and the best one is selected at runtime.
+ *
+ * Integer conversions clamp the input to [-1, 1],
+ * scale symmetrically and round to the nearest value.
+ *
+ * Dithered conversions add triangular (TPDF) noise of one LSB
+ * before rounding, which decorrelates the quantization error from the signal.
+ * This is recommended when converting to 16 bits.
+ * The dither state should be kept between calls, and must not be zero.
+ * The Dither class offers a faster dithered conversion,
+ * which runs a generator per lane so the noise can be vectorized,
+ * and can optionally shape the quantization noise away from the frequencies we hear best.
+ *
+ * We also offer conversions in the other direction,
+ * which take samples from a device or file and convert them into mf samples.
+ * Integer values are scaled so the largest positive value maps to 1.
+ *
+ * Finally, we offer PCM codecs that work with raw bytes,
+ * such as the contents of a wave file.
+ * These support the common sample formats (unsigned 8 bit, signed 16, packed 24 and 32 bit,
+ * and 32 bit IEEE float), in either byte order.
+ * Bytes are assembled with shifts rather than by casting pointers,
+ * so the results are the same regardless of the byte order of the host.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "audio_buffer.hpp"
+
+/**
+ * @brief Converts mf samples into 32 bit floats
+ *
+ * @param input Pointer to input samples
+ * @param output Pointer to output samples
+ * @param num Number of samples to convert
+ */
+void convert_float(const sample_t* input, float* output, std::size_t num);
+
+/**
+ * @brief Converts mf samples into signed 32 bit integers
+ *
+ * @param input Pointer to input samples
+ * @param output Pointer to output samples
+ * @param num Number of samples to convert
+ */
+void convert_int32(const sample_t* input, int32_t* output, std::size_t num);
+
+/**
+ * @brief Converts mf samples into signed 16 bit integers
+ *
+ * @param input Pointer to input samples
+ * @param output Pointer to output samples
+ * @param num Number of samples to convert
+ */
+void convert_int16(const sample_t* input, int16_t* output, std::size_t num);
+
+/**
+ * @brief Converts mf samples into signed 16 bit integers with dither
+ *
+ * @param input Pointer to input samples
+ * @param output Pointer to output samples
+ * @param num Number of samples to convert
+ * @param state State of the dither generator, updated in place
+ */
+void convert_int16_dither(const sample_t* input, int16_t* output, std::size_t num, uint32_t& state);
+
+/// Number of dither generators run side by side
+constexpr int DITHER_LANES = 8;
+
+/**
+ * @brief Converts mf samples into signed 16 bit integers with dither from many generators
+ *
+ * This is the same as convert_int16_dither(const sample_t*, int16_t*, std::size_t, uint32_t&),
+ * but sample i gets its noise from generator (i % DITHER_LANES),
+ * so the generators can be advanced as one vector (see Dither).
+ *
+ * @param input Pointer to input samples
+ * @param output Pointer to output samples
+ * @param num Number of samples to convert
+ * @param lanes State of DITHER_LANES generators, updated in place, none may be zero
+ */
+void convert_int16_dither(const sample_t* input, int16_t* output, std::size_t num, uint32_t* lanes);
+
+/**
+ * @brief Filters that shape dither noise
+ *
+ * Shaping feeds the quantization error of previous samples back into the next ones,
+ * which moves the noise towards high frequencies where it is less audible,
+ * at the cost of more noise overall.
+ */
+enum class NoiseShaping {
+    None,  /// Flat noise, the error is not fed back
+    FirstOrder,  /// Noise is shaped by (1 - z^-1)
+    SecondOrder  /// Noise is shaped by (1 - z^-1)^2
+};
+
+/**
+ * @brief Converts mf samples into 16 bits with TPDF dither and optional noise shaping
+ *
+ * A single xorshift generator has a dependency from each value to the next,
+ * so the noise for each sample has to wait on the previous one.
+ * We keep DITHER_LANES generators instead, and give sample i the noise of lane (i % DITHER_LANES),
+ * so a whole vector of noise is made at once and flat dither costs about the same as rounding.
+ * Each 32 bit value gives one triangular value, the difference of its two halves.
+ *
+ * Noise shaping keeps the last two errors of each channel,
+ * and is run one frame at a time as each error depends on the last.
+ * The error history is sized by the first conversion of a given number of channels,
+ * so conversions should be started with a block of the final channel count before entering a real-time context.
+ *
+ * The state is carried between calls, so consecutive blocks of a stream
+ * should be converted with the same Dither, and blocks must hold whole frames.
+ */
+class Dither {
+
+    public:
+
+        /**
+         * @brief Construct a new Dither object
+         *
+         * @param seed Seed of the generators
+         * @param shape Noise shaping to use
+         */
+        explicit Dither(uint32_t seed = 0x9E3779B9, NoiseShaping shape = NoiseShaping::None) : shaping(shape) { this->set_seed(seed); }
+
+        /**
+         * @brief Seeds the generators
+         *
+         * Each lane is seeded with a different value derived from the seed.
+         *
+         * @param seed Seed, 0 is replaced with 1
+         */
+        void set_seed(uint32_t seed);
+
+        /**
+         * @brief Sets the noise shaping to use
+         *
+         * This clears the error history.
+         *
+         * @param shape Noise shaping
+         */
+        void set_shaping(NoiseShaping shape) { this->shaping = shape; this->reset(); }
+
+        /**
+         * @brief Gets the noise shaping in use
+         *
+         * @return NoiseShaping Noise shaping
+         */
+        NoiseShaping get_shaping() const { return this->shaping; }
+
+        /**
+         * @brief Clears the error history
+         */
+        void reset() { std::fill(this->error.begin(), this->error.end(), 0.0); }
+
+        /**
+         * @brief Converts a block of interleaved samples
+         *
+         * @param input Pointer to input samples
+         * @param output Pointer to output samples
+         * @param num Number of samples to convert
+         * @param channels Number of interleaved channels
+         */
+        void process(const sample_t* input, int16_t* output, std::size_t num, int channels = 1);
+
+    private:
+
+        /// State of each generator
+        alignas(32) uint32_t lanes[DITHER_LANES] = {};
+
+        /// Last two errors of each channel, in LSBs
+        std::vector<double> error;
+
+        /// Noise shaping to use
+        NoiseShaping shaping = NoiseShaping::None;
+};
+
+/**
+ * @brief Converts 32 bit floats into mf samples
+ *
+ * @param input Pointer to input samples
+ * @param output Pointer to output samples
+ * @param num Number of samples to convert
+ */
+void convert_from_float(const float* input, sample_t* output, std::size_t num);
+
+/**
+ * @brief Converts signed 32 bit integers into mf samples
+ *
+ * @param input Pointer to input samples
+ * @param output Pointer to output samples
+ * @param num Number of samples to convert
+ */
+void convert_from_int32(const int32_t* input, sample_t* output, std::size_t num);
+
+/**
+ * @brief Converts signed 16 bit integers into mf samples
+ *
+ * @param input Pointer to input samples
+ * @param output Pointer to output samples
+ * @param num Number of samples to convert
+ */
+void convert_from_int16(const int16_t* input, sample_t* output, std::size_t num);
+
+/**
+ * @brief Raw PCM sample formats
+ *
+ * These describe how a single sample is stored in raw bytes.
+ */
+enum class PCMFormat {
+    none,  /// Unsupported format
+    u8,    /// Unsigned 8 bit integer, 128 is silence
+    s16,   /// Signed 16 bit integer
+    s24,   /// Signed 24 bit integer, packed into 3 bytes
+    s32,   /// Signed 32 bit integer
+    f32    /// 32 bit IEEE float
+};
+
+/**
+ * @brief Determines the PCM format of a sample
+ *
+ * @param bits Number of bits per sample
+ * @param floating Whether samples are IEEE floats
+ * @return PCMFormat Format of the samples, PCMFormat::none if unsupported
+ */
+PCMFormat pcm_format(int bits, bool floating);
+
+/**
+ * @brief Determines the number of bytes a sample occupies
+ *
+ * @param format Format of the sample
+ * @return std::size_t Number of bytes in a sample, 0 if unsupported
+ */
+std::size_t pcm_width(PCMFormat format);
+
+/**
+ * @brief Decodes raw PCM bytes into mf samples
+ *
+ * The input must contain num * pcm_width(format) bytes.
+ * Unsupported formats leave the output untouched.
+ *
+ * @param format Format of the input samples
+ * @param input Pointer to raw sample bytes
+ * @param output Pointer to output samples
+ * @param num Number of samples to decode
+ * @param big_endian Whether the input bytes are big endian
+ */
+void pcm_decode(PCMFormat format, const char* input, sample_t* output, std::size_t num, bool big_endian = false);
+
+/**
+ * @brief Encodes mf samples into raw PCM bytes
+ *
+ * The output must have space for num * pcm_width(format) bytes.
+ * Integer formats clamp and round like the converters above.
+ * Unsupported formats leave the output untouched.
+ *
+ * @param format Format of the output samples
+ * @param input Pointer to input samples
+ * @param output Pointer to raw sample bytes
+ * @param num Number of samples to encode
+ * @param big_endian Whether the output bytes should be big endian
+ */
+void pcm_encode(PCMFormat format, const sample_t* input, char* output, std::size_t num, bool big_endian = false);
+
+/**
+ * @brief Decodes raw PCM bytes into signed 16 bit samples
+ *
+ * This is used by fixed point paths (see fixed.hpp),
+ * where 16 bit samples are Q15 values.
+ * Signed 16 bit input is copied straight through,
+ * wider integers are rounded into 16 bits,
+ * and unsigned 8 bit values are shifted up.
+ * Floats are clamped and scaled like the converters above.
+ * Unsupported formats leave the output untouched.
+ *
+ * @param format Format of the input samples
+ * @param input Pointer to raw sample bytes
+ * @param output Pointer to output samples
+ * @param num Number of samples to decode
+ * @param big_endian Whether the input bytes are big endian
+ */
+void pcm_decode(PCMFormat format, const char* input, int16_t* output, std::size_t num, bool big_endian = false);
+
+/**
+ * @brief Encodes signed 16 bit samples into raw PCM bytes
+ *
+ * Signed 16 bit output is copied straight through,
+ * wider integers are shifted up, and unsigned 8 bit values are rounded.
+ * Unsupported formats leave the output untouched.
+ *
+ * @param format Format of the output samples
+ * @param input Pointer to input samples
+ * @param output Pointer to raw sample bytes
+ * @param num Number of samples to encode
+ * @param big_endian Whether the output bytes should be big endian
+ */
+void pcm_encode(PCMFormat format, const int16_t* input, char* output, std::size_t num, bool big_endian = false);
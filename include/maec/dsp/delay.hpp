@@ -0,0 +1,388 @@
+/**
+ * @file delay.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Fractional delay lines
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This file contains a delay line, and the kernels that read from it.
+ * Delay lines are the basis of echoes, chorus, flangers and reverbs.
+ *
+ * Like the SPSCRing, the capacity of the delay line is a power of two,
+ * so positions are wrapped with a mask rather than a modulo.
+ * We also mirror the start of the line past the end,
+ * so a block can always be read from contiguous memory, no matter where it starts.
+ * This allows the read kernels to work over straight runs of memory,
+ * which vectorize well.
+ *
+ * Delays can be fractional, and are interpolated (see DelayInterp).
+ * Any number of taps can read from a single line,
+ * so many taps only cost one buffer and one write.
+ *
+ * Like the mixing kernels, these are compiled for multiple instruction sets when possible.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "dsp/alloc.hpp"
+
+/**
+ * @brief Methods of interpolating fractional delays
+ *
+ * Each method needs some history around the delayed position,
+ * which sets the smallest delay it can read (see delay_lookahead()).
+ *
+ * - None - Delays are truncated to whole samples
+ * - Linear - Linear interpolation between two samples, cheap but dulls high frequencies as the delay moves
+ * - Cubic - Four point Hermite interpolation, a smoother response at a higher cost
+ * - Allpass - First order allpass interpolation, has a flat magnitude response,
+ *   but keeps state, so works best with slowly moving delays
+ */
+enum class DelayInterp { None, Linear, Cubic, Allpass };
+
+/**
+ * @brief Gets the amount of history an interpolation method reads past the delayed position
+ *
+ * Delays smaller than this can't be read from a block that has just been written.
+ *
+ * @param interp Interpolation method
+ * @return double Smallest delay in samples
+ */
+constexpr double delay_lookahead(DelayInterp interp) {
+
+    switch (interp) {
+
+        case DelayInterp::Cubic:
+            return 1;
+
+        case DelayInterp::Allpass:
+            return 0.5;
+
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Reads a block with the same fractional delay using linear interpolation
+ *
+ * out[i] = in[i] + frac * (in[i + 1] - in[i])
+ *
+ * @param in Pointer to num + 1 older samples
+ * @param out Pointer to store results
+ * @param num Number of samples to read
+ * @param frac Position between each pair of samples
+ */
+void delay_linear(const float* in, float* out, int num, float frac);
+
+/// @copydoc delay_linear(const float*, float*, int, float)
+void delay_linear(const double* in, double* out, int num, double frac);
+
+/// @copydoc delay_linear(const float*, float*, int, float)
+void delay_linear(const long double* in, long double* out, int num, long double frac);
+
+/**
+ * @brief Reads a block with the same fractional delay using cubic interpolation
+ *
+ * We interpolate between in[i] and in[i + 1] using a four point Hermite spline,
+ * so in[-1] and in[num + 1] must also be valid.
+ *
+ * @param in Pointer to samples
+ * @param out Pointer to store results
+ * @param num Number of samples to read
+ * @param frac Position between each pair of samples
+ */
+void delay_cubic(const float* in, float* out, int num, float frac);
+
+/// @copydoc delay_cubic(const float*, float*, int, float)
+void delay_cubic(const double* in, double* out, int num, double frac);
+
+/// @copydoc delay_cubic(const float*, float*, int, float)
+void delay_cubic(const long double* in, long double* out, int num, long double frac);
+
+/**
+ * @brief Reads a block with the same fractional delay using allpass interpolation
+ *
+ * out[i] = eta * (in[i + 1] - out[i - 1]) + in[i]
+ *
+ * @param in Pointer to num + 1 older samples
+ * @param out Pointer to store results
+ * @param num Number of samples to read
+ * @param eta Allpass coefficient
+ * @param state Last output value, updated with our last output
+ */
+void delay_allpass(const float* in, float* out, int num, float eta, float& state);
+
+/// @copydoc delay_allpass(const float*, float*, int, float, float&)
+void delay_allpass(const double* in, double* out, int num, double eta, double& state);
+
+/// @copydoc delay_allpass(const float*, float*, int, float, float&)
+void delay_allpass(const long double* in, long double* out, int num, long double eta, long double& state);
+
+/**
+ * @brief Reads a block with a different delay for each sample
+ *
+ * Output i is read delays[i] samples before position (pos + i) of the line.
+ * Positions are wrapped with the mask, and the line must be mirrored
+ * so the samples after the last index can be read.
+ *
+ * @param line Pointer to the delay line
+ * @param mask Mask used to wrap positions
+ * @param pos Position of the first output
+ * @param delays Delay of each output, in samples
+ * @param out Pointer to store results
+ * @param num Number of samples to read
+ * @param interp Interpolation method
+ * @param state Last output value, only used for allpass interpolation
+ */
+void delay_gather(const float* line, std::size_t mask, std::size_t pos, const float* delays, float* out, int num, DelayInterp interp, float& state);
+
+/// @copydoc delay_gather(const float*, std::size_t, std::size_t, const float*, float*, int, DelayInterp, float&)
+void delay_gather(const double* line, std::size_t mask, std::size_t pos, const double* delays, double* out, int num, DelayInterp interp, double& state);
+
+/// @copydoc delay_gather(const float*, std::size_t, std::size_t, const float*, float*, int, DelayInterp, float&)
+void delay_gather(const long double* line, std::size_t mask, std::size_t pos, const long double* delays, long double* out, int num, DelayInterp interp, long double& state);
+
+/**
+ * @brief A circular buffer of past samples that can be read at fractional delays
+ *
+ * Samples are written a block at a time, and then any number of taps
+ * may read blocks at different delays.
+ * Reads are relative to the start of the block being processed,
+ * which may or may not have been written yet:
+ *
+ * - When there is no feedback, write the block first, then read with written = num.
+ *   Delays down to delay_lookahead() can then be read.
+ * - When the taps feed back into the line, read first with written = 0, then write.
+ *   Each block read this way may be no longer than (delay - delay_lookahead()).
+ *
+ * Delays are given in samples, and should be no larger than the maximum delay we were reserved with.
+ * Reads are fastest when the delay is the same for the whole block,
+ * as the interpolation weights are shared and samples are read from contiguous memory.
+ *
+ * Allpass interpolation is recursive,
+ * so each tap must provide its own state to every read.
+ *
+ * @tparam T Type of samples to store
+ */
+template <typename T>
+class DelayLine {
+
+    public:
+
+        DelayLine() =default;
+
+        /**
+         * @brief Construct a new DelayLine object
+         *
+         * @param delay Maximum delay in samples
+         * @param block Maximum number of samples written or read at once
+         */
+        DelayLine(int delay, int block) { this->reserve(delay, block); }
+
+        /**
+         * @brief Reserves room for a maximum delay and block size
+         *
+         * This clears the line.
+         *
+         * @param delay Maximum delay in samples
+         * @param block Maximum number of samples written or read at once
+         */
+        void reserve(int delay, int block) {
+
+            // Determine the capacity, room for the delay plus a block and the interpolation points:
+
+            std::size_t size = 1;
+
+            const auto needed = static_cast<std::size_t>(std::max(delay, 0) + std::max(block, 1) + 4);
+
+            while (size < needed) {
+
+                size <<= 1;
+            }
+
+            this->mask = size - 1;
+            this->guard = static_cast<std::size_t>(std::max(block, 1) + 4);
+            this->max_delay = std::max(delay, 0);
+            this->max_block = std::max(block, 1);
+
+            this->buff.assign(size + this->guard, 0);
+            this->head = 0;
+        }
+
+        /**
+         * @brief Gets the capacity of this line
+         *
+         * @return std::size_t Number of samples held
+         */
+        std::size_t capacity() const { return this->mask + 1; }
+
+        /**
+         * @brief Gets the maximum delay
+         *
+         * @return int Maximum delay in samples
+         */
+        int get_max_delay() const { return this->max_delay; }
+
+        /**
+         * @brief Gets the maximum block size
+         *
+         * @return int Maximum number of samples written or read at once
+         */
+        int get_max_block() const { return this->max_block; }
+
+        /**
+         * @brief Gets the write position
+         *
+         * @return std::size_t Total number of samples written
+         */
+        std::size_t position() const { return this->head; }
+
+        /**
+         * @brief Gets the number of bytes held by this line
+         *
+         * @return std::size_t Number of bytes held
+         */
+        std::size_t bytes() const { return heap_bytes(this->buff); }
+
+        /**
+         * @brief Clears the line to silence
+         */
+        void clear() {
+
+            std::fill(this->buff.begin(), this->buff.end(), 0);
+        }
+
+        /**
+         * @brief Writes a block of samples
+         *
+         * @param in Pointer to samples to write
+         * @param num Number of samples, no more than the maximum block size
+         */
+        void write(const T* in, int num) {
+
+            const std::size_t size = this->capacity();
+            const std::size_t start = this->head & this->mask;
+            const auto count = static_cast<std::size_t>(num);
+
+            // Write up to the end of the line, and wrap the rest to the start:
+
+            const std::size_t first = std::min(count, size - start);
+
+            std::copy_n(in, first, this->buff.begin() + static_cast<std::ptrdiff_t>(start));
+            std::copy_n(in + first, count - first, this->buff.begin());
+
+            // Mirror anything written to the start after the end:
+
+            if (start < this->guard) {
+
+                const std::size_t end = std::min(this->guard, start + first);
+
+                std::copy(this->buff.begin() + static_cast<std::ptrdiff_t>(start), this->buff.begin() + static_cast<std::ptrdiff_t>(end),
+                          this->buff.begin() + static_cast<std::ptrdiff_t>(size + start));
+            }
+
+            if (first < count) {
+
+                const std::size_t wrapped = std::min(this->guard, count - first);
+
+                std::copy_n(this->buff.begin(), wrapped, this->buff.begin() + static_cast<std::ptrdiff_t>(size));
+            }
+
+            this->head += count;
+        }
+
+        /**
+         * @brief Reads a block with the same delay for every sample
+         *
+         * @param out Pointer to store results
+         * @param num Number of samples to read
+         * @param delay Delay in samples
+         * @param interp Interpolation method
+         * @param written Number of samples of this block that have been written
+         * @param state Allpass state of the tap, unused otherwise
+         */
+        void read(T* out, int num, double delay, DelayInterp interp, int written, T& state) const {
+
+            // Determine the whole and fractional delay:
+
+            const double look = interp == DelayInterp::Allpass ? 0.5 : 0;
+
+            const auto whole = static_cast<std::size_t>(std::floor(delay - look));
+            const double frac = delay - static_cast<double>(whole);
+
+            // Find the samples before the oldest read, the line is mirrored so this run is contiguous:
+
+            const std::size_t pos = this->head - static_cast<std::size_t>(written);
+            const T* span = this->buff.data() + ((pos - whole - 2) & this->mask) + 1;
+
+            switch (interp) {
+
+                case DelayInterp::None:
+
+                    std::copy_n(span + 1, num, out);
+
+                    break;
+
+                case DelayInterp::Linear:
+
+                    delay_linear(span, out, num, static_cast<T>(1 - frac));
+
+                    break;
+
+                case DelayInterp::Cubic:
+
+                    delay_cubic(span, out, num, static_cast<T>(1 - frac));
+
+                    break;
+
+                case DelayInterp::Allpass:
+
+                    delay_allpass(span, out, num, static_cast<T>((1 - frac) / (1 + frac)), state);
+
+                    break;
+            }
+        }
+
+        /**
+         * @brief Reads a block with a different delay for each sample
+         *
+         * @param out Pointer to store results
+         * @param num Number of samples to read
+         * @param delays Delay of each sample
+         * @param interp Interpolation method
+         * @param written Number of samples of this block that have been written
+         * @param state Allpass state of the tap, unused otherwise
+         */
+        void read(T* out, int num, const T* delays, DelayInterp interp, int written, T& state) const {
+
+            delay_gather(this->buff.data(), this->mask, this->head - static_cast<std::size_t>(written), delays, out, num, interp, state);
+        }
+
+    private:
+
+        /// Samples in the line, with the mirrored start at the end
+        std::vector<T> buff;
+
+        /// Mask used to wrap positions
+        std::size_t mask = 0;
+
+        /// Number of samples mirrored after the end
+        std::size_t guard = 0;
+
+        /// Total number of samples written
+        std::size_t head = 0;
+
+        /// Maximum delay in samples
+        int max_delay = 0;
+
+        /// Maximum block size
+        int max_block = 1;
+};
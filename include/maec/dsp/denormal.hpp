@@ -0,0 +1,112 @@
+/**
+ * @file denormal.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Components for avoiding denormal numbers
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Values too small to be represented normally (denormals)
+ * are handled in microcode on most CPUs, and can be 10-100 times slower to work with.
+ * Decaying signals (filter tails, envelope releases, reverbs)
+ * fall into this range on their way to zero, so CPU use spikes right when
+ * nothing can be heard.
+ *
+ * There are two ways to avoid them:
+ *
+ * - Ask the CPU to flush denormals to zero (FTZ) and treat denormal inputs as zero (DAZ).
+ *   This is a per thread setting, see set_flush_to_zero().
+ *   It only applies to SSE/NEON math, so long double (x87) math is not covered!
+ * - Flush small values to zero in software, see flush_denormal().
+ *   This works for any type, and is used by the recursive filters
+ *   and ramps on the values they carry over.
+ */
+
+#pragma once
+
+#include <cmath>
+
+/// Magnitude under which values are flushed to zero in software, roughly -600 dB
+constexpr double DENORMAL_LEVEL = 1e-30;
+
+/**
+ * @brief Determines if the calling thread flushes denormals to zero
+ *
+ * @return true If FTZ (and DAZ where available) is enabled
+ * @return false If disabled, or not supported on this platform
+ */
+bool flush_to_zero();
+
+/**
+ * @brief Sets if the calling thread flushes denormals to zero
+ *
+ * On x86 we set the FTZ and DAZ bits of the MXCSR register,
+ * on ARM we set the FZ bit of the FPCR register.
+ * On other platforms nothing is done.
+ *
+ * @param enable true to flush denormals, false to keep them
+ * @return true If denormals were previously flushed
+ * @return false If denormals were previously kept
+ */
+bool set_flush_to_zero(bool enable);
+
+/**
+ * @brief Flushes denormals to zero for a scope
+ *
+ * The previous mode of the calling thread is restored when we go out of scope.
+ */
+class FlushToZeroScope {
+
+    private:
+
+        /// Mode to restore
+        bool previous = false;
+
+    public:
+
+        /**
+         * @brief Construct a new Flush To Zero Scope object
+         *
+         * @param enable true to flush denormals within this scope
+         */
+        explicit FlushToZeroScope(bool enable = true) : previous(set_flush_to_zero(enable)) {}
+
+        /**
+         * @brief Destroy the Flush To Zero Scope object
+         *
+         * We restore the previous mode.
+         */
+        ~FlushToZeroScope() { set_flush_to_zero(this->previous); }
+
+        FlushToZeroScope(const FlushToZeroScope&) = delete;
+        FlushToZeroScope& operator=(const FlushToZeroScope&) = delete;
+};
+
+/**
+ * @brief Flushes a small value to zero
+ *
+ * @tparam T Type of value
+ * @param val Value to check
+ * @return T Zero if the value is under DENORMAL_LEVEL, otherwise the value
+ */
+template <typename T>
+inline T flush_denormal(T val) { return std::fabs(val) < static_cast<T>(DENORMAL_LEVEL) ? T(0) : val; }
+
+/**
+ * @brief Flushes every small value in a range to zero
+ *
+ * This is intended for state carried between blocks,
+ * so a decayed state settles at exactly zero.
+ *
+ * @tparam R Type of range
+ * @param range Values to flush
+ */
+template <typename R>
+inline void flush_denormals(R& range) {
+
+    for (auto& val : range) {
+
+        val = flush_denormal(val);
+    }
+}
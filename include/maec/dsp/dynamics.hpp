@@ -0,0 +1,329 @@
+/**
+ * @file dynamics.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Kernels for dynamics processing
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This file contains the building blocks of compressors and limiters.
+ * A dynamics processor follows the level of a signal (the detector),
+ * determines how much to turn it down at that level (the gain curve),
+ * smooths the change in gain over time (attack and release),
+ * and applies the gain to the signal.
+ *
+ * Each stage works on a whole block at a time.
+ * The detectors and the gain curve are plain loops over contiguous memory,
+ * which vectorize well.
+ * The gain curve works in decibels, and uses the fast log and exponent
+ * approximations (see fastmath.hpp) rather than calling std::log and std::exp for each sample.
+ * Smoothing is a one pole recurrence whose coefficients are determined once,
+ * so no sample requires an exponent.
+ *
+ * Like the mixing kernels, these are compiled for multiple instruction sets when possible.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Shape of a gain curve
+ *
+ * Levels above the threshold are reduced by the ratio,
+ * so a ratio of 4 lets a level 8 dB above the threshold out at 2 dB above it.
+ * An infinite ratio holds every level at the threshold, which is a limiter.
+ * The knee softens the corner at the threshold over the given width,
+ * and the makeup gain is added after the reduction.
+ */
+struct DynCurve {
+
+    /// Level where reduction starts in dB
+    double threshold = 0;
+
+    /// Amount levels above the threshold are divided by
+    double ratio = 1;
+
+    /// Width of the soft knee in dB
+    double knee = 0;
+
+    /// Gain added after reduction in dB
+    double makeup = 0;
+};
+
+/**
+ * @brief Determines the smoothing coefficient for a given time
+ *
+ * A one pole smoother with this coefficient covers 1 - 1/e
+ * (about 63%) of any change in the given time.
+ *
+ * @param time Time in seconds
+ * @param rate Sample rate
+ * @return double Smoothing coefficient, 0 for no smoothing
+ */
+inline double dyn_coefficient(double time, double rate) { return time > 0 && rate > 0 ? std::exp(-1.0 / (time * rate)) : 0.0; }
+
+/**
+ * @brief Raises the level of each sample to the magnitude of the input
+ *
+ * level[i] = max(level[i], |in[i]|)
+ *
+ * Calling this for each channel links the channels,
+ * so every channel is reduced by the loudest.
+ *
+ * @param in Pointer to samples
+ * @param level Pointer to levels, updated in place
+ * @param num Number of samples
+ */
+void dyn_peak(const float* in, float* level, int num);
+
+/// @copydoc dyn_peak(const float*, float*, int)
+void dyn_peak(const double* in, double* level, int num);
+
+/// @copydoc dyn_peak(const float*, float*, int)
+void dyn_peak(const long double* in, long double* level, int num);
+
+/**
+ * @brief Adds the power of each sample to the level
+ *
+ * level[i] += in[i] * in[i] * scale
+ *
+ * Calling this for each channel with a scale of 1 / channels
+ * determines the mean power of every channel.
+ *
+ * @param in Pointer to samples
+ * @param level Pointer to levels, updated in place
+ * @param num Number of samples
+ * @param scale Value to scale each power by
+ */
+void dyn_square(const float* in, float* level, int num, float scale);
+
+/// @copydoc dyn_square(const float*, float*, int, float)
+void dyn_square(const double* in, double* level, int num, double scale);
+
+/// @copydoc dyn_square(const float*, float*, int, float)
+void dyn_square(const long double* in, long double* level, int num, long double scale);
+
+/**
+ * @brief Determines the gain reduction for each level
+ *
+ * Levels are converted to decibels, where scale is the number of decibels
+ * for each doubling of level, about 6.02 for magnitudes and 3.01 for power.
+ * The result is the reduction in dB given by the curve, which is never positive.
+ * The makeup gain is not included.
+ *
+ * @param level Pointer to levels
+ * @param out Pointer to store the reduction of each level
+ * @param num Number of levels
+ * @param curve Shape of the gain curve
+ * @param scale Decibels for each doubling of level
+ */
+void dyn_reduction(const float* level, float* out, int num, const DynCurve& curve, float scale);
+
+/// @copydoc dyn_reduction(const float*, float*, int, const DynCurve&, float)
+void dyn_reduction(const double* level, double* out, int num, const DynCurve& curve, double scale);
+
+/// @copydoc dyn_reduction(const float*, float*, int, const DynCurve&, float)
+void dyn_reduction(const long double* level, long double* out, int num, const DynCurve& curve, long double scale);
+
+/**
+ * @brief Smooths values in place with separate rise and fall times
+ *
+ * state = data[i] + coeff * (state - data[i])
+ *
+ * Where coeff is attack when the value falls below the state,
+ * and release otherwise.
+ * For gain reduction, falling values reduce more, so they attack.
+ * Passing the same coefficient for both smooths values evenly,
+ * which turns the power of dyn_square() into a running mean.
+ *
+ * @param data Pointer to values, replaced with the smoothed values
+ * @param num Number of values
+ * @param attack Coefficient for falling values
+ * @param release Coefficient for rising values
+ * @param state Last smoothed value, updated with the last value
+ */
+void dyn_smooth(float* data, int num, float attack, float release, float& state);
+
+/// @copydoc dyn_smooth(float*, int, float, float, float&)
+void dyn_smooth(double* data, int num, double attack, double release, double& state);
+
+/// @copydoc dyn_smooth(float*, int, float, float, float&)
+void dyn_smooth(long double* data, int num, long double attack, long double release, long double& state);
+
+/**
+ * @brief Converts gains in dB to linear gains
+ *
+ * out[i] = 10 ^ ((db[i] + makeup) / 20)
+ *
+ * @param db Pointer to gains in dB
+ * @param out Pointer to store linear gains
+ * @param num Number of gains
+ * @param makeup Gain added to each value in dB
+ */
+void dyn_gain(const float* db, float* out, int num, float makeup);
+
+/// @copydoc dyn_gain(const float*, float*, int, float)
+void dyn_gain(const double* db, double* out, int num, double makeup);
+
+/// @copydoc dyn_gain(const float*, float*, int, float)
+void dyn_gain(const long double* db, long double* out, int num, long double makeup);
+
+/**
+ * @brief Multiplies samples by a gain for each sample
+ *
+ * data[i] *= gain[i]
+ *
+ * @param data Pointer to samples, updated in place
+ * @param gain Pointer to gains
+ * @param num Number of samples
+ */
+void dyn_apply(float* data, const float* gain, int num);
+
+/// @copydoc dyn_apply(float*, const float*, int)
+void dyn_apply(double* data, const double* gain, int num);
+
+/// @copydoc dyn_apply(float*, const float*, int)
+void dyn_apply(long double* data, const long double* gain, int num);
+
+/**
+ * @brief Holds the largest value seen over a sliding window
+ *
+ * Each value is replaced with the largest of the last window values,
+ * including itself.
+ * When the signal is delayed by window - 1 samples,
+ * every sample is covered by the reduction for the peaks around it,
+ * which lets a limiter turn down ahead of a peak instead of after it.
+ *
+ * We keep a queue of values that may still become the largest,
+ * each smaller than the one before it, which costs a constant amount
+ * of work per sample no matter the window.
+ * Memory is reserved up front, so processing never allocates.
+ *
+ * @tparam T Type of values
+ */
+template <typename T>
+class PeakHold {
+
+    private:
+
+        /// Candidate values, in the order they arrived
+        std::vector<T> values;
+
+        /// Position of each candidate
+        std::vector<std::size_t> times;
+
+        /// Mask used to wrap positions in the queue
+        std::size_t mask = 0;
+
+        /// Position of the first candidate in the queue
+        std::size_t head = 0;
+
+        /// Position after the last candidate in the queue
+        std::size_t tail = 0;
+
+        /// Number of values we have seen
+        std::size_t now = 0;
+
+        /// Number of values in the window
+        std::size_t window = 1;
+
+    public:
+
+        PeakHold() { this->set_window(1); }
+
+        /**
+         * @brief Construct a new PeakHold object
+         *
+         * @param size Number of values in the window
+         */
+        explicit PeakHold(std::size_t size) { this->set_window(size); }
+
+        /**
+         * @brief Sets the number of values in the window
+         *
+         * This discards the values we have seen.
+         *
+         * @param size Number of values in the window, at least 1
+         */
+        void set_window(std::size_t size) {
+
+            this->window = std::max<std::size_t>(size, 1);
+
+            std::size_t cap = 1;
+
+            while (cap < this->window + 1) {
+
+                cap *= 2;
+            }
+
+            this->values.assign(cap, 0);
+            this->times.assign(cap, 0);
+            this->mask = cap - 1;
+
+            this->reset();
+        }
+
+        /**
+         * @brief Gets the number of values in the window
+         *
+         * @return std::size_t Number of values in the window
+         */
+        std::size_t get_window() const { return this->window; }
+
+        /**
+         * @brief Discards the values we have seen
+         */
+        void reset() {
+
+            this->head = 0;
+            this->tail = 0;
+            this->now = 0;
+        }
+
+        /**
+         * @brief Replaces each value with the largest in its window
+         *
+         * @param data Pointer to values, updated in place
+         * @param num Number of values
+         */
+        void process(T* data, int num) {
+
+            if (this->window == 1) {
+
+                return;
+            }
+
+            for (int i = 0; i < num; ++i) {
+
+                const T val = data[i];
+
+                // Drop candidates that this value outlasts and beats:
+
+                while (this->tail != this->head && this->values[(this->tail - 1) & this->mask] <= val) {
+
+                    --(this->tail);
+                }
+
+                this->values[this->tail & this->mask] = val;
+                this->times[this->tail & this->mask] = this->now;
+
+                ++(this->tail);
+
+                // Drop the oldest candidate if it has left the window:
+
+                if (this->now - this->times[this->head & this->mask] >= this->window) {
+
+                    ++(this->head);
+                }
+
+                ++(this->now);
+
+                data[i] = this->values[this->head & this->mask];
+            }
+        }
+};
@@ -0,0 +1,475 @@
+/**
+ * @file fastmath.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Fast approximations of common math functions
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This file contains approximations of sin, cos, exp2, log2 and tanh
+ * that are much cheaper than their libm counterparts.
+ * They are used in the hot paths of the built-in modules,
+ * where the exact libm result is not needed.
+ *
+ * Like the oscillator kernels, these are written to be friendly to the vectorizer:
+ * there are no branches or calls (only selects and polynomials),
+ * so loops that call them can be vectorized.
+ * Exponents are built and split with bit operations for float and double,
+ * long double falls back on ldexp() and frexp().
+ *
+ * Each function takes an accuracy (see MathAccuracy),
+ * which picks the degree of the polynomial.
+ * The polynomials are minimax fits found with the Remez exchange algorithm,
+ * and the error bounds listed with each function were measured in double precision.
+ * When working with floats, the error can't be lower than the float resolution (about 6e-8).
+ *
+ * A table based sine (see sine_table_turns()) is also provided,
+ * for when a single lookup is cheaper than a polynomial.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+/**
+ * @brief Accuracy of the fast math functions
+ *
+ * - Low - Cheapest, errors around 1e-4, fine for control signals and modulation
+ * - Medium - Errors around 1e-7, near the resolution of float samples
+ * - High - Errors around 1e-10, near the resolution of 32 bit integer samples
+ */
+enum class MathAccuracy { Low, Medium, High };
+
+/// Coefficients of sin(2 * pi * u) / u in u^2, for each accuracy
+constexpr std::array<double, 3> FM_SIN_LOW = {6.281281461428721, -41.09536162449064, 73.58742419082442};
+constexpr std::array<double, 4> FM_SIN_MEDIUM = {6.283164065019835, -41.33714570841603, 81.3408974669643, -70.99480757590592};
+constexpr std::array<double, 6> FM_SIN_HIGH = {6.283185305899292,   -41.34170174169562, 81.60519258903979,
+                                               -76.70305215508048, 41.990142360122384, -14.279745660100408};
+
+/// Coefficients of 2^f over [0, 1], for each accuracy
+constexpr std::array<double, 4> FM_EXP2_LOW = {0.9999246834315009, 0.6958369147890414, 0.22606310794503198, 0.07802499273194792};
+constexpr std::array<double, 6> FM_EXP2_MEDIUM = {0.9999999238016755,  0.6931530957436508,  0.240153513269872,
+                                                  0.05582649190529207, 0.00898923833068816, 0.001877585088136558};
+constexpr std::array<double, 8> FM_EXP2_HIGH = {0.9999999999585599,   0.693147186126705,     0.24022638420451137,    0.05550512853793859,
+                                                0.009614013730257462, 0.001342266587826216, 0.00014352192610421236, 2.14988456160533e-05};
+
+/// Coefficients of log2((1 + s) / (1 - s)) / s in s^2, for each accuracy
+constexpr std::array<double, 2> FM_LOG2_LOW = {2.885228651531313, 0.9835289534523238};
+constexpr std::array<double, 3> FM_LOG2_MEDIUM = {2.88539128845541, 0.9614709746024065, 0.5989682591556295};
+constexpr std::array<double, 5> FM_LOG2_HIGH = {2.8853900819000584, 0.9617966234956162, 0.5770896834161817, 0.4113964221504468,
+                                                0.34490234957345656};
+
+/// Number of points in one cycle of the sine table
+constexpr int FM_SINE_TABLE_SIZE = 4096;
+
+/**
+ * @brief Evaluates a polynomial using Horner's method
+ *
+ * @tparam T Type to work with
+ * @tparam N Number of coefficients
+ * @param coeffs Coefficients, lowest order first
+ * @param x Value to evaluate at
+ * @return T Value of the polynomial
+ */
+template <typename T, std::size_t N>
+inline T fm_poly(const std::array<double, N>& coeffs, T x) {
+
+    T out = static_cast<T>(coeffs[N - 1]);
+
+    for (std::size_t i = N - 1; i-- > 0;) {
+
+        out = out * x + static_cast<T>(coeffs[i]);
+    }
+
+    return out;
+}
+
+/**
+ * @brief Approximates sine of a phase in turns
+ *
+ * We compute sin(2 * pi * turn), reducing the phase into a quarter wave
+ * so the polynomial only has to be accurate in [0, 1/4] turns.
+ *
+ * Maximum absolute error:
+ *
+ * - Low - 6.9e-5
+ * - Medium - 6.0e-7
+ * - High - 2.7e-11
+ *
+ * @tparam A Accuracy to use
+ * @tparam T Type to work with
+ * @param turn Phase in turns
+ * @return T Approximate sine value
+ */
+template <MathAccuracy A = MathAccuracy::Medium, typename T>
+inline T fast_sin_turns(T turn) {
+
+    // Reduce phase into [-0.5, 0.5]:
+
+    const T y = turn - std::floor(turn + T(0.5));
+
+    // Fold into quarter wave:
+
+    const T u = T(0.25) - std::fabs(std::fabs(y) - T(0.25));
+    const T u2 = u * u;
+
+    // Evaluate polynomial, and restore the sign:
+
+    T poly;
+
+    if constexpr (A == MathAccuracy::Low) {
+
+        poly = fm_poly(FM_SIN_LOW, u2);
+    }
+
+    else if constexpr (A == MathAccuracy::Medium) {
+
+        poly = fm_poly(FM_SIN_MEDIUM, u2);
+    }
+
+    else {
+
+        poly = fm_poly(FM_SIN_HIGH, u2);
+    }
+
+    return std::copysign(poly * u, y);
+}
+
+/**
+ * @brief Approximates cosine of a phase in turns
+ *
+ * Error bounds are the same as fast_sin_turns().
+ *
+ * @tparam A Accuracy to use
+ * @tparam T Type to work with
+ * @param turn Phase in turns
+ * @return T Approximate cosine value
+ */
+template <MathAccuracy A = MathAccuracy::Medium, typename T>
+inline T fast_cos_turns(T turn) { return fast_sin_turns<A>(turn + T(0.25)); }
+
+/**
+ * @brief Approximates sine of a value in radians
+ *
+ * Error bounds are the same as fast_sin_turns(),
+ * though large values lose precision when converted to turns.
+ *
+ * @tparam A Accuracy to use
+ * @tparam T Type to work with
+ * @param x Value in radians
+ * @return T Approximate sine value
+ */
+template <MathAccuracy A = MathAccuracy::Medium, typename T>
+inline T fast_sin(T x) { return fast_sin_turns<A>(x * T(0.159154943091895335768883763372514362)); }
+
+/**
+ * @brief Approximates cosine of a value in radians
+ *
+ * Error bounds are the same as fast_sin_turns().
+ *
+ * @tparam A Accuracy to use
+ * @tparam T Type to work with
+ * @param x Value in radians
+ * @return T Approximate cosine value
+ */
+template <MathAccuracy A = MathAccuracy::Medium, typename T>
+inline T fast_cos(T x) { return fast_cos_turns<A>(x * T(0.159154943091895335768883763372514362)); }
+
+/**
+ * @brief Computes 2 raised to a whole number
+ *
+ * The exponent is built directly for float and double.
+ *
+ * @tparam T Type to work with
+ * @param n Whole exponent, within the normal range of T
+ * @return T 2^n
+ */
+template <typename T>
+inline T fm_exp2_int(T n) {
+
+    if constexpr (std::is_same_v<T, float>) {
+
+        return std::bit_cast<float>(static_cast<std::int32_t>(n + 127) << 23);
+    }
+
+    else if constexpr (std::is_same_v<T, double>) {
+
+        return std::bit_cast<double>(static_cast<std::int64_t>(n + 1023) << 52);
+    }
+
+    else {
+
+        return std::ldexp(T(1), static_cast<int>(n));
+    }
+}
+
+/**
+ * @brief Approximates 2 raised to a value
+ *
+ * We split the value into whole and fractional parts,
+ * approximating 2 raised to the fraction, and scaling by 2 raised to the whole part.
+ * Values are clamped so the result is a normal number,
+ * very small values will not reach zero.
+ *
+ * Maximum relative error:
+ *
+ * - Low - 7.6e-5
+ * - Medium - 7.7e-8
+ * - High - 4.2e-11
+ *
+ * @tparam A Accuracy to use
+ * @tparam T Type to work with
+ * @param x Value to raise 2 to
+ * @return T Approximate 2^x
+ */
+template <MathAccuracy A = MathAccuracy::Medium, typename T>
+inline T fast_exp2(T x) {
+
+    // Keep the result in the normal range,
+    // the polynomial is slightly under one at zero, so we stay one above the smallest exponent:
+
+    constexpr T low = std::numeric_limits<T>::min_exponent;
+    constexpr T high = std::numeric_limits<T>::max_exponent - 1;
+
+    const T clamped = std::clamp(x, low, high);
+
+    // Split into whole and fractional parts:
+
+    const T whole = std::floor(clamped);
+    const T frac = clamped - whole;
+
+    T poly;
+
+    if constexpr (A == MathAccuracy::Low) {
+
+        poly = fm_poly(FM_EXP2_LOW, frac);
+    }
+
+    else if constexpr (A == MathAccuracy::Medium) {
+
+        poly = fm_poly(FM_EXP2_MEDIUM, frac);
+    }
+
+    else {
+
+        poly = fm_poly(FM_EXP2_HIGH, frac);
+    }
+
+    return poly * fm_exp2_int(whole);
+}
+
+/**
+ * @brief Approximates e raised to a value
+ *
+ * Error bounds are the same as fast_exp2().
+ *
+ * @tparam A Accuracy to use
+ * @tparam T Type to work with
+ * @param x Value to raise e to
+ * @return T Approximate e^x
+ */
+template <MathAccuracy A = MathAccuracy::Medium, typename T>
+inline T fast_exp(T x) { return fast_exp2<A>(x * T(1.44269504088896340735992468100189214)); }
+
+/**
+ * @brief Approximates the base 2 logarithm of a value
+ *
+ * We split the value into an exponent and a mantissa in [sqrt(1/2), sqrt(2)],
+ * and approximate the logarithm of the mantissa using s = (m - 1) / (m + 1).
+ * The value must be positive and normal.
+ *
+ * Maximum absolute error:
+ *
+ * - Low - 5.6e-6
+ * - Medium - 3.0e-8
+ * - High - 2.1e-12
+ *
+ * @tparam A Accuracy to use
+ * @tparam T Type to work with
+ * @param x Value to find the logarithm of
+ * @return T Approximate log2(x)
+ */
+template <MathAccuracy A = MathAccuracy::Medium, typename T>
+inline T fast_log2(T x) {
+
+    // Split into exponent and mantissa in [1, 2):
+
+    T exp;
+    T man;
+
+    if constexpr (std::is_same_v<T, float>) {
+
+        const auto bits = std::bit_cast<std::uint32_t>(x);
+
+        exp = static_cast<T>(static_cast<std::int32_t>((bits >> 23) & 0xff) - 127);
+        man = std::bit_cast<float>((bits & 0x7fffffU) | 0x3f800000U);
+    }
+
+    else if constexpr (std::is_same_v<T, double>) {
+
+        const auto bits = std::bit_cast<std::uint64_t>(x);
+
+        exp = static_cast<T>(static_cast<std::int64_t>((bits >> 52) & 0x7ff) - 1023);
+        man = std::bit_cast<double>((bits & 0xfffffffffffffULL) | 0x3ff0000000000000ULL);
+    }
+
+    else {
+
+        int whole = 0;
+
+        man = 2 * std::frexp(x, &whole);
+        exp = static_cast<T>(whole - 1);
+    }
+
+    // Center the mantissa around 1:
+
+    const bool big = man > T(1.41421356237309504880168872420969808);
+
+    man = big ? man * T(0.5) : man;
+    exp = big ? exp + 1 : exp;
+
+    const T s = (man - 1) / (man + 1);
+    const T s2 = s * s;
+
+    T poly;
+
+    if constexpr (A == MathAccuracy::Low) {
+
+        poly = fm_poly(FM_LOG2_LOW, s2);
+    }
+
+    else if constexpr (A == MathAccuracy::Medium) {
+
+        poly = fm_poly(FM_LOG2_MEDIUM, s2);
+    }
+
+    else {
+
+        poly = fm_poly(FM_LOG2_HIGH, s2);
+    }
+
+    return exp + s * poly;
+}
+
+/**
+ * @brief Approximates a raised to b
+ *
+ * This is computed as 2^(b * log2(a)),
+ * so the relative error grows with the magnitude of the result's exponent.
+ * The base must be positive and normal.
+ *
+ * @tparam A Accuracy to use
+ * @tparam T Type to work with
+ * @param base Value to raise
+ * @param power Power to raise to
+ * @return T Approximate base^power
+ */
+template <MathAccuracy A = MathAccuracy::Medium, typename T>
+inline T fast_pow(T base, T power) { return fast_exp2<A>(power * fast_log2<A>(base)); }
+
+/**
+ * @brief Approximates the hyperbolic tangent of a value
+ *
+ * The low accuracy version uses a rational approximation (from Lambert's continued fraction),
+ * which needs no exponent.
+ * The others compute 1 - 2 / (e^(2x) + 1) on the magnitude,
+ * using a series for small values where this would cancel.
+ *
+ * Maximum absolute error:
+ *
+ * - Low - 9.7e-5
+ * - Medium - 4.0e-8
+ * - High - 1.7e-10
+ *
+ * @tparam A Accuracy to use
+ * @tparam T Type to work with
+ * @param x Value to find the hyperbolic tangent of
+ * @return T Approximate tanh(x)
+ */
+template <MathAccuracy A = MathAccuracy::Medium, typename T>
+inline T fast_tanh(T x) {
+
+    if constexpr (A == MathAccuracy::Low) {
+
+        const T x2 = x * x;
+
+        const T num = x * (T(135135) + x2 * (T(17325) + x2 * (T(378) + x2)));
+        const T den = T(135135) + x2 * (T(62370) + x2 * (T(3150) + x2 * T(28)));
+
+        return std::clamp(num / den, T(-1), T(1));
+    }
+
+    else {
+
+        const T mag = std::fabs(x);
+
+        // Series for small values:
+
+        const T x2 = x * x;
+        const T series = x * (T(1) + x2 * (T(-1.0 / 3) + x2 * (T(2.0 / 15) + x2 * T(-17.0 / 315))));
+
+        // Exponential form for the rest:
+
+        const T full = std::copysign(T(1) - T(2) / (fast_exp2<A>(mag * T(2.88539008177792681471984936200378427)) + T(1)), x);
+
+        return mag < T(0.125) ? series : full;
+    }
+}
+
+/**
+ * @brief Builds one cycle of a sine wave, with the first point repeated at the end
+ *
+ * @return std::array<float, FM_SINE_TABLE_SIZE + 1> Sine table
+ */
+inline std::array<float, FM_SINE_TABLE_SIZE + 1> fm_sine_table() {
+
+    std::array<float, FM_SINE_TABLE_SIZE + 1> table{};
+
+    for (int i = 0; i <= FM_SINE_TABLE_SIZE; ++i) {
+
+        table[i] = static_cast<float>(std::sin(2 * 3.14159265358979323846 * i / FM_SINE_TABLE_SIZE));
+    }
+
+    return table;
+}
+
+/// One cycle of a sine wave, used by sine_table_turns()
+inline const std::array<float, FM_SINE_TABLE_SIZE + 1> FM_SINE_TABLE = fm_sine_table();
+
+/**
+ * @brief Approximates sine of a phase in turns using a table
+ *
+ * We linearly interpolate between the points of a table with FM_SINE_TABLE_SIZE points.
+ * Each call is one lookup and a multiply add, with no polynomial,
+ * though the lookups are gathers, which don't vectorize as well.
+ *
+ * The maximum absolute error is 3.3e-7 (the interpolation error, plus the float table).
+ *
+ * @tparam T Type to work with
+ * @param turn Phase in turns
+ * @return T Approximate sine value
+ */
+template <typename T>
+inline T sine_table_turns(T turn) {
+
+    // Find the position in the table:
+
+    const T pos = (turn - std::floor(turn)) * T(FM_SINE_TABLE_SIZE);
+    const T base = std::floor(pos);
+    const T frac = pos - base;
+
+    const int index = std::min(static_cast<int>(base), FM_SINE_TABLE_SIZE - 1);
+
+    const T first = FM_SINE_TABLE[index];
+    const T second = FM_SINE_TABLE[index + 1];
+
+    return first + frac * (second - first);
+}
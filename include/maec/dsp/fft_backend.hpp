@@ -0,0 +1,280 @@
+/**
+ * @file fft_backend.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Pluggable backend for computing FFTs
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This file contains a backend that components should use
+ * when they need to compute complex FFTs on a hot path.
+ * The backend is selected at build time:
+ *
+ * - If FFTW is found, then we dispatch to FFTW
+ * - Otherwise, we use the in-tree FFTPlan implementation
+ *
+ * Both backends are templated on the precision to work with,
+ * and are provided for float, double and long double.
+ * Components should use the precision of the data they are given (usually sample_t),
+ * as FFTW only has SIMD codelets for float and double,
+ * and converting each value to long double is slower than the transform itself.
+ *
+ * Components do not need to change anything to get the faster backend,
+ * they just need to use these classes rather than calling the FFT functions directly.
+ * FFTBackend computes complex transforms, and RealFFTBackend computes
+ * transforms of real data, which is about twice as fast for audio.
+ *
+ * When using FFTW, plans are expensive to create,
+ * so we keep a process-wide cache of plans for each (precision, kind, size, direction, placement).
+ * Plans are only created when a backend is prepared,
+ * and are shared between every backend of the same size.
+ * FFTW wisdom can also be saved and loaded,
+ * so plans do not have to be measured on every run.
+ * FFTW keeps separate wisdom for each precision.
+ */
+
+#pragma once
+
+#include <complex>
+#include <string>
+#include <vector>
+
+#include "dsp/ft.hpp"
+
+/**
+ * @brief Computes complex FFTs of a given size
+ *
+ * Create one of these for each size you will be transforming,
+ * and call prepare() before processing starts.
+ * All expensive work (planning, twiddle tables, allocation)
+ * happens in prepare(), so forward() and inverse() are real-time safe.
+ *
+ * The inverse transform is normalized by the size,
+ * same as ifft_c_radix2().
+ * Input and output may point to the same data.
+ *
+ * @tparam T Floating point type to work with
+ */
+template <typename T = long double>
+class FFTBackend {
+
+    private:
+
+        /// Size of the transform
+        int fsize = 0;
+
+#ifdef FFTW
+
+        /// Cached FFTW plans, as opaque pointers
+        void* plans[4] = {nullptr, nullptr, nullptr, nullptr};
+
+        /**
+         * @brief Runs the correct cached plan
+         *
+         * @param input Pointer to input data
+         * @param output Pointer to output data
+         * @param inverse true for inverse, false for forward
+         */
+        void execute(const std::complex<T>* input, std::complex<T>* output, bool inverse);
+
+#else
+
+        /// In-tree plan to use
+        FFTPlan<T> plan;
+
+#endif
+
+    public:
+
+        FFTBackend() =default;
+
+        /**
+         * @brief Construct a new FFTBackend object
+         *
+         * @param size Size of the transform
+         */
+        explicit FFTBackend(int size) { this->prepare(size); }
+
+        /**
+         * @brief Prepares this backend for the given size
+         *
+         * We create (or fetch from the cache) any plans we need.
+         * This should be called before processing starts.
+         *
+         * @param size Size of the transform
+         */
+        void prepare(int size);
+
+        /**
+         * @brief Computes the forward FFT
+         *
+         * @param input Pointer to input data
+         * @param output Pointer to output data
+         */
+        void forward(const std::complex<T>* input, std::complex<T>* output);
+
+        /**
+         * @brief Computes the normalized inverse FFT
+         *
+         * @param input Pointer to input data
+         * @param output Pointer to output data
+         */
+        void inverse(const std::complex<T>* input, std::complex<T>* output);
+
+        /**
+         * @brief Gets the size of this backend
+         *
+         * @return int Size of the transform
+         */
+        int size() const { return this->fsize; }
+
+        /**
+         * @brief Gets the number of bytes held by this backend
+         *
+         * Memory held by FFTW plans is not visible to us, and is not counted.
+         *
+         * @return std::size_t Number of bytes held
+         */
+        std::size_t bytes() const;
+
+        /**
+         * @brief Gets the name of the backend in use
+         *
+         * @return const char* "fftw" or "maec"
+         */
+        static const char* name();
+
+        /**
+         * @brief Loads FFTW wisdom from a file
+         *
+         * This should be done before any backends are prepared,
+         * which will make planning very fast.
+         * Only wisdom for our precision is loaded.
+         * Does nothing if FFTW is not in use.
+         *
+         * @param path Path to the wisdom file
+         * @return true If wisdom was loaded
+         * @return false If wisdom could not be loaded, or FFTW is not in use
+         */
+        static bool import_wisdom(const std::string& path);
+
+        /**
+         * @brief Saves FFTW wisdom to a file
+         *
+         * Only wisdom for our precision is saved.
+         * Does nothing if FFTW is not in use.
+         *
+         * @param path Path to the wisdom file
+         * @return true If wisdom was saved
+         * @return false If wisdom could not be saved, or FFTW is not in use
+         */
+        static bool export_wisdom(const std::string& path);
+
+        /**
+         * @brief Destroys all cached plans
+         *
+         * Only plans for our precision are destroyed.
+         * This MUST NOT be called while any backend of our precision is in use,
+         * as they will be left with dangling plans.
+         * Does nothing if FFTW is not in use.
+         */
+        static void clear_cache();
+};
+
+/**
+ * @brief Computes real FFTs of a given size
+ *
+ * This is the real data counterpart to FFTBackend.
+ * An N point real signal is transformed into (N / 2 + 1) complex bins,
+ * and back again.
+ * The size MUST be even.
+ *
+ * As with FFTBackend, all expensive work is done in prepare(),
+ * and the inverse is normalized by the size.
+ * Input and output may point to the same memory,
+ * in which case the buffer must be large enough to hold the spectrum.
+ *
+ * @tparam T Floating point type to work with
+ */
+template <typename T = long double>
+class RealFFTBackend {
+
+    private:
+
+        /// Size of the real data
+        int fsize = 0;
+
+#ifdef FFTW
+
+        /// Cached FFTW plans, as opaque pointers
+        void* plans[3] = {nullptr, nullptr, nullptr};
+
+        /// Copy of the spectrum, as FFTW destroys the input of inverse real transforms
+        std::vector<std::complex<T>> scratch;
+
+#else
+
+        /// In-tree plan to use
+        RealFFTPlan<T> plan;
+
+#endif
+
+    public:
+
+        RealFFTBackend() =default;
+
+        /**
+         * @brief Construct a new RealFFTBackend object
+         *
+         * @param size Size of the real data
+         */
+        explicit RealFFTBackend(int size) { this->prepare(size); }
+
+        /**
+         * @brief Prepares this backend for the given size
+         *
+         * @param size Size of the real data, must be even
+         */
+        void prepare(int size);
+
+        /**
+         * @brief Computes the forward real FFT
+         *
+         * @param input Pointer to N real values
+         * @param output Pointer to (N / 2 + 1) complex values
+         */
+        void forward(const T* input, std::complex<T>* output);
+
+        /**
+         * @brief Computes the normalized inverse real FFT
+         *
+         * @param input Pointer to (N / 2 + 1) complex values
+         * @param output Pointer to N real values
+         */
+        void inverse(const std::complex<T>* input, T* output);
+
+        /**
+         * @brief Gets the size of this backend
+         *
+         * @return int Size of the real data
+         */
+        int size() const { return this->fsize; }
+
+        /**
+         * @brief Gets the number of bytes held by this backend
+         *
+         * Memory held by FFTW plans is not visible to us, and is not counted.
+         *
+         * @return std::size_t Number of bytes held
+         */
+        std::size_t bytes() const;
+};
+
+extern template class FFTBackend<float>;
+extern template class FFTBackend<double>;
+extern template class FFTBackend<long double>;
+
+extern template class RealFFTBackend<float>;
+extern template class RealFFTBackend<double>;
+extern template class RealFFTBackend<long double>;
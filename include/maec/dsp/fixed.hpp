@@ -0,0 +1,306 @@
+/**
+ * @file fixed.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Fixed point samples and kernels
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Devices without a strong floating point unit
+ * spend most of their time converting and multiplying floats.
+ * This file offers a fixed point path for these platforms,
+ * which works on Q15 (16 bit) and Q31 (32 bit) samples.
+ * A Q15 sample is identical to a signed 16 bit PCM sample,
+ * so data read from a 16 bit wave file can be processed
+ * and sent to a 16 bit device without ever becoming a float
+ * (see the 16 bit PCM codecs in convert.hpp).
+ *
+ * All kernels saturate, so overflow clips to the largest value
+ * rather than wrapping around.
+ * Coefficients that may exceed one (gains and biquad coefficients)
+ * are given with a shift, or in a format with more integer bits.
+ *
+ * On ARM, the kernels use NEON saturating instructions.
+ * Elsewhere, portable loops are used, which are compiled
+ * for multiple instruction sets like the floating point kernels.
+ *
+ * The module chain itself still works on sample_t,
+ * these kernels are meant for fixed point processing outside of a chain,
+ * or for modules that convert at their edges.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "dsp/alloc.hpp"
+#include "dsp/buffer.hpp"
+#include "dsp/iir.hpp"
+
+/// Q15 sample, 1 sign bit and 15 fractional bits
+using q15_t = int16_t;
+
+/// Q31 sample, 1 sign bit and 31 fractional bits
+using q31_t = int32_t;
+
+/// Buffer of Q15 samples, aligned like the AudioBuffer
+using Q15Buffer = Buffer<q15_t, Interleaved, AlignedAllocator<q15_t>>;
+
+/// Buffer of Q31 samples, aligned like the AudioBuffer
+using Q31Buffer = Buffer<q31_t, Interleaved, AlignedAllocator<q31_t>>;
+
+/// Number of fractional bits in biquad coefficients (Q2.14)
+constexpr int FIXED_BIQUAD_BITS = 14;
+
+/**
+ * @brief Clamps a wide value into a Q15 sample
+ *
+ * @param val Value to clamp
+ * @return q15_t Saturated value
+ */
+constexpr q15_t q15_saturate(int64_t val) {
+
+    return static_cast<q15_t>(std::clamp<int64_t>(val, std::numeric_limits<q15_t>::min(), std::numeric_limits<q15_t>::max()));
+}
+
+/**
+ * @brief Clamps a wide value into a Q31 sample
+ *
+ * @param val Value to clamp
+ * @return q31_t Saturated value
+ */
+constexpr q31_t q31_saturate(int64_t val) {
+
+    return static_cast<q31_t>(std::clamp<int64_t>(val, std::numeric_limits<q31_t>::min(), std::numeric_limits<q31_t>::max()));
+}
+
+/**
+ * @brief Converts a floating point value in [-1, 1] into Q15
+ *
+ * The value is rounded to the nearest step, and saturated.
+ *
+ * @param val Value to convert
+ * @return q15_t Fixed point value
+ */
+inline q15_t to_q15(double val) { return q15_saturate(std::llround(val * 32768.0)); }
+
+/**
+ * @brief Converts a floating point value in [-1, 1] into Q31
+ *
+ * @param val Value to convert
+ * @return q31_t Fixed point value
+ */
+inline q31_t to_q31(double val) { return q31_saturate(std::llround(val * 2147483648.0)); }
+
+/**
+ * @brief Converts a Q15 value into floating point
+ *
+ * @param val Value to convert
+ * @return double Value in [-1, 1)
+ */
+constexpr double from_q15(q15_t val) { return val / 32768.0; }
+
+/**
+ * @brief Converts a Q31 value into floating point
+ *
+ * @param val Value to convert
+ * @return double Value in [-1, 1)
+ */
+constexpr double from_q31(q31_t val) { return val / 2147483648.0; }
+
+/**
+ * @brief Multiplies two Q15 values, rounding to nearest
+ *
+ * @param one First value
+ * @param two Second value
+ * @return q15_t Saturated product
+ */
+constexpr q15_t q15_mul(q15_t one, q15_t two) { return q15_saturate((static_cast<int32_t>(one) * two + (1 << 14)) >> 15); }
+
+/**
+ * @brief Multiplies two Q31 values, rounding to nearest
+ *
+ * @param one First value
+ * @param two Second value
+ * @return q31_t Saturated product
+ */
+constexpr q31_t q31_mul(q31_t one, q31_t two) { return q31_saturate((static_cast<int64_t>(one) * two + (int64_t{1} << 30)) >> 31); }
+
+/**
+ * @brief Scales a block of samples in place
+ *
+ * data[i] = saturate(data[i] * gain * 2^shift)
+ *
+ * The shift allows gains larger than one,
+ * for example a gain of 0.75 with a shift of 1 is a gain of 1.5.
+ *
+ * @param data Samples to scale
+ * @param size Number of samples
+ * @param gain Gain to apply
+ * @param shift Number of bits to shift the product left, from 0 to 15
+ */
+void fixed_gain(q15_t* data, int size, q15_t gain, int shift = 0);
+
+/// @copydoc fixed_gain(q15_t*, int, q15_t, int)
+void fixed_gain(q31_t* data, int size, q31_t gain, int shift = 0);
+
+/**
+ * @brief Adds a block of samples into another, saturating
+ *
+ * out[i] = saturate(out[i] + in[i])
+ *
+ * @param out Pointer to data to add to
+ * @param in Pointer to data to add
+ * @param size Number of samples
+ */
+void fixed_mix_add(q15_t* out, const q15_t* in, int size);
+
+/// @copydoc fixed_mix_add(q15_t*, const q15_t*, int)
+void fixed_mix_add(q31_t* out, const q31_t* in, int size);
+
+/**
+ * @brief Adds a scaled block of samples into another, saturating
+ *
+ * out[i] = saturate(out[i] + in[i] * gain)
+ *
+ * @param out Pointer to data to add to
+ * @param in Pointer to data to add
+ * @param size Number of samples
+ * @param gain Value to scale the input by
+ */
+void fixed_mix_add(q15_t* out, const q15_t* in, int size, q15_t gain);
+
+/// @copydoc fixed_mix_add(q15_t*, const q15_t*, int, q15_t)
+void fixed_mix_add(q31_t* out, const q31_t* in, int size, q31_t gain);
+
+/**
+ * @brief Coefficients of a fixed point second order section
+ *
+ * Coefficients are stored in Q2.14, which covers [-2, 2),
+ * enough for the feedback coefficients of any stable section.
+ * We use the same sign convention as BiquadCoefficients.
+ */
+struct FixedBiquad {
+
+    /// Feedforward coefficients
+    int16_t b0 = 1 << FIXED_BIQUAD_BITS, b1 = 0, b2 = 0;
+
+    /// Feedback coefficients
+    int16_t a1 = 0, a2 = 0;
+};
+
+/**
+ * @brief Converts floating point biquad coefficients into fixed point
+ *
+ * Coefficients outside of [-2, 2) are saturated,
+ * so sections with large feedforward gains should be scaled first.
+ *
+ * @param coeff Coefficients to convert
+ * @return FixedBiquad Fixed point coefficients
+ */
+FixedBiquad fixed_biquad(const BiquadCoefficients<double>& coeff);
+
+/**
+ * @brief Runs a block of Q15 samples through a second order section
+ *
+ * We use direct form I with a 64 bit accumulator,
+ * which cannot overflow inside the section and only rounds once per sample.
+ * The recursion prevents vectorizing across samples,
+ * so this kernel is scalar on every platform.
+ * Input and output may be the same.
+ *
+ * @param coeff Coefficients of the section
+ * @param state Four state values, (x1, x2, y1, y2), carried across blocks
+ * @param input Pointer to input samples
+ * @param size Number of samples
+ * @param output Pointer to output samples
+ */
+void fixed_biquad_process(const FixedBiquad& coeff, int32_t* state, const q15_t* input, int size, q15_t* output);
+
+/**
+ * @brief Computes the dot product of two blocks of Q15 values
+ *
+ * The products are accumulated in 64 bits, in Q30.
+ *
+ * @param one First block
+ * @param two Second block
+ * @param size Number of values
+ * @return int64_t Sum of the products
+ */
+int64_t fixed_dot(const q15_t* one, const q15_t* two, int size);
+
+/**
+ * @brief Streaming direct form FIR filter on Q15 samples
+ *
+ * This is the fixed point counterpart of StreamFIR,
+ * with the same history layout: the last (size - 1) input values
+ * are kept in front of each block, so every output is one
+ * contiguous dot product over the reversed kernel.
+ * The kernel is given in Q15.
+ *
+ * Memory is allocated when the kernel is set.
+ */
+class FixedFIR {
+
+    public:
+
+        FixedFIR() = default;
+
+        /**
+         * @brief Construct a new FixedFIR object
+         *
+         * @param kernel Kernel to filter with, in Q15
+         * @param block Expected size of each block
+         */
+        FixedFIR(const std::vector<q15_t>& kernel, int block) { this->set_kernel(kernel, block); }
+
+        /**
+         * @brief Sets the kernel to filter with
+         *
+         * The block size is only a hint, larger blocks may be processed
+         * but will cause the window to be reallocated.
+         * This clears the history.
+         *
+         * @param kernel Kernel to filter with, in Q15
+         * @param block Expected size of each block
+         */
+        void set_kernel(const std::vector<q15_t>& kernel, int block);
+
+        /**
+         * @brief Filters a block of samples
+         *
+         * Input and output may be the same.
+         *
+         * @param in Pointer to input samples
+         * @param size Number of samples
+         * @param out Pointer to output samples
+         */
+        void process(const q15_t* in, int size, q15_t* out);
+
+        /**
+         * @brief Clears the history
+         *
+         */
+        void reset();
+
+        /**
+         * @brief Gets the size of the kernel
+         *
+         * @return int Number of taps
+         */
+        int size() const { return static_cast<int>(this->rkernel.size()); }
+
+    private:
+
+        /// Kernel in reverse order
+        std::vector<q15_t> rkernel;
+
+        /// History followed by the block being processed
+        std::vector<q15_t> window;
+};
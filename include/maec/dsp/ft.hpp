@@ -20,9 +20,14 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
 #include <complex>
 #include <iterator>
+#include <vector>
 
+#include "alloc.hpp"
+#include "tables.hpp"
 #include "util.hpp"
 
 /**
@@ -70,6 +75,9 @@ long double sin_basis(int phase, int total, long double freq);
  * Where the real and imaginary parts will be
  * used in the complex type and returned.
  * By default we store results as long doubles.
+ *
+ * Sizes covered by the compile time tables (see tables.hpp)
+ * are looked up rather than computed.
  * 
  * @tparam T Type of output complex value
  * @param k Frequency component to calculate
@@ -80,6 +88,11 @@ long double sin_basis(int phase, int total, long double freq);
 template <typename T>
 std::complex<T> twiddle(int k, int size, int sign = -1) {
 
+    if (table_covers(size)) {
+
+        return table_twiddle<T>(k, size, sign);
+    }
+
     std::complex<T> res = std::polar<T>(1.0, sign * 2 * M_PI * k / size);
 
     return res;
@@ -113,11 +126,9 @@ std::complex<T> twiddle(int k, int size, int sign = -1) {
 template<typename T>
 std::complex<T> compute_a(int k, int size) {
 
-    using namespace std::complex_literals;
-
-    auto res = twiddle<T>(k, size);
+    const std::complex<T> res = twiddle<T>(k, size);
 
-    return (static_cast<T>(1.0) - res * 1il) / static_cast<T>(2);
+    return (static_cast<T>(1.0) - res * std::complex<T>(0, 1)) / static_cast<T>(2);
 }
 
 /**
@@ -148,11 +159,9 @@ std::complex<T> compute_a(int k, int size) {
 template<typename T>
 std::complex<T> compute_b(int k, int size) {
 
-    using namespace std::complex_literals;
-
-    auto res = twiddle<T>(k, size);
+    const std::complex<T> res = twiddle<T>(k, size);
 
-    return (static_cast<T>(1.0) + res * 1il) / static_cast<T>(2);
+    return (static_cast<T>(1.0) + res * std::complex<T>(0, 1)) / static_cast<T>(2);
 }
 
 /**
@@ -702,3 +711,545 @@ void ifft_r_radix2(I input, int size, O output) {
 
     ifft_c_radix2(input, size - 1, cmp);
 }
+
+/**
+ * @brief A reusable plan for computing complex FFTs of a given size
+ *
+ * The radix2 functions above recompute every twiddle factor on each call,
+ * and only work with power of two sizes.
+ * This is fine for one-off transforms,
+ * but spectral components transform the same size over and over again.
+ *
+ * This class does all of the expensive setup work once per size:
+ *
+ * - The size is factored into radix-4, radix-2, radix-3, and radix-5 stages
+ *   (any other prime factors are handled by a generic butterfly)
+ * - A table of twiddle factors for the full size is computed,
+ *   or copied from the compile time tables for power of two sizes (see tables.hpp)
+ * - The digit reversal permutation for the factors is computed
+ *
+ * After preparing, transforms are done iteratively with no allocations,
+ * no trigonometry, and no recursion.
+ * Radix-4 stages are used wherever possible, as they take
+ * roughly a quarter fewer multiplications than two radix-2 stages.
+ *
+ * The inverse transform is computed with the conjugate trick
+ * (conjugate the input, run the forward transform, conjugate the output),
+ * and is normalized by the size, same as ifft_c_radix2().
+ * Output is always in natural order.
+ *
+ * Plans are cheap to keep around, so components should prepare
+ * a plan at start time and reuse it for every block.
+ *
+ * @tparam T Floating point type to work with
+ */
+template <typename T = long double>
+class FFTPlan {
+
+    private:
+
+        /// Size of the transform
+        int fsize = 0;
+
+        /// Radix of each stage, outermost first
+        std::vector<int> factors;
+
+        /// Forward twiddle factors for the full size
+        std::vector<std::complex<T>> twiddles;
+
+        /// Digit reversal permutation, position -> input index
+        std::vector<int> perm;
+
+        /// Working memory for the transform
+        std::vector<std::complex<T>> work;
+
+        /// Working memory for generic butterflies
+        std::vector<std::complex<T>> scratch;
+
+        /**
+         * @brief Runs each butterfly stage on the working memory
+         *
+         * The working memory must already be in digit reversed order.
+         * We start with the innermost factor, and work our way out.
+         * 
+         */
+        void run() {
+
+            int span = 1;
+
+            for (auto fiter = this->factors.rbegin(); fiter != this->factors.rend(); ++fiter) {
+
+                const int radix = *fiter;
+                const int sub = span;
+
+                span *= radix;
+
+                // Stride through the twiddle table for this stage:
+
+                const int tstride = this->fsize / span;
+
+                for (int base = 0; base < this->fsize; base += span) {
+
+                    std::complex<T>* data = this->work.data() + base;
+
+                    for (int k = 0; k < sub; ++k) {
+
+                        this->butterfly(data + k, sub, radix, k * tstride);
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Computes one butterfly of the given radix
+         *
+         * We grab each value at the given stride, multiply by the twiddle factors,
+         * and compute a DFT of size radix over the values.
+         * Results are placed back at the same locations.
+         *
+         * @param data Pointer to the first value
+         * @param stride Distance between each value
+         * @param radix Number of values in this butterfly
+         * @param tstep Twiddle table step for this butterfly
+         */
+        void butterfly(std::complex<T>* data, int stride, int radix, int tstep) {
+
+            const std::complex<T>* tw = this->twiddles.data();
+
+            // Apply the twiddles:
+
+            if (tstep != 0) {
+
+                for (int q = 1; q < radix; ++q) {
+
+                    data[q * stride] *= tw[q * tstep];
+                }
+            }
+
+            switch (radix) {
+
+                case 2: {
+
+                    const std::complex<T> a0 = data[0];
+                    const std::complex<T> a1 = data[stride];
+
+                    data[0] = a0 + a1;
+                    data[stride] = a0 - a1;
+
+                    break;
+                }
+
+                case 3: {
+
+                    const T sin3 = T(0.866025403784438646763723170752936183L);
+
+                    const std::complex<T> a0 = data[0];
+                    const std::complex<T> sum = data[stride] + data[2 * stride];
+                    const std::complex<T> dif = data[stride] - data[2 * stride];
+
+                    const std::complex<T> mid = a0 - sum * T(0.5);
+                    const std::complex<T> rot(dif.imag() * sin3, -dif.real() * sin3);
+
+                    data[0] = a0 + sum;
+                    data[stride] = mid + rot;
+                    data[2 * stride] = mid - rot;
+
+                    break;
+                }
+
+                case 4: {
+
+                    const std::complex<T> t0 = data[0] + data[2 * stride];
+                    const std::complex<T> t1 = data[0] - data[2 * stride];
+                    const std::complex<T> t2 = data[stride] + data[3 * stride];
+                    const std::complex<T> d3 = data[stride] - data[3 * stride];
+
+                    // Multiply by -j:
+
+                    const std::complex<T> t3(d3.imag(), -d3.real());
+
+                    data[0] = t0 + t2;
+                    data[stride] = t1 + t3;
+                    data[2 * stride] = t0 - t2;
+                    data[3 * stride] = t1 - t3;
+
+                    break;
+                }
+
+                case 5: {
+
+                    const T cos1 = T(0.309016994374947424102293417182819059L);
+                    const T cos2 = T(-0.809016994374947424102293417182819059L);
+                    const T sin1 = T(0.951056516295153572116439333379382143L);
+                    const T sin2 = T(0.587785252292473129168705954639072769L);
+
+                    const std::complex<T> a0 = data[0];
+                    const std::complex<T> b1 = data[stride] + data[4 * stride];
+                    const std::complex<T> b2 = data[2 * stride] + data[3 * stride];
+                    const std::complex<T> d1 = data[stride] - data[4 * stride];
+                    const std::complex<T> d2 = data[2 * stride] - data[3 * stride];
+
+                    const std::complex<T> r1 = a0 + b1 * cos1 + b2 * cos2;
+                    const std::complex<T> r2 = a0 + b1 * cos2 + b2 * cos1;
+
+                    // Multiply the odd parts by -j:
+
+                    const std::complex<T> i1 = d1 * sin1 + d2 * sin2;
+                    const std::complex<T> i2 = d1 * sin2 - d2 * sin1;
+
+                    const std::complex<T> j1(i1.imag(), -i1.real());
+                    const std::complex<T> j2(i2.imag(), -i2.real());
+
+                    data[0] = a0 + b1 + b2;
+                    data[stride] = r1 + j1;
+                    data[4 * stride] = r1 - j1;
+                    data[2 * stride] = r2 + j2;
+                    data[3 * stride] = r2 - j2;
+
+                    break;
+                }
+
+                default: {
+
+                    // Generic DFT of size radix, using the twiddle table:
+
+                    const int rstep = this->fsize / radix;
+
+                    std::complex<T>* vals = this->scratch.data();
+
+                    for (int q = 0; q < radix; ++q) {
+
+                        vals[q] = data[q * stride];
+                    }
+
+                    for (int j = 0; j < radix; ++j) {
+
+                        std::complex<T> sum = vals[0];
+
+                        for (int q = 1; q < radix; ++q) {
+
+                            sum += vals[q] * tw[((j * q) % radix) * rstep];
+                        }
+
+                        data[j * stride] = sum;
+                    }
+                }
+            }
+        }
+
+    public:
+
+        FFTPlan() =default;
+
+        /**
+         * @brief Construct a new FFTPlan object
+         *
+         * @param size Size of the transform
+         */
+        explicit FFTPlan(int size) { this->prepare(size); }
+
+        /**
+         * @brief Prepares this plan for the given size
+         *
+         * We factor the size, compute the twiddle table,
+         * and compute the permutation.
+         * This requires allocation, and trigonometry for sizes not in the tables,
+         * so it should be done before processing starts.
+         * If the size has not changed, then we do nothing.
+         *
+         * @param size Size of the transform
+         */
+        void prepare(int size) {
+
+            if (size == this->fsize) {
+
+                return;
+            }
+
+            this->fsize = size;
+
+            // Factor the size, preferring radix-4:
+
+            this->factors.clear();
+
+            int rem = size;
+
+            for (int radix : {4, 2, 3, 5}) {
+
+                while (rem % radix == 0) {
+
+                    this->factors.push_back(radix);
+                    rem /= radix;
+                }
+            }
+
+            for (int radix = 7; rem > 1; radix += 2) {
+
+                while (rem % radix == 0) {
+
+                    this->factors.push_back(radix);
+                    rem /= radix;
+                }
+            }
+
+            // Compute the forward twiddle factors:
+
+            this->twiddles.resize(size);
+
+            for (int k = 0; k < size; ++k) {
+
+                this->twiddles[k] = table_covers(size) ? table_twiddle<T>(k, size) : std::polar<T>(T(1), static_cast<T>(-2.0L * M_PI * k / size));
+            }
+
+            // Compute the digit reversal permutation:
+
+            this->perm.resize(size);
+
+            for (int i = 0; i < size; ++i) {
+
+                int pos = 0;
+                int left = i;
+                int stride = size;
+
+                for (int radix : this->factors) {
+
+                    stride /= radix;
+                    pos += (left % radix) * stride;
+                    left /= radix;
+                }
+
+                this->perm[pos] = i;
+            }
+
+            this->work.resize(size);
+            this->scratch.resize(this->factors.empty() ? 1 : *std::max_element(this->factors.begin(), this->factors.end()));
+        }
+
+        /**
+         * @brief Computes the forward FFT
+         *
+         * The input and output may be the same.
+         *
+         * @tparam I Input iterator type
+         * @tparam O Output iterator type
+         * @param input Input iterator of complex data
+         * @param output Output iterator of complex data
+         */
+        template <typename I, typename O>
+        void forward(I input, O output) {
+
+            for (int i = 0; i < this->fsize; ++i) {
+
+                this->work[i] = *(input + this->perm[i]);
+            }
+
+            this->run();
+
+            std::copy(this->work.begin(), this->work.end(), output);
+        }
+
+        /**
+         * @brief Computes the normalized inverse FFT
+         *
+         * The input and output may be the same.
+         *
+         * @tparam I Input iterator type
+         * @tparam O Output iterator type
+         * @param input Input iterator of complex data
+         * @param output Output iterator of complex data
+         */
+        template <typename I, typename O>
+        void inverse(I input, O output) {
+
+            for (int i = 0; i < this->fsize; ++i) {
+
+                this->work[i] = std::conj(std::complex<T>(*(input + this->perm[i])));
+            }
+
+            this->run();
+
+            const T norm = T(1) / static_cast<T>(this->fsize);
+
+            std::transform(this->work.begin(), this->work.end(), output, [norm](const std::complex<T>& val) { return std::conj(val) * norm; });
+        }
+
+        /**
+         * @brief Gets the size of this plan
+         *
+         * @return int Size of the transform
+         */
+        int size() const { return this->fsize; }
+
+        /**
+         * @brief Gets the number of bytes held by this plan
+         *
+         * @return std::size_t Number of bytes held
+         */
+        std::size_t bytes() const {
+
+            return heap_bytes(this->factors) + heap_bytes(this->twiddles) + heap_bytes(this->perm) + heap_bytes(this->work) + heap_bytes(this->scratch);
+        }
+
+        /**
+         * @brief Gets the radix of each stage
+         *
+         * @return const std::vector<int>& Radix of each stage, outermost first
+         */
+        const std::vector<int>& get_factors() const { return this->factors; }
+};
+
+/**
+ * @brief A reusable plan for computing FFTs of real data
+ *
+ * Audio is real valued, so half of the work and memory
+ * of a complex FFT is wasted on imaginary parts that are always zero,
+ * and on the redundant upper half of the spectrum.
+ *
+ * This plan computes an N point real FFT using an N/2 point complex FFT.
+ * The real input is viewed as N/2 complex values
+ * (even samples in the real part, odd samples in the imaginary part),
+ * which requires no copying.
+ * After the complex transform, we use the A and B coefficients
+ * (see compute_a() and compute_b()) to split the result
+ * into the N/2 + 1 unique bins of the real spectrum.
+ * The inverse does the same steps backwards.
+ *
+ * The coefficients are computed once when the plan is prepared.
+ * The size MUST be even.
+ *
+ * Both transforms may be done in place.
+ * To do so, the buffer must be large enough to hold the spectrum,
+ * that is (N / 2 + 1) complex values, or N + 2 real values.
+ *
+ * @tparam T Floating point type to work with
+ */
+template <typename T = long double>
+class RealFFTPlan {
+
+    private:
+
+        /// Size of the real data
+        int fsize = 0;
+
+        /// Plan for the half size complex transform
+        FFTPlan<T> plan;
+
+        /// A coefficients for each bin
+        std::vector<std::complex<T>> acoef;
+
+        /// B coefficients for each bin
+        std::vector<std::complex<T>> bcoef;
+
+        /// Working memory for the half size spectrum
+        std::vector<std::complex<T>> spec;
+
+    public:
+
+        RealFFTPlan() =default;
+
+        /**
+         * @brief Construct a new RealFFTPlan object
+         *
+         * @param size Size of the real data
+         */
+        explicit RealFFTPlan(int size) { this->prepare(size); }
+
+        /**
+         * @brief Prepares this plan for the given size
+         *
+         * If the size has not changed, then we do nothing.
+         *
+         * @param size Size of the real data, must be even
+         */
+        void prepare(int size) {
+
+            if (size == this->fsize) {
+
+                return;
+            }
+
+            this->fsize = size;
+
+            const int half = size / 2;
+
+            this->plan.prepare(half);
+            this->spec.assign(half + 1, 0);
+
+            // Compute the coefficients:
+
+            this->acoef.resize(half + 1);
+            this->bcoef.resize(half + 1);
+
+            for (int k = 0; k <= half; ++k) {
+
+                this->acoef[k] = compute_a<T>(k, size);
+                this->bcoef[k] = compute_b<T>(k, size);
+            }
+        }
+
+        /**
+         * @brief Computes the forward real FFT
+         *
+         * The output will contain (N / 2 + 1) complex values.
+         * The output may point to the same memory as the input.
+         *
+         * @param input Pointer to N real values
+         * @param output Pointer to output spectrum
+         */
+        void forward(const T* input, std::complex<T>* output) {
+
+            const int half = this->fsize / 2;
+
+            // Transform the samples as packed complex values:
+
+            this->plan.forward(reinterpret_cast<const std::complex<T>*>(input), this->spec.begin());
+
+            this->spec[half] = this->spec[0];
+
+            // Split into the real spectrum:
+
+            for (int k = 0; k <= half; ++k) {
+
+                output[k] = this->spec[k] * this->acoef[k] + std::conj(this->spec[half - k]) * this->bcoef[k];
+            }
+        }
+
+        /**
+         * @brief Computes the normalized inverse real FFT
+         *
+         * The input must contain (N / 2 + 1) complex values.
+         * The output may point to the same memory as the input.
+         *
+         * @param input Pointer to input spectrum
+         * @param output Pointer to N real values
+         */
+        void inverse(const std::complex<T>* input, T* output) {
+
+            const int half = this->fsize / 2;
+
+            // Merge into the packed spectrum:
+
+            for (int k = 0; k < half; ++k) {
+
+                this->spec[k] = input[k] * std::conj(this->acoef[k]) + std::conj(input[half - k]) * std::conj(this->bcoef[k]);
+            }
+
+            // Transform back into the packed samples:
+
+            this->plan.inverse(this->spec.begin(), reinterpret_cast<std::complex<T>*>(output));
+        }
+
+        /**
+         * @brief Gets the size of this plan
+         *
+         * @return int Size of the real data
+         */
+        int size() const { return this->fsize; }
+
+        /**
+         * @brief Gets the number of bytes held by this plan
+         *
+         * @return std::size_t Number of bytes held
+         */
+        std::size_t bytes() const { return this->plan.bytes() + heap_bytes(this->acoef) + heap_bytes(this->bcoef) + heap_bytes(this->spec); }
+};
@@ -0,0 +1,206 @@
+/**
+ * @file goertzel.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tools for measuring a few frequencies of a signal
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Tone detection and tuning only need a handful of frequencies,
+ * so a full transform (see ft.hpp) computes far more than we use.
+ * The Goertzel algorithm measures a single frequency with a two pole resonator,
+ * costing one multiply and two adds for each sample.
+ *
+ * The GoertzelBank runs many resonators side by side.
+ * Their states are stored in contiguous arrays, one value per frequency,
+ * so each sample updates every frequency in a loop that vectorizes well.
+ * Frequencies do not have to fall on the bins of a transform,
+ * any frequency below Nyquist can be measured.
+ *
+ * Like the mixing kernels, the kernel is compiled for multiple instruction sets when possible.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "dsp/alloc.hpp"
+
+/**
+ * @brief Runs a number of Goertzel resonators over some samples
+ *
+ * For each sample, every resonator is updated with:
+ *
+ * s0 = x + coeff * s1 - s2
+ *
+ * and the states are shifted along.
+ * States are kept in double precision, as the resonators have poles on the unit circle.
+ *
+ * @param coeff Coefficient of each resonator, 2 * cos(w)
+ * @param first Latest state of each resonator
+ * @param second Previous state of each resonator
+ * @param bins Number of resonators
+ * @param in Samples to process
+ * @param num Number of samples
+ * @param stride Distance between samples
+ */
+void goertzel_run(const double* coeff, double* first, double* second, int bins, const float* in, int num, std::ptrdiff_t stride = 1);
+
+/// @copydoc goertzel_run(const double*, double*, double*, int, const float*, int, std::ptrdiff_t)
+void goertzel_run(const double* coeff, double* first, double* second, int bins, const double* in, int num, std::ptrdiff_t stride = 1);
+
+/// @copydoc goertzel_run(const double*, double*, double*, int, const float*, int, std::ptrdiff_t)
+void goertzel_run(const double* coeff, double* first, double* second, int bins, const long double* in, int num, std::ptrdiff_t stride = 1);
+
+/**
+ * @brief Measures a set of frequencies over windows of a signal
+ *
+ * Samples are fed in with process(),
+ * and once every (window) samples the magnitude of each frequency is determined
+ * and the resonators are cleared for the next window.
+ * Magnitudes are normalized so a full scale sine at one of our frequencies
+ * has a magnitude of about 1.
+ *
+ * The window should hold many periods of the lowest frequency,
+ * and the spacing of the frequencies should be wider than rate / window,
+ * otherwise neighbouring frequencies will leak into each other.
+ *
+ * All memory is allocated when configured,
+ * after which processing is allocation-free.
+ */
+class GoertzelBank {
+
+    public:
+
+        GoertzelBank() = default;
+
+        /**
+         * @brief Construct a new GoertzelBank object
+         *
+         * @param freqs Frequencies to measure in hertz
+         * @param rate Sample rate in hertz
+         * @param window Number of samples in each window
+         */
+        GoertzelBank(const std::vector<double>& freqs, double rate, int window) { this->configure(freqs, rate, window); }
+
+        /**
+         * @brief Sets the frequencies to measure
+         *
+         * This clears any measurements in progress.
+         *
+         * @param freqs Frequencies to measure in hertz
+         * @param rate Sample rate in hertz
+         * @param window Number of samples in each window, at least 1
+         */
+        void configure(const std::vector<double>& freqs, double rate, int window);
+
+        /**
+         * @brief Feeds samples into the resonators
+         *
+         * When a window is completed, the magnitudes are updated
+         * and measurement continues with the remaining samples.
+         *
+         * @tparam T Type of samples
+         * @param in Samples to process
+         * @param num Number of samples
+         * @param stride Distance between samples
+         * @return int Number of windows completed
+         */
+        template <typename T>
+        int process(const T* in, int num, std::ptrdiff_t stride = 1) {
+
+            int completed = 0;
+
+            while (num > 0) {
+
+                const int take = std::min(num, this->window - this->filled);
+
+                goertzel_run(this->coeff.data(), this->first.data(), this->second.data(), this->bins(), in, take, stride);
+
+                in += static_cast<std::ptrdiff_t>(take) * stride;
+                num -= take;
+
+                this->filled += take;
+
+                if (this->filled == this->window) {
+
+                    this->finish();
+
+                    ++completed;
+                }
+            }
+
+            return completed;
+        }
+
+        /**
+         * @brief Clears the measurements in progress
+         *
+         * The magnitudes of the last window are kept.
+         */
+        void reset();
+
+        /**
+         * @brief Gets the number of frequencies we measure
+         *
+         * @return int Number of frequencies
+         */
+        int bins() const { return static_cast<int>(this->coeff.size()); }
+
+        /**
+         * @brief Gets the number of samples in each window
+         *
+         * @return int Window size
+         */
+        int get_window() const { return this->window; }
+
+        /**
+         * @brief Gets the number of samples in the window in progress
+         *
+         * @return int Samples measured so far
+         */
+        int get_filled() const { return this->filled; }
+
+        /**
+         * @brief Gets the magnitudes of the last completed window
+         *
+         * @return const std::vector<double>& Magnitude of each frequency
+         */
+        const std::vector<double>& magnitudes() const { return this->magnitude; }
+
+        /**
+         * @brief Gets the number of bytes held by this bank
+         *
+         * @return std::size_t Number of bytes held
+         */
+        std::size_t bytes() const { return heap_bytes(this->coeff) + heap_bytes(this->first) + heap_bytes(this->second) + heap_bytes(this->magnitude); }
+
+    private:
+
+        /**
+         * @brief Determines the results of the window, and clears the resonators
+         *
+         */
+        void finish();
+
+        /// Coefficient of each resonator
+        std::vector<double> coeff;
+
+        /// Latest state of each resonator
+        std::vector<double> first;
+
+        /// Previous state of each resonator
+        std::vector<double> second;
+
+        /// Magnitude of each frequency in the last window
+        std::vector<double> magnitude;
+
+        /// Number of samples in each window
+        int window = 1;
+
+        /// Number of samples in the window in progress
+        int filled = 0;
+};
@@ -0,0 +1,307 @@
+/**
+ * @file halfband.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Half-band filters for changing the sample rate by 2
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * A half-band filter is a lowpass with a cutoff at a quarter of the sample rate.
+ * Designed as a windowed sinc (see sinc_kernel()), every other tap is zero,
+ * except for the center tap which is exactly 0.5.
+ *
+ * This makes them ideal for doubling or halving the sample rate.
+ * Split into two polyphase branches,
+ * one branch holds all of the non-zero side taps, and the other is a plain delay.
+ * So each output of an interpolator (or each input pair of a decimator)
+ * costs a single dot product of the side taps, which is a quarter of the full filter.
+ *
+ * Filters are described by the number of side taps, which must be even.
+ * A filter with N side taps is 2N - 1 taps long,
+ * and delays the signal by N - 1 samples at the high rate.
+ *
+ * Higher ratios are reached by chaining stages, see OversampleModule.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "dsp/alloc.hpp"
+#include "dsp/kernel.hpp"
+
+/**
+ * @brief Designs the side taps of a half-band filter
+ *
+ * We design the full filter with sinc_kernel(),
+ * and keep only the non-zero side taps.
+ * The side taps are scaled so they sum to 0.5,
+ * which with the center tap of 0.5 gives a gain of exactly 1 at DC.
+ * The taps are symmetric, so they can be applied in either direction.
+ *
+ * @tparam O Type of output iterator
+ * @param taps Number of side taps, must be even
+ * @param output Iterator to output, must have space for taps values
+ * @param window Window function to utilize
+ */
+template <typename O>
+void halfband_kernel(int taps, O output, window_functiont window = window_blackman) {
+
+    // Design the full filter, with a zero tap on each end so the window does not waste a side tap:
+
+    const int size = 2 * taps + 1;
+
+    std::vector<long double> full(size);
+
+    sinc_kernel(0.25, size, full.begin(), window);
+
+    // Keep the side taps, which sit at an odd distance from the center:
+
+    std::vector<long double> side(taps);
+
+    long double sum = 0;
+
+    for (int k = 0; k < taps; ++k) {
+
+        side[k] = full[static_cast<std::size_t>(2 * k) + 1];
+        sum += side[k];
+    }
+
+    // Scale so the side taps sum to half:
+
+    for (int k = 0; k < taps; ++k) {
+
+        *(output + k) = side[k] * 0.5 / sum;
+    }
+}
+
+/**
+ * @brief Doubles the sample rate of a block of samples
+ *
+ * The input must contain taps - 1 samples of history before the new samples,
+ * and output must have room for 2 * num samples.
+ *
+ * @param input Pointer to history, followed by the new samples
+ * @param output Pointer to output samples
+ * @param num Number of new input samples
+ * @param coeffs Side taps designed with halfband_kernel()
+ * @param taps Number of side taps
+ */
+void halfband_interpolate(const float* input, float* output, int num, const float* coeffs, int taps);
+
+/// @copydoc halfband_interpolate(const float*, float*, int, const float*, int)
+void halfband_interpolate(const double* input, double* output, int num, const double* coeffs, int taps);
+
+/// @copydoc halfband_interpolate(const float*, float*, int, const float*, int)
+void halfband_interpolate(const long double* input, long double* output, int num, const long double* coeffs, int taps);
+
+/**
+ * @brief Halves the sample rate of a block of samples
+ *
+ * The incoming samples are split into even and odd samples.
+ * The even samples must be preceded by taps - 1 samples of history,
+ * and the odd samples by taps / 2 samples of history.
+ *
+ * @param even Pointer to even history, followed by the new even samples
+ * @param odd Pointer to odd history, followed by the new odd samples
+ * @param output Pointer to output samples
+ * @param num Number of output samples, which is the number of new even (and odd) samples
+ * @param coeffs Side taps designed with halfband_kernel()
+ * @param taps Number of side taps
+ */
+void halfband_decimate(const float* even, const float* odd, float* output, int num, const float* coeffs, int taps);
+
+/// @copydoc halfband_decimate(const float*, const float*, float*, int, const float*, int)
+void halfband_decimate(const double* even, const double* odd, double* output, int num, const double* coeffs, int taps);
+
+/// @copydoc halfband_decimate(const float*, const float*, float*, int, const float*, int)
+void halfband_decimate(const long double* even, const long double* odd, long double* output, int num, const long double* coeffs, int taps);
+
+/**
+ * @brief Streaming half-band filter for one channel
+ *
+ * We keep the history needed to interpolate and decimate
+ * a continuous signal one block at a time.
+ * Interpolation and decimation keep separate history,
+ * so one instance can be used on both sides of an oversampled process.
+ *
+ * Windows are allocated by reserve(),
+ * processing larger blocks will cause them to be reallocated.
+ *
+ * @tparam T Type of samples
+ */
+template <typename T>
+class HalfbandFIR {
+
+    private:
+
+        /// Side taps of the filter
+        std::vector<T> coeffs;
+
+        /// Window of interpolator history followed by the current block
+        std::vector<T> up;
+
+        /// Window of even decimator history followed by the current block
+        std::vector<T> even;
+
+        /// Window of odd decimator history followed by the current block
+        std::vector<T> odd;
+
+        /**
+         * @brief Ensures a window has room for a block
+         *
+         * @param window Window to check
+         * @param hist Number of history samples
+         * @param num Number of new samples
+         */
+        static void fit(std::vector<T>& window, int hist, int num) {
+
+            if (static_cast<int>(window.size()) < hist + num) {
+
+                window.resize(hist + num, T(0));
+            }
+        }
+
+        /**
+         * @brief Carries the end of a window over as history
+         *
+         * @param window Window to shift
+         * @param hist Number of history samples
+         * @param num Number of new samples
+         */
+        static void shift(std::vector<T>& window, int hist, int num) { std::copy(window.begin() + num, window.begin() + num + hist, window.begin()); }
+
+    public:
+
+        /**
+         * @brief Construct a new Halfband FIR object
+         *
+         * @param taps Number of side taps, rounded up to be even
+         */
+        explicit HalfbandFIR(int taps = 16) { this->set_taps(taps); }
+
+        /**
+         * @brief Sets the number of side taps
+         *
+         * We design the filter and clear all history.
+         *
+         * @param taps Number of side taps, rounded up to be even
+         */
+        void set_taps(int taps) {
+
+            taps = std::max(taps + (taps % 2), 2);
+
+            this->coeffs.resize(taps);
+
+            halfband_kernel(taps, this->coeffs.begin());
+
+            this->up.assign(taps - 1, T(0));
+            this->even.assign(taps - 1, T(0));
+            this->odd.assign(taps / 2, T(0));
+        }
+
+        /**
+         * @brief Gets the number of side taps
+         *
+         * @return int Number of side taps
+         */
+        int get_taps() const { return static_cast<int>(this->coeffs.size()); }
+
+        /**
+         * @brief Gets the side taps
+         *
+         * @return const std::vector<T>& Side taps
+         */
+        const std::vector<T>& get_coeffs() const { return this->coeffs; }
+
+        /**
+         * @brief Gets the delay of one filter, in samples at the high rate
+         *
+         * @return int Delay of the interpolator (or decimator)
+         */
+        int delay() const { return this->get_taps() - 1; }
+
+        /**
+         * @brief Gets the number of bytes held by this filter
+         *
+         * @return std::size_t Number of bytes held
+         */
+        std::size_t bytes() const { return heap_bytes(this->coeffs) + heap_bytes(this->up) + heap_bytes(this->even) + heap_bytes(this->odd); }
+
+        /**
+         * @brief Allocates room for blocks of a given size
+         *
+         * @param num Largest number of samples at the low rate
+         */
+        void reserve(int num) {
+
+            fit(this->up, this->get_taps() - 1, num);
+            fit(this->even, this->get_taps() - 1, num);
+            fit(this->odd, this->get_taps() / 2, num);
+        }
+
+        /**
+         * @brief Doubles the sample rate of a block
+         *
+         * @param input Pointer to samples at the low rate
+         * @param num Number of input samples
+         * @param output Pointer to output, must have room for 2 * num samples
+         */
+        void interpolate(const T* input, int num, T* output) {
+
+            const int hist = this->get_taps() - 1;
+
+            fit(this->up, hist, num);
+
+            std::copy_n(input, num, this->up.begin() + hist);
+
+            halfband_interpolate(this->up.data(), output, num, this->coeffs.data(), this->get_taps());
+
+            shift(this->up, hist, num);
+        }
+
+        /**
+         * @brief Halves the sample rate of a block
+         *
+         * @param input Pointer to 2 * num samples at the high rate
+         * @param num Number of output samples
+         * @param output Pointer to output samples
+         */
+        void decimate(const T* input, int num, T* output) {
+
+            const int ehist = this->get_taps() - 1;
+            const int ohist = this->get_taps() / 2;
+
+            fit(this->even, ehist, num);
+            fit(this->odd, ohist, num);
+
+            // Split the even and odd samples:
+
+            for (int i = 0; i < num; ++i) {
+
+                this->even[ehist + i] = input[2 * i];
+                this->odd[ohist + i] = input[2 * i + 1];
+            }
+
+            halfband_decimate(this->even.data(), this->odd.data(), output, num, this->coeffs.data(), this->get_taps());
+
+            shift(this->even, ehist, num);
+            shift(this->odd, ohist, num);
+        }
+
+        /**
+         * @brief Clears all history
+         *
+         * After this call, processing behaves as if
+         * the signal was silent before the next block.
+         */
+        void reset() {
+
+            std::ranges::fill(this->up, T(0));
+            std::ranges::fill(this->even, T(0));
+            std::ranges::fill(this->odd, T(0));
+        }
+};
@@ -15,11 +15,15 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
 #include <deque>
 #include <vector>
 #include <cmath>
 
 #include "dsp/const.hpp"
+#include "dsp/denormal.hpp"
+#include "dsp/fastmath.hpp"
 
 /**
  * @brief Preforms a recursive IIR filter on a single input
@@ -126,6 +130,9 @@ class IIRFilter {
         /// Number of B coefficients
         int bsize = 0;
 
+        /// Value determining if decayed state is flushed to zero
+        bool flush = true;
+
     public:
 
         IIRFilter() =default;
@@ -135,33 +142,22 @@ class IIRFilter {
         /**
          * @brief Reserves components for operation.
          * 
-         * We reserve the A and B coefficient vectors,
-         * along with the input and output deques.
+         * We size the A and B coefficient vectors,
+         * and fill the input and output deques with zeros.
          * This function will be called automatically where necessary.
          * 
          */
         void reserve() {
 
-            // First, reserve A and B vectors:
+            // First, size A and B vectors:
 
-            this->acoes.reserve(this->asize);
-            this->bcoes.reserve(this->bcoes);
+            this->acoes.resize(this->asize);
+            this->bcoes.resize(this->bsize);
 
             // Next, fill input and output deques:
 
-            for (int i = 0; i < this->asize; ++i) {
-
-                // Fill input with 0:
-
-                this->input.push_front(0);
-            }
-
-            for (int i = 0; i < this->bsize; ++i) {
-
-                // Fill output with 0:
-
-                this->input.push_front(0);
-            }
+            this->input.assign(this->asize, 0);
+            this->output.assign(this->bsize, 0);
         }
 
         /**
@@ -264,6 +260,27 @@ class IIRFilter {
          */
         T get_b(int index) const { return this->bcoes[index]; }
 
+        /**
+         * @brief Sets if state is flushed to zero once decayed
+         *
+         * When enabled, state values under DENORMAL_LEVEL are set to zero
+         * at the end of each call to process(),
+         * so filtering silence never reaches denormal values (see dsp/denormal.hpp).
+         * This is enabled by default, and is needed for long double,
+         * which is not covered by the flush to zero mode of the CPU.
+         *
+         * @param enable true to flush state, false to leave it alone
+         */
+        void set_flush(bool enable) { this->flush = enable; }
+
+        /**
+         * @brief Determines if state is flushed to zero once decayed
+         *
+         * @return true If state is flushed
+         * @return false If state is left alone
+         */
+        bool get_flush() const { return this->flush; }
+
         /**
          * @brief Filters the given signal in place.
          * 
@@ -287,6 +304,8 @@ class IIRFilter {
                                      this->abegin(), this->bbegin(),
                                      this->asize, this->bsize);
             }
+
+            this->flush_state();
         }
 
         /**
@@ -315,6 +334,465 @@ class IIRFilter {
                     *(input + i), this->input, this->output, this->abegin(),
                     this->bbegin(), this->asize, this->bsize);
             }
+
+            this->flush_state();
+        }
+
+    private:
+
+        /**
+         * @brief Flushes decayed state to zero, if enabled
+         *
+         */
+        void flush_state() {
+
+            if (this->flush) {
+
+                flush_denormals(this->input);
+                flush_denormals(this->output);
+            }
+        }
+};
+
+/**
+ * @brief Coefficients of a single second order section
+ *
+ * Unlike the coefficients used by IIRFilter,
+ * these follow the usual convention for biquads,
+ * where b values are feedforward and a values are feedback:
+ *
+ * y[n] = b0 * x[n] + b1 * x[n-1] + b2 * x[n-2] - a1 * y[n-1] - a2 * y[n-2]
+ *
+ * a0 is always normalized to 1.
+ * First order sections are represented by leaving b2 and a2 at 0.
+ *
+ * @tparam T Type of the coefficients
+ */
+template <typename T>
+struct BiquadCoefficients {
+
+    /// Feedforward coefficients
+    T b0 = 1, b1 = 0, b2 = 0;
+
+    /// Feedback coefficients
+    T a1 = 0, a2 = 0;
+};
+
+/**
+ * @brief Runs a block through a single second order section
+ *
+ * We use the transposed direct form II,
+ * which only needs two state values per section
+ * and has good numerical behavior with floating point values.
+ * The state is held in locals for the whole block,
+ * and written back when we are done.
+ * Input and output may be the same.
+ *
+ * @tparam T Type of the values
+ * @param coeff Coefficients of the section
+ * @param state Two state values, carried across blocks
+ * @param input Pointer to input data
+ * @param size Number of values to process
+ * @param output Pointer to output data
+ */
+template <typename T>
+void biquad_process(const BiquadCoefficients<T>& coeff, T* state, const T* input, int size, T* output) {
+
+    const T b0 = coeff.b0, b1 = coeff.b1, b2 = coeff.b2, a1 = coeff.a1, a2 = coeff.a2;
+
+    T z1 = state[0];
+    T z2 = state[1];
+
+    for (int i = 0; i < size; ++i) {
+
+        const T x = input[i];
+        const T y = b0 * x + z1;
+
+        z1 = b1 * x - a1 * y + z2;
+        z2 = b2 * x - a2 * y;
+
+        output[i] = y;
+    }
+
+    state[0] = z1;
+    state[1] = z2;
+}
+
+/**
+ * @brief An IIR filter made of a cascade of second order sections
+ *
+ * High order IIR filters are very sensitive to rounding
+ * when implemented directly (as IIRFilter does).
+ * Splitting them into second order sections (biquads)
+ * keeps them stable, and is cheaper to run:
+ * each section keeps two state values that live in registers,
+ * and blocks are run through one section at a time.
+ *
+ * State is kept between calls to process(),
+ * so a continuous signal may be filtered one block at a time.
+ *
+ * @tparam T Type of value to work with
+ */
+template <typename T>
+class BiquadCascade {
+
+    private:
+
+        /// Coefficients of each section
+        std::vector<BiquadCoefficients<T>> sections;
+
+        /// Two state values for each section
+        std::vector<T> state;
+
+        /// Value determining if decayed state is flushed to zero
+        bool flush = true;
+
+    public:
+
+        BiquadCascade() =default;
+
+        /**
+         * @brief Allocates state for the current sections
+         *
+         * Any previous state is cleared.
+         * This function will be called automatically where necessary.
+         */
+        void reserve() { this->state.assign(this->sections.size() * 2, 0); }
+
+        /**
+         * @brief Clears the state of every section
+         *
+         */
+        void reset() { std::ranges::fill(this->state, 0); }
+
+        /**
+         * @brief Sets the sections to use
+         *
+         * State is reserved and cleared.
+         *
+         * @tparam U Type of the given coefficients
+         * @param secs Coefficients of each section
+         */
+        template <typename U>
+        void set_sections(const std::vector<BiquadCoefficients<U>>& secs) {
+
+            this->sections.clear();
+
+            for (const auto& sec : secs) {
+
+                this->sections.push_back({static_cast<T>(sec.b0), static_cast<T>(sec.b1), static_cast<T>(sec.b2),
+                                          static_cast<T>(sec.a1), static_cast<T>(sec.a2)});
+            }
+
+            this->reserve();
+        }
+
+        /**
+         * @brief Gets the number of sections
+         *
+         * @return int Number of sections
+         */
+        int num_sections() const { return static_cast<int>(this->sections.size()); }
+
+        /**
+         * @brief Gets the coefficients of a section
+         *
+         * @param index Index of the section
+         * @return const BiquadCoefficients<T>& Coefficients of the section
+         */
+        const BiquadCoefficients<T>& get_section(int index) const { return this->sections[index]; }
+
+        /**
+         * @brief Sets if state is flushed to zero once decayed
+         *
+         * When enabled, state values under DENORMAL_LEVEL are set to zero
+         * at the end of each call to process(),
+         * so filtering silence never reaches denormal values (see dsp/denormal.hpp).
+         * This is enabled by default, and is needed for long double,
+         * which is not covered by the flush to zero mode of the CPU.
+         *
+         * @param enable true to flush state, false to leave it alone
+         */
+        void set_flush(bool enable) { this->flush = enable; }
+
+        /**
+         * @brief Determines if state is flushed to zero once decayed
+         *
+         * @return true If state is flushed
+         * @return false If state is left alone
+         */
+        bool get_flush() const { return this->flush; }
+
+        /**
+         * @brief Filters the given signal out of place
+         *
+         * The first section reads the input,
+         * each following section works in place on the output.
+         *
+         * @param input Pointer to input data
+         * @param size Size of signal
+         * @param output Pointer to output data
+         */
+        void process(const T* input, int size, T* output) {
+
+            if (this->sections.empty()) {
+
+                std::copy_n(input, size, output);
+
+                return;
+            }
+
+            for (std::size_t s = 0; s < this->sections.size(); ++s) {
+
+                biquad_process(this->sections[s], this->state.data() + 2 * s, s == 0 ? input : output, size, output);
+            }
+
+            if (this->flush) {
+
+                flush_denormals(this->state);
+            }
+        }
+
+        /**
+         * @brief Filters the given signal in place
+         *
+         * @param input Signal to process
+         * @param size Size of signal
+         */
+        void process(T* input, int size) { this->process(input, size, input); }
+};
+
+/**
+ * @brief Runs a block of interleaved channels through a single second order section
+ *
+ * Every channel shares the same coefficients, but has its own state.
+ * As the channels of a frame sit next to each other,
+ * we process them in groups of 8 (and then 4) channels at a time,
+ * each channel in its own vector lane.
+ * State for a group is held in locals for the whole block.
+ *
+ * The state holds the first state value of every channel,
+ * followed by the second state value of every channel.
+ * Input and output may be the same.
+ *
+ * @param coeff Coefficients of the section
+ * @param state (2 * channels) state values, carried across blocks
+ * @param input Pointer to interleaved input data
+ * @param frames Number of frames to process
+ * @param channels Number of channels in each frame
+ * @param output Pointer to interleaved output data
+ */
+void biquad_interleaved(const BiquadCoefficients<float>& coeff, float* state, const float* input, int frames, int channels, float* output);
+
+/// @copydoc biquad_interleaved(const BiquadCoefficients<float>&, float*, const float*, int, int, float*)
+void biquad_interleaved(const BiquadCoefficients<double>& coeff, double* state, const double* input, int frames, int channels, double* output);
+
+/// @copydoc biquad_interleaved(const BiquadCoefficients<float>&, float*, const float*, int, int, float*)
+void biquad_interleaved(const BiquadCoefficients<long double>& coeff, long double* state, const long double* input, int frames, int channels, long double* output);
+
+/**
+ * @brief A cascade of second order sections shared by many channels
+ *
+ * This is the multichannel counterpart to BiquadCascade,
+ * for when the same filter is applied to every channel (such as a master EQ).
+ * Coefficients are stored once, and each channel keeps its own state.
+ * Interleaved blocks are processed with the channels running in parallel
+ * vector lanes (see biquad_interleaved()),
+ * channels stored one after another are processed one channel at a time.
+ *
+ * @tparam T Type of value to work with
+ */
+template <typename T>
+class BiquadBank {
+
+    private:
+
+        /// Coefficients of each section
+        std::vector<BiquadCoefficients<T>> sections;
+
+        /// State for each section, see biquad_interleaved() for the layout
+        std::vector<T> state;
+
+        /// Number of channels
+        int nchannels = 0;
+
+        /// Value determining if decayed state is flushed to zero
+        bool flush = true;
+
+    public:
+
+        BiquadBank() =default;
+
+        /**
+         * @brief Sets the sections to use
+         *
+         * State is reserved and cleared.
+         *
+         * @tparam U Type of the given coefficients
+         * @param secs Coefficients of each section
+         */
+        template <typename U>
+        void set_sections(const std::vector<BiquadCoefficients<U>>& secs) {
+
+            this->sections.clear();
+
+            for (const auto& sec : secs) {
+
+                this->sections.push_back({static_cast<T>(sec.b0), static_cast<T>(sec.b1), static_cast<T>(sec.b2),
+                                          static_cast<T>(sec.a1), static_cast<T>(sec.a2)});
+            }
+
+            this->reserve();
+        }
+
+        /**
+         * @brief Sets the number of channels
+         *
+         * State is reserved and cleared.
+         *
+         * @param num Number of channels
+         */
+        void set_channels(int num) {
+
+            this->nchannels = num;
+
+            this->reserve();
+        }
+
+        /**
+         * @brief Replaces the coefficients of a section
+         *
+         * Unlike set_sections(), state is kept,
+         * so coefficients may be changed while filtering.
+         *
+         * @tparam U Type of the given coefficients
+         * @param index Index of the section to replace
+         * @param sec New coefficients
+         */
+        template <typename U>
+        void update_section(int index, const BiquadCoefficients<U>& sec) {
+
+            this->sections[index] = {static_cast<T>(sec.b0), static_cast<T>(sec.b1), static_cast<T>(sec.b2),
+                                     static_cast<T>(sec.a1), static_cast<T>(sec.a2)};
+        }
+
+        /**
+         * @brief Gets the number of channels
+         *
+         * @return int Number of channels
+         */
+        int channels() const { return this->nchannels; }
+
+        /**
+         * @brief Gets the number of sections
+         *
+         * @return int Number of sections
+         */
+        int num_sections() const { return static_cast<int>(this->sections.size()); }
+
+        /**
+         * @brief Sets if state is flushed to zero once decayed
+         *
+         * When enabled, state values under DENORMAL_LEVEL are set to zero
+         * at the end of each call to process(),
+         * so filtering silence never reaches denormal values (see dsp/denormal.hpp).
+         * This is enabled by default, and is needed for long double,
+         * which is not covered by the flush to zero mode of the CPU.
+         *
+         * @param enable true to flush state, false to leave it alone
+         */
+        void set_flush(bool enable) { this->flush = enable; }
+
+        /**
+         * @brief Determines if state is flushed to zero once decayed
+         *
+         * @return true If state is flushed
+         * @return false If state is left alone
+         */
+        bool get_flush() const { return this->flush; }
+
+        /**
+         * @brief Allocates state for the current sections and channels
+         *
+         */
+        void reserve() { this->state.assign(this->sections.size() * 2 * this->nchannels, 0); }
+
+        /**
+         * @brief Clears the state of every channel
+         *
+         */
+        void reset() { std::ranges::fill(this->state, 0); }
+
+        /**
+         * @brief Determines if the state of every channel has decayed
+         *
+         * Once decayed, filtering silence produces (nearly) silence,
+         * so the caller may skip filtering and reset() instead.
+         *
+         * @param level Magnitude under which state is considered decayed
+         * @return true If every state value is under the level
+         * @return false If some channel is still ringing
+         */
+        bool settled(T level) const { return std::ranges::all_of(this->state, [level](T val) { return std::fabs(val) < level; }); }
+
+        /**
+         * @brief Filters an interleaved block
+         *
+         * @param input Pointer to interleaved input data
+         * @param frames Number of frames to process
+         * @param output Pointer to interleaved output data
+         */
+        void process_interleaved(const T* input, int frames, T* output) {
+
+            const auto total = static_cast<std::ptrdiff_t>(frames) * this->nchannels;
+
+            if (this->sections.empty()) {
+
+                std::copy_n(input, total, output);
+
+                return;
+            }
+
+            for (std::size_t s = 0; s < this->sections.size(); ++s) {
+
+                biquad_interleaved(this->sections[s], this->state.data() + 2 * s * this->nchannels, s == 0 ? input : output, frames, this->nchannels, output);
+            }
+
+            if (this->flush) {
+
+                flush_denormals(this->state);
+            }
+        }
+
+        /**
+         * @brief Filters a block of a single channel
+         *
+         * @param channel Channel the block belongs to
+         * @param input Pointer to input data
+         * @param frames Number of values to process
+         * @param output Pointer to output data
+         */
+        void process_channel(int channel, const T* input, int frames, T* output) {
+
+            if (this->sections.empty()) {
+
+                std::copy_n(input, frames, output);
+
+                return;
+            }
+
+            for (std::size_t s = 0; s < this->sections.size(); ++s) {
+
+                // Gather the state of this channel:
+
+                T* base = this->state.data() + 2 * s * this->nchannels;
+                T local[2] = {base[channel], base[this->nchannels + channel]};
+
+                biquad_process(this->sections[s], local, s == 0 ? input : output, frames, output);
+
+                base[channel] = this->flush ? flush_denormal(local[0]) : local[0];
+                base[this->nchannels + channel] = this->flush ? flush_denormal(local[1]) : local[1];
+            }
         }
 };
 
@@ -336,16 +814,19 @@ class IIRFilter {
  * We also describe some methods for generating the coefficients.
  * 
  * This class aims to standardize and simplify the implementation of IIR filters!
+ * Filters may pick the engine that runs them,
+ * which is the direct form IIRFilter by default.
  * 
  * @tparam T Type of value to work with
+ * @tparam E Engine that runs the filter
  */
-template <typename T>
-class BaseIIRImplementation : public IIRFilter<T> {
+template <typename T, typename E = IIRFilter<T>>
+class BaseIIRImplementation : public E {
 
     private:
 
         /// Sample rate
-        int sample_rate;
+        int sample_rate = SAMPLE_RATE;
 
         /// Lower frequency cutoff
         double freq_high = 0.;
@@ -354,7 +835,7 @@ class BaseIIRImplementation : public IIRFilter<T> {
         double freq_low = 0.;
 
         /// Filter type
-        FilterType type;
+        FilterType type = FilterType::LowPass;
 
     public:
 
@@ -476,11 +957,11 @@ class BaseIIRImplementation : public IIRFilter<T> {
          * and will vary from filter to filter!
          * 
          * Child classes should implement and call the parent function,
-         * as we automatically configure and reserve the IIRFilter class.
+         * as we automatically configure and reserve the engine.
          */
         virtual void generate_coefficients() {
 
-            // Reserve the IIRFilter class:
+            // Reserve the engine:
 
             this->reserve();
         }
@@ -513,13 +994,13 @@ class SinglePole : public BaseIIRImplementation<T> {
          * @param freq Frequency fraction to convert
          * @return double New X value
          */
-        double frac_to_x(double freq) { return std::exp(-2 * M_PI * freq); }
+        double frac_to_x(double freq) { return fast_exp<MathAccuracy::High>(-2 * M_PI * freq); }
 
         /**
          * @brief Generates the coefficients for this filter
          * 
          */
-        void generate_coefficients() {
+        void generate_coefficients() override {
 
             // Determine if we are a low pass filter:
 
@@ -534,7 +1015,7 @@ class SinglePole : public BaseIIRImplementation<T> {
 
                 // Determine the X value:
 
-                double xval = this->frac_to_x(this->get_freq_high());
+                double xval = this->frac_to_x(this->get_frac_high());
 
                 // Generate A & B coefficients:
 
@@ -555,14 +1036,170 @@ class SinglePole : public BaseIIRImplementation<T> {
 
                 // Determine the x value:
 
-                double xval = this->frac_to_x(this->get_freq_low());
+                double xval = this->frac_to_x(this->get_frac_low());
 
                 // Generate A & B coefficients:
 
                 this->set_a(0, (1 + xval) / 2);
                 this->set_a(1, -(1 + xval) / 2);
 
-                this->set_b(0, this->get_freq_low());
+                this->set_b(0, xval);
             }
         }
 };
+
+/// Analog prototypes that IIR filters can be designed from
+enum class IIRPrototype { Butterworth, Chebyshev };
+
+/**
+ * @brief Designs the second order sections of an IIR filter
+ *
+ * We start from the poles of an analog low pass prototype,
+ * transform them to the requested filter type around the pre-warped cutoffs,
+ * and map them to the digital domain with the bilinear transform.
+ * Poles and zeros are then paired into sections,
+ * each normalized to unity gain at a reference frequency
+ * (DC for low pass and band reject, Nyquist for high pass,
+ * and the center frequency for band pass).
+ *
+ * Low and high pass filters have ceil(order / 2) sections,
+ * band filters have (order) sections.
+ * Chebyshev filters ripple between 1 and the given ripple below 1
+ * in the pass band.
+ *
+ * Cutoffs are fractions of the sample rate.
+ * Low pass filters use the high cutoff, high pass filters use the low cutoff.
+ *
+ * @param proto Analog prototype to use
+ * @param type Type of filter
+ * @param order Order of the prototype
+ * @param low Low cutoff fraction
+ * @param high High cutoff fraction
+ * @param ripple Pass band ripple in decibels, only used by Chebyshev filters
+ * @return std::vector<BiquadCoefficients<double>> Coefficients of each section
+ */
+std::vector<BiquadCoefficients<double>> iir_design(IIRPrototype proto, FilterType type, int order, double low, double high, double ripple = 1.0);
+
+/**
+ * @brief Designs a single second order section
+ *
+ * This is a cheap closed form design, with no allocations,
+ * so it is suitable for recomputing coefficients while filtering.
+ * The cutoff (or center for band filters) is pre-warped,
+ * and Q sets the resonance (or bandwidth for band filters).
+ * A Q of 1/sqrt(2) gives a second order Butterworth response.
+ *
+ * @param type Type of filter
+ * @param freq Cutoff as a fraction of the sample rate
+ * @param q Quality factor
+ * @return BiquadCoefficients<double> Coefficients of the section
+ */
+BiquadCoefficients<double> biquad_design(FilterType type, double freq, double q = M_SQRT1_2);
+
+/**
+ * @brief Base class for IIR filters run as a cascade of biquads
+ *
+ * We add an order to the usual filter parameters,
+ * and design the sections using iir_design().
+ *
+ * @tparam T Type to work with
+ */
+template <typename T>
+class BaseBiquadImplementation : public BaseIIRImplementation<T, BiquadCascade<T>> {
+
+    private:
+
+        /// Order of the analog prototype
+        int order = 2;
+
+    protected:
+
+        /**
+         * @brief Designs and installs the sections
+         *
+         * @param proto Analog prototype to use
+         * @param ripple Pass band ripple in decibels
+         */
+        void design(IIRPrototype proto, double ripple) {
+
+            this->set_sections(iir_design(proto, this->get_type(), this->order, this->get_frac_low(), this->get_frac_high(), ripple));
+        }
+
+    public:
+
+        /**
+         * @brief Gets the order of this filter
+         *
+         * @return int Order of the analog prototype
+         */
+        int get_order() const { return this->order; }
+
+        /**
+         * @brief Sets the order of this filter
+         *
+         * Higher orders give sharper transitions.
+         * Band filters end up with twice as many poles as the order.
+         *
+         * @param num New order
+         */
+        void set_order(int num) { this->order = std::max(1, num); }
+};
+
+/**
+ * @brief Implementation of a Butterworth filter
+ *
+ * Butterworth filters are maximally flat in the pass band,
+ * and roll off at 6 dB per octave per order.
+ *
+ * @tparam T Type to work with
+ */
+template <typename T>
+class ButterworthFilter : public BaseBiquadImplementation<T> {
+
+    public:
+
+        /**
+         * @brief Generates the coefficients for this filter
+         *
+         */
+        void generate_coefficients() override { this->design(IIRPrototype::Butterworth, 0); }
+};
+
+/**
+ * @brief Implementation of a Chebyshev (type I) filter
+ *
+ * Chebyshev filters trade ripple in the pass band
+ * for a sharper transition than a Butterworth filter of the same order.
+ *
+ * @tparam T Type to work with
+ */
+template <typename T>
+class ChebyshevFilter : public BaseBiquadImplementation<T> {
+
+    private:
+
+        /// Pass band ripple in decibels
+        double ripple = 1.0;
+
+    public:
+
+        /**
+         * @brief Gets the pass band ripple
+         *
+         * @return double Ripple in decibels
+         */
+        double get_ripple() const { return this->ripple; }
+
+        /**
+         * @brief Sets the pass band ripple
+         *
+         * @param val New ripple in decibels
+         */
+        void set_ripple(double val) { this->ripple = val; }
+
+        /**
+         * @brief Generates the coefficients for this filter
+         *
+         */
+        void generate_coefficients() override { this->design(IIRPrototype::Chebyshev, this->ripple); }
+};
@@ -0,0 +1,60 @@
+/**
+ * @file interleave.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Interleave and deinterleave kernels
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This file contains kernels that convert blocks of samples
+ * between the planar and interleaved layouts (see Planar and Interleaved in dsp/buffer.hpp).
+ * Most devices and files speak interleaved audio,
+ * while per channel processing prefers planar audio,
+ * so these are used at the edges of the graph.
+ *
+ * Mono and stereo data have dedicated paths, as they are by far the most common.
+ * Like the other kernels, these are compiled for multiple instruction sets when possible.
+ */
+
+#pragma once
+
+/**
+ * @brief Converts a planar block into an interleaved block
+ *
+ * out[frame * channels + channel] = in[channel * frames + frame]
+ *
+ * The input and output must not overlap.
+ *
+ * @param in Pointer to planar data
+ * @param out Pointer to interleaved output
+ * @param channels Number of channels
+ * @param frames Number of samples in each channel
+ */
+void interleave(const float* in, float* out, int channels, int frames);
+
+/// @copydoc interleave(const float*, float*, int, int)
+void interleave(const double* in, double* out, int channels, int frames);
+
+/// @copydoc interleave(const float*, float*, int, int)
+void interleave(const long double* in, long double* out, int channels, int frames);
+
+/**
+ * @brief Converts an interleaved block into a planar block
+ *
+ * out[channel * frames + frame] = in[frame * channels + channel]
+ *
+ * The input and output must not overlap.
+ *
+ * @param in Pointer to interleaved data
+ * @param out Pointer to planar output
+ * @param channels Number of channels
+ * @param frames Number of samples in each channel
+ */
+void deinterleave(const float* in, float* out, int channels, int frames);
+
+/// @copydoc deinterleave(const float*, float*, int, int)
+void deinterleave(const double* in, double* out, int channels, int frames);
+
+/// @copydoc deinterleave(const float*, float*, int, int)
+void deinterleave(const long double* in, long double* out, int channels, int frames);
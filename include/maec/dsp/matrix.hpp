@@ -8,18 +8,34 @@
  * @copyright Copyright (c) 2023
  * 
  * This header contains matrix and common matrix operations
- * that may be useful in DSP contexts.
- * These implementations are very basic!
- * These are no replacements for mature linear algebra libraries.
- * The speed of these operations are also probably not ideal,
- * so it is not recommended to use these components in realtime scenarios.
+ * that may be useful in DSP contexts,
+ * such as multichannel routing, downmixing and ambisonic decoding,
+ * which all apply a matrix of gains to every frame of a block.
  * 
  * We utilize the generic multi-channel AudioBuffer as a matrix
  * in these operations, as it can correctly emulate the necessary functionality.
+ * Each channel is a row, and each sample is a column.
+ * Applying a matrix of gains to a buffer of audio is then the product:
+ * 
+ * out = gains * in
+ * 
+ * Where gains has one channel per output and one sample per input,
+ * and in has one channel per input with (n) samples each.
+ * 
+ * The heavy lifting is done by gemm() and gemv(),
+ * which work on a MatrixView so they do not care about the layout of the buffer.
+ * gemm() works on cache sized tiles with a vectorized inner loop,
+ * and never allocates, so it is safe to use in real-time contexts.
+ * If maec was built with MAEC_BLAS, gemm() dispatches float and double
+ * products to the BLAS library instead.
  */
 
 #pragma once
 
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
 #include "dsp/buffer.hpp"
 
 /**
@@ -54,7 +70,7 @@
 template <typename A, typename B, typename T = typename std::iterator_traits<A>::value_type>
 T dot_product(const A& aiter, const B& biter, int num) {
 
-    int done = 0;
+    T done = 0;
 
     // Iterate over each value in the provided iterators:
 
@@ -68,12 +84,168 @@ T dot_product(const A& aiter, const B& biter, int num) {
     return done;
 }
 
+/**
+ * @brief Computes the dot product of two contiguous vectors
+ *
+ * This is the same as the iterator version,
+ * but we keep several partial sums so the loop vectorizes.
+ * The result may differ from the iterator version by rounding.
+ *
+ * @param avec Pointer to the first vector
+ * @param bvec Pointer to the second vector
+ * @param num Number of values in each vector
+ * @return float Scalar result of dot product
+ */
+float dot_product(const float* avec, const float* bvec, int num);
+
+/// @copydoc dot_product(const float*, const float*, int)
+double dot_product(const double* avec, const double* bvec, int num);
+
+/// @copydoc dot_product(const float*, const float*, int)
+long double dot_product(const long double* avec, const long double* bvec, int num);
+
+/**
+ * @brief A strided view of a matrix in memory
+ *
+ * The value at <row, col> lives at:
+ *
+ * data[row * rstride + col * cstride]
+ *
+ * Views do not own their data, and can describe matrices
+ * stored in either order, or a transpose of one, without copying.
+ * Use matrix_view() to get a view of a buffer.
+ *
+ * @tparam T Type of the values, may be const
+ */
+template <typename T>
+struct MatrixView {
+
+    /// Pointer to the value at <0, 0>
+    T* data = nullptr;
+
+    /// Number of rows
+    int rows = 0;
+
+    /// Number of columns
+    int cols = 0;
+
+    /// Distance between rows
+    std::ptrdiff_t rstride = 0;
+
+    /// Distance between columns
+    std::ptrdiff_t cstride = 0;
+
+    /**
+     * @brief Gets the value at a position
+     *
+     * @param row Row of the value
+     * @param col Column of the value
+     * @return T& Value at the position
+     */
+    T& at(int row, int col) const { return this->data[(row * this->rstride) + (col * this->cstride)]; }
+
+    /**
+     * @brief Gets the transpose of this matrix
+     *
+     * @return MatrixView<T> View with rows and columns swapped
+     */
+    MatrixView<T> transpose() const { return {this->data, this->cols, this->rows, this->cstride, this->rstride}; }
+
+    /**
+     * @brief Allows views of mutable data to be used as views of const data
+     *
+     * @return MatrixView<const T> Const view of the same data
+     */
+    operator MatrixView<const T>() const requires(!std::is_const_v<T>) { return {this->data, this->rows, this->cols, this->rstride, this->cstride}; }
+};
+
+/**
+ * @brief Gets a view of a buffer as a matrix
+ *
+ * Each channel is a row, and each sample is a column.
+ *
+ * @tparam B Type of buffer
+ * @param buff Buffer to view
+ * @return MatrixView View of the buffer
+ */
+template <typename B>
+auto matrix_view(B& buff) {
+
+    using L = typename std::remove_const_t<B>::layout;
+
+    const std::size_t channels = buff.channels();
+    const std::size_t capacity = buff.channel_capacity();
+
+    using V = std::remove_pointer_t<decltype(buff.data())>;
+
+    return MatrixView<V>{buff.data(), static_cast<int>(channels), static_cast<int>(capacity),
+        static_cast<std::ptrdiff_t>(L::offset(1, 0, channels, capacity) - L::offset(0, 0, channels, capacity)),
+        static_cast<std::ptrdiff_t>(L::offset(0, 1, channels, capacity) - L::offset(0, 0, channels, capacity))};
+}
+
+/**
+ * @brief Computes a matrix product
+ *
+ * out = a * b
+ *
+ * Or, when accumulating:
+ *
+ * out += a * b
+ *
+ * The number of columns in a must equal the number of rows in b,
+ * and out must have the rows of a and the columns of b.
+ * The output must not overlap either input.
+ *
+ * We work on tiles small enough to stay in cache,
+ * copying each tile of b into contiguous memory on the stack
+ * so the inner loop is a vectorized multiply-add over a row.
+ * Views stored column by column (such as interleaved buffers)
+ * are handled by computing the transposed product, so no layout is slower than another.
+ *
+ * @param out Matrix to store the result in
+ * @param a Left matrix
+ * @param b Right matrix
+ * @param accumulate true to add to the output rather than replace it
+ */
+void gemm(MatrixView<float> out, MatrixView<const float> a, MatrixView<const float> b, bool accumulate = false);
+
+/// @copydoc gemm(MatrixView<float>, MatrixView<const float>, MatrixView<const float>, bool)
+void gemm(MatrixView<double> out, MatrixView<const double> a, MatrixView<const double> b, bool accumulate = false);
+
+/// @copydoc gemm(MatrixView<float>, MatrixView<const float>, MatrixView<const float>, bool)
+void gemm(MatrixView<long double> out, MatrixView<const long double> a, MatrixView<const long double> b, bool accumulate = false);
+
+/**
+ * @brief Computes the product of a matrix and a vector
+ *
+ * out = a * vec
+ *
+ * Or, when accumulating:
+ *
+ * out += a * vec
+ *
+ * This is gemm() for a single column, such as a single frame of audio.
+ *
+ * @param out Pointer to the output vector, one value per row of a
+ * @param a Matrix to apply
+ * @param vec Pointer to the input vector, one value per column of a
+ * @param accumulate true to add to the output rather than replace it
+ */
+void gemv(float* out, MatrixView<const float> a, const float* vec, bool accumulate = false);
+
+/// @copydoc gemv(float*, MatrixView<const float>, const float*, bool)
+void gemv(double* out, MatrixView<const double> a, const double* vec, bool accumulate = false);
+
+/// @copydoc gemv(float*, MatrixView<const float>, const float*, bool)
+void gemv(long double* out, MatrixView<const long double> a, const long double* vec, bool accumulate = false);
+
 /**
  * @brief Preforms a matrix multiplication on the provided buffers.
  * 
  * Given two buffers, the matrix product will be computed and placed
  * in the out buffer.
  * We will automatically size and configure the out buffer for you!
+ * If the out buffer is already the correct size, then nothing is allocated.
  * 
  * The matrix multiplication can be described as computing the dot product
  * of each row and column for each value in the out array.
@@ -106,17 +278,17 @@ T dot_product(const A& aiter, const B& biter, int num) {
  * At the end of the day, to compute the position of the output
  * matrix at any position <r, c> will be:
  * 
- * dot(row(A, r), row(B, c))
+ * dot(row(A, r), col(B, c))
  * 
- * We utilize the Buffer methods to retrieve the row and column
- * of the input matrixes.
- * Also, if the provided matrixes have a different number of rows and columns,
- * then this operation will fail!
- * The number of rows in A MUST equal the number of columns in B!
+ * Rows are channels and columns are samples, see matrix_view().
+ * The number of columns in A MUST equal the number of rows in B!
  * 
  * This operation is NOT communicative!
  * You may get very different results if you switch the order of A and B.
  * 
+ * When all buffers hold the same floating point type, we use gemm().
+ * Otherwise, each value is summed in the type of the output.
+ * 
  * @tparam T Type of input matrix A
  * @tparam U Type of input matrix B
  * @tparam V Type of output matrix
@@ -127,36 +299,48 @@ T dot_product(const A& aiter, const B& biter, int num) {
 template <typename T, typename U, typename V>
 void matrix_mult(const Buffer<T>& buf1, const Buffer<U>& buf2, Buffer<V>& out) {
 
+    const auto rows = static_cast<int>(buf1.channels());
+    const auto cols = static_cast<int>(buf2.channel_capacity());
+
     // Configure the out buffer to match our size:
 
-    out.set_channels(buf2.channels());
-    out.set_channel_capacity(buf1.channel_capacity());
+    out.set_channels(rows);
+
+    if (out.size() != static_cast<std::size_t>(rows) * cols) {
+
+        out.resize(rows * cols);
+    }
+
+    if constexpr (std::is_floating_point_v<T> && std::is_same_v<T, U> && std::is_same_v<T, V>) {
+
+        gemm(matrix_view(out), matrix_view(buf1), matrix_view(buf2));
+    }
 
-    // Iterate over the rows:
+    else {
 
-    for (int row = 0; row < buf1.channel_capacity(); ++row) {
+        const auto inner = static_cast<int>(buf1.channel_capacity());
 
-        // Iterate over the cols:
+        // Iterate over the rows:
 
-        for (int col = 0; col < buf2.channels(); ++col) {
+        for (int row = 0; row < rows; ++row) {
 
-            // Grab the iterators:
+            // Iterate over the cols:
 
-            auto rowv = buf1.scbegin();
-            auto colv = buf2.icbegin();
+            for (int col = 0; col < cols; ++col) {
 
-            // Set the iterator position:
+                // Compute the dot product at this position:
 
-            rowv.set_channel(row);
-            colv.set_sample(col);
+                V done = 0;
 
-            // Compute the dot product at this position:
+                for (int i = 0; i < inner; ++i) {
 
-            auto done = dot_product(rowv, colv, buf1.channel_capacity());
+                    done += buf1.at(row, i) * buf2.at(i, col);
+                }
 
-            // Store the dot product in the final buffer:
+                // Store the dot product in the final buffer:
 
-            out.at(row, col) = done;
+                out.at(row, col) = done;
+            }
         }
     }
 }
@@ -0,0 +1,75 @@
+/**
+ * @file mix.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Batch mixing kernels
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This file contains kernels that accumulate one block of samples into another.
+ * These are used by the mixers, which sum many input buffers into one.
+ * The kernels work on contiguous memory with no loop carried dependencies,
+ * so they vectorize well.
+ *
+ * Like the oscillator kernels, these are compiled for multiple instruction sets when possible.
+ */
+
+#pragma once
+
+/**
+ * @brief Adds a block of samples into another
+ *
+ * out[i] += in[i]
+ *
+ * @param out Pointer to data to add to
+ * @param in Pointer to data to add
+ * @param size Number of samples
+ */
+void mix_add(float* out, const float* in, int size);
+
+/// @copydoc mix_add(float*, const float*, int)
+void mix_add(double* out, const double* in, int size);
+
+/// @copydoc mix_add(float*, const float*, int)
+void mix_add(long double* out, const long double* in, int size);
+
+/**
+ * @brief Adds a scaled block of samples into another
+ *
+ * out[i] += in[i] * gain
+ *
+ * @param out Pointer to data to add to
+ * @param in Pointer to data to add
+ * @param size Number of samples
+ * @param gain Value to scale the input by
+ */
+void mix_add(float* out, const float* in, int size, float gain);
+
+/// @copydoc mix_add(float*, const float*, int, float)
+void mix_add(double* out, const double* in, int size, double gain);
+
+/// @copydoc mix_add(float*, const float*, int, float)
+void mix_add(long double* out, const long double* in, int size, long double gain);
+
+/**
+ * @brief Adds a windowed and scaled block of samples into another
+ *
+ * out[i] += in[i] * window[i] * gain
+ *
+ * This is the inner loop of granular synthesis,
+ * where each grain is a windowed slice of a sample.
+ *
+ * @param out Pointer to data to add to
+ * @param in Pointer to data to add
+ * @param window Pointer to window coefficients
+ * @param size Number of samples
+ * @param gain Value to scale the input by
+ */
+void mix_window_add(float* out, const float* in, const float* window, int size, float gain);
+
+/// @copydoc mix_window_add(float*, const float*, const float*, int, float)
+void mix_window_add(double* out, const double* in, const double* window, int size, double gain);
+
+/// @copydoc mix_window_add(float*, const float*, const float*, int, float)
+void mix_window_add(long double* out, const long double* in, const long double* window, int size, long double gain);
@@ -0,0 +1,184 @@
+/**
+ * @file osc.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Batch oscillator kernels
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This file contains kernels that fill an entire block of memory
+ * with a periodic waveform in one call.
+ * These are the workhorses of the fundamental oscillators,
+ * and are designed to be as friendly to the vectorizer as possible:
+ *
+ * - Phase is computed for each sample from the start phase,
+ *   rather than accumulated, so there is no loop carried dependency
+ * - Sine is computed via a polynomial rather than calling sin()
+ * - All branches are expressed as selects
+ *
+ * Phase values given to these kernels are in 'turns',
+ * that is to say a phase of 1 is one full cycle of the waveform.
+ * The increment is the number of turns to advance per sample,
+ * which is the frequency divided by the sample rate.
+ *
+ * The kernels are compiled for multiple instruction sets when possible,
+ * and the best one for the current CPU is selected at runtime.
+ * On x86 we build an AVX2 version alongside the default one.
+ * On ARM, NEON is part of the base instruction set, so the default kernel
+ * is already vectorized.
+ *
+ * We also offer bank kernels, which run many sine voices at once.
+ * The phase, increment and amplitude of each voice are stored in separate arrays
+ * (structure of arrays), so each step of time updates a whole vector of voices
+ * in one instruction, 8 floats with AVX2 and 16 across two registers.
+ * Voices are kept in single precision for the widest vectors,
+ * and phases are accumulated per sample and wrapped into [0, 1).
+ */
+
+#pragma once
+
+#include <cmath>
+
+#include "dsp/fastmath.hpp"
+
+/**
+ * @brief Approximates sine of a phase in turns
+ *
+ * We compute sin(2 * pi * turn) using the high accuracy fast sine (see fast_sin_turns()).
+ * The maximum absolute error of this function is around 3e-11,
+ * which is well below the resolution of a float sample.
+ *
+ * @tparam T Type to work with
+ * @param turn Phase in turns
+ * @return T Approximate sine value
+ */
+template <typename T>
+inline T sine_turns(T turn) { return fast_sin_turns<MathAccuracy::High>(turn); }
+
+/**
+ * @brief Fills a block with a sine wave
+ *
+ * @param out Pointer to output data
+ * @param size Number of samples to generate
+ * @param start Starting phase in turns
+ * @param inc Phase increment per sample in turns
+ */
+void osc_sine(float* out, int size, double start, double inc);
+
+/// @copydoc osc_sine(float*, int, double, double)
+void osc_sine(double* out, int size, double start, double inc);
+
+/// @copydoc osc_sine(float*, int, double, double)
+void osc_sine(long double* out, int size, double start, double inc);
+
+/**
+ * @brief Fills a block with a square wave
+ *
+ * The first half of each cycle is 1,
+ * the second half is -1.
+ *
+ * @param out Pointer to output data
+ * @param size Number of samples to generate
+ * @param start Starting phase in turns
+ * @param inc Phase increment per sample in turns
+ */
+void osc_square(float* out, int size, double start, double inc);
+
+/// @copydoc osc_square(float*, int, double, double)
+void osc_square(double* out, int size, double start, double inc);
+
+/// @copydoc osc_square(float*, int, double, double)
+void osc_square(long double* out, int size, double start, double inc);
+
+/**
+ * @brief Fills a block with a sawtooth wave
+ *
+ * The wave starts at 0, rises to 1,
+ * jumps to -1 at the half cycle and rises back to 0.
+ *
+ * @param out Pointer to output data
+ * @param size Number of samples to generate
+ * @param start Starting phase in turns
+ * @param inc Phase increment per sample in turns
+ */
+void osc_sawtooth(float* out, int size, double start, double inc);
+
+/// @copydoc osc_sawtooth(float*, int, double, double)
+void osc_sawtooth(double* out, int size, double start, double inc);
+
+/// @copydoc osc_sawtooth(float*, int, double, double)
+void osc_sawtooth(long double* out, int size, double start, double inc);
+
+/**
+ * @brief Fills a block with a triangle wave
+ *
+ * The wave starts at 0, rises to 1 at a quarter cycle,
+ * falls to -1 at three quarters and rises back to 0.
+ *
+ * @param out Pointer to output data
+ * @param size Number of samples to generate
+ * @param start Starting phase in turns
+ * @param inc Phase increment per sample in turns
+ */
+void osc_triangle(float* out, int size, double start, double inc);
+
+/// @copydoc osc_triangle(float*, int, double, double)
+void osc_triangle(double* out, int size, double start, double inc);
+
+/// @copydoc osc_triangle(float*, int, double, double)
+void osc_triangle(long double* out, int size, double start, double inc);
+
+/// Number of voices the bank kernels advance together
+constexpr int OSC_BANK_LANES = 16;
+
+/**
+ * @brief Sums a bank of sine voices into a block
+ *
+ * out[i] = sum(amp[v] * sin(2 * pi * phase[v])), with each phase advanced by inc[v] per sample
+ *
+ * The number of voices MUST be a multiple of OSC_BANK_LANES,
+ * unused voices should have an amplitude of 0.
+ * Increments must be in (-1, 1).
+ * The phases are updated in place, so the next block continues where this one ends.
+ *
+ * @param phase Phase of each voice in turns, in [0, 1)
+ * @param inc Phase increment of each voice per sample in turns
+ * @param amp Amplitude of each voice
+ * @param voices Number of voices
+ * @param out Pointer to output data
+ * @param size Number of samples to generate
+ */
+void osc_bank_sum(float* phase, const float* inc, const float* amp, int voices, float* out, int size);
+
+/// @copydoc osc_bank_sum(float*, const float*, const float*, int, float*, int)
+void osc_bank_sum(float* phase, const float* inc, const float* amp, int voices, double* out, int size);
+
+/// @copydoc osc_bank_sum(float*, const float*, const float*, int, float*, int)
+void osc_bank_sum(float* phase, const float* inc, const float* amp, int voices, long double* out, int size);
+
+/**
+ * @brief Renders a bank of sine voices into separate outputs
+ *
+ * out[i * voices + v] = amp[v] * sin(2 * pi * phase[v]), with each phase advanced by inc[v] per sample
+ *
+ * The output is interleaved, one channel per voice,
+ * so each step of time writes the voices contiguously.
+ * Any number of voices may be given.
+ * Increments must be in (-1, 1).
+ * The phases are updated in place.
+ *
+ * @param phase Phase of each voice in turns, in [0, 1)
+ * @param inc Phase increment of each voice per sample in turns
+ * @param amp Amplitude of each voice
+ * @param voices Number of voices
+ * @param out Pointer to interleaved output data
+ * @param size Number of frames to generate
+ */
+void osc_bank_voices(float* phase, const float* inc, const float* amp, int voices, float* out, int size);
+
+/// @copydoc osc_bank_voices(float*, const float*, const float*, int, float*, int)
+void osc_bank_voices(float* phase, const float* inc, const float* amp, int voices, double* out, int size);
+
+/// @copydoc osc_bank_voices(float*, const float*, const float*, int, float*, int)
+void osc_bank_voices(float* phase, const float* inc, const float* amp, int voices, long double* out, int size);
@@ -0,0 +1,68 @@
+/**
+ * @file ramp.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Batch ramp kernels
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This file contains kernels that fill an entire block of memory
+ * with a linear or exponential ramp in one call.
+ * These are used by the ramp envelopes, which would otherwise
+ * evaluate the closed form ramp (including a call to pow())
+ * for every sample.
+ *
+ * Ramps are described by a start value and a per-sample step:
+ *
+ * - Linear ramps compute start + step * i
+ * - Exponential ramps compute start * ratio^i
+ *
+ * The linear ramp has no loop carried dependency, so it vectorizes directly.
+ * The exponential ramp uses a multiplicative recurrence across a few
+ * independent lanes, and is re-anchored with a real pow()
+ * every RAMP_ANCHOR samples, so rounding error can't build up over long ramps.
+ *
+ * Values under DENORMAL_LEVEL are written as zero (see dsp/denormal.hpp),
+ * so ramps towards zero (such as releases) never produce denormals,
+ * even when the values are converted to a smaller type.
+ *
+ * Like the oscillator kernels, these are compiled for multiple instruction sets when possible.
+ */
+
+#pragma once
+
+/// Number of samples between each re-anchor of an exponential ramp
+const int RAMP_ANCHOR = 64;
+
+/**
+ * @brief Fills a block with a linear ramp
+ *
+ * @param out Pointer to output data
+ * @param size Number of samples to generate
+ * @param start Value of the first sample
+ * @param step Value to add for each sample
+ */
+void ramp_linear(float* out, int size, double start, double step);
+
+/// @copydoc ramp_linear(float*, int, double, double)
+void ramp_linear(double* out, int size, double start, double step);
+
+/// @copydoc ramp_linear(float*, int, double, double)
+void ramp_linear(long double* out, int size, double start, double step);
+
+/**
+ * @brief Fills a block with an exponential ramp
+ *
+ * @param out Pointer to output data
+ * @param size Number of samples to generate
+ * @param start Value of the first sample
+ * @param ratio Value to multiply by for each sample
+ */
+void ramp_exponential(float* out, int size, double start, double ratio);
+
+/// @copydoc ramp_exponential(float*, int, double, double)
+void ramp_exponential(double* out, int size, double start, double ratio);
+
+/// @copydoc ramp_exponential(float*, int, double, double)
+void ramp_exponential(long double* out, int size, double start, double ratio);
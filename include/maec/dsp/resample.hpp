@@ -0,0 +1,110 @@
+/**
+ * @file resample.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Polyphase resampling kernels
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This file contains components for changing the sample rate of a signal
+ * by an arbitrary ratio.
+ *
+ * We use a polyphase FIR filter.
+ * A windowed sinc kernel is designed at a high rate (taps * phases samples long),
+ * and is split into 'phases' sub-filters of 'taps' samples each.
+ * Each sub-filter produces an output sample at a different fractional offset
+ * between two input samples.
+ * To produce an output at any fractional position,
+ * we run the two nearest sub-filters and linearly interpolate between them.
+ *
+ * The cost of each output sample is fixed (two dot products of 'taps' samples),
+ * regardless of the ratio between the sample rates.
+ *
+ * Positions given to these kernels are in input samples,
+ * and the step is the number of input samples to advance per output sample,
+ * which is the input rate divided by the output rate.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "dsp/kernel.hpp"
+#include "dsp/window.hpp"
+
+/**
+ * @brief Determines the cutoff frequency for a resampler
+ *
+ * The cutoff is placed so the transition band of the filter
+ * ends at the Nyquist frequency of the lower of the two rates.
+ * This prevents aliasing when downsampling,
+ * and imaging when upsampling.
+ *
+ * @param ratio Output rate divided by input rate
+ * @param taps Number of taps in each sub-filter
+ * @return double Cutoff frequency, normalized to the input rate
+ */
+inline double resample_cutoff(double ratio, int taps) { return (ratio < 1 ? ratio : 1.0) * (0.5 - 2.75 / taps); }
+
+/**
+ * @brief Builds a polyphase filter table
+ *
+ * The table contains phases + 1 sub-filters of 'taps' values each,
+ * one after the other.
+ * The extra sub-filter at the end allows interpolation past the last phase.
+ * Each sub-filter is reversed, so it can be applied as a forward dot product.
+ *
+ * @tparam O Type of output iterator
+ * @param cutoff Cutoff frequency, normalized to the input rate
+ * @param taps Number of taps in each sub-filter
+ * @param phases Number of phases
+ * @param output Iterator to output table, must have space for (phases + 1) * taps values
+ * @param window Window function to utilize
+ */
+template <typename O>
+void polyphase_table(double cutoff, int taps, int phases, O output, window_functiont window = window_blackman) {
+
+    // Design the prototype at the high rate:
+
+    const int size = taps * phases + 1;
+
+    std::vector<long double> proto(size);
+
+    sinc_kernel(cutoff / phases, size, proto.begin(), window);
+
+    // Split into sub-filters, restoring the gain of each one:
+
+    for (int p = 0; p <= phases; ++p) {
+
+        for (int i = 0; i < taps; ++i) {
+
+            *(output + static_cast<std::ptrdiff_t>(p) * taps + i) = proto[static_cast<std::size_t>(taps - 1 - i) * phases + p] * phases;
+        }
+    }
+}
+
+/**
+ * @brief Resamples a block of samples
+ *
+ * Output sample j is taken at input position start + j * step.
+ * The input must contain history around each position,
+ * that is to say output j reads input samples from
+ * floor(pos) - taps / 2 + 1 through floor(pos) + taps / 2.
+ *
+ * @param input Pointer to input samples
+ * @param output Pointer to output samples
+ * @param num Number of output samples to generate
+ * @param start Position of the first output sample, in input samples
+ * @param step Number of input samples to advance per output sample
+ * @param table Polyphase table built with polyphase_table()
+ * @param taps Number of taps in each sub-filter
+ * @param phases Number of phases in the table
+ */
+void resample(const float* input, float* output, int num, double start, double step, const float* table, int taps, int phases);
+
+/// @copydoc resample(const float*, float*, int, double, double, const float*, int, int)
+void resample(const double* input, double* output, int num, double start, double step, const double* table, int taps, int phases);
+
+/// @copydoc resample(const float*, float*, int, double, double, const float*, int, int)
+void resample(const long double* input, long double* output, int num, double start, double step, const long double* table, int taps, int phases);
@@ -0,0 +1,613 @@
+/**
+ * @file ring.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Lock-free ring buffers for passing data between threads
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This file contains ring buffers that are safe to use
+ * between threads without any locking.
+ * These are used to decouple components that run at different paces,
+ * such as the thread rendering the chain and a real-time audio thread
+ * that feeds a device.
+ *
+ * Unlike RingBuffer (see dsp/buffer.hpp), these buffers track
+ * separate read and write positions,
+ * and will never overwrite data that has not been read.
+ * Capacities are always a power of two, so positions are wrapped with a mask
+ * rather than a modulo.
+ *
+ * SPSCRing is the fastest option, and supports bulk transfers.
+ * MPSCRing allows many threads to write at once,
+ * at the cost of moving a single value at a time.
+ *
+ * When only the latest value matters, such as state displayed by a UI,
+ * TripleBuffer hands over whole values and lets the writer
+ * overwrite anything the reader has not picked up.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A lock-free single-producer single-consumer ring buffer
+ *
+ * One thread may write to this buffer while another reads from it,
+ * with no locks and no allocations.
+ * The read and write positions are only ever advanced,
+ * and are kept on separate cache lines so the two threads
+ * do not fight over the same memory.
+ *
+ * The capacity is rounded up to the next power of two,
+ * which allows positions to be wrapped with a mask.
+ * Reads and writes are done in bulk, and will move as many values
+ * as are available, up to the requested amount.
+ *
+ * This class is NOT safe for more than one reader or more than one writer!
+ *
+ * @tparam T Type of data to store
+ */
+template <typename T>
+class SPSCRing {
+
+    private:
+
+        /// Storage for the values
+        std::vector<T> buff;
+
+        /// Mask used to wrap positions
+        std::size_t mask = 0;
+
+        /// Total number of values written, only changed by the producer
+        alignas(64) std::atomic<std::size_t> whead{0};
+
+        /// Total number of values read, only changed by the consumer
+        alignas(64) std::atomic<std::size_t> rhead{0};
+
+    public:
+
+        SPSCRing() =default;
+
+        /**
+         * @brief Construct a new SPSCRing object
+         *
+         * @param capacity Minimum number of values to hold
+         */
+        explicit SPSCRing(std::size_t capacity) { this->reserve(capacity); }
+
+        /**
+         * @brief Allocates room for the given number of values
+         *
+         * Any existing data is discarded.
+         * This is NOT thread safe, and should only be called
+         * when neither thread is using the buffer.
+         *
+         * @param capacity Minimum number of values to hold
+         */
+        void reserve(std::size_t capacity) {
+
+            std::size_t size = 1;
+
+            while (size < capacity) {
+
+                size *= 2;
+            }
+
+            this->buff.clear();
+            this->buff.resize(size);
+            this->mask = size - 1;
+
+            this->clear();
+        }
+
+        /**
+         * @brief Discards all data in the buffer
+         *
+         * This is NOT thread safe, and should only be called
+         * when neither thread is using the buffer.
+         */
+        void clear() {
+
+            this->whead.store(0, std::memory_order_relaxed);
+            this->rhead.store(0, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Gets the capacity of this buffer
+         *
+         * @return std::size_t Number of values this buffer can hold
+         */
+        std::size_t capacity() const { return this->buff.size(); }
+
+        /**
+         * @brief Gets the number of values that can be read
+         *
+         * @return std::size_t Number of values available for reading
+         */
+        std::size_t read_available() const {
+
+            return this->whead.load(std::memory_order_acquire) - this->rhead.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Gets the number of values that can be written
+         *
+         * @return std::size_t Number of free spaces
+         */
+        std::size_t write_available() const {
+
+            return this->capacity() - (this->whead.load(std::memory_order_relaxed) - this->rhead.load(std::memory_order_acquire));
+        }
+
+        /**
+         * @brief Writes values into the buffer
+         *
+         * We write as many values as we have room for, up to num.
+         * This should only be called by the producer.
+         *
+         * @tparam I Input iterator type
+         * @param input Start iterator of values to write
+         * @param num Number of values to write
+         * @return std::size_t Number of values written
+         */
+        template <typename I>
+        std::size_t write(I input, std::size_t num) {
+
+            const std::size_t pos = this->whead.load(std::memory_order_relaxed);
+            const std::size_t free = this->capacity() - (pos - this->rhead.load(std::memory_order_acquire));
+
+            const std::size_t total = std::min(num, free);
+
+            // Copy in up to two parts, before and after the wrap:
+
+            const std::size_t start = pos & this->mask;
+            const std::size_t first = std::min(total, this->capacity() - start);
+
+            std::copy_n(input, first, this->buff.begin() + start);
+            std::copy_n(input + first, total - first, this->buff.begin());
+
+            // Publish the values:
+
+            this->whead.store(pos + total, std::memory_order_release);
+
+            return total;
+        }
+
+        /**
+         * @brief Moves a single value into the buffer
+         *
+         * This works with types that can only be moved, such as BufferPointers.
+         * This should only be called by the producer.
+         *
+         * @param val Value to move in
+         * @return true If the value was written
+         * @return false If the buffer is full, val is left untouched
+         */
+        bool push(T&& val) {
+
+            const std::size_t pos = this->whead.load(std::memory_order_relaxed);
+
+            if (pos - this->rhead.load(std::memory_order_acquire) >= this->capacity()) {
+
+                return false;
+            }
+
+            this->buff[pos & this->mask] = std::move(val);
+
+            this->whead.store(pos + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        /**
+         * @brief Moves a single value out of the buffer
+         *
+         * This should only be called by the consumer.
+         *
+         * @param val Value to move out into
+         * @return true If a value was read
+         * @return false If the buffer is empty
+         */
+        bool pop(T& val) {
+
+            const std::size_t pos = this->rhead.load(std::memory_order_relaxed);
+
+            if (this->whead.load(std::memory_order_acquire) == pos) {
+
+                return false;
+            }
+
+            val = std::move(this->buff[pos & this->mask]);
+
+            this->rhead.store(pos + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        /**
+         * @brief Reads values from the buffer
+         *
+         * We read as many values as are available, up to num.
+         * This should only be called by the consumer.
+         *
+         * @tparam O Output iterator type
+         * @param output Start iterator to place values
+         * @param num Number of values to read
+         * @return std::size_t Number of values read
+         */
+        template <typename O>
+        std::size_t read(O output, std::size_t num) {
+
+            const std::size_t pos = this->rhead.load(std::memory_order_relaxed);
+            const std::size_t avail = this->whead.load(std::memory_order_acquire) - pos;
+
+            const std::size_t total = std::min(num, avail);
+
+            // Copy out up to two parts, before and after the wrap:
+
+            const std::size_t start = pos & this->mask;
+            const std::size_t first = std::min(total, this->capacity() - start);
+
+            std::copy_n(this->buff.begin() + start, first, output);
+            std::copy_n(this->buff.begin(), total - first, output + first);
+
+            // Release the space:
+
+            this->rhead.store(pos + total, std::memory_order_release);
+
+            return total;
+        }
+};
+
+/**
+ * @brief A lock-free multi-producer single-consumer ring buffer
+ *
+ * Any number of threads may write to this buffer,
+ * while one thread reads from it.
+ * There are no locks and no allocations once constructed.
+ *
+ * Each slot carries a sequence number which tells producers and the
+ * consumer whose turn it is to use the slot.
+ * Producers claim a slot by advancing the write position with a compare and swap,
+ * and publish the value by bumping the sequence of the slot.
+ * The consumer waits for the sequence to show the value is ready,
+ * and then hands the slot back to producers for the next lap.
+ *
+ * Values are moved in and out, so types that can only be moved
+ * (such as BufferPointers) work fine.
+ *
+ * @tparam T Type of data to store
+ */
+template <typename T>
+class MPSCRing {
+
+    private:
+
+        /**
+         * @brief A single slot in the ring
+         */
+        struct Slot {
+
+            /// Sequence number of this slot
+            std::atomic<std::size_t> seq{0};
+
+            /// Value stored in this slot
+            T value{};
+        };
+
+        /// Storage for the slots
+        std::unique_ptr<Slot[]> slots;
+
+        /// Number of slots
+        std::size_t size = 0;
+
+        /// Mask used to wrap positions
+        std::size_t mask = 0;
+
+        /// Next position to claim, shared by all producers
+        alignas(64) std::atomic<std::size_t> whead{0};
+
+        /// Next position to read, only changed by the consumer
+        alignas(64) std::atomic<std::size_t> rhead{0};
+
+    public:
+
+        MPSCRing() =default;
+
+        /**
+         * @brief Construct a new MPSCRing object
+         *
+         * @param capacity Minimum number of values to hold
+         */
+        explicit MPSCRing(std::size_t capacity) { this->reserve(capacity); }
+
+        /**
+         * @brief Allocates room for the given number of values
+         *
+         * Any existing data is discarded.
+         * This is NOT thread safe, and should only be called
+         * when no thread is using the buffer.
+         *
+         * @param capacity Minimum number of values to hold
+         */
+        void reserve(std::size_t capacity) {
+
+            std::size_t nsize = 1;
+
+            while (nsize < capacity) {
+
+                nsize *= 2;
+            }
+
+            this->slots = std::make_unique<Slot[]>(nsize);
+            this->size = nsize;
+            this->mask = nsize - 1;
+
+            this->clear();
+        }
+
+        /**
+         * @brief Discards all data in the buffer
+         *
+         * This is NOT thread safe, and should only be called
+         * when no thread is using the buffer.
+         */
+        void clear() {
+
+            for (std::size_t i = 0; i < this->size; ++i) {
+
+                this->slots[i].seq.store(i, std::memory_order_relaxed);
+                this->slots[i].value = T{};
+            }
+
+            this->whead.store(0, std::memory_order_relaxed);
+            this->rhead.store(0, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Gets the capacity of this buffer
+         *
+         * @return std::size_t Number of values this buffer can hold
+         */
+        std::size_t capacity() const { return this->size; }
+
+        /**
+         * @brief Gets the number of values that can be read
+         *
+         * With many producers this is only an estimate,
+         * as values may be claimed but not yet published.
+         *
+         * @return std::size_t Number of values claimed by producers
+         */
+        std::size_t read_available() const {
+
+            return this->whead.load(std::memory_order_acquire) - this->rhead.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Moves a value into the buffer
+         *
+         * This may be called by any number of threads at once.
+         *
+         * @param val Value to move in
+         * @return true If the value was written
+         * @return false If the buffer is full, val is left untouched
+         */
+        bool push(T&& val) {
+
+            std::size_t pos = this->whead.load(std::memory_order_relaxed);
+
+            Slot* slot = nullptr;
+
+            while (true) {
+
+                slot = &(this->slots[pos & this->mask]);
+
+                const std::size_t seq = slot->seq.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+
+                if (diff == 0) {
+
+                    // Slot is free, try to claim it:
+
+                    if (this->whead.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+
+                        break;
+                    }
+                }
+
+                else if (diff < 0) {
+
+                    // Consumer has not freed this slot, we are full:
+
+                    return false;
+                }
+
+                else {
+
+                    // Another producer got here first:
+
+                    pos = this->whead.load(std::memory_order_relaxed);
+                }
+            }
+
+            // Fill and publish the slot:
+
+            slot->value = std::move(val);
+            slot->seq.store(pos + 1, std::memory_order_release);
+
+            return true;
+        }
+
+        /**
+         * @brief Copies a value into the buffer
+         *
+         * @param val Value to copy in
+         * @return true If the value was written
+         * @return false If the buffer is full
+         */
+        bool push(const T& val) {
+
+            T temp = val;
+
+            return this->push(std::move(temp));
+        }
+
+        /**
+         * @brief Moves a value out of the buffer
+         *
+         * This should only be called by the consumer.
+         * Values from a single producer are read in the order they were written.
+         *
+         * @param val Value to move out into
+         * @return true If a value was read
+         * @return false If no value is ready
+         */
+        bool pop(T& val) {
+
+            const std::size_t pos = this->rhead.load(std::memory_order_relaxed);
+
+            Slot& slot = this->slots[pos & this->mask];
+
+            if (slot.seq.load(std::memory_order_acquire) != pos + 1) {
+
+                return false;
+            }
+
+            val = std::move(slot.value);
+
+            // Hand the slot back for the next lap:
+
+            slot.seq.store(pos + this->size, std::memory_order_release);
+
+            this->rhead.store(pos + 1, std::memory_order_release);
+
+            return true;
+        }
+};
+
+/**
+ * @brief A lock-free triple buffer for publishing the latest value
+ *
+ * One thread writes values, and another picks up the most recent one.
+ * We hold three copies of the value:
+ * one the writer is filling, one the reader is looking at,
+ * and one in the middle holding the latest published value.
+ * Publishing and picking up a value each swap one index with the middle,
+ * with a single atomic exchange, so both sides are wait-free.
+ * The writer never waits for the reader,
+ * values the reader does not pick up in time are simply replaced.
+ *
+ * All copies are set up in reset(), after which no allocations happen
+ * as long as the writer only alters the values in place.
+ *
+ * This class is NOT safe for more than one reader or more than one writer!
+ *
+ * @tparam T Type of value to hold
+ */
+template <typename T>
+class TripleBuffer {
+
+    private:
+
+        /// Bit set in the middle index when it holds a value the reader has not seen
+        static constexpr unsigned fresh = 4;
+
+        /// Copies of the value
+        T values[3] = {};
+
+        /// Index of the copy being written, only used by the writer
+        unsigned back = 0;
+
+        /// Index of the copy being read, only used by the reader
+        unsigned front = 1;
+
+        /// Index of the middle copy, plus the fresh bit
+        alignas(64) std::atomic<unsigned> middle{2};
+
+    public:
+
+        TripleBuffer() =default;
+
+        /**
+         * @brief Construct a new TripleBuffer object
+         *
+         * @param value Value to copy into each slot
+         */
+        explicit TripleBuffer(const T& value) { this->reset(value); }
+
+        /**
+         * @brief Sets every copy to the given value
+         *
+         * Any published value is discarded.
+         * This is NOT thread safe, and should only be called
+         * when neither thread is using the buffer.
+         *
+         * @param value Value to copy into each slot
+         */
+        void reset(const T& value) {
+
+            for (auto& val : this->values) {
+
+                val = value;
+            }
+
+            this->back = 0;
+            this->front = 1;
+            this->middle.store(2, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Gets the copy the writer may alter
+         *
+         * This copy holds whatever value was last swapped in,
+         * which is not necessarily the last value written.
+         *
+         * @return T& Copy to write to
+         */
+        T& write_buffer() { return this->values[this->back]; }
+
+        /**
+         * @brief Publishes the write buffer
+         *
+         * The write buffer becomes the latest value,
+         * and we take over a new copy to write to.
+         */
+        void publish() {
+
+            this->back = this->middle.exchange(this->back | fresh, std::memory_order_acq_rel) & (fresh - 1);
+        }
+
+        /**
+         * @brief Picks up the latest value, if there is one
+         *
+         * @return true If a new value is now in the read buffer
+         * @return false If nothing was published since the last call
+         */
+        bool update() {
+
+            if ((this->middle.load(std::memory_order_relaxed) & fresh) == 0) {
+
+                return false;
+            }
+
+            this->front = this->middle.exchange(this->front, std::memory_order_acq_rel) & (fresh - 1);
+
+            return true;
+        }
+
+        /**
+         * @brief Gets the copy the reader may look at
+         *
+         * @return const T& Last value picked up by update()
+         */
+        const T& read_buffer() const { return this->values[this->front]; }
+};
@@ -0,0 +1,393 @@
+/**
+ * @file stft.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Streaming short-time Fourier transform
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This file contains components for working with signals in the frequency domain
+ * while they are streamed through a chain.
+ * The short-time Fourier transform (STFT) cuts a signal into overlapping frames,
+ * windows each frame, and transforms them into spectra.
+ * After the spectra are altered, they can be transformed back into frames,
+ * windowed again, and overlap-added to resynthesize the signal.
+ *
+ * Each frame is (size) samples long, and a new frame is started every (hop) samples.
+ * Output frames are normalized by the sum of the squared windows
+ * that overlap each sample (weighted overlap-add),
+ * so any window and hop that cover every sample reconstruct the input exactly
+ * when the spectra are left alone.
+ *
+ * https://en.wikipedia.org/wiki/Short-time_Fourier_transform
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <complex>
+#include <iterator>
+#include <span>
+#include <vector>
+
+#include "audio_buffer.hpp"
+#include "dsp/fft_backend.hpp"
+#include "dsp/window.hpp"
+
+/**
+ * @brief Transforms frames of a signal into spectra
+ *
+ * We window each frame using a cached window table
+ * and compute the real FFT of the result.
+ * All work memory is allocated in prepare(),
+ * so analyze() is real-time safe.
+ */
+class STFTAnalysis {
+
+    private:
+
+        /// Size of each frame
+        int fsize = 0;
+
+        /// Number of samples between frames
+        int hop_size = 0;
+
+        /// Window coefficients
+        std::span<const sample_t> window;
+
+        /// Windowed frame
+        std::vector<sample_t> frame;
+
+        /// Backend for the forward transform
+        RealFFTBackend<sample_t> plan;
+
+    public:
+
+        STFTAnalysis() =default;
+
+        /**
+         * @brief Prepares this analysis for the given size
+         *
+         * @param size Size of each frame, must be even
+         * @param hop Number of samples between frames
+         * @param type Type of window to apply
+         */
+        void prepare(int size, int hop, WindowType type = WindowType::Hann);
+
+        /**
+         * @brief Transforms a frame into a spectrum
+         *
+         * @param input Pointer to (size) samples
+         * @param spectrum Pointer to (size / 2 + 1) complex values
+         */
+        void analyze(const sample_t* input, std::complex<sample_t>* spectrum);
+
+        /**
+         * @brief Gets the size of each frame
+         *
+         * @return int Size of each frame
+         */
+        int size() const { return this->fsize; }
+
+        /**
+         * @brief Gets the number of samples between frames
+         *
+         * @return int Hop size
+         */
+        int hop() const { return this->hop_size; }
+
+        /**
+         * @brief Gets the number of bins in each spectrum
+         *
+         * @return int Number of bins
+         */
+        int bins() const { return this->fsize / 2 + 1; }
+
+        /**
+         * @brief Gets the window in use
+         *
+         * @return std::span<const sample_t> Window coefficients
+         */
+        std::span<const sample_t> get_window() const { return this->window; }
+
+        /**
+         * @brief Gets the number of bytes held by the transform
+         *
+         * @return std::size_t Number of bytes held
+         */
+        std::size_t plan_bytes() const { return this->plan.bytes(); }
+
+        /**
+         * @brief Gets the number of bytes held by the working buffers
+         *
+         * The window is shared with every other analysis, and is not counted.
+         *
+         * @return std::size_t Number of bytes held
+         */
+        std::size_t bytes() const { return heap_bytes(this->frame); }
+};
+
+/**
+ * @brief Transforms spectra back into a signal
+ *
+ * We inverse the spectrum of each frame, window it,
+ * and add it to an accumulator.
+ * Each call outputs the (hop) samples that no future frame will touch.
+ * All work memory is allocated in prepare(),
+ * so synthesize() is real-time safe.
+ */
+class STFTSynthesis {
+
+    private:
+
+        /// Size of each frame
+        int fsize = 0;
+
+        /// Number of samples between frames
+        int hop_size = 0;
+
+        /// Window coefficients
+        std::span<const sample_t> window;
+
+        /// Time domain frame
+        std::vector<sample_t> frame;
+
+        /// Overlap-add accumulator
+        std::vector<sample_t> accum;
+
+        /// Inverse of the window power overlapping each output position
+        std::vector<sample_t> norm;
+
+        /// Backend for the inverse transform
+        RealFFTBackend<sample_t> plan;
+
+    public:
+
+        STFTSynthesis() =default;
+
+        /**
+         * @brief Prepares this synthesis for the given size
+         *
+         * The synthesis must use the same size, hop and window
+         * as the analysis that produced the spectra.
+         *
+         * @param size Size of each frame, must be even
+         * @param hop Number of samples between frames
+         * @param type Type of window to apply
+         */
+        void prepare(int size, int hop, WindowType type = WindowType::Hann);
+
+        /**
+         * @brief Overlap-adds a spectrum and outputs finished samples
+         *
+         * @param spectrum Pointer to (size / 2 + 1) complex values
+         * @param output Pointer to (hop) samples
+         */
+        void synthesize(const std::complex<sample_t>* spectrum, sample_t* output);
+
+        /**
+         * @brief Clears the accumulator
+         *
+         */
+        void reset() { std::ranges::fill(this->accum, 0); }
+
+        /**
+         * @brief Gets the number of bytes held by the transform
+         *
+         * @return std::size_t Number of bytes held
+         */
+        std::size_t plan_bytes() const { return this->plan.bytes(); }
+
+        /**
+         * @brief Gets the number of bytes held by the working buffers
+         *
+         * @return std::size_t Number of bytes held
+         */
+        std::size_t bytes() const { return heap_bytes(this->frame) + heap_bytes(this->accum) + heap_bytes(this->norm); }
+};
+
+/**
+ * @brief Streams a signal through analysis and resynthesis
+ *
+ * Samples are buffered until a full hop has arrived,
+ * at which point the latest frame is analyzed,
+ * handed to a callback that may alter the spectrum in place,
+ * and resynthesized.
+ *
+ * Blocks of any size may be processed.
+ * The output is always delayed by (size) samples,
+ * regardless of the block size:
+ * a sample can not leave until the frame it ends has been analyzed,
+ * and the hop it belongs to has been resynthesized.
+ */
+class STFT {
+
+    private:
+
+        /// Number of samples buffered in the input frame
+        int fill = 0;
+
+        /// Analysis stage
+        STFTAnalysis analysis;
+
+        /// Synthesis stage
+        STFTSynthesis synthesis;
+
+        /// Last (size) input samples
+        std::vector<sample_t> input_frame;
+
+        /// Finished output samples
+        std::vector<sample_t> output_hop;
+
+        /// Spectrum of the current frame
+        std::vector<std::complex<sample_t>> spectrum;
+
+        /**
+         * @brief Processes the current frame
+         *
+         * @tparam F Callback type
+         * @param func Callback to alter the spectrum
+         */
+        template <typename F>
+        void run(F& func) {
+
+            this->analysis.analyze(this->input_frame.data(), this->spectrum.data());
+
+            func(std::span<std::complex<sample_t>>(this->spectrum));
+
+            this->synthesis.synthesize(this->spectrum.data(), this->output_hop.data());
+
+            // Shift the input frame:
+
+            std::copy(this->input_frame.begin() + this->hop(), this->input_frame.end(), this->input_frame.begin());
+        }
+
+    public:
+
+        STFT() =default;
+
+        /**
+         * @brief Construct a new STFT object
+         *
+         * @param size Size of each frame, must be even
+         * @param hop Number of samples between frames
+         * @param type Type of window to apply
+         */
+        STFT(int size, int hop, WindowType type = WindowType::Hann) { this->prepare(size, hop, type); }
+
+        /**
+         * @brief Prepares this STFT for the given size
+         *
+         * This allocates all work memory and clears any state.
+         *
+         * @param size Size of each frame, must be even
+         * @param hop Number of samples between frames, no larger than size
+         * @param type Type of window to apply
+         */
+        void prepare(int size, int hop, WindowType type = WindowType::Hann);
+
+        /**
+         * @brief Clears all buffered samples
+         *
+         */
+        void reset();
+
+        /**
+         * @brief Processes incoming samples
+         *
+         * The callback is invoked with a std::span of complex bins
+         * once for every hop, and may alter the bins in place.
+         * Input and output may be the same.
+         *
+         * @tparam I Input iterator type
+         * @tparam O Output iterator type
+         * @tparam F Callback type
+         * @param input Start iterator of input data
+         * @param num Number of samples to process
+         * @param output Start iterator of output data
+         * @param func Callback to alter each spectrum
+         */
+        template <typename I, typename O, typename F>
+        void process(I input, int num, O output, F&& func) {
+
+            typedef typename std::iterator_traits<O>::value_type out_type;
+
+            // Samples before this point in the input frame belong to earlier hops:
+
+            const int start = this->size() - this->hop();
+
+            int done = 0;
+
+            while (done < num) {
+
+                // Determine how many samples until the next frame:
+
+                const int count = std::min(num - done, this->size() - this->fill);
+
+                // Shift samples in, and finished samples out:
+
+                std::copy_n(input + done, count, this->input_frame.begin() + this->fill);
+
+                std::transform(this->output_hop.begin() + (this->fill - start), this->output_hop.begin() + (this->fill - start + count), output + done,
+                               [](sample_t val) { return static_cast<out_type>(val); });
+
+                this->fill += count;
+                done += count;
+
+                // Process the frame if it is full:
+
+                if (this->fill == this->size()) {
+
+                    this->run(func);
+
+                    this->fill = start;
+                }
+            }
+        }
+
+        /**
+         * @brief Gets the size of each frame
+         *
+         * @return int Size of each frame
+         */
+        int size() const { return this->analysis.size(); }
+
+        /**
+         * @brief Gets the number of samples between frames
+         *
+         * @return int Hop size
+         */
+        int hop() const { return this->analysis.hop(); }
+
+        /**
+         * @brief Gets the number of bins in each spectrum
+         *
+         * @return int Number of bins
+         */
+        int bins() const { return this->analysis.bins(); }
+
+        /**
+         * @brief Gets the delay between input and output
+         *
+         * @return int Latency in samples
+         */
+        int latency() const { return this->size(); }
+
+        /**
+         * @brief Gets the number of bytes held by the transforms
+         *
+         * @return std::size_t Number of bytes held
+         */
+        std::size_t plan_bytes() const { return this->analysis.plan_bytes() + this->synthesis.plan_bytes(); }
+
+        /**
+         * @brief Gets the number of bytes held by the working buffers
+         *
+         * @return std::size_t Number of bytes held
+         */
+        std::size_t bytes() const {
+
+            return this->analysis.bytes() + this->synthesis.bytes() + heap_bytes(this->input_frame) + heap_bytes(this->output_hop) + heap_bytes(this->spectrum);
+        }
+};
@@ -0,0 +1,153 @@
+/**
+ * @file tables.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Compile time tables for transforms and windows
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Preparing a transform or window of a common size
+ * normally computes thousands of sines and cosines,
+ * which adds up when many components are started at once.
+ * The tables here are computed by the compiler and live in read only memory,
+ * so using them costs nothing at startup:
+ *
+ * - A quarter wave sine table for TABLE_MAX_SIZE,
+ *   which provides the twiddle factors of any power of two size up to TABLE_MAX_SIZE
+ * - A bit reversal table for TABLE_MAX_SIZE,
+ *   which provides the bit reversal of any power of two size up to TABLE_MAX_SIZE
+ * - Half of the window cosine cos(2 * PI * n / (N - 1)) for power of two sizes
+ *   from TABLE_MIN_SIZE to TABLE_MAX_SIZE, which is all the Hann, Hamming and Blackman windows need
+ *
+ * Callers should check if a size is covered before using these,
+ * and fall back to computing values when it is not.
+ */
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <complex>
+#include <cstdint>
+
+/// Smallest window size that has a table
+constexpr int TABLE_MIN_SIZE = 256;
+
+/// Largest size that has a table
+constexpr int TABLE_MAX_SIZE = 8192;
+
+/// Number of bits in the indices of the largest size
+constexpr int TABLE_MAX_BITS = std::countr_zero(static_cast<unsigned>(TABLE_MAX_SIZE));
+
+/// Number of window cosines stored across all sizes
+constexpr int WINDOW_TABLE_SIZE = TABLE_MAX_SIZE - TABLE_MIN_SIZE / 2;
+
+/// sin(2 * PI * k / TABLE_MAX_SIZE) for the first quarter of a period
+extern const std::array<long double, TABLE_MAX_SIZE / 4 + 1> QUARTER_SINE;
+
+/// Bit reversal of each index of TABLE_MAX_SIZE
+extern const std::array<uint16_t, TABLE_MAX_SIZE> BIT_REVERSE;
+
+/// First half of the window cosines of each size, smallest size first
+extern const std::array<long double, WINDOW_TABLE_SIZE> WINDOW_COSINE;
+
+/**
+ * @brief Determines if twiddle factors and bit reversals of a size are in the tables
+ *
+ * @param size Size of the transform
+ * @return true If the size is a power of two no larger than TABLE_MAX_SIZE
+ * @return false If values must be computed
+ */
+constexpr bool table_covers(int size) { return size > 0 && size <= TABLE_MAX_SIZE && std::has_single_bit(static_cast<unsigned>(size)); }
+
+/**
+ * @brief Determines if the window cosines of a size are in the tables
+ *
+ * @param size Size of the window
+ * @return true If the size is a power of two from TABLE_MIN_SIZE to TABLE_MAX_SIZE
+ * @return false If values must be computed
+ */
+constexpr bool window_table_covers(int size) { return size >= TABLE_MIN_SIZE && table_covers(size); }
+
+/**
+ * @brief Gets sin(2 * PI * k / TABLE_MAX_SIZE)
+ *
+ * Any k may be given, the quarter wave is mirrored as needed.
+ *
+ * @param k Step around the period
+ * @return long double Sine of the step
+ */
+inline long double table_sine(int k) {
+
+    constexpr int quarter = TABLE_MAX_SIZE / 4;
+
+    k &= TABLE_MAX_SIZE - 1;
+
+    if (k <= quarter) {
+
+        return QUARTER_SINE[k];
+    }
+
+    if (k <= 2 * quarter) {
+
+        return QUARTER_SINE[2 * quarter - k];
+    }
+
+    if (k <= 3 * quarter) {
+
+        return -QUARTER_SINE[k - 2 * quarter];
+    }
+
+    return -QUARTER_SINE[4 * quarter - k];
+}
+
+/**
+ * @brief Gets a twiddle factor from the tables
+ *
+ * This is identical to twiddle() in ft.hpp,
+ * but the size MUST be covered by the tables, see table_covers().
+ *
+ * @tparam T Type of output complex value
+ * @param k Frequency component to get
+ * @param size Size of the transform
+ * @param sign Sign to use, (-1) forward, (1) backward
+ * @return std::complex<T> Twiddle factor
+ */
+template <typename T>
+std::complex<T> table_twiddle(int k, int size, int sign = -1) {
+
+    const int step = (k % size) * (TABLE_MAX_SIZE / size);
+
+    return {static_cast<T>(table_sine(step + TABLE_MAX_SIZE / 4)), static_cast<T>(sign * table_sine(step))};
+}
+
+/**
+ * @brief Gets the bit reversal of an index
+ *
+ * The size MUST be covered by the tables, see table_covers().
+ *
+ * @param index Index to reverse
+ * @param size Size of the transform
+ * @return int Reversed index
+ */
+inline int table_bit_reverse(int index, int size) { return BIT_REVERSE[index] >> (TABLE_MAX_BITS - std::countr_zero(static_cast<unsigned>(size))); }
+
+/**
+ * @brief Gets cos(2 * PI * num / (size - 1)) from the tables
+ *
+ * The size MUST be covered by the tables, see window_table_covers(),
+ * and num must be in [0, size).
+ *
+ * @param num Index in the window
+ * @param size Size of the window
+ * @return long double Window cosine
+ */
+inline long double table_window_cosine(int num, int size) {
+
+    // The cosine is symmetric about the center of the window:
+
+    const int half = size / 2;
+
+    return WINDOW_COSINE[half - TABLE_MIN_SIZE / 2 + (num < half ? num : size - 1 - num)];
+}
@@ -16,6 +16,8 @@
 #include <iterator>
 #include <complex>
 
+#include "tables.hpp"
+
 /**
  * @brief A component that chooses between types based upon a flag
  * 
@@ -45,9 +47,35 @@ struct ChooseType<false, True, False> {
     using type = False;
 };
 
+/**
+ * @brief Places values in bit reversed order
+ *
+ * The size MUST be a power of two.
+ * Sizes covered by the compile time tables (see tables.hpp)
+ * look up each reversal rather than computing it.
+ *
+ * @tparam I Iterator type
+ * @param size Number of values
+ * @param iter Iterator to the values
+ */
 template <typename I>
 void bit_reverse(int size, I iter) {
 
+    if (table_covers(size)) {
+
+        for (int i = 0; i < size; ++i) {
+
+            const int j = table_bit_reverse(i, size);
+
+            if (i < j) {
+
+                std::swap(iter[i], iter[j]);
+            }
+        }
+
+        return;
+    }
+
     // Iterate over all components:
 
     for (int i = 0, j = 1; j < size-1; j++) {
@@ -78,8 +106,8 @@ void bit_reverse(int size, I iter) {
  */
 long double sinc(long double x);
 
-template<typename I1, typename O>
-void multiply_signals(int size, I1 input1, I1 input2, O output) {
+template<typename I1, typename I2, typename O>
+void multiply_signals(int size, I1 input1, I2 input2, O output) {
 
     // Determine the type:
 
@@ -0,0 +1,183 @@
+/**
+ * @file wavetable.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Band-limited wavetables
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Naive waveforms (see dsp/osc.hpp) contain harmonics all the way up,
+ * so anything past the Nyquist frequency folds back down as aliasing.
+ * Computing a band-limited waveform for every sample is expensive,
+ * so instead we compute it once, ahead of time, and store it in a table.
+ *
+ * A single table can only be band-limited for one frequency,
+ * so we keep a set of tables, one per octave (a mip-map).
+ * Each level holds half as many harmonics as the one before it,
+ * and oscillators pick the level with the most harmonics
+ * that stay below the Nyquist frequency at the current pitch.
+ *
+ * Tables are built via additive synthesis from the Fourier series of each waveform,
+ * and are shared process-wide, see wavetable().
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "dsp/alloc.hpp"
+
+/**
+ * @brief Waveforms that can be stored in wavetables
+ *
+ * These match the phase and polarity of the naive kernels in dsp/osc.hpp.
+ */
+enum class Waveform { Sine, Square, Sawtooth, Triangle };
+
+/// Number of samples in one cycle of a wavetable
+constexpr int WAVETABLE_SIZE = 4096;
+
+/// Number of levels in a wavetable, one per octave
+constexpr int WAVETABLE_LEVELS = 10;
+
+/// Number of harmonics kept in the first level
+constexpr int WAVETABLE_HARMONICS = 512;
+
+/**
+ * @brief A set of band-limited tables for a waveform
+ *
+ * Level (k) keeps the first (WAVETABLE_HARMONICS >> k) harmonics,
+ * and the last level is a pure sine.
+ * The first level keeps a table size of eight samples per cycle
+ * for its highest harmonic, so linear interpolation stays accurate.
+ *
+ * Each level stores WAVETABLE_SIZE + 1 samples,
+ * the last one repeating the first so lookups never wrap.
+ *
+ * @tparam T Type of the samples
+ */
+template <typename T>
+struct Wavetable {
+
+    /// Samples of every level, one after another
+    std::vector<T, AlignedAllocator<T>> data;
+
+    /**
+     * @brief Determines the level to use for a phase increment
+     *
+     * We pick the level with the most harmonics,
+     * whose highest harmonic stays below the Nyquist frequency.
+     *
+     * @param inc Phase increment per sample in turns
+     * @return int Level to use
+     */
+    static int pick(double inc) {
+
+        // Highest harmonic of the first level in turns per sample:
+
+        const double top = std::fabs(inc) * WAVETABLE_HARMONICS * 2;
+
+        if (top <= 1) {
+
+            return 0;
+        }
+
+        // Round log2 up, each level covers one octave:
+
+        int exp = 0;
+        const double mant = std::frexp(top, &exp);
+
+        const int level = mant > 0.5 ? exp : exp - 1;
+
+        return level < WAVETABLE_LEVELS ? level : WAVETABLE_LEVELS - 1;
+    }
+
+    /**
+     * @brief Gets the samples of a level
+     *
+     * @param num Level to get
+     * @return std::span<const T> WAVETABLE_SIZE + 1 samples
+     */
+    std::span<const T> level(int num) const { return std::span<const T>(this->data).subspan(static_cast<std::size_t>(num) * (WAVETABLE_SIZE + 1), WAVETABLE_SIZE + 1); }
+
+    /**
+     * @brief Computes a single sample
+     *
+     * This is used when the frequency changes every sample,
+     * see wavetable_render() for constant frequencies.
+     *
+     * @param turn Phase in turns, wrapped into [0, 1)
+     * @param inc Phase increment per sample in turns
+     * @return T Interpolated sample
+     */
+    T sample(double turn, double inc) const {
+
+        const T* table = this->data.data() + static_cast<std::ptrdiff_t>(pick(inc)) * (WAVETABLE_SIZE + 1);
+
+        const double pos = turn * WAVETABLE_SIZE;
+        const auto index = static_cast<int>(pos);
+        const auto frac = static_cast<T>(pos - index);
+
+        return table[index] + frac * (table[index + 1] - table[index]);
+    }
+};
+
+/**
+ * @brief Gets the shared wavetable for a waveform
+ *
+ * The first call for a waveform builds the table,
+ * later calls return the same one.
+ *
+ * This function is thread safe.
+ * The returned table stays valid until wavetable_cache_clear() is called.
+ * Building a table allocates and takes some time,
+ * so fetch tables before entering a real-time context.
+ *
+ * Tables are provided for float, double and long double.
+ *
+ * @tparam T Type of the samples
+ * @param type Waveform to get
+ * @return const Wavetable<T>& Shared wavetable
+ */
+template <typename T>
+const Wavetable<T>& wavetable(Waveform type);
+
+/**
+ * @brief Determines the number of cached wavetables
+ *
+ * @return std::size_t Number of tables across all types
+ */
+std::size_t wavetable_cache_size();
+
+/**
+ * @brief Frees all cached wavetables
+ *
+ * This invalidates every table previously returned by wavetable(),
+ * so only call this when no one is using them.
+ */
+void wavetable_cache_clear();
+
+/**
+ * @brief Fills a block from a wavetable
+ *
+ * We linearly interpolate between the samples of the table.
+ * Like the kernels in dsp/osc.hpp, the phase of each sample
+ * is computed from the start phase rather than accumulated.
+ *
+ * @param out Pointer to output data
+ * @param size Number of samples to generate
+ * @param table Level of a wavetable, WAVETABLE_SIZE + 1 samples
+ * @param start Starting phase in turns
+ * @param inc Phase increment per sample in turns
+ */
+void wavetable_render(float* out, int size, const float* table, double start, double inc);
+
+/// @copydoc wavetable_render(float*, int, const float*, double, double)
+void wavetable_render(double* out, int size, const double* table, double start, double inc);
+
+/// @copydoc wavetable_render(float*, int, const float*, double, double)
+void wavetable_render(long double* out, int size, const long double* table, double start, double inc);
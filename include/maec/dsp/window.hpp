@@ -30,10 +30,20 @@
  * allowing you to use the defaults easily with maec kernels,
  * and configure the windows to your needs.
  * 
+ * Computing a window value calls cos() at least once,
+ * which adds up when a window is applied to every frame of a signal.
+ * For these cases we offer window tables,
+ * which are computed once for each (type, size, parameter)
+ * and shared across the process.
+ * Tables live in aligned memory, and can be applied to a frame
+ * using the apply_window() kernel.
  */
 
 #pragma once
 
+#include <cstddef>
+#include <span>
+
 /**
  * @brief Generates a rectangular window
  * 
@@ -129,3 +139,104 @@ long double window_blackmanc(int num, int size, double alpha = 0.16);
  * @return long double Computed value
  */
 long double window_blackman(int num, int size);
+
+/**
+ * @brief Types of windows that can be stored in tables
+ *
+ */
+enum class WindowType { Rectangle, Hann, Hamming, Blackman };
+
+/**
+ * @brief Gets the default parameter of a window type
+ *
+ * This is the a0 value for Hann and Hamming windows,
+ * and the alpha value for Blackman windows.
+ * Rectangle windows have no parameter, so we return 0.
+ *
+ * @param type Type of window
+ * @return double Default parameter
+ */
+double window_default(WindowType type);
+
+/**
+ * @brief Computes a single value of a window of a given type
+ *
+ * This dispatches to the window function for the type.
+ * Windows with a size of one are always 1.
+ *
+ * @param type Type of window
+ * @param num Current value to compute
+ * @param size Size of the window
+ * @param param Parameter of the window, see window_default()
+ * @return long double Computed value
+ */
+long double window_value(WindowType type, int num, int size, double param);
+
+/**
+ * @brief Gets a cached window table
+ *
+ * The first call for a given (type, size, parameter) computes the table,
+ * later calls return the same memory.
+ * The table starts on a BUFFER_ALIGN boundary and is padded,
+ * so it may be used directly by SIMD kernels.
+ *
+ * This function is thread safe.
+ * The returned span stays valid until window_cache_clear() is called.
+ * Building a table allocates, so fetch tables before entering
+ * a real-time context.
+ *
+ * Tables are provided for float, double and long double.
+ *
+ * @tparam T Type of the coefficients
+ * @param type Type of window
+ * @param size Size of the window
+ * @param param Parameter of the window, see window_default()
+ * @return std::span<const T> Window coefficients
+ */
+template <typename T>
+std::span<const T> window_table(WindowType type, int size, double param);
+
+/**
+ * @brief Gets a cached window table with the default parameter
+ *
+ * @tparam T Type of the coefficients
+ * @param type Type of window
+ * @param size Size of the window
+ * @return std::span<const T> Window coefficients
+ */
+template <typename T>
+std::span<const T> window_table(WindowType type, int size) { return window_table<T>(type, size, window_default(type)); }
+
+/**
+ * @brief Determines the number of cached window tables
+ *
+ * @return std::size_t Number of tables across all types
+ */
+std::size_t window_cache_size();
+
+/**
+ * @brief Frees all cached window tables
+ *
+ * This invalidates every span previously returned by window_table(),
+ * so only call this when no one is using them.
+ */
+void window_cache_clear();
+
+/**
+ * @brief Applies a window to a block of data
+ *
+ * We multiply each value by the matching window coefficient.
+ * The input and output may be the same.
+ *
+ * @param input Pointer to input data
+ * @param window Pointer to window coefficients
+ * @param output Pointer to output data
+ * @param size Number of values to process
+ */
+void apply_window(const float* input, const float* window, float* output, int size);
+
+/// @copydoc apply_window(const float*, const float*, float*, int)
+void apply_window(const double* input, const double* window, double* output, int size);
+
+/// @copydoc apply_window(const float*, const float*, float*, int)
+void apply_window(const long double* input, const long double* window, long double* output, int size);
@@ -0,0 +1,404 @@
+/**
+ * @file dynamics_module.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Compressors and limiters
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This file contains modules that control the dynamics of audio data,
+ * turning loud passages down so the level stays within bounds.
+ * A limiter at the end of a chain keeps the output from clipping.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "audio_module.hpp"
+#include "module_param.hpp"
+
+#include "dsp/delay.hpp"
+#include "dsp/dynamics.hpp"
+
+/**
+ * @brief Methods of following the level of a signal
+ *
+ * - Peak - Follows the magnitude of each sample, which catches every peak
+ * - RMS - Follows the mean power over a short window, which is closer to perceived loudness
+ */
+enum class DynDetector { Peak, RMS };
+
+/**
+ * @brief Reduces the gain of audio that is louder than a threshold
+ *
+ * The level of every channel is followed together (see DynDetector),
+ * and every channel is reduced by the same amount, so the stereo image does not move.
+ * The reduction is determined by a gain curve (see DynCurve),
+ * and is smoothed by the attack and release times.
+ *
+ * The detector can follow another signal through the sidechain parameter.
+ * When the sidechain is constant (the default) we follow our own input.
+ * When the sidechain is attached to a module at audio rate,
+ * we follow every channel of its output, which allows ducking one signal under another.
+ * At control rate, the sidechain value is used as the level directly.
+ *
+ * With a lookahead, the audio is delayed while the detector is not,
+ * and the detector holds each peak for the length of the lookahead,
+ * so the reduction is in place before the peak is output.
+ * An attack a fraction of the lookahead (such as a fifth) lets the reduction
+ * settle to within 1% before the peak arrives.
+ * The lookahead is reported as our latency.
+ *
+ * We process our buffer in place.
+ */
+class CompressorModule : public AudioModule, public BaseParamModule<1> {
+
+    public:
+
+        CompressorModule() : BaseParamModule<1>(&sidechain), sidechain(0.0) {}
+
+        /**
+         * @brief Construct a new CompressorModule object
+         *
+         * @param threshold Level where reduction starts in dB
+         * @param ratio Amount levels above the threshold are divided by
+         * @param atk Attack time in seconds
+         * @param rel Release time in seconds
+         */
+        CompressorModule(double threshold, double ratio, double atk = 0.005, double rel = 0.1)
+            : BaseParamModule<1>(&sidechain), sidechain(0.0), attack(atk), release(rel) {
+
+            this->curve.threshold = threshold;
+            this->curve.ratio = ratio;
+        }
+
+        /**
+         * @brief Starts this module and the sidechain parameter
+         *
+         */
+        void meta_start() override {
+
+            AudioModule::meta_start();
+
+            this->param_start();
+        }
+
+        /**
+         * @brief Stops this module and the sidechain parameter
+         *
+         */
+        void meta_stop() override {
+
+            AudioModule::meta_stop();
+
+            this->param_stop();
+        }
+
+        /**
+         * @brief Preforms a meta info sync operation
+         *
+         * We sync ourselves, and then the sidechain parameter.
+         */
+        void meta_info_sync() override {
+
+            AudioModule::meta_info_sync();
+
+            this->param_info(this);
+        }
+
+        /**
+         * @brief Determines the modules we pull buffers from
+         *
+         * @param inputs Vector to add modules to
+         * @return true If we can be stepped
+         */
+        bool plan_inputs(std::vector<AudioModule*>& inputs) override {
+
+            this->param_inputs(inputs);
+
+            return AudioModule::plan_inputs(inputs);
+        }
+
+        /**
+         * @brief Syncs our info, and reports our latency
+         *
+         */
+        void info_sync() override;
+
+        /**
+         * @brief Starts this module
+         *
+         * We reset the detector, and create the lookahead delay for each channel.
+         */
+        void start() override;
+
+        /**
+         * @brief Adds the memory held by this compressor
+         *
+         * We count the lookahead line and working memory of each channel.
+         *
+         * @param usage Footprint to add to
+         */
+        void footprint(MemoryFootprint& usage) const override;
+
+        /**
+         * @brief Reduces the gain of the current buffer
+         *
+         */
+        void process() override;
+
+        /// We alter the buffer we are given
+        bool in_place() const override { return true; }
+
+        /**
+         * @brief Gets the sidechain parameter
+         *
+         * @return ModuleParam* Sidechain parameter
+         */
+        ModuleParam* get_sidechain() { return &(this->sidechain); }
+
+        /**
+         * @brief Sets the level where reduction starts
+         *
+         * @param db Threshold in dB
+         */
+        void set_threshold(double db) { this->curve.threshold = db; }
+
+        /**
+         * @brief Gets the level where reduction starts
+         *
+         * @return double Threshold in dB
+         */
+        double get_threshold() const { return this->curve.threshold; }
+
+        /**
+         * @brief Sets the amount levels above the threshold are divided by
+         *
+         * Use infinity to limit.
+         *
+         * @param val Ratio, at least 1
+         */
+        void set_ratio(double val) { this->curve.ratio = std::max(val, 1.0); }
+
+        /**
+         * @brief Gets the amount levels above the threshold are divided by
+         *
+         * @return double Ratio
+         */
+        double get_ratio() const { return this->curve.ratio; }
+
+        /**
+         * @brief Sets the width of the soft knee
+         *
+         * @param db Width of the knee in dB, 0 for a hard knee
+         */
+        void set_knee(double db) { this->curve.knee = std::max(db, 0.0); }
+
+        /**
+         * @brief Gets the width of the soft knee
+         *
+         * @return double Width of the knee in dB
+         */
+        double get_knee() const { return this->curve.knee; }
+
+        /**
+         * @brief Sets the gain added after reduction
+         *
+         * @param db Makeup gain in dB
+         */
+        void set_makeup(double db) { this->curve.makeup = db; }
+
+        /**
+         * @brief Gets the gain added after reduction
+         *
+         * @return double Makeup gain in dB
+         */
+        double get_makeup() const { return this->curve.makeup; }
+
+        /**
+         * @brief Sets the time taken to reduce the gain
+         *
+         * @param sec Attack time in seconds, 0 to react instantly
+         */
+        void set_attack(double sec) { this->attack = std::max(sec, 0.0); }
+
+        /**
+         * @brief Gets the time taken to reduce the gain
+         *
+         * @return double Attack time in seconds
+         */
+        double get_attack() const { return this->attack; }
+
+        /**
+         * @brief Sets the time taken to restore the gain
+         *
+         * @param sec Release time in seconds, 0 to react instantly
+         */
+        void set_release(double sec) { this->release = std::max(sec, 0.0); }
+
+        /**
+         * @brief Gets the time taken to restore the gain
+         *
+         * @return double Release time in seconds
+         */
+        double get_release() const { return this->release; }
+
+        /**
+         * @brief Sets how far ahead the detector looks
+         *
+         * This should be set before we are started,
+         * as changing it while running discards the delayed audio.
+         *
+         * @param sec Lookahead in seconds
+         */
+        void set_lookahead(double sec) { this->lookahead = std::max(sec, 0.0); }
+
+        /**
+         * @brief Gets how far ahead the detector looks
+         *
+         * @return double Lookahead in seconds
+         */
+        double get_lookahead() const { return this->lookahead; }
+
+        /**
+         * @brief Sets the method of following the level
+         *
+         * @param det New detector
+         */
+        void set_detector(DynDetector det) { this->detector = det; }
+
+        /**
+         * @brief Gets the method of following the level
+         *
+         * @return DynDetector Current detector
+         */
+        DynDetector get_detector() const { return this->detector; }
+
+        /**
+         * @brief Sets the window of the RMS detector
+         *
+         * @param sec Window in seconds
+         */
+        void set_rms_window(double sec) { this->rms_window = std::max(sec, 0.0); }
+
+        /**
+         * @brief Gets the window of the RMS detector
+         *
+         * @return double Window in seconds
+         */
+        double get_rms_window() const { return this->rms_window; }
+
+        /**
+         * @brief Gets the largest reduction applied in the last block
+         *
+         * This is useful for metering.
+         *
+         * @return double Reduction in dB, never positive
+         */
+        double get_reduction() const { return this->reduction; }
+
+        /**
+         * @brief Gets the latency we add
+         *
+         * @return int Lookahead in samples
+         */
+        int latency();
+
+    private:
+
+        /**
+         * @brief Creates the lookahead delays and scratch space
+         *
+         * @param channels Number of channels
+         * @param block Largest number of samples in a block
+         */
+        void prepare(int channels, int block);
+
+        /**
+         * @brief Adds a buffer to the level of each sample
+         *
+         * @param data Buffer to follow
+         * @param num Number of samples to follow
+         */
+        void detect(const AudioBuffer& data, int num);
+
+        /// Sidechain parameter
+        ModuleParam sidechain;
+
+        /// Shape of the gain curve
+        DynCurve curve;
+
+        /// Attack time in seconds
+        double attack = 0.005;
+
+        /// Release time in seconds
+        double release = 0.1;
+
+        /// Lookahead in seconds
+        double lookahead = 0;
+
+        /// Method of following the level
+        DynDetector detector = DynDetector::Peak;
+
+        /// Window of the RMS detector in seconds
+        double rms_window = 0.01;
+
+        /// Largest reduction in the last block, in dB
+        double reduction = 0;
+
+        /// Smoothed reduction in dB
+        sample_t envelope = 0;
+
+        /// Running mean power of the RMS detector
+        sample_t power = 0;
+
+        /// Holds each peak for the length of the lookahead
+        PeakHold<sample_t> hold;
+
+        /// Lookahead delay for each channel
+        std::vector<DelayLine<sample_t>> lines;
+
+        /// Lookahead in samples the delays were created with
+        int delay = 0;
+
+        /// Number of samples since we last took in anything audible
+        std::size_t quiet = 0;
+
+        /// Level of each sample, then the reduction of each sample
+        std::vector<sample_t> level;
+
+        /// Gain of each sample
+        std::vector<sample_t> gain;
+
+        /// Samples of a single channel
+        std::vector<sample_t> chan_data;
+
+        /// Delayed samples of a single channel
+        std::vector<sample_t> delayed;
+};
+
+/**
+ * @brief A compressor configured to stop audio from passing a ceiling
+ *
+ * We use an infinite ratio, a short lookahead,
+ * and an attack a fifth of the lookahead,
+ * so peaks are turned down before they arrive.
+ */
+class LimiterModule : public CompressorModule {
+
+    public:
+
+        /**
+         * @brief Construct a new LimiterModule object
+         *
+         * @param ceiling Level audio may not pass in dB
+         * @param rel Release time in seconds
+         * @param ahead Lookahead in seconds
+         */
+        explicit LimiterModule(double ceiling = -0.3, double rel = 0.05, double ahead = 0.005)
+            : CompressorModule(ceiling, std::numeric_limits<double>::infinity(), ahead / 5, rel) { this->set_lookahead(ahead); }
+};
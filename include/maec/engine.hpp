@@ -0,0 +1,360 @@
+/**
+ * @file engine.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Components for running chains on real-time threads
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This file contains components for running a chain.
+ * Normally, a chain is run by calling meta_process() on the sink
+ * in a loop on whatever thread the user likes.
+ * Under load, the kernel will happily preempt this thread,
+ * which causes the device to underrun.
+ *
+ * The components here configure the thread that runs the chain
+ * for real-time operation:
+ *
+ * - The thread can be scheduled with SCHED_FIFO at a given priority
+ * - The thread can be pinned to a single CPU
+ * - All process memory can be locked, so we never page fault
+ * - The chain buffer pool can be filled before we start,
+ *   so no allocations occur while running
+ * - The chain can be warmed up with blocks that are rendered and thrown away,
+ *   so lazy storage is grown and caches are hot before the first real block
+ *
+ * Most of these operations require privileges
+ * (CAP_SYS_NICE for scheduling, CAP_IPC_LOCK or a suitable rlimit for locking).
+ * If an operation fails, then we continue without it,
+ * and report what was applied in an RTStatus struct.
+ *
+ * These operations are only supported on Linux,
+ * on other platforms every operation reports failure.
+ *
+ * Setup that should not happen on the audio deadline is done in a prepare phase
+ * (see Engine::prepare()), which syncs and starts the chain,
+ * prepares each module (see AudioModule::prepare()),
+ * fills the pool and runs the warm-up blocks.
+ * This can be done well before processing starts,
+ * and the engine reports when the chain is ready.
+ *
+ * The thread also flushes denormals to zero if the chain asks for it
+ * (see ChainInfo::flush_denormals), so decaying tails do not spike the CPU.
+ *
+ * To get timing and jitter statistics,
+ * place a LatencyModule before the sink.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "audio_module.hpp"
+
+/**
+ * @brief Real-time options for the thread running a chain
+ *
+ * The default values do not change anything.
+ */
+struct RTConfig {
+
+    /// SCHED_FIFO priority to request, 0 keeps the default scheduler
+    int priority = 0;
+
+    /// CPU to pin the thread to, -1 to not pin
+    int cpu = -1;
+
+    /// Value determining if we lock all current and future memory
+    bool lock_memory = false;
+
+    /// Number of buffers to place in the chain pool before starting
+    int prefault = 0;
+
+    /// Number of blocks to render and throw away before starting
+    int warmup = 0;
+};
+
+/**
+ * @brief Real-time options that were applied
+ */
+struct RTStatus {
+
+    /// Value determining if SCHED_FIFO was applied
+    bool scheduled = false;
+
+    /// Value determining if the thread was pinned
+    bool pinned = false;
+
+    /// Value determining if memory was locked
+    bool locked = false;
+
+    /// Number of buffers placed in the chain pool
+    int prefaulted = 0;
+
+    /// Value determining if denormals are flushed to zero
+    bool flushed = false;
+
+    /// Number of modules that were prepared
+    int prepared = 0;
+
+    /// Number of warm-up blocks that were rendered
+    int warmed = 0;
+
+    /// Time spent preparing the chain in nanoseconds
+    int64_t prepare_time = 0;
+};
+
+/**
+ * @brief Applies real-time options to the calling thread
+ *
+ * We apply the scheduling, pinning and memory options in the given config.
+ * If memory is locked, then we also touch a chunk of the stack,
+ * so it is faulted in and locked before we begin.
+ *
+ * The prefault option is NOT handled here,
+ * as it requires a chain (see Engine).
+ *
+ * @param config Options to apply
+ * @return RTStatus Options that were applied
+ */
+RTStatus apply_rt(const RTConfig& config);
+
+/**
+ * @brief Prepares every module in a chain
+ *
+ * We walk the chain behind the sink (see AudioModule::plan_inputs())
+ * and call AudioModule::prepare() once on each module, including the sink.
+ * Modules that hide their inputs are followed through their backward module.
+ * The chain should already be started.
+ *
+ * @param sink Sink of the chain
+ * @return int Number of modules prepared
+ */
+int prepare_chain(AudioModule* sink);
+
+/**
+ * @brief Renders blocks of a chain and throws them away
+ *
+ * We process the module behind the sink, and hand its output back to the chain pool,
+ * so the sink never sees these blocks and nothing reaches a device.
+ * This grows any storage the modules allocate lazily,
+ * and warms the caches and branch predictors of the thread.
+ *
+ * The chain time is not advanced, and events are not delivered while warming,
+ * so events are still delivered on time.
+ * Sources are not processed while warming (see ChainInfo::warming),
+ * they output zeros instead and keep their state.
+ * The zeros are not marked as silent, so the modules after the sources do their full work,
+ * and modules at rest stay at rest,
+ * so the first real block is identical to that of a cold chain.
+ * Sub-chains, such as those of mixers and voices, follow the warm-up state of the chain.
+ * Only the modules after the sources are warmed.
+ * The chain should already be started.
+ *
+ * @param sink Sink of the chain
+ * @param blocks Number of blocks to render
+ * @return int Number of blocks rendered
+ */
+int warm_chain(AudioModule* sink, int blocks);
+
+/**
+ * @brief Runs a chain with real-time options
+ *
+ * We take a sink module, and run the chain it is attached to.
+ * The chain can be run on the calling thread using run(),
+ * or on a dedicated thread using start() and stop().
+ * In both cases, the real-time options are applied to the thread
+ * that processes the chain before processing starts.
+ *
+ * The chain is synced and started by us,
+ * so do not call meta_info_sync() or meta_start() yourself.
+ * We stop processing when asked, or when all modules in the chain are done.
+ */
+class Engine {
+
+   private:
+
+    /// Sink of the chain we are running
+    AudioModule* sink = nullptr;
+
+    /// Real-time options to apply
+    RTConfig config;
+
+    /// Real-time options that were applied
+    RTStatus status;
+
+    /// Thread processing the chain
+    std::thread thread;
+
+    /// Value determining if we should keep processing
+    std::atomic<bool> running{false};
+
+    /// Value determining if the chain is prepared
+    std::atomic<bool> ready{false};
+
+    /**
+     * @brief Applies the real-time options to the calling thread
+     *
+     * The results of the prepare phase are kept in our status.
+     */
+    void apply();
+
+    /**
+     * @brief Processes the chain the given number of times
+     *
+     * @param num Number of times to process, negative to process until stopped
+     */
+    void loop(long num);
+
+    /**
+     * @brief Determines if all modules in the chain are done
+     *
+     * @return true If the chain is done
+     * @return false If the chain should continue
+     */
+    bool chain_done() const;
+
+    /**
+     * @brief Flushes denormals on the calling thread if the chain asks for it
+     *
+     * @return true If denormals are flushed on this thread
+     * @return false If they are kept
+     */
+    bool flush() const;
+
+   public:
+
+    Engine() = default;
+
+    /**
+     * @brief Construct a new Engine object
+     *
+     * @param sink Sink of the chain to run
+     */
+    Engine(AudioModule* sink) : sink(sink) {}
+
+    /**
+     * @brief Destroy the Engine object
+     *
+     * We stop the processing thread if it is running.
+     */
+    ~Engine() { this->stop(); }
+
+    Engine(const Engine&) = delete;
+    Engine& operator=(const Engine&) = delete;
+
+    /**
+     * @brief Prepares the chain for real-time use
+     *
+     * This does all the work that should not happen on the audio deadline:
+     *
+     * - The chain is synced and started
+     * - Every module is prepared (see prepare_chain())
+     * - The buffer pool is filled (see RTConfig::prefault)
+     * - The warm-up blocks are rendered (see RTConfig::warmup and warm_chain())
+     *
+     * Afterwards, the chain is ready (see is_ready()).
+     * If the chain is over its memory budget (see ChainInfo::memory_budget),
+     * then the sink stops it once started, and it never becomes ready,
+     * in which case run() and start() do nothing.
+     * run() and start() prepare the chain if it is not ready,
+     * so calling this first simply moves the work to a time of your choosing.
+     * If the chain is already ready, we do nothing.
+     */
+    void prepare();
+
+    /**
+     * @brief Determines if the chain is ready for real-time use
+     *
+     * The chain is ready once prepared,
+     * and is no longer ready once it is stopped.
+     *
+     * @return true If the chain is prepared
+     * @return false If the chain must be prepared
+     */
+    bool is_ready() const { return this->ready.load(); }
+
+    /**
+     * @brief Runs the chain on the calling thread
+     *
+     * We apply the real-time options to the calling thread,
+     * start the chain and process it the given number of times.
+     * The chain is stopped when we are done.
+     * Be aware, the real-time options remain applied to the calling thread!
+     *
+     * @param num Number of times to process, negative to process until the chain is done
+     * @return RTStatus Options that were applied
+     */
+    RTStatus run(long num);
+
+    /**
+     * @brief Runs the chain on a dedicated thread
+     *
+     * We start a thread, apply the real-time options to it,
+     * and process the chain until stop() is called.
+     * The chain is synced and started on the calling thread,
+     * so any start time work is done before we return.
+     */
+    void start();
+
+    /**
+     * @brief Stops the dedicated thread and the chain
+     *
+     * If the chain was prepared but never run, then it is simply stopped.
+     * Otherwise, if the thread is not running, then we do nothing.
+     */
+    void stop();
+
+    /**
+     * @brief Determines if the dedicated thread is running
+     *
+     * @return true If the thread is running
+     * @return false If the thread is not running
+     */
+    bool is_running() const { return this->running.load(); }
+
+    /**
+     * @brief Gets the sink of the chain
+     *
+     * @return AudioModule* Sink of the chain
+     */
+    AudioModule* get_sink() const { return this->sink; }
+
+    /**
+     * @brief Sets the sink of the chain
+     *
+     * This MUST NOT be changed while running!
+     *
+     * @param mod Sink of the chain
+     */
+    void set_sink(AudioModule* mod) { this->sink = mod; }
+
+    /**
+     * @brief Gets the real-time options
+     *
+     * @return RTConfig Real-time options
+     */
+    RTConfig get_config() const { return this->config; }
+
+    /**
+     * @brief Sets the real-time options
+     *
+     * These are applied the next time the engine runs.
+     *
+     * @param conf Real-time options
+     */
+    void set_config(const RTConfig& conf) { this->config = conf; }
+
+    /**
+     * @brief Gets the real-time options that were applied
+     *
+     * When using a dedicated thread, this is only valid
+     * once the thread has begun processing.
+     *
+     * @return RTStatus Options that were applied
+     */
+    RTStatus get_status() const { return this->status; }
+};
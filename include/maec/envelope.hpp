@@ -66,10 +66,10 @@ class BaseEnvelope : public SourceModule {
         int64_t stop_time = 0;
 
         /// Value we are starting on
-        long double value_start = 0;
+        sample_t value_start = 0;
 
         /// Value we are stopping on
-        long double value_stop = 0;
+        sample_t value_stop = 0;
 
     public:
 
@@ -110,14 +110,14 @@ class BaseEnvelope : public SourceModule {
          * 
          * @param startv Value to start on
          */
-        void set_start_value(long double startv) { this->value_start = startv; }
+        void set_start_value(sample_t startv) { this->value_start = startv; }
 
         /**
          * @brief Gets the start value of this envelope
          * 
-         * @return long double Start value of this envelope
+         * @return sample_t Start value of this envelope
          */
-        long double get_start_value() const { return this->value_start; }
+        sample_t get_start_value() const { return this->value_start; }
 
         /**
          * @brief Sets the stop value of this envelope
@@ -126,14 +126,14 @@ class BaseEnvelope : public SourceModule {
          * 
          * @param stopv Value to stop on
          */
-        void set_stop_value(long double stopv) { this->value_stop = stopv; }
+        void set_stop_value(sample_t stopv) { this->value_stop = stopv; }
 
         /**
          * @brief Gets the stop value of this envelope
          * 
-         * @return long double Stop value of this envelope
+         * @return sample_t Stop value of this envelope
          */
-        long double get_stop_value() const { return this->value_stop; }
+        sample_t get_stop_value() const { return this->value_stop; }
 
         /**
          * @brief Sets the start time of this envelope
@@ -180,9 +180,9 @@ class BaseEnvelope : public SourceModule {
          * We take into account the possibility that value_start may be zero.
          * If this is the case, we use a very low value.
          * 
-         * @return long double Result of the divide operation
+         * @return sample_t Result of the divide operation
          */
-        long double val_divide() const { return this->value_stop / (this->value_start != 0 ? this->value_start : SMALL); }
+        sample_t val_divide() const { return this->value_stop / (this->value_start != 0 ? this->value_start : SMALL); }
 
         /**
          * @brief Determines the value difference
@@ -191,9 +191,9 @@ class BaseEnvelope : public SourceModule {
          * This is a convience function,
          * and aims to save some typing.
          * 
-         * @return long double Stop value minus start value
+         * @return sample_t Stop value minus start value
          */
-        long double val_diff() const { return this->value_stop - this->value_start; }
+        sample_t val_diff() const { return this->value_stop - this->value_start; }
 
         /**
          * @brief Determines the number of remaining samples
@@ -204,6 +204,19 @@ class BaseEnvelope : public SourceModule {
          * @return int 
          */
         int64_t remaining_samples() { return (this->get_stop_time() - this->get_timer()->get_time()) / this->get_timer()->get_npf(); }
+
+        /**
+         * @brief Determines the number of samples in a block that come before the stop time
+         *
+         * Ramps use this to determine how many samples need to be computed,
+         * the rest of the block simply holds the stop value.
+         * If the stop time is not after the start time,
+         * then the envelope is considered finished and we return zero.
+         *
+         * @param size Number of samples in the block
+         * @return int64_t Number of samples before the stop time
+         */
+        int64_t ramp_length(int64_t size) const;
 };
 
 /**
@@ -352,6 +365,12 @@ class SetValue : public BaseEnvelope {
  * T0 = start time
  * T1 = end time
  * 
+ * We don't evaluate this formula for every sample.
+ * Instead, we find the value at the start of the block
+ * and the ratio between neighboring samples,
+ * and fill the block using a multiplicative recurrence (see dsp/ramp.hpp).
+ * Once the stop time is reached, we hold the stop value.
+ * 
  */
 class ExponentialRamp : public BaseEnvelope {
 
@@ -380,6 +399,11 @@ class ExponentialRamp : public BaseEnvelope {
  * T0 = start time
  * T1 = end time
  * 
+ * Like ExponentialRamp, we find the value at the start of the block
+ * and the difference between neighboring samples,
+ * and fill the block using these values.
+ * Once the stop time is reached, we hold the stop value.
+ * 
  */
 class LinearRamp : public BaseEnvelope {
 
@@ -454,7 +478,7 @@ class ChainEnvelope : public BaseEnvelope {
         std::vector<BaseEnvelope*> envs {};
 
         /// Vector of internal envelopes
-        std::vector<std::unique_ptr<InternalEnvelope>> inter {};
+        std::vector<ModulePointer<InternalEnvelope>> inter {};
 
         /// Current envelope index we are on:
         int env_index = -1;
@@ -563,7 +587,7 @@ class ADSREnvelope : public ChainEnvelope {
         int64_t decay = 0;
 
         /// Value to sustain at
-        long double sustain = 0;
+        sample_t sustain = 0;
 
         /// Time it takes to ramp to zero after key is released
         int64_t release = 0;
@@ -571,11 +595,20 @@ class ADSREnvelope : public ChainEnvelope {
         /// Collection for keeping envelopes:
         Collection<BaseEnvelope> envs;
 
+        /// Last value we produced, which the release starts from
+        sample_t last = 0;
+
+        /// Value the release ramps down from
+        sample_t release_value = 0;
+
+        /// Time the release started
+        int64_t release_start = 0;
+
     public:
 
         ADSREnvelope() =default;
 
-        ADSREnvelope(int64_t att, int64_t dec, long double sus, int64_t rel) : attack(att), decay(dec), sustain(sus), release(rel) {}
+        ADSREnvelope(int64_t att, int64_t dec, sample_t sus, int64_t rel) : attack(att), decay(dec), sustain(sus), release(rel) {}
 
         /**
          * @brief Sets the attack value
@@ -616,14 +649,14 @@ class ADSREnvelope : public ChainEnvelope {
          * 
          * @param sus Sustain to set
          */
-        void set_sustain(long double sus) { this->sustain = sus; }
+        void set_sustain(sample_t sus) { this->sustain = sus; }
 
         /**
          * @brief Gets the sustain value
          * 
-         * @return long double Current sustain value
+         * @return sample_t Current sustain value
          */
-        long double get_sustain() const { return this->sustain; }
+        sample_t get_sustain() const { return this->sustain; }
 
         /**
          * @brief Sets the release value
@@ -650,6 +683,18 @@ class ADSREnvelope : public ChainEnvelope {
          */
         void start() override;
 
+        /**
+         * @brief Processes this envelope
+         *
+         * Until we are finished, we run through the attack, decay and sustain.
+         * Once finishing, we ramp down to zero over the release time,
+         * and are marked as done when the ramp completes.
+         * Blocks after the release are silent, and are marked as such
+         * so modules in front of us may skip them.
+         *
+         */
+        void process() override;
+
         /**
          * @brief Finishes this envelope
          * 
@@ -0,0 +1,147 @@
+/**
+ * @file event.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Timestamped events for module chains
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Modules often need to change at a specific point in time,
+ * such as when a note is pressed or a parameter is set.
+ * Checking the time for every sample is slow,
+ * and changing values between buffers is not accurate.
+ *
+ * Instead, events can be scheduled onto the chain
+ * at the sample they should occur on.
+ * Modules that handle events split their buffer at each event boundary,
+ * and render each sub-block with constant settings (see AudioModule::render_events()).
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+class AudioModule;
+
+/**
+ * @brief Types of events
+ */
+enum class EventType {
+    NoteOn,     /// A note has been pressed
+    NoteOff,    /// A note has been released
+    Parameter,  /// A parameter should be set
+    Custom      /// Module specific event
+};
+
+/**
+ * @brief A timestamped event
+ *
+ * Events are targeted towards a single module.
+ * What the ID and value mean is up to the module,
+ * for example a Parameter event may use the ID
+ * to determine which parameter to set.
+ */
+struct Event {
+
+    /// Chain sample time this event occurs on
+    int64_t sample = 0;
+
+    /// Module this event is for
+    AudioModule* target = nullptr;
+
+    /// Type of this event
+    EventType type = EventType::Custom;
+
+    /// ID of this event
+    int id = 0;
+
+    /// Value of this event
+    double value = 0;
+};
+
+/**
+ * @brief A queue of events, ordered by time
+ *
+ * Each chain holds one of these queues in its ChainInfo.
+ * Events are kept in order of sample time,
+ * and events with the same time are kept in the order they were added.
+ *
+ * Events that are scheduled in the past
+ * will be handled at the start of the next block.
+ */
+class EventQueue {
+
+    private:
+
+        /// Events, sorted by sample time
+        std::vector<Event> events;
+
+    public:
+
+        EventQueue() =default;
+
+        /**
+         * @brief Adds an event to this queue
+         *
+         * @param event Event to add
+         */
+        void push(const Event& event);
+
+        /**
+         * @brief Determines the time of the next event for a module
+         *
+         * We find the first event for the given module
+         * that occurs after the given time, and before the limit.
+         *
+         * @param target Module to search for
+         * @param after Time the event must occur after
+         * @param limit Time to stop searching at
+         * @return int64_t Time of the next event, or limit if there is none
+         */
+        int64_t next(const AudioModule* target, int64_t after, int64_t limit) const;
+
+        /**
+         * @brief Hands events to a module
+         *
+         * We remove each event for the given module
+         * that occurs at or before the given time,
+         * and pass it to the module's on_event() method.
+         *
+         * @param target Module to dispatch to
+         * @param until Time to dispatch until
+         * @return int Number of events dispatched
+         */
+        int dispatch(AudioModule* target, int64_t until);
+
+        /**
+         * @brief Removes every event for a module
+         *
+         * This should be called when a module that may have
+         * pending events is destroyed.
+         *
+         * @param target Module to remove events for
+         */
+        void remove(const AudioModule* target);
+
+        /**
+         * @brief Gets the number of events in this queue
+         *
+         * @return std::size_t Number of events
+         */
+        std::size_t size() const { return this->events.size(); }
+
+        /**
+         * @brief Determines if this queue is empty
+         *
+         * @return true If there are no events
+         * @return false If there are events
+         */
+        bool empty() const { return this->events.empty(); }
+
+        /**
+         * @brief Removes all events
+         */
+        void clear() { this->events.clear(); }
+};
@@ -0,0 +1,314 @@
+/**
+ * @file executor.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Components for processing modules concurrently
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This file contains a work stealing thread pool,
+ * which is used to process independent parts of a chain concurrently.
+ * For example, ModuleMixDown can use a pool to process
+ * each of its input subtrees on a separate core.
+ *
+ * On machines with many NUMA nodes, the pool can pin its workers to each node
+ * and keep each part of a batch on the same node (see numa.hpp).
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "numa.hpp"
+
+/**
+ * @brief A fixed pool of worker threads that steal work from each other
+ *
+ * Work is given to this pool in batches.
+ * A batch is a function and a number of tasks,
+ * and the function is called once with the index of each task.
+ * The tasks are spread over the queues of each worker.
+ * Workers take tasks from the back of their own queue,
+ * and when empty, steal tasks from the front of the other queues.
+ * The thread that submits the batch also steals tasks,
+ * so it does useful work while waiting for the batch to complete.
+ *
+ * The order in which tasks are run is not defined!
+ * Tasks should write their results to a location determined by their index,
+ * so the results are deterministic regardless of which thread ran each task.
+ *
+ * Only one batch can be run at a time.
+ *
+ * Queues have a fixed number of task slots, which grow if a batch does not fit.
+ * Components that run batches on the audio thread should reserve room
+ * for their largest batch when they are set up (see reserve()),
+ * so running a batch never allocates.
+ *
+ * When built from a NumaTopology, workers are pinned to the CPUs of each node,
+ * and the tasks of a batch are split into contiguous ranges, one for each node
+ * (see node_of()).
+ * Workers then only steal from the workers on their own node,
+ * so task i of a batch of a given size always runs on the same node.
+ * Memory is placed on the node of the thread that first touches it,
+ * so the buffers of each task (such as the buffer pool of a ModuleMixDown input)
+ * are allocated on, and stay on, the node that processes them.
+ * Stealing between nodes can be allowed (see set_remote_stealing()),
+ * which balances uneven batches at the cost of remote memory access.
+ * The thread that submits the batch may still run a task from any node.
+ */
+class WorkerPool {
+
+   private:
+
+    /**
+     * @brief A single task to run
+     */
+    struct Task {
+
+        /// Function to call
+        const std::function<void(int)>* func = nullptr;
+
+        /// Index to call the function with
+        int index = 0;
+    };
+
+    /**
+     * @brief Queue of tasks for a worker
+     *
+     * Tasks waiting to be run are kept in [head, tail) of the slots.
+     * The positions are reset once the queue empties,
+     * so a batch never needs more slots than the tasks given to this queue.
+     */
+    struct Queue {
+
+        /// Slots for tasks
+        std::vector<Task> tasks;
+
+        /// Position of the task at the front
+        std::size_t head = 0;
+
+        /// Position after the task at the back
+        std::size_t tail = 0;
+
+        /// Mutex protecting the tasks
+        std::mutex mutex;
+    };
+
+    /// Queues for each worker
+    std::vector<std::unique_ptr<Queue>> queues;
+
+    /// Worker threads
+    std::vector<std::thread> workers;
+
+    /// Number of tasks in the current batch that have not completed
+    std::atomic<int> remaining{0};
+
+    /// Number of tasks waiting in queues
+    std::atomic<int> queued{0};
+
+    /// Value determining if the workers should keep running
+    bool running = true;
+
+    /// Value determining if the workers flush denormals to zero
+    bool flush = true;
+
+    /// Topology the workers are pinned to
+    NumaTopology topology;
+
+    /// Value determining if the workers pin themselves to their node
+    bool pin = false;
+
+    /// Value determining if workers steal tasks from other nodes
+    std::atomic<bool> remote{true};
+
+    /// Node of each worker
+    std::vector<int> worker_nodes;
+
+    /// Queues of the workers on each node
+    std::vector<std::vector<int>> node_queues;
+
+    /// Number of tasks waiting in the queues of each node
+    std::vector<std::atomic<int>> node_queued;
+
+    /// Number of tasks given to each node in the current batch
+    std::vector<int> node_counts;
+
+    /// Mutex for sleeping workers
+    std::mutex sleep_mutex;
+
+    /// Condition variable for waking workers
+    std::condition_variable wake;
+
+    /**
+     * @brief Creates the queues and starts the workers
+     *
+     * @param nodes Node of each worker
+     */
+    void launch(const std::vector<int>& nodes);
+
+    /**
+     * @brief Attempts to take a task from the front of a queue
+     *
+     * @param victim Index of the queue
+     * @param task Task to fill
+     * @return true If a task was taken
+     * @return false If the queue is empty
+     */
+    bool steal(int victim, Task& task);
+
+    /**
+     * @brief Attempts to take a task
+     *
+     * We first try the back of the given queue,
+     * then steal from the front of the others on the same node,
+     * and then from the other nodes if allowed.
+     *
+     * @param home Index of the queue to try first, -1 to only steal
+     * @param task Task to fill
+     * @return true If a task was taken
+     * @return false If no tasks are available
+     */
+    bool take(int home, Task& task);
+
+    /**
+     * @brief Runs a task and marks it complete
+     *
+     * @param task Task to run
+     */
+    void execute(const Task& task);
+
+    /**
+     * @brief Main loop of each worker
+     *
+     * @param index Index of the worker
+     */
+    void worker_loop(int index);
+
+   public:
+
+    /**
+     * @brief Construct a new WorkerPool object
+     *
+     * Workers run parts of a chain, so like the thread running the chain
+     * they flush denormals to zero by default (see dsp/denormal.hpp).
+     *
+     * @param threads Number of worker threads, 0 uses one less than the number of cores
+     * @param ftz Value determining if workers flush denormals to zero
+     */
+    explicit WorkerPool(int threads = 0, bool ftz = true);
+
+    /**
+     * @brief Construct a new WorkerPool object with workers pinned to each node
+     *
+     * @param topo Nodes to place workers on
+     * @param per_node Number of workers on each node, 0 uses one for each CPU
+     * @param ftz Value determining if workers flush denormals to zero
+     */
+    explicit WorkerPool(const NumaTopology& topo, int per_node = 0, bool ftz = true);
+
+    /**
+     * @brief Destroy the WorkerPool object
+     *
+     * We stop and join all workers.
+     */
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * @brief Runs a batch of tasks
+     *
+     * We call the function with each index in [0, num),
+     * and return once all calls have completed.
+     *
+     * @param func Function to call with each index
+     * @param num Number of tasks
+     * @param deadline Time in nanoseconds the batch should complete within, 0 for no deadline
+     * @return true If the batch completed within the deadline
+     * @return false If the deadline was missed
+     */
+    bool run(const std::function<void(int)>& func, int num, int64_t deadline = 0);
+
+    /**
+     * @brief Reserves room for batches of a given size
+     *
+     * Every queue can then hold the given number of tasks,
+     * so running batches of up to this size never allocates.
+     * This should be called when setting up, not while a batch is running.
+     *
+     * @param num Number of tasks in the largest batch
+     */
+    void reserve(int num);
+
+    /**
+     * @brief Gets the number of tasks each queue can hold without allocating
+     *
+     * @return int Number of task slots in the smallest queue
+     */
+    int capacity() const;
+
+    /**
+     * @brief Gets the number of worker threads
+     *
+     * @return int Number of worker threads
+     */
+    int size() const { return static_cast<int>(this->workers.size()); }
+
+    /**
+     * @brief Gets the number of nodes workers are placed on
+     *
+     * @return int Number of nodes
+     */
+    int node_count() const { return static_cast<int>(this->node_queues.size()); }
+
+    /**
+     * @brief Gets the node of a worker
+     *
+     * @param worker Index of the worker
+     * @return int Node of the worker
+     */
+    int get_node(int worker) const { return this->worker_nodes.at(worker); }
+
+    /**
+     * @brief Determines the node a task is placed on
+     *
+     * Tasks are split into contiguous ranges,
+     * so neighbouring tasks (which are often neighbouring inputs of a mixer) share a node.
+     *
+     * @param index Index of the task
+     * @param num Number of tasks in the batch
+     * @return int Node of the task
+     */
+    int node_of(int index, int num) const { return static_cast<int>(static_cast<int64_t>(index) * this->node_count() / num); }
+
+    /**
+     * @brief Determines if workers steal tasks from other nodes
+     *
+     * @param val True to steal from other nodes
+     */
+    void set_remote_stealing(bool val) { this->remote = val; }
+
+    /**
+     * @brief Determines if workers steal tasks from other nodes
+     *
+     * @return true If workers steal from other nodes
+     * @return false If workers stay on their own node
+     */
+    bool get_remote_stealing() const { return this->remote; }
+
+    /**
+     * @brief Gets the node of the calling thread
+     *
+     * @return int Node of the calling worker, -1 if not called from a worker
+     */
+    static int current_node();
+};
@@ -18,9 +18,40 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <semaphore>
+#include <thread>
+#include <vector>
+
 #include "audio_module.hpp"
+#include "executor.hpp"
+#include "module_param.hpp"
 
 #include "dsp/const.hpp"
+#include "dsp/conv.hpp"
+#include "dsp/iir.hpp"
+#include "dsp/ring.hpp"
+#include "dsp/window.hpp"
+
+/**
+ * @brief Methods convolution filters can use
+ *
+ * Direct convolution is done in the time domain,
+ * and outputs the full convolution (including the tail) for each block.
+ * This is fine for small kernels, but gets slow for large ones.
+ *
+ * Streaming convolution is done in the time domain,
+ * but carries the tail over to the next block,
+ * so one output sample is produced for each input sample.
+ * This is the best choice for small kernels when filtering a continuous signal.
+ *
+ * Overlap-save convolution is done in the frequency domain,
+ * and keeps state between blocks, so one output sample is produced
+ * for each input sample.
+ * This is much faster for large kernels.
+ */
+enum class ConvMode { Direct, Streaming, OverlapSave };
 
 /**
  * @brief A base class for filters
@@ -133,12 +164,38 @@ class BaseConvFilter : public BaseFilter {
 
     private:
 
-        /// Filter kernel to utilize
-        BufferPointer kernel = nullptr;
+        /// Filter kernel to utilize, shared and immutable
+        KernelPointer kernel = nullptr;
 
         /// Size of the filter kernel
         int size = 0;
 
+        /// Method of convolution to use
+        ConvMode mode = ConvMode::Direct;
+
+        /// Engine used for streaming convolution
+        StreamFIR<sample_t> fir;
+
+        /// Engine used for overlap-save convolution
+        OverlapSave ols;
+
+        /// Number of silent samples seen since the last sound
+        int64_t quiet = 0;
+
+        /// Kernel to fade to on the next block, if any
+        KernelPointer next_kernel = nullptr;
+
+        /// Spectrum of the kernel to fade to, for overlap-save convolution
+        SpectrumPointer next_spectrum = nullptr;
+
+        /**
+         * @brief Fades to the staged kernel over the given block
+         *
+         * @param input Incoming buffer
+         * @param output Outgoing buffer
+         */
+        void fade(const AudioBuffer& input, AudioBuffer& output);
+
     public:
 
         /**
@@ -158,16 +215,41 @@ class BaseConvFilter : public BaseFilter {
         /**
          * @brief Gets a pointer to the kernel
          * 
-         * @return AudioBuffer* AudioBuffer to contain a kernel
+         * The kernel is immutable and shared,
+         * so the returned pointer can be handed to other filters
+         * (i.e one per channel) without copying the kernel.
+         * We retain our reference, so this can be called as many times as necessary.
+         * 
+         * @return KernelPointer Shared pointer to the kernel
          */
-        BufferPointer get_kernel();
+        KernelPointer get_kernel() const { return this->kernel; }
 
         /**
-         * @brief Sets the kernel using the BufferPointer
+         * @brief Sets the kernel
+         * 
+         * A BufferPointer can be moved in here,
+         * or a kernel shared with another filter can be provided.
          * 
          * @param nkern New kernel to set
          */
-        void set_kernel(BufferPointer nkern);
+        void set_kernel(KernelPointer nkern);
+
+        /**
+         * @brief Gets the convolution mode
+         *
+         * @return ConvMode Current convolution mode
+         */
+        ConvMode get_mode() const { return this->mode; }
+
+        /**
+         * @brief Sets the convolution mode
+         *
+         * This should be set before the module is started,
+         * as the mode determines what work is done at start time.
+         *
+         * @param nmode New convolution mode
+         */
+        void set_mode(ConvMode nmode) { this->mode = nmode; }
 
         /**
          * @brief Creates a filter kernel
@@ -186,31 +268,900 @@ class BaseConvFilter : public BaseFilter {
          * allowing for proper filtering to take place
          * once audio data is provided.
          * 
+         * If we are using streaming convolution,
+         * then the history is allocated here.
+         * If we are using overlap-save convolution,
+         * then the kernel spectrum is also computed here,
+         * so no transform of the kernel is done while processing.
+         * 
          */
         void start() override;
 
+        /**
+         * @brief Adds the memory held by this filter
+         *
+         * We count the kernel (and any kernel being faded to),
+         * along with the history and spectrum of the convolution engine in use.
+         *
+         * @param usage Footprint to add to
+         */
+        void footprint(MemoryFootprint& usage) const override;
+
         /**
          * @brief Processes incoming audio data
          * 
          * We Just convolve the incoming audio data
          * with the generated filter kernel. 
          * 
+         * The method of convolution is determined by the current mode.
+         *
+         * Silent input is skipped once the tail of the kernel has passed,
+         * see decayed().
+         * 
          */
         void process() override;
+
+    protected:
+
+        /**
+         * @brief Determines if our tail has decayed
+         *
+         * Convolution of silence has no output once the
+         * samples we remember have all been silent.
+         * We count the silent samples we see,
+         * and report when at least the given tail has passed.
+         * Any input that is not silent resets the count.
+         *
+         * Call this once for each block,
+         * skipping the convolution when we return true.
+         *
+         * @param input Incoming buffer
+         * @param tail Number of samples remembered between blocks
+         * @return true If the block is silent, and so is the output
+         * @return false If the block must be convolved
+         */
+        bool decayed(const AudioBuffer& input, int64_t tail);
+
+        /**
+         * @brief Stages a kernel to fade to while running
+         *
+         * The next block is convolved with both the current and the new kernel,
+         * and the output is crossfaded between them,
+         * after which the new kernel is used.
+         * This allows the kernel to be changed without clicks or reallocation.
+         *
+         * When streaming or using overlap-save convolution,
+         * the kernel MUST be the same size as the current one.
+         * For overlap-save, the spectrum of the kernel must also be provided,
+         * computed for the same block size (see OverlapSave::get_spectrum()).
+         *
+         * This must be called from the thread processing us.
+         *
+         * @param nkern Kernel to fade to
+         * @param spec Spectrum of the kernel to fade to, only used for overlap-save convolution
+         */
+        void stage_kernel(KernelPointer nkern, SpectrumPointer spec = nullptr);
 };
 
+/**
+ * @brief Designs a windowed sinc filter kernel
+ *
+ * We design a low pass kernel with sinc_kernel(),
+ * and use spectral inversion and summing to create the other types.
+ * Band filters use both frequencies, other types only the start frequency.
+ *
+ * Kernels are immutable, and are kept in a process-wide cache
+ * keyed by (type, size, frequencies, window),
+ * so filters with the same design share one kernel
+ * and starting a filter with a known design costs nothing.
+ * Kernels no one holds are evicted once the cache grows large,
+ * which keeps parameter sweeps from filling the cache.
+ *
+ * This function is thread safe.
+ * Designing allocates, so this should not be called from a real-time context.
+ *
+ * @param type Type of filter
+ * @param size Size of the kernel
+ * @param start Start frequency, as a fraction of the sample rate
+ * @param stop Stop frequency, as a fraction of the sample rate
+ * @param window Window applied to the kernel
+ * @return KernelPointer Shared kernel
+ */
+KernelPointer sinc_design(FilterType type, int size, double start, double stop, WindowType window = WindowType::Blackman);
+
+/**
+ * @brief Determines the number of cached sinc kernels
+ *
+ * @return std::size_t Number of kernels
+ */
+std::size_t sinc_cache_size();
+
+/**
+ * @brief Removes all cached sinc kernels
+ *
+ * Kernels still held by filters stay valid.
+ */
+void sinc_cache_clear();
+
+/**
+ * @brief FIR filter using a windowed sinc kernel
+ *
+ * The kernel is designed from the filter type and frequencies when we are started,
+ * see sinc_design().
+ *
+ * The frequencies can be changed while running with retune().
+ * When dynamic (see set_dynamic()), a background thread designs the new kernel,
+ * and the audio thread crossfades to it over one block (see stage_kernel()),
+ * so modulating the cutoff never stalls processing with kernel design.
+ * Requests that arrive while a design is in progress are merged,
+ * so only the latest frequencies are designed.
+ */
 class SincFilter : public BaseConvFilter {
 
+    private:
+
+        /**
+         * @brief A kernel designed by the background thread
+         */
+        struct Design {
+
+            /// Designed kernel
+            KernelPointer kernel = nullptr;
+
+            /// Spectrum of the kernel, for overlap-save convolution
+            SpectrumPointer spectrum = nullptr;
+        };
+
+        /// Window applied to the kernel
+        WindowType window = WindowType::Blackman;
+
+        /// Value determining if kernels are designed in the background while running
+        bool dynamic = false;
+
+        /// Start frequency requested by retune()
+        std::atomic<double> target_start{0};
+
+        /// Stop frequency requested by retune()
+        std::atomic<double> target_stop{0};
+
+        /// Value determining if the background thread has been woken
+        std::atomic<bool> pending{false};
+
+        /// Number of designs completed by the background thread
+        std::atomic<uint64_t> designs{0};
+
+        /// Value determining if the background thread should keep running
+        std::atomic<bool> running{false};
+
+        /// Semaphore waking the background thread
+        std::binary_semaphore wake{0};
+
+        /// Background thread designing kernels
+        std::thread worker;
+
+        /// Designs handed to the audio thread
+        TripleBuffer<Design> published;
+
+        /**
+         * @brief Main loop of the background thread
+         *
+         */
+        void design_loop();
+
+        /**
+         * @brief Wakes the background thread, if it is not already woken
+         *
+         */
+        void request();
+
+        /**
+         * @brief Stops and joins the background thread
+         *
+         */
+        void join();
+
     public:
 
         SincFilter() =default;
 
+        ~SincFilter() override;
+
+        SincFilter(const SincFilter&) = delete;
+        SincFilter& operator=(const SincFilter&) = delete;
+
         /**
          * @brief Generates a sinc filter kernel
          * 
-         * We generate a sinc filter kernel based upon
-         * the filter parameters in this class.
+         * We fetch a sinc filter kernel based upon
+         * the filter parameters in this class,
+         * see sinc_design().
          * 
          */
         void generate_kernel() override;
+
+        /**
+         * @brief Starts this module
+         *
+         * If we are dynamic, the background thread is started.
+         *
+         */
+        void start() override;
+
+        /**
+         * @brief Stops this module
+         *
+         * The background thread is stopped.
+         *
+         */
+        void stop() override;
+
+        /**
+         * @brief Processes incoming audio data
+         *
+         * If a new kernel has been designed, we fade to it.
+         *
+         */
+        void process() override;
+
+        /**
+         * @brief Changes the frequencies of this filter
+         *
+         * This may be called from any thread, including the audio thread, at any time.
+         * If we are running and dynamic, the background thread designs the new kernel
+         * and we crossfade to it, otherwise the new frequencies are used at the next start.
+         *
+         * @param start Start frequency in hertz
+         * @param stop Stop frequency in hertz
+         */
+        void retune(double start, double stop);
+
+        /**
+         * @brief Determines if kernels are designed in the background while running
+         *
+         * This must be set before we are started.
+         *
+         * @param val True to allow retuning while running
+         */
+        void set_dynamic(bool val) { this->dynamic = val; }
+
+        /**
+         * @brief Determines if kernels are designed in the background while running
+         *
+         * @return true If retuning while running is allowed
+         * @return false If retuning is used at the next start
+         */
+        bool get_dynamic() const { return this->dynamic; }
+
+        /**
+         * @brief Sets the window applied to the kernel
+         *
+         * This must be set before we are started.
+         *
+         * @param type Type of window
+         */
+        void set_window(WindowType type) { this->window = type; }
+
+        /**
+         * @brief Gets the window applied to the kernel
+         *
+         * @return WindowType Type of window
+         */
+        WindowType get_window() const { return this->window; }
+
+        /**
+         * @brief Gets the number of kernels designed in the background
+         *
+         * @return uint64_t Number of designs
+         */
+        uint64_t get_designs() const { return this->designs.load(std::memory_order_acquire); }
+};
+
+/**
+ * @brief Filter for convolving with very long kernels
+ *
+ * This filter is designed for kernels that are much larger than
+ * the block size, such as reverb impulse responses.
+ * We use uniformly partitioned convolution, which splits the kernel
+ * into partitions the size of the incoming block.
+ * This allows very long kernels to be applied at low latency,
+ * with per block cost that does not require any FFT proportional to kernel length.
+ *
+ * The kernel should be provided via set_kernel() before the module is started.
+ * The partition size is determined by the largest block size at start time
+ * (see max_block_size()), which must be a power of two.
+ * Each block produces exactly one block of output,
+ * and smaller blocks are convolved as they arrive without added latency.
+ */
+class PartitionedConvFilter : public BaseConvFilter {
+
+    private:
+
+        /// Engine that does the partitioned convolution
+        PartitionedConv engine;
+
+    public:
+
+        PartitionedConvFilter() =default;
+
+        /**
+         * @brief Starts this module
+         *
+         * We generate the kernel, split it into partitions,
+         * and compute the spectrum of each partition.
+         *
+         */
+        void start() override;
+
+        /**
+         * @brief Adds the memory held by this filter
+         *
+         * We add the partition spectra, delay line and transform of our engine.
+         *
+         * @param usage Footprint to add to
+         */
+        void footprint(MemoryFootprint& usage) const override;
+
+        /**
+         * @brief Processes incoming audio data
+         *
+         * We run the incoming block through the partitioned convolution engine.
+         *
+         */
+        void process() override;
+
+        /**
+         * @brief Gets the number of partitions in use
+         *
+         * @return int Number of partitions
+         */
+        int get_partitions() const { return this->engine.get_partitions(); }
+};
+
+/**
+ * @brief Partitioned convolution of many channels at once
+ *
+ * Room correction and spatial audio convolve every channel of a buffer
+ * with its own long kernel, which PartitionedConvFilter can't do
+ * as it only works with a single channel.
+ * We keep a PartitionedConv engine for each channel,
+ * and convolve each channel of the buffer in place.
+ *
+ * Each channel may have its own kernel (see set_channel_kernel()),
+ * and channels without one use the default kernel (see set_kernel()).
+ * Channels with matching kernels share one set of partition spectra,
+ * so the kernel is only transformed and stored once.
+ *
+ * Channels are independent, so if a WorkerPool is provided (see set_executor())
+ * they are convolved concurrently, one task per channel.
+ * Like ModuleMixDown, if a deadline is set and a block takes longer than it,
+ * we fall back to serial processing for a number of blocks before trying again.
+ *
+ * Like PartitionedConvFilter, the partition size is determined
+ * by the largest block size at start time, which must be a power of two,
+ * and smaller blocks are convolved as they arrive.
+ */
+class MultiConvFilter : public AudioModule {
+
+    private:
+
+        /// Kernel used by channels without their own
+        KernelPointer kernel = nullptr;
+
+        /// Kernel of each channel, nullptr to use the default
+        std::vector<KernelPointer> kernels;
+
+        /// Engine for each channel
+        std::vector<PartitionedConv> engines;
+
+        /// Working memory for each channel, input then output
+        std::vector<sample_t> scratch;
+
+        /// Number of distinct kernels in use
+        int unique = 0;
+
+        /// Number of silent samples seen since the last sound
+        int64_t quiet = 0;
+
+        /// Pool to convolve channels with, if any
+        WorkerPool* executor = nullptr;
+
+        /// Time in nanoseconds concurrent processing should complete within, 0 for none
+        int64_t deadline = 0;
+
+        /// Number of blocks to process serially after missing the deadline
+        int backoff = 64;
+
+        /// Number of blocks remaining until we try concurrent processing again
+        int serial = 0;
+
+        /**
+         * @brief Gets the kernel of a channel
+         *
+         * @param channel Channel to get
+         * @return const KernelPointer& Kernel of the channel
+         */
+        const KernelPointer& kernel_of(int channel) const;
+
+        /**
+         * @brief Convolves one channel of the current buffer
+         *
+         * @param channel Channel to convolve
+         */
+        void process_channel(int channel);
+
+    public:
+
+        MultiConvFilter() =default;
+
+        /**
+         * @brief Starts this module
+         *
+         * We create an engine for each channel,
+         * computing the partition spectra once for each distinct kernel.
+         *
+         */
+        void start() override;
+
+        /**
+         * @brief Adds the memory held by this filter
+         *
+         * We count the kernels, and the partition spectra, delay line and transform of each channel.
+         * Channels that share a kernel each count its spectra.
+         *
+         * @param usage Footprint to add to
+         */
+        void footprint(MemoryFootprint& usage) const override;
+
+        /**
+         * @brief Processes incoming audio data
+         *
+         * We convolve each channel of the buffer with its kernel, in place.
+         * Silent input is skipped once every tail has passed.
+         *
+         */
+        void process() override;
+
+        /// We convolve the buffer we are given
+        bool in_place() const override { return true; }
+
+        /**
+         * @brief Sets the default kernel
+         *
+         * This should be set before the module is started.
+         *
+         * @param nkern Kernel used by channels without their own
+         */
+        void set_kernel(KernelPointer nkern) { this->kernel = std::move(nkern); }
+
+        /**
+         * @brief Gets the default kernel
+         *
+         * @return KernelPointer Kernel used by channels without their own
+         */
+        KernelPointer get_kernel() const { return this->kernel; }
+
+        /**
+         * @brief Sets the kernel of a channel
+         *
+         * This should be set before the module is started.
+         * Channels given the same kernel (or kernels with the same values)
+         * will share partition spectra.
+         *
+         * @param channel Channel to set
+         * @param nkern Kernel of the channel, nullptr to use the default
+         */
+        void set_channel_kernel(int channel, KernelPointer nkern);
+
+        /**
+         * @brief Gets the number of partitions of a channel
+         *
+         * @param channel Channel to get
+         * @return int Number of partitions
+         */
+        int get_partitions(int channel) const { return this->engines.at(channel).get_partitions(); }
+
+        /**
+         * @brief Gets the number of distinct kernels in use
+         *
+         * Channels with the same kernel share partition spectra,
+         * so this is the number of spectra computed at start time.
+         *
+         * @return int Number of distinct kernels
+         */
+        int get_unique_kernels() const { return this->unique; }
+
+        /**
+         * @brief Gets the pool used to convolve channels
+         *
+         * @return WorkerPool* Pool in use, nullptr if we process serially
+         */
+        WorkerPool* get_executor() const { return this->executor; }
+
+        /**
+         * @brief Sets the pool used to convolve channels
+         *
+         * A pool can only run one batch at a time,
+         * so it must not be shared with a module processing us concurrently.
+         * This should be set before we are started,
+         * which reserves room in the pool for each channel.
+         *
+         * @param pool Pool to use, nullptr to process serially
+         */
+        void set_executor(WorkerPool* pool) { this->executor = pool; }
+
+        /**
+         * @brief Gets the deadline for concurrent processing
+         *
+         * @return int64_t Deadline in nanoseconds, 0 for none
+         */
+        int64_t get_deadline() const { return this->deadline; }
+
+        /**
+         * @brief Sets the deadline for concurrent processing
+         *
+         * This is the time all channels of a block should be convolved within.
+         *
+         * @param time Deadline in nanoseconds, 0 for none
+         */
+        void set_deadline(int64_t time) { this->deadline = time; }
+
+        /**
+         * @brief Sets the number of blocks processed serially after a missed deadline
+         *
+         * @param num Number of blocks
+         */
+        void set_backoff(int num) { this->backoff = num; }
+
+        /**
+         * @brief Determines if we are currently falling back to serial processing
+         *
+         * @return true If channels are being processed serially due to a missed deadline
+         * @return false If channels are processed normally
+         */
+        bool is_fallback() const { return this->serial > 0; }
+};
+
+/**
+ * @brief Recursive filter applied to every channel
+ *
+ * We design a Butterworth or Chebyshev filter (see iir_design())
+ * from the filter type and frequencies when we are started,
+ * and run it as a cascade of biquads.
+ * Every channel shares the same coefficients and keeps its own state,
+ * so state is carried between blocks.
+ *
+ * Interleaved buffers are filtered with all channels running in parallel
+ * vector lanes, which makes filtering many channels very cheap.
+ * Planar buffers are filtered one channel at a time.
+ * We process our buffer in place.
+ *
+ * Custom sections may be provided via set_sections(),
+ * in which case nothing is designed at start time.
+ */
+class BiquadFilter : public BaseFilter {
+
+    private:
+
+        /// Analog prototype to design from
+        IIRPrototype prototype = IIRPrototype::Butterworth;
+
+        /// Order of the prototype
+        int order = 2;
+
+        /// Pass band ripple in decibels
+        double ripple = 1.0;
+
+        /// true if sections were provided by the user
+        bool custom = false;
+
+        /// Sections to run
+        std::vector<BiquadCoefficients<double>> sections;
+
+        /// Shared coefficients, and state for each channel
+        BiquadBank<sample_t> bank;
+
+    public:
+
+        BiquadFilter() =default;
+
+        /**
+         * @brief Construct a new BiquadFilter object
+         *
+         * @param type Filter type
+         * @param startf Start frequency of filter
+         * @param stopf Stop frequency of filter
+         * @param order Order of the prototype
+         */
+        BiquadFilter(FilterType type, double startf, double stopf, int order = 2) : BaseFilter(type, startf, stopf), order(order) {}
+
+        /**
+         * @brief Starts this module
+         *
+         * We design the filter for our sample rate,
+         * and clear the state of every channel.
+         */
+        void start() override;
+
+        /**
+         * @brief Filters the current buffer
+         *
+         */
+        void process() override;
+
+        /// We alter the buffer we are given
+        bool in_place() const override { return true; }
+
+        /**
+         * @brief Sets the analog prototype to design from
+         *
+         * @param proto New prototype
+         */
+        void set_prototype(IIRPrototype proto) { this->prototype = proto; }
+
+        /**
+         * @brief Gets the analog prototype to design from
+         *
+         * @return IIRPrototype Current prototype
+         */
+        IIRPrototype get_prototype() const { return this->prototype; }
+
+        /**
+         * @brief Sets the order of the prototype
+         *
+         * @param num New order
+         */
+        void set_order(int num) { this->order = std::max(1, num); }
+
+        /**
+         * @brief Gets the order of the prototype
+         *
+         * @return int Current order
+         */
+        int get_order() const { return this->order; }
+
+        /**
+         * @brief Sets the pass band ripple of Chebyshev filters
+         *
+         * @param val Ripple in decibels
+         */
+        void set_ripple(double val) { this->ripple = val; }
+
+        /**
+         * @brief Gets the pass band ripple of Chebyshev filters
+         *
+         * @return double Ripple in decibels
+         */
+        double get_ripple() const { return this->ripple; }
+
+        /**
+         * @brief Provides custom sections to run
+         *
+         * @param secs Coefficients of each section
+         */
+        void set_sections(std::vector<BiquadCoefficients<double>> secs) {
+
+            this->sections = std::move(secs);
+            this->custom = true;
+        }
+
+        /**
+         * @brief Gets the sections in use
+         *
+         * This is only valid once we have been started.
+         *
+         * @return const std::vector<BiquadCoefficients<double>>& Coefficients of each section
+         */
+        const std::vector<BiquadCoefficients<double>>& get_sections() const { return this->sections; }
+};
+
+/**
+ * @brief A second order filter with a modulated cutoff
+ *
+ * The cutoff frequency (in hertz) is read from a ModuleParam,
+ * so modules may be attached to sweep the filter.
+ * Retuning an IIR filter only needs a handful of coefficients,
+ * which is far cheaper than regenerating an FIR kernel.
+ *
+ * To keep this cheap and free of zipper noise:
+ *
+ * - The cutoff is read once every (interval) frames, the control rate
+ * - The cutoff is smoothed with a one pole smoother, see set_smoothing()
+ * - Coefficients are only recomputed when the smoothed cutoff moves
+ *   by more than a small tolerance, so constant cutoffs cost nothing
+ *
+ * We use a single section designed with biquad_design(),
+ * and Q sets the resonance (or bandwidth for band filters).
+ * The stop frequency is not used.
+ * We process our buffer in place.
+ */
+class ModulatedFilter : public BaseFilter, public BaseParamModule<1> {
+
+    private:
+
+        /// Cutoff frequency parameter
+        ModuleParam cutoff;
+
+        /// Quality factor
+        double q = M_SQRT1_2;
+
+        /// Number of frames between coefficient updates
+        int interval = 32;
+
+        /// Smoothing time constant in seconds
+        double smoothing = 0.005;
+
+        /// Smoothing factor applied at each update
+        double alpha = 1;
+
+        /// Smoothed cutoff frequency
+        double current = 0;
+
+        /// Cutoff the coefficients were designed for
+        double designed = -1;
+
+        /// Determines if we have read the cutoff
+        bool primed = false;
+
+        /// Number of times coefficients were recomputed
+        int64_t updates = 0;
+
+        /// Shared coefficients, and state for each channel
+        BiquadBank<sample_t> bank;
+
+        /**
+         * @brief Smooths towards a cutoff, and redesigns if necessary
+         *
+         * @param target Cutoff to move towards
+         */
+        void retune(double target);
+
+    public:
+
+        ModulatedFilter() : BaseParamModule<1>(&cutoff) {}
+
+        /**
+         * @brief Construct a new ModulatedFilter object
+         *
+         * @param type Filter type
+         * @param freq Initial cutoff frequency
+         * @param qval Quality factor
+         */
+        ModulatedFilter(FilterType type, sample_t freq, double qval = M_SQRT1_2)
+            : BaseFilter(type, freq, 0), BaseParamModule<1>(&cutoff), cutoff(freq), q(qval) {}
+
+        /**
+         * @brief Starts this module and the cutoff parameter
+         *
+         */
+        void meta_start() override {
+
+            BaseFilter::meta_start();
+
+            this->param_start();
+        }
+
+        /**
+         * @brief Stops this module and the cutoff parameter
+         *
+         */
+        void meta_stop() override {
+
+            BaseFilter::meta_stop();
+
+            this->param_stop();
+        }
+
+        /**
+         * @brief Preforms a meta info sync operation
+         *
+         * We sync ourselves, and then the cutoff parameter.
+         */
+        void meta_info_sync() override {
+
+            BaseFilter::meta_info_sync();
+
+            this->param_info(this);
+        }
+
+        /**
+         * @brief Determines the modules we pull buffers from
+         *
+         * @param inputs Vector to add modules to
+         * @return true If we can be stepped
+         */
+        bool plan_inputs(std::vector<AudioModule*>& inputs) override {
+
+            this->param_inputs(inputs);
+
+            return BaseFilter::plan_inputs(inputs);
+        }
+
+        /**
+         * @brief Starts this module
+         *
+         * We clear the state of every channel,
+         * and jump straight to the current cutoff.
+         */
+        void start() override;
+
+        /**
+         * @brief Filters the current buffer
+         *
+         */
+        void process() override;
+
+        /// We alter the buffer we are given
+        bool in_place() const override { return true; }
+
+        /**
+         * @brief Gets the cutoff parameter
+         *
+         * @return ModuleParam* Cutoff frequency parameter
+         */
+        ModuleParam* get_cutoff() { return &(this->cutoff); }
+
+        /**
+         * @brief Sets the quality factor
+         *
+         * @param val New quality factor
+         */
+        void set_q(double val) {
+
+            this->q = val;
+            this->designed = -1;
+        }
+
+        /**
+         * @brief Gets the quality factor
+         *
+         * @return double Current quality factor
+         */
+        double get_q() const { return this->q; }
+
+        /**
+         * @brief Sets the number of frames between coefficient updates
+         *
+         * This must be set before we are started.
+         *
+         * @param num Number of frames, at least 1
+         */
+        void set_interval(int num) { this->interval = std::max(1, num); }
+
+        /**
+         * @brief Gets the number of frames between coefficient updates
+         *
+         * @return int Number of frames
+         */
+        int get_interval() const { return this->interval; }
+
+        /**
+         * @brief Sets the smoothing time constant
+         *
+         * This must be set before we are started.
+         * A value of 0 disables smoothing.
+         *
+         * @param sec Time constant in seconds
+         */
+        void set_smoothing(double sec) { this->smoothing = std::max(0.0, sec); }
+
+        /**
+         * @brief Gets the smoothing time constant
+         *
+         * @return double Time constant in seconds
+         */
+        double get_smoothing() const { return this->smoothing; }
+
+        /**
+         * @brief Gets the smoothed cutoff frequency
+         *
+         * @return double Cutoff in hertz
+         */
+        double get_current() const { return this->current; }
+
+        /**
+         * @brief Gets the number of times coefficients were recomputed
+         *
+         * @return int64_t Number of updates since we were started
+         */
+        int64_t get_updates() const { return this->updates; }
 };
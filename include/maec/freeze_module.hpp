@@ -0,0 +1,314 @@
+/**
+ * @file freeze_module.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief A module that renders part of a chain once, and plays it back
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Parts of a patch are often deterministic and static,
+ * such as a constant into an oscillator into a fixed filter.
+ * Rendering these every block is wasted work,
+ * as the output is the same every time around.
+ *
+ * The FreezeModule renders the sub-chain behind it once into a cached buffer,
+ * and then plays that buffer back, which costs no more than a copy.
+ * The cache is rendered again when any watched ModuleParam changes.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "audio_module.hpp"
+#include "module_param.hpp"
+
+/**
+ * @brief Renders the modules behind us once, and plays the result back
+ *
+ * The first time we are processed, we render a number of frames
+ * (see set_length()) from the sub-chain into our cache.
+ * From then on we play the cache back, looping by default,
+ * and the sub-chain is not processed at all.
+ * Sources with a period should be frozen for a whole number of periods,
+ * otherwise the loop will click.
+ *
+ * ModuleParams the sub-chain depends on can be watched (see watch()).
+ * When a watched parameter is changed with set_constant() or bind(),
+ * the cache is invalid and is rendered again.
+ * The sub-chain keeps its state between renders,
+ * so oscillators continue from where they left off.
+ *
+ * Rendering is done on the calling thread by default,
+ * which stalls the block that triggers it.
+ * In the background (see set_background()), a worker thread renders the cache instead.
+ * While it does, we keep playing the previous cache,
+ * or silence if there is none, and swap in the new one once it is done.
+ *
+ * The sub-chain gets its own ChainInfo, with its own buffer pool and clock,
+ * so renders can happen on any thread, and never touch the main chain.
+ * Events scheduled on the main chain do not reach the sub-chain.
+ *
+ * Compiled chains can't flatten the sub-chain,
+ * so we report no inputs and are meta processed as a whole.
+ */
+class FreezeModule : public AudioModule {
+
+    public:
+
+        FreezeModule() = default;
+
+        /**
+         * @brief Construct a new FreezeModule object
+         *
+         * @param length Number of frames to render
+         */
+        explicit FreezeModule(int length) { this->set_length(length); }
+
+        /// Destructor, waits for any render in progress
+        ~FreezeModule() override;
+
+        /// Freeze modules can't be copied
+        FreezeModule(const FreezeModule&) = delete;
+
+        /// Freeze modules can't be copied
+        FreezeModule& operator=(const FreezeModule&) = delete;
+
+        /**
+         * @brief Plays back the next block from the cache
+         *
+         * If the cache is missing or invalid, we render it first
+         * (or ask the worker to, if we render in the background).
+         */
+        void meta_process() override;
+
+        /**
+         * @brief Syncs the sub-chain behind us
+         *
+         * We configure our private ChainInfo using our info,
+         * and point every module behind us at it.
+         */
+        void meta_info_sync() override;
+
+        /**
+         * @brief Renders the cache before real-time processing
+         *
+         * Otherwise, the cache would be rendered on our first block.
+         */
+        void prepare() override;
+
+        /**
+         * @brief Waits for any render in progress, and then stops the modules behind us
+         */
+        void meta_stop() override;
+
+        /**
+         * @brief Reports the modules that must be processed before us
+         *
+         * The sub-chain is only processed when rendering,
+         * so we report nothing and ask to be meta processed.
+         *
+         * @param inputs Vector to add modules to
+         * @return false Always
+         */
+        bool plan_inputs(std::vector<AudioModule*>& inputs) override;
+
+        /**
+         * @brief Renders the cache now, on the calling thread
+         *
+         * This can be used to freeze a chain before it is played,
+         * instead of on the first block.
+         * Any render in progress is waited for first.
+         */
+        void freeze();
+
+        /**
+         * @brief Discards the cache
+         *
+         * The cache will be rendered again when we are next processed.
+         */
+        void invalidate() { this->valid = false; }
+
+        /**
+         * @brief Determines if the cache is ready to be played
+         *
+         * @return true If the cache is valid
+         * @return false If the cache must be rendered
+         */
+        bool frozen() const { return this->valid && this->cache != nullptr; }
+
+        /**
+         * @brief Determines if the worker is rendering the cache
+         *
+         * @return true If a render is in progress
+         * @return false If not
+         */
+        bool rendering() const { return this->busy.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Watches a parameter for changes
+         *
+         * The cache is rendered again whenever the parameter changes.
+         *
+         * @param param Parameter to watch
+         */
+        void watch(ModuleParam* param);
+
+        /**
+         * @brief Sets the number of frames to render
+         *
+         * This invalidates the cache.
+         *
+         * @param frames Frames to render, at least one
+         */
+        void set_length(int frames);
+
+        /**
+         * @brief Gets the number of frames we render
+         *
+         * @return int Frames to render
+         */
+        int get_length() const { return this->length; }
+
+        /**
+         * @brief Sets if the cache is looped
+         *
+         * If not, we output silence once the cache has been played.
+         *
+         * @param val true to loop, false to play once
+         */
+        void set_loop(bool val) { this->loop = val; }
+
+        /**
+         * @brief Determines if the cache is looped
+         *
+         * @return true If we loop
+         * @return false If we play once
+         */
+        bool get_loop() const { return this->loop; }
+
+        /**
+         * @brief Sets if the cache is rendered in the background
+         *
+         * @param val true to render on a worker thread, false to render on the calling thread
+         */
+        void set_background(bool val) { this->background = val; }
+
+        /**
+         * @brief Determines if the cache is rendered in the background
+         *
+         * @return true If we render on a worker thread
+         * @return false If we render on the calling thread
+         */
+        bool get_background() const { return this->background; }
+
+        /**
+         * @brief Moves playback to a frame of the cache
+         *
+         * @param frame Frame to play next
+         */
+        void seek(int frame) { this->position = std::max(frame, 0); }
+
+        /**
+         * @brief Gets the next frame of the cache we will play
+         *
+         * @return int Frame played next
+         */
+        int tell() const { return this->position; }
+
+        /**
+         * @brief Gets the number of times we have rendered the cache
+         *
+         * @return uint64_t Number of renders
+         */
+        uint64_t get_renders() const { return this->renders; }
+
+        /**
+         * @brief Gets the ChainInfo used by the sub-chain
+         *
+         * @return ChainInfo* ChainInfo of the modules behind us
+         */
+        ChainInfo* get_freeze_chain() { return &(this->freeze_chain); }
+
+    private:
+
+        /**
+         * @brief Renders the sub-chain into a new cache
+         *
+         * @return BufferPointer Rendered cache
+         */
+        BufferPointer render();
+
+        /**
+         * @brief Renders in the background
+         *
+         * Any previous worker is joined first.
+         */
+        void render_async();
+
+        /**
+         * @brief Waits for the worker to finish, and collects its cache
+         */
+        void join();
+
+        /**
+         * @brief Determines if a watched parameter has changed
+         *
+         * We record the current versions of the parameters.
+         *
+         * @return true If a parameter changed
+         * @return false If nothing changed
+         */
+        bool params_changed();
+
+        /// A parameter we watch
+        struct Watch {
+
+            /// Parameter to watch
+            ModuleParam* param = nullptr;
+
+            /// Version of the parameter when we last rendered
+            uint64_t version = 0;
+        };
+
+        /// ChainInfo used by the modules behind us
+        ChainInfo freeze_chain;
+
+        /// Rendered cache, nullptr if nothing has been rendered
+        BufferPointer cache = nullptr;
+
+        /// Cache rendered by the worker
+        BufferPointer pending = nullptr;
+
+        /// Parameters we watch
+        std::vector<Watch> watched;
+
+        /// Worker thread rendering in the background
+        std::thread worker;
+
+        /// Determines if the worker is rendering
+        std::atomic<bool> busy{false};
+
+        /// Number of frames to render
+        int length = BUFF_SIZE;
+
+        /// Next frame of the cache to play
+        int position = 0;
+
+        /// Number of renders
+        uint64_t renders = 0;
+
+        /// Determines if the cache is valid
+        bool valid = false;
+
+        /// Determines if we loop the cache
+        bool loop = true;
+
+        /// Determines if we render in the background
+        bool background = false;
+};
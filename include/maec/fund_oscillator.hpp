@@ -10,11 +10,18 @@
  * Various fundamental oscillators are defined here.
  * These oscillators can be used to create more complex waveforms.
  * We contain sine, square, saw, triangle, and sawtooth oscillators.
+ *
+ * The naive oscillators compute each waveform directly,
+ * which aliases for any waveform with harmonics above the Nyquist frequency.
+ * The wavetable oscillators read band-limited tables instead (see dsp/wavetable.hpp),
+ * which are clean at a similar cost.
  */
 
 #pragma once
 
 #include "base_oscillator.hpp"
+#include "dsp/osc.hpp"
+#include "dsp/wavetable.hpp"
 
 /**
  * @brief Sine wave oscillator
@@ -37,6 +44,22 @@ class SineOscillator : public BaseOscillator {
          * the sine wave.
          */
         void process() override;
+        /**
+         * @brief Generates the next sample of a fused block
+         * 
+         * @return sample_t Next sample
+         */
+        sample_t fused_tick(sample_t /*input*/) { return sine_turns<sample_t>(static_cast<sample_t>(this->fused_turn())); }
+
+        /**
+         * @brief Generates a fused block of a known size
+         *
+         * @tparam N Number of samples in the block
+         * @param data Block to fill
+         */
+        template <std::size_t N>
+        void fused_block(std::span<sample_t, N> data) {
+            this->fused_fill(data, 0, [](double turn) { return sine_turns<sample_t>(static_cast<sample_t>(turn)); }); }
 };
 
 /**
@@ -59,6 +82,22 @@ class SquareOscillator : public BaseOscillator {
          * the square wave.
          */
         void process() override;
+        /**
+         * @brief Generates the next sample of a fused block
+         * 
+         * @return sample_t Next sample
+         */
+        sample_t fused_tick(sample_t /*input*/) { return this->fused_turn() < 0.5 ? sample_t(1) : sample_t(-1); }
+
+        /**
+         * @brief Generates a fused block of a known size
+         *
+         * @tparam N Number of samples in the block
+         * @param data Block to fill
+         */
+        template <std::size_t N>
+        void fused_block(std::span<sample_t, N> data) {
+            this->fused_fill(data, 0, [](double turn) { return turn < 0.5 ? sample_t(1) : sample_t(-1); }); }
 };
 
 /**
@@ -81,6 +120,22 @@ class SawtoothOscillator : public BaseOscillator {
          * the sawtooth wave.
          */
         void process() override;
+        /**
+         * @brief Generates the next sample of a fused block
+         * 
+         * @return sample_t Next sample
+         */
+        sample_t fused_tick(sample_t /*input*/) { return static_cast<sample_t>(2.0 * this->fused_turn(0.5) - 1.0); }
+
+        /**
+         * @brief Generates a fused block of a known size
+         *
+         * @tparam N Number of samples in the block
+         * @param data Block to fill
+         */
+        template <std::size_t N>
+        void fused_block(std::span<sample_t, N> data) {
+            this->fused_fill(data, 0.5, [](double turn) { return static_cast<sample_t>(2.0 * turn - 1.0); }); }
 };
 
 /**
@@ -103,6 +158,22 @@ class TriangleOscillator : public BaseOscillator {
          * the triangle wave.
          */
         void process() override;
+        /**
+         * @brief Generates the next sample of a fused block
+         * 
+         * @return sample_t Next sample
+         */
+        sample_t fused_tick(sample_t /*input*/) { return static_cast<sample_t>(1.0 - 4.0 * std::fabs(this->fused_turn(0.25) - 0.5)); }
+
+        /**
+         * @brief Generates a fused block of a known size
+         *
+         * @tparam N Number of samples in the block
+         * @param data Block to fill
+         */
+        template <std::size_t N>
+        void fused_block(std::span<sample_t, N> data) {
+            this->fused_fill(data, 0.25, [](double turn) { return static_cast<sample_t>(1.0 - 4.0 * std::fabs(turn - 0.5)); }); }
 };
 
 /**
@@ -197,3 +268,229 @@ public:
      */
     void process() override;
 };
+
+/**
+ * @brief Band-limited oscillator that reads from wavetables
+ *
+ * We generate any of the fundamental waveforms (see Waveform)
+ * without aliasing, by reading from a band-limited wavetable.
+ * The level of the table is picked by our frequency,
+ * so harmonics always stop below the Nyquist frequency.
+ *
+ * Tables are shared by every oscillator in the process,
+ * and are fetched when the waveform is set,
+ * so the first oscillator of each waveform pays for building the table.
+ * Processing never allocates.
+ */
+class WavetableOscillator : public BaseOscillator {
+
+    private:
+
+        /// Waveform we generate
+        Waveform type = Waveform::Sawtooth;
+
+        /// Table we read from
+        const Wavetable<sample_t>* table = &wavetable<sample_t>(Waveform::Sawtooth);
+
+    public:
+
+        WavetableOscillator() =default;
+
+        /**
+         * @brief Construct a new Wavetable Oscillator object
+         *
+         * @param type Waveform to generate
+         * @param freq Frequency of the oscillator
+         */
+        WavetableOscillator(Waveform type, double freq) : BaseOscillator(static_cast<sample_t>(freq)) { this->set_waveform(type); }
+
+        /**
+         * @brief Process the oscillator
+         *
+         * We fill a new buffer from the table level for our frequency.
+         */
+        void process() override;
+
+        /**
+         * @brief Sets the waveform to generate
+         *
+         * This may build the shared table, so avoid calling this in a real-time context
+         * the first time a waveform is used.
+         *
+         * @param ntype Waveform to generate
+         */
+        void set_waveform(Waveform ntype) {
+
+            this->type = ntype;
+            this->table = &wavetable<sample_t>(ntype);
+        }
+
+        /**
+         * @brief Gets the waveform we generate
+         *
+         * @return Waveform Current waveform
+         */
+        Waveform get_waveform() const { return this->type; }
+};
+
+/**
+ * @brief Modulated band-limited oscillator that reads from wavetables
+ *
+ * This is the WavetableOscillator, but it can have it's frequency modulated.
+ * When the frequency changes during a block,
+ * the table level is picked for each sample.
+ */
+class ModWavetableOscillator : public BaseModulatedOscillator {
+
+    private:
+
+        /// Waveform we generate
+        Waveform type = Waveform::Sawtooth;
+
+        /// Table we read from
+        const Wavetable<sample_t>* table = &wavetable<sample_t>(Waveform::Sawtooth);
+
+    public:
+
+        ModWavetableOscillator() =default;
+
+        /**
+         * @brief Construct a new Mod Wavetable Oscillator object
+         *
+         * @param type Waveform to generate
+         * @param freq Frequency of the oscillator
+         */
+        ModWavetableOscillator(Waveform type, sample_t freq) : BaseModulatedOscillator(freq) { this->set_waveform(type); }
+
+        /**
+         * @brief Process the oscillator
+         *
+         * This method will process the oscillator.
+         * It will create a new buffer and fill it with
+         * the band-limited waveform.
+         */
+        void process() override;
+
+        /**
+         * @brief Sets the waveform to generate
+         *
+         * This may build the shared table, so avoid calling this in a real-time context
+         * the first time a waveform is used.
+         *
+         * @param ntype Waveform to generate
+         */
+        void set_waveform(Waveform ntype) {
+
+            this->type = ntype;
+            this->table = &wavetable<sample_t>(ntype);
+        }
+
+        /**
+         * @brief Gets the waveform we generate
+         *
+         * @return Waveform Current waveform
+         */
+        Waveform get_waveform() const { return this->type; }
+};
+
+/**
+ * @brief Band-limited oscillator using PolyBLEP corrections
+ *
+ * We generate any of the fundamental waveforms (see Waveform)
+ * with greatly reduced aliasing, by correcting the naive waveform
+ * around each discontinuity (see dsp/blep.hpp).
+ * Sine waves have no discontinuities, so they are left alone.
+ *
+ * This is cheaper than the WavetableOscillator and needs no memory,
+ * but lets a little more aliasing through in the top octave.
+ */
+class BLEPOscillator : public BaseOscillator {
+
+    private:
+
+        /// Waveform we generate
+        Waveform type = Waveform::Sawtooth;
+
+    public:
+
+        BLEPOscillator() =default;
+
+        /**
+         * @brief Construct a new BLEP Oscillator object
+         *
+         * @param type Waveform to generate
+         * @param freq Frequency of the oscillator
+         */
+        BLEPOscillator(Waveform type, double freq) : BaseOscillator(static_cast<sample_t>(freq)), type(type) {}
+
+        /**
+         * @brief Process the oscillator
+         *
+         * We fill a new buffer with the corrected waveform.
+         */
+        void process() override;
+
+        /**
+         * @brief Sets the waveform to generate
+         *
+         * @param ntype Waveform to generate
+         */
+        void set_waveform(Waveform ntype) { this->type = ntype; }
+
+        /**
+         * @brief Gets the waveform we generate
+         *
+         * @return Waveform Current waveform
+         */
+        Waveform get_waveform() const { return this->type; }
+};
+
+/**
+ * @brief Modulated band-limited oscillator using PolyBLEP corrections
+ *
+ * This is the BLEPOscillator, but it can have it's frequency modulated.
+ * When the frequency changes during a block,
+ * the width of the corrections follows it for each sample.
+ */
+class ModBLEPOscillator : public BaseModulatedOscillator {
+
+    private:
+
+        /// Waveform we generate
+        Waveform type = Waveform::Sawtooth;
+
+    public:
+
+        ModBLEPOscillator() =default;
+
+        /**
+         * @brief Construct a new Mod BLEP Oscillator object
+         *
+         * @param type Waveform to generate
+         * @param freq Frequency of the oscillator
+         */
+        ModBLEPOscillator(Waveform type, sample_t freq) : BaseModulatedOscillator(freq), type(type) {}
+
+        /**
+         * @brief Process the oscillator
+         *
+         * This method will process the oscillator.
+         * It will create a new buffer and fill it with
+         * the band-limited waveform.
+         */
+        void process() override;
+
+        /**
+         * @brief Sets the waveform to generate
+         *
+         * @param ntype Waveform to generate
+         */
+        void set_waveform(Waveform ntype) { this->type = ntype; }
+
+        /**
+         * @brief Gets the waveform we generate
+         *
+         * @return Waveform Current waveform
+         */
+        Waveform get_waveform() const { return this->type; }
+};
@@ -0,0 +1,280 @@
+/**
+ * @file granular.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief A source that plays grains of a cached sample
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Granular synthesis builds a sound out of many short, overlapping slices of a sample,
+ * often thousands every second.
+ * The WaveSource and SampleSource can only play a sample from start to end,
+ * and starting a source for each grain would cost far too much.
+ *
+ * The GranularSource plays grains straight from the decoded frames of a sample
+ * held by the SampleCache, so every grain (and every source) shares one copy of the audio.
+ * Each grain is a windowed copy of the sample, which is added into the output
+ * with a single vectorized kernel (see mix_window_add() in dsp/mix.hpp).
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dsp/window.hpp"
+#include "io/sample_cache.hpp"
+#include "source_module.hpp"
+
+/**
+ * @brief Plays grains of a sample from a SampleCache
+ *
+ * Grains are started at a fixed rate (see set_density()),
+ * each one playing get_grain_length() frames of the sample from around the position.
+ * The start of each grain is moved by a random amount up to the spread,
+ * which blurs the texture of the sound.
+ * Grains play at the rate of the sample, and are shaped by a window (Hann by default).
+ *
+ * Only the decoded frames of the sample are used,
+ * so large samples that are streamed only offer their attack.
+ * The threshold of the cache should be raised for samples played as grains (see SampleCache::set_threshold()).
+ *
+ * The window is tiled across the channels of the sample when we are started,
+ * and the grain pool is allocated up front.
+ * If every grain in the pool is playing, new grains are dropped and counted.
+ * Processing is allocation-free.
+ */
+class GranularSource : public SourceModule {
+
+    public:
+
+        /**
+         * @brief Construct a new GranularSource object
+         *
+         * @param samples Cache to fetch samples from
+         * @param file Path to the wave file to play
+         */
+        GranularSource(SampleCache& samples, std::string file) : cache(&samples), path(std::move(file)) {}
+
+        /**
+         * @brief Adds the grains playing in the next block
+         */
+        void process() override;
+
+        /**
+         * @brief Fetches the sample, and prepares the window and grain pool
+         */
+        void start() override;
+
+        /**
+         * @brief Releases the sample, and stops every grain
+         */
+        void stop() override;
+
+        /**
+         * @brief Adds the memory held by this source
+         *
+         * We count the decoded frames of the sample, the window and the grain pool.
+         * Samples are shared through the cache, so every source playing a sample counts it.
+         *
+         * @param usage Footprint to add to
+         */
+        void footprint(MemoryFootprint& usage) const override;
+
+        /**
+         * @brief Sets the path of the sample to play
+         *
+         * This takes effect when we are next started.
+         *
+         * @param file Path to the wave file
+         */
+        void set_path(const std::string& file) { this->path = file; }
+
+        /**
+         * @brief Gets the sample we are playing
+         *
+         * @return const CachedSample* Sample, or nullptr if not started
+         */
+        const CachedSample* get_sample() const { return this->sample.get(); }
+
+        /**
+         * @brief Sets the number of grains started every second
+         *
+         * @param num Grains per second, 0 stops starting grains
+         */
+        void set_density(double num) { this->density = std::max(num, 0.0); }
+
+        /**
+         * @brief Gets the number of grains started every second
+         *
+         * @return double Grains per second
+         */
+        double get_density() const { return this->density; }
+
+        /**
+         * @brief Sets the length of each grain
+         *
+         * This takes effect when we are next started.
+         *
+         * @param frames Length in frames
+         */
+        void set_grain_length(int frames) { this->length = std::max(frames, 1); }
+
+        /**
+         * @brief Gets the length of each grain
+         *
+         * @return int Length in frames
+         */
+        int get_grain_length() const { return this->length; }
+
+        /**
+         * @brief Sets the window that shapes each grain
+         *
+         * This takes effect when we are next started.
+         *
+         * @param type Type of window
+         */
+        void set_window(WindowType type) { this->window = type; }
+
+        /**
+         * @brief Sets the frame grains are started around
+         *
+         * This may be changed while playing to scan through the sample.
+         *
+         * @param frame Frame in the sample
+         */
+        void set_position(int64_t frame) { this->position = frame; }
+
+        /**
+         * @brief Gets the frame grains are started around
+         *
+         * @return int64_t Frame in the sample
+         */
+        int64_t get_position() const { return this->position; }
+
+        /**
+         * @brief Sets the largest random offset of the start of each grain
+         *
+         * @param frames Offset in frames
+         */
+        void set_spread(int64_t frames) { this->spread = std::max<int64_t>(frames, 0); }
+
+        /**
+         * @brief Sets the gain of each grain
+         *
+         * @param value Gain to apply
+         */
+        void set_gain(double value) { this->gain = value; }
+
+        /**
+         * @brief Sets the number of grains that may play at once
+         *
+         * This takes effect when we are next started.
+         *
+         * @param num Number of grains
+         */
+        void set_max_grains(int num) { this->max_grains = std::max(num, 1); }
+
+        /**
+         * @brief Sets the seed of the random offsets
+         *
+         * @param value Seed, 0 is replaced with 1
+         */
+        void set_seed(uint32_t value) { this->seed = value != 0 ? value : 1; }
+
+        /**
+         * @brief Gets the number of grains playing
+         *
+         * @return int Number of grains
+         */
+        int get_active() const { return static_cast<int>(this->grains.size()); }
+
+        /**
+         * @brief Gets the number of grains dropped because the pool was full
+         *
+         * @return uint64_t Number of grains
+         */
+        uint64_t get_dropped() const { return this->dropped; }
+
+    private:
+
+        /// A grain that is playing
+        struct Grain {
+
+            /// First frame of the grain in the sample
+            int64_t start = 0;
+
+            /// Number of frames played
+            int offset = 0;
+
+            /// Frame of the current block to start on
+            int delay = 0;
+        };
+
+        /**
+         * @brief Starts a new grain
+         *
+         * @param delay Frame of the current block to start on
+         */
+        void spawn(int delay);
+
+        /**
+         * @brief Generates the next random value
+         *
+         * @return uint32_t Random value
+         */
+        uint32_t random();
+
+        /// Cache to fetch samples from
+        SampleCache* cache = nullptr;
+
+        /// Path to the sample
+        std::string path;
+
+        /// Sample we are playing
+        std::shared_ptr<const CachedSample> sample;
+
+        /// Window of a grain, with each coefficient repeated for every channel
+        std::vector<sample_t> envelope;
+
+        /// Grains that are playing
+        std::vector<Grain> grains;
+
+        /// Interleaved frames when buffers are planar
+        std::vector<sample_t> frames;
+
+        /// Number of grains started every second
+        double density = 100;
+
+        /// Frames until the next grain starts
+        double countdown = 0;
+
+        /// Length of each grain in frames
+        int length = 2048;
+
+        /// Window that shapes each grain
+        WindowType window = WindowType::Hann;
+
+        /// Frame grains are started around
+        int64_t position = 0;
+
+        /// Largest random offset of each grain
+        int64_t spread = 0;
+
+        /// Gain of each grain
+        double gain = 1;
+
+        /// Number of grains that may play at once
+        int max_grains = 256;
+
+        /// State of the random generator
+        uint32_t seed = 1;
+
+        /// Number of grains dropped
+        uint64_t dropped = 0;
+};
@@ -0,0 +1,304 @@
+/**
+ * @file hot_swap.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief A module that swaps the chain behind it while running
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Binding modules changes their backward and forward pointers in place,
+ * so a chain must be stopped before it can be changed.
+ * Live performance can't afford to stop, so we need another way to edit a patch.
+ *
+ * The HotSwap module uses a read-copy-update scheme:
+ * a new patch is built, synced and started on a non real-time thread,
+ * and then handed to the module with a single atomic store.
+ * The audio thread picks it up at the start of the next block,
+ * and hands the old patch back to be stopped and freed on a non real-time thread.
+ * The audio thread never waits, locks, allocates or frees while doing so.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "audio_module.hpp"
+
+class HotSwap;
+
+/**
+ * @brief A collection of modules that can be swapped into a chain
+ *
+ * A patch owns its modules, and names the module that outputs the patch.
+ * The modules are bound to each other as usual,
+ * but the output module is not bound to anything in front of it,
+ * as the HotSwap module does this when the patch is submitted.
+ *
+ * Each patch gets its own ChainInfo, with its own buffer pool and clock,
+ * so it can be prepared without touching the running chain.
+ * Events scheduled on the main chain do not reach the patch.
+ */
+class Patch {
+
+    public:
+
+        Patch() =default;
+
+        /// Patches can't be copied
+        Patch(const Patch&) = delete;
+
+        /// Patches can't be copied
+        Patch& operator=(const Patch&) = delete;
+
+        /**
+         * @brief Creates a module owned by this patch
+         *
+         * @tparam M Type of module to create
+         * @tparam Args Types of the constructor arguments
+         * @param args Arguments to pass to the constructor
+         * @return M* Pointer to the new module
+         */
+        template <typename M, typename... Args>
+        M* add(Args&&... args) {
+
+            auto mod = std::make_unique<M>(std::forward<Args>(args)...);
+
+            M* out = mod.get();
+
+            this->modules.push_back(std::move(mod));
+
+            return out;
+        }
+
+        /**
+         * @brief Takes ownership of a module
+         *
+         * @param mod Module to own
+         * @return AudioModule* Pointer to the module
+         */
+        AudioModule* adopt(std::unique_ptr<AudioModule> mod);
+
+        /**
+         * @brief Sets the module that outputs this patch
+         *
+         * @param mod Output module, should be owned by this patch
+         */
+        void set_output(AudioModule* mod) { this->output = mod; }
+
+        /**
+         * @brief Gets the module that outputs this patch
+         *
+         * @return AudioModule* Output module
+         */
+        AudioModule* get_output() const { return this->output; }
+
+        /**
+         * @brief Gets the ChainInfo used by this patch
+         *
+         * @return ChainInfo* ChainInfo of the modules in this patch
+         */
+        ChainInfo* get_chain() { return &(this->chain); }
+
+        /**
+         * @brief Gets the number of modules we own
+         *
+         * @return std::size_t Number of modules
+         */
+        std::size_t size() const { return this->modules.size(); }
+
+    private:
+
+        friend class HotSwap;
+
+        /// Modules owned by this patch
+        std::vector<std::unique_ptr<AudioModule>> modules;
+
+        /// Module that outputs this patch
+        AudioModule* output = nullptr;
+
+        /// ChainInfo used by the modules in this patch
+        ChainInfo chain;
+
+        /// Next patch waiting to be collected
+        Patch* next = nullptr;
+};
+
+/**
+ * @brief Outputs a patch that can be replaced while the chain is running
+ *
+ * New patches are given to submit() on a non real-time thread.
+ * The patch is prepared there: pointed at its ChainInfo, synced to our format and started.
+ * It then waits until the start of our next block, where the audio thread swaps it in.
+ * If several patches are submitted in the same block, only the last one is used.
+ *
+ * The old patch is placed on a retired list, and must be freed by calling collect()
+ * on a non real-time thread, for example after each submit or from a timer.
+ * Retired patches are stopped right before they are freed.
+ *
+ * By default, we crossfade from the old patch to the new one over the block where the swap happens,
+ * so the swap is free of clicks. Both patches are processed during this block.
+ *
+ * Buffers made by the patch are handed downstream as is,
+ * and buffers from the main pool are traded back to the patch pool, one for one,
+ * so neither pool allocates in the steady state.
+ * Each patch pool is primed with one buffer per module when it is submitted.
+ *
+ * If no patch is present, we output silence.
+ *
+ * Compiled chains can't flatten the patch,
+ * so we report no inputs and are meta processed as a whole.
+ */
+class HotSwap : public AudioModule {
+
+    public:
+
+        HotSwap() =default;
+
+        /// Destructor, stops and frees all patches
+        ~HotSwap() override;
+
+        /// Swaps can't be copied
+        HotSwap(const HotSwap&) = delete;
+
+        /// Swaps can't be copied
+        HotSwap& operator=(const HotSwap&) = delete;
+
+        /**
+         * @brief Swaps in any pending patch, and processes the current patch
+         *
+         * This is safe to call on the audio thread,
+         * as swapping only exchanges pointers.
+         */
+        void meta_process() override;
+
+        /**
+         * @brief Syncs ourselves and the current patch
+         *
+         * Like the other meta methods, this must not run alongside meta_process().
+         */
+        void meta_info_sync() override;
+
+        /**
+         * @brief Starts ourselves and the current patch
+         */
+        void meta_start() override;
+
+        /**
+         * @brief Stops ourselves and the current patch
+         */
+        void meta_stop() override;
+
+        /**
+         * @brief Finishes ourselves and the current patch
+         */
+        void meta_finish() override;
+
+        /**
+         * @brief Reports the modules that must be processed before us
+         *
+         * Patches can be swapped at any time,
+         * so we report nothing and ask to be meta processed.
+         *
+         * @param inputs Vector to add modules to
+         * @return false Always
+         */
+        bool plan_inputs(std::vector<AudioModule*>& inputs) override;
+
+        /**
+         * @brief Prepares a patch and queues it to be swapped in
+         *
+         * This must be called on a non real-time thread,
+         * as the patch is synced and started here.
+         * Calls to submit() must not run alongside each other.
+         *
+         * If a patch was submitted but not yet swapped in, it is freed.
+         *
+         * @param patch Patch to swap in, or nullptr to swap in silence
+         */
+        void submit(std::unique_ptr<Patch> patch);
+
+        /**
+         * @brief Stops and frees all retired patches
+         *
+         * This must be called on a non real-time thread.
+         *
+         * @return int Number of patches freed
+         */
+        int collect();
+
+        /**
+         * @brief Determines if a patch is waiting to be swapped in
+         *
+         * @return true If a submitted patch has not been picked up yet
+         * @return false If the last submitted patch is in use
+         */
+        bool pending() const { return this->next.load(std::memory_order_acquire) != nullptr; }
+
+        /**
+         * @brief Gets the number of swaps that have happened
+         *
+         * @return uint64_t Number of patches swapped in
+         */
+        uint64_t swaps() const { return this->swapped.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Sets if we crossfade between patches
+         *
+         * @param enable true to crossfade over one block, false to cut
+         */
+        void set_crossfade(bool enable) { this->crossfade = enable; }
+
+        /**
+         * @brief Determines if we crossfade between patches
+         *
+         * @return true If we crossfade over one block
+         * @return false If we cut between patches
+         */
+        bool get_crossfade() const { return this->crossfade; }
+
+    private:
+
+        /**
+         * @brief Points a patch at its ChainInfo, and syncs it to our format
+         *
+         * @param patch Patch to configure
+         */
+        void configure(Patch& patch);
+
+        /**
+         * @brief Renders a block of a patch
+         *
+         * A buffer from our pool is traded to the patch pool.
+         *
+         * @param patch Patch to render
+         * @return BufferPointer Buffer made by the patch
+         */
+        BufferPointer render_patch(Patch& patch);
+
+        /**
+         * @brief Stops and frees a patch
+         *
+         * @param patch Patch to free
+         */
+        static void dispose(Patch* patch);
+
+        /// Patch being output, only touched by the audio thread once started
+        Patch* current = nullptr;
+
+        /// Patch waiting to be swapped in
+        std::atomic<Patch*> next{nullptr};
+
+        /// Patches waiting to be collected
+        std::atomic<Patch*> retired{nullptr};
+
+        /// Number of swaps that have happened
+        std::atomic<uint64_t> swapped{0};
+
+        /// Determines if we crossfade between patches
+        bool crossfade = true;
+};
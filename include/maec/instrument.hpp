@@ -0,0 +1,347 @@
+/**
+ * @file instrument.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Components for measuring the cost of modules
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Large chains can contain hundreds of modules,
+ * and when a chain misses its deadline it can be hard to tell which one is to blame.
+ * Modules can be instrumented (see AudioModule::set_instrumented()),
+ * in which case each call to process() is timed,
+ * and the allocations and buffer sizes are recorded.
+ * instrument_chain() instruments every module in a chain,
+ * and chain_report() collects the measurements into a report.
+ *
+ * Instrumentation is opt-in, modules that are not instrumented
+ * pay only for a single pointer check.
+ *
+ * The memory a chain holds can be measured as well.
+ * Each module reports what it holds (see AudioModule::footprint()),
+ * and chain_footprint() collects the amounts into a report,
+ * which a sink can check against a budget when the chain is started
+ * (see ChainInfo::memory_budget).
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class AudioModule;
+
+/// Number of buckets in a process time histogram
+constexpr int PROFILE_BUCKETS = 32;
+
+/**
+ * @brief Measurements of a single module
+ *
+ * Times are in nanoseconds.
+ * Bucket n of the histogram counts calls that took
+ * at least 2^n nanoseconds, but less than 2^(n+1).
+ * The first bucket also counts calls that took less than 1 nanosecond.
+ */
+struct ModuleReport {
+
+    /// Module that was measured
+    const AudioModule* module = nullptr;
+
+    /// Name of the type of the module
+    std::string type;
+
+    /// Number of times process() was called
+    uint64_t calls = 0;
+
+    /// Total time spent in process()
+    int64_t total_time = 0;
+
+    /// Longest time spent in a single call
+    int64_t max_time = 0;
+
+    /// Number of allocations made while processing
+    uint64_t allocations = 0;
+
+    /// Number of bytes allocated while processing
+    uint64_t allocated_bytes = 0;
+
+    /// Total size of the buffers produced, in bytes
+    uint64_t buffer_bytes = 0;
+
+    /// Histogram of process times
+    std::array<uint64_t, PROFILE_BUCKETS> histogram = {};
+
+    /**
+     * @brief Gets the mean time spent in process()
+     *
+     * @return double Mean time in nanoseconds
+     */
+    double mean_time() const { return this->calls > 0 ? static_cast<double>(this->total_time) / static_cast<double>(this->calls) : 0; }
+
+    /**
+     * @brief Estimates a percentile of the process time
+     *
+     * We return the upper edge of the bucket the percentile falls in,
+     * so the true value is at most this.
+     *
+     * @param frac Percentile as a fraction, such as 0.99
+     * @return int64_t Process time in nanoseconds
+     */
+    int64_t percentile(double frac) const;
+};
+
+/**
+ * @brief Lock-free recorder of module measurements
+ *
+ * All counters are atomic and updated with relaxed ordering,
+ * so any thread may record (for example, executor workers)
+ * and another thread may read a report at any time without blocking either.
+ * Recording never allocates.
+ */
+class ModuleProfile {
+
+    public:
+
+        /**
+         * @brief Records a call to process()
+         *
+         * @param time Time spent in nanoseconds
+         * @param allocs Number of allocations made
+         * @param bytes Number of bytes allocated
+         * @param buffer Size of the buffer produced in bytes
+         */
+        void record(int64_t time, uint64_t allocs, uint64_t bytes, uint64_t buffer);
+
+        /**
+         * @brief Gets the measurements made so far
+         *
+         * The module and type in the report are not filled in.
+         *
+         * @return ModuleReport Measurements made so far
+         */
+        ModuleReport report() const;
+
+        /**
+         * @brief Clears all measurements
+         *
+         */
+        void reset();
+
+        /**
+         * @brief Determines the histogram bucket of a time
+         *
+         * @param time Time in nanoseconds
+         * @return int Bucket the time belongs to
+         */
+        static int bucket(int64_t time);
+
+    private:
+
+        /// Number of calls
+        std::atomic<uint64_t> calls{0};
+
+        /// Total time
+        std::atomic<int64_t> total{0};
+
+        /// Longest call
+        std::atomic<int64_t> longest{0};
+
+        /// Number of allocations
+        std::atomic<uint64_t> allocations{0};
+
+        /// Number of bytes allocated
+        std::atomic<uint64_t> allocated{0};
+
+        /// Total buffer size
+        std::atomic<uint64_t> buffer{0};
+
+        /// Histogram of process times
+        std::array<std::atomic<uint64_t>, PROFILE_BUCKETS> histogram{};
+};
+
+/**
+ * @brief Measurements of every instrumented module in a chain
+ *
+ * Modules are listed in the order they are processed,
+ * sources first and the sink last.
+ */
+struct ChainReport {
+
+    /// Measurements of each module
+    std::vector<ModuleReport> modules;
+
+    /**
+     * @brief Gets the total time spent by all modules
+     *
+     * @return int64_t Total time in nanoseconds
+     */
+    int64_t total_time() const;
+
+    /**
+     * @brief Gets the module that spent the most time
+     *
+     * @return const ModuleReport* Slowest module, nullptr if there are none
+     */
+    const ModuleReport* slowest() const;
+
+    /**
+     * @brief Formats the report as a table
+     *
+     * We output one line per module, with times in microseconds.
+     *
+     * @return std::string Formatted report
+     */
+    std::string format() const;
+};
+
+/**
+ * @brief Finds every module in a chain
+ *
+ * We walk backwards from the given module (usually the sink),
+ * following the inputs of each module (see AudioModule::plan_inputs()),
+ * so mixer inputs and parameters are found too.
+ * Modules are returned in the order they are processed.
+ *
+ * @param mod Last module in the chain
+ * @return std::vector<AudioModule*> Every module in the chain
+ */
+std::vector<AudioModule*> chain_modules(AudioModule* mod);
+
+/**
+ * @brief Instruments every module in a chain
+ *
+ * This should not be called while the chain is being processed.
+ *
+ * @param mod Last module in the chain
+ * @param enable true to instrument, false to remove instrumentation
+ */
+void instrument_chain(AudioModule* mod, bool enable = true);
+
+/**
+ * @brief Collects the measurements of every instrumented module in a chain
+ *
+ * Modules that are not instrumented are skipped.
+ *
+ * @param mod Last module in the chain
+ * @return ChainReport Measurements of the chain
+ */
+ChainReport chain_report(AudioModule* mod);
+
+/**
+ * @brief Memory held by a module, in bytes
+ *
+ * Memory is split by what it is used for.
+ * Kernels and samples may be shared between modules,
+ * in which case each module that holds them counts them,
+ * so the total of a chain is an upper bound.
+ */
+struct MemoryFootprint {
+
+    /// Audio buffers held between blocks
+    std::size_t buffers = 0;
+
+    /// Filter kernels and their spectra
+    std::size_t kernels = 0;
+
+    /// FFT plans, including their twiddles and working memory
+    std::size_t plans = 0;
+
+    /// Decoded frames of cached samples
+    std::size_t samples = 0;
+
+    /// Delay lines, history and other working memory
+    std::size_t state = 0;
+
+    /**
+     * @brief Gets the total memory held
+     *
+     * @return std::size_t Total number of bytes
+     */
+    std::size_t total() const { return this->buffers + this->kernels + this->plans + this->samples + this->state; }
+
+    /**
+     * @brief Adds another footprint to this one
+     *
+     * @param other Footprint to add
+     * @return MemoryFootprint& This footprint
+     */
+    MemoryFootprint& operator+=(const MemoryFootprint& other);
+};
+
+/**
+ * @brief Memory held by a single module
+ */
+struct ModuleFootprint {
+
+    /// Module that was measured
+    const AudioModule* module = nullptr;
+
+    /// Name of the type of the module
+    std::string type;
+
+    /// Memory held by the module
+    MemoryFootprint usage;
+};
+
+/**
+ * @brief Memory held by every module in a chain
+ *
+ * Modules are listed in the order they are processed,
+ * sources first and the sink last.
+ */
+struct FootprintReport {
+
+    /// Memory held by each module
+    std::vector<ModuleFootprint> modules;
+
+    /// Number of bytes held by spare buffers in the chain pool
+    std::size_t pool = 0;
+
+    /**
+     * @brief Gets the memory held by all modules
+     *
+     * @return MemoryFootprint Sum of every module
+     */
+    MemoryFootprint usage() const;
+
+    /**
+     * @brief Gets the total memory held by the chain
+     *
+     * This includes every module and the chain pool.
+     *
+     * @return std::size_t Total number of bytes
+     */
+    std::size_t total() const { return this->usage().total() + this->pool; }
+
+    /**
+     * @brief Gets the module that holds the most memory
+     *
+     * @return const ModuleFootprint* Largest module, nullptr if there are none
+     */
+    const ModuleFootprint* largest() const;
+
+    /**
+     * @brief Formats the report as a table
+     *
+     * We output one line per module, with sizes in KiB,
+     * followed by the chain pool and the total.
+     *
+     * @return std::string Formatted report
+     */
+    std::string format() const;
+};
+
+/**
+ * @brief Measures the memory held by every module in a chain
+ *
+ * This should not be called while the chain is being processed.
+ *
+ * @param mod Last module in the chain
+ * @return FootprintReport Memory held by the chain
+ */
+FootprintReport chain_footprint(AudioModule* mod);
@@ -19,10 +19,21 @@
 #define ALSA_PCM_NEW_HW_PARAMS_API
 #include <alsa/asoundlib.h>
 
+#include <poll.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
+#include "dsp/convert.hpp"
+#include "dsp/ring.hpp"
 #include "sink_module.hpp"
+#include "source_module.hpp"
 
 /**
  * @brief A struct containing info on an ALSA device
@@ -198,6 +209,20 @@ struct DeviceInfo {
      */
     void create_device(void** hint, int id);
 
+    /**
+     * @brief Extracts the hint values for this device
+     *
+     * We only pull the name, description and IO type from the hint,
+     * and do NOT open the device.
+     * This is very cheap compared to create_device(),
+     * and is used when enumerating many devices.
+     * Call update() to query the device parameters.
+     *
+     * @param hint The current device to extract hints from
+     * @param id ID of this device
+     */
+    void read_hint(void** hint, int id);
+
     /**
      * @brief Updates this device info
      * 
@@ -217,6 +242,100 @@ struct DeviceInfo {
     void update();
 };
 
+/**
+ * @brief Cache of enumerated ALSA devices
+ *
+ * Enumerating ALSA devices requires a full parse of the ALSA configuration,
+ * which can take hundreds of milliseconds on systems with many virtual PCMs.
+ * Instead of enumerating on every lookup, we enumerate once
+ * and hold onto the results.
+ *
+ * Enumeration only extracts the hint values of each device.
+ * The device parameters are queried the first time a device is looked up,
+ * and are then cached as well.
+ *
+ * Lookup by id is a simple index, and lookup by name is hashed.
+ * The devices available can change, for example when a USB device is plugged in,
+ * so refresh() can be called to enumerate again.
+ * The cache is populated automatically on first use.
+ *
+ * All operations on this cache are thread safe.
+ */
+class ALSADeviceCache {
+
+   private:
+
+    /// Enumerated devices
+    std::vector<DeviceInfo> devices;
+
+    /// Value determining if each device has been queried
+    std::vector<bool> loaded;
+
+    /// Map of device names to ids
+    std::unordered_map<std::string, int> names;
+
+    /// Value determining if we have enumerated devices
+    bool valid = false;
+
+    /// Mutex protecting the cache
+    mutable std::mutex mutex;
+
+    /**
+     * @brief Enumerates devices if we have not done so already
+     *
+     * The mutex MUST be held when calling this method!
+     */
+    void ensure();
+
+    /**
+     * @brief Gets a device, querying it if necessary
+     *
+     * The mutex MUST be held when calling this method!
+     *
+     * @param index ID of the device
+     * @return DeviceInfo Information about the device
+     */
+    DeviceInfo load(int index);
+
+   public:
+
+    /**
+     * @brief Enumerates all devices again
+     *
+     * Any previously queried device parameters are discarded.
+     */
+    void refresh();
+
+    /**
+     * @brief Gets the number of devices
+     *
+     * @return int Number of devices
+     */
+    int size();
+
+    /**
+     * @brief Gets a device by its id
+     *
+     * If the id is invalid, then the returned device
+     * will have load_fail set.
+     *
+     * @param index ID of the device
+     * @return DeviceInfo Information about the device
+     */
+    DeviceInfo get(int index);
+
+    /**
+     * @brief Gets a device by its name
+     *
+     * If no device has the given name, then the returned device
+     * will have load_fail set.
+     *
+     * @param name Name of the device
+     * @return DeviceInfo Information about the device
+     */
+    DeviceInfo find(const std::string& name);
+};
+
 /**
  * @brief A base class that works with ALSA
  *
@@ -249,6 +368,12 @@ class ALSABase {
     /// Return code of the last write
     int return_code = 0;
 
+    /// Value determining if we use memory mapped access
+    bool mmap = false;
+
+    /// Direction of the PCM device
+    snd_pcm_stream_t stream = SND_PCM_STREAM_PLAYBACK;
+
    public:
     /**
      * @brief Construct a new ALSAModule object
@@ -317,10 +442,26 @@ class ALSABase {
      */
     DeviceInfo get_device() const { return this->device; }
 
+    /**
+     * @brief Gets the device cache shared by all ALSA modules
+     *
+     * @return ALSADeviceCache& Device cache
+     */
+    static ALSADeviceCache& get_cache();
+
+    /**
+     * @brief Enumerates the available devices again
+     *
+     * Devices are enumerated once and cached,
+     * so this should be called if devices are added or removed.
+     */
+    static void refresh_devices() { get_cache().refresh(); }
+
     /**
      * @brief Gets the number of devices we have to work with
      * 
-     * We return the number of devices available for use
+     * We return the number of devices available for use.
+     * This is served from the device cache.
      * 
      * @return int Number of devices available for use
      */
@@ -331,8 +472,8 @@ class ALSABase {
      * 
      * We grab the device at the given id
      * and return it's info.
-     * If this index does not exist, then we do something!!!
-     * TODO: IMPLEMENT THIS!
+     * If this index does not exist, then the returned device
+     * will have load_fail set.
      * 
      * @param index ID of the device
      * @return DeviceInfo Information about retrieved device
@@ -342,11 +483,9 @@ class ALSABase {
     /**
      * @brief Gets a device by it's name
      * 
-     * We search all devices until we find one
-     * that has the given name.
+     * We look up the device with the given name in the device cache.
      * If we are unable to find a device with the given name,
-     * then we DO STUFF.
-     * TODO: Yeah, you know
+     * then the returned device will have load_fail set.
      * 
      * @param name name of the device to get
      * @return DeviceInfo Information about retrieved device
@@ -359,19 +498,51 @@ class ALSABase {
      * We configure the necessary ALSA parameters,
      * and ensure everything is initialized.
      * 
-     * @param sample_rate The sample of the device to open
-     * @param buffer_size The buffer size of the device to open
+     * @param dir Direction of the device to open
+     * @param mode Mode to open the device with, such as SND_PCM_NONBLOCK
      */
-    void alsa_start();
+    void alsa_start(snd_pcm_stream_t dir = SND_PCM_STREAM_PLAYBACK, int mode = 0);
 
     /**
      * @brief Stops the underlying ALSA components
      *
-     * We stop the ALSA components we are using,
-     * and wait for the buffer to empty.
+     * We stop the ALSA components we are using.
+     * Playback devices wait for the buffer to empty,
+     * capture devices discard any pending frames.
      *
      */
     void alsa_stop();
+
+    /**
+     * @brief Determines if we are using memory mapped access
+     *
+     * @return true If memory mapped access is enabled
+     * @return false If we use read/write access
+     */
+    bool get_mmap() const { return this->mmap; }
+
+    /**
+     * @brief Enables or disables memory mapped access
+     *
+     * With memory mapped access, samples are written
+     * directly into the DMA area of the device,
+     * removing a copy for each period.
+     * Not all devices support this!
+     * This MUST be set before the module is started.
+     *
+     * @param val true to enable memory mapped access
+     */
+    void set_mmap(bool val) { this->mmap = val; }
+
+    /**
+     * @brief Gets the size of one sample in the device format
+     *
+     * This is only valid after the device has been started,
+     * as the format is negotiated with the device.
+     *
+     * @return std::size_t Size of one sample in bytes
+     */
+    std::size_t sample_bytes() const { return this->device.format == DeviceInfo::Format::S16 ? sizeof(int16_t) : sizeof(int32_t); }
 };
 
 /**
@@ -389,9 +560,122 @@ class ALSABase {
  * Also, if you allow ALSA to determine default values,
  * then the chain will reflect these values. 
  * 
+ * By default, we write to the device on the same thread
+ * that processes the chain.
+ * This means that any slow module will cause the device to underrun.
+ * If threaded mode is enabled, then we instead place the converted samples
+ * into a lock-free ring buffer, and a dedicated audio thread
+ * drains the ring into the device.
+ * The chain is then free to render ahead of the device,
+ * which absorbs any jitter in processing time.
+ * 
+ * If memory mapped access is enabled (see ALSABase::set_mmap()),
+ * then samples are converted straight into the DMA area of the device,
+ * and in threaded mode the audio thread reads from the ring straight into it.
+ * 
+ * The sample format is negotiated with the device when started,
+ * preferring 32 bit float, then signed 32 bit, then signed 16 bit.
+ * Samples are converted in blocks, and conversion to 16 bits
+ * can optionally be dithered (see set_dither()).
+ * 
+ * The prefill value determines how many device periods
+ * must be buffered before the device is started (or restarted after an underrun).
+ * Higher values trade latency for underrun safety.
+ * 
  */
 class ALSASink : public ALSABase, public PeriodSink {
 
+   private:
+
+    /// Determines if we use a dedicated audio thread
+    bool threaded = false;
+
+    /// Number of device periods to buffer before starting the device
+    int prefill = 2;
+
+    /// Determines if we dither when converting to 16 bits
+    bool dither = false;
+
+    /// Determines if each block is sized to the space available in the device
+    bool adaptive = false;
+
+    /// Dither and noise shaping state
+    Dither ditherer;
+
+    /// Converted samples waiting to be written to the device, in bytes
+    SPSCRing<unsigned char> ring;
+
+    /// Scratch buffer for converted samples, in bytes
+    std::vector<unsigned char> temp;
+
+    /// Scratch buffer for interleaved samples when buffers are planar
+    std::vector<sample_t> frames;
+
+    /// Thread that writes to the device
+    std::thread writer;
+
+    /// Value determining if the audio thread should keep running
+    std::atomic<bool> running{false};
+
+    /// Number of underruns that have occurred
+    std::atomic<int> underruns{0};
+
+    /**
+     * @brief Writes frames to the device, recovering from underruns
+     *
+     * @param data Pointer to interleaved samples in the device format
+     * @param frames Number of frames to write
+     */
+    void write_frames(const void* data, snd_pcm_uframes_t frames);
+
+    /**
+     * @brief Converts samples into the device format
+     *
+     * @param input Pointer to samples to convert
+     * @param output Pointer to destination in the device format
+     * @param num Number of samples to convert
+     */
+    void convert(const sample_t* input, void* output, std::size_t num);
+
+    /// @copydoc convert(const sample_t*, void*, std::size_t)
+    void convert(const int16_t* input, void* output, std::size_t num);
+
+    /**
+     * @brief Sends converted samples in our scratch buffer to the device
+     *
+     * We either write them to the device,
+     * or hand them to the audio thread in threaded mode.
+     *
+     * @param bytes Number of bytes to send
+     * @param frames Number of frames to send
+     */
+    void deliver(std::size_t bytes, snd_pcm_uframes_t frames);
+
+    /**
+     * @brief Writes frames directly into the DMA area of the device
+     *
+     * We wait for room in the device buffer, map it,
+     * and let the given function fill it.
+     * The function is called with a pointer to the mapped area,
+     * the number of frames already written, and the number of frames to fill.
+     * We continue until all frames are written.
+     *
+     * @tparam F Fill function type
+     * @param frames Number of frames to write
+     * @param fill Function that fills the mapped area
+     */
+    template <typename F>
+    void mmap_frames(snd_pcm_uframes_t frames, F fill);
+
+    /**
+     * @brief Main loop of the audio thread
+     *
+     * We wait until the ring has been prefilled,
+     * and then write one period at a time to the device.
+     * The blocking writes pace this thread to the device.
+     */
+    void drain_loop();
+
    public:
     /**
      * @brief Construct a new ALSASink object
@@ -406,15 +690,60 @@ class ALSASink : public ALSABase, public PeriodSink {
      *
      * After grabbing the audio data from the back modules,
      * we send that data to the output ALSA device.
+     * If we are in threaded mode, then the data is placed
+     * in the ring for the audio thread, and we only block
+     * if the ring is full.
      *
      */
     void process() override;
 
+    /**
+     * @brief Sends interleaved samples to the device
+     *
+     * This is what process() does with each block,
+     * and can be used when the device is fed from outside the chain,
+     * such as by a DeviceMixer (see device_mixer.hpp).
+     * Samples are converted to the device format,
+     * and memory mapped and threaded modes are honored.
+     * The module MUST be started.
+     *
+     * @param data Pointer to interleaved samples
+     * @param frames Number of frames to send
+     */
+    void write(const sample_t* data, std::size_t frames);
+
+    /**
+     * @brief Sends signed 16 bit samples to the device
+     *
+     * This is used by fixed point paths (see fixed.hpp),
+     * which bypass the chain and never convert to floating point.
+     * If the device uses 16 bit samples, they are copied straight through,
+     * otherwise they are widened to the device format.
+     * Like process(), memory mapped and threaded modes are honored.
+     * The module MUST be started.
+     *
+     * @param data Pointer to interleaved samples
+     * @param frames Number of frames to send
+     */
+    void write_fixed(const int16_t* data, std::size_t frames);
+
+    /**
+     * @brief Renders and outputs the next block
+     *
+     * In adaptive mode, we first ask the device how many frames it has room for
+     * (using snd_pcm_avail_update()), and render exactly that many,
+     * up to one device period.
+     * Otherwise, we process like any other PeriodSink.
+     */
+    void meta_process() override;
+
     /**
      * @brief Starts this module
      *
      * We simply pass the configuration
-     * info ALSABase for proper ALSA configuration
+     * info ALSABase for proper ALSA configuration.
+     * If we are in threaded mode, then we also allocate the ring
+     * and start the audio thread.
      *
      */
     void start() override;
@@ -422,19 +751,275 @@ class ALSASink : public ALSABase, public PeriodSink {
     /**
      * @brief Stops this module.
      * 
-     * We simply upcall the alsa_stop() method.
+     * We stop the audio thread if it is running,
+     * and then upcall the alsa_stop() method.
      * 
      */
-    void stop() override { this->alsa_stop(); }
+    void stop() override;
 
     /**
      * @brief Preforms an info sync for this module.
      * 
      * We set the necessary period size,
      * and sets the desired buffer size.
+     * In adaptive mode, we also declare one device period
+     * as the largest block the chain may render.
      * 
      */
     void info_sync() override;
+
+    /**
+     * @brief Determines if blocks are sized to the space available in the device
+     *
+     * @return true If adaptive mode is enabled
+     * @return false If every block is the same size
+     */
+    bool get_adaptive() const { return this->adaptive; }
+
+    /**
+     * @brief Enables or disables adaptive mode
+     *
+     * In adaptive mode, each block holds exactly the number of frames
+     * the device can accept (see SinkModule::set_frames()),
+     * rather than half a period.
+     * This only applies when not in threaded mode,
+     * as the audio thread decouples the chain from the device.
+     * This MUST be set before the chain is synced!
+     *
+     * @param val true to enable adaptive mode
+     */
+    void set_adaptive(bool val) { this->adaptive = val; }
+
+    /**
+     * @brief Determines if we are using a dedicated audio thread
+     *
+     * @return true If threaded mode is enabled
+     * @return false If we write on the processing thread
+     */
+    bool get_threaded() const { return this->threaded; }
+
+    /**
+     * @brief Enables or disables threaded mode
+     *
+     * This MUST be set before the module is started!
+     *
+     * @param val true to enable threaded mode
+     */
+    void set_threaded(bool val) { this->threaded = val; }
+
+    /**
+     * @brief Gets the prefill depth
+     *
+     * @return int Number of device periods to buffer before starting
+     */
+    int get_prefill() const { return this->prefill; }
+
+    /**
+     * @brief Sets the prefill depth
+     *
+     * This MUST be set before the module is started!
+     *
+     * @param num Number of device periods to buffer before starting
+     */
+    void set_prefill(int num) { this->prefill = num; }
+
+    /**
+     * @brief Determines if we dither when converting to 16 bits
+     *
+     * @return true If dither is enabled
+     * @return false If samples are simply rounded
+     */
+    bool get_dither() const { return this->dither; }
+
+    /**
+     * @brief Enables or disables dither
+     *
+     * Dither only applies if the device uses 16 bit samples,
+     * higher resolution formats are never dithered.
+     *
+     * @param val true to enable dither
+     */
+    void set_dither(bool val) { this->dither = val; }
+
+    /**
+     * @brief Sets the noise shaping used when dithering
+     *
+     * @param shape Noise shaping to use
+     */
+    void set_noise_shaping(NoiseShaping shape) { this->ditherer.set_shaping(shape); }
+
+    /**
+     * @brief Gets the noise shaping used when dithering
+     *
+     * @return NoiseShaping Noise shaping in use
+     */
+    NoiseShaping get_noise_shaping() const { return this->ditherer.get_shaping(); }
+
+    /**
+     * @brief Gets the number of underruns that have occurred
+     *
+     * @return int Number of underruns
+     */
+    int get_underruns() const { return this->underruns.load(); }
+};
+
+/**
+ * @brief Captures audio data from an ALSA device
+ *
+ * We read audio data from the selected ALSA device
+ * and provide it to forward modules.
+ * Like ALSASink, the chain parameters are taken from the device,
+ * and each processed buffer holds exactly one device period.
+ *
+ * The device is opened in non-blocking mode,
+ * and we wait on the device poll descriptors for a period to become available,
+ * rather than blocking inside of snd_pcm_readi().
+ * Because process() returns as soon as the capture period interrupt fires,
+ * a chain with this module at the back is clocked by the capture device:
+ * repeatedly calling meta_process() on the sink will run the chain
+ * exactly once per captured period, with minimal latency.
+ * This is ideal for duplex effects.
+ *
+ * If you want to do other work while waiting,
+ * the poll descriptors can be retrieved with get_descriptors()
+ * and integrated into your own event loop,
+ * and ready() can then be called to check if a period can be read.
+ *
+ * If an overrun occurs, we recover the device and continue.
+ * The number of overruns can be retrieved with get_overruns().
+ */
+class ALSASource : public ALSABase, public SourceModule {
+
+   private:
+
+    /// Poll descriptors of the device
+    std::vector<pollfd> fds;
+
+    /// Scratch buffer for samples in the device format, in bytes
+    std::vector<unsigned char> temp;
+
+    /// Scratch buffer for interleaved samples when buffers are planar
+    std::vector<sample_t> frames;
+
+    /// Number of overruns that have occurred
+    int overruns = 0;
+
+    /// Maximum time to wait for a period in milliseconds, -1 to wait forever
+    int timeout = -1;
+
+    /// Boolean determining if the device can not capture
+    bool capture_fail = false;
+
+    /**
+     * @brief Converts samples from the device format
+     *
+     * @param input Pointer to samples in the device format
+     * @param output Pointer to destination samples
+     * @param num Number of samples to convert
+     */
+    void convert(const void* input, sample_t* output, std::size_t num);
+
+   public:
+
+    /**
+     * @brief Waits until a period can be read from the device
+     *
+     * We poll the device descriptors until a full period is available.
+     * If the device has overrun, we recover it and keep waiting.
+     *
+     * @param wait Maximum time to wait in milliseconds, -1 to wait forever
+     * @return true If a period is ready to be read
+     * @return false If we timed out
+     */
+    bool wait_period(int wait);
+
+    /**
+     * @brief Determines if a period can be read without blocking
+     *
+     * @return true If a full period is available
+     * @return false If the device does not yet have a full period
+     */
+    bool ready();
+
+    /**
+     * @brief Reads audio data from the selected ALSA device
+     *
+     * We wait for the next capture period,
+     * read it from the device and convert it into an AudioBuffer.
+     * If the wait times out, or the device can not capture,
+     * then the buffer is filled with silence.
+     *
+     */
+    void process() override;
+
+    /**
+     * @brief Starts this module
+     *
+     * We open the device for capture,
+     * configure the chain with the device parameters,
+     * grab the poll descriptors and start the device.
+     *
+     * If the device does not support input, then it is not opened,
+     * capture_fail is set, and we output silence.
+     *
+     */
+    void start() override;
+
+    /**
+     * @brief Stops this module
+     *
+     * We simply upcall the alsa_stop() method.
+     *
+     */
+    void stop() override;
+
+    /**
+     * @brief Preforms an info sync for this module
+     *
+     * We configure our info using the device parameters,
+     * so each buffer is one device period.
+     *
+     */
+    void info_sync() override;
+
+    /**
+     * @brief Gets the poll descriptors of the device
+     *
+     * These are only valid after the module is started.
+     *
+     * @return const std::vector<pollfd>& Poll descriptors of the device
+     */
+    const std::vector<pollfd>& get_descriptors() const { return this->fds; }
+
+    /**
+     * @brief Gets the maximum time to wait for a period
+     *
+     * @return int Timeout in milliseconds, -1 waits forever
+     */
+    int get_timeout() const { return this->timeout; }
+
+    /**
+     * @brief Sets the maximum time to wait for a period
+     *
+     * @param wait Timeout in milliseconds, -1 waits forever
+     */
+    void set_timeout(int wait) { this->timeout = wait; }
+
+    /**
+     * @brief Gets the number of overruns that have occurred
+     *
+     * @return int Number of overruns
+     */
+    int get_overruns() const { return this->overruns; }
+
+    /**
+     * @brief Determines if the device could not be captured from
+     *
+     * This is set when we are started on a device that does not support input.
+     *
+     * @return true If we are outputting silence in place of the device
+     */
+    bool get_capture_fail() const { return this->capture_fail; }
 };
 
 #endif
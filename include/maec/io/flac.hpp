@@ -0,0 +1,496 @@
+/**
+ * @file flac.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief FLAC file support
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Here we define components that decode FLAC streams.
+ * FLAC files are usually around half the size of the equivalent wave file,
+ * so large sample libraries take up half the disk and page cache,
+ * at the cost of a small amount of decoding work.
+ *
+ * The decoder is our own, and reads from any input mstream.
+ * A FLAC source is provided, which decodes on a background
+ * thread and outputs blocks like the WaveSource.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "../source_module.hpp"
+#include "audio_buffer.hpp"
+#include "dsp/ring.hpp"
+#include "mstream.hpp"
+
+/**
+ * @brief Reads audio data from a FLAC stream
+ *
+ * This component reads the stream metadata when started,
+ * and decodes FLAC frames as audio data is requested.
+ * Like the WaveReader, audio data is returned in buffers of a set size,
+ * and frames are decoded across buffers as necessary.
+ * If we reach the end of the stream before the buffer is full,
+ * then the rest of the buffer will be filled with zeros.
+ *
+ * Bytes are read from the mstream in large reads (see set_read_size()),
+ * so slow mstreams are not asked for a few bytes at a time.
+ *
+ * Every frame is checked against its CRCs.
+ * Frames that fail are replaced with silence of the same length,
+ * so the timing of the rest of the stream is maintained,
+ * and we resynchronize on the next frame.
+ *
+ * We support every sample size and channel assignment in the format.
+ * Seeking is not supported, so the stream is read from start to finish.
+ */
+class FLACReader {
+public:
+
+    FLACReader() = default;
+
+    FLACReader(BaseMIStream* stream) : stream(stream) {}
+
+    /**
+     * @brief Starts this FLAC reader
+     *
+     * We start the mstream and read the stream metadata.
+     * If the stream is not a FLAC stream,
+     * then we are immediately done.
+     */
+    void start();
+
+    /**
+     * @brief Stops this FLAC reader
+     *
+     * We simply stop the mstream.
+     */
+    void stop();
+
+    /**
+     * @brief Sets the input mstream to utilize
+     *
+     * @param stream New input mstream
+     */
+    void set_stream(BaseMIStream* stream) { this->stream = stream; }
+
+    /**
+     * @brief Gets the input mstream
+     *
+     * @return BaseMIStream* input mstream
+     */
+    BaseMIStream* get_stream() const { return this->stream; }
+
+    /**
+     * @brief Sets the size of the output buffer
+     *
+     * Like the WaveReader, this is the number of FRAMES we will output.
+     *
+     * @param bsize New size of output buffer
+     */
+    void set_buffer_size(int bsize) { this->buffer_size = bsize; }
+
+    /**
+     * @brief Gets the size of the output buffer
+     *
+     * @return int Size of output buffer
+     */
+    int get_buffer_size() const { return this->buffer_size; }
+
+    /**
+     * @brief Sets the number of bytes to read from the mstream at once
+     *
+     * This must be set before we are started.
+     *
+     * @param size Number of bytes to read at once
+     */
+    void set_read_size(int size) { this->read_size = std::max(size, 64); }
+
+    /**
+     * @brief Gets the number of bytes to read from the mstream at once
+     *
+     * @return int Number of bytes to read at once
+     */
+    int get_read_size() const { return this->read_size; }
+
+    /**
+     * @brief Gets the number of channels
+     *
+     * @return int Number of channels
+     */
+    int get_channels() const { return this->channels; }
+
+    /**
+     * @brief Gets the sample rate
+     *
+     * @return int Sample rate of the stream
+     */
+    int get_samplerate() const { return this->sample_rate; }
+
+    /**
+     * @brief Gets the number of bits per sample
+     *
+     * @return int Bits per sample
+     */
+    int get_bits_per_sample() const { return this->bits_per_sample; }
+
+    /**
+     * @brief Gets the number of frames in the stream
+     *
+     * This is the number of frames reported by the stream metadata,
+     * which is 0 if the encoder did not know.
+     *
+     * @return int64_t Number of frames
+     */
+    int64_t get_frames() const { return this->total_frames; }
+
+    /**
+     * @brief Gets the number of FLAC frames that failed to decode
+     *
+     * @return uint64_t Number of corrupt frames
+     */
+    uint64_t get_errors() const { return this->errors; }
+
+    /**
+     * @brief Determines if this FLACReader is done
+     *
+     * We are done once every frame has been decoded and output,
+     * or if the stream is not a valid FLAC stream.
+     *
+     * @return true Reader is done
+     * @return false Reader is not done
+     */
+    bool done() const { return this->ended && this->block_pos >= this->block_frames; }
+
+    /**
+     * @brief Reads audio data from the stream
+     *
+     * We decode FLAC frames until the buffer is full.
+     * If we reach the end of the stream,
+     * then the empty space in the buffer will simply be zeros.
+     *
+     * @return BufferPointer AudioBuffer containing audio data, ready for processing
+     */
+    BufferPointer get_data();
+
+private:
+
+    /**
+     * @brief Reads more bytes from the mstream
+     *
+     * Bytes which may still be needed are moved to the front of the input.
+     *
+     * @return true If any bytes were read
+     */
+    bool load();
+
+    /**
+     * @brief Fills the bit cache from the input
+     */
+    void refill();
+
+    /**
+     * @brief Reads an unsigned value
+     *
+     * @param num Number of bits to read, at most 32
+     * @return uint32_t Value read
+     */
+    uint32_t read_bits(int num);
+
+    /**
+     * @brief Reads a two's complement signed value
+     *
+     * @param num Number of bits to read, at most 33
+     * @return int64_t Value read
+     */
+    int64_t read_signed(int num);
+
+    /**
+     * @brief Reads a unary value
+     *
+     * This is the number of zero bits before the next one bit.
+     *
+     * @return uint32_t Value read
+     */
+    uint32_t read_unary();
+
+    /**
+     * @brief Gets the next bits without consuming them
+     *
+     * @param num Number of bits to peek, at most 32
+     * @return uint32_t Value of the bits
+     */
+    uint32_t peek_bits(int num);
+
+    /**
+     * @brief Skips to the next byte boundary
+     */
+    void align() { this->read_bits(this->cached % 8); }
+
+    /**
+     * @brief Determines if every bit has been read
+     *
+     * @return true If there is nothing left in the stream
+     */
+    bool exhausted() const { return this->eof && this->in_pos >= this->in_end && this->cached == 0; }
+
+    /**
+     * @brief Gets the number of input bytes that have been consumed
+     *
+     * @return std::size_t Position in the input of the first byte not completely read
+     */
+    std::size_t consumed() const { return this->in_pos - static_cast<std::size_t>((this->cached + 7) / 8); }
+
+    /**
+     * @brief Updates the CRCs with every byte consumed since the last update
+     */
+    void crc_update();
+
+    /**
+     * @brief Moves back to an earlier byte of the input
+     *
+     * Any bits in the cache are discarded.
+     *
+     * @param pos Position in the input to read from next
+     */
+    void rewind(std::size_t pos);
+
+    /**
+     * @brief Restarts the CRCs at the current position
+     *
+     * This marks the start of a frame.
+     */
+    void crc_reset();
+
+    /**
+     * @brief Reads the stream metadata
+     *
+     * @return true If the stream is a valid FLAC stream
+     */
+    bool read_metadata();
+
+    /**
+     * @brief Decodes the next FLAC frame into the block
+     *
+     * @return true If a frame was found, even if it was corrupt
+     */
+    bool decode_frame();
+
+    /**
+     * @brief Decodes a subframe
+     *
+     * @param output Pointer to room for the block of samples
+     * @param num Number of samples in the block
+     * @param bits Number of bits per sample for this subframe
+     * @return true If the subframe is valid
+     */
+    bool decode_subframe(int64_t* output, int num, int bits);
+
+    /**
+     * @brief Decodes residuals and applies a predictor
+     *
+     * @param output Pointer to the block, with the warm-up samples filled in
+     * @param num Number of samples in the block
+     * @param coeffs Predictor coefficients
+     * @param order Order of the predictor
+     * @param shift Shift applied to the prediction
+     * @return true If the residuals are valid
+     */
+    bool decode_residual(int64_t* output, int num, const int64_t* coeffs, int order, int shift);
+
+    /// Input mstream to read from
+    BaseMIStream* stream = nullptr;
+
+    /// Number of frames to output
+    int buffer_size = 0;
+
+    /// Number of bytes to read from the mstream at once
+    int read_size = 1 << 16;
+
+    /// Number of channels
+    int channels = 0;
+
+    /// Sample rate of the stream
+    int sample_rate = 0;
+
+    /// Number of bits per sample
+    int bits_per_sample = 0;
+
+    /// Number of frames reported by the stream metadata
+    int64_t total_frames = 0;
+
+    /// Number of frames decoded so far
+    int64_t decoded = 0;
+
+    /// Number of corrupt FLAC frames
+    uint64_t errors = 0;
+
+    /// Determines if there are no more FLAC frames
+    bool ended = true;
+
+    /// Bytes read from the mstream
+    std::vector<unsigned char> input;
+
+    /// Position of the next byte to move into the bit cache
+    std::size_t in_pos = 0;
+
+    /// Number of valid bytes in the input
+    std::size_t in_end = 0;
+
+    /// Position of the first byte not included in the CRCs
+    std::size_t crc_pos = 0;
+
+    /// Position of the first byte of the current frame
+    std::size_t frame_pos = 0;
+
+    /// Determines if the mstream has no more bytes
+    bool eof = false;
+
+    /// Bits waiting to be read, starting at the most significant bit
+    uint64_t cache = 0;
+
+    /// Number of bits in the cache
+    int cached = 0;
+
+    /// CRC-8 of the current frame header
+    uint8_t crc8 = 0;
+
+    /// CRC-16 of the current frame
+    uint16_t crc16 = 0;
+
+    /// Decoded samples of the current FLAC frame, one channel after another
+    std::vector<int64_t> block;
+
+    /// Number of frames in the current FLAC frame
+    int block_frames = 0;
+
+    /// Next frame of the current FLAC frame to output
+    int block_pos = 0;
+
+    /// Interleaved scratch space when buffers are planar
+    std::vector<sample_t> frames;
+};
+
+/**
+ * @brief Plays audio from a FLAC stream
+ *
+ * This module reads audio data from a FLAC stream,
+ * and allows this audio data to be integrated into a chain.
+ * Just like the WaveSource, we automatically configure this module
+ * with the stream parameters, which forward modules can utilize.
+ *
+ * Decoding takes more work than reading wave data,
+ * so by default we decode on a background thread,
+ * which keeps a number of blocks waiting in a lock-free queue (see set_prefetch()).
+ * If the thread falls behind, we output silence instead of waiting,
+ * and count the underrun.
+ * Once the end of the stream is reached, we output silence without
+ * counting underruns.
+ */
+class FLACSource : public SourceModule, public FLACReader {
+public:
+
+    FLACSource() = default;
+
+    FLACSource(BaseMIStream* stream) : FLACReader(stream) {}
+
+    /// Destructor, stops the decoding thread
+    ~FLACSource() override;
+
+    /// Sources can't be copied
+    FLACSource(const FLACSource&) = delete;
+
+    /// Sources can't be copied
+    FLACSource& operator=(const FLACSource&) = delete;
+
+    /**
+     * @brief Starts this FLAC source
+     *
+     * We start the FLACReader, which reads the stream metadata,
+     * and start the decoding thread if prefetching is enabled.
+     */
+    void start() override;
+
+    /**
+     * @brief Stops this FLAC source
+     *
+     * We stop the decoding thread if it is running,
+     * then stop the FLACReader.
+     */
+    void stop() override;
+
+    /**
+     * @brief Processes this module
+     *
+     * We take the next decoded block from the queue,
+     * or decode it now if prefetching is disabled.
+     */
+    void process() override;
+
+    /**
+     * @brief Sets the number of blocks to decode ahead
+     *
+     * This must be set before we are started.
+     * A value of 0 disables the decoding thread,
+     * and decodes audio data when we are processed.
+     *
+     * @param blocks Number of blocks to decode ahead
+     */
+    void set_prefetch(int blocks) { this->prefetch = blocks; }
+
+    /**
+     * @brief Gets the number of blocks to decode ahead
+     *
+     * @return int Number of blocks to decode ahead
+     */
+    int get_prefetch() const { return this->prefetch; }
+
+    /**
+     * @brief Gets the number of underruns
+     *
+     * @return uint64_t Number of underruns since we were started
+     */
+    uint64_t get_underruns() const { return this->underruns.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Determines if every block has been output
+     *
+     * @return true If there is nothing left to play
+     */
+    bool finished() const;
+
+private:
+
+    /**
+     * @brief Main loop of the decoding thread
+     */
+    void run();
+
+    /// Number of blocks to decode ahead
+    int prefetch = 8;
+
+    /// Blocks decoded by the decoding thread
+    SPSCRing<BufferPointer> ahead;
+
+    /// Decoding thread
+    std::thread worker;
+
+    /// Determines if the decoding thread should keep running
+    std::atomic<bool> running{false};
+
+    /// Determines if the decoding thread has reached the end of the stream
+    std::atomic<bool> drained{false};
+
+    /// Number of blocks we have taken from the queue
+    std::atomic<uint64_t> taken{0};
+
+    /// Number of underruns
+    std::atomic<uint64_t> underruns{0};
+};
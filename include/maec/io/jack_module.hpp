@@ -0,0 +1,376 @@
+/**
+ * @file jack_module.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Components for working with JACK and PipeWire
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Here we define modules that output to and read from a JACK server.
+ * Unlike ALSA, where we pull the chain and then push the result to the device,
+ * JACK calls us from its own realtime thread once per period,
+ * and the chain is rendered right there in the callback.
+ * This lets the chain share a clock (and a period) with every other client in the graph.
+ *
+ * PipeWire provides a drop-in JACK library (pipewire-jack),
+ * so on PipeWire hosts these modules become PipeWire nodes driven by the PipeWire graph.
+ * Of course, libjack (or the PipeWire replacement) MUST be installed on any system
+ * that wishes to use this module.
+ */
+
+#pragma once
+
+#ifdef JACK_F
+
+#include <jack/jack.h>
+
+#include <atomic>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "chain_plan.hpp"
+#include "sink_module.hpp"
+#include "source_module.hpp"
+
+class JACKSource;
+
+/**
+ * @brief Outputs audio to a JACK server
+ *
+ * We open a JACK client and register one output port per channel.
+ * Once started, the JACK process callback drives the chain:
+ * each callback renders exactly the number of frames JACK asks for
+ * (see SinkModule::set_frames()), and writes them straight into the port buffers.
+ * No thread or ring sits between the chain and the server.
+ *
+ * JACK buffers are planar 32 bit floats.
+ * When our buffers are planar and our samples are floats,
+ * the output is a straight copy of each channel into its port;
+ * otherwise the samples are converted as they are written.
+ *
+ * By default the chain is compiled into a ChainPlan when we start (see chain_plan.hpp),
+ * so the callback runs a flat schedule without any allocations or recursion.
+ *
+ * The sample rate and period of the chain are taken from the server when we sync,
+ * and the server period is declared as the largest block.
+ * If the server later grows its period past that size,
+ * the extra frames are output as silence until the chain is synced and started again.
+ *
+ * Sources that read from the same server (see JACKSource) share our client,
+ * so their input ports are read in the same callback.
+ * The sink must outlive its sources.
+ */
+class JACKSink : public PeriodSink {
+
+    private:
+
+        /// Name of the client we register as
+        std::string name = "maec";
+
+        /// Name of the server to connect to, empty for the default
+        std::string server;
+
+        /// Client we are registered as
+        jack_client_t* client = nullptr;
+
+        /// Output port for each channel
+        std::vector<jack_port_t*> ports;
+
+        /// Compiled chain run by the callback
+        ChainPlan plan;
+
+        /// Determines if we compile the chain when started
+        bool compiled = true;
+
+        /// Determines if our ports are connected to the physical outputs when started
+        bool autoconnect = true;
+
+        /// Value determining if the callback renders the chain
+        std::atomic<bool> running{false};
+
+        /// Value determining if the server has shut us down
+        std::atomic<bool> shutdown{false};
+
+        /// Number of xruns reported by the server
+        std::atomic<int> xruns{0};
+
+        /// Largest JACK period the chain was configured for
+        int capacity = 0;
+
+        /// Number of frames asked for by the current callback
+        jack_nframes_t period = 0;
+
+        /// Sources sharing our client
+        std::vector<JACKSource*> sources;
+
+        /**
+         * @brief JACK process callback
+         *
+         * @param nframes Number of frames to render
+         * @param arg Pointer to the sink
+         * @return int Always 0
+         */
+        static int process_callback(jack_nframes_t nframes, void* arg);
+
+        /**
+         * @brief JACK thread init callback, flushes denormals on the JACK thread if the chain asks for it
+         *
+         * @param arg Pointer to the sink
+         */
+        static void thread_callback(void* arg);
+
+        /**
+         * @brief JACK xrun callback
+         *
+         * @param arg Pointer to the sink
+         * @return int Always 0
+         */
+        static int xrun_callback(void* arg);
+
+        /**
+         * @brief JACK shutdown callback
+         *
+         * @param arg Pointer to the sink
+         */
+        static void shutdown_callback(void* arg);
+
+        /**
+         * @brief Renders one period into the port buffers
+         *
+         * @param nframes Number of frames to render
+         */
+        void render(jack_nframes_t nframes);
+
+        /**
+         * @brief Connects each of the given ports to a physical port
+         *
+         * @param own Ports to connect
+         * @param output Determines if the given ports are outputs
+         */
+        void connect_physical(const std::vector<jack_port_t*>& own, bool output);
+
+        friend class JACKSource;
+
+    public:
+
+        JACKSink() = default;
+
+        /**
+         * @brief Construct a new JACKSink object
+         *
+         * @param cname Name of the client we register as
+         */
+        explicit JACKSink(std::string cname) : name(std::move(cname)) {}
+
+        /**
+         * @brief Destroy the JACKSink object
+         *
+         * We stop (if necessary) and close our client.
+         */
+        ~JACKSink() override;
+
+        JACKSink(const JACKSink&) = delete;
+        JACKSink& operator=(const JACKSink&) = delete;
+        JACKSink(JACKSink&&) = delete;
+        JACKSink& operator=(JACKSink&&) = delete;
+
+        /**
+         * @brief Writes the current buffer into the port buffers
+         *
+         * This is called within the JACK callback,
+         * and should not be called otherwise.
+         */
+        void process() override;
+
+        /**
+         * @brief Opens our client and configures the chain from the server
+         *
+         * We take the sample rate and period from the server,
+         * and register one output port per channel.
+         */
+        void info_sync() override;
+
+        /**
+         * @brief Compiles the chain and activates our client
+         *
+         * Once active, our ports (and those of our sources) are connected to the physical ports if enabled.
+         * After this, the chain is rendered by the JACK callback,
+         * so it should not be processed by anything else.
+         */
+        void start() override;
+
+        /**
+         * @brief Deactivates our client
+         *
+         * Once this returns, the callback no longer touches the chain.
+         */
+        void stop() override;
+
+        /**
+         * @brief Opens our client, if it is not already open
+         *
+         * This is done automatically when we sync.
+         *
+         * @return true If the client is open
+         */
+        bool open();
+
+        /**
+         * @brief Closes our client
+         */
+        void close();
+
+        /**
+         * @brief Sets the name of the client we register as
+         *
+         * This must be set before our client is opened.
+         *
+         * @param cname Client name
+         */
+        void set_name(const std::string& cname) { this->name = cname; }
+
+        /**
+         * @brief Gets the name of the client we register as
+         *
+         * @return std::string Client name
+         */
+        std::string get_name() const { return this->name; }
+
+        /**
+         * @brief Sets the server to connect to
+         *
+         * This must be set before our client is opened.
+         *
+         * @param sname Server name, empty for the default server
+         */
+        void set_server(const std::string& sname) { this->server = sname; }
+
+        /**
+         * @brief Sets whether the chain is compiled when we start
+         *
+         * @param value True to run a ChainPlan in the callback, false to meta process
+         */
+        void set_compiled(bool value) { this->compiled = value; }
+
+        /**
+         * @brief Determines if the chain is compiled when we start
+         *
+         * @return true If the callback runs a ChainPlan
+         */
+        bool get_compiled() const { return this->compiled; }
+
+        /**
+         * @brief Sets whether our ports are connected to the physical ports when started
+         *
+         * @param value True to connect to the physical ports
+         */
+        void set_autoconnect(bool value) { this->autoconnect = value; }
+
+        /**
+         * @brief Determines if our ports are connected to the physical ports when started
+         *
+         * @return true If we connect to the physical ports
+         */
+        bool get_autoconnect() const { return this->autoconnect; }
+
+        /**
+         * @brief Gets our JACK client
+         *
+         * @return jack_client_t* Client, or nullptr if not open
+         */
+        jack_client_t* get_client() const { return this->client; }
+
+        /**
+         * @brief Gets the number of xruns reported by the server
+         *
+         * @return int Number of xruns since starting
+         */
+        int get_xruns() const { return this->xruns.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Determines if the server has shut us down
+         *
+         * @return true If the server has gone away
+         */
+        bool is_shutdown() const { return this->shutdown.load(std::memory_order_relaxed); }
+};
+
+/**
+ * @brief Reads audio from a JACK server
+ *
+ * We register one input port per channel on the client of a JACKSink,
+ * so we are read within the same callback that renders the chain.
+ * Each block copies (or converts) the port buffers straight into our buffer,
+ * with as many frames as the callback asked for.
+ *
+ * The sink must be synced before we are, which is always the case
+ * if we are somewhere in the chain of the sink.
+ */
+class JACKSource : public SourceModule {
+
+    private:
+
+        /// Sink whose client we share
+        JACKSink* host = nullptr;
+
+        /// Number of channels to read
+        int channels = 1;
+
+        /// Input port for each channel
+        std::vector<jack_port_t*> ports;
+
+        /// Determines if our ports are connected to the physical inputs when started
+        bool autoconnect = true;
+
+        /**
+         * @brief Unregisters our ports and detaches us from the sink
+         */
+        void unregister();
+
+        friend class JACKSink;
+
+    public:
+
+        /**
+         * @brief Construct a new JACKSource object
+         *
+         * @param sink Sink whose client we share
+         * @param num Number of channels to read
+         */
+        explicit JACKSource(JACKSink& sink, int num = 1) : host(&sink), channels(num) {}
+
+        /**
+         * @brief Destroy the JACKSource object
+         *
+         * We unregister our ports from the client.
+         */
+        ~JACKSource() override { this->unregister(); }
+
+        JACKSource(const JACKSource&) = delete;
+        JACKSource& operator=(const JACKSource&) = delete;
+        JACKSource(JACKSource&&) = delete;
+        JACKSource& operator=(JACKSource&&) = delete;
+
+        /**
+         * @brief Reads the port buffers into a new buffer
+         */
+        void process() override;
+
+        /**
+         * @brief Registers our ports on the client of the sink
+         *
+         * Our ports are connected to the physical inputs by the sink when it starts.
+         */
+        void info_sync() override;
+
+        /**
+         * @brief Sets whether our ports are connected to the physical ports when started
+         *
+         * @param value True to connect to the physical ports
+         */
+        void set_autoconnect(bool value) { this->autoconnect = value; }
+};
+
+#endif
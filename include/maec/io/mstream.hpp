@@ -19,10 +19,19 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <fstream>
+#include <span>
+#include <thread>
 #include <vector>
 
+#include "dsp/alloc.hpp"
+#include "dsp/ring.hpp"
+
 /**
  * @brief Base class for mstreams
  * 
@@ -192,6 +201,52 @@ public:
      * @param num Number of bytes to read
      */
     virtual void read(char* byts, int num) =0;
+
+    /**
+     * @brief Reads up to a number of bytes from the stream
+     *
+     * This is identical to read(),
+     * except we report the number of bytes that were actually read,
+     * which may be less than requested if the end of the stream was reached.
+     * If this happens, the stream is stopped.
+     *
+     * By default we assume all bytes can be read.
+     *
+     * @param byts Character array to place data into
+     * @param num Maximum number of bytes to read
+     * @return int Number of bytes read
+     */
+    virtual int read_some(char* byts, int num) { this->read(byts, num); return num; }
+
+    /**
+     * @brief Gets the contents of this mstream as one block of memory
+     *
+     * Some mstreams hold their entire contents in memory,
+     * such as memory mapped files.
+     * These mstreams can return a pointer to the start of their contents,
+     * which allows consumers to decode data in place
+     * rather than copying it out with read().
+     *
+     * The position of the mstream is NOT changed by this method,
+     * consumers that read from this pointer should seek
+     * to keep the mstream in sync.
+     *
+     * By default we return nullptr,
+     * which means the contents are not available in memory.
+     *
+     * @return const char* Pointer to contents, or nullptr if unavailable
+     */
+    virtual const char* contiguous() const { return nullptr; }
+
+    /**
+     * @brief Gets the total number of bytes in this mstream
+     *
+     * This is only meaningful if contiguous() returns a valid pointer,
+     * other mstreams will return 0.
+     *
+     * @return std::size_t Number of bytes in the mstream
+     */
+    virtual std::size_t length() const { return 0; }
 };
 
 /**
@@ -264,6 +319,31 @@ public:
      */
     void read(char* byts, int num) final;
 
+    /**
+     * @brief Reads up to a number of chars from the array
+     *
+     * @param byts Char array to store results into
+     * @param num Maximum number of bytes to read
+     * @return int Number of bytes read
+     */
+    int read_some(char* byts, int num) final;
+
+    /**
+     * @brief Gets the contents of the array
+     *
+     * The pointer is only valid until the array is changed.
+     *
+     * @return const char* Pointer to the array contents
+     */
+    const char* contiguous() const final { return reinterpret_cast<const char*>(this->arr.data()); }
+
+    /**
+     * @brief Gets the size of the array
+     *
+     * @return std::size_t Number of bytes in the array
+     */
+    std::size_t length() const final { return this->arr.size(); }
+
     /**
      * @brief Gets the array utilized by this mstream
      * 
@@ -275,6 +355,96 @@ public:
     std::vector<unsigned char>& get_array() { return this->arr; }
 };
 
+/**
+ * @brief mstream for reading borrowed memory
+ *
+ * This mstream is similar to the CharIStream,
+ * except we do not own the memory we read from.
+ * This allows data that is already in memory (received over the network, embedded in the program, ...)
+ * to be read without first copying it into the mstream.
+ *
+ * The memory MUST outlive this mstream, and should not change while it is being read.
+ * Like the MMapIStream, the memory is exposed via contiguous(),
+ * so consumers can decode straight from it.
+ */
+class SpanIStream : public BaseMIStream {
+private:
+
+    /// Memory we are reading from
+    std::span<const char> data;
+
+    /// Current index into memory
+    std::size_t index = 0;
+
+public:
+
+    SpanIStream() = default;
+
+    SpanIStream(std::span<const char> mem) : data(mem) {}
+
+    SpanIStream(std::span<const unsigned char> mem) : data(reinterpret_cast<const char*>(mem.data()), mem.size()) {}
+
+    /**
+     * @brief Sets the memory to read from
+     *
+     * We also seek to the start of the memory.
+     *
+     * @param mem Memory to read from
+     */
+    void set_span(std::span<const char> mem) { this->data = mem; this->index = 0; }
+
+    /**
+     * @brief Gets the memory we are reading from
+     *
+     * @return std::span<const char> Memory in use
+     */
+    std::span<const char> get_span() const { return this->data; }
+
+    /**
+     * @brief Seeks the index to the given position
+     *
+     * Positions beyond the end of the memory
+     * are clamped to the end of the memory.
+     *
+     * @param pos Position to seek to
+     */
+    void seek(int pos) final { this->index = std::min(static_cast<std::size_t>(std::max(pos, 0)), this->data.size()); }
+
+    /**
+     * @brief Reads chars from the memory
+     *
+     * If we are asked to read beyond the end of the memory,
+     * then the remaining bytes are zeroed and this mstream is stopped.
+     *
+     * @param byts Char array to store results into
+     * @param num Number of bytes to read
+     */
+    void read(char* byts, int num) final;
+
+    /**
+     * @brief Reads up to a number of chars from the memory
+     *
+     * @param byts Char array to store results into
+     * @param num Maximum number of bytes to read
+     * @return int Number of bytes read
+     */
+    int read_some(char* byts, int num) final;
+
+    /**
+     * @brief Gets the memory we are reading from
+     *
+     * @return const char* Pointer to start of memory
+     */
+    const char* contiguous() const final { return this->data.data(); }
+
+    /**
+     * @brief Gets the size of the memory we are reading from
+     *
+     * @return std::size_t Number of bytes in memory
+     */
+    std::size_t length() const final { return this->data.size(); }
+};
+
 /**
  * @brief mstream for writing byte arrays
  * 
@@ -285,6 +455,8 @@ public:
  * and we will reserve the initial size.
  * If we are asked to add values beyond the capacity of the array,
  * we will change the size to fit our values.
+ * The capacity grows geometrically, and values are added in bulk,
+ * so many small writes are cheap.
  * 
  */
 class CharOStream : public BaseMOStream {
@@ -319,6 +491,16 @@ public:
      */
     void write(char* byts, int num) final;
 
+    /**
+     * @brief Reserves space in the array
+     *
+     * Use this if the final size is known ahead of time,
+     * to avoid moving the array as it grows.
+     *
+     * @param size Number of bytes to reserve
+     */
+    void reserve(std::size_t size) { this->arr.reserve(size); }
+
     /**
      * @brief Gets the array utilized by this mstream
      *
@@ -455,6 +637,15 @@ public:
      */
     void read(char* byts, int num) final;
 
+    /**
+     * @brief Reads up to a number of bytes from a file
+     *
+     * @param byts Char array to store results into
+     * @param num Maximum number of bytes to read
+     * @return int Number of bytes read
+     */
+    int read_some(char* byts, int num) final;
+
     /**
      * @brief Starts this mstream
      * 
@@ -504,3 +695,502 @@ public:
      */
     void stop() final;
 };
+
+/**
+ * @brief mstream for reading memory mapped files
+ *
+ * This mstream maps a file into memory when started,
+ * and reads from the mapping instead of making a system call per read.
+ * The operating system pages in the file contents as they are touched,
+ * so large files can be opened instantly.
+ *
+ * Because the entire file is available in memory,
+ * this mstream supports arbitrary seeking,
+ * and exposes its contents via contiguous().
+ * Consumers such as the WaveReader will decode straight
+ * from the mapping without copying.
+ *
+ * If the file can't be opened or mapped,
+ * then this mstream will go into the error state.
+ */
+class MMapIStream : public BaseMIStream {
+private:
+
+    /// Path to file we are working with
+    std::string filepath;
+
+    /// File descriptor of the open file
+    int fd = -1;
+
+    /// Pointer to start of mapped file
+    const char* map = nullptr;
+
+    /// Size of the mapped file in bytes
+    std::size_t map_size = 0;
+
+    /// Current position in the mapped file
+    std::size_t index = 0;
+
+public:
+
+    MMapIStream() = default;
+
+    MMapIStream(std::string path) : filepath(std::move(path)) {}
+
+    MMapIStream(const MMapIStream&) = delete;
+
+    MMapIStream& operator=(const MMapIStream&) = delete;
+
+    /**
+     * @brief Destroys this mstream
+     *
+     * We release the mapping if it is still active.
+     */
+    ~MMapIStream() { this->unmap(); }
+
+    /**
+     * @brief Gets the path to the file we are working with
+     *
+     * @return std::string Path to file
+     */
+    std::string get_path() const { return this->filepath; }
+
+    /**
+     * @brief Sets the path to the file we are working with
+     *
+     * @param path New path to file
+     */
+    void set_path(const std::string& path) { this->filepath = path; }
+
+    /**
+     * @brief Seeks to the given position
+     *
+     * Positions beyond the end of the file
+     * are clamped to the end of the file.
+     *
+     * @param pos Position to seek to
+     */
+    void seek(int pos) final { this->index = std::min(static_cast<std::size_t>(std::max(pos, 0)), this->map_size); }
+
+    /**
+     * @brief Reads contents from the mapped file
+     *
+     * If we are asked to read beyond the end of the file,
+     * then the remaining bytes are zeroed and this mstream is stopped.
+     *
+     * @param byts Char array to store results into
+     * @param num Number of bytes to read
+     */
+    void read(char* byts, int num) final;
+
+    /**
+     * @brief Reads up to a number of bytes from the mapped file
+     *
+     * @param byts Char array to store results into
+     * @param num Maximum number of bytes to read
+     * @return int Number of bytes read
+     */
+    int read_some(char* byts, int num) final;
+
+    /**
+     * @brief Gets the mapped file contents
+     *
+     * @return const char* Pointer to start of mapping, nullptr if not mapped
+     */
+    const char* contiguous() const final { return this->map; }
+
+    /**
+     * @brief Gets the size of the mapped file
+     *
+     * @return std::size_t Size of the mapped file in bytes
+     */
+    std::size_t length() const final { return this->map_size; }
+
+    /**
+     * @brief Starts this mstream
+     *
+     * We open and map the file.
+     * We also advise the kernel that we will read the file sequentially,
+     * so it can read ahead of us.
+     */
+    void start() final;
+
+    /**
+     * @brief Stops this mstream
+     *
+     * We unmap and close the file.
+     */
+    void stop() final;
+
+private:
+
+    /**
+     * @brief Releases the mapping and file descriptor
+     *
+     */
+    void unmap();
+};
+
+/**
+ * @brief mstream for writing files from a background thread
+ *
+ * Writing to a file can take a long time if the disk is busy,
+ * which is not something a real time thread can afford.
+ * This mstream copies written data into large chunks of memory,
+ * and hands full chunks to a background thread which writes them to the file.
+ * Writes only block if every chunk is waiting to be written,
+ * so the number and size of the chunks should cover any expected disk stalls.
+ *
+ * Chunks are aligned to pages, and can optionally be written with O_DIRECT,
+ * which bypasses the page cache.
+ * This is useful for long recordings, which would otherwise evict useful data from the cache.
+ * When using O_DIRECT, the chunk size should be a multiple of the page size.
+ * Writes that can't be done directly (the final partial chunk, or writes after seeking)
+ * are written through the page cache instead.
+ * If the file system does not support O_DIRECT, we silently write through the page cache.
+ *
+ * Seeking waits for all pending chunks to be written,
+ * so it should only be done rarely, such as patching headers before stopping.
+ */
+class AsyncFOStream : public BaseMOStream {
+public:
+
+    /// Alignment of chunks in bytes
+    static constexpr std::size_t chunk_align = 4096;
+
+    AsyncFOStream() = default;
+
+    AsyncFOStream(std::string path) : filepath(std::move(path)) {}
+
+    AsyncFOStream(const AsyncFOStream&) = delete;
+
+    AsyncFOStream& operator=(const AsyncFOStream&) = delete;
+
+    /**
+     * @brief Destroys this mstream
+     *
+     * We write any pending data and close the file.
+     */
+    ~AsyncFOStream() { this->close(); }
+
+    /**
+     * @brief Gets the path to the file we are working with
+     *
+     * @return std::string Path to file
+     */
+    std::string get_path() const { return this->filepath; }
+
+    /**
+     * @brief Sets the path to the file we are working with
+     *
+     * @param path New path to file
+     */
+    void set_path(const std::string& path) { this->filepath = path; }
+
+    /**
+     * @brief Sets the size and number of chunks
+     *
+     * This must be done before we are started.
+     *
+     * @param size Size of each chunk in bytes
+     * @param num Number of chunks
+     */
+    void set_chunks(std::size_t size, int num) { this->chunk_size = std::max<std::size_t>(size, 1); this->chunk_num = std::max(num, 2); }
+
+    /**
+     * @brief Gets the size of each chunk
+     *
+     * @return std::size_t Size of each chunk in bytes
+     */
+    std::size_t get_chunk_size() const { return this->chunk_size; }
+
+    /**
+     * @brief Determines if we should write with O_DIRECT
+     *
+     * This must be done before we are started.
+     *
+     * @param val Whether to bypass the page cache
+     */
+    void set_direct(bool val) { this->direct = val; }
+
+    /**
+     * @brief Determines if we write with O_DIRECT
+     *
+     * @return true If we bypass the page cache
+     * @return false If we write through the page cache
+     */
+    bool get_direct() const { return this->direct; }
+
+    /**
+     * @brief Seeks to the given position
+     *
+     * We wait for all pending data to be written first.
+     *
+     * @param pos Position to seek to
+     */
+    void seek(int pos) final;
+
+    /**
+     * @brief Writes content to the file
+     *
+     * The content is copied into the current chunk,
+     * and written to the file at a later time.
+     *
+     * @param byts Bytes to write to a file
+     * @param num Number of bytes to be written
+     */
+    void write(char* byts, int num) final;
+
+    /**
+     * @brief Starts this mstream
+     *
+     * We open the file and start the background thread.
+     */
+    void start() final;
+
+    /**
+     * @brief Stops this mstream
+     *
+     * We write any pending data, stop the background thread and close the file.
+     */
+    void stop() final;
+
+private:
+
+    /// Chunk waiting to be written
+    struct Pending {
+
+        /// Index of the chunk
+        int index = 0;
+
+        /// Position in the file to write the chunk
+        int64_t offset = 0;
+
+        /// Number of bytes in the chunk
+        std::size_t size = 0;
+    };
+
+    /**
+     * @brief Hands the current chunk to the background thread
+     *
+     * We then grab a free chunk, waiting if there are none.
+     */
+    void submit();
+
+    /**
+     * @brief Waits until all chunks have been written
+     */
+    void drain();
+
+    /**
+     * @brief Writes pending chunks and closes the file
+     */
+    void close();
+
+    /**
+     * @brief Main loop of the background thread
+     */
+    void run();
+
+    /// Path to file we are working with
+    std::string filepath;
+
+    /// Size of each chunk in bytes
+    std::size_t chunk_size = 1 << 20;
+
+    /// Number of chunks
+    int chunk_num = 4;
+
+    /// Whether to write with O_DIRECT
+    bool direct = false;
+
+    /// File descriptor of the open file
+    int fd = -1;
+
+    /// Memory for all chunks
+    std::vector<char, AlignedAllocator<char, chunk_align>> memory;
+
+    /// Chunks waiting to be written
+    SPSCRing<Pending> full;
+
+    /// Chunks that can be filled
+    SPSCRing<int> empty;
+
+    /// Index of the chunk we are filling
+    int current = 0;
+
+    /// Number of bytes in the current chunk
+    std::size_t fill = 0;
+
+    /// Position in the file of the current chunk
+    int64_t position = 0;
+
+    /// Background thread
+    std::thread worker;
+
+    /// Determines if the background thread should keep running
+    std::atomic<bool> running{false};
+
+    /// Determines if a write has failed
+    std::atomic<bool> failed{false};
+
+    /// Number of chunks submitted, only changed by the writer
+    std::atomic<uint64_t> submitted{0};
+
+    /// Number of chunks written, only changed by the background thread
+    std::atomic<uint64_t> written{0};
+};
+
+/**
+ * @brief mstream that buffers another input mstream
+ *
+ * Reading many small pieces from an mstream can be slow,
+ * as each read is a virtual call, and may be a system call as well.
+ * This mstream reads large blocks from another mstream into a window of memory,
+ * and serves reads from this window.
+ *
+ * The window can also be inspected directly via peek() and consume(),
+ * which allows parsers to work with in-memory bytes without copying them out.
+ *
+ * We take ownership of starting and stopping the wrapped mstream.
+ * If the wrapped mstream holds its contents in memory,
+ * then we also expose them via contiguous(), as no buffering is needed.
+ */
+class BufferedIStream : public BaseMIStream {
+private:
+
+    /// mstream we are buffering
+    BaseMIStream* inner = nullptr;
+
+    /// Window of buffered bytes
+    std::vector<char> window;
+
+    /// Position of the window start in the wrapped mstream
+    std::size_t base = 0;
+
+    /// Position of the next byte in the window
+    std::size_t pos = 0;
+
+    /// Number of valid bytes in the window
+    std::size_t fill = 0;
+
+    /// Determines if the wrapped mstream has reached the end
+    bool ended = false;
+
+public:
+
+    /// Default size of the window in bytes
+    static constexpr std::size_t default_window = 65536;
+
+    BufferedIStream() = default;
+
+    BufferedIStream(BaseMIStream* stream, std::size_t size = default_window) : inner(stream), window(size) {}
+
+    /**
+     * @brief Sets the mstream to buffer
+     *
+     * @param stream mstream to buffer
+     */
+    void set_stream(BaseMIStream* stream) { this->inner = stream; }
+
+    /**
+     * @brief Gets the mstream we are buffering
+     *
+     * @return BaseMIStream* mstream we are buffering
+     */
+    BaseMIStream* get_stream() const { return this->inner; }
+
+    /**
+     * @brief Sets the size of the window
+     *
+     * This must be done before we are started.
+     *
+     * @param size New size of the window in bytes
+     */
+    void set_window(std::size_t size) { this->window.resize(std::max<std::size_t>(size, 1)); }
+
+    /**
+     * @brief Gets the size of the window
+     *
+     * @return std::size_t Size of the window in bytes
+     */
+    std::size_t get_window() const { return this->window.size(); }
+
+    /**
+     * @brief Gets the next bytes in the stream without consuming them
+     *
+     * We refill the window if less than num bytes are buffered.
+     * The returned span may be shorter than num if the end of the stream is near.
+     * It is only valid until the next operation on this mstream.
+     *
+     * @param num Number of bytes to inspect
+     * @return std::span<const char> Next bytes in the stream
+     */
+    std::span<const char> peek(std::size_t num);
+
+    /**
+     * @brief Consumes bytes from the stream
+     *
+     * This should be used after peek(),
+     * to skip the bytes that have been inspected.
+     *
+     * @param num Number of bytes to consume
+     */
+    void consume(std::size_t num) { this->pos += std::min(num, this->fill - this->pos); }
+
+    /**
+     * @brief Seeks to the given position
+     *
+     * If the position is in the window, we simply move within it.
+     * Otherwise, we seek the wrapped mstream and discard the window.
+     *
+     * @param pos Position to seek to
+     */
+    void seek(int pos) final;
+
+    /**
+     * @brief Reads bytes from the stream
+     *
+     * If we are asked to read beyond the end of the stream,
+     * then the remaining bytes are zeroed and this mstream is stopped.
+     *
+     * @param byts Char array to store results into
+     * @param num Number of bytes to read
+     */
+    void read(char* byts, int num) final;
+
+    /**
+     * @brief Reads up to a number of bytes from the stream
+     *
+     * @param byts Char array to store results into
+     * @param num Maximum number of bytes to read
+     * @return int Number of bytes read
+     */
+    int read_some(char* byts, int num) final;
+
+    /**
+     * @brief Gets the contents of the wrapped mstream, if they are in memory
+     *
+     * @return const char* Pointer to contents, or nullptr if unavailable
+     */
+    const char* contiguous() const final { return this->inner != nullptr ? this->inner->contiguous() : nullptr; }
+
+    /**
+     * @brief Gets the size of the wrapped mstream, if it is in memory
+     *
+     * @return std::size_t Number of bytes in the wrapped mstream
+     */
+    std::size_t length() const final { return this->inner != nullptr ? this->inner->length() : 0; }
+
+    /**
+     * @brief Starts this mstream, and the mstream we are buffering
+     *
+     */
+    void start() final;
+
+    /**
+     * @brief Stops this mstream, and the mstream we are buffering
+     *
+     */
+    void stop() final;
+};
@@ -0,0 +1,597 @@
+/**
+ * @file rtp.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Components for streaming audio over RTP
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Here we define modules that stream audio to and from remote endpoints using RTP over UDP.
+ * Audio is sent as linear PCM (L16 or L24, see RFC 3190),
+ * with the packet sizes and payloads used by AES67 and friends.
+ *
+ * The sink packetizes each block, and sends all the packets with a single batched write.
+ * The source receives packets on a background thread, and places them into a jitter buffer.
+ * The jitter buffer absorbs the variation in network delay,
+ * reorders packets, conceals lost packets, and adapts its delay to the network.
+ *
+ * These components only handle the media stream:
+ * session description (SDP) and clock synchronization (PTP) are left to the application.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dsp/convert.hpp"
+#include "io/udp.hpp"
+#include "sink_module.hpp"
+#include "source_module.hpp"
+
+/**
+ * @brief The fixed header of an RTP packet
+ *
+ * We can read and write the 12 byte fixed header,
+ * and skip any contributing sources, extensions and padding on packets we receive.
+ */
+struct RTPHeader {
+
+    /// Size of the fixed header in bytes
+    static constexpr int size = 12;
+
+    /// Payload type, 96 and above are dynamic
+    uint8_t payload = 96;
+
+    /// Marker bit, set on the first packet of a talkspurt
+    bool marker = false;
+
+    /// Sequence number, incremented for each packet
+    uint16_t sequence = 0;
+
+    /// Timestamp of the first frame in the packet
+    uint32_t timestamp = 0;
+
+    /// Synchronization source identifier
+    uint32_t ssrc = 0;
+
+    /**
+     * @brief Writes this header
+     *
+     * @param data Pointer to at least size bytes
+     */
+    void write(char* data) const;
+
+    /**
+     * @brief Reads a header from a packet
+     *
+     * @param data Pointer to the packet
+     * @param num Number of bytes in the packet
+     * @param payload_size Where the number of payload bytes is stored
+     * @return int Offset of the payload, or -1 if this is not a valid RTP packet
+     */
+    int read(const char* data, int num, int* payload_size);
+};
+
+/**
+ * @brief Jitter buffer for RTP packets
+ *
+ * Packets are decoded straight into a fixed number of slots,
+ * indexed by their sequence number.
+ * A single thread pushes packets, and a single thread pops frames,
+ * and neither ever waits on the other or allocates.
+ * The slot of a packet is published with its sequence number,
+ * so the reader only touches slots that are complete.
+ *
+ * Playout starts once the buffered audio reaches the target delay.
+ * We estimate the interarrival jitter like RFC 3550,
+ * and keep the target delay at three times the jitter above the minimum,
+ * up to the maximum delay.
+ *
+ * Packets that arrive after their turn are discarded.
+ * Packets that never arrive are concealed with silence,
+ * and we stop to rebuffer if we run out of packets.
+ * If the buffered audio grows well past the target delay
+ * (because the sender's clock is faster than ours, or the network settled down),
+ * we skip a packet to bring the delay back down.
+ */
+class RTPJitterBuffer {
+
+    public:
+
+        /**
+         * @brief Allocates the slots
+         *
+         * This must not be done while packets are pushed or popped.
+         *
+         * @param num Number of slots, rounded up to a power of 2
+         * @param channels Number of channels in each packet
+         * @param max_frames Largest number of frames in a packet
+         * @param rate Sample rate of the stream
+         */
+        void configure(int num, int channels, int max_frames, double rate);
+
+        /**
+         * @brief Sets the range of the target delay
+         *
+         * @param min_frames Smallest delay in frames
+         * @param max_frames Largest delay in frames
+         */
+        void set_delay(int min_frames, int max_frames);
+
+        /**
+         * @brief Decodes a packet into its slot
+         *
+         * This should only be called by the thread receiving packets.
+         *
+         * @param sequence Sequence number of the packet
+         * @param timestamp Timestamp of the packet
+         * @param format Format of the payload, PCMFormat::s16 or PCMFormat::s24
+         * @param payload Pointer to the big endian payload
+         * @param bytes Number of bytes in the payload
+         * @param arrival Time the packet arrived in nanoseconds
+         * @return true If the packet was buffered
+         */
+        bool push(uint16_t sequence, uint32_t timestamp, PCMFormat format, const char* payload, std::size_t bytes, int64_t arrival);
+
+        /**
+         * @brief Pops interleaved frames from the buffer
+         *
+         * Frames we do not have are filled with silence.
+         * This should only be called by the thread processing audio.
+         *
+         * @param output Pointer to room for frames * channels samples
+         * @param frames Number of frames to pop
+         * @return int Number of frames taken from packets
+         */
+        int pop(sample_t* output, int frames);
+
+        /**
+         * @brief Forgets every packet and statistic
+         *
+         * This must not be done while packets are pushed or popped.
+         */
+        void reset();
+
+        /**
+         * @brief Gets the number of frames waiting to be popped
+         *
+         * This counts whole packets, including any that are still missing.
+         *
+         * @return int Number of buffered frames
+         */
+        int buffered() const;
+
+        /**
+         * @brief Gets the current target delay
+         *
+         * @return int Target delay in frames
+         */
+        int target() const;
+
+        /**
+         * @brief Gets the estimated interarrival jitter
+         *
+         * @return double Jitter in frames
+         */
+        double get_jitter() const { return this->jitter.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Gets the number of packets that never arrived
+         *
+         * @return int Number of concealed packets
+         */
+        int get_lost() const { return this->lost.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Gets the number of packets that arrived too late
+         *
+         * @return int Number of late packets
+         */
+        int get_late() const { return this->late.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Gets the number of packets skipped to reduce the delay
+         *
+         * @return int Number of skipped packets
+         */
+        int get_skipped() const { return this->skipped.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Gets the number of times we ran out of packets
+         *
+         * @return int Number of underruns
+         */
+        int get_underruns() const { return this->underruns.load(std::memory_order_relaxed); }
+
+    private:
+
+        /// A decoded packet
+        struct Slot {
+
+            /// Extended sequence number of the packet plus one, 0 if never used
+            std::atomic<uint32_t> tag{0};
+
+            /// Number of frames in the packet
+            int frames = 0;
+
+            /// Interleaved samples of the packet
+            std::vector<sample_t> samples;
+        };
+
+        /// Slots for each packet
+        std::unique_ptr<Slot[]> slots;
+
+        /// Number of slots
+        uint32_t count = 0;
+
+        /// Number of channels in each packet
+        int channels = 0;
+
+        /// Largest number of frames in a packet
+        int max_frames = 0;
+
+        /// Sample rate of the stream
+        double rate = 48000;
+
+        /// Smallest target delay in frames
+        int min_delay = 96;
+
+        /// Largest target delay in frames
+        int max_delay = 4800;
+
+        /// Value determining if the first packet has arrived
+        std::atomic<bool> primed{false};
+
+        /// Extended sequence number of the next packet to pop
+        std::atomic<uint32_t> next{0};
+
+        /// Highest extended sequence number pushed
+        std::atomic<uint32_t> newest{0};
+
+        /// Value determining if the reader should move to resync_to
+        std::atomic<bool> resync{false};
+
+        /// Extended sequence number the reader should move to
+        std::atomic<uint32_t> resync_to{0};
+
+        /// Number of frames in the largest packet
+        std::atomic<int> packet_frames{0};
+
+        /// Estimated interarrival jitter in frames
+        std::atomic<double> jitter{0};
+
+        /// Number of concealed packets
+        std::atomic<int> lost{0};
+
+        /// Number of late packets
+        std::atomic<int> late{0};
+
+        /// Number of skipped packets
+        std::atomic<int> skipped{0};
+
+        /// Number of underruns
+        std::atomic<int> underruns{0};
+
+        /// Highest extended sequence number, used by the writer to unwrap sequence numbers
+        uint32_t highest = 0;
+
+        /// Arrival time of the last packet in frames, used by the writer
+        double last_arrival = 0;
+
+        /// Timestamp of the last packet, used by the writer
+        uint32_t last_timestamp = 0;
+
+        /// Value determining if the reader is waiting for the target delay
+        bool buffering = true;
+
+        /// Number of frames already popped from the next packet
+        int offset = 0;
+};
+
+/**
+ * @brief Streams audio to a remote endpoint over RTP
+ *
+ * Each block is split into packets of a fixed number of frames
+ * (48 by default, which is 1 ms at 48 kHz like AES67),
+ * encoded as big endian L16 or L24, and sent with a single batched write.
+ * Every packet is full: frames left over at the end of a block are sent with the next block.
+ * Packets are limited to MAX_PAYLOAD bytes of audio so they fit in a typical MTU.
+ *
+ * The sequence number, timestamp and SSRC start at random values,
+ * as RFC 3550 recommends.
+ */
+class RTPSink : public SinkModule {
+
+    public:
+
+        /// Largest number of payload bytes in a packet
+        static constexpr int MAX_PAYLOAD = 1440;
+
+        /**
+         * @brief Construct a new RTPSink object
+         *
+         * @param host Host or address to stream to
+         * @param port Port to stream to
+         */
+        explicit RTPSink(const std::string& host = "127.0.0.1", int port = 5004);
+
+        /**
+         * @brief Packetizes and sends the current buffer
+         */
+        void process() override;
+
+        /**
+         * @brief Opens the socket and prepares the packets
+         */
+        void start() override;
+
+        /**
+         * @brief Closes the socket
+         */
+        void stop() override;
+
+        /**
+         * @brief Sets the format of the payload
+         *
+         * @param val PCMFormat::s16 for L16, or PCMFormat::s24 for L24
+         */
+        void set_format(PCMFormat val) { this->format = val; }
+
+        /**
+         * @brief Gets the format of the payload
+         *
+         * @return PCMFormat Format of the payload
+         */
+        PCMFormat get_format() const { return this->format; }
+
+        /**
+         * @brief Sets the number of frames in each packet
+         *
+         * This is reduced if the packets would not fit in MAX_PAYLOAD bytes.
+         *
+         * @param num Number of frames per packet
+         */
+        void set_packet_frames(int num) { this->packet_frames = std::max(num, 1); }
+
+        /**
+         * @brief Gets the number of frames in each packet
+         *
+         * @param channels Number of channels being sent
+         * @return int Number of frames per packet
+         */
+        int get_packet_frames(int channels) const;
+
+        /**
+         * @brief Sets the payload type of our packets
+         *
+         * @param val Payload type, usually a dynamic type of 96 and above
+         */
+        void set_payload_type(int val) { this->header.payload = static_cast<uint8_t>(val & 0x7F); }
+
+        /**
+         * @brief Sets the synchronization source identifier
+         *
+         * @param val SSRC of our stream
+         */
+        void set_ssrc(uint32_t val) { this->header.ssrc = val; }
+
+        /**
+         * @brief Gets the synchronization source identifier
+         *
+         * @return uint32_t SSRC of our stream
+         */
+        uint32_t get_ssrc() const { return this->header.ssrc; }
+
+        /**
+         * @brief Gets the number of packets we have sent
+         *
+         * @return uint64_t Number of packets sent since starting
+         */
+        uint64_t get_packets() const { return this->packets; }
+
+        /**
+         * @brief Gets the mstream we send packets with
+         *
+         * @return UDPOStream* mstream we send with
+         */
+        UDPOStream* get_stream() { return &(this->stream); }
+
+    private:
+
+        /**
+         * @brief Ensures the scratch space fits a block
+         *
+         * @param channels Number of channels in the block
+         * @param frames Number of frames in the block
+         */
+        void prepare(int channels, int frames);
+
+        /// mstream we send packets with
+        UDPOStream stream;
+
+        /// Header of the next packet
+        RTPHeader header;
+
+        /// Format of the payload
+        PCMFormat format = PCMFormat::s24;
+
+        /// Number of frames in each packet
+        int packet_frames = 48;
+
+        /// Number of packets sent since starting
+        uint64_t packets = 0;
+
+        /// Interleaved frames waiting to be sent
+        std::vector<sample_t> inter;
+
+        /// Number of frames carried from the last block
+        int carried = 0;
+
+        /// Number of channels in the carried frames
+        int staged_channels = 0;
+
+        /// Packets being sent
+        std::vector<char> data;
+
+        /// Pointer to each packet
+        std::vector<char*> ptrs;
+
+        /// Size of each packet
+        std::vector<int> sizes;
+};
+
+/**
+ * @brief Receives audio from a remote endpoint over RTP
+ *
+ * A background thread receives packets in batches, and decodes them into the jitter buffer.
+ * Each block we output is popped from the jitter buffer,
+ * so processing never waits on the network.
+ *
+ * We lock on to the SSRC of the first packet we receive, and ignore all others until stopped.
+ * The stream is expected to have the channels and format we are configured with,
+ * and run at the sample rate of the chain.
+ */
+class RTPSource : public SourceModule {
+
+    public:
+
+        /**
+         * @brief Construct a new RTPSource object
+         *
+         * @param port Port to receive on, 0 to pick a free port
+         * @param num Number of channels in the stream
+         */
+        explicit RTPSource(int port = 5004, int num = 2) : stream(port), channels(num) {}
+
+        /**
+         * @brief Destroy the RTPSource object
+         *
+         * We stop the receiving thread if it is running.
+         */
+        ~RTPSource() override { this->stop(); }
+
+        RTPSource(const RTPSource&) = delete;
+        RTPSource& operator=(const RTPSource&) = delete;
+        RTPSource(RTPSource&&) = delete;
+        RTPSource& operator=(RTPSource&&) = delete;
+
+        /**
+         * @brief Pops a block from the jitter buffer
+         */
+        void process() override;
+
+        /**
+         * @brief Sets our channels from the stream
+         */
+        void info_sync() override;
+
+        /**
+         * @brief Opens the socket and starts receiving
+         */
+        void start() override;
+
+        /**
+         * @brief Stops receiving and closes the socket
+         */
+        void stop() override;
+
+        /**
+         * @brief Sets the format of the payload
+         *
+         * @param val PCMFormat::s16 for L16, or PCMFormat::s24 for L24
+         */
+        void set_format(PCMFormat val) { this->format = val; }
+
+        /**
+         * @brief Sets the payload type we accept
+         *
+         * @param val Payload type, or -1 to accept any
+         */
+        void set_payload_type(int val) { this->payload = val; }
+
+        /**
+         * @brief Sets the range of the delay added by the jitter buffer
+         *
+         * @param min_frames Smallest delay in frames
+         * @param max_frames Largest delay in frames
+         */
+        void set_delay(int min_frames, int max_frames) { this->jitter.set_delay(min_frames, max_frames); }
+
+        /**
+         * @brief Sets the number of packets the jitter buffer can hold
+         *
+         * This must be set before we are started.
+         *
+         * @param num Number of packets, rounded up to a power of 2
+         */
+        void set_slots(int num) { this->slots = num; }
+
+        /**
+         * @brief Gets the jitter buffer, for statistics
+         *
+         * @return const RTPJitterBuffer* Jitter buffer we pop from
+         */
+        const RTPJitterBuffer* get_jitter_buffer() const { return &(this->jitter); }
+
+        /**
+         * @brief Gets the mstream we receive packets with
+         *
+         * @return UDPIStream* mstream we receive with
+         */
+        UDPIStream* get_stream() { return &(this->stream); }
+
+        /**
+         * @brief Gets the number of packets we have received
+         *
+         * @return uint64_t Number of packets received since starting
+         */
+        uint64_t get_packets() const { return this->packets.load(std::memory_order_relaxed); }
+
+    private:
+
+        /**
+         * @brief Main loop of the receiving thread
+         */
+        void run();
+
+        /// mstream we receive packets with
+        UDPIStream stream;
+
+        /// Jitter buffer the packets are decoded into
+        RTPJitterBuffer jitter;
+
+        /// Number of channels in the stream
+        int channels = 2;
+
+        /// Format of the payload
+        PCMFormat format = PCMFormat::s24;
+
+        /// Payload type we accept, -1 for any
+        int payload = -1;
+
+        /// Number of packets the jitter buffer can hold
+        int slots = 256;
+
+        /// Number of packets received in a batch
+        int batch = 32;
+
+        /// Thread receiving packets
+        std::thread receiver;
+
+        /// Value determining if the receiving thread should keep running
+        std::atomic<bool> running{false};
+
+        /// Number of packets received
+        std::atomic<uint64_t> packets{0};
+
+        /// Interleaved samples when buffers are planar
+        std::vector<sample_t> inter;
+};
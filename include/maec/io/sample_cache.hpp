@@ -0,0 +1,569 @@
+/**
+ * @file sample_cache.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief A shared cache of decoded samples
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Sampler instruments play the same few files over and over, from many voices at once.
+ * Giving each voice a WaveSource means every voice opens and parses its file when it starts,
+ * and decodes its own copy of the audio.
+ *
+ * Here we define a cache which parses each file once, and shares the decoded audio
+ * between every voice playing it.
+ * Small samples are decoded completely.
+ * Large samples only have their first few milliseconds decoded (the attack),
+ * so voices can start instantly, while the rest is streamed from a memory map
+ * by a background thread that stays ahead of every playing voice.
+ *
+ * The decoded audio is kept under a memory budget,
+ * and samples that have not been used recently are evicted first.
+ * Samples that are playing are never evicted.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "dsp/convert.hpp"
+#include "dsp/ring.hpp"
+#include "io/mstream.hpp"
+#include "source_module.hpp"
+
+/**
+ * @brief A sample held by the SampleCache
+ *
+ * We hold the format of the sample, and its decoded interleaved frames.
+ * If only the attack has been decoded,
+ * we also hold a memory map of the file the rest is streamed from.
+ * Samples are immutable once loaded, so they can be shared between threads.
+ */
+class CachedSample {
+
+    public:
+
+        /**
+         * @brief Gets the path of the sample
+         *
+         * @return const std::string& Path to the file
+         */
+        const std::string& get_path() const { return this->path; }
+
+        /**
+         * @brief Gets the number of channels
+         *
+         * @return int Number of channels
+         */
+        int get_channels() const { return this->channels; }
+
+        /**
+         * @brief Gets the sample rate
+         *
+         * @return int Sample rate of the file
+         */
+        int get_samplerate() const { return this->sample_rate; }
+
+        /**
+         * @brief Gets the number of frames in the sample
+         *
+         * @return int64_t Number of frames
+         */
+        int64_t get_frames() const { return this->frames; }
+
+        /**
+         * @brief Gets the number of frames that have been decoded
+         *
+         * @return int64_t Number of frames held in memory
+         */
+        int64_t get_head_frames() const { return this->head_frames; }
+
+        /**
+         * @brief Gets the decoded interleaved frames
+         *
+         * @return const sample_t* Pointer to the first get_head_frames() frames
+         */
+        const sample_t* get_head() const { return this->head.data(); }
+
+        /**
+         * @brief Determines if the whole sample has been decoded
+         *
+         * @return true If no streaming is necessary
+         */
+        bool complete() const { return this->head_frames >= this->frames; }
+
+        /**
+         * @brief Gets the memory used by the decoded frames
+         *
+         * @return std::size_t Size in bytes
+         */
+        std::size_t bytes() const { return this->head.size() * sizeof(sample_t); }
+
+        /**
+         * @brief Decodes frames straight from the memory map
+         *
+         * This is used to stream the frames after the attack.
+         *
+         * @param frame First frame to decode
+         * @param num Number of frames to decode
+         * @param output Pointer to room for num interleaved frames
+         * @return int64_t Number of frames decoded
+         */
+        int64_t decode(int64_t frame, int64_t num, sample_t* output) const;
+
+    private:
+
+        /// Path to the file
+        std::string path;
+
+        /// Number of channels
+        int channels = 1;
+
+        /// Sample rate of the file
+        int sample_rate = 44100;
+
+        /// Format of the raw samples
+        PCMFormat format = PCMFormat::none;
+
+        /// Number of bytes in a raw frame
+        int blockalign = 0;
+
+        /// Number of frames in the sample
+        int64_t frames = 0;
+
+        /// Number of frames decoded
+        int64_t head_frames = 0;
+
+        /// Decoded interleaved frames
+        std::vector<sample_t> head;
+
+        /// Memory map of the file, if the sample is streamed
+        std::unique_ptr<MMapIStream> map;
+
+        /// Pointer to the raw frames in the memory map
+        const char* data = nullptr;
+
+        friend class SampleCache;
+};
+
+/**
+ * @brief Shares decoded samples between many sources
+ *
+ * Use get() to fetch a sample, which is loaded if it is not in the cache.
+ * Samples are loaded through a WaveReader on a memory map of the file.
+ * If a decoded sample is no larger than the threshold, it is decoded completely.
+ * Otherwise, only the first preload milliseconds are decoded,
+ * and the remaining frames are streamed when played (see SampleSource).
+ *
+ * Once the decoded samples use more memory than the budget,
+ * we evict the least recently used samples that are not being played.
+ *
+ * Streamed samples are read ahead by a single background thread,
+ * which tops up a ring for each playing source.
+ * The thread is started by the first stream, and stopped when the cache is destroyed.
+ *
+ * get() and the stream methods are thread safe,
+ * but may block, so they should not be called from the audio thread.
+ * The cache must outlive any source that uses it.
+ */
+class SampleCache {
+
+    public:
+
+        /**
+         * @brief A ring of frames streamed for a single source
+         */
+        class Stream {
+
+            public:
+
+                /**
+                 * @brief Reads streamed interleaved frames
+                 *
+                 * This will not block, and wakes the streaming thread so it can read ahead.
+                 *
+                 * @param output Pointer to room for num frames
+                 * @param num Number of frames to read
+                 * @return int Number of frames read
+                 */
+                int read(sample_t* output, int num);
+
+                /**
+                 * @brief Determines if every frame has been streamed into the ring
+                 *
+                 * @return true If the streaming thread has reached the end of the sample
+                 */
+                bool finished() const { return this->drained.load(std::memory_order_acquire); }
+
+                /**
+                 * @brief Gets the number of bytes held by the ring
+                 *
+                 * @return std::size_t Number of bytes held
+                 */
+                std::size_t bytes() const { return this->ring.capacity() * sizeof(sample_t); }
+
+            private:
+
+                /// Sample we are streaming
+                std::shared_ptr<const CachedSample> sample;
+
+                /// Cache that streams us
+                SampleCache* cache = nullptr;
+
+                /// Decoded interleaved frames waiting to be read
+                SPSCRing<sample_t> ring;
+
+                /// Next frame to stream, only used by the streaming thread
+                int64_t next = 0;
+
+                /// Value determining if every frame has been streamed
+                std::atomic<bool> drained{false};
+
+                friend class SampleCache;
+        };
+
+        /**
+         * @brief Construct a new SampleCache object
+         *
+         * @param limit Memory budget in bytes
+         */
+        explicit SampleCache(std::size_t limit = DEFAULT_BUDGET) : budget(limit) {}
+
+        /**
+         * @brief Destroy the SampleCache object
+         *
+         * We stop the streaming thread.
+         */
+        ~SampleCache();
+
+        SampleCache(const SampleCache&) = delete;
+        SampleCache& operator=(const SampleCache&) = delete;
+        SampleCache(SampleCache&&) = delete;
+        SampleCache& operator=(SampleCache&&) = delete;
+
+        /// Default memory budget, in bytes
+        static constexpr std::size_t DEFAULT_BUDGET = std::size_t{256} << 20;
+
+        /**
+         * @brief Gets a sample, loading it if necessary
+         *
+         * @param path Path to the wave file
+         * @return std::shared_ptr<const CachedSample> Sample, or nullptr if it could not be loaded
+         */
+        std::shared_ptr<const CachedSample> get(const std::string& path);
+
+        /**
+         * @brief Opens a stream of the frames after the attack
+         *
+         * @param sample Sample to stream
+         * @return std::shared_ptr<Stream> Stream to read from
+         */
+        std::shared_ptr<Stream> open_stream(std::shared_ptr<const CachedSample> sample);
+
+        /**
+         * @brief Closes a stream
+         *
+         * @param stream Stream to close
+         */
+        void close_stream(const std::shared_ptr<Stream>& stream);
+
+        /**
+         * @brief Sets the memory budget
+         *
+         * Samples are evicted immediately if we are over the new budget.
+         *
+         * @param limit Memory budget in bytes
+         */
+        void set_budget(std::size_t limit);
+
+        /**
+         * @brief Gets the memory budget
+         *
+         * @return std::size_t Memory budget in bytes
+         */
+        std::size_t get_budget() const { return this->budget; }
+
+        /**
+         * @brief Sets the length of the attack decoded for large samples
+         *
+         * This only affects samples loaded afterwards.
+         *
+         * @param msec Length of the attack in milliseconds
+         */
+        void set_preload(int msec) { this->preload = std::max(msec, 1); }
+
+        /**
+         * @brief Sets the largest decoded size of a sample that is decoded completely
+         *
+         * This only affects samples loaded afterwards.
+         *
+         * @param size Threshold in bytes
+         */
+        void set_threshold(std::size_t size) { this->threshold = size; }
+
+        /**
+         * @brief Sets the number of frames read ahead of each stream
+         *
+         * This only affects streams opened afterwards.
+         *
+         * @param num Number of frames
+         */
+        void set_read_ahead(int num) { this->ahead = std::max(num, 1); }
+
+        /**
+         * @brief Gets the memory used by decoded samples
+         *
+         * @return std::size_t Size in bytes
+         */
+        std::size_t get_memory() const;
+
+        /**
+         * @brief Gets the number of samples in the cache
+         *
+         * @return std::size_t Number of samples
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Gets the number of times get() found the sample in the cache
+         *
+         * @return uint64_t Number of hits
+         */
+        uint64_t get_hits() const { return this->hits.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Gets the number of times get() had to load the sample
+         *
+         * @return uint64_t Number of misses
+         */
+        uint64_t get_misses() const { return this->misses.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Gets the number of samples evicted
+         *
+         * @return uint64_t Number of evictions
+         */
+        uint64_t get_evictions() const { return this->evictions.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Removes every sample that is not being played
+         */
+        void clear();
+
+    private:
+
+        /// A sample in the cache
+        struct Entry {
+
+            /// The sample
+            std::shared_ptr<CachedSample> sample;
+
+            /// Position of the sample in the usage order
+            std::list<std::string>::iterator pos;
+        };
+
+        /**
+         * @brief Loads and decodes a sample
+         *
+         * @param path Path to the wave file
+         * @return std::shared_ptr<CachedSample> Sample, or nullptr if it could not be loaded
+         */
+        std::shared_ptr<CachedSample> load(const std::string& path) const;
+
+        /**
+         * @brief Evicts samples until we are under the budget
+         *
+         * The lock must be held.
+         *
+         * @param limit Memory budget to get under
+         */
+        void evict(std::size_t limit);
+
+        /**
+         * @brief Wakes the streaming thread
+         */
+        void wake();
+
+        /**
+         * @brief Main loop of the streaming thread
+         */
+        void run();
+
+        /// Lock protecting the samples and streams
+        mutable std::mutex lock;
+
+        /// Samples in the cache
+        std::unordered_map<std::string, Entry> entries;
+
+        /// Paths of the samples, most recently used first
+        std::list<std::string> order;
+
+        /// Memory used by decoded samples
+        std::size_t memory = 0;
+
+        /// Memory budget in bytes
+        std::size_t budget = DEFAULT_BUDGET;
+
+        /// Largest decoded size of a sample that is decoded completely
+        std::size_t threshold = std::size_t{4} << 20;
+
+        /// Length of the attack decoded for large samples, in milliseconds
+        int preload = 100;
+
+        /// Number of frames read ahead of each stream
+        int ahead = 16384;
+
+        /// Streams being read ahead
+        std::vector<std::shared_ptr<Stream>> streams;
+
+        /// Streaming thread
+        std::thread streamer;
+
+        /// Value determining if the streaming thread should keep running
+        std::atomic<bool> running{false};
+
+        /// Incremented to wake the streaming thread
+        std::atomic<uint64_t> wakes{0};
+
+        /// Number of hits
+        std::atomic<uint64_t> hits{0};
+
+        /// Number of misses
+        std::atomic<uint64_t> misses{0};
+
+        /// Number of evictions
+        std::atomic<uint64_t> evictions{0};
+};
+
+/**
+ * @brief Plays a sample from a SampleCache
+ *
+ * This is a lightweight replacement for WaveSource when many voices play the same files.
+ * When started, we fetch our sample from the cache (which only loads it the first time),
+ * and play the decoded attack straight from the cache.
+ * If the sample is streamed, the remaining frames are read from a stream
+ * that the cache fills in the background.
+ * If the stream falls behind, we output silence and count an underrun.
+ *
+ * Once every frame has been played, we output silence.
+ */
+class SampleSource : public SourceModule {
+
+    public:
+
+        /**
+         * @brief Construct a new SampleSource object
+         *
+         * @param samples Cache to fetch samples from
+         * @param file Path to the wave file to play
+         */
+        SampleSource(SampleCache& samples, std::string file) : cache(&samples), path(std::move(file)) {}
+
+        /**
+         * @brief Destroy the SampleSource object
+         *
+         * We close our stream.
+         */
+        ~SampleSource() override { this->stop(); }
+
+        SampleSource(const SampleSource&) = delete;
+        SampleSource& operator=(const SampleSource&) = delete;
+        SampleSource(SampleSource&&) = delete;
+        SampleSource& operator=(SampleSource&&) = delete;
+
+        /**
+         * @brief Outputs the next block of the sample
+         */
+        void process() override;
+
+        /**
+         * @brief Fetches the sample, and opens a stream if necessary
+         */
+        void start() override;
+
+        /**
+         * @brief Closes the stream and releases the sample
+         */
+        void stop() override;
+
+        /**
+         * @brief Adds the memory held by this source
+         *
+         * We count the decoded frames of the sample, and the ring of our stream.
+         * Samples are shared through the cache, so every source playing a sample counts it.
+         *
+         * @param usage Footprint to add to
+         */
+        void footprint(MemoryFootprint& usage) const override;
+
+        /**
+         * @brief Sets the path of the sample to play
+         *
+         * This takes effect when we are next started.
+         *
+         * @param file Path to the wave file
+         */
+        void set_path(const std::string& file) { this->path = file; }
+
+        /**
+         * @brief Gets the sample we are playing
+         *
+         * @return const CachedSample* Sample, or nullptr if not started
+         */
+        const CachedSample* get_sample() const { return this->sample.get(); }
+
+        /**
+         * @brief Gets the stream of the frames after the attack
+         *
+         * @return const SampleCache::Stream* Stream, or nullptr if the sample is not streamed
+         */
+        const SampleCache::Stream* get_stream() const { return this->stream.get(); }
+
+        /**
+         * @brief Determines if every frame has been played
+         *
+         * @return true If we are done
+         */
+        bool done() const { return this->sample == nullptr || this->position >= this->sample->get_frames(); }
+
+        /**
+         * @brief Gets the number of blocks the stream fell behind on
+         *
+         * @return uint64_t Number of underruns
+         */
+        uint64_t get_underruns() const { return this->underruns; }
+
+    private:
+
+        /// Cache to fetch samples from
+        SampleCache* cache = nullptr;
+
+        /// Path to the sample
+        std::string path;
+
+        /// Sample we are playing
+        std::shared_ptr<const CachedSample> sample;
+
+        /// Stream of the frames after the attack
+        std::shared_ptr<SampleCache::Stream> stream;
+
+        /// Next frame to play
+        int64_t position = 0;
+
+        /// Number of underruns
+        uint64_t underruns = 0;
+
+        /// Interleaved frames when buffers are planar
+        std::vector<sample_t> frames;
+};
@@ -0,0 +1,341 @@
+/**
+ * @file udp.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief mstreams that send and receive UDP datagrams
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This file defines mstreams that work with UDP sockets.
+ * Unlike the other mstreams, these are message based:
+ * each write sends a single datagram, and each read receives a single datagram.
+ *
+ * Because audio is sent as many small datagrams,
+ * both mstreams also offer batched operations that send or receive many datagrams
+ * with a single system call (sendmmsg() and recvmmsg() on Linux).
+ * On other platforms, batches are sent and received one datagram at a time.
+ */
+
+#pragma once
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "io/mstream.hpp"
+
+/**
+ * @brief mstream that sends UDP datagrams
+ *
+ * We send datagrams to a single destination, which may be a multicast group.
+ * The destination is resolved when we are started.
+ */
+class UDPOStream : public BaseMOStream {
+public:
+
+    UDPOStream() = default;
+
+    /**
+     * @brief Construct a new UDPOStream object
+     *
+     * @param dhost Host or address to send to
+     * @param dport Port to send to
+     */
+    UDPOStream(std::string dhost, int dport) : host(std::move(dhost)), port(dport) {}
+
+    UDPOStream(const UDPOStream&) = delete;
+
+    UDPOStream& operator=(const UDPOStream&) = delete;
+
+    /**
+     * @brief Destroys this mstream, closing the socket
+     */
+    ~UDPOStream() { this->close(); }
+
+    /**
+     * @brief Sets the destination of the datagrams
+     *
+     * This must be done before we are started.
+     *
+     * @param dhost Host or address to send to
+     * @param dport Port to send to
+     */
+    void set_destination(const std::string& dhost, int dport) { this->host = dhost; this->port = dport; }
+
+    /**
+     * @brief Sets the time to live of multicast datagrams
+     *
+     * This must be done before we are started.
+     *
+     * @param val Number of hops multicast datagrams may take
+     */
+    void set_ttl(int val) { this->ttl = val; }
+
+    /**
+     * @brief Sets the DSCP value of our datagrams
+     *
+     * Audio is usually sent with expedited forwarding (46),
+     * so routers prioritize it.
+     * This must be done before we are started.
+     *
+     * @param val DSCP value, or -1 to leave it alone
+     */
+    void set_dscp(int val) { this->dscp = val; }
+
+    /**
+     * @brief Does nothing, datagrams can't be seeked
+     */
+    void seek(int /*pos*/) final {}
+
+    /**
+     * @brief Sends a single datagram
+     *
+     * @param byts Contents of the datagram
+     * @param num Number of bytes in the datagram
+     */
+    void write(char* byts, int num) final;
+
+    /**
+     * @brief Sends a batch of datagrams
+     *
+     * Datagrams that could not be sent are counted, see get_errors().
+     *
+     * @param datagrams Pointer to the contents of each datagram
+     * @param sizes Number of bytes in each datagram
+     * @param num Number of datagrams to send
+     * @return int Number of datagrams sent
+     */
+    int write_batch(char* const* datagrams, const int* sizes, int num);
+
+    /**
+     * @brief Ensures batches of up to num datagrams can be sent without allocating
+     *
+     * @param num Number of datagrams
+     */
+    void reserve(int num);
+
+    /**
+     * @brief Gets the number of datagrams that could not be sent
+     *
+     * @return int Number of failed datagrams
+     */
+    int get_errors() const { return this->errors; }
+
+    /**
+     * @brief Starts this mstream
+     *
+     * We resolve the destination and open the socket.
+     * If this fails, we are put into the error state.
+     */
+    void start() final;
+
+    /**
+     * @brief Stops this mstream, closing the socket
+     */
+    void stop() final;
+
+private:
+
+    /**
+     * @brief Closes the socket
+     */
+    void close();
+
+    /// Host or address to send to
+    std::string host = "127.0.0.1";
+
+    /// Port to send to
+    int port = 5004;
+
+    /// Time to live of multicast datagrams
+    int ttl = 1;
+
+    /// DSCP value of our datagrams
+    int dscp = -1;
+
+    /// Socket we send with
+    int fd = -1;
+
+    /// Address we send to
+    sockaddr_storage dest{};
+
+    /// Length of the address we send to
+    socklen_t dest_len = 0;
+
+    /// Number of datagrams that could not be sent
+    int errors = 0;
+
+#ifdef __linux__
+
+    /// Message headers for batched writes
+    std::vector<mmsghdr> msgs;
+
+#endif
+
+    /// Buffers for batched writes
+    std::vector<iovec> iovs;
+};
+
+/**
+ * @brief mstream that receives UDP datagrams
+ *
+ * We bind to a local port, and optionally join a multicast group.
+ * Reads wait up to the timeout for a datagram,
+ * so a receiving thread can check if it should stop.
+ */
+class UDPIStream : public BaseMIStream {
+public:
+
+    UDPIStream() = default;
+
+    /**
+     * @brief Construct a new UDPIStream object
+     *
+     * @param bport Port to bind to, 0 to pick a free port
+     */
+    explicit UDPIStream(int bport) : port(bport) {}
+
+    UDPIStream(const UDPIStream&) = delete;
+
+    UDPIStream& operator=(const UDPIStream&) = delete;
+
+    /**
+     * @brief Destroys this mstream, closing the socket
+     */
+    ~UDPIStream() { this->close(); }
+
+    /**
+     * @brief Sets the port to bind to
+     *
+     * This must be done before we are started.
+     *
+     * @param bport Port to bind to, 0 to pick a free port
+     */
+    void set_port(int bport) { this->port = bport; }
+
+    /**
+     * @brief Gets the port we are bound to
+     *
+     * If we were asked to pick a free port,
+     * this is the port we picked once started.
+     *
+     * @return int Port we are bound to
+     */
+    int get_port() const { return this->port; }
+
+    /**
+     * @brief Sets the IPv4 multicast group to join
+     *
+     * This must be done before we are started.
+     *
+     * @param addr Address of the group, empty to not join a group
+     */
+    void set_group(const std::string& addr) { this->group = addr; }
+
+    /**
+     * @brief Sets the time reads wait for a datagram
+     *
+     * @param msec Timeout in milliseconds, negative to wait forever
+     */
+    void set_timeout(int msec) { this->timeout = msec; }
+
+    /**
+     * @brief Does nothing, datagrams can't be seeked
+     */
+    void seek(int /*pos*/) final {}
+
+    /**
+     * @brief Receives a single datagram
+     *
+     * Bytes of the datagram past num are discarded,
+     * and any bytes we did not receive are zeroed.
+     *
+     * @param byts Char array to store the datagram into
+     * @param num Size of the array
+     */
+    void read(char* byts, int num) final;
+
+    /**
+     * @brief Receives a single datagram
+     *
+     * @param byts Char array to store the datagram into
+     * @param num Size of the array
+     * @return int Number of bytes received, 0 if we timed out
+     */
+    int read_some(char* byts, int num) final;
+
+    /**
+     * @brief Receives a batch of datagrams
+     *
+     * We wait up to the timeout for the first datagram,
+     * and then take any others that are already waiting.
+     *
+     * @param byts Space for the datagrams, each given stride bytes
+     * @param stride Largest size of a datagram
+     * @param sizes Where the size of each datagram is stored
+     * @param num Largest number of datagrams to receive
+     * @return int Number of datagrams received
+     */
+    int read_batch(char* byts, int stride, int* sizes, int num);
+
+    /**
+     * @brief Ensures batches of up to num datagrams can be received without allocating
+     *
+     * @param num Number of datagrams
+     */
+    void reserve(int num);
+
+    /**
+     * @brief Starts this mstream
+     *
+     * We open the socket, bind it and join the group.
+     * If this fails, we are put into the error state.
+     */
+    void start() final;
+
+    /**
+     * @brief Stops this mstream, closing the socket
+     */
+    void stop() final;
+
+private:
+
+    /**
+     * @brief Waits for the socket to become readable
+     *
+     * @return true If a datagram is waiting
+     */
+    bool wait();
+
+    /**
+     * @brief Closes the socket
+     */
+    void close();
+
+    /// Port to bind to
+    int port = 5004;
+
+    /// IPv4 multicast group to join
+    std::string group;
+
+    /// Time reads wait for a datagram in milliseconds
+    int timeout = 100;
+
+    /// Socket we receive with
+    int fd = -1;
+
+#ifdef __linux__
+
+    /// Message headers for batched reads
+    std::vector<mmsghdr> msgs;
+
+#endif
+
+    /// Buffers for batched reads
+    std::vector<iovec> iovs;
+};
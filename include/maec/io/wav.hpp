@@ -12,9 +12,18 @@
  * so modules can read and write to wave files.
  */
 
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
 #include "../sink_module.hpp"
 #include "../source_module.hpp"
 #include "audio_buffer.hpp"
+#include "dsp/convert.hpp"
+#include "dsp/ring.hpp"
 #include "mstream.hpp"
 
 /**
@@ -408,9 +417,9 @@ public:
      * 
      * This function returns the size of the wave file in bytes.
      * 
-     * @return int Size in bytes
+     * @return int64_t Size in bytes
      */
-    int get_size() const { return this->size; }
+    int64_t get_size() const { return this->size; }
 
     /**
      * @brief Sets the size of the wave file
@@ -419,7 +428,7 @@ public:
      * 
      * @param size Size of wave file
      */
-    void set_size(int size) { this->size = size; }
+    void set_size(int64_t size) { this->size = size; }
 
 private:
 
@@ -445,7 +454,7 @@ private:
     int bytes_per_sample = 0;
 
     /// Size of the wave file
-    int size = 0;
+    int64_t size = 0;
 };
 
 /**
@@ -466,6 +475,13 @@ private:
  * but if it is split then we will handle this as well.
  * If we reach the end of the file before we reach the buffer size,
  * then the rest of the buffer will be filled with zeros.
+ *
+ * If the mstream holds its contents in memory (such as the MMapIStream),
+ * then we decode samples straight from the stream contents without copying.
+ * Frames can also be accessed in any order via seek_frame().
+ *
+ * We support 8, 16, 24 and 32 bit integer samples,
+ * as well as 32 bit float samples (format 3).
  */
 class WaveReader : public BaseWave {
 public:
@@ -544,7 +560,7 @@ public:
      * @return false Reader is not done
      */
     bool done() const {
-        return this->total_read >= static_cast<u_int32_t>(this->get_size()) || this->stream->bad(); }
+        return this->total_read >= this->get_size() || this->stream->bad(); }
 
     /**
      * @brief Reads audio data from the stream
@@ -563,8 +579,105 @@ public:
      */
     BufferPointer get_data();
 
+    /**
+     * @brief Reads audio data from the stream as signed 16 bit samples
+     *
+     * This works like get_data(), but samples are decoded into
+     * signed 16 bit (Q15) values for fixed point processing (see fixed.hpp).
+     * 16 bit files are copied straight through, and never converted to floating point.
+     * The destination must have room for one buffer of samples,
+     * which are always interleaved.
+     * If we reach the end of the file, the rest of the destination is filled with zeros.
+     *
+     * @param dest Pointer to write samples to
+     * @return int Number of samples read from the file
+     */
+    int get_data(int16_t* dest);
+
+    /**
+     * @brief Seeks to the given frame of the wave data
+     *
+     * The next call to get_data() will start reading at this frame.
+     * If we have not yet found the data chunk,
+     * then we will scan forward until it is found.
+     * Frames beyond the end of the data are clamped to the end.
+     *
+     * Random access is relative to the first data chunk,
+     * and the mstream must support seeking.
+     * Once the reader is done and the mstream is stopped,
+     * seeking will no longer have any effect.
+     *
+     * @param frame Frame to seek to
+     */
+    void seek_frame(int64_t frame);
+
+    /**
+     * @brief Gets the number of frames in the wave data
+     *
+     * This value is only known once the data chunk has been found,
+     * which happens on the first call to get_data() or seek_frame().
+     * Before this, we return 0.
+     *
+     * @return int64_t Number of frames in the data chunk
+     */
+    int64_t get_frames() const {
+        return this->get_blockalign() > 0 ? this->data_size / this->get_blockalign() : 0; }
+
+    /**
+     * @brief Gets the position of the wave data in the mstream
+     *
+     * This is the byte offset of the contents of the first data chunk,
+     * which allows the samples to be read straight from in-memory mstreams.
+     * Like get_frames(), this is only known once the data chunk has been found.
+     *
+     * @return uint32_t Byte offset of the wave data, 0 if not found
+     */
+    uint32_t get_data_start() const { return this->data_start; }
+
 private:
 
+    /**
+     * @brief Skips over the contents of the current chunk
+     *
+     * We use this for chunks we don't recognize.
+     * In-memory mstreams simply seek past the chunk.
+     */
+    void skip_chunk();
+
+    /**
+     * @brief Records the position of a data chunk we just entered
+     *
+     * Only the first data chunk is recorded,
+     * as this is the chunk seek_frame() operates on.
+     */
+    void enter_data();
+
+    /**
+     * @brief Decodes raw sample bytes into the given destination
+     *
+     * @param src Pointer to raw sample bytes
+     * @param bytes Number of bytes to decode
+     * @param dest Pointer to write samples to
+     * @return int Number of samples decoded
+     */
+    int decode(const char* src, int bytes, sample_t* dest) const;
+
+    /// @copydoc decode(const char*, int, sample_t*) const
+    int decode(const char* src, int bytes, int16_t* dest) const;
+
+    /**
+     * @brief Reads and decodes one buffer of interleaved samples
+     *
+     * This walks the chunks of the file, and is shared by
+     * both versions of get_data().
+     *
+     * @tparam T Type of samples to decode into
+     * @param dest Pointer to write samples to
+     * @return int Number of samples decoded
+     */
+    template <typename T>
+    int read_samples(T* dest);
+
     /**
      * @brief Reads the header of the current chunk
      * 
@@ -611,6 +724,18 @@ private:
 
     /// Boolean determining if we require a new chunk
     bool needs_chunk = true;
+
+    /// Scratch buffer for interleaved samples when buffers are planar
+    std::vector<sample_t> frames;
+
+    /// Scratch buffer for raw bytes when the mstream is not in memory
+    std::vector<char> raw;
+
+    /// Byte offset of the first data chunk contents, 0 if not found
+    uint32_t data_start = 0;
+
+    /// Size of the first data chunk in bytes
+    int64_t data_size = 0;
 };
 
 /**
@@ -630,10 +755,26 @@ private:
  * We currently do not support writing of any meta chunks,
  * we do the bare minimum to output audio data.
  * 
+ * Like the WaveReader, we support 8, 16, 24 and 32 bit integer samples.
+ * To write 32 bit float samples, set the format to 3.
+ *
+ * Wave files store sizes in 32 bits, which limits them to 4 GB.
+ * Long recordings can instead be written as RF64 (BW64) files,
+ * which store 64 bit sizes in a 'ds64' chunk, see set_rf64().
+ * For long recordings, pairing this writer with an AsyncFOStream
+ * keeps disk writes off the calling thread.
+ *
  */
 class WaveWriter : public BaseWave {
 public:
 
+    /// RF64 modes
+    enum rf64_mode {
+        never,    /// Always write a standard wave file
+        reserve,  /// Reserve space for a ds64 chunk, and only use it if the file is larger than 4 GB
+        always    /// Always write an RF64 file
+    };
+
     WaveWriter() = default;
 
     WaveWriter(BaseMOStream* stream) : stream(stream) {}
@@ -688,6 +829,70 @@ public:
      */
     void write_data(BufferPointer data);
 
+    /**
+     * @brief Writes the first frames of a buffer to the wave file
+     *
+     * This is useful when only part of a buffer is wanted,
+     * such as the final block of an offline render.
+     *
+     * @param data Buffer to write from
+     * @param num Number of frames to write
+     */
+    void write_frames(const AudioBuffer& data, int num);
+
+    /**
+     * @brief Sets the RF64 mode
+     *
+     * When reserving, we write a 'JUNK' chunk large enough to hold a ds64 chunk
+     * before the format chunk. Readers that don't know RF64 will skip it.
+     * If the file grows beyond 4 GB, the chunk is converted when we are stopped.
+     * This is the approach recommended by the BW64 specification.
+     *
+     * This must be set before we are started.
+     *
+     * @param mode New RF64 mode
+     */
+    void set_rf64(rf64_mode mode) { this->rf64 = mode; }
+
+    /**
+     * @brief Gets the RF64 mode
+     *
+     * @return rf64_mode Current RF64 mode
+     */
+    rf64_mode get_rf64() const { return this->rf64; }
+
+    /**
+     * @brief Enables or disables dither
+     *
+     * Dither only applies to 16 bit files,
+     * higher resolution formats are never dithered.
+     * The dither state is carried across writes.
+     *
+     * @param val true to enable dither
+     */
+    void set_dither(bool val) { this->dither = val; }
+
+    /**
+     * @brief Determines if we dither when writing 16 bit files
+     *
+     * @return true If dither is enabled
+     */
+    bool get_dither() const { return this->dither; }
+
+    /**
+     * @brief Sets the noise shaping used when dithering
+     *
+     * @param shape Noise shaping to use
+     */
+    void set_noise_shaping(NoiseShaping shape) { this->ditherer.set_shaping(shape); }
+
+    /**
+     * @brief Gets the noise shaping used when dithering
+     *
+     * @return NoiseShaping Noise shaping in use
+     */
+    NoiseShaping get_noise_shaping() const { return this->ditherer.get_shaping(); }
+
 private:
 
     /**
@@ -695,10 +900,113 @@ private:
      * 
      * @param num Number to add to total size
      */
-    void increment_size(int num) { this->set_size(this->get_size() + num); }
+    void increment_size(int64_t num) { this->set_size(this->get_size() + num); }
 
     /// Stream we are reading from
     BaseMOStream* stream = nullptr;
+
+    /// Scratch buffer for interleaved samples when buffers are planar
+    std::vector<sample_t> frames;
+
+    /// Scratch buffer for encoded samples
+    std::vector<char> raw;
+
+    /// Scratch buffer for dithered samples
+    std::vector<int16_t> quantized;
+
+    /// Determines if we dither when writing 16 bit files
+    bool dither = false;
+
+    /// Dither and noise shaping state
+    Dither ditherer;
+
+    /// Size of the contents of a ds64 chunk
+    static constexpr uint32_t ds64_size = 28;
+
+    /// RF64 mode
+    rf64_mode rf64 = never;
+
+    /// Position of the data chunk header
+    int64_t data_offset = 0;
+};
+
+/**
+ * @brief A sink that writes wave data
+ *
+ * This module writes the audio data it receives to a wave file,
+ * which is the usual way to bounce a chain to disk.
+ * The channels and sample rate of the wave file are taken from our info when started,
+ * all other wave parameters (bits per sample, format, RF64 mode)
+ * must be configured before we are started.
+ *
+ * A limit can be set, in which case we only write that many frames,
+ * and drop anything we receive after that.
+ */
+class WaveSink : public SinkModule, public WaveWriter {
+public:
+
+    WaveSink() = default;
+
+    WaveSink(BaseMOStream* stream) : WaveWriter(stream) {}
+
+    /**
+     * @brief Starts this wave sink
+     *
+     * We configure the wave data from our info,
+     * and tell the WaveWriter to start.
+     */
+    void start() override;
+
+    /**
+     * @brief Stops this wave sink
+     *
+     * We tell the WaveWriter to finish the wave file,
+     * which closes the underlying mstream.
+     */
+    void stop() override;
+
+    /**
+     * @brief Writes the current buffer
+     *
+     */
+    void process() override;
+
+    /**
+     * @brief Sets the largest number of frames to write
+     *
+     * @param num Number of frames, negative for no limit
+     */
+    void set_limit(int64_t num) { this->limit = num; }
+
+    /**
+     * @brief Gets the largest number of frames to write
+     *
+     * @return int64_t Number of frames, negative for no limit
+     */
+    int64_t get_limit() const { return this->limit; }
+
+    /**
+     * @brief Gets the number of frames written
+     *
+     * @return int64_t Frames written since we were started
+     */
+    int64_t get_written() const { return this->written; }
+
+    /**
+     * @brief Determines if we have reached our limit
+     *
+     * @return true If the limit has been written
+     * @return false If there is no limit, or we have not reached it
+     */
+    bool full() const { return this->limit >= 0 && this->written >= this->limit; }
+
+private:
+
+    /// Largest number of frames to write, negative for no limit
+    int64_t limit = -1;
+
+    /// Number of frames written
+    int64_t written = 0;
 };
 
 /**
@@ -711,30 +1019,53 @@ private:
  * 
  * The required wave reading operations are done at start time,
  * so you may see some latency when the chain is started.
+ *
+ * By default, audio data is read and decoded when we are processed.
+ * If the mstream has to wait on the disk, so does the chain!
+ * To avoid this, a number of blocks to read ahead can be set via set_prefetch().
+ * When started, a background thread will keep that many decoded blocks
+ * waiting in a lock-free queue, and processing simply takes the next one.
+ * If the thread falls behind, we output silence instead of waiting,
+ * and count the underrun.
+ * Once the end of the wave data is reached, we output silence without
+ * counting underruns.
  * 
  * TODO: Need to find a process for stopping the chain
  * if we reach the end of audio data.
  * 
  */
 class WaveSource : public SourceModule, public WaveReader {
+public:
 
     WaveSource() = default;
 
     WaveSource(BaseMIStream* stream) : WaveReader(stream) {}
 
+    /// Destructor, stops the prefetch thread
+    ~WaveSource() override;
+
+    /// Sources can't be copied
+    WaveSource(const WaveSource&) = delete;
+
+    /// Sources can't be copied
+    WaveSource& operator=(const WaveSource&) = delete;
+
     /**
      * @brief Starts this wave source
      * 
      * We simply tell the WaveReader to start read operations.
      * This operation can take some time!
      * 
+     * If prefetching is enabled, we also start the prefetch thread.
+     * 
      */
     void start() override;
 
     /**
      * @brief Stops this wave source
      * 
-     * We simply tell the WaveReader to stop read operations,
+     * We stop the prefetch thread if it is running,
+     * then tell the WaveReader to stop read operations,
      * and will close the underlying mstream.
      * 
      */
@@ -744,7 +1075,73 @@ class WaveSource : public SourceModule, public WaveReader {
      * @brief Processes this module
      * 
      * We simply ask the WaveReader to extract audio data from the wave source.
+     * When prefetching, we take the next block from the queue instead.
      * 
      */
     void process() override;
+
+    /**
+     * @brief Waits for the prefetch queue to fill
+     *
+     * Otherwise, the first blocks after starting may underrun
+     * while the prefetch thread catches up.
+     * We return early if the file runs out.
+     */
+    void prepare() override;
+
+    /**
+     * @brief Sets the number of blocks to read ahead
+     * 
+     * This must be set before we are started.
+     * A value of 0 disables prefetching,
+     * and reads audio data when we are processed.
+     * 
+     * @param blocks Number of blocks to read ahead
+     */
+    void set_prefetch(int blocks) { this->prefetch = blocks; }
+
+    /**
+     * @brief Gets the number of blocks to read ahead
+     * 
+     * @return int Number of blocks to read ahead
+     */
+    int get_prefetch() const { return this->prefetch; }
+
+    /**
+     * @brief Gets the number of underruns
+     * 
+     * An underrun occurs when we are processed,
+     * but the prefetch thread has no block ready for us.
+     * 
+     * @return uint64_t Number of underruns since we were started
+     */
+    uint64_t get_underruns() const { return this->underruns.load(std::memory_order_relaxed); }
+
+private:
+
+    /**
+     * @brief Main loop of the prefetch thread
+     */
+    void run();
+
+    /// Number of blocks to read ahead
+    int prefetch = 0;
+
+    /// Blocks decoded by the prefetch thread
+    SPSCRing<BufferPointer> ahead;
+
+    /// Prefetch thread
+    std::thread worker;
+
+    /// Determines if the prefetch thread should keep running
+    std::atomic<bool> running{false};
+
+    /// Determines if the prefetch thread has reached the end of the wave data
+    std::atomic<bool> drained{false};
+
+    /// Number of blocks we have taken from the queue
+    std::atomic<uint64_t> taken{0};
+
+    /// Number of underruns
+    std::atomic<uint64_t> underruns{0};
 };
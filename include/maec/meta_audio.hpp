@@ -72,6 +72,24 @@ class Counter : public AudioModule {
          * 
          */
         void process() override;
+
+        /**
+         * @brief Determines if this module processes in place
+         * 
+         * We pass the incoming buffer along untouched.
+         * 
+         * @return true Always
+         */
+        bool in_place() const override { return true; }
+
+        /**
+         * @brief Determines if this module only reads the buffer it is given
+         *
+         * We only look at the size of the buffer.
+         *
+         * @return true Always
+         */
+        bool read_only() const override { return true; }
 };
 
 /**
@@ -91,6 +109,15 @@ class Counter : public AudioModule {
  * - total latency thus far
  * - average time of each operation
  * - average latency of each operation
+ * - worst case time of an operation
+ * - jitter of each operation
+ * 
+ * Jitter is the difference between the time that passed
+ * since the start of the previous operation,
+ * and the time the previous buffer represents.
+ * When a chain is paced by a device, this shows how late (or early)
+ * we are woken up, which is the main reason for running on a real-time thread.
+ * If the chain is not paced, then the jitter is not very meaningful.
  * 
  * We utilize a chain timer that allows us to determine
  * the ideal time.
@@ -117,6 +144,27 @@ class LatencyModule : public Counter {
         /// Sum of all latency times
         int64_t total_operation_latency = 0;
 
+        /// Longest operation time
+        int64_t worst_time = 0;
+
+        /// Start time of the last operation
+        int64_t last_start = 0;
+
+        /// Expected time between the last two operations
+        int64_t last_expected = 0;
+
+        /// Jitter of the last operation
+        int64_t operation_jitter = 0;
+
+        /// Largest jitter encountered
+        int64_t worst_jitter = 0;
+
+        /// Sum of all jitter values
+        int64_t total_jitter = 0;
+
+        /// Number of jitter values measured
+        int64_t jitter_num = 0;
+
         /// Chain timer for ideal timekeeping
         ChainTimer timer;
 
@@ -235,6 +283,41 @@ class LatencyModule : public Counter {
          */
         int64_t average_latency() const { return this->total_operation_latency / this->processed(); }
 
+        /**
+         * @brief Gets the longest operation time in nanoseconds
+         * 
+         * This is the worst case time spent meta processing back modules,
+         * which must stay below the buffer time to avoid underruns.
+         * 
+         * @return int64_t Longest operation time in nanoseconds
+         */
+        int64_t max_time() const { return this->worst_time; }
+
+        /**
+         * @brief Gets the jitter of the last operation in nanoseconds
+         * 
+         * This is the absolute difference between the time since the
+         * previous operation started, and the time the previous buffer represents.
+         * No jitter is measured for the first operation.
+         * 
+         * @return int64_t Jitter of last operation in nanoseconds
+         */
+        int64_t jitter() const { return this->operation_jitter; }
+
+        /**
+         * @brief Gets the largest jitter in nanoseconds
+         * 
+         * @return int64_t Largest jitter in nanoseconds
+         */
+        int64_t max_jitter() const { return this->worst_jitter; }
+
+        /**
+         * @brief Gets the average jitter in nanoseconds
+         * 
+         * @return int64_t Average jitter in nanoseconds
+         */
+        int64_t average_jitter() const { return this->jitter_num == 0 ? 0 : this->total_jitter / this->jitter_num; }
+
         /**
          * @brief Starts this latency module
          * 
@@ -252,6 +335,16 @@ class LatencyModule : public Counter {
          */
         void meta_process() override;
 
+        /**
+         * @brief Determines the modules we pull buffers from
+         * 
+         * We time the processing of all backward modules,
+         * so we must be meta processed as a whole.
+         * 
+         * @return false Always
+         */
+        bool plan_inputs(std::vector<AudioModule*>& /*inputs*/) override { return false; }
+
         /**
          * @brief Dummy process method
          * 
@@ -363,7 +456,17 @@ class UniformBuffer : public AudioModule {
          * It will handle back processing when necessary.
          * 
          */
-        void meta_process() override { this->process(); }
+        void meta_process() override { this->run_process(); }
+
+        /**
+         * @brief Determines the modules we pull buffers from
+         * 
+         * We process backward modules a varying number of times,
+         * so we must be meta processed as a whole.
+         * 
+         * @return false Always
+         */
+        bool plan_inputs(std::vector<AudioModule*>& /*inputs*/) override { return false; }
 };
 
 /**
@@ -379,7 +482,7 @@ class ConstModule : public SourceModule {
 
 private:
     /// The value to return
-    long double value = 0.0;
+    sample_t value = 0.0;
 
 public:
     ConstModule() = default;
@@ -389,23 +492,23 @@ public:
      *
      * @param invalue Value to use in buffer creation
      */
-    ConstModule(long double invalue) : value(invalue) {}
+    ConstModule(sample_t invalue) : value(invalue) {}
 
     /**
      * @brief Set the value to use in buffer creation
      *
      * @param invalue Value to use in buffer creation
      */
-    void set_value(long double invalue) { this->value = invalue; }
+    void set_value(sample_t invalue) { this->value = invalue; }
 
     /**
      * @brief Get the value object
      *
      * We return the value that will be used in buffer creation.
      *
-     * @return long double
+     * @return sample_t
      */
-    long double get_value() const { return this->value; }
+    sample_t get_value() const { return this->value; }
 
     /**
      * @brief Override process method
@@ -0,0 +1,308 @@
+/**
+ * @file module_arena.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Arenas for building module graphs
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Each module is usually allocated on its own,
+ * so the modules in a large graph end up scattered across the heap.
+ * Processing a block walks every module, so this walk misses the cache constantly.
+ *
+ * This file contains an arena that modules can be constructed in.
+ * Modules are placed one after the other in the order they are created,
+ * and the buffers created while the arena is in scope are placed after them.
+ * When modules are created in the order they are processed
+ * (sources first, then each module that pulls from them, and the sink last),
+ * processing a block walks through memory in order.
+ * Use in_order() to check this against a compiled plan.
+ *
+ * Components that create objects for themselves
+ * (such as the constant module of a ModuleParam) use make_module(),
+ * which places the object in the current arena if there is one.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "dsp/alloc.hpp"
+
+class ChainPlan;
+
+/**
+ * @brief Deletes objects that may live in a ModuleArena
+ *
+ * Objects in an arena are destroyed, but their memory is left to the arena.
+ * Everything else is deleted as usual.
+ */
+struct ModuleDeleter {
+
+    /// Determines if the object lives in an arena
+    bool arena = false;
+
+    /**
+     * @brief Destroys an object
+     *
+     * @tparam T Type of object
+     * @param ptr Object to destroy
+     */
+    template <typename T>
+    void operator()(T* ptr) const {
+
+        if (this->arena) {
+
+            ptr->~T();
+        }
+
+        else {
+
+            delete ptr;
+        }
+    }
+};
+
+/**
+ * @brief Pointer to an object that may live in a ModuleArena
+ *
+ * @tparam T Type of object
+ */
+template <typename T>
+using ModulePointer = std::unique_ptr<T, ModuleDeleter>;
+
+/**
+ * @brief A monotonic arena that modules are constructed in
+ *
+ * Objects created with create() are owned by the arena,
+ * and are destroyed in reverse order when the arena is destroyed or cleared.
+ * Memory is never handed back until then.
+ * If the arena fills up, objects are allocated on the heap as usual,
+ * so construction never fails, it just loses the layout.
+ *
+ * Use scope() while building a graph:
+ *
+ * ModuleArena arena(1 << 20);
+ * {
+ *     auto scope = arena.scope();
+ *     auto* osc = arena.create<SineOscillator>(440);
+ *     auto* sink = arena.create<PeriodSink>();
+ *     sink->bind(osc);
+ *     // Start and compile the chain here, so its buffers follow the modules
+ * }
+ *
+ * The arena must outlive every object and buffer allocated from it!
+ * An arena may only be used by one thread at a time.
+ */
+class ModuleArena {
+public:
+
+    /**
+     * @brief Sets the current arena for the lifetime of this object
+     *
+     * Buffers and objects created with make_module() come from the arena while in scope.
+     * The previous arenas are restored when we are destroyed.
+     */
+    class Scope {
+    public:
+
+        /**
+         * @brief Construct a new Scope object
+         *
+         * @param arena Arena to use in this scope
+         */
+        explicit Scope(ModuleArena* arena);
+
+        /// Destructor, restores the previous arenas
+        ~Scope();
+
+        /// Scopes can not be copied
+        Scope(const Scope&) = delete;
+
+        /// Scopes can not be copied
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+
+        /// Module arena to restore
+        ModuleArena* previous = nullptr;
+
+        /// Buffer arena to restore
+        HugePageArena* previous_buffers = nullptr;
+    };
+
+    /**
+     * @brief Construct a new Module Arena object
+     *
+     * @param bytes Number of bytes to reserve for modules and buffers
+     */
+    explicit ModuleArena(std::size_t bytes) : memory(bytes) {}
+
+    /// Destructor, destroys every object we own
+    ~ModuleArena() { this->clear(); }
+
+    /// Arenas can not be copied
+    ModuleArena(const ModuleArena&) = delete;
+
+    /// Arenas can not be copied
+    ModuleArena& operator=(const ModuleArena&) = delete;
+
+    /**
+     * @brief Constructs an object owned by this arena
+     *
+     * @tparam T Type of object
+     * @tparam Args Types of constructor arguments
+     * @param args Constructor arguments
+     * @return T* Pointer to the new object
+     */
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+
+        void* mem = this->allocate(sizeof(T), alignof(T));
+
+        if (mem == nullptr) {
+
+            T* obj = new T(std::forward<Args>(args)...);
+
+            this->owned.push_back({obj, sizeof(T), false, [](void* ptr) { delete static_cast<T*>(ptr); }});
+
+            return obj;
+        }
+
+        T* obj = ::new (mem) T(std::forward<Args>(args)...);
+
+        this->owned.push_back({obj, sizeof(T), true, [](void* ptr) { static_cast<T*>(ptr)->~T(); }});
+
+        return obj;
+    }
+
+    /**
+     * @brief Allocates memory from this arena
+     *
+     * @param bytes Number of bytes to allocate
+     * @param align Alignment of the memory
+     * @return void* Pointer to memory, nullptr if the arena is full
+     */
+    void* allocate(std::size_t bytes, std::size_t align) { return this->memory.allocate(bytes, align); }
+
+    /**
+     * @brief Destroys every object we own, and releases all memory
+     *
+     * Only call this once no objects or buffers are using the arena!
+     */
+    void clear();
+
+    /**
+     * @brief Makes this the current arena until the returned scope is destroyed
+     *
+     * @return Scope Scope of this arena
+     */
+    Scope scope() { return Scope(this); }
+
+    /**
+     * @brief Determines if a pointer was allocated from this arena
+     *
+     * @param ptr Pointer to check
+     * @return true If the pointer lives in this arena
+     * @return false If not
+     */
+    bool owns(const void* ptr) const { return this->memory.owns(ptr); }
+
+    /**
+     * @brief Gets the number of objects we own
+     *
+     * @return std::size_t Number of objects
+     */
+    std::size_t size() const { return this->owned.size(); }
+
+    /**
+     * @brief Gets the number of bytes reserved by this arena
+     *
+     * @return std::size_t Number of bytes reserved
+     */
+    std::size_t capacity() const { return this->memory.capacity(); }
+
+    /**
+     * @brief Gets the number of bytes handed out
+     *
+     * @return std::size_t Number of bytes used
+     */
+    std::size_t allocated() const { return this->memory.allocated(); }
+
+    /**
+     * @brief Determines if the modules of a plan are laid out in the order they are processed
+     *
+     * Modules that live inside another object (such as the parameters of a module)
+     * are counted at the position of that object.
+     * Modules that don't live in this arena are ignored.
+     *
+     * @param plan Compiled plan to check
+     * @return true If each module in the arena is placed at or after the one processed before it
+     * @return false If not
+     */
+    bool in_order(const ChainPlan& plan) const;
+
+    /**
+     * @brief Gets the current arena of this thread
+     *
+     * @return ModuleArena* Current arena, nullptr if none
+     */
+    static ModuleArena* current();
+
+private:
+
+    /**
+     * @brief An object we own
+     */
+    struct Owned {
+
+        /// Pointer to the object
+        void* ptr = nullptr;
+
+        /// Size of the object in bytes
+        std::size_t size = 0;
+
+        /// Determines if the object lives in the arena
+        bool arena = false;
+
+        /// Function that destroys the object
+        void (*destroy)(void*) = nullptr;
+    };
+
+    /// Memory the modules and buffers live in
+    HugePageArena memory;
+
+    /// Objects we own, in order of creation
+    std::vector<Owned> owned;
+};
+
+/**
+ * @brief Creates an object, in the current arena if there is one
+ *
+ * The returned pointer destroys the object as usual,
+ * but leaves the memory to the arena.
+ *
+ * @tparam T Type of object
+ * @tparam Args Types of constructor arguments
+ * @param args Constructor arguments
+ * @return ModulePointer<T> Pointer to the new object
+ */
+template <typename T, typename... Args>
+ModulePointer<T> make_module(Args&&... args) {
+
+    ModuleArena* arena = ModuleArena::current();
+
+    void* mem = arena != nullptr ? arena->allocate(sizeof(T), alignof(T)) : nullptr;
+
+    if (mem == nullptr) {
+
+        return ModulePointer<T>(new T(std::forward<Args>(args)...));
+    }
+
+    return ModulePointer<T>(::new (mem) T(std::forward<Args>(args)...), ModuleDeleter{true});
+}
@@ -9,8 +9,11 @@
  * 
  */
 
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include "audio_module.hpp"
+#include "executor.hpp"
 
 
 /**
@@ -37,7 +40,23 @@
  * Each input module will be sampled and their outputs will be added together.
  * If the input modules are sufficiently complex, 
  * then their will be overhead while waiting for the output to be computed.
- * Hopefully, this will be somewhat corrected when utilizing concurency modules.
+ * This can be corrected by providing a WorkerPool (see set_executor()),
+ * which processes the input modules concurrently and joins them before summing.
+ * Each input module must be the front of an independent subtree,
+ * meaning subtrees must not share modules!
+ * When processed serially, the modules behind each input share our ChainInfo.
+ * With a WorkerPool, each input gets a sub-chain of its own,
+ * so concurrent subtrees never share a buffer pool or event queue.
+ * Sub-chains follow the size, time and warm-up state of our chain at each block.
+ * The results are identical to serial processing,
+ * as buffers are always summed in the order the inputs were bound.
+ * With a pool placed on NUMA nodes, neighbouring inputs are processed on the same node,
+ * and each input stays on its node from block to block, so its buffers stay local.
+ * 
+ * If a deadline is set, and processing the inputs concurrently takes longer than it,
+ * then we fall back to serial processing for a number of blocks before trying again.
+ * This avoids paying the synchronization overhead when it does not help,
+ * for example when the machine is loaded or the inputs are trivial.
  * This will be an issue the more modules you add.
  * Adding together the outputs is minimal, but again,
  * the more modules that are added the more complex this gets.
@@ -60,8 +79,41 @@ class ModuleMixDown : virtual public AudioModule {
         /// Vector of pointers to all input modules
         std::vector<AudioModule*> in;
 
-        /// Vector of all input buffers
-        std::vector<std::shared_ptr<AudioBuffer>> buffs;
+        /// Slots for input buffers, one for each input
+        std::vector<BufferPointer> buffs;
+
+        /// Gain for each input
+        std::vector<double> gains;
+
+        /// Pool to process inputs with, if any
+        WorkerPool* executor = nullptr;
+
+        /// Time in nanoseconds concurrent processing should complete within, 0 for none
+        int64_t deadline = 0;
+
+        /// Number of blocks to process serially after missing the deadline
+        int backoff = 64;
+
+        /// Number of blocks remaining until we try concurrent processing again
+        int serial = 0;
+
+        /// Sub-chain of each input, used when processing concurrently
+        std::vector<std::unique_ptr<ChainInfo>> chains;
+
+        /**
+         * @brief Points every module behind an input at a chain
+         * 
+         * @param index Index of the input
+         * @param target Chain to use
+         */
+        void share_chain(int index, ChainInfo* target);
+
+        /**
+         * @brief Processes an input and stores its buffer
+         * 
+         * @param index Index of the input
+         */
+        void process_input(int index);
 
     public:
 
@@ -76,6 +128,11 @@ class ModuleMixDown : virtual public AudioModule {
          * 
          * We simply sample each input module,
          * and add the given buffers together.
+         * Each buffer is scaled by the gain of its input,
+         * and summed with a vectorized kernel (see dsp/mix.hpp).
+         * 
+         * Input buffers are kept in a fixed set of slots,
+         * one for each input, so no memory is allocated while mixing.
          * 
          */
         void process() override;
@@ -86,9 +143,36 @@ class ModuleMixDown : virtual public AudioModule {
          * We do something a little differently when compared to normal.
          * Instead of setting one pointer for one input,
          * we contain a vector of pointers for each module bound to us.
+         * We become the forward module of the input,
+         * and share our ChainInfo with it.
+         * The chain of the subtree behind the input is set
+         * when we are synced (see meta_info_sync()).
          */
         AudioModule* bind(AudioModule* mod) override;
 
+        /**
+         * @brief Preforms an info sync on this module and all inputs
+         * 
+         * Every module behind an input is pointed at our ChainInfo,
+         * or at a sub-chain of the input if we have an executor.
+         * Sub-chains are configured from our info here,
+         * so this may allocate.
+         * 
+         */
+        void meta_info_sync() override;
+
+        /**
+         * @brief Starts this module and all inputs
+         * 
+         */
+        void meta_start() override;
+
+        /**
+         * @brief Stops this module and all inputs
+         * 
+         */
+        void meta_stop() override;
+
         /**
          * @brief Meta process method
          * 
@@ -98,6 +182,37 @@ class ModuleMixDown : virtual public AudioModule {
          */
         void meta_process() override;
 
+        /**
+         * @brief Steps this module
+         * 
+         * We grab the buffers from each input module,
+         * which must have been processed already,
+         * and add them together.
+         */
+        void step() override;
+
+        /**
+         * @brief Determines the modules we pull buffers from
+         * 
+         * We add each input module.
+         * If we have an executor, then we can't be stepped,
+         * as the inputs should be processed concurrently by meta_process().
+         * 
+         * @param inputs Vector to add modules to
+         * @return true If we can be stepped
+         * @return false If we have an executor
+         */
+        bool plan_inputs(std::vector<AudioModule*>& inputs) override;
+
+        /**
+         * @brief Adds the memory held by this mixer
+         *
+         * We also count the buffers held in each input slot.
+         *
+         * @param usage Footprint to add to
+         */
+        void footprint(MemoryFootprint& usage) const override;
+
         /**
          * @brief Returns the number of input modules attached to this mixer
          * 
@@ -105,6 +220,85 @@ class ModuleMixDown : virtual public AudioModule {
          */
         int num_inputs() { return static_cast<int>(in.size()); }
 
+        /**
+         * @brief Gets the gain of an input
+         * 
+         * @param index Index of the input
+         * @return double Gain of the input
+         */
+        double get_gain(int index) const { return this->gains.at(index); }
+
+        /**
+         * @brief Sets the gain of an input
+         * 
+         * Each input is multiplied by its gain before being summed.
+         * By default, each input has a gain of 1.
+         * 
+         * @param index Index of the input
+         * @param gain Gain to use
+         */
+        void set_gain(int index, double gain) { this->gains.at(index) = gain; }
+
+        /**
+         * @brief Gets the pool used to process inputs
+         * 
+         * @return WorkerPool* Pool in use, nullptr if we process serially
+         */
+        WorkerPool* get_executor() const { return this->executor; }
+
+        /**
+         * @brief Sets the pool used to process inputs
+         * 
+         * The pool may be shared between many mixers,
+         * but a pool can only run one batch at a time,
+         * so mixers sharing a pool must not be nested.
+         * This should be set before the chain is synced,
+         * as inputs only get their own sub-chains when we are synced,
+         * and room for a task for each input is reserved in the pool.
+         * 
+         * @param pool Pool to use, nullptr to process serially
+         */
+        void set_executor(WorkerPool* pool) { this->executor = pool; }
+
+        /**
+         * @brief Gets the deadline for concurrent processing
+         * 
+         * @return int64_t Deadline in nanoseconds, 0 for none
+         */
+        int64_t get_deadline() const { return this->deadline; }
+
+        /**
+         * @brief Sets the deadline for concurrent processing
+         * 
+         * A sensible value is a fraction of the time
+         * a single buffer represents.
+         * 
+         * @param time Deadline in nanoseconds, 0 for none
+         */
+        void set_deadline(int64_t time) { this->deadline = time; }
+
+        /**
+         * @brief Gets the number of blocks processed serially after a missed deadline
+         * 
+         * @return int Number of blocks
+         */
+        int get_backoff() const { return this->backoff; }
+
+        /**
+         * @brief Sets the number of blocks processed serially after a missed deadline
+         * 
+         * @param num Number of blocks
+         */
+        void set_backoff(int num) { this->backoff = num; }
+
+        /**
+         * @brief Determines if we are currently falling back to serial processing
+         * 
+         * @return true If inputs are being processed serially due to a missed deadline
+         * @return false If inputs are processed normally
+         */
+        bool is_fallback() const { return this->serial > 0; }
+
 };
 
 
@@ -151,6 +345,12 @@ class ModuleMixUp : virtual public AudioModule {
         /// Vector of out modules
         std::vector<AudioModule*> out;
 
+        /// Buffers we have shared with read only modules
+        std::vector<std::shared_ptr<AudioBuffer>> slots;
+
+        /// Index of the slot holding the current buffer, -1 if none
+        int current = -1;
+
     public:
 
         /**
@@ -180,11 +380,45 @@ class ModuleMixUp : virtual public AudioModule {
          * 
          * This introduces a performance/memory issue, as we are copying the buffer
          * each time this method is called.
+         * Modules that only read their input (see AudioModule::read_only())
+         * use share_buffer() instead, and don't pay for a copy.
          * 
          * @return AudioBuffer
          */
         std::unique_ptr<AudioBuffer> get_buffer() override;
 
+        /**
+         * @brief Shares the current buffer without copying it
+         * 
+         * Every read only module in front of us gets the same buffer.
+         * We keep a few slots of shared buffers around,
+         * and only reuse a slot once no module is holding it.
+         * The contents of our buffer are swapped into a free slot,
+         * so in the steady state sharing allocates nothing.
+         * 
+         * @return SharedBuffer Buffer shared with all readers
+         */
+        SharedBuffer share_buffer() override;
+
+        /**
+         * @brief Adds the memory held by this mixer
+         *
+         * We also count the buffers held in each shared slot.
+         *
+         * @param usage Footprint to add to
+         */
+        void footprint(MemoryFootprint& usage) const override;
+
+        /**
+         * @brief Determines if this module processes in place
+         * 
+         * We hold onto the incoming buffer,
+         * and hand out copies of it.
+         * 
+         * @return true Always
+         */
+        bool in_place() const override { return true; }
+
         /**
          * @brief Returns the number of output modules
          * 
@@ -225,4 +459,26 @@ class ModuleMixUp : virtual public AudioModule {
  * This class is an AudioModule, so it can be manipulated and worked with
  * like any conventional audio module.
  */
-class MultiMix: public ModuleMixDown, public ModuleMixUp {};
+class MultiMix: public ModuleMixDown, public ModuleMixUp {
+
+    public:
+
+        /**
+         * @brief Determines if this module processes in place
+         * 
+         * We add our inputs into a new buffer.
+         * 
+         * @return false Always
+         */
+        bool in_place() const override { return false; }
+
+        /**
+         * @brief Adds the memory held by this mixer
+         *
+         * We count the input slots and the shared slots,
+         * along with the buffer we are holding.
+         *
+         * @param usage Footprint to add to
+         */
+        void footprint(MemoryFootprint& usage) const override;
+};
@@ -13,15 +13,34 @@
 
 #pragma once
 
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <utility>
 #include <array>
+#include <vector>
 
 #include "audio_module.hpp"
+#include "module_arena.hpp"
 #include "sink_module.hpp"
 #include "source_module.hpp"
 #include "meta_audio.hpp"
 
+/**
+ * @brief Rates a parameter can change at
+ *
+ * Consumers of parameters can use this to pick a fast path:
+ *
+ * - Constant - The value never changes, use get_constant() and skip buffer generation
+ * - Control - One value per block, use get_control() and interpolate across the block
+ * - Audio - A value for every sample, use get()
+ */
+enum class ParamRate {
+    Constant,  /// Value does not change
+    Control,   /// One value per block
+    Audio      /// One value per sample
+};
+
 /**
  * @brief A component that represents a parameter
  * 
@@ -61,16 +80,71 @@
  * For example, one could attach a SineOscillator, which would cause the this parameter to represent a sine wave.
  * This allows for components to be modulated.
  * 
+ * Parameters also have a rate (see ParamRate).
+ * Parameters configured with set_constant() are constant,
+ * and modules can read the value directly instead of generating a buffer.
+ * Parameters attached to modules are audio rate by default,
+ * but can be set to control rate, in which case the attached chain
+ * generates a single value per block, at a correspondingly lower sample rate.
+ * 
+ * Many parameters can read from the same module, such as one LFO modulating many voices.
+ * The first parameter bound to the module leads, and the others follow it.
+ * The module is rendered once per block of the chain that reads the parameters,
+ * and every parameter reads the same result (see share()).
+ * Followers never process, start, stop or sync the module themselves,
+ * so the leader must outlive them.
+ * 
  */
 class ModuleParam : public SinkModule {
 
     private:
 
         /// A constant value to be returned
-        long double value = 0;
+        sample_t value = 0;
 
         /// Pointer to ConstModule
-        std::unique_ptr<ConstModule> const_mod = nullptr;
+        ModulePointer<ConstModule> const_mod = nullptr;
+
+        /// Determines if a compiled chain processes us
+        bool planned = false;
+
+        /// Rate to use when attached to a module
+        ParamRate rate = ParamRate::Audio;
+
+        /// Last control value we returned
+        sample_t last_control = 0;
+
+        /// Determines if we have returned a control value
+        bool primed = false;
+
+        /// Number of times we have been reconfigured
+        uint64_t version = 0;
+
+        /// Parameter that reads our module for us, nullptr if we lead
+        ModuleParam* leader = nullptr;
+
+        /// Number of parameters following us
+        int followers = 0;
+
+        /// Blocks we have shared with readers
+        std::vector<std::shared_ptr<AudioBuffer>> slots;
+
+        /// Slot holding the current block, -1 if there is none
+        int current = -1;
+
+        /// Chain the current block belongs to
+        const ChainInfo* block_chain = nullptr;
+
+        /// Sample time of the current block in its chain
+        int64_t block_sample = 0;
+
+        /**
+         * @brief Gets the block for the given time, rendering it if necessary
+         *
+         * @param chain Chain the block belongs to, nullptr to always render
+         * @return SharedBuffer Block for the given time
+         */
+        SharedBuffer share_block(const ChainInfo* chain);
 
     public:
 
@@ -85,7 +159,7 @@ class ModuleParam : public SinkModule {
          * 
          * @param val Constant value to set
          */
-        ModuleParam(long double val) { this->set_constant(val); }
+        ModuleParam(sample_t val) { this->set_constant(val); }
 
         /**
          * @brief Construct a parameter, and configures for constant values
@@ -102,11 +176,52 @@ class ModuleParam : public SinkModule {
          * 
          * We meta process and backward modules,
          * and then return the AudioBuffer.
+         * If we are part of a compiled chain,
+         * then we have already been processed,
+         * so we simply return the AudioBuffer.
          * 
          * @return AudioBuffer Buffer of values to work with
          */
         BufferPointer get();
 
+        /**
+         * @brief Gets the current buffer, without taking ownership of it
+         *
+         * When many parameters read the same module,
+         * it is rendered at most once per block of the chain that reads us
+         * (the chain of our forward module),
+         * and the same buffer is shared with every parameter reading that module.
+         * The returned buffer must not be altered!
+         * Consumers that only read their parameters should prefer this to get().
+         *
+         * Otherwise, or if we have no forward module, we render every time we are called.
+         *
+         * @return SharedBuffer Buffer of values to read
+         */
+        SharedBuffer share();
+
+        /**
+         * @brief Binds a module as our source of values
+         *
+         * This counts as a change, see get_version().
+         * If another parameter is already reading the module, we follow it.
+         *
+         * @param mod Module to bind
+         * @return AudioModule* The module we just bound
+         */
+        AudioModule* bind(AudioModule* mod) override;
+
+        /**
+         * @brief Gets the number of times we have been reconfigured
+         *
+         * This goes up each time set_constant() or bind() is called,
+         * so components that cache our output (such as FreezeModule)
+         * can tell when they must render again.
+         *
+         * @return uint64_t Version of this parameter
+         */
+        uint64_t get_version() const { return this->version; }
+
         /**
          * @brief Configures this parameter for constant values.
          * 
@@ -115,7 +230,51 @@ class ModuleParam : public SinkModule {
          * 
          * @param val Value to set
          */
-        void set_constant(long double val);
+        void set_constant(sample_t val);
+
+        /**
+         * @brief Gets the constant value of this parameter
+         * 
+         * This is only meaningful if we are constant!
+         * 
+         * @return sample_t Constant value
+         */
+        sample_t get_constant() const { return this->value; }
+
+        /**
+         * @brief Gets the rate of this parameter
+         * 
+         * We are constant if we were configured with set_constant(),
+         * and nothing else has been bound since.
+         * Otherwise, we return the rate set with set_rate().
+         * 
+         * @return ParamRate Rate of this parameter
+         */
+        ParamRate get_rate() const;
+
+        /**
+         * @brief Sets the rate to use when attached to a module
+         * 
+         * This should be set before info sync,
+         * as control rate parameters configure the attached chain differently.
+         * Constant parameters are configured with set_constant().
+         * 
+         * @param nrate Rate to use, either Control or Audio
+         */
+        void set_rate(ParamRate nrate) { this->rate = nrate; }
+
+        /**
+         * @brief Gets the value range of this parameter for the current block
+         * 
+         * This is used for control rate parameters.
+         * We process the attached chain, which generates a single value,
+         * and return the last value alongside the new one.
+         * Consumers should interpolate from the first value to the second across the block.
+         * On the first call, both values are the same.
+         * 
+         * @return std::pair<sample_t, sample_t> Value at the start and end of the block
+         */
+        std::pair<sample_t, sample_t> get_control();
 
         /**
          * @brief Configures this parameter using a given module
@@ -133,6 +292,65 @@ class ModuleParam : public SinkModule {
          * @param mod Module to use for configuration
          */
         void conf_mod(AudioModule* mod);
+
+        /**
+         * @brief Determines if a compiled chain processes us
+         * 
+         * @return true If we are processed by a compiled chain
+         * @return false If we process ourselves when get() is called
+         */
+        bool is_planned() const { return this->planned; }
+
+        /**
+         * @brief Sets if a compiled chain processes us
+         * 
+         * This is set by ChainPlan, users should not need to call this!
+         * 
+         * @param val true if we are processed by a compiled chain
+         */
+        void set_planned(bool val) { this->planned = val; }
+
+        /**
+         * @brief Gets the parameter we follow
+         *
+         * @return ModuleParam* Parameter reading our module for us, nullptr if we lead
+         */
+        ModuleParam* get_leader() const { return this->leader; }
+
+        /**
+         * @brief Syncs ourselves, and the module we read if we lead
+         *
+         */
+        void meta_info_sync() override;
+
+        /**
+         * @brief Starts ourselves, and the module we read if we lead
+         *
+         */
+        void meta_start() override;
+
+        /**
+         * @brief Stops ourselves, and the module we read if we lead
+         *
+         */
+        void meta_stop() override;
+
+        /**
+         * @brief Processes our buffer
+         *
+         * Followers do nothing, as the leader takes the buffer of our module.
+         */
+        void step() override;
+
+        /**
+         * @brief Determines the modules we pull buffers from
+         *
+         * Followers read from their leader.
+         *
+         * @param inputs Vector to add modules to
+         * @return true Always
+         */
+        bool plan_inputs(std::vector<AudioModule*>& inputs) override;
 };
 
 /**
@@ -180,6 +398,25 @@ public:
      */
     std::array<ModuleParam*, num>* get_array() { return &params; }
 
+    /**
+     * @brief Adds each parameter to the given vector
+     *
+     * This is used when determining the modules we pull buffers from,
+     * as parameters must be processed before the module that uses them.
+     *
+     * @param inputs Vector to add parameters to
+     */
+    void param_inputs(std::vector<AudioModule*>& inputs) {
+
+        for (ModuleParam* param : this->params) {
+
+            if (param != nullptr) {
+
+                inputs.push_back(param);
+            }
+        }
+    }
+
     /**
      * @brief Starts all attached parameters
      * 
@@ -312,6 +549,20 @@ public:
 
         this->param_info(this);
     }
+    /**
+     * @brief Determines the modules we pull buffers from
+     *
+     * We add our parameters, as well as the usual modules.
+     *
+     * @param inputs Vector to add modules to
+     * @return true If we can be stepped
+     */
+    bool plan_inputs(std::vector<AudioModule*>& inputs) override {
+
+        this->param_inputs(inputs);
+
+        return AudioModule::plan_inputs(inputs);
+    }
 };
 
 /**
@@ -396,6 +647,20 @@ public:
 
         this->param_info(this);
     }
+    /**
+     * @brief Determines the modules we pull buffers from
+     *
+     * We add our parameters, as well as the usual modules.
+     *
+     * @param inputs Vector to add modules to
+     * @return true If we can be stepped
+     */
+    bool plan_inputs(std::vector<AudioModule*>& inputs) override {
+
+        this->param_inputs(inputs);
+
+        return SinkModule::plan_inputs(inputs);
+    }
 };
 
 /**
@@ -480,4 +745,18 @@ public:
 
         this->param_info(this);
     }
+    /**
+     * @brief Determines the modules we pull buffers from
+     *
+     * We add our parameters, as well as the usual modules.
+     *
+     * @param inputs Vector to add modules to
+     * @return true If we can be stepped
+     */
+    bool plan_inputs(std::vector<AudioModule*>& inputs) override {
+
+        this->param_inputs(inputs);
+
+        return SourceModule::plan_inputs(inputs);
+    }
 };
@@ -0,0 +1,93 @@
+/**
+ * @file numa.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Components for NUMA aware processing
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * On machines with many sockets, each socket (or node) has its own memory.
+ * Memory on another node can be reached, but with less bandwidth and more latency.
+ * This file contains components for discovering the nodes of a machine,
+ * and for keeping threads on them.
+ *
+ * We don't depend on libnuma.
+ * Linux places a page on the node of the thread that first touches it,
+ * so a buffer is local to a node when it is allocated and zeroed by a thread pinned to that node.
+ * The WorkerPool uses this to keep the buffers of each part of a chain on one node.
+ */
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief The nodes of a machine, and the CPUs in each
+ *
+ * On Linux, we read the topology from sysfs.
+ * Elsewhere, or when it can't be read, we report one node holding every CPU.
+ */
+class NumaTopology {
+public:
+
+    NumaTopology() = default;
+
+    /**
+     * @brief Construct a new NumaTopology object with the given nodes
+     *
+     * @param cpus CPUs in each node
+     */
+    explicit NumaTopology(std::vector<std::vector<int>> cpus) : nodes(std::move(cpus)) {}
+
+    /**
+     * @brief Determines the topology of this machine
+     *
+     * @return NumaTopology Topology of this machine
+     */
+    static NumaTopology detect();
+
+    /**
+     * @brief Gets the number of nodes
+     *
+     * @return int Number of nodes
+     */
+    int size() const { return static_cast<int>(this->nodes.size()); }
+
+    /**
+     * @brief Gets the CPUs in a node
+     *
+     * @param node Index of the node
+     * @return const std::vector<int>& CPUs in the node
+     */
+    const std::vector<int>& get_cpus(int node) const { return this->nodes.at(node); }
+
+private:
+
+    /// CPUs in each node
+    std::vector<std::vector<int>> nodes;
+};
+
+/**
+ * @brief Parses a list of CPUs
+ *
+ * Lists are in the format used by sysfs, such as '0-3,8,10-11'.
+ * Anything we can't parse is skipped.
+ *
+ * @param list List to parse
+ * @return std::vector<int> CPUs in the list
+ */
+std::vector<int> parse_cpu_list(const std::string& list);
+
+/**
+ * @brief Pins the calling thread to a set of CPUs
+ *
+ * This does nothing on platforms without thread affinity.
+ *
+ * @param cpus CPUs the thread may run on
+ * @return true If the thread was pinned
+ * @return false If not
+ */
+bool pin_current_thread(const std::vector<int>& cpus);
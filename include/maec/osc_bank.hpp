@@ -0,0 +1,204 @@
+/**
+ * @file osc_bank.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief A source that runs many sine voices at once
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Additive synthesis builds a sound out of hundreds of sine partials.
+ * Running each partial as its own SineOscillator costs a module,
+ * a buffer and a kernel call per partial, and only vectorizes across time.
+ *
+ * The OscillatorBank keeps the state of every voice in contiguous arrays
+ * (see the bank kernels in dsp/osc.hpp), so each sample advances
+ * a whole vector of voices at once.
+ * The voices can be summed into one channel,
+ * or rendered into one channel per voice.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "dsp/alloc.hpp"
+#include "source_module.hpp"
+
+/**
+ * @brief Generates a bank of sine voices
+ *
+ * Each voice has a frequency in hertz, an amplitude and a phase.
+ * In the Sum output (the default), the voices are added together
+ * into a single channel, like one large additive oscillator.
+ * In the Voices output, each voice is written to its own channel,
+ * which is useful for routing or panning voices separately.
+ *
+ * Voices at or above Nyquist are muted rather than aliased,
+ * so a harmonic series can be given without checking the sample rate.
+ *
+ * Voices are stored padded to a multiple of OSC_BANK_LANES,
+ * and are kept in single precision, no matter the type of sample_t.
+ * Memory is allocated when the number of voices is set,
+ * after which processing is allocation-free.
+ */
+class OscillatorBank : public SourceModule {
+
+    public:
+
+        /// How voices are written to the output
+        enum class Output {
+            Sum,  /// All voices are added into one channel
+            Voices  /// Each voice is written to its own channel
+        };
+
+        OscillatorBank() = default;
+
+        /**
+         * @brief Construct a new OscillatorBank object
+         *
+         * All voices start silent, at 0 hertz.
+         *
+         * @param voices Number of voices
+         */
+        explicit OscillatorBank(int voices) { this->set_voices(voices); }
+
+        /**
+         * @brief Renders a block of the bank
+         *
+         * Increments are recomputed first if any frequency
+         * or the sample rate has changed.
+         */
+        void process() override;
+
+        /**
+         * @brief Sets the number of voices
+         *
+         * Existing voices are kept, new voices are silent at 0 hertz.
+         *
+         * @param num Number of voices
+         */
+        void set_voices(int num);
+
+        /**
+         * @brief Gets the number of voices
+         *
+         * @return int Number of voices
+         */
+        int get_voices() const { return static_cast<int>(this->freq.size()); }
+
+        /**
+         * @brief Sets the frequency of a voice
+         *
+         * @param voice Index of the voice
+         * @param hertz Frequency in hertz
+         */
+        void set_frequency(int voice, double hertz);
+
+        /**
+         * @brief Gets the frequency of a voice
+         *
+         * @param voice Index of the voice
+         * @return double Frequency in hertz
+         */
+        double get_frequency(int voice) const { return this->freq.at(voice); }
+
+        /**
+         * @brief Sets the amplitude of a voice
+         *
+         * @param voice Index of the voice
+         * @param amp Amplitude of the voice
+         */
+        void set_amplitude(int voice, double amp);
+
+        /**
+         * @brief Gets the amplitude of a voice
+         *
+         * @param voice Index of the voice
+         * @return double Amplitude of the voice
+         */
+        double get_amplitude(int voice) const { return this->level.at(voice); }
+
+        /**
+         * @brief Sets the phase of a voice
+         *
+         * @param voice Index of the voice
+         * @param turns Phase in turns, wrapped into [0, 1)
+         */
+        void set_phase(int voice, double turns);
+
+        /**
+         * @brief Gets the phase of a voice
+         *
+         * @param voice Index of the voice
+         * @return double Phase in turns, in [0, 1)
+         */
+        double get_phase(int voice) const { return this->phase.at(voice); }
+
+        /**
+         * @brief Configures the bank as a harmonic series
+         *
+         * Voice k plays (k + 1) times the fundamental,
+         * with the k-th amplitude given.
+         * The number of voices is set to the number of amplitudes,
+         * and all phases are reset to 0.
+         *
+         * @param fundamental Frequency of the first harmonic in hertz
+         * @param amps Amplitude of each harmonic
+         */
+        void set_harmonics(double fundamental, const std::vector<double>& amps);
+
+        /**
+         * @brief Sets how voices are written to the output
+         *
+         * @param out Output to use
+         */
+        void set_output(Output out) { this->output = out; }
+
+        /**
+         * @brief Gets how voices are written to the output
+         *
+         * @return Output Current output
+         */
+        Output get_output() const { return this->output; }
+
+    private:
+
+        /// Vector of kernel values, aligned for the bank kernels
+        using BankVector = std::vector<float, AlignedAllocator<float>>;
+
+        /**
+         * @brief Recomputes the increment and amplitude of each voice
+         *
+         * @param rate Sample rate in hertz
+         */
+        void update(double rate);
+
+        /// Frequency of each voice in hertz
+        std::vector<double> freq;
+
+        /// Amplitude of each voice, as set by the user
+        std::vector<double> level;
+
+        /// Phase of each voice in turns, padded
+        BankVector phase;
+
+        /// Phase increment of each voice in turns, padded
+        BankVector inc;
+
+        /// Amplitude of each voice given to the kernels, padded
+        BankVector amp;
+
+        /// Scratch space for planar voice output
+        std::vector<sample_t> scratch;
+
+        /// Sample rate the increments were computed for
+        double rate = 0;
+
+        /// Determines if the increments must be recomputed
+        bool dirty = true;
+
+        /// How voices are written to the output
+        Output output = Output::Sum;
+};
@@ -0,0 +1,276 @@
+/**
+ * @file oversample_module.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief A module that runs a sub-chain at a higher sample rate
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Nonlinear processes (distortion, waveshaping, saturation) create harmonics
+ * far above the frequencies they are given.
+ * Any harmonic past the Nyquist frequency folds back down as aliasing,
+ * which is very audible and can't be filtered out afterwards.
+ *
+ * The common fix is to oversample: the signal is upsampled, processed at the higher rate
+ * where the harmonics have room, lowpassed, and then decimated back down.
+ * The OversampleModule does this for any sub-chain.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "audio_module.hpp"
+#include "dsp/halfband.hpp"
+
+/**
+ * @brief Runs a sub-chain at 2, 4, 8 or 16 times our sample rate
+ *
+ * The sub-chain is given with set_chain(), using the module at the front of the sub-chain
+ * (which outputs the processed audio) and the module at the back (which is fed the upsampled audio).
+ * The sub-chain should be bound together as usual, but not to anything outside of it.
+ *
+ * Each block we receive is upsampled by a cascade of half-band interpolators (see dsp/halfband.hpp),
+ * one for each doubling of the rate, and handed to the sub-chain.
+ * The output of the sub-chain is then brought back down by the matching decimators.
+ * The first stage (next to our rate) uses the number of taps given to us,
+ * as its transition band is the narrowest.
+ * Each later stage uses half as many taps as the one before it,
+ * down to a minimum of MIN_TAPS.
+ *
+ * The sub-chain gets its own ChainInfo, whose sample rate and buffer size
+ * are multiplied by the factor, with its own buffer pool and clock.
+ * The sub-chain must output buffers with the same size and channels as it receives.
+ *
+ * The filters add a fixed latency, reported through our ModuleInfo (see latency()).
+ * The latency is the sum of the delay of each filter at our rate, rounded to the nearest sample.
+ *
+ * The modules behind us are reported as usual,
+ * but the sub-chain is processed within our own process().
+ */
+class OversampleModule : public AudioModule {
+
+    public:
+
+        /// Smallest number of side taps used by a stage
+        static constexpr int MIN_TAPS = 8;
+
+        /// Largest supported oversampling factor
+        static constexpr int MAX_FACTOR = 16;
+
+        /**
+         * @brief Construct a new Oversample Module object
+         *
+         * @param factor Oversampling factor, rounded down to a power of 2
+         * @param num Number of side taps in the first stage
+         */
+        explicit OversampleModule(int factor = 2, int num = 32) : taps(num) { this->set_factor(factor); }
+
+        /**
+         * @brief Upsamples the block, processes the sub-chain, and decimates the result
+         */
+        void process() override;
+
+        /**
+         * @brief Syncs our info with the module in front of us
+         *
+         * We mirror the forward module, and report our latency.
+         */
+        void info_sync() override;
+
+        /**
+         * @brief Syncs ourselves, the sub-chain, and then the modules behind us
+         *
+         * We configure the ChainInfo of the sub-chain from our info,
+         * and point every module in the sub-chain at it.
+         */
+        void meta_info_sync() override;
+
+        /**
+         * @brief Starts the sub-chain, the modules behind us and then ourselves
+         */
+        void meta_start() override;
+
+        /**
+         * @brief Stops the sub-chain, the modules behind us and then ourselves
+         */
+        void meta_stop() override;
+
+        /**
+         * @brief Designs the filters and clears their history
+         */
+        void start() override;
+
+        /**
+         * @brief Adds the memory held by this module
+         *
+         * We count the halfband stages and the working buffers.
+         *
+         * @param usage Footprint to add to
+         */
+        void footprint(MemoryFootprint& usage) const override;
+
+        /**
+         * @brief Sets the sub-chain to run at the higher rate
+         *
+         * @param front Module at the front of the sub-chain, which outputs the processed audio
+         * @param back Module at the back of the sub-chain, which is fed the upsampled audio
+         */
+        void set_chain(AudioModule* front, AudioModule* back);
+
+        /**
+         * @brief Sets the oversampling factor
+         *
+         * This must be set before the chain is synced.
+         *
+         * @param factor Factor, rounded down to a power of 2 between 1 and MAX_FACTOR
+         */
+        void set_factor(int factor);
+
+        /**
+         * @brief Gets the oversampling factor
+         *
+         * @return int Factor the sub-chain runs at
+         */
+        int get_factor() const { return 1 << this->stages; }
+
+        /**
+         * @brief Gets the number of half-band stages
+         *
+         * @return int One stage for each doubling of the rate
+         */
+        int get_stages() const { return this->stages; }
+
+        /**
+         * @brief Sets the number of side taps in the first stage
+         *
+         * More taps give a sharper filter, at the cost of more work and latency.
+         * This must be set before we are started.
+         *
+         * @param num Number of side taps, rounded up to an even number
+         */
+        void set_taps(int num) { this->taps = num; }
+
+        /**
+         * @brief Gets the number of side taps used by a stage
+         *
+         * @param stage Stage to check, 0 being the stage next to our rate
+         * @return int Number of side taps, always even
+         */
+        int get_taps(int stage = 0) const;
+
+        /**
+         * @brief Gets the latency we add, in samples at our rate
+         *
+         * @return int Latency of the filters
+         */
+        int latency() const;
+
+        /**
+         * @brief Gets the ChainInfo used by the sub-chain
+         *
+         * @return ChainInfo* ChainInfo of the sub-chain
+         */
+        ChainInfo* get_inner_chain() { return &(this->inner_chain); }
+
+    private:
+
+        /**
+         * @brief Connects the sub-chain to us
+         *
+         * The port feeds upsampled blocks to the back of the sub-chain,
+         * and describes the higher rate to the front of it.
+         */
+        class Port : public AudioModule {
+
+            public:
+
+                /// The port is configured by the oversampler
+                void info_sync() override {}
+
+                /// The buffer is handed to us directly
+                void meta_process() override {}
+
+                /// Nothing behind us to sync
+                void meta_info_sync() override {}
+
+                /// Nothing behind us to start
+                void meta_start() override { BaseModule::start(); }
+
+                /// Nothing behind us to stop
+                void meta_stop() override { BaseModule::stop(); }
+
+                /// Nothing behind us to finish
+                void meta_finish() override { BaseModule::finish(); }
+
+                /// Nothing behind us to report
+                bool plan_inputs(std::vector<AudioModule*>& /*inputs*/) override { return false; }
+        };
+
+        /**
+         * @brief Upsamples one channel through every stage
+         *
+         * @param channel Channel to upsample
+         * @param input Pointer to samples at our rate
+         * @param frames Number of samples at our rate
+         * @param output Pointer to output, must have room for frames * factor samples
+         */
+        void upsample(int channel, const sample_t* input, int frames, sample_t* output);
+
+        /**
+         * @brief Decimates one channel through every stage
+         *
+         * @param channel Channel to decimate
+         * @param input Pointer to frames * factor samples at the higher rate
+         * @param frames Number of samples at our rate
+         * @param output Pointer to output samples
+         */
+        void downsample(int channel, const sample_t* input, int frames, sample_t* output);
+
+        /**
+         * @brief Ensures the filters and scratch space fit a block
+         *
+         * The filters are only designed again if the number of channels changed.
+         *
+         * @param channels Number of channels to prepare for
+         * @param frames Number of frames at our rate to prepare for
+         */
+        void prepare(int channels, int frames);
+
+        /// Number of half-band stages
+        int stages = 1;
+
+        /// Number of side taps in the first stage
+        int taps = 32;
+
+        /// Number of channels the filters are prepared for
+        int prepared = 0;
+
+        /// Filters for each stage and channel, indexed by stage * channels + channel
+        std::vector<HalfbandFIR<sample_t>> filters;
+
+        /// Planar samples at our rate
+        std::vector<sample_t> low;
+
+        /// Planar samples at the higher rate
+        std::vector<sample_t> high;
+
+        /// Scratch space between stages
+        std::vector<sample_t> ping;
+
+        /// Scratch space between stages
+        std::vector<sample_t> pong;
+
+        /// ChainInfo used by the sub-chain
+        ChainInfo inner_chain;
+
+        /// Connects the sub-chain to us
+        Port port;
+
+        /// Module at the front of the sub-chain
+        AudioModule* front = nullptr;
+
+        /// Module at the back of the sub-chain
+        AudioModule* back = nullptr;
+};
@@ -0,0 +1,245 @@
+/**
+ * @file render.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Components for rendering chains offline
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * When rendering to disk (bouncing), there is no device to keep up with,
+ * so chains can be run as fast as the machine allows.
+ * Real-time block sizes are small to keep latency down,
+ * but offline there is no latency to worry about,
+ * so we use large blocks to cut the per-block overhead of each module.
+ *
+ * The OfflineRenderer takes a number of independent chains (jobs),
+ * each ending in a wave file,
+ * and renders them across a WorkerPool.
+ * We report how long each job took, and how much faster than real-time it was.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "audio_module.hpp"
+#include "executor.hpp"
+#include "io/mstream.hpp"
+#include "io/wav.hpp"
+
+/**
+ * @brief A chain to render offline
+ *
+ * The chain is rendered into a WaveSink owned by the renderer,
+ * so the module given should be the last module of the chain, NOT a sink.
+ * The chain must not be shared with any other job!
+ */
+struct RenderJob {
+
+    /// Last module in the chain to render
+    AudioModule* mod = nullptr;
+
+    /// Stream to write the wave file to
+    BaseMOStream* stream = nullptr;
+
+    /// Number of frames to render
+    int64_t frames = 0;
+
+    /// Number of channels to render
+    int channels = 1;
+
+    /// Sample rate to render at
+    int sample_rate = SAMPLE_RATE;
+};
+
+/**
+ * @brief Results of rendering a job
+ */
+struct RenderResult {
+
+    /// Number of frames written
+    int64_t frames = 0;
+
+    /// Time taken to render, in nanoseconds
+    int64_t time = 0;
+
+    /// Duration of the audio rendered, in seconds
+    double duration = 0;
+
+    /**
+     * @brief Determines how much faster than real-time we rendered
+     *
+     * @return double Duration of the audio divided by the time taken
+     */
+    double realtime() const { return this->time > 0 ? this->duration / (static_cast<double>(this->time) / NANO) : 0; }
+};
+
+/**
+ * @brief Results of rendering a batch of jobs
+ */
+struct RenderReport {
+
+    /// Results of each job, in the order the jobs were added
+    std::vector<RenderResult> jobs;
+
+    /// Wall time taken to render every job, in nanoseconds
+    int64_t time = 0;
+
+    /**
+     * @brief Gets the total duration of audio rendered
+     *
+     * @return double Duration in seconds
+     */
+    double duration() const;
+
+    /**
+     * @brief Determines how much faster than real-time the batch rendered
+     *
+     * Jobs rendered in parallel all count,
+     * so this can exceed the speed of a single job.
+     *
+     * @return double Total duration of the audio divided by the wall time
+     */
+    double realtime() const { return this->time > 0 ? this->duration() / (static_cast<double>(this->time) / NANO) : 0; }
+};
+
+/**
+ * @brief Renders chains to wave files faster than real-time
+ *
+ * Jobs are added with add_job(), and rendered when run() is called.
+ * If a WorkerPool is set, then jobs are rendered in parallel,
+ * otherwise they are rendered one after another on the calling thread.
+ * Each job is synced, started and stopped by us,
+ * so do not call meta_info_sync() or meta_start() yourself.
+ *
+ * A job stops once the requested number of frames are written,
+ * or once every module in its chain is done.
+ * The final block is trimmed, so exactly the requested number of frames are written.
+ */
+class OfflineRenderer {
+
+    public:
+
+        OfflineRenderer() =default;
+
+        /**
+         * @brief Construct a new OfflineRenderer object
+         *
+         * @param size Number of frames to render per block
+         */
+        explicit OfflineRenderer(int size) { this->set_block_size(size); }
+
+        /**
+         * @brief Adds a job to render
+         *
+         * @param job Job to add
+         * @return int Index of the job
+         */
+        int add_job(const RenderJob& job);
+
+        /**
+         * @brief Gets the number of jobs
+         *
+         * @return int Number of jobs
+         */
+        int num_jobs() const { return static_cast<int>(this->jobs.size()); }
+
+        /**
+         * @brief Removes every job
+         *
+         */
+        void clear() { this->jobs.clear(); }
+
+        /**
+         * @brief Renders every job
+         *
+         * @return RenderReport Results of the batch
+         */
+        RenderReport run();
+
+        /**
+         * @brief Sets the number of frames to render per block
+         *
+         * @param size Block size
+         */
+        void set_block_size(int size) { this->block = std::max(1, size); }
+
+        /**
+         * @brief Gets the number of frames to render per block
+         *
+         * @return int Block size
+         */
+        int get_block_size() const { return this->block; }
+
+        /**
+         * @brief Sets the bits per sample of the wave files
+         *
+         * @param bits Bits per sample
+         */
+        void set_bits_per_sample(int bits) { this->bits = bits; }
+
+        /**
+         * @brief Gets the bits per sample of the wave files
+         *
+         * @return int Bits per sample
+         */
+        int get_bits_per_sample() const { return this->bits; }
+
+        /**
+         * @brief Sets if the wave files store float samples
+         *
+         * Float samples are always 32 bits.
+         *
+         * @param val true to store float samples
+         */
+        void set_float(bool val) { this->floats = val; }
+
+        /**
+         * @brief Determines if the wave files store float samples
+         *
+         * @return true If we store float samples
+         */
+        bool get_float() const { return this->floats; }
+
+        /**
+         * @brief Sets the pool to render jobs on
+         *
+         * @param pool Pool to use, nullptr to render on the calling thread
+         */
+        void set_pool(WorkerPool* pool) { this->pool = pool; }
+
+        /**
+         * @brief Gets the pool to render jobs on
+         *
+         * @return WorkerPool* Pool in use, nullptr if none
+         */
+        WorkerPool* get_pool() const { return this->pool; }
+
+        /**
+         * @brief Renders a single job
+         *
+         * @param job Job to render
+         * @return RenderResult Results of the job
+         */
+        RenderResult render(const RenderJob& job) const;
+
+    private:
+
+        /// Jobs to render
+        std::vector<RenderJob> jobs;
+
+        /// Number of frames per block
+        int block = 8192;
+
+        /// Bits per sample of the wave files
+        int bits = 16;
+
+        /// Determines if we store float samples
+        bool floats = false;
+
+        /// Pool to render jobs on
+        WorkerPool* pool = nullptr;
+};
@@ -0,0 +1,207 @@
+/**
+ * @file resample_module.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief A module that changes the sample rate of audio data
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Sources do not always produce audio at the rate of the chain.
+ * For example, a wave file recorded at 44.1 kHz may be played into
+ * a chain running at 48 kHz.
+ * The ResampleModule converts audio data from one rate to another,
+ * so the modules in front of it see audio at the rate of the chain.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "audio_module.hpp"
+
+/**
+ * @brief Converts audio data to the sample rate of the chain
+ *
+ * We use a polyphase FIR filter (see dsp/resample.hpp),
+ * which supports any ratio between the input and output rates.
+ * The filter table is built when the ratio is first known,
+ * after that the cost of each block is fixed.
+ *
+ * The output rate is the rate of the module in front of us.
+ * The input rate can be set via set_input_rate(),
+ * in which case the modules behind us are configured with this rate.
+ * If the input rate is not set, we use the sample rate of the buffers we receive,
+ * which is useful for sources that configure themselves (such as the WaveSource).
+ *
+ * As the number of input samples needed for each block varies,
+ * we process the modules behind us as many times as needed,
+ * and keep any leftover samples for the next block.
+ * This means we report no inputs, and are meta processed as a whole.
+ *
+ * We add a latency of half of the filter length.
+ */
+class ResampleModule : public AudioModule {
+
+    public:
+
+        ResampleModule() =default;
+
+        /**
+         * @brief Generates a block at the output rate
+         *
+         * We pull blocks from the modules behind us until we have
+         * enough input samples, and then resample each channel.
+         */
+        void meta_process() override;
+
+        /**
+         * @brief Syncs the modules behind us
+         *
+         * We save the output rate from the module in front of us,
+         * and configure the modules behind us with the input rate (if set).
+         */
+        void meta_info_sync() override;
+
+        /**
+         * @brief Starts this module
+         *
+         * We discard any samples left over from previous runs.
+         */
+        void start() override;
+
+        /**
+         * @brief Adds the memory held by this resampler
+         *
+         * We count the filter table and the history of each channel.
+         *
+         * @param usage Footprint to add to
+         */
+        void footprint(MemoryFootprint& usage) const override;
+
+        /**
+         * @brief Reports the modules that must be processed before us
+         *
+         * We process the modules behind us ourselves,
+         * so we report nothing and ask to be meta processed.
+         *
+         * @param inputs Vector to add modules to
+         * @return false Always
+         */
+        bool plan_inputs(std::vector<AudioModule*>& inputs) override;
+
+        /**
+         * @brief Sets the input sample rate
+         *
+         * A value of 0 uses the sample rate of the buffers we receive.
+         *
+         * @param rate New input rate
+         */
+        void set_input_rate(double rate) { this->input_rate = rate; }
+
+        /**
+         * @brief Gets the input sample rate
+         *
+         * @return double Input rate, 0 if taken from the buffers we receive
+         */
+        double get_input_rate() const { return this->input_rate; }
+
+        /**
+         * @brief Gets the output sample rate
+         *
+         * This is only valid after the chain has been synced.
+         *
+         * @return double Output rate
+         */
+        double get_output_rate() const { return this->output_rate; }
+
+        /**
+         * @brief Sets the number of taps in each sub-filter
+         *
+         * More taps give a sharper filter, at the cost of more work and latency.
+         * This must be set before we are started.
+         *
+         * @param num Number of taps, rounded up to an even number
+         */
+        void set_taps(int num) { this->taps = std::max(2, num + (num % 2)); }
+
+        /**
+         * @brief Gets the number of taps in each sub-filter
+         *
+         * @return int Number of taps
+         */
+        int get_taps() const { return this->taps; }
+
+        /**
+         * @brief Sets the number of phases in the filter table
+         *
+         * More phases give a more accurate fractional delay,
+         * at the cost of a larger table.
+         * This must be set before we are started.
+         *
+         * @param num Number of phases
+         */
+        void set_phases(int num) { this->phases = std::max(1, num); }
+
+        /**
+         * @brief Gets the number of phases in the filter table
+         *
+         * @return int Number of phases
+         */
+        int get_phases() const { return this->phases; }
+
+        /**
+         * @brief Gets the ratio between the output and input rates
+         *
+         * This is only valid once the first block has been received.
+         *
+         * @return double Output rate divided by input rate
+         */
+        double get_ratio() const { return this->ratio; }
+
+        /**
+         * @brief Gets the latency we add, in input samples
+         *
+         * @return int Latency in input samples
+         */
+        int latency() const { return this->taps / 2; }
+
+    private:
+
+        /**
+         * @brief Pulls a block from the modules behind us
+         *
+         * The block is split into channels and added to the history.
+         */
+        void pull();
+
+        /// Input sample rate, 0 to use rate of buffers
+        double input_rate = 0;
+
+        /// Output sample rate
+        double output_rate = 0;
+
+        /// Current rate of input samples
+        double current_rate = 0;
+
+        /// Output rate divided by input rate
+        double ratio = 0;
+
+        /// Number of taps in each sub-filter
+        int taps = 64;
+
+        /// Number of phases in the filter table
+        int phases = 256;
+
+        /// Polyphase filter table
+        std::vector<sample_t> table;
+
+        /// Input samples for each channel
+        std::vector<std::vector<sample_t>> history;
+
+        /// Position of the next output sample in the history
+        double position = 0;
+
+        /// Scratch space for splitting and joining channels
+        std::vector<sample_t> scratch;
+};
@@ -0,0 +1,187 @@
+/**
+ * @file router_module.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief A module that routes channels through a matrix of gains
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Surround and ambisonic rendering, downmixing and upmixing all
+ * send each input channel to each output channel at some gain.
+ * The ChannelRouter does all of this in one pass,
+ * rather than splitting channels apart and mixing them back together.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "audio_module.hpp"
+#include "dsp/matrix.hpp"
+
+/**
+ * @brief Routes input channels to output channels through a matrix of gains
+ *
+ * Each output channel is the sum of every input channel scaled by a gain:
+ *
+ * out[o] = gain(o, 0) * in[0] + gain(o, 1) * in[1] + ...
+ *
+ * Which is the matrix product of the gains and the incoming buffer (see dsp/matrix.hpp).
+ * For example, a stereo downmix of a 3 channel (L, R, C) buffer would be:
+ *
+ * L' = 1 * L + 0 * R + 0.707 * C
+ * R' = 0 * L + 1 * R + 0.707 * C
+ *
+ * Dense matrices (such as ambisonic decoders) are applied with gemm().
+ * Most routing matrices are sparse, so when at most half of the gains are non-zero,
+ * we only visit the non-zero gains and skip the rest entirely.
+ *
+ * We ask the module behind us for one channel per input,
+ * and produce buffers with one channel per output.
+ * If the incoming buffer has fewer channels than we expect,
+ * then the missing channels are treated as silence.
+ *
+ * All memory is allocated when the size of the matrix is set,
+ * so processing and changing gains never allocates.
+ */
+class ChannelRouter : public AudioModule {
+
+    public:
+
+        /**
+         * @brief A non-zero gain of the matrix
+         *
+         */
+        struct Route {
+
+            /// Output channel
+            int output = 0;
+
+            /// Input channel
+            int input = 0;
+
+            /// Gain from the input to the output
+            sample_t gain = 0;
+        };
+
+        /**
+         * @brief Construct a new Channel Router object
+         *
+         * We default to passing a single channel through.
+         */
+        ChannelRouter() : ChannelRouter(1, 1) { this->set_identity(); }
+
+        /**
+         * @brief Construct a new Channel Router object
+         *
+         * All gains start at 0.
+         *
+         * @param inputs Number of input channels
+         * @param outputs Number of output channels
+         */
+        ChannelRouter(int inputs, int outputs) { this->set_size(inputs, outputs); }
+
+        /**
+         * @brief Routes the incoming buffer
+         *
+         * We create a new buffer with one channel per output.
+         */
+        void process() override;
+
+        /**
+         * @brief Syncs our info with the module in front of us
+         *
+         * We mirror the forward module,
+         * but ask the module behind us for one channel per input.
+         */
+        void info_sync() override;
+
+        /**
+         * @brief Sets the size of the matrix
+         *
+         * This clears all gains to 0,
+         * and allocates, so this should not be called while processing.
+         *
+         * @param inputs Number of input channels
+         * @param outputs Number of output channels
+         */
+        void set_size(int inputs, int outputs);
+
+        /**
+         * @brief Gets the number of input channels
+         *
+         * @return int Number of input channels
+         */
+        int inputs() const { return static_cast<int>(this->gains.channel_capacity()); }
+
+        /**
+         * @brief Gets the number of output channels
+         *
+         * @return int Number of output channels
+         */
+        int outputs() const { return static_cast<int>(this->gains.channels()); }
+
+        /**
+         * @brief Sets the gain from an input to an output
+         *
+         * @param output Output channel
+         * @param input Input channel
+         * @param gain Gain to apply
+         */
+        void set_gain(int output, int input, sample_t gain);
+
+        /**
+         * @brief Gets the gain from an input to an output
+         *
+         * @param output Output channel
+         * @param input Input channel
+         * @return sample_t Gain applied
+         */
+        sample_t get_gain(int output, int input) const { return this->gains.at(output, input); }
+
+        /**
+         * @brief Routes each input to the output of the same number
+         *
+         * Any other gains are set to 0.
+         */
+        void set_identity();
+
+        /**
+         * @brief Gets the matrix of gains
+         *
+         * Each channel is an output, and each sample is an input.
+         *
+         * @return const Buffer<sample_t>& Matrix of gains
+         */
+        const Buffer<sample_t>& get_matrix() const { return this->gains; }
+
+        /**
+         * @brief Gets the non-zero gains, ordered by output
+         *
+         * @return const std::vector<Route>& Non-zero gains
+         */
+        const std::vector<Route>& get_routes() const { return this->routes; }
+
+        /**
+         * @brief Determines if we skip the zero gains when processing
+         *
+         * @return true If at most half of the gains are non-zero
+         * @return false If we use the dense product
+         */
+        bool is_sparse() const { return this->routes.size() * 2 <= this->gains.size(); }
+
+    private:
+
+        /**
+         * @brief Rebuilds the list of non-zero gains
+         *
+         */
+        void update_routes();
+
+        /// Matrix of gains, one channel per output and one sample per input
+        Buffer<sample_t> gains;
+
+        /// Non-zero gains, ordered by output
+        std::vector<Route> routes;
+};
@@ -16,8 +16,12 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
+
 #include "audio_module.hpp"
+#include "chrono.hpp"
 
 /**
  * @brief Sink module, base class for outputting audio data
@@ -55,6 +59,9 @@ class SinkModule : public AudioModule {
         /// ChainInfo instance, to be shared with backward modules
         ChainInfo chain_instance;
 
+        /// Value determining if denormals were flushed before we started
+        bool flushed = false;
+
     public:
 
         /**
@@ -77,6 +84,60 @@ class SinkModule : public AudioModule {
          * 
          */
         void info_sync() override;
+
+        /**
+         * @brief Starts the chain
+         *
+         * If the chain asks for it (see ChainInfo::flush_denormals),
+         * then the calling thread flushes denormals to zero from here on,
+         * as this is usually the thread that processes the chain.
+         * Then, the chain is started like normal.
+         *
+         * If the chain has a memory budget (see ChainInfo::memory_budget),
+         * then the memory held by the started chain is measured (see chain_footprint()).
+         * A chain over budget is stopped right away,
+         * and ChainInfo::over_budget is set so the caller can tell.
+         */
+        void meta_start() override;
+
+        /**
+         * @brief Stops the chain
+         *
+         * Once stopped, the denormal mode of the calling thread
+         * is set back to what it was before we started.
+         */
+        void meta_stop() override;
+
+        /**
+         * @brief Processes this sink
+         *
+         * We step like any other module,
+         * and then advance the chain sample time
+         * to the start of the next block.
+         */
+        void step() override;
+
+        /**
+         * @brief Sets the number of frames in the following blocks
+         *
+         * Sinks can ask for exactly the frames a backend wants,
+         * as long as it is no larger than the max block size of the chain
+         * (see ChainInfo::max_buffer), which must be declared before syncing.
+         * Buffers are given room for the max block size when the chain is synced,
+         * so changing the frame count never allocates.
+         *
+         * @param num Number of frames, 0 to use the buffer size of the chain
+         */
+        void set_frames(int num);
+
+        /**
+         * @brief Determines if this module processes in place
+         * 
+         * We hold onto the incoming buffer.
+         * 
+         * @return true Always
+         */
+        bool in_place() const override { return true; }
 };
 
 /**
@@ -93,13 +154,58 @@ class SinkModule : public AudioModule {
  * and we automatically handle it for you.
  * 
  * This sink could be used in contexts where periods are utilized.
+ *
+ * We also measure the DSP load of the chain.
+ * Each time we are processed, we time how long the chain behind us
+ * took to render, and divide it by the time the rendered audio represents
+ * (using the nanoseconds per frame from a ChainTimer).
+ * A load of 1 means rendering took exactly as long as playback will,
+ * and any block with a load above 1 is counted as a deadline miss,
+ * as a real-time backend would have run dry.
+ * Time spent outputting the audio (such as waiting on a device) is not counted.
+ *
+ * An overload callback may be set, which is invoked on the rendering thread
+ * whenever the load of a block reaches a threshold.
+ * This can be used to raise alarms, or to degrade gracefully
+ * before users hear dropouts, such as shedding voices
+ * (see VoiceManager::shed_voices()).
+ * The load statistics are atomic, so other threads may read them at any time.
  */
 class PeriodSink : public SinkModule {
+public:
+
+    /// Function invoked when a block overloads, given the sink and the load of the block
+    using LoadCallback = std::function<void(PeriodSink&, double)>;
+
 private:
 
     /// Number of periods per process
     int periods = 1;
 
+    /// Timer used to determine the duration of frames
+    ChainTimer timer;
+
+    /// Load of the last block
+    std::atomic<double> load{0};
+
+    /// Smoothed load
+    std::atomic<double> average{0};
+
+    /// Highest load since the last reset
+    std::atomic<double> peak{0};
+
+    /// Number of blocks measured
+    std::atomic<uint64_t> blocks{0};
+
+    /// Number of blocks that missed their deadline
+    std::atomic<uint64_t> misses{0};
+
+    /// Load at which the overload callback is invoked
+    double threshold = 0.9;
+
+    /// Function invoked when a block overloads
+    LoadCallback overload;
+
 public:
 
     /**
@@ -140,4 +246,82 @@ public:
      * 
      */
     void meta_process() override;
+
+    /**
+     * @brief Records the time taken to render a block
+     *
+     * This is called by meta_process(),
+     * but can be called by anything else that renders the chain behind us
+     * (such as a ChainPlan) so the load is still measured.
+     *
+     * @param time Time taken to render, in nanoseconds
+     * @param frames Number of frames rendered
+     */
+    void record_render(int64_t time, int frames);
+
+    /**
+     * @brief Gets the load of the last block
+     *
+     * @return double Render time divided by the duration of the block
+     */
+    double get_load() const { return this->load.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Gets the smoothed load
+     *
+     * This is an exponential moving average of the load of each block,
+     * which is better suited to displays than the load of a single block.
+     *
+     * @return double Smoothed load
+     */
+    double get_average_load() const { return this->average.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Gets the highest load since the last reset
+     *
+     * @return double Peak load
+     */
+    double get_peak_load() const { return this->peak.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Gets the number of blocks measured
+     *
+     * @return uint64_t Number of blocks
+     */
+    uint64_t get_blocks() const { return this->blocks.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Gets the number of blocks that missed their deadline
+     *
+     * @return uint64_t Number of deadline misses
+     */
+    uint64_t get_misses() const { return this->misses.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Clears the load statistics
+     *
+     */
+    void reset_load();
+
+    /**
+     * @brief Sets the overload callback
+     *
+     * The callback is invoked on the rendering thread,
+     * so it must be real-time safe!
+     *
+     * @param func Function to invoke, or an empty function for none
+     * @param level Load at which the function is invoked
+     */
+    void set_overload(LoadCallback func, double level = 0.9) {
+
+        this->overload = std::move(func);
+        this->threshold = level;
+    }
+
+    /**
+     * @brief Gets the load at which the overload callback is invoked
+     *
+     * @return double Overload threshold
+     */
+    double get_overload_threshold() const { return this->threshold; }
 };
@@ -30,6 +30,12 @@
  * 
  * The biggest difference between source modules
  * and conventional modules is that we will NEVER process back modules.
+ *
+ * While the chain is warming up (see ChainInfo::warming),
+ * we output zeros without processing,
+ * so warm-up blocks do not consume any of our state.
+ * The zeros are not marked as silent,
+ * so the modules after us are not skipped and are still warmed.
  */
 class SourceModule : public AudioModule {
     public:
@@ -40,10 +46,30 @@ class SourceModule : public AudioModule {
          * This method is identical to the conventional
          * audio module counterpart,
          * except that we don't process any back modules.
+         * If the chain is warming up, we output zeros instead.
          * 
          */
         void meta_process() override;
 
+        /**
+         * @brief Steps this module
+         * 
+         * As we have no backward modules,
+         * this is identical to meta processing.
+         * 
+         */
+        void step() override { this->meta_process(); }
+
+        /**
+         * @brief Determines the modules we pull buffers from
+         * 
+         * We have no backward modules, so we add nothing.
+         * 
+         * @param inputs Vector to add modules to
+         * @return true Always
+         */
+        bool plan_inputs(std::vector<AudioModule*>& /*inputs*/) override { return true; }
+
         /**
          * @brief Meta start method
          * 
@@ -0,0 +1,361 @@
+/**
+ * @file static_chain.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Chains fused at compile time
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Normally, each module in a chain processes a whole buffer,
+ * and hands it to the next module with a virtual call.
+ * For simple chains, such as an oscillator followed by some amplitude modules,
+ * the virtual calls and buffer round trips dominate the cost.
+ *
+ * This file contains a chain whose modules are known at compile time.
+ * The modules are fused into one loop that computes each sample
+ * by passing it through every module, so the sample stays in a register
+ * and the compiler can inline everything.
+ *
+ * Chains can also opt into a block size that is known at compile time (see StaticBlockChain).
+ * Modules are then handed fixed extent spans, so every loop has a known trip count,
+ * which the compiler can fully unroll and vectorize.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <tuple>
+#include <utility>
+
+#include "source_module.hpp"
+
+/**
+ * @brief Prepares a fused module, if it wants to be
+ *
+ * @tparam M Module type
+ * @param mod Module to prepare
+ * @param sample_rate Sample rate of the block
+ */
+template <typename M>
+void fused_prepare_one(M& mod, double sample_rate) {
+
+    if constexpr (requires { mod.fused_prepare(sample_rate); }) {
+
+        mod.fused_prepare(sample_rate);
+    }
+}
+
+/**
+ * @brief Commits a fused module, if it wants to be
+ *
+ * @tparam M Module type
+ * @param mod Module to commit
+ * @param num Number of samples generated
+ */
+template <typename M>
+void fused_commit_one(M& mod, int num) {
+
+    if constexpr (requires { mod.fused_commit(num); }) {
+
+        mod.fused_commit(num);
+    }
+}
+
+/**
+ * @brief A chain of modules fused at compile time
+ *
+ * The first module generates samples, and each following module
+ * alters them in order.
+ * For example, StaticChain<SineOscillator, AmplitudeScale>
+ * generates a sine wave and scales it.
+ *
+ * The modules are the usual maec module classes,
+ * they just need to offer a fused interface:
+ *
+ * - sample_t fused_tick(sample_t input) - Processes a single sample (required)
+ * - void fused_prepare(double sample_rate) - Called before each block (optional)
+ * - void fused_commit(int num) - Called after each block (optional)
+ *
+ * The first module is given a zero input.
+ * Modules are default constructed, use get() to configure them.
+ *
+ * This chain is a SourceModule, so it can be bound into a normal chain
+ * like any other module, and the dynamic bind() API is used for everything else.
+ * The modules we hold are never bound, synced or started,
+ * so only modules that don't rely on these operations should be used.
+ *
+ * @tparam Modules Modules to fuse, in processing order
+ */
+template <typename... Modules>
+class StaticChain : public SourceModule {
+
+    static_assert(sizeof...(Modules) > 0, "StaticChain requires at least one module");
+
+   private:
+
+    /// Modules in this chain
+    std::tuple<Modules...> modules;
+
+    /**
+     * @brief Passes a single sample through every module
+     *
+     * @tparam I Indices of the modules
+     * @return sample_t Final sample
+     */
+    template <std::size_t... I>
+    sample_t tick(std::index_sequence<I...> /*indices*/) {
+
+        sample_t val = 0;
+
+        ((val = std::get<I>(this->modules).fused_tick(val)), ...);
+
+        return val;
+    }
+
+   public:
+
+    StaticChain() = default;
+
+    /**
+     * @brief Gets a module in this chain
+     *
+     * @tparam I Index of the module
+     * @return auto& Reference to the module
+     */
+    template <std::size_t I>
+    auto& get() { return std::get<I>(this->modules); }
+
+    /**
+     * @brief Gets the number of modules in this chain
+     *
+     * @return constexpr std::size_t Number of modules
+     */
+    static constexpr std::size_t size() { return sizeof...(Modules); }
+
+    /**
+     * @brief Fills a block of memory with the output of this chain
+     *
+     * This can be used without binding this chain to anything.
+     *
+     * @param out Pointer to output data
+     * @param num Number of samples to generate
+     * @param sample_rate Sample rate of the data
+     */
+    void fill(sample_t* out, int num, double sample_rate) {
+
+        // Prepare each module:
+
+        std::apply([sample_rate](auto&... mod) { (fused_prepare_one(mod, sample_rate), ...); }, this->modules);
+
+        // Run the fused loop:
+
+        for (int i = 0; i < num; ++i) {
+
+            out[i] = this->tick(std::index_sequence_for<Modules...>{});
+        }
+
+        // Commit each module:
+
+        std::apply([num](auto&... mod) { (fused_commit_one(mod, num), ...); }, this->modules);
+    }
+
+    /**
+     * @brief Processes this chain
+     *
+     * We create a new buffer and fill it with our output.
+     */
+    void process() override {
+
+        this->set_buffer(this->create_buffer());
+
+        this->fill(this->buff->data(), static_cast<int>(this->buff->size()), this->buff->get_samplerate());
+    }
+};
+
+/**
+ * @brief A chain of modules fused at compile time, processed in blocks of a fixed size
+ *
+ * This is like StaticChain, except we process one module at a time
+ * over a block of BLOCK samples, rather than one sample at a time over every module.
+ * Each stage is then a loop with a trip count known at compile time,
+ * working on memory the compiler knows the extent of.
+ *
+ * Modules may offer a block interface, in addition to the fused interface of StaticChain:
+ *
+ * - void fused_block(std::span<sample_t, BLOCK> data) - Processes a whole block in place (optional)
+ *
+ * Modules without it have fused_tick() called for each sample of the block.
+ * Because each module sees every sample of the block before the next module does,
+ * a module may only depend on its own input, which is true of the fused interface.
+ *
+ * Whole blocks are generated straight into the output.
+ * When the output is not a multiple of BLOCK, the final block is generated into a StaticBuffer,
+ * and the samples we don't use are handed out first on the next call.
+ * So, the output is the same as StaticChain, but changes to the modules
+ * may take effect up to BLOCK - 1 samples late.
+ * Pick a BLOCK that divides the buffer size to avoid this.
+ *
+ * @tparam BLOCK Number of samples in each block
+ * @tparam Modules Modules to fuse, in processing order
+ */
+template <std::size_t BLOCK, typename... Modules>
+class StaticBlockChain : public SourceModule {
+
+    static_assert(BLOCK > 0, "StaticBlockChain requires a block size");
+    static_assert(sizeof...(Modules) > 0, "StaticBlockChain requires at least one module");
+
+   private:
+
+    /// Modules in this chain
+    std::tuple<Modules...> modules;
+
+    /// Final block, when the output is not a multiple of BLOCK
+    StaticBuffer<sample_t, BLOCK> tail;
+
+    /// Number of samples at the end of the tail that have not been handed out
+    std::size_t pending = 0;
+
+    /**
+     * @brief Processes a block with a module
+     *
+     * @tparam M Module type
+     * @param mod Module to process with
+     * @param data Block to process in place
+     */
+    template <typename M>
+    static void block_one(M& mod, std::span<sample_t, BLOCK> data) {
+
+        if constexpr (requires { mod.fused_block(data); }) {
+
+            mod.fused_block(data);
+        }
+
+        else {
+
+            for (std::size_t i = 0; i < BLOCK; ++i) {
+
+                data[i] = mod.fused_tick(data[i]);
+            }
+        }
+    }
+
+   public:
+
+    StaticBlockChain() = default;
+
+    /**
+     * @brief Gets a module in this chain
+     *
+     * @tparam I Index of the module
+     * @return auto& Reference to the module
+     */
+    template <std::size_t I>
+    auto& get() { return std::get<I>(this->modules); }
+
+    /**
+     * @brief Gets the number of modules in this chain
+     *
+     * @return constexpr std::size_t Number of modules
+     */
+    static constexpr std::size_t size() { return sizeof...(Modules); }
+
+    /**
+     * @brief Gets the number of samples in each block
+     *
+     * @return constexpr std::size_t Block size
+     */
+    static constexpr std::size_t block_size() { return BLOCK; }
+
+    /**
+     * @brief Fills a single block with the output of this chain
+     *
+     * Any samples pending from a previous call to fill() are discarded.
+     *
+     * @param out Block to fill
+     * @param sample_rate Sample rate of the data
+     */
+    void fill_block(std::span<sample_t, BLOCK> out, double sample_rate) {
+
+        this->pending = 0;
+
+        this->generate(out, sample_rate);
+    }
+
+    /**
+     * @brief Fills a block of memory with the output of this chain
+     *
+     * This can be used without binding this chain to anything.
+     *
+     * @param out Pointer to output data
+     * @param num Number of samples to generate
+     * @param sample_rate Sample rate of the data
+     */
+    void fill(sample_t* out, int num, double sample_rate) {
+
+        auto remaining = static_cast<std::size_t>(num);
+
+        // Hand out anything left from the last call:
+
+        const std::size_t first = std::min(this->pending, remaining);
+
+        std::copy_n(this->tail.data() + (BLOCK - this->pending), first, out);
+
+        this->pending -= first;
+        remaining -= first;
+        out += first;
+
+        // Generate whole blocks in place:
+
+        for (; remaining >= BLOCK; remaining -= BLOCK, out += BLOCK) {
+
+            this->generate(std::span<sample_t, BLOCK>(out, BLOCK), sample_rate);
+        }
+
+        // Generate the final block into the tail, keeping what we don't use:
+
+        if (remaining > 0) {
+
+            this->generate(std::span<sample_t, BLOCK>(this->tail.data(), BLOCK), sample_rate);
+
+            std::copy_n(this->tail.data(), remaining, out);
+
+            this->pending = BLOCK - remaining;
+        }
+    }
+
+    /**
+     * @brief Processes this chain
+     *
+     * We create a new buffer and fill it with our output.
+     */
+    void process() override {
+
+        this->set_buffer(this->create_buffer());
+
+        this->fill(this->buff->data(), static_cast<int>(this->buff->size()), this->buff->get_samplerate());
+    }
+
+   private:
+
+    /**
+     * @brief Runs a block through every module
+     *
+     * @param data Block to fill
+     * @param sample_rate Sample rate of the data
+     */
+    void generate(std::span<sample_t, BLOCK> data, double sample_rate) {
+
+        // The first module is given a zero input:
+
+        std::ranges::fill(data, sample_t(0));
+
+        std::apply([sample_rate](auto&... mod) { (fused_prepare_one(mod, sample_rate), ...); }, this->modules);
+
+        std::apply([data](auto&... mod) { (block_one(mod, data), ...); }, this->modules);
+
+        std::apply([](auto&... mod) { (fused_commit_one(mod, static_cast<int>(BLOCK)), ...); }, this->modules);
+    }
+};
@@ -0,0 +1,202 @@
+/**
+ * @file stft_module.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief A module that processes audio in the frequency domain
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Many effects are easiest to describe in the frequency domain,
+ * such as vocoders, denoising and spectral gating.
+ * The STFTModule streams audio through analysis and resynthesis (see dsp/stft.hpp),
+ * and allows the spectrum of each frame to be altered in between.
+ */
+
+#pragma once
+
+#include <complex>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include "audio_module.hpp"
+#include "dsp/stft.hpp"
+
+/**
+ * @brief Alters the spectra of audio data
+ *
+ * Each channel is cut into frames of (size) samples, every (hop) samples.
+ * The spectrum of each frame is handed to process_spectrum(),
+ * which may alter the bins in place before the frame is resynthesized.
+ * By default, process_spectrum() invokes the callback set via set_callback(),
+ * subclasses may instead override it directly.
+ *
+ * All work memory is allocated when we are started,
+ * so processing is real-time safe as long as the callback is.
+ * We process our buffer in place.
+ *
+ * We add a fixed latency of (size) samples,
+ * which is reported through our ModuleInfo.
+ */
+class STFTModule : public AudioModule {
+
+    public:
+
+        /// Callback that alters the spectrum of a frame of a channel
+        using SpectrumCallback = std::function<void(std::span<std::complex<sample_t>>, int)>;
+
+        STFTModule() { this->get_info()->latency = this->latency(); }
+
+        /**
+         * @brief Construct a new STFTModule object
+         *
+         * @param size Size of each frame
+         * @param hop Number of samples between frames
+         */
+        STFTModule(int size, int hop) {
+
+            this->set_size(size);
+            this->set_hop(hop);
+        }
+
+        /**
+         * @brief Processes the current buffer
+         *
+         * Each channel is streamed through its own STFT.
+         */
+        void process() override;
+
+        /**
+         * @brief Starts this module
+         *
+         * We prepare an STFT for each channel,
+         * and clear any samples left over from previous runs.
+         */
+        void start() override;
+
+        /**
+         * @brief Adds the memory held by this module
+         *
+         * We count the transforms and frames of each channel.
+         *
+         * @param usage Footprint to add to
+         */
+        void footprint(MemoryFootprint& usage) const override;
+
+        /**
+         * @brief Syncs our info with the module in front of us
+         *
+         */
+        void info_sync() override;
+
+        /// We alter the buffer we are given
+        bool in_place() const override { return true; }
+
+        /**
+         * @brief Alters the spectrum of a frame
+         *
+         * Bins start at DC and end at the Nyquist frequency.
+         * By default we invoke the callback, if one is set.
+         *
+         * @param spectrum Bins of the frame
+         * @param channel Channel the frame belongs to
+         */
+        virtual void process_spectrum(std::span<std::complex<sample_t>> spectrum, int channel);
+
+        /**
+         * @brief Sets the callback to alter spectra
+         *
+         * @param func New callback
+         */
+        void set_callback(SpectrumCallback func) { this->callback = std::move(func); }
+
+        /**
+         * @brief Sets the size of each frame
+         *
+         * This must be set before we are started.
+         *
+         * @param num Size of each frame, rounded up to an even number
+         */
+        void set_size(int num);
+
+        /**
+         * @brief Gets the size of each frame
+         *
+         * @return int Size of each frame
+         */
+        int get_size() const { return this->size; }
+
+        /**
+         * @brief Sets the number of samples between frames
+         *
+         * This must be set before we are started.
+         *
+         * @param num Hop size, clamped to the frame size
+         */
+        void set_hop(int num);
+
+        /**
+         * @brief Gets the number of samples between frames
+         *
+         * @return int Hop size
+         */
+        int get_hop() const { return this->hop; }
+
+        /**
+         * @brief Sets the window applied to each frame
+         *
+         * This must be set before we are started.
+         *
+         * @param type Type of window
+         */
+        void set_window(WindowType type) { this->window = type; }
+
+        /**
+         * @brief Gets the window applied to each frame
+         *
+         * @return WindowType Type of window
+         */
+        WindowType get_window() const { return this->window; }
+
+        /**
+         * @brief Gets the number of bins in each spectrum
+         *
+         * @return int Number of bins
+         */
+        int bins() const { return this->size / 2 + 1; }
+
+        /**
+         * @brief Gets the latency we add
+         *
+         * @return int Latency in samples
+         */
+        int latency() const { return this->size; }
+
+    private:
+
+        /**
+         * @brief Prepares an STFT for each channel
+         *
+         * @param channels Number of channels
+         */
+        void prepare(int channels);
+
+        /// Size of each frame
+        int size = 1024;
+
+        /// Number of samples between frames
+        int hop = 256;
+
+        /// Window applied to each frame
+        WindowType window = WindowType::Hann;
+
+        /// Callback to alter spectra
+        SpectrumCallback callback;
+
+        /// STFT for each channel
+        std::vector<STFT> engines;
+
+        /// Scratch space for splitting and joining channels
+        std::vector<sample_t> scratch;
+};
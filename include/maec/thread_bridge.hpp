@@ -0,0 +1,169 @@
+/**
+ * @file thread_bridge.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief A module that runs part of a chain on another thread
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Heavy effects can take up most of the time we have to render a block.
+ * If the rest of the chain can run at the same time,
+ * we can move the heavy part onto another core.
+ *
+ * The ThreadBridge module does just that.
+ * Everything behind the bridge is processed on a worker thread,
+ * while the chain in front of the bridge (and any other branches) continue on as usual.
+ * Blocks are passed between the threads using lock-free rings.
+ * The price of this is a fixed latency of one block,
+ * as the block we output was rendered while the previous block was being consumed.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "audio_module.hpp"
+#include "dsp/ring.hpp"
+
+/**
+ * @brief Processes the modules behind us on a worker thread
+ *
+ * When started, we create a worker thread that owns the sub-chain behind us.
+ * Each time we are processed we collect the block the worker rendered last time,
+ * and ask the worker to render the next one.
+ * The first block we output is silence, after that we are always one block behind.
+ *
+ * The sub-chain gets its own ChainInfo, with its own buffer pool and clock,
+ * as these are not safe to share between threads.
+ * Buffers are traded between the two pools, one for one,
+ * so neither thread allocates in the steady state.
+ * Events scheduled on the main chain do not reach the sub-chain.
+ * The worker renders one block ahead, so it can't follow a variable frame count
+ * (see ChainInfo::frames), and always renders full blocks.
+ *
+ * If we are processed without being started,
+ * the sub-chain is simply processed on the calling thread with no latency.
+ *
+ * Compiled chains can't flatten the sub-chain,
+ * so we report no inputs and are meta processed as a whole.
+ */
+class ThreadBridge : public AudioModule {
+
+    public:
+
+        ThreadBridge() =default;
+
+        /// Destructor, stops the worker thread
+        ~ThreadBridge() override;
+
+        /// Bridges can't be copied
+        ThreadBridge(const ThreadBridge&) = delete;
+
+        /// Bridges can't be copied
+        ThreadBridge& operator=(const ThreadBridge&) = delete;
+
+        /**
+         * @brief Collects a block from the worker, and requests the next one
+         *
+         * We do NOT meta process the backward modules on this thread,
+         * that is the job of the worker.
+         * If the worker is still busy with the last block, we wait for it.
+         */
+        void meta_process() override;
+
+        /**
+         * @brief Syncs the sub-chain behind us
+         *
+         * We configure our private ChainInfo using our info,
+         * and point every module behind us at it.
+         */
+        void meta_info_sync() override;
+
+        /**
+         * @brief Stops the worker, and then the modules behind us
+         *
+         * The worker must be stopped first,
+         * as it may be processing the modules behind us.
+         */
+        void meta_stop() override;
+
+        /**
+         * @brief Starts the worker thread
+         */
+        void start() override;
+
+        /**
+         * @brief Stops the worker thread
+         *
+         * Any block still in flight is dropped.
+         */
+        void stop() override;
+
+        /**
+         * @brief Reports the modules that must be processed before us
+         *
+         * The sub-chain is processed by the worker,
+         * so we report nothing and ask to be meta processed.
+         *
+         * @param inputs Vector to add modules to
+         * @return false Always
+         */
+        bool plan_inputs(std::vector<AudioModule*>& inputs) override;
+
+        /**
+         * @brief Determines if the worker thread is running
+         *
+         * @return true If blocks are rendered on the worker
+         * @return false If blocks are rendered on the calling thread
+         */
+        bool threaded() const { return this->running.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Gets the latency we add, in samples
+         *
+         * @return int One block when threaded, otherwise zero
+         */
+        int latency() { return this->threaded() ? this->get_info()->out_buffer : 0; }
+
+        /**
+         * @brief Gets the ChainInfo used by the sub-chain
+         *
+         * @return ChainInfo* ChainInfo of the modules behind us
+         */
+        ChainInfo* get_bridge_chain() { return &(this->bridge_chain); }
+
+    private:
+
+        /**
+         * @brief Main loop of the worker thread
+         */
+        void run();
+
+        /// ChainInfo used by the modules behind us
+        ChainInfo bridge_chain;
+
+        /// Blocks rendered by the worker
+        SPSCRing<BufferPointer> ready{4};
+
+        /// Buffers handed back to the worker pool
+        SPSCRing<BufferPointer> spent{4};
+
+        /// Worker thread
+        std::thread worker;
+
+        /// Determines if the worker is running
+        std::atomic<bool> running{false};
+
+        /// Number of blocks requested from the worker
+        std::atomic<uint64_t> requested{0};
+
+        /// Number of blocks the worker has rendered
+        std::atomic<uint64_t> completed{0};
+
+        /// Number of blocks we have collected
+        uint64_t received = 0;
+};
@@ -0,0 +1,297 @@
+/**
+ * @file trace.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Components for tracing the rendering of chains
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Instrumentation (see instrument.hpp) tells us how long each module takes,
+ * but not when it ran, or what the other threads were doing at the time.
+ * A trace records the beginning and end of each piece of work on every thread,
+ * so we can see how rendering interleaves with device writes and disk reads.
+ *
+ * Each thread records into its own ring of events,
+ * so recording never locks and never allocates.
+ * When a ring is full the oldest events are overwritten.
+ * write_chrome_trace() exports every ring as Chrome trace JSON,
+ * which can be loaded into Perfetto or chrome://tracing.
+ *
+ * Tracing is enabled by building with MAEC_TRACE.
+ * Otherwise the MAEC_TRACE_* macros expand to nothing,
+ * and the hot paths contain no trace code at all.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A single trace event
+ *
+ * Names and categories are never copied,
+ * so they must be string literals or other strings that live forever
+ * (such as those returned by typeid().name()).
+ */
+struct TraceEvent {
+
+    /// Kinds of events
+    enum class Phase : uint8_t {
+        Begin,
+        End
+    };
+
+    /// Name of the work
+    const char* name = nullptr;
+
+    /// Category of the work
+    const char* category = nullptr;
+
+    /// Time of the event in nanoseconds, see get_time()
+    int64_t time = 0;
+
+    /// Kind of event
+    Phase phase = Phase::Begin;
+};
+
+/**
+ * @brief Ring of events recorded by a single thread
+ *
+ * Only one thread may push, but any thread may take a snapshot at any time.
+ * Slots are relaxed atomics, so a snapshot taken while the ring wraps
+ * may see partly overwritten slots, which is detected and dropped.
+ */
+class TraceRing {
+
+    public:
+
+        /**
+         * @brief Construct a new TraceRing object
+         *
+         * @param capacity Number of events to hold, rounded up to a power of two
+         * @param tid Identifier of the thread recording into this ring
+         */
+        TraceRing(std::size_t capacity, int tid);
+
+        /**
+         * @brief Records an event
+         *
+         * @param name Name of the work
+         * @param category Category of the work
+         * @param time Time of the event
+         * @param phase Kind of event
+         */
+        void push(const char* name, const char* category, int64_t time, TraceEvent::Phase phase) {
+
+            const uint64_t index = this->head.load(std::memory_order_relaxed);
+
+            Slot& slot = this->slots[index & this->mask];
+
+            slot.name.store(name, std::memory_order_relaxed);
+            slot.category.store(category, std::memory_order_relaxed);
+            slot.time.store(time, std::memory_order_relaxed);
+            slot.phase.store(phase, std::memory_order_relaxed);
+
+            this->head.store(index + 1, std::memory_order_release);
+        }
+
+        /**
+         * @brief Gets the events currently held, oldest first
+         *
+         * @return std::vector<TraceEvent> Events held
+         */
+        std::vector<TraceEvent> snapshot() const;
+
+        /**
+         * @brief Forgets all events recorded so far
+         *
+         */
+        void clear() { this->start.store(this->head.load(std::memory_order_acquire), std::memory_order_release); }
+
+        /**
+         * @brief Gets the number of events held
+         *
+         * @return std::size_t Number of events
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Gets the number of events we can hold
+         *
+         * @return std::size_t Capacity of this ring
+         */
+        std::size_t capacity() const { return this->slots.size(); }
+
+        /**
+         * @brief Gets the identifier of our thread
+         *
+         * @return int Thread identifier
+         */
+        int get_tid() const { return this->tid; }
+
+        /**
+         * @brief Sets the name of our thread
+         *
+         * This is not lock free, and should be called once when a thread starts.
+         *
+         * @param name Name of the thread
+         */
+        void set_name(std::string name);
+
+        /**
+         * @brief Gets the name of our thread
+         *
+         * @return std::string Name of the thread, empty if it has none
+         */
+        std::string get_name() const;
+
+    private:
+
+        /// A slot holding one event
+        struct Slot {
+            std::atomic<const char*> name{nullptr};
+            std::atomic<const char*> category{nullptr};
+            std::atomic<int64_t> time{0};
+            std::atomic<TraceEvent::Phase> phase{TraceEvent::Phase::Begin};
+        };
+
+        /// Slots of the ring
+        std::vector<Slot> slots;
+
+        /// Mask applied to indices
+        uint64_t mask = 0;
+
+        /// Number of events pushed
+        std::atomic<uint64_t> head{0};
+
+        /// Index of the first event that has not been cleared
+        std::atomic<uint64_t> start{0};
+
+        /// Identifier of our thread
+        int tid = 0;
+
+        /// Name of our thread, guarded by the recorder
+        std::string thread_name;
+};
+
+/**
+ * @brief Gets the ring of the calling thread
+ *
+ * The ring is created and registered the first time a thread asks for it,
+ * which takes a lock.
+ * Rings outlive their threads, so events from finished threads can still be exported.
+ *
+ * @return TraceRing& Ring of the calling thread
+ */
+TraceRing& thread_trace_ring();
+
+/**
+ * @brief Sets the capacity of rings created from now on
+ *
+ * Rings that already exist keep their capacity.
+ *
+ * @param capacity Number of events each ring holds
+ */
+void set_trace_capacity(std::size_t capacity);
+
+/**
+ * @brief Sets if events are recorded
+ *
+ * Recording is on by default.
+ *
+ * @param enable true to record events, false to ignore them
+ */
+void set_tracing(bool enable);
+
+/**
+ * @brief Determines if events are recorded
+ *
+ * @return true If events are recorded
+ * @return false If not
+ */
+bool tracing();
+
+/**
+ * @brief Forgets all events recorded on every thread
+ *
+ */
+void clear_trace();
+
+/**
+ * @brief Writes every event recorded as Chrome trace JSON
+ *
+ * Times are converted to microseconds relative to the earliest event.
+ * Events whose partner was overwritten are dropped,
+ * so each thread has balanced begin and end events.
+ *
+ * @param out Stream to write to
+ */
+void write_chrome_trace(std::ostream& out);
+
+/**
+ * @brief Gets every event recorded as Chrome trace JSON
+ *
+ * @return std::string Trace JSON
+ */
+std::string chrome_trace();
+
+/**
+ * @brief Records a begin event now, and an end event when destroyed
+ *
+ */
+class TraceScope {
+
+    public:
+
+        /**
+         * @brief Construct a new TraceScope object
+         *
+         * @param category Category of the work
+         * @param name Name of the work
+         */
+        TraceScope(const char* category, const char* name);
+
+        /// Destructor
+        ~TraceScope();
+
+        TraceScope(const TraceScope&) = delete;
+        TraceScope(TraceScope&&) = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+        TraceScope& operator=(TraceScope&&) = delete;
+
+    private:
+
+        /// Ring we recorded into, nullptr if we recorded nothing
+        TraceRing* ring = nullptr;
+
+        /// Name of the work
+        const char* name;
+
+        /// Category of the work
+        const char* category;
+};
+
+#define MAEC_TRACE_CONCAT_INNER(a, b) a##b
+#define MAEC_TRACE_CONCAT(a, b) MAEC_TRACE_CONCAT_INNER(a, b)
+
+#ifdef MAEC_TRACE
+
+/// Traces the rest of the enclosing scope
+#define MAEC_TRACE_SCOPE(category, name) const TraceScope MAEC_TRACE_CONCAT(maec_trace_, __LINE__)(category, name)
+
+/// Names the calling thread in the trace
+#define MAEC_TRACE_THREAD(name) thread_trace_ring().set_name(name)
+
+#else
+
+#define MAEC_TRACE_SCOPE(category, name) static_cast<void>(0)
+#define MAEC_TRACE_THREAD(name) static_cast<void>(0)
+
+#endif
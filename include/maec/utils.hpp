@@ -16,8 +16,11 @@
 #pragma once
 
 #include <memory>
+#include <utility>
 #include <vector>
 
+#include "module_arena.hpp"
+
 /**
  * @brief Keeps a collection of objects
  * 
@@ -33,6 +36,8 @@
  * Objects can be submitted via smart pointer,
  * or via raw pointer,
  * which we will then convert into a SmartPointer and take ownership over.
+ * Objects can also be created in place with create_object(),
+ * which places them in the current ModuleArena if there is one.
  * 
  * @tparam T The type of objects to keep
  */
@@ -42,7 +47,7 @@ class Collection {
     private:
 
         /// A collection of objects to maintain
-        std::vector<std::unique_ptr<T>> objs;
+        std::vector<ModulePointer<T>> objs;
 
     public:
 
@@ -57,7 +62,38 @@ class Collection {
          * 
          * @param ptr Pointer to save
          */
-        void add_object(std::unique_ptr<T>& ptr) { this->objs.push_back(std::move(ptr)); }
+        void add_object(std::unique_ptr<T>& ptr) { this->objs.push_back(ModulePointer<T>(ptr.release())); }
+
+        /**
+         * @brief Adds the given object via module pointer
+         * 
+         * The passed pointer SHOULD NOT be used after this operation!
+         * 
+         * @param ptr Pointer to save
+         */
+        void add_object(ModulePointer<T>& ptr) { this->objs.push_back(std::move(ptr)); }
+
+        /**
+         * @brief Creates an object and adds it to this collection
+         * 
+         * The object is placed in the current ModuleArena if there is one
+         * (see make_module()).
+         * 
+         * @tparam U Type of object to create
+         * @tparam Args Types of constructor arguments
+         * @param args Constructor arguments
+         * @return U* Raw pointer to the new object
+         */
+        template <typename U = T, typename... Args>
+        U* create_object(Args&&... args) {
+
+            ModulePointer<U> ptr = make_module<U>(std::forward<Args>(args)...);
+            U* obj = ptr.get();
+
+            this->objs.push_back(std::move(ptr));
+
+            return obj;
+        }
 
         /**
          * @brief Gets the object at the given position
@@ -96,6 +132,8 @@ class Collection {
          * We release an object by getting the raw pointer from the 
          * unique pointer in our collection.
          * We then return the raw pointer to the caller that they can use as they see fit.
+         * Objects that live in a ModuleArena must not be deleted,
+         * as their memory belongs to the arena.
          * 
          * @param index Index of object to release
          * @return T* Pointer to released object
@@ -0,0 +1,304 @@
+/**
+ * @file voice.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Components for polyphonic voices
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Polyphonic instruments play many notes at once,
+ * each of which is generated by a 'voice'.
+ * A voice is simply a chain of modules, usually an oscillator
+ * followed by some amplitude modules and an envelope.
+ *
+ * This file contains a module that manages a pool of voices,
+ * assigns notes to them, and mixes the active voices together.
+ * Voices that are not playing are not processed,
+ * so the cost of an instrument scales with the number of notes being played,
+ * and not with the number of voices it owns.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "source_module.hpp"
+
+/**
+ * @brief A single voice managed by a VoiceManager
+ *
+ * The voice is made up of a chain of modules that end in the output module.
+ * The envelope module determines when the voice is finished,
+ * once its state is Finished (see BaseModule::done()) the voice is no longer processed.
+ * Often, the envelope will be the output module.
+ */
+struct Voice {
+
+    /// Last module in the voice chain
+    AudioModule* output = nullptr;
+
+    /// Module that determines when this voice is finished
+    BaseModule* envelope = nullptr;
+
+    /// Note this voice is playing, -1 if none
+    int note = -1;
+
+    /// Order this voice was triggered in, higher values are newer
+    uint64_t age = 0;
+
+    /// Peak level of the last block this voice generated
+    sample_t level = 0;
+
+    /// Determines if the note is still held
+    bool held = false;
+
+    /// Determines if this voice is being processed
+    bool active = false;
+};
+
+/**
+ * @brief Manages and mixes a pool of voices
+ *
+ * Voices are added ahead of time with add_voice(),
+ * so no modules need to be created when a note is played.
+ * When a note is played, we pick a voice that is not active.
+ * If all voices are active, then a voice is stolen, either
+ * the oldest voice or the quietest voice (see StealMode).
+ *
+ * Voices are configured for a note through the trigger function,
+ * which could set the frequency of an oscillator, for example.
+ * Once configured, the voice chain is started.
+ * When a note is released, the release function is called,
+ * which by default asks the envelope to finish.
+ *
+ * Each block, we process the active voices and sum their output.
+ * Voices whose envelope has finished are marked as inactive,
+ * and are skipped until they are used again.
+ *
+ * Voice chains share a ChainInfo owned by this manager,
+ * so voices finishing does not affect the chain we are a part of.
+ */
+class VoiceManager : public SourceModule {
+
+    public:
+
+        /**
+         * @brief Methods for picking a voice to steal
+         */
+        enum class StealMode {
+            Oldest,   /// Steal the voice that was triggered first
+            Quietest  /// Steal the voice with the lowest level
+        };
+
+        /// Function used to configure a voice for a note
+        using TriggerFunction = std::function<void(Voice&, int, double)>;
+
+        /// Function used to release a voice
+        using ReleaseFunction = std::function<void(Voice&)>;
+
+    private:
+
+        /// Voices we manage
+        std::vector<Voice> voices;
+
+        /// ChainInfo shared by all voice chains
+        ChainInfo voice_chain;
+
+        /// Method for stealing voices
+        StealMode steal = StealMode::Oldest;
+
+        /// Function to configure voices
+        TriggerFunction trigger;
+
+        /// Function to release voices
+        ReleaseFunction release;
+
+        /// Number of voices triggered so far
+        uint64_t triggered = 0;
+
+        /// Number of voices stolen so far
+        int stolen = 0;
+
+        /// Largest number of voices to process at once, 0 for no limit
+        int limit = 0;
+
+        /**
+         * @brief Determines the active voice to give up first
+         *
+         * Voices that have been released are given up before held voices,
+         * otherwise we pick using the steal mode.
+         *
+         * @return Voice* Voice to give up, nullptr if none are active
+         */
+        Voice* pick_victim();
+
+        /**
+         * @brief Determines the voice to use for a new note
+         *
+         * @return Voice* Voice to use, nullptr if we have none
+         */
+        Voice* pick_voice();
+
+        /**
+         * @brief Shares our voice ChainInfo with a voice chain
+         *
+         * Each module in the voice chain that is not a part of a chain
+         * is given our voice ChainInfo.
+         *
+         * @param voice Voice to configure
+         */
+        void share_chain(Voice& voice);
+
+    public:
+
+        VoiceManager() =default;
+
+        /**
+         * @brief Adds a voice to this manager
+         *
+         * The voice chain should be fully built before it is added.
+         *
+         * @param output Last module in the voice chain
+         * @param envelope Module that determines when the voice is finished, output if nullptr
+         * @return int Index of the new voice
+         */
+        int add_voice(AudioModule* output, BaseModule* envelope = nullptr);
+
+        /**
+         * @brief Gets a voice
+         *
+         * @param index Index of the voice
+         * @return Voice& Voice at the index
+         */
+        Voice& get_voice(int index) { return this->voices.at(index); }
+
+        /**
+         * @brief Gets the number of voices we manage
+         *
+         * @return int Number of voices
+         */
+        int num_voices() const { return static_cast<int>(this->voices.size()); }
+
+        /**
+         * @brief Gets the number of voices that are being processed
+         *
+         * @return int Number of active voices
+         */
+        int active_voices() const;
+
+        /**
+         * @brief Gets the number of voices stolen so far
+         *
+         * @return int Number of stolen voices
+         */
+        int stolen_voices() const { return this->stolen; }
+
+        /**
+         * @brief Sets the largest number of voices to process at once
+         *
+         * Once this many voices are active, new notes steal a voice
+         * instead of using a free one.
+         * Lowering the limit does not stop voices that are already playing,
+         * see shed_voices() for that.
+         *
+         * @param num Voice limit, 0 for no limit
+         */
+        void set_voice_limit(int num) { this->limit = std::max(0, num); }
+
+        /**
+         * @brief Gets the largest number of voices to process at once
+         *
+         * @return int Voice limit, 0 for no limit
+         */
+        int get_voice_limit() const { return this->limit; }
+
+        /**
+         * @brief Immediately stops a number of active voices
+         *
+         * This is intended for degrading gracefully when the chain is overloaded
+         * (see PeriodSink::set_overload()).
+         * Released voices are stopped first, then voices are picked by the steal mode.
+         * Stopped voices are counted as stolen.
+         *
+         * @param num Number of voices to stop
+         * @return int Number of voices stopped
+         */
+        int shed_voices(int num);
+
+        /**
+         * @brief Sets the method for stealing voices
+         *
+         * @param mode Steal mode to use
+         */
+        void set_steal_mode(StealMode mode) { this->steal = mode; }
+
+        /**
+         * @brief Gets the method for stealing voices
+         *
+         * @return StealMode Current steal mode
+         */
+        StealMode get_steal_mode() const { return this->steal; }
+
+        /**
+         * @brief Sets the function used to configure voices
+         *
+         * This function is given the voice, the note and the velocity,
+         * and is called before the voice chain is started.
+         *
+         * @param func Function to use
+         */
+        void set_trigger(TriggerFunction func) { this->trigger = std::move(func); }
+
+        /**
+         * @brief Sets the function used to release voices
+         *
+         * By default, we call finish() on the voice envelope.
+         *
+         * @param func Function to use
+         */
+        void set_release(ReleaseFunction func) { this->release = std::move(func); }
+
+        /**
+         * @brief Plays a note
+         *
+         * We pick a voice, configure it and start it.
+         *
+         * @param note Note to play
+         * @param velocity Velocity of the note
+         * @return Voice* Voice playing the note, nullptr if we have no voices
+         */
+        Voice* note_on(int note, double velocity = 1);
+
+        /**
+         * @brief Releases a note
+         *
+         * Each voice holding the note is released.
+         *
+         * @param note Note to release
+         */
+        void note_off(int note);
+
+        /**
+         * @brief Mixes the active voices
+         *
+         * We process each active voice and sum the output.
+         * Voices that have finished are marked as inactive.
+         */
+        void process() override;
+
+        /**
+         * @brief Preforms an info sync on this module and all voices
+         *
+         * Voice chains are configured using our info.
+         */
+        void meta_info_sync() override;
+
+        /**
+         * @brief Stops this module and all active voices
+         */
+        void meta_stop() override;
+};
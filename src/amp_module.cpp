@@ -9,30 +9,140 @@
  * 
  */
 
-#include <algorithm>
+#include <cstddef>
 
 #include "amp_module.hpp"
 
+void BaseAmplitude::on_event(const Event& event) {
+
+    if (event.type == EventType::Parameter) {
+
+        this->set_value(event.value);
+    }
+}
+
+bool BaseAmplitude::fold(int offset, int num, sample_t value) {
+
+    if (!this->buff->is_constant()) {
+
+        return false;
+    }
+
+    // Only whole blocks can be folded, events split the block into different values:
+
+    const int frames = static_cast<int>(this->buff->size()) / this->buff->channels();
+
+    if (offset != 0 || num != frames) {
+
+        this->buff->clear_constant();
+
+        return false;
+    }
+
+    // Skip the fill entirely if the value does not change, such as scaling silence:
+
+    if (value != this->buff->get_constant()) {
+
+        this->buff->fill_constant(value);
+    }
+
+    return true;
+}
+
 void AmplitudeScale::process() {
 
-    // Scale the audio by the given value:
+    // Scale the audio, splitting at each event:
+
+    this->render_events(static_cast<int>(this->buff->size()) / this->buff->channels());
+}
+
+void AmplitudeScale::render(int offset, int num) {
+
+    // Determine the range to scale:
+
+    const int channels = this->buff->channels();
+
+    const auto value = static_cast<sample_t>(this->get_value());
+
+    // Fold constant buffers into a new constant:
+
+    if (this->fold(offset, num, this->buff->get_constant() * value)) {
+
+        return;
+    }
 
-    std::transform(this->buff->ibegin(), this->buff->iend(), this->buff->ibegin(), [this](long double inv) {
+    if constexpr (AudioBuffer::layout::planar) {
 
-        // Scale the value:
+        // Work over each channel:
 
-        return this->get_value() * inv;
-    });
+        for (int c = 0; c < channels; ++c) {
+
+            sample_t* data = this->buff->data() + AudioBuffer::layout::offset(c, offset, channels, this->buff->channel_capacity());
+
+            for (int i = 0; i < num; ++i) {
+
+                data[i] *= value;
+            }
+        }
+
+        return;
+    }
+
+    sample_t* data = this->buff->data() + static_cast<std::ptrdiff_t>(offset) * channels;
+
+    const int size = num * channels;
+
+    for (int i = 0; i < size; ++i) {
+
+        data[i] *= value;
+    }
 }
 
 void AmplitudeAdd::process() {
 
-    // Add the given value to the audio:
+    // Add to the audio, splitting at each event:
+
+    this->render_events(static_cast<int>(this->buff->size()) / this->buff->channels());
+}
+
+void AmplitudeAdd::render(int offset, int num) {
+
+    // Determine the range to add to:
+
+    const int channels = this->buff->channels();
+
+    const auto value = static_cast<sample_t>(this->get_value());
+
+    // Fold constant buffers into a new constant:
+
+    if (this->fold(offset, num, this->buff->get_constant() + value)) {
+
+        return;
+    }
+
+    if constexpr (AudioBuffer::layout::planar) {
+
+        // Work over each channel:
+
+        for (int c = 0; c < channels; ++c) {
+
+            sample_t* data = this->buff->data() + AudioBuffer::layout::offset(c, offset, channels, this->buff->channel_capacity());
+
+            for (int i = 0; i < num; ++i) {
+
+                data[i] += value;
+            }
+        }
+
+        return;
+    }
+
+    sample_t* data = this->buff->data() + static_cast<std::ptrdiff_t>(offset) * channels;
 
-    std::transform(this->buff->ibegin(), this->buff->iend(), this->buff->ibegin(), [this](long double inv) {
+    const int size = num * channels;
 
-        // Add to the value:
+    for (int i = 0; i < size; ++i) {
 
-        return this->get_value() + inv;
-    });
+        data[i] += value;
+    }
 }
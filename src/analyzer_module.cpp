@@ -0,0 +1,268 @@
+/**
+ * @file analyzer_module.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations for analyzer modules
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "analyzer_module.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+void SpectrumAnalyzer::process() {
+
+    const int channels = this->buff->channels();
+    const auto num = static_cast<int>(this->buff->size()) / channels;
+
+    // Ensure we are set up for these channels:
+
+    if (channels != this->snapshots.write_buffer().channels) {
+
+        this->prepare(channels);
+    }
+
+    auto& snap = this->snapshots.write_buffer();
+
+    const std::ptrdiff_t stride = AudioBuffer::layout::planar ? 1 : channels;
+
+    for (int c = 0; c < channels; ++c) {
+
+        const sample_t* data = this->buff->data() + AudioBuffer::layout::offset(c, 0, channels, this->buff->channel_capacity());
+
+        sample_t* frame = this->frames.data() + static_cast<std::ptrdiff_t>(c) * this->size;
+
+        float peak = snap.peak[c];
+        double power = 0;
+
+        for (int i = 0; i < num; ++i) {
+
+            const sample_t val = data[i * stride];
+
+            // Update the levels:
+
+            peak = std::max(peak, static_cast<float>(std::fabs(val)));
+            power += static_cast<double>(val) * val;
+
+            // Add to the frame, and analyze it if full:
+
+            frame[this->fill[c]++] = val;
+
+            if (this->fill[c] == this->size) {
+
+                this->analyze(c);
+
+                std::copy(frame + this->hop, frame + this->size, frame);
+
+                this->fill[c] = this->size - this->hop;
+            }
+        }
+
+        snap.peak[c] = peak;
+        this->power[c] += power;
+    }
+
+    this->measured += num;
+
+    // Publish if we have a new spectrum:
+
+    if (this->averaged > 0) {
+
+        this->publish();
+    }
+}
+
+void SpectrumAnalyzer::footprint(MemoryFootprint& usage) const {
+
+    AudioModule::footprint(usage);
+
+    usage.plans += this->analysis.plan_bytes();
+    usage.state += this->analysis.bytes() + heap_bytes(this->frames) + heap_bytes(this->fill) + heap_bytes(this->spectrum) + heap_bytes(this->power);
+}
+
+void SpectrumAnalyzer::start() {
+
+    AudioModule::start();
+
+    this->sequence = 0;
+
+    this->prepare(this->get_info()->channels);
+}
+
+void SpectrumAnalyzer::prepare(int channels) {
+
+    this->analysis.prepare(this->size, this->hop, this->window);
+
+    // Scale so a full scale sine has a magnitude of 1:
+
+    const auto win = this->analysis.get_window();
+
+    this->scale = static_cast<sample_t>(2.0 / std::accumulate(win.begin(), win.end(), 0.0));
+
+    // Allocate the frames:
+
+    this->frames.assign(static_cast<std::size_t>(channels) * this->size, 0);
+    this->fill.assign(channels, 0);
+    this->spectrum.assign(this->bins(), 0);
+    this->power.assign(channels, 0);
+
+    this->averaged = 0;
+    this->measured = 0;
+
+    // Allocate the snapshots:
+
+    SpectrumSnapshot snap;
+
+    snap.channels = channels;
+    snap.bins = this->bins();
+    snap.magnitude.assign(static_cast<std::size_t>(channels) * this->bins(), 0);
+    snap.peak.assign(channels, 0);
+    snap.rms.assign(channels, 0);
+
+    this->snapshots.reset(snap);
+}
+
+void SpectrumAnalyzer::analyze(int channel) {
+
+    this->analysis.analyze(this->frames.data() + static_cast<std::ptrdiff_t>(channel) * this->size, this->spectrum.data());
+
+    // Add the magnitudes to the average:
+
+    float* mag = this->snapshots.write_buffer().magnitude.data() + static_cast<std::ptrdiff_t>(channel) * this->bins();
+
+    for (int k = 0; k < this->bins(); ++k) {
+
+        mag[k] += static_cast<float>(std::abs(this->spectrum[k]) * this->scale);
+    }
+
+    if (channel == 0) {
+
+        ++(this->averaged);
+    }
+}
+
+void SpectrumAnalyzer::publish() {
+
+    auto& snap = this->snapshots.write_buffer();
+
+    // Finish the measurements:
+
+    const float inv = 1.0F / static_cast<float>(this->averaged);
+
+    for (float& val : snap.magnitude) {
+
+        val *= inv;
+    }
+
+    for (int c = 0; c < snap.channels; ++c) {
+
+        snap.rms[c] = static_cast<float>(std::sqrt(this->power[c] / static_cast<double>(this->measured)));
+    }
+
+    snap.sample = this->get_chain_info()->sample + static_cast<int64_t>(this->buff->size()) / snap.channels;
+    snap.sequence = this->sequence++;
+
+    this->snapshots.publish();
+
+    // Clear the new write buffer:
+
+    auto& next = this->snapshots.write_buffer();
+
+    std::ranges::fill(next.magnitude, 0);
+    std::ranges::fill(next.peak, 0);
+    std::ranges::fill(this->power, 0);
+
+    this->averaged = 0;
+    this->measured = 0;
+}
+
+void ToneDetector::process() {
+
+    const int channels = this->buff->channels();
+    const auto num = static_cast<int>(this->buff->size()) / channels;
+
+    // Ensure we are set up for these channels:
+
+    if (channels != static_cast<int>(this->banks.size())) {
+
+        this->prepare(channels);
+    }
+
+    const std::ptrdiff_t stride = AudioBuffer::layout::planar ? 1 : channels;
+
+    bool completed = false;
+
+    for (int c = 0; c < channels; ++c) {
+
+        const sample_t* data = this->buff->data() + AudioBuffer::layout::offset(c, 0, channels, this->buff->channel_capacity());
+
+        completed = this->banks[c].process(data, num, stride) > 0 || completed;
+    }
+
+    if (!completed) {
+
+        return;
+    }
+
+    // Publish the last completed window:
+
+    auto& snap = this->snapshots.write_buffer();
+
+    const int bins = snap.bins;
+
+    for (int c = 0; c < channels; ++c) {
+
+        const auto& mag = this->banks[c].magnitudes();
+
+        std::transform(mag.begin(), mag.end(), snap.magnitude.begin() + static_cast<std::ptrdiff_t>(c) * bins, [](double val) { return static_cast<float>(val); });
+    }
+
+    snap.sample = this->get_chain_info()->sample + num;
+    snap.sequence = this->sequence++;
+
+    this->snapshots.publish();
+}
+
+void ToneDetector::footprint(MemoryFootprint& usage) const {
+
+    AudioModule::footprint(usage);
+
+    for (const auto& bank : this->banks) {
+
+        usage.state += bank.bytes();
+    }
+
+    usage.state += heap_bytes(this->frequencies);
+}
+
+void ToneDetector::start() {
+
+    AudioModule::start();
+
+    this->sequence = 0;
+
+    this->prepare(this->get_info()->channels);
+}
+
+void ToneDetector::prepare(int channels) {
+
+    // Configure a bank for each channel:
+
+    this->banks.assign(channels, GoertzelBank(this->frequencies, this->get_info()->sample_rate, this->window));
+
+    // Allocate the snapshots:
+
+    ToneSnapshot snap;
+
+    snap.channels = channels;
+    snap.bins = static_cast<int>(this->frequencies.size());
+    snap.frequencies = this->frequencies;
+    snap.magnitude.assign(static_cast<std::size_t>(channels) * snap.bins, 0);
+
+    this->snapshots.reset(snap);
+}
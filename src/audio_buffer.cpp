@@ -29,11 +29,11 @@ std::unique_ptr<AudioBuffer> create_buffer(int size, int channels, double sample
     return std::make_unique<AudioBuffer>(size, channels, sample_rate);
 }
 
-float mf_float(long double val) { return static_cast<float>(val); }
+float mf_float(sample_t val) { return static_cast<float>(val); }
 
-long double mf_null(long double val) { return val; }
+sample_t mf_null(sample_t val) { return val; }
 
-int16_t mf_int16(long double val) {
+int16_t mf_int16(sample_t val) {
 
     if (val < 0) {
 
@@ -45,14 +45,14 @@ int16_t mf_int16(long double val) {
     return static_cast<int16_t>(val * 32767);
 }
 
-uint16_t mf_uint16(long double val) {
+uint16_t mf_uint16(sample_t val) {
 
     // Add, multiply, and return:
 
     return static_cast<uint16_t>(std::round(((val + 1) / 2) * 65535));
 }
 
-char mf_char(long double val) {
+char mf_char(sample_t val) {
 
     if (val < 0) {
 
@@ -66,44 +66,44 @@ char mf_char(long double val) {
     return static_cast<char>(val * 127.);
 }
 
-unsigned char mf_uchar(long double val) {
+unsigned char mf_uchar(sample_t val) {
 
     // Add, divide, multiply:
 
     return static_cast<unsigned char>(std::round(((val + 1.) / 2.) * 255.));
 }
 
-long double int16_mf(int16_t val) {
+sample_t int16_mf(int16_t val) {
 
     // Divide by largest value:
 
-    return static_cast<long double>(val) / 32767.;
+    return static_cast<sample_t>(val) / 32767.;
 }
 
-long double uint16_mf(uint16_t val) {
+sample_t uint16_mf(uint16_t val) {
 
     // Normalize, double, subtract:
 
-    return (static_cast<long double>(val) / 65535.) * 2. - 1.;
+    return (static_cast<sample_t>(val) / 65535.) * 2. - 1.;
 }
 
-long double char_mf(char val) {
+sample_t char_mf(char val) {
 
     if (val < 0) {
 
         // Divide by largest value:
 
-        return static_cast<long double>(val) / 128.;
+        return static_cast<sample_t>(val) / 128.;
     }
 
     // Divide by largest value:
 
-    return static_cast<long double>(val) / 127.;
+    return static_cast<sample_t>(val) / 127.;
 }
 
-long double uchar_mf(unsigned char val) {
+sample_t uchar_mf(unsigned char val) {
 
     // Normalize, double, subtract:
 
-    return (static_cast<long double>(val) / 255.) * 2. - 1.;
+    return (static_cast<sample_t>(val) / 255.) * 2. - 1.;
 }
@@ -11,25 +11,132 @@
 
 #include "audio_module.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
 #include "audio_buffer.hpp"
 #include "base_module.hpp"
+#include "chrono.hpp"
+#include "dsp/alloc.hpp"
+#include "trace.hpp"
 
 void AudioModule::meta_process() {  // NOLINT(misc-no-recursion): No recursion cycles present, valid chains will eventually end
 
+    MAEC_TRACE_SCOPE("meta_process", typeid(*this).name());
+
     // Call the module behind us:
 
     this->get_backward()->meta_process();
 
-    // Grab the buffer from the module behind us:
+    // Process ourselves:
+
+    this->step();
+}
+
+void AudioModule::step() {
+
+    // Share the buffer of the module behind us if we can:
+
+    SharedBuffer shared = this->read_only() ? this->get_backward()->share_buffer() : nullptr;
 
-    this->set_buffer(this->get_backward()->get_buffer());
+    if (shared != nullptr) {
+
+        this->reclaim_buffer(std::move(this->buff));
+
+        this->sbuff = std::move(shared);
+    }
+
+    else {
+
+        // Grab the buffer from the module behind us:
+
+        this->set_buffer(this->get_backward()->get_buffer());
+    }
 
     // Call the processing module of our own:
 
+    this->run_process();
+}
+
+void AudioModule::profiled_process() {
+
+    const AllocStats before = thread_alloc_stats();
+    const int64_t start = get_time();
+
     this->process();
+
+    const int64_t time = get_time() - start;
+    const AllocStats after = thread_alloc_stats();
+
+    // Determine the size of the buffer we produced:
+
+    const AudioBuffer* out = this->input_buffer();
+
+    const uint64_t bytes = out != nullptr ? out->size() * sizeof(sample_t) : 0;
+
+    this->profile->record(time, after.count - before.count, after.bytes - before.bytes, bytes);
+}
+
+bool AudioModule::plan_inputs(std::vector<AudioModule*>& inputs) {
+
+    if (this->backward != nullptr) {
+
+        inputs.push_back(this->backward);
+    }
+
+    return true;
+}
+
+void AudioModule::render_events(int size) {
+
+    // If we have no chain, render everything:
+
+    if (this->chain == nullptr) {
+
+        this->render(0, size);
+
+        return;
+    }
+
+    // Events are held back while warming up, so they are delivered on time later:
+
+    if (this->chain->warming) {
+
+        this->render(0, size);
+
+        return;
+    }
+
+    const int64_t start = this->chain->sample;
+    const int64_t end = start + size;
+
+    int64_t time = start;
+
+    while (time < end) {
+
+        // Handle events that have been reached:
+
+        this->chain->events.dispatch(this, time);
+
+        // Render until the next event:
+
+        const int64_t next = this->chain->events.next(this, time, end);
+
+        this->render(static_cast<int>(time - start), static_cast<int>(next - time));
+
+        time = next;
+    }
+}
+
+void AudioModule::schedule(EventType type, int64_t sample, int id, double value) {
+
+    if (this->chain == nullptr) {
+
+        return;
+    }
+
+    this->chain->events.push(Event{sample, this, type, id, value});
 }
 
 void AudioModule::meta_start() {  // NOLINT(misc-no-recursion): No recursion cycles present, valid chains will eventually end
@@ -47,6 +154,19 @@ void AudioModule::meta_start() {  // NOLINT(misc-no-recursion): No recursion cyc
     this->start();
 }
 
+void AudioModule::footprint(MemoryFootprint& usage) const {
+
+    if (this->buff != nullptr) {
+
+        usage.buffers += this->buff->bytes();
+    }
+
+    if (this->sbuff != nullptr) {
+
+        usage.buffers += this->sbuff->bytes();
+    }
+}
+
 void AudioModule::meta_stop() {  // NOLINT(misc-no-recursion): No recursion cycles present, valid chains will eventually end
 
     // Yeah, just ask for previous module to stop:
@@ -79,9 +199,12 @@ void AudioModule::meta_finish() {  // NOLINT(misc-no-recursion): No recursion cy
 
 void AudioModule::info_sync() {
 
-    // By default, copy AudioInfo from front:
+    // By default, copy AudioInfo from front, keeping our own latency:
+
+    const int latency = this->info.latency;
 
     this->info = *(this->forward->get_info());
+    this->info.latency = latency;
 }
 
 void AudioModule::meta_info_sync() {  // NOLINT(misc-no-recursion): No recursion cycles present, valid chains eventually end
@@ -101,9 +224,12 @@ void AudioModule::done() {
 
     BaseModule::done();
 
-    // Report to the chain that we are done:
+    // Report to the chain that we are done, if we are a part of one:
+
+    if (this->chain != nullptr) {
 
-    ++(this->chain->module_finish);
+        ++(this->chain->module_finish);
+    }
 }
 
 void AudioModule::finish() {
@@ -115,25 +241,88 @@ void AudioModule::finish() {
 
 void AudioModule::set_buffer(std::unique_ptr<AudioBuffer> inbuff) {
 
+    // Hand back any buffer we are holding:
+
+    this->reclaim_buffer(std::move(this->buff));
+
     // Set our buffer:
 
     this->buff = std::move(inbuff);
+
+    this->sbuff.reset();
 }
 
 std::unique_ptr<AudioBuffer> AudioModule::get_buffer() {
 
+    // If we only have a shared buffer, return a copy:
+
+    if (this->buff == nullptr && this->sbuff != nullptr) {
+
+        const int channels = this->sbuff->channels();
+
+        std::unique_ptr<AudioBuffer> copy = this->chain != nullptr ? this->chain->pool.get(static_cast<int>(this->sbuff->size()) / channels, channels, this->sbuff->get_samplerate())
+                                                                   : std::make_unique<AudioBuffer>(*this->sbuff);
+
+        std::copy_n(this->sbuff->data(), this->sbuff->size(), copy->data());
+
+        this->sbuff.reset();
+
+        return copy;
+    }
+
     // Return our buffer:
 
     return std::move(this->buff);
 }
 
+SharedBuffer AudioModule::share_buffer() {
+
+    // Only pass along a buffer that is already shared:
+
+    if (this->buff != nullptr) {
+
+        return nullptr;
+    }
+
+    return this->sbuff;
+}
+
 std::unique_ptr<AudioBuffer> AudioModule::create_buffer(int channels) {
 
+    // Pull from the chain pool if we can:
+
+    if (this->chain != nullptr) {
+
+        return this->chain->pool.get(this->block_size(), channels, this->info.sample_rate);
+    }
+
     // Allocate the new buffer:
 
     return std::make_unique<AudioBuffer>(this->info.out_buffer, channels, this->info.sample_rate);
 }
 
+int AudioModule::block_size() const {
+
+    // Follow the chain if we output blocks of the chain size:
+
+    if (this->chain != nullptr && this->info.out_buffer == this->chain->buffer_size) {
+
+        return this->chain->block_size();
+    }
+
+    return this->info.out_buffer;
+}
+
+int AudioModule::max_block_size() const {
+
+    if (this->chain != nullptr && this->info.out_buffer == this->chain->buffer_size) {
+
+        return this->chain->max_block_size();
+    }
+
+    return this->info.out_buffer;
+}
+
 std::unique_ptr<AudioBuffer> AudioModule::create_buffer(int size, int channels) {
 
     // Allocate the new buffer:
@@ -141,6 +330,16 @@ std::unique_ptr<AudioBuffer> AudioModule::create_buffer(int size, int channels)
     return std::make_unique<AudioBuffer>(size, channels);
 }
 
+void AudioModule::reclaim_buffer(std::unique_ptr<AudioBuffer> rbuff) {
+
+    // Hand the buffer to the chain pool if we can:
+
+    if (this->chain != nullptr) {
+
+        this->chain->pool.reclaim(std::move(rbuff));
+    }
+}
+
 void AudioModule::set_forward(AudioModule* mod) {
 
     // Set the forward module:
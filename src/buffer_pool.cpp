@@ -0,0 +1,103 @@
+/**
+ * @file buffer_pool.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations for buffer pools
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "buffer_pool.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "audio_buffer.hpp"
+
+BufferPointer BufferPool::get(int size, int channels, double sample_rate) {
+
+    // Determine if we have any buffers on hand:
+
+    if (this->free.empty()) {
+
+        // Allocate a new buffer:
+
+        ++(this->allocated);
+
+        BufferPointer buff = std::make_unique<AudioBuffer>(size, channels, sample_rate);
+
+        buff->reserve(static_cast<std::size_t>(std::max(size, this->capacity)) * channels);
+
+        return buff;
+    }
+
+    // Grab the last buffer:
+
+    BufferPointer buff = std::move(this->free.back());
+    this->free.pop_back();
+
+    // Configure the buffer:
+
+    buff->set_channels(channels);
+    buff->set_samplerate(sample_rate);
+    buff->resize(size * channels);
+
+    // Zero the contents:
+
+    std::ranges::fill(buff->span(), 0);
+
+    return buff;
+}
+
+void BufferPool::reclaim(BufferPointer buff) {
+
+    // Ensure we can hold this buffer:
+
+    if (buff == nullptr || this->free.size() >= this->max_size) {
+
+        return;
+    }
+
+    this->free.push_back(std::move(buff));
+}
+
+void BufferPool::reserve(int num, int size, int channels) {
+
+    // Allocate each buffer:
+
+    for (int i = 0; i < num && this->free.size() < this->max_size; ++i) {
+
+        ++(this->allocated);
+
+        this->free.push_back(std::make_unique<AudioBuffer>(std::max(size, this->capacity), channels));
+    }
+}
+
+void BufferPool::set_max(std::size_t max) {
+
+    // Set the new max:
+
+    this->max_size = max;
+
+    // Free any extra buffers:
+
+    if (this->free.size() > max) {
+
+        this->free.resize(max);
+    }
+}
+
+std::size_t BufferPool::bytes() const {
+
+    std::size_t total = 0;
+
+    for (const auto& buff : this->free) {
+
+        total += buff->bytes();
+    }
+
+    return total;
+}
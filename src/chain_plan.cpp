@@ -0,0 +1,330 @@
+/**
+ * @file chain_plan.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations for compiled execution plans
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "chain_plan.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "module_param.hpp"
+#include "sink_module.hpp"
+
+void ChainPlan::release() {
+
+    for (auto& step : this->schedule) {
+
+        auto* param = dynamic_cast<ModuleParam*>(step.mod);
+
+        if (param != nullptr) {
+
+            param->set_planned(false);
+        }
+    }
+
+    this->schedule.clear();
+
+    this->buffers = 0;
+    this->peak = 0;
+}
+
+void ChainPlan::analyze() {
+
+    const int num = static_cast<int>(this->schedule.size());
+
+    // Determine the position of each module:
+
+    std::unordered_map<AudioModule*, int> pos;
+
+    for (int i = 0; i < num; ++i) {
+
+        pos.emplace(this->schedule[i].mod, i);
+    }
+
+    // Determine the inputs of each step, and who reads each buffer:
+
+    std::vector<std::vector<int>> inputs(num);
+    std::vector<int> readers(num, 0);
+    std::vector<AudioModule*> mods;
+
+    for (int i = 0; i < num; ++i) {
+
+        auto& step = this->schedule[i];
+
+        // Buffers with no readers are held until the next block:
+
+        step.last_use = num;
+
+        if (step.opaque) {
+
+            continue;
+        }
+
+        mods.clear();
+
+        step.mod->plan_inputs(mods);
+
+        for (AudioModule* mod : mods) {
+
+            auto iter = pos.find(mod);
+
+            if (iter != pos.end()) {
+
+                inputs[i].push_back(iter->second);
+
+                ++(readers[iter->second]);
+            }
+        }
+    }
+
+    // Readers are visited in order, so the last one wins:
+
+    for (int i = 0; i < num; ++i) {
+
+        for (const int input : inputs[i]) {
+
+            this->schedule[input].last_use = i;
+        }
+    }
+
+    // Assign buffers, in place modules continue the buffer of their only input:
+
+    std::vector<int> start;
+    std::vector<int> end;
+
+    for (int i = 0; i < num; ++i) {
+
+        auto& step = this->schedule[i];
+
+        const bool continues = !step.opaque && step.mod->in_place() && inputs[i].size() == 1 && readers[inputs[i][0]] == 1;
+
+        if (continues) {
+
+            step.buffer = this->schedule[inputs[i][0]].buffer;
+        }
+
+        else {
+
+            step.buffer = static_cast<int>(start.size());
+
+            start.push_back(i);
+            end.push_back(i);
+        }
+
+        end[step.buffer] = std::max(end[step.buffer], step.last_use);
+    }
+
+    this->buffers = static_cast<int>(start.size());
+
+    // Determine the peak number of live buffers:
+
+    std::vector<int> delta(num + 2, 0);
+
+    for (int b = 0; b < this->buffers; ++b) {
+
+        ++delta[start[b]];
+        --delta[std::min(end[b], num) + 1];
+    }
+
+    int live = 0;
+
+    for (int i = 0; i <= num; ++i) {
+
+        live += delta[i];
+
+        this->peak = std::max(this->peak, live);
+    }
+
+    // Release buffers once their last reader is done:
+
+    for (int i = 0; i < num; ++i) {
+
+        const int last = this->schedule[i].last_use;
+
+        if (last < num) {
+
+            this->schedule[last].release.push_back(this->schedule[i].mod);
+        }
+    }
+
+    // Share the pool of the front module:
+
+    ChainInfo* chain = this->front->get_chain_info();
+
+    if (chain == nullptr) {
+
+        return;
+    }
+
+    for (auto& step : this->schedule) {
+
+        if (step.mod->get_chain_info() == nullptr) {
+
+            step.mod->set_chain_info(chain);
+        }
+    }
+
+    // Fill the pool so a steady state block does not allocate:
+
+    const int missing = this->peak - static_cast<int>(chain->pool.available());
+
+    if (missing > 0) {
+
+        chain->pool.reserve(missing, chain->buffer_size, chain->channels);
+    }
+}
+
+void ChainPlan::compile(AudioModule* mod) {
+
+    // Clear any old schedule:
+
+    this->release();
+
+    this->front = mod;
+    this->repeat = 1;
+    this->sink = nullptr;
+
+    if (mod == nullptr) {
+
+        return;
+    }
+
+    // Determine the number of periods:
+
+    this->sink = dynamic_cast<PeriodSink*>(mod);
+
+    if (this->sink != nullptr) {
+
+        this->repeat = this->sink->get_period();
+    }
+
+    // Walk the graph depth first, adding modules after their inputs.
+    // We use an explicit stack to avoid recursing through long chains:
+
+    std::unordered_set<AudioModule*> visited;
+    std::vector<std::pair<AudioModule*, bool>> stack;
+    std::vector<AudioModule*> inputs;
+
+    stack.emplace_back(mod, false);
+
+    while (!stack.empty()) {
+
+        auto [current, expanded] = stack.back();
+        stack.pop_back();
+
+        if (expanded) {
+
+            // All inputs are scheduled, schedule this module:
+
+            inputs.clear();
+
+            const bool opaque = !current->plan_inputs(inputs);
+
+            this->schedule.push_back(Step{current, opaque, 0, 0, {}});
+
+            continue;
+        }
+
+        if (!visited.insert(current).second) {
+
+            continue;
+        }
+
+        // Determine our inputs:
+
+        inputs.clear();
+
+        const bool steppable = current->plan_inputs(inputs);
+
+        stack.emplace_back(current, true);
+
+        if (!steppable) {
+
+            // Meta processed as a whole, do not descend:
+
+            continue;
+        }
+
+        // Push inputs in reverse, so they are scheduled in order:
+
+        for (auto iter = inputs.rbegin(); iter != inputs.rend(); ++iter) {
+
+            if (*iter != nullptr && visited.count(*iter) == 0) {
+
+                stack.emplace_back(*iter, false);
+            }
+        }
+    }
+
+    // Parameters are now processed by us:
+
+    for (auto& step : this->schedule) {
+
+        auto* param = dynamic_cast<ModuleParam*>(step.mod);
+
+        if (param != nullptr) {
+
+            param->set_planned(true);
+        }
+    }
+
+    // Finally, determine buffer lifetimes:
+
+    this->analyze();
+}
+
+void ChainPlan::process() {
+
+    int64_t render = 0;
+
+    for (int i = 0; i < this->repeat; ++i) {
+
+        int64_t start = this->sink != nullptr ? get_time() : 0;
+
+        for (const auto& step : this->schedule) {
+
+            // Time spent in the sink is not rendering:
+
+            if (step.mod == this->sink) {
+
+                render += get_time() - start;
+            }
+
+            if (step.opaque) {
+
+                step.mod->meta_process();
+            }
+
+            else {
+
+                step.mod->step();
+            }
+
+            for (AudioModule* mod : step.release) {
+
+                mod->release_buffer();
+            }
+
+            if (step.mod == this->sink) {
+
+                start = get_time();
+            }
+        }
+    }
+
+    // Report the load to the sink:
+
+    if (this->sink != nullptr) {
+
+        this->sink->record_render(render, this->sink->block_size() * this->repeat);
+    }
+}
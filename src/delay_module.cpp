@@ -0,0 +1,306 @@
+/**
+ * @file delay_module.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations for the delay module
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "delay_module.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "dsp/mix.hpp"
+
+int DelayModule::add_tap(double time, double gain, double depth) {
+
+    this->taps.push_back(Tap{time, gain, depth});
+
+    return static_cast<int>(this->taps.size()) - 1;
+}
+
+void DelayModule::footprint(MemoryFootprint& usage) const {
+
+    AudioModule::footprint(usage);
+
+    for (const auto& line : this->lines) {
+
+        usage.state += line.bytes();
+    }
+
+    usage.state += heap_bytes(this->taps) + heap_bytes(this->states) + heap_bytes(this->delays) + heap_bytes(this->mods);
+    usage.state += heap_bytes(this->tap_out) + heap_bytes(this->wet) + heap_bytes(this->fed) + heap_bytes(this->chan_data);
+}
+
+void DelayModule::start() {
+
+    this->prepare(this->get_info()->channels, this->max_block_size());
+}
+
+void DelayModule::prepare(int channels, int block) {
+
+    // Create a silent line for each channel:
+
+    const auto longest = static_cast<int>(std::ceil(this->max_delay * this->get_info()->sample_rate));
+
+    this->lines.assign(static_cast<std::size_t>(std::max(channels, 1)), DelayLine<sample_t>(longest, block));
+
+    this->states.assign(this->lines.size() * this->taps.size(), 0);
+    this->quiet = 0;
+
+    // Allocate the scratch space for each block:
+
+    const auto size = static_cast<std::size_t>(block);
+
+    this->delays.resize(size * std::max<std::size_t>(this->taps.size(), 1));
+    this->mods.resize(size);
+    this->tap_out.resize(size);
+    this->wet.resize(size);
+    this->fed.resize(size);
+    this->chan_data.resize(size);
+}
+
+void DelayModule::process() {
+
+    const int channels = this->buff->channels();
+    const auto frames = static_cast<int>(this->buff->size()) / channels;
+
+    // Ensure we have a line for each channel, and room for each tap:
+
+    if (this->lines.size() != static_cast<std::size_t>(channels) || frames > this->lines.front().get_max_block()) {
+
+        this->prepare(channels, std::max(frames, this->max_block_size()));
+    }
+
+    if (this->states.size() != this->lines.size() * this->taps.size()) {
+
+        this->states.assign(this->lines.size() * this->taps.size(), 0);
+        this->delays.resize(this->mods.size() * std::max<std::size_t>(this->taps.size(), 1));
+    }
+
+    // Grab the modulation values for this block:
+
+    const ParamRate rate = this->modulation.get_rate();
+
+    this->moving = rate != ParamRate::Constant;
+
+    if (rate == ParamRate::Control) {
+
+        const std::pair<sample_t, sample_t> control = this->modulation.get_control();
+
+        for (int i = 0; i < frames; ++i) {
+
+            this->mods[i] = control.first + (control.second - control.first) * static_cast<sample_t>(i + 1) / static_cast<sample_t>(frames);
+        }
+    }
+
+    else if (rate == ParamRate::Audio) {
+
+        const SharedBuffer mdata = this->modulation.share();
+
+        const int available = static_cast<int>(mdata->size() / mdata->channels());
+
+        for (int i = 0; i < frames; ++i) {
+
+            this->mods[i] = available > 0 ? mdata->at(0, std::min(i, available - 1)) : 0;
+        }
+    }
+
+    // Determine the delay of each tap, held between what the interpolation can read and the longest delay:
+
+    const double srate = this->get_info()->sample_rate;
+    const double low = delay_lookahead(this->interpolation) + (this->feedback != 0 ? 1 : 0);
+    const auto high = static_cast<double>(std::max(this->lines.front().get_max_delay(), static_cast<int>(std::ceil(low))));
+
+    this->shortest = high;
+
+    // Delays that should be whole samples may land just below them after scaling, so we snap them:
+
+    auto samples = [&](double sec) {
+
+        const double delay = sec * srate;
+        const double near = std::round(delay);
+
+        return std::clamp(std::fabs(delay - near) < 1e-6 ? near : delay, low, high);
+    };
+
+    for (std::size_t t = 0; t < this->taps.size(); ++t) {
+
+        const Tap& tap = this->taps[t];
+
+        if (!this->moving) {
+
+            const double delay = samples(tap.time + tap.depth * this->modulation.get_constant());
+
+            this->delays[t] = static_cast<sample_t>(delay);
+            this->shortest = std::min(this->shortest, delay);
+
+            continue;
+        }
+
+        sample_t* tdelays = this->delays.data() + t * this->mods.size();
+
+        for (int i = 0; i < frames; ++i) {
+
+            const double delay = samples(tap.time + tap.depth * this->mods[i]);
+
+            tdelays[i] = static_cast<sample_t>(delay);
+            this->shortest = std::min(this->shortest, delay);
+        }
+    }
+
+    // Silence in is silence out once the line has emptied:
+
+    const auto empty = static_cast<std::size_t>(this->lines.front().get_max_delay()) + 4;
+
+    if (this->buff->is_silent() && this->quiet >= empty) {
+
+        this->quiet += static_cast<std::size_t>(frames);
+
+        std::fill(this->states.begin(), this->states.end(), 0);
+
+        return;
+    }
+
+    this->buff->clear_constant();
+
+    // Delay each channel:
+
+    bool loud = false;
+
+    for (int c = 0; c < channels; ++c) {
+
+        if constexpr (AudioBuffer::layout::planar) {
+
+            sample_t* data = this->buff->data() + AudioBuffer::layout::offset(c, 0, channels, this->buff->channel_capacity());
+
+            loud = this->process_channel(c, data, frames) || loud;
+        }
+
+        else {
+
+            // Gather the channel, delay it, and scatter it back:
+
+            sample_t* data = this->buff->data();
+
+            for (int i = 0; i < frames; ++i) {
+
+                this->chan_data[i] = data[static_cast<std::ptrdiff_t>(i) * channels + c];
+            }
+
+            loud = this->process_channel(c, this->chan_data.data(), frames) || loud;
+
+            for (int i = 0; i < frames; ++i) {
+
+                data[static_cast<std::ptrdiff_t>(i) * channels + c] = this->chan_data[i];
+            }
+        }
+    }
+
+    // Keep track of how long we have only written silence:
+
+    this->quiet = loud ? 0 : this->quiet + static_cast<std::size_t>(frames);
+}
+
+bool DelayModule::process_channel(int chan, sample_t* data, int num) {
+
+    DelayLine<sample_t>& line = this->lines[chan];
+    sample_t* states = this->states.data() + static_cast<std::size_t>(chan) * this->taps.size();
+
+    const auto stride = this->mods.size();
+    const auto fback = static_cast<sample_t>(this->feedback);
+
+    const sample_t* written = data;
+
+    // Without feedback, write the whole block first, then every tap reads it:
+
+    if (this->feedback == 0) {
+
+        line.write(data, num);
+
+        std::fill_n(this->wet.begin(), num, 0);
+
+        for (std::size_t t = 0; t < this->taps.size(); ++t) {
+
+            if (this->moving) {
+
+                line.read(this->tap_out.data(), num, this->delays.data() + t * stride, this->interpolation, num, states[t]);
+            }
+
+            else {
+
+                line.read(this->tap_out.data(), num, static_cast<double>(this->delays[t]), this->interpolation, num, states[t]);
+            }
+
+            mix_add(this->wet.data(), this->tap_out.data(), num, static_cast<sample_t>(this->taps[t].gain));
+        }
+    }
+
+    // With feedback, read each piece before writing it, so each piece may be no longer than the shortest delay:
+
+    else {
+
+        const int chunk = std::max(1, static_cast<int>(std::floor(this->shortest - delay_lookahead(this->interpolation))));
+
+        for (int pos = 0; pos < num; pos += chunk) {
+
+            const int size = std::min(chunk, num - pos);
+
+            sample_t* wpos = this->wet.data() + pos;
+
+            std::fill_n(wpos, size, 0);
+
+            for (std::size_t t = 0; t < this->taps.size(); ++t) {
+
+                if (this->moving) {
+
+                    line.read(this->tap_out.data(), size, this->delays.data() + t * stride + pos, this->interpolation, 0, states[t]);
+                }
+
+                else {
+
+                    line.read(this->tap_out.data(), size, static_cast<double>(this->delays[t]), this->interpolation, 0, states[t]);
+                }
+
+                mix_add(wpos, this->tap_out.data(), size, static_cast<sample_t>(this->taps[t].gain));
+            }
+
+            // Feed the wet signal back into the line:
+
+            for (int i = 0; i < size; ++i) {
+
+                this->fed[pos + i] = data[pos + i] + fback * wpos[i];
+            }
+
+            line.write(this->fed.data() + pos, size);
+        }
+
+        written = this->fed.data();
+    }
+
+    // Determine if we wrote anything audible:
+
+    bool loud = false;
+
+    for (int i = 0; i < num; ++i) {
+
+        loud = loud || std::fabs(written[i]) > SILENCE_LEVEL;
+    }
+
+    // Mix the dry and wet signals:
+
+    const auto dry = static_cast<sample_t>(1 - this->mix);
+    const auto amount = static_cast<sample_t>(this->mix);
+
+    for (int i = 0; i < num; ++i) {
+
+        data[i] = dry * data[i] + amount * this->wet[i];
+    }
+
+    return loud;
+}
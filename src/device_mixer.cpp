@@ -0,0 +1,306 @@
+/**
+ * @file device_mixer.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations of the device mixer
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "device_mixer.hpp"
+
+#include <chrono>
+
+#include "dsp/interleave.hpp"
+#include "dsp/mix.hpp"
+#include "trace.hpp"
+
+int DeviceMixer::Client::write(const sample_t* data, int frames) {
+
+    // The ring may not hold a whole number of frames, so only write the frames that fit:
+
+    const std::size_t num = std::min(static_cast<std::size_t>(std::max(frames, 0)), this->ring.write_available() / this->channels);
+
+    return static_cast<int>(this->ring.write(data, num * this->channels) / this->channels);
+}
+
+DeviceMixer::DeviceMixer(int channels, int period, double rate)
+    : channels(std::max(channels, 1)), period(std::max(period, 1)), rate(rate > 0 ? rate : SAMPLE_RATE) {
+
+    const auto total = static_cast<std::size_t>(this->channels) * this->period;
+
+    this->mixed.resize(total);
+    this->scratch.resize(total);
+}
+
+DeviceMixer::~DeviceMixer() { this->stop(); }
+
+std::shared_ptr<DeviceMixer::Client> DeviceMixer::attach(int capacity) {
+
+    const std::lock_guard<std::mutex> guard(this->lock);
+
+    for (auto& slot : this->slots) {
+
+        if (slot.load(std::memory_order_relaxed) != nullptr) {
+
+            continue;
+        }
+
+        auto client = std::make_shared<Client>();
+
+        client->channels = this->channels;
+        client->ring.reserve(static_cast<std::size_t>(std::max(capacity, this->period)) * this->channels);
+
+        // Publish the client to the mixer thread:
+
+        slot.store(client.get());
+
+        this->owners.push_back(client);
+
+        return client;
+    }
+
+    return nullptr;
+}
+
+void DeviceMixer::detach(const std::shared_ptr<Client>& client) {
+
+    if (client == nullptr) {
+
+        return;
+    }
+
+    const std::lock_guard<std::mutex> guard(this->lock);
+
+    for (auto& slot : this->slots) {
+
+        Client* expected = client.get();
+
+        if (!slot.compare_exchange_strong(expected, nullptr)) {
+
+            continue;
+        }
+
+        // The mixer may have loaded the client before we cleared it,
+        // so wait until it is done with this period:
+
+        while (this->mixing.load()) {
+
+            std::this_thread::yield();
+        }
+
+        std::erase(this->owners, client);
+
+        return;
+    }
+}
+
+int DeviceMixer::clients() const {
+
+    const std::lock_guard<std::mutex> guard(this->lock);
+
+    return static_cast<int>(this->owners.size());
+}
+
+bool DeviceMixer::clients_ready() {
+
+    // Clients are read here too, so detach() must wait for us:
+
+    this->mixing.store(true);
+
+    bool ready = true;
+
+    for (const auto& slot : this->slots) {
+
+        const Client* client = slot.load();
+
+        if (client != nullptr && client->queued() < this->period) {
+
+            ready = false;
+
+            break;
+        }
+    }
+
+    this->mixing.store(false);
+
+    return ready;
+}
+
+int DeviceMixer::mix() {
+
+    const int total = this->channels * this->period;
+
+    this->mixing.store(true);
+
+    std::fill(this->mixed.begin(), this->mixed.end(), 0);
+
+    int num = 0;
+
+    for (auto& slot : this->slots) {
+
+        Client* client = slot.load();
+
+        if (client == nullptr) {
+
+            continue;
+        }
+
+        // Read a period of whole frames, anything missing is left silent:
+
+        const std::size_t frames = std::min(static_cast<std::size_t>(this->period), client->ring.read_available() / this->channels);
+
+        const int read = static_cast<int>(client->ring.read(this->scratch.data(), frames * this->channels));
+
+        if (read < total) {
+
+            client->underruns.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        const sample_t gain = client->gain.load(std::memory_order_relaxed);
+
+        if (gain == 1) {
+
+            mix_add(this->mixed.data(), this->scratch.data(), read);
+        }
+
+        else {
+
+            mix_add(this->mixed.data(), this->scratch.data(), read, gain);
+        }
+
+        ++num;
+    }
+
+    this->mixing.store(false);
+
+    // Send the period to the device:
+
+    if (this->output) {
+
+        this->output(this->mixed.data(), this->period);
+    }
+
+    this->periods.fetch_add(1, std::memory_order_relaxed);
+
+    return num;
+}
+
+void DeviceMixer::start() {
+
+    if (this->running.exchange(true)) {
+
+        return;
+    }
+
+    this->mixer = std::thread([this]() { this->run(); });
+}
+
+void DeviceMixer::stop() {
+
+    this->running.store(false);
+
+    if (this->mixer.joinable()) {
+
+        this->mixer.join();
+    }
+}
+
+void DeviceMixer::run() {
+
+    MAEC_TRACE_THREAD("device mixer");
+
+    this->status = apply_rt(this->config);
+
+    const auto length = std::chrono::nanoseconds(static_cast<int64_t>(static_cast<double>(this->period) * NANO / this->rate));
+    const auto pause = length / 8 + std::chrono::nanoseconds(1);
+
+    auto deadline = std::chrono::steady_clock::now() + length;
+
+    while (this->running.load(std::memory_order_relaxed)) {
+
+        // Wait until every client has a period, or a period of time has passed:
+
+        if (!this->clients_ready() && std::chrono::steady_clock::now() < deadline) {
+
+            std::this_thread::sleep_for(pause);
+
+            continue;
+        }
+
+        this->mix();
+
+        deadline = std::chrono::steady_clock::now() + length;
+    }
+}
+
+MixerSink::~MixerSink() {
+
+    if (this->client != nullptr) {
+
+        this->mixer->detach(this->client);
+    }
+}
+
+void MixerSink::start() {
+
+    SinkModule::start();
+
+    if (this->client == nullptr) {
+
+        this->client = this->mixer->attach(this->depth * this->mixer->get_period());
+    }
+
+    this->dropped = 0;
+}
+
+void MixerSink::stop() {
+
+    SinkModule::stop();
+
+    this->mixer->detach(this->client);
+    this->client.reset();
+}
+
+void MixerSink::process() {
+
+    const int channels = static_cast<int>(this->buff->channels());
+    const int frames = static_cast<int>(this->buff->size()) / channels;
+
+    // Blocks we can't hand to the mixer are dropped:
+
+    if (this->client == nullptr || channels != this->mixer->get_channels()) {
+
+        this->dropped += frames;
+
+        return;
+    }
+
+    const sample_t* src = this->buff->data();
+
+    // The mixer expects interleaved frames:
+
+    if constexpr (AudioBuffer::layout::planar) {
+
+        this->frames.resize(this->buff->size());
+
+        interleave(src, this->frames.data(), channels, frames);
+
+        src = this->frames.data();
+    }
+
+    int done = this->client->write(src, frames);
+
+    while (done < frames && this->mixer->is_running()) {
+
+        // Ring is full, give the mixer some time:
+
+        std::this_thread::sleep_for(std::chrono::microseconds(static_cast<int64_t>(this->mixer->get_period() * 250000.0 / this->mixer->get_rate()) + 1));
+
+        done += this->client->write(src + static_cast<std::ptrdiff_t>(done) * channels, frames - done);
+    }
+
+    this->dropped += frames - done;
+}
@@ -0,0 +1,121 @@
+/**
+ * @file alloc.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations of buffer arenas
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "dsp/alloc.hpp"
+
+#include <cstdint>
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace {
+
+/// Size of a huge page
+constexpr std::size_t HUGE_PAGE = 2 * 1024 * 1024;
+
+/// Current arena of each thread
+thread_local HugePageArena* current_arena = nullptr;
+
+/// Allocations made by each thread
+thread_local AllocStats alloc_stats;
+
+}  // namespace
+
+HugePageArena::HugePageArena(std::size_t bytes) : size(((bytes + HUGE_PAGE - 1) / HUGE_PAGE) * HUGE_PAGE) {
+
+#ifdef __linux__
+
+    // Try explicit huge pages first:
+
+    void* ptr = mmap(nullptr, this->size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+    if (ptr != MAP_FAILED) {
+
+        this->hugetlb = true;
+    }
+
+    else {
+
+        // Fall back to normal pages, and ask for transparent huge pages:
+
+        ptr = mmap(nullptr, this->size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (ptr == MAP_FAILED) {
+
+            throw std::bad_alloc();
+        }
+
+        madvise(ptr, this->size, MADV_HUGEPAGE);
+    }
+
+    this->base = static_cast<unsigned char*>(ptr);
+    this->mapped = true;
+
+#else
+
+    this->base = static_cast<unsigned char*>(::operator new(this->size, std::align_val_t(BUFFER_ALIGN)));
+
+#endif
+}
+
+HugePageArena::~HugePageArena() {
+
+#ifdef __linux__
+
+    if (this->mapped) {
+
+        munmap(this->base, this->size);
+
+        return;
+    }
+
+#endif
+
+    ::operator delete(this->base, std::align_val_t(BUFFER_ALIGN));
+}
+
+void* HugePageArena::allocate(std::size_t bytes, std::size_t align) {
+
+    // Align the next offset:
+
+    const std::size_t start = ((this->used + align - 1) / align) * align;
+
+    if (start + bytes > this->size) {
+
+        return nullptr;
+    }
+
+    this->used = start + bytes;
+
+    return this->base + start;
+}
+
+bool HugePageArena::owns(const void* ptr) const {
+
+    const auto addr = reinterpret_cast<std::uintptr_t>(ptr);
+    const auto begin = reinterpret_cast<std::uintptr_t>(this->base);
+
+    return addr >= begin && addr < begin + this->size;
+}
+
+HugePageArena* HugePageArena::current() { return current_arena; }
+
+void HugePageArena::set_current(HugePageArena* arena) { current_arena = arena; }
+
+AllocStats thread_alloc_stats() { return alloc_stats; }
+
+void count_allocation(std::size_t bytes) {
+
+    ++alloc_stats.count;
+    alloc_stats.bytes += bytes;
+}
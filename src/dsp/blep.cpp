@@ -0,0 +1,66 @@
+/**
+ * @file blep.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations of PolyBLEP oscillator kernels
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "dsp/blep.hpp"
+
+#include <cmath>
+
+#include "dsp/target.hpp"
+
+namespace {
+
+/**
+ * @brief Fills a block with a band-limited waveform
+ *
+ * The phase of each sample is computed from the start phase,
+ * so there is no loop carried dependency.
+ *
+ * @tparam T Type of the samples
+ * @tparam Wave Function taking a phase and a width, see blep_square_turns()
+ * @param out Pointer to output data
+ * @param size Number of samples to generate
+ * @param start Starting phase in turns
+ * @param inc Phase increment per sample in turns
+ * @param wave Waveform to generate
+ */
+template <typename T, typename Wave>
+inline void blep_kernel(T* out, int size, double start, double inc, Wave wave) {
+
+    const double width = blep_width(inc);
+
+    for (int i = 0; i < size; ++i) {
+
+        double turn = start + inc * i;
+        turn -= std::floor(turn);
+
+        out[i] = static_cast<T>(wave(turn, width));
+    }
+}
+
+}  // namespace
+
+MAEC_KERNEL_CLONES void osc_blep_square(float* out, int size, double start, double inc) { blep_kernel(out, size, start, inc, blep_square_turns); }
+
+MAEC_KERNEL_CLONES void osc_blep_square(double* out, int size, double start, double inc) { blep_kernel(out, size, start, inc, blep_square_turns); }
+
+void osc_blep_square(long double* out, int size, double start, double inc) { blep_kernel(out, size, start, inc, blep_square_turns); }
+
+MAEC_KERNEL_CLONES void osc_blep_sawtooth(float* out, int size, double start, double inc) { blep_kernel(out, size, start, inc, blep_sawtooth_turns); }
+
+MAEC_KERNEL_CLONES void osc_blep_sawtooth(double* out, int size, double start, double inc) { blep_kernel(out, size, start, inc, blep_sawtooth_turns); }
+
+void osc_blep_sawtooth(long double* out, int size, double start, double inc) { blep_kernel(out, size, start, inc, blep_sawtooth_turns); }
+
+MAEC_KERNEL_CLONES void osc_blep_triangle(float* out, int size, double start, double inc) { blep_kernel(out, size, start, inc, blep_triangle_turns); }
+
+MAEC_KERNEL_CLONES void osc_blep_triangle(double* out, int size, double start, double inc) { blep_kernel(out, size, start, inc, blep_triangle_turns); }
+
+void osc_blep_triangle(long double* out, int size, double start, double inc) { blep_kernel(out, size, start, inc, blep_triangle_turns); }
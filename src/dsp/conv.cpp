@@ -11,6 +11,56 @@
 
 #include "dsp/conv.hpp"
 
+#include <algorithm>
+#include <cstddef>
+
+namespace {
+
+/**
+ * @brief Multiplies (or multiply-accumulates) two spectra
+ *
+ * std::complex multiplication checks for infinities and NaNs,
+ * which compiles into a library call per bin.
+ * Spectra of audio are always finite, so we do the plain complex multiply
+ * on the real and imaginary parts ourselves,
+ * which the compiler is free to vectorize.
+ *
+ * @tparam Accumulate true to add the product to the output, false to overwrite it
+ * @param aval Pointer to first spectrum
+ * @param bval Pointer to second spectrum
+ * @param output Pointer to output spectrum
+ * @param bins Number of bins
+ */
+template <bool Accumulate>
+void spectrum_multiply(const std::complex<sample_t>* aval, const std::complex<sample_t>* bval, std::complex<sample_t>* output, int bins) {
+
+    // std::complex is laid out as an array of (real, imaginary):
+
+    const auto* adata = reinterpret_cast<const sample_t*>(aval);
+    const auto* bdata = reinterpret_cast<const sample_t*>(bval);
+    auto* odata = reinterpret_cast<sample_t*>(output);
+
+    for (int i = 0; i < 2 * bins; i += 2) {
+
+        const sample_t real = adata[i] * bdata[i] - adata[i + 1] * bdata[i + 1];
+        const sample_t imag = adata[i] * bdata[i + 1] + adata[i + 1] * bdata[i];
+
+        if constexpr (Accumulate) {
+
+            odata[i] += real;
+            odata[i + 1] += imag;
+        }
+
+        else {
+
+            odata[i] = real;
+            odata[i + 1] = imag;
+        }
+    }
+}
+
+}  // namespace
+
 int length_conv(int size1, int size2) {
 
     // Calculate and return:
@@ -33,7 +83,7 @@ BufferPointer input_conv(BufferPointer input, BufferPointer kernel) {
 
     // Pass the data along to the other function:
 
-    input_conv(input->ibegin(), input->size(), kernel->ibegin(), kernel->size(), buff->ibegin());
+    input_conv(input->data(), input->size(), kernel->data(), kernel->size(), buff->data());
 
     // Finally, return the output buffer:
 
@@ -48,9 +98,181 @@ BufferPointer output_conv(BufferPointer input, BufferPointer kernel) {
 
     // Pass the data along to other function:
 
-    input_conv(input->ibegin(), input->size(), kernel->ibegin(), kernel->size(), buff->ibegin());
+    input_conv(input->data(), input->size(), kernel->data(), kernel->size(), buff->data());
 
     // Finally, return the output buffer:
 
     return buff;
 }
+
+int OverlapSave::prepare(int ksize, int block) {
+
+    // Determine the FFT size, smallest power of two that fits block and kernel:
+
+    this->fft_size = 2;
+
+    while (this->fft_size < length_conv(block, ksize)) {
+
+        this->fft_size *= 2;
+    }
+
+    // Use up all the space we have for blocks:
+
+    this->block_size = this->fft_size - ksize + 1;
+
+    // Allocate working memory:
+
+    this->allocate();
+
+    return this->fft_size;
+}
+
+void OverlapSave::allocate() {
+
+    this->window.assign(this->fft_size, 0);
+    this->freq.assign(length_ft(this->fft_size), 0);
+    this->time.assign(this->fft_size, 0);
+    this->plan.prepare(this->fft_size);
+}
+
+void OverlapSave::share_kernel(const OverlapSave& other) {
+
+    // Copy sizes and spectrum:
+
+    this->fft_size = other.fft_size;
+    this->block_size = other.block_size;
+    this->kernel_freq = other.kernel_freq;
+
+    // Allocate our own working memory:
+
+    this->allocate();
+}
+
+void OverlapSave::reset() {
+
+    // Zero the window:
+
+    std::fill(this->window.begin(), this->window.end(), 0);
+}
+
+void OverlapSave::shift(int num) {
+
+    // Move old samples to the front:
+
+    std::copy(this->window.begin() + num, this->window.end(), this->window.begin());
+}
+
+void OverlapSave::run() {
+
+    // Transform the window:
+
+    this->plan.forward(this->window.data(), this->freq.data());
+
+    // Multiply by kernel spectrum:
+
+    spectrum_multiply<false>(this->freq.data(), this->kernel_freq->data(), this->freq.data(), static_cast<int>(this->freq.size()));
+
+    // Transform back:
+
+    this->plan.inverse(this->freq.data(), this->time.data());
+}
+
+void PartitionedConv::prepare(int ksize, int psize) {
+
+    // Determine our sizes:
+
+    this->part_size = psize;
+    this->part_num = std::max(1, (ksize + psize - 1) / psize);
+
+    // Allocate working memory:
+
+    this->allocate();
+}
+
+void PartitionedConv::allocate() {
+
+    const int fsize = 2 * this->part_size;
+    const int bins = this->part_size + 1;
+
+    this->head = 0;
+    this->fill = 0;
+    this->fdl.assign(static_cast<std::size_t>(bins) * this->part_num, 0);
+    this->window.assign(fsize, 0);
+    this->accum.assign(bins, 0);
+    this->tail.assign(bins, 0);
+    this->time.assign(fsize, 0);
+    this->plan.prepare(fsize);
+}
+
+void PartitionedConv::share_kernel(const PartitionedConv& other) {
+
+    // Copy sizes and spectra:
+
+    this->part_size = other.part_size;
+    this->part_num = other.part_num;
+    this->kernel_freq = other.kernel_freq;
+
+    // Allocate our own working memory:
+
+    this->allocate();
+}
+
+void PartitionedConv::reset() {
+
+    // Clear history:
+
+    std::fill(this->fdl.begin(), this->fdl.end(), 0);
+    std::fill(this->window.begin(), this->window.end(), 0);
+    this->head = 0;
+    this->fill = 0;
+}
+
+void PartitionedConv::run() {
+
+    const int bins = this->part_size + 1;
+
+    if (this->fill == 0) {
+
+        // New partition, move the head of the delay line, overwriting the oldest spectrum:
+
+        this->head = (this->head + this->part_num - 1) % this->part_num;
+
+        // Multiply-accumulate the older input spectra, these will not change for this partition:
+
+        std::fill(this->tail.begin(), this->tail.end(), 0);
+
+        for (int p = 1; p < this->part_num; ++p) {
+
+            const auto* in = this->fdl.data() + static_cast<std::ptrdiff_t>((this->head + p) % this->part_num) * bins;
+            const auto* kern = this->kernel_freq->data() + static_cast<std::ptrdiff_t>(p) * bins;
+
+            spectrum_multiply<true>(in, kern, this->tail.data(), bins);
+        }
+    }
+
+    auto* slot = this->fdl.data() + static_cast<std::ptrdiff_t>(this->head) * bins;
+
+    // Transform the window into the delay line, replacing any partial spectrum:
+
+    this->plan.forward(this->window.data(), slot);
+
+    // Add the newest spectrum to the older ones:
+
+    std::copy(this->tail.begin(), this->tail.end(), this->accum.begin());
+
+    spectrum_multiply<true>(slot, this->kernel_freq->data(), this->accum.data(), bins);
+
+    // Transform back:
+
+    this->plan.inverse(this->accum.data(), this->time.data());
+}
+
+void PartitionedConv::commit() {
+
+    // Shift the window, the next partition starts out silent:
+
+    std::copy(this->window.begin() + this->part_size, this->window.end(), this->window.begin());
+    std::fill(this->window.begin() + this->part_size, this->window.end(), 0);
+
+    this->fill = 0;
+}
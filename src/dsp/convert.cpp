@@ -0,0 +1,632 @@
+/**
+ * @file convert.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations of batch sample format converters
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "dsp/convert.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#include "dsp/target.hpp"
+
+namespace {
+
+/**
+ * @brief Clamps, scales and rounds a sample
+ *
+ * This is written with selects rather than library calls,
+ * so loops using it can be vectorized.
+ *
+ * @param val Value to convert
+ * @param scale Largest output value
+ * @param offset Extra value to add before rounding (dither)
+ * @return double Rounded value
+ */
+inline double quantize(double val, double scale, double offset) {
+
+    const double clamped = val < -1.0 ? -1.0 : (val > 1.0 ? 1.0 : val);
+    const double scaled = clamped * scale + offset;
+    const double limited = scaled < -scale ? -scale : (scaled > scale ? scale : scaled);
+
+    return limited + (limited >= 0 ? 0.5 : -0.5);
+}
+
+/**
+ * @brief Generates a uniform random value in [-0.5, 0.5)
+ *
+ * We use a xorshift generator, which is fast and good enough for dither.
+ *
+ * @param state State of the generator
+ * @return double Random value
+ */
+inline double uniform(uint32_t& state) {
+
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+
+    return static_cast<double>(state) / 4294967296.0 - 0.5;
+}
+
+/**
+ * @brief Generates a triangular random value in (-1, 1)
+ *
+ * We advance a xorshift generator once,
+ * and take the difference of the two halves of the value.
+ *
+ * @param state State of the generator
+ * @return double Random value
+ */
+inline double triangular(uint32_t& state) {
+
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+
+    // Both halves fit in a signed value, which is cheaper to convert:
+
+    const int32_t diff = static_cast<int32_t>(state >> 16) - static_cast<int32_t>(state & 0xFFFF);
+
+    return static_cast<double>(diff) * (1.0 / 65536.0);
+}
+
+/**
+ * @brief Assembles a value from raw bytes
+ *
+ * @tparam Bytes Number of bytes in the value
+ * @tparam Big Whether the bytes are big endian
+ * @param byts Pointer to the first byte
+ * @return uint32_t Assembled value
+ */
+template <int Bytes, bool Big>
+inline uint32_t load_bytes(const unsigned char* byts) {
+
+    uint32_t val = 0;
+
+    for (int i = 0; i < Bytes; ++i) {
+
+        val |= static_cast<uint32_t>(byts[Big ? Bytes - 1 - i : i]) << (8 * i);
+    }
+
+    return val;
+}
+
+/**
+ * @brief Splits a value into raw bytes
+ *
+ * @tparam Bytes Number of bytes in the value
+ * @tparam Big Whether the bytes should be big endian
+ * @param val Value to split
+ * @param byts Pointer to the first byte
+ */
+template <int Bytes, bool Big>
+inline void store_bytes(uint32_t val, unsigned char* byts) {
+
+    for (int i = 0; i < Bytes; ++i) {
+
+        byts[Big ? Bytes - 1 - i : i] = static_cast<unsigned char>(val >> (8 * i));
+    }
+}
+
+template <bool Big>
+inline void decode_kernel(PCMFormat format, const unsigned char* in, sample_t* out, std::size_t num) {
+
+    switch (format) {
+
+        case PCMFormat::u8:
+
+            for (std::size_t i = 0; i < num; ++i) {
+
+                out[i] = static_cast<sample_t>((static_cast<double>(in[i]) / 255.) * 2. - 1.);
+            }
+
+            break;
+
+        case PCMFormat::s16:
+
+            for (std::size_t i = 0; i < num; ++i) {
+
+                const auto val = static_cast<int16_t>(load_bytes<2, Big>(in + i * 2));
+
+                out[i] = static_cast<sample_t>(static_cast<double>(val) / 32767.0);
+            }
+
+            break;
+
+        case PCMFormat::s24:
+
+            for (std::size_t i = 0; i < num; ++i) {
+
+                // Shift up and back down to extend the sign:
+
+                const int32_t val = static_cast<int32_t>(load_bytes<3, Big>(in + i * 3) << 8) >> 8;
+
+                out[i] = static_cast<sample_t>(static_cast<double>(val) / 8388607.0);
+            }
+
+            break;
+
+        case PCMFormat::s32:
+
+            for (std::size_t i = 0; i < num; ++i) {
+
+                const auto val = static_cast<int32_t>(load_bytes<4, Big>(in + i * 4));
+
+                out[i] = static_cast<sample_t>(static_cast<double>(val) / 2147483647.0);
+            }
+
+            break;
+
+        case PCMFormat::f32:
+
+            for (std::size_t i = 0; i < num; ++i) {
+
+                out[i] = static_cast<sample_t>(std::bit_cast<float>(load_bytes<4, Big>(in + i * 4)));
+            }
+
+            break;
+
+        default:
+
+            break;
+    }
+}
+
+template <bool Big>
+inline void encode_kernel(PCMFormat format, const sample_t* in, unsigned char* out, std::size_t num) {
+
+    switch (format) {
+
+        case PCMFormat::u8:
+
+            for (std::size_t i = 0; i < num; ++i) {
+
+                const double val = static_cast<double>(in[i]);
+                const double clamped = val < -1.0 ? -1.0 : (val > 1.0 ? 1.0 : val);
+
+                out[i] = static_cast<unsigned char>(((clamped + 1.0) / 2.0) * 255.0 + 0.5);
+            }
+
+            break;
+
+        case PCMFormat::s16:
+
+            for (std::size_t i = 0; i < num; ++i) {
+
+                const auto val = static_cast<int32_t>(quantize(static_cast<double>(in[i]), 32767.0, 0.0));
+
+                store_bytes<2, Big>(static_cast<uint32_t>(val), out + i * 2);
+            }
+
+            break;
+
+        case PCMFormat::s24:
+
+            for (std::size_t i = 0; i < num; ++i) {
+
+                const auto val = static_cast<int32_t>(quantize(static_cast<double>(in[i]), 8388607.0, 0.0));
+
+                store_bytes<3, Big>(static_cast<uint32_t>(val), out + i * 3);
+            }
+
+            break;
+
+        case PCMFormat::s32:
+
+            for (std::size_t i = 0; i < num; ++i) {
+
+                const auto val = static_cast<int32_t>(quantize(static_cast<double>(in[i]), 2147483647.0, 0.0));
+
+                store_bytes<4, Big>(static_cast<uint32_t>(val), out + i * 4);
+            }
+
+            break;
+
+        case PCMFormat::f32:
+
+            for (std::size_t i = 0; i < num; ++i) {
+
+                store_bytes<4, Big>(std::bit_cast<uint32_t>(static_cast<float>(in[i])), out + i * 4);
+            }
+
+            break;
+
+        default:
+
+            break;
+    }
+}
+
+/**
+ * @brief Rounds a wide integer into 16 bits
+ *
+ * @param val Value to round
+ * @param shift Number of bits to remove
+ * @return int16_t Rounded and saturated value
+ */
+inline int16_t narrow16(int64_t val, int shift) {
+
+    const int64_t rounded = (val + (int64_t{1} << (shift - 1))) >> shift;
+
+    return static_cast<int16_t>(rounded > 32767 ? 32767 : rounded);
+}
+
+template <bool Big>
+inline void decode16_kernel(PCMFormat format, const unsigned char* in, int16_t* out, std::size_t num) {
+
+    switch (format) {
+
+        case PCMFormat::u8:
+
+            for (std::size_t i = 0; i < num; ++i) {
+
+                out[i] = static_cast<int16_t>((in[i] - 128) * 256);
+            }
+
+            break;
+
+        case PCMFormat::s16:
+
+            for (std::size_t i = 0; i < num; ++i) {
+
+                out[i] = static_cast<int16_t>(load_bytes<2, Big>(in + i * 2));
+            }
+
+            break;
+
+        case PCMFormat::s24:
+
+            for (std::size_t i = 0; i < num; ++i) {
+
+                const int32_t val = static_cast<int32_t>(load_bytes<3, Big>(in + i * 3) << 8) >> 8;
+
+                out[i] = narrow16(val, 8);
+            }
+
+            break;
+
+        case PCMFormat::s32:
+
+            for (std::size_t i = 0; i < num; ++i) {
+
+                out[i] = narrow16(static_cast<int32_t>(load_bytes<4, Big>(in + i * 4)), 16);
+            }
+
+            break;
+
+        case PCMFormat::f32:
+
+            for (std::size_t i = 0; i < num; ++i) {
+
+                out[i] = static_cast<int16_t>(quantize(std::bit_cast<float>(load_bytes<4, Big>(in + i * 4)), 32767.0, 0.0));
+            }
+
+            break;
+
+        default:
+
+            break;
+    }
+}
+
+template <bool Big>
+inline void encode16_kernel(PCMFormat format, const int16_t* in, unsigned char* out, std::size_t num) {
+
+    switch (format) {
+
+        case PCMFormat::u8:
+
+            for (std::size_t i = 0; i < num; ++i) {
+
+                const int rounded = (in[i] + 128) >> 8;
+
+                out[i] = static_cast<unsigned char>((rounded > 127 ? 127 : rounded) + 128);
+            }
+
+            break;
+
+        case PCMFormat::s16:
+
+            for (std::size_t i = 0; i < num; ++i) {
+
+                store_bytes<2, Big>(static_cast<uint32_t>(in[i]), out + i * 2);
+            }
+
+            break;
+
+        case PCMFormat::s24:
+
+            for (std::size_t i = 0; i < num; ++i) {
+
+                store_bytes<3, Big>(static_cast<uint32_t>(in[i] * 256), out + i * 3);
+            }
+
+            break;
+
+        case PCMFormat::s32:
+
+            for (std::size_t i = 0; i < num; ++i) {
+
+                store_bytes<4, Big>(static_cast<uint32_t>(in[i] * 65536), out + i * 4);
+            }
+
+            break;
+
+        case PCMFormat::f32:
+
+            for (std::size_t i = 0; i < num; ++i) {
+
+                store_bytes<4, Big>(std::bit_cast<uint32_t>(static_cast<float>(in[i] / 32767.0)), out + i * 4);
+            }
+
+            break;
+
+        default:
+
+            break;
+    }
+}
+
+}  // namespace
+
+MAEC_KERNEL_CLONES void convert_float(const sample_t* input, float* output, std::size_t num) {
+
+    for (std::size_t i = 0; i < num; ++i) {
+
+        output[i] = static_cast<float>(input[i]);
+    }
+}
+
+MAEC_KERNEL_CLONES void convert_int32(const sample_t* input, int32_t* output, std::size_t num) {
+
+    for (std::size_t i = 0; i < num; ++i) {
+
+        output[i] = static_cast<int32_t>(quantize(static_cast<double>(input[i]), 2147483647.0, 0.0));
+    }
+}
+
+MAEC_KERNEL_CLONES void convert_int16(const sample_t* input, int16_t* output, std::size_t num) {
+
+    for (std::size_t i = 0; i < num; ++i) {
+
+        output[i] = static_cast<int16_t>(quantize(static_cast<double>(input[i]), 32767.0, 0.0));
+    }
+}
+
+void convert_int16_dither(const sample_t* input, int16_t* output, std::size_t num, uint32_t& state) {
+
+    for (std::size_t i = 0; i < num; ++i) {
+
+        // Sum of two uniform values gives triangular noise:
+
+        const double noise = uniform(state) + uniform(state);
+
+        output[i] = static_cast<int16_t>(quantize(static_cast<double>(input[i]), 32767.0, noise));
+    }
+}
+
+MAEC_KERNEL_CLONES void convert_int16_dither(const sample_t* input, int16_t* output, std::size_t num, uint32_t* lanes) {
+
+    // Noise is made for a few vectors at a time, so both loops below are simple enough to vectorize:
+
+    constexpr std::size_t rounds = 8;
+    constexpr std::size_t chunk = rounds * DITHER_LANES;
+
+    double noise[chunk];
+
+    for (std::size_t i = 0; i < num; i += chunk) {
+
+        const std::size_t count = std::min(chunk, num - i);
+
+        for (std::size_t r = 0; r < rounds; ++r) {
+
+            for (int l = 0; l < DITHER_LANES; ++l) {
+
+                noise[r * DITHER_LANES + l] = triangular(lanes[l]);
+            }
+        }
+
+        for (std::size_t j = 0; j < count; ++j) {
+
+            output[i + j] = static_cast<int16_t>(quantize(static_cast<double>(input[i + j]), 32767.0, noise[j]));
+        }
+    }
+}
+
+void Dither::set_seed(uint32_t seed) {
+
+    // Spread the seed over the lanes with a multiplicative hash:
+
+    for (int l = 0; l < DITHER_LANES; ++l) {
+
+        const uint32_t val = (seed + static_cast<uint32_t>(l)) * 0x9E3779B9U;
+
+        this->lanes[l] = val != 0 ? val : 1;
+    }
+}
+
+void Dither::process(const sample_t* input, int16_t* output, std::size_t num, int channels) {
+
+    if (this->shaping == NoiseShaping::None) {
+
+        convert_int16_dither(input, output, num, this->lanes);
+
+        return;
+    }
+
+    // Ensure we have an error history for each channel:
+
+    const auto width = static_cast<std::size_t>(std::max(channels, 1));
+
+    if (this->error.size() != width * 2) {
+
+        this->error.assign(width * 2, 0.0);
+    }
+
+    const bool second = this->shaping == NoiseShaping::SecondOrder;
+
+    for (std::size_t i = 0; i < num; ++i) {
+
+        const std::size_t chan = i % width;
+
+        double& last = this->error[chan * 2];
+        double& prev = this->error[chan * 2 + 1];
+
+        // Subtract the filtered error from the scaled input:
+
+        const double clamped = std::clamp(static_cast<double>(input[i]), -1.0, 1.0) * 32767.0;
+        const double want = clamped - (second ? 2.0 * last - prev : last);
+
+        const double noisy = want + triangular(this->lanes[i % DITHER_LANES]);
+        const double rounded = std::clamp(std::round(noisy), -32767.0, 32767.0);
+
+        output[i] = static_cast<int16_t>(rounded);
+
+        // Limit the error, so clipping can't make the loop run away:
+
+        prev = last;
+        last = std::clamp(rounded - want, -2.0, 2.0);
+    }
+}
+
+MAEC_KERNEL_CLONES void convert_from_float(const float* input, sample_t* output, std::size_t num) {
+
+    for (std::size_t i = 0; i < num; ++i) {
+
+        output[i] = static_cast<sample_t>(input[i]);
+    }
+}
+
+MAEC_KERNEL_CLONES void convert_from_int32(const int32_t* input, sample_t* output, std::size_t num) {
+
+    for (std::size_t i = 0; i < num; ++i) {
+
+        output[i] = static_cast<sample_t>(static_cast<double>(input[i]) / 2147483647.0);
+    }
+}
+
+MAEC_KERNEL_CLONES void convert_from_int16(const int16_t* input, sample_t* output, std::size_t num) {
+
+    for (std::size_t i = 0; i < num; ++i) {
+
+        output[i] = static_cast<sample_t>(static_cast<double>(input[i]) / 32767.0);
+    }
+}
+
+PCMFormat pcm_format(int bits, bool floating) {
+
+    // Floats are only supported at 32 bits:
+
+    if (floating) {
+
+        return bits == 32 ? PCMFormat::f32 : PCMFormat::none;
+    }
+
+    switch (bits) {
+
+        case 8:
+            return PCMFormat::u8;
+
+        case 16:
+            return PCMFormat::s16;
+
+        case 24:
+            return PCMFormat::s24;
+
+        case 32:
+            return PCMFormat::s32;
+
+        default:
+            return PCMFormat::none;
+    }
+}
+
+std::size_t pcm_width(PCMFormat format) {
+
+    switch (format) {
+
+        case PCMFormat::u8:
+            return 1;
+
+        case PCMFormat::s16:
+            return 2;
+
+        case PCMFormat::s24:
+            return 3;
+
+        case PCMFormat::s32:
+        case PCMFormat::f32:
+            return 4;
+
+        default:
+            return 0;
+    }
+}
+
+MAEC_KERNEL_CLONES void pcm_decode(PCMFormat format, const char* input, sample_t* output, std::size_t num, bool big_endian) {
+
+    const auto* in = reinterpret_cast<const unsigned char*>(input);
+
+    if (big_endian) {
+
+        decode_kernel<true>(format, in, output, num);
+    }
+
+    else {
+
+        decode_kernel<false>(format, in, output, num);
+    }
+}
+
+MAEC_KERNEL_CLONES void pcm_encode(PCMFormat format, const sample_t* input, char* output, std::size_t num, bool big_endian) {
+
+    auto* out = reinterpret_cast<unsigned char*>(output);
+
+    if (big_endian) {
+
+        encode_kernel<true>(format, input, out, num);
+    }
+
+    else {
+
+        encode_kernel<false>(format, input, out, num);
+    }
+}
+
+MAEC_KERNEL_CLONES void pcm_decode(PCMFormat format, const char* input, int16_t* output, std::size_t num, bool big_endian) {
+
+    const auto* in = reinterpret_cast<const unsigned char*>(input);
+
+    if (big_endian) {
+
+        decode16_kernel<true>(format, in, output, num);
+    }
+
+    else {
+
+        decode16_kernel<false>(format, in, output, num);
+    }
+}
+
+MAEC_KERNEL_CLONES void pcm_encode(PCMFormat format, const int16_t* input, char* output, std::size_t num, bool big_endian) {
+
+    auto* out = reinterpret_cast<unsigned char*>(output);
+
+    if (big_endian) {
+
+        encode16_kernel<true>(format, input, out, num);
+    }
+
+    else {
+
+        encode16_kernel<false>(format, input, out, num);
+    }
+}
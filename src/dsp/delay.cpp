@@ -0,0 +1,171 @@
+/**
+ * @file delay.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations of delay line kernels
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "dsp/delay.hpp"
+
+#include "dsp/target.hpp"
+
+namespace {
+
+/**
+ * @brief Evaluates a four point Hermite spline
+ *
+ * @tparam T Type of samples
+ * @param p Pointer to the second of the four points
+ * @param t Position between the second and third points
+ * @return T Interpolated value
+ */
+template <typename T>
+inline T hermite(const T* p, T t) {
+
+    const T c1 = static_cast<T>(0.5) * (p[1] - p[-1]);
+    const T c2 = p[-1] - static_cast<T>(2.5) * p[0] + 2 * p[1] - static_cast<T>(0.5) * p[2];
+    const T c3 = static_cast<T>(0.5) * (p[2] - p[-1]) + static_cast<T>(1.5) * (p[0] - p[1]);
+
+    return ((c3 * t + c2) * t + c1) * t + p[0];
+}
+
+template <typename T>
+inline void linear_kernel(const T* __restrict in, T* __restrict out, int num, T frac) {
+
+    for (int i = 0; i < num; ++i) {
+
+        out[i] = in[i] + frac * (in[i + 1] - in[i]);
+    }
+}
+
+template <typename T>
+inline void cubic_kernel(const T* __restrict in, T* __restrict out, int num, T frac) {
+
+    for (int i = 0; i < num; ++i) {
+
+        out[i] = hermite(in + i, frac);
+    }
+}
+
+template <typename T>
+inline void allpass_kernel(const T* __restrict in, T* __restrict out, int num, T eta, T& state) {
+
+    T last = state;
+
+    for (int i = 0; i < num; ++i) {
+
+        last = eta * (in[i + 1] - last) + in[i];
+
+        out[i] = last;
+    }
+
+    state = last;
+}
+
+template <DelayInterp I, typename T>
+inline void gather_loop(const T* __restrict line, std::size_t mask, std::size_t pos, const T* __restrict delays, T* __restrict out, int num, T& state) {
+
+    // Allpass interpolation keeps its delay half a sample further back:
+
+    const T look = I == DelayInterp::Allpass ? static_cast<T>(0.5) : 0;
+
+    T last = state;
+
+    for (int i = 0; i < num; ++i) {
+
+        const T whole = std::floor(delays[i] - look);
+        const T frac = delays[i] - whole;
+
+        // Find the samples around the delayed position, span[1] is (whole) samples back:
+
+        const T* span = line + ((pos + static_cast<std::size_t>(i) - static_cast<std::size_t>(whole) - 2) & mask) + 1;
+
+        if constexpr (I == DelayInterp::None) {
+
+            out[i] = span[1];
+        }
+
+        else if constexpr (I == DelayInterp::Linear) {
+
+            out[i] = span[1] + frac * (span[0] - span[1]);
+        }
+
+        else if constexpr (I == DelayInterp::Cubic) {
+
+            out[i] = hermite(span, 1 - frac);
+        }
+
+        else {
+
+            last = ((1 - frac) / (1 + frac)) * (span[1] - last) + span[0];
+
+            out[i] = last;
+        }
+    }
+
+    state = last;
+}
+
+template <typename T>
+inline void gather_kernel(const T* line, std::size_t mask, std::size_t pos, const T* delays, T* out, int num, DelayInterp interp, T& state) {
+
+    switch (interp) {
+
+        case DelayInterp::None:
+
+            gather_loop<DelayInterp::None>(line, mask, pos, delays, out, num, state);
+
+            break;
+
+        case DelayInterp::Linear:
+
+            gather_loop<DelayInterp::Linear>(line, mask, pos, delays, out, num, state);
+
+            break;
+
+        case DelayInterp::Cubic:
+
+            gather_loop<DelayInterp::Cubic>(line, mask, pos, delays, out, num, state);
+
+            break;
+
+        case DelayInterp::Allpass:
+
+            gather_loop<DelayInterp::Allpass>(line, mask, pos, delays, out, num, state);
+
+            break;
+    }
+}
+
+}  // namespace
+
+MAEC_KERNEL_CLONES void delay_linear(const float* in, float* out, int num, float frac) { linear_kernel(in, out, num, frac); }
+
+MAEC_KERNEL_CLONES void delay_linear(const double* in, double* out, int num, double frac) { linear_kernel(in, out, num, frac); }
+
+void delay_linear(const long double* in, long double* out, int num, long double frac) { linear_kernel(in, out, num, frac); }
+
+MAEC_KERNEL_CLONES void delay_cubic(const float* in, float* out, int num, float frac) { cubic_kernel(in, out, num, frac); }
+
+MAEC_KERNEL_CLONES void delay_cubic(const double* in, double* out, int num, double frac) { cubic_kernel(in, out, num, frac); }
+
+void delay_cubic(const long double* in, long double* out, int num, long double frac) { cubic_kernel(in, out, num, frac); }
+
+void delay_allpass(const float* in, float* out, int num, float eta, float& state) { allpass_kernel(in, out, num, eta, state); }
+
+void delay_allpass(const double* in, double* out, int num, double eta, double& state) { allpass_kernel(in, out, num, eta, state); }
+
+void delay_allpass(const long double* in, long double* out, int num, long double eta, long double& state) { allpass_kernel(in, out, num, eta, state); }
+
+MAEC_KERNEL_CLONES void delay_gather(const float* line, std::size_t mask, std::size_t pos, const float* delays, float* out, int num, DelayInterp interp, float& state) {
+    gather_kernel(line, mask, pos, delays, out, num, interp, state); }
+
+MAEC_KERNEL_CLONES void delay_gather(const double* line, std::size_t mask, std::size_t pos, const double* delays, double* out, int num, DelayInterp interp, double& state) {
+    gather_kernel(line, mask, pos, delays, out, num, interp, state); }
+
+void delay_gather(const long double* line, std::size_t mask, std::size_t pos, const long double* delays, long double* out, int num, DelayInterp interp, long double& state) {
+    gather_kernel(line, mask, pos, delays, out, num, interp, state); }
@@ -0,0 +1,102 @@
+/**
+ * @file denormal.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations for avoiding denormal numbers
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "dsp/denormal.hpp"
+
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define MAEC_MXCSR 1
+#elif defined(__aarch64__)
+#define MAEC_FPCR 1
+#endif
+
+namespace {
+
+#ifdef MAEC_MXCSR
+
+/// Flush to zero and denormals are zero bits of the MXCSR register
+constexpr unsigned int MXCSR_FLUSH = 0x8040;
+
+#endif
+
+#ifdef MAEC_FPCR
+
+/// Flush to zero bit of the FPCR register
+constexpr uint64_t FPCR_FLUSH = uint64_t(1) << 24;
+
+/**
+ * @brief Reads the FPCR register
+ *
+ * @return uint64_t Value of the register
+ */
+uint64_t read_fpcr() {
+
+    uint64_t val = 0;
+
+    asm volatile("mrs %0, fpcr" : "=r"(val));
+
+    return val;
+}
+
+/**
+ * @brief Writes the FPCR register
+ *
+ * @param val Value to write
+ */
+void write_fpcr(uint64_t val) { asm volatile("msr fpcr, %0" : : "r"(val)); }
+
+#endif
+
+}  // namespace
+
+bool flush_to_zero() {
+
+#if defined(MAEC_MXCSR)
+
+    return (_mm_getcsr() & MXCSR_FLUSH) == MXCSR_FLUSH;
+
+#elif defined(MAEC_FPCR)
+
+    return (read_fpcr() & FPCR_FLUSH) != 0;
+
+#else
+
+    return false;
+
+#endif
+}
+
+bool set_flush_to_zero(bool enable) {
+
+    const bool previous = flush_to_zero();
+
+#if defined(MAEC_MXCSR)
+
+    const unsigned int csr = _mm_getcsr();
+
+    _mm_setcsr(enable ? (csr | MXCSR_FLUSH) : (csr & ~MXCSR_FLUSH));
+
+#elif defined(MAEC_FPCR)
+
+    const uint64_t fpcr = read_fpcr();
+
+    write_fpcr(enable ? (fpcr | FPCR_FLUSH) : (fpcr & ~FPCR_FLUSH));
+
+#else
+
+    static_cast<void>(enable);
+
+#endif
+
+    return previous;
+}
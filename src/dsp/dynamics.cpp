@@ -0,0 +1,142 @@
+/**
+ * @file dynamics.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations of dynamics kernels
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "dsp/dynamics.hpp"
+
+#include <limits>
+
+#include "dsp/fastmath.hpp"
+#include "dsp/target.hpp"
+
+namespace {
+
+/// Decibels for each doubling of magnitude, 20 * log10(2)
+constexpr double DB_PER_OCTAVE = 6.020599913279624;
+
+template <typename T>
+inline void peak_kernel(const T* __restrict in, T* __restrict level, int num) {
+
+    for (int i = 0; i < num; ++i) {
+
+        const T mag = std::fabs(in[i]);
+
+        level[i] = mag > level[i] ? mag : level[i];
+    }
+}
+
+template <typename T>
+inline void square_kernel(const T* __restrict in, T* __restrict level, int num, T scale) {
+
+    for (int i = 0; i < num; ++i) {
+
+        level[i] += in[i] * in[i] * scale;
+    }
+}
+
+template <typename T>
+inline void reduction_kernel(const T* __restrict level, T* __restrict out, int num, const DynCurve& curve, T scale) {
+
+    // Determine the shape of the curve:
+
+    const T threshold = static_cast<T>(curve.threshold);
+    const T slope = static_cast<T>(curve.ratio > 1 ? 1 / curve.ratio - 1 : 0);
+    const T knee = static_cast<T>(std::max(curve.knee, 0.0));
+    const T half = knee / 2;
+    const T bend = knee > 0 ? slope / (2 * knee) : 0;
+
+    // Levels this small are silence:
+
+    const T floor = static_cast<T>(1e-20);
+
+    for (int i = 0; i < num; ++i) {
+
+        const T db = scale * fast_log2<MathAccuracy::Medium>(level[i] > floor ? level[i] : floor);
+        const T over = db - threshold;
+        const T inside = over + half;
+
+        out[i] = over >= half ? slope * over : (inside > 0 ? bend * inside * inside : 0);
+    }
+}
+
+template <typename T>
+inline void smooth_kernel(T* data, int num, T attack, T release, T& state) {
+
+    T last = state;
+
+    for (int i = 0; i < num; ++i) {
+
+        const T target = data[i];
+
+        last = target + (target < last ? attack : release) * (last - target);
+
+        data[i] = last;
+    }
+
+    state = last;
+}
+
+template <typename T>
+inline void gain_kernel(const T* __restrict db, T* __restrict out, int num, T makeup) {
+
+    const T scale = static_cast<T>(1 / DB_PER_OCTAVE);
+
+    for (int i = 0; i < num; ++i) {
+
+        out[i] = fast_exp2<MathAccuracy::Medium>((db[i] + makeup) * scale);
+    }
+}
+
+template <typename T>
+inline void apply_kernel(T* __restrict data, const T* __restrict gain, int num) {
+
+    for (int i = 0; i < num; ++i) {
+
+        data[i] *= gain[i];
+    }
+}
+
+}  // namespace
+
+MAEC_KERNEL_CLONES void dyn_peak(const float* in, float* level, int num) { peak_kernel(in, level, num); }
+
+MAEC_KERNEL_CLONES void dyn_peak(const double* in, double* level, int num) { peak_kernel(in, level, num); }
+
+void dyn_peak(const long double* in, long double* level, int num) { peak_kernel(in, level, num); }
+
+MAEC_KERNEL_CLONES void dyn_square(const float* in, float* level, int num, float scale) { square_kernel(in, level, num, scale); }
+
+MAEC_KERNEL_CLONES void dyn_square(const double* in, double* level, int num, double scale) { square_kernel(in, level, num, scale); }
+
+void dyn_square(const long double* in, long double* level, int num, long double scale) { square_kernel(in, level, num, scale); }
+
+MAEC_KERNEL_CLONES void dyn_reduction(const float* level, float* out, int num, const DynCurve& curve, float scale) { reduction_kernel(level, out, num, curve, scale); }
+
+MAEC_KERNEL_CLONES void dyn_reduction(const double* level, double* out, int num, const DynCurve& curve, double scale) { reduction_kernel(level, out, num, curve, scale); }
+
+void dyn_reduction(const long double* level, long double* out, int num, const DynCurve& curve, long double scale) { reduction_kernel(level, out, num, curve, scale); }
+
+void dyn_smooth(float* data, int num, float attack, float release, float& state) { smooth_kernel(data, num, attack, release, state); }
+
+void dyn_smooth(double* data, int num, double attack, double release, double& state) { smooth_kernel(data, num, attack, release, state); }
+
+void dyn_smooth(long double* data, int num, long double attack, long double release, long double& state) { smooth_kernel(data, num, attack, release, state); }
+
+MAEC_KERNEL_CLONES void dyn_gain(const float* db, float* out, int num, float makeup) { gain_kernel(db, out, num, makeup); }
+
+MAEC_KERNEL_CLONES void dyn_gain(const double* db, double* out, int num, double makeup) { gain_kernel(db, out, num, makeup); }
+
+void dyn_gain(const long double* db, long double* out, int num, long double makeup) { gain_kernel(db, out, num, makeup); }
+
+MAEC_KERNEL_CLONES void dyn_apply(float* data, const float* gain, int num) { apply_kernel(data, gain, num); }
+
+MAEC_KERNEL_CLONES void dyn_apply(double* data, const double* gain, int num) { apply_kernel(data, gain, num); }
+
+void dyn_apply(long double* data, const long double* gain, int num) { apply_kernel(data, gain, num); }
@@ -0,0 +1,426 @@
+/**
+ * @file fft_backend.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations of the FFT backend
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "dsp/fft_backend.hpp"
+
+#ifdef FFTW
+
+#include <fftw3.h>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace {
+
+/// Kinds of plans we cache
+enum class PlanKind { Complex, RealForward, RealInverse };
+
+/**
+ * @brief Maps a precision onto the matching FFTW functions
+ *
+ * FFTW provides a separate library for each precision,
+ * with the same functions under a different prefix.
+ *
+ * @tparam T Floating point type to work with
+ */
+template <typename T>
+struct FFTWApi;
+
+template <>
+struct FFTWApi<float> {
+
+    using plan = fftwf_plan;
+    using complex = fftwf_complex;
+
+    static complex* alloc(int size) { return fftwf_alloc_complex(size); }
+    static void free(complex* data) { fftwf_free(data); }
+    static void destroy(plan nplan) { fftwf_destroy_plan(nplan); }
+
+    static plan dft(int size, complex* input, complex* output, int sign, unsigned flags) { return fftwf_plan_dft_1d(size, input, output, sign, flags); }
+    static plan r2c(int size, float* input, complex* output, unsigned flags) { return fftwf_plan_dft_r2c_1d(size, input, output, flags); }
+    static plan c2r(int size, complex* input, float* output, unsigned flags) { return fftwf_plan_dft_c2r_1d(size, input, output, flags); }
+
+    static void execute_dft(plan nplan, complex* input, complex* output) { fftwf_execute_dft(nplan, input, output); }
+    static void execute_r2c(plan nplan, float* input, complex* output) { fftwf_execute_dft_r2c(nplan, input, output); }
+    static void execute_c2r(plan nplan, complex* input, float* output) { fftwf_execute_dft_c2r(nplan, input, output); }
+
+    static bool import_wisdom(const char* path) { return fftwf_import_wisdom_from_filename(path) != 0; }
+    static bool export_wisdom(const char* path) { return fftwf_export_wisdom_to_filename(path) != 0; }
+};
+
+template <>
+struct FFTWApi<double> {
+
+    using plan = fftw_plan;
+    using complex = fftw_complex;
+
+    static complex* alloc(int size) { return fftw_alloc_complex(size); }
+    static void free(complex* data) { fftw_free(data); }
+    static void destroy(plan nplan) { fftw_destroy_plan(nplan); }
+
+    static plan dft(int size, complex* input, complex* output, int sign, unsigned flags) { return fftw_plan_dft_1d(size, input, output, sign, flags); }
+    static plan r2c(int size, double* input, complex* output, unsigned flags) { return fftw_plan_dft_r2c_1d(size, input, output, flags); }
+    static plan c2r(int size, complex* input, double* output, unsigned flags) { return fftw_plan_dft_c2r_1d(size, input, output, flags); }
+
+    static void execute_dft(plan nplan, complex* input, complex* output) { fftw_execute_dft(nplan, input, output); }
+    static void execute_r2c(plan nplan, double* input, complex* output) { fftw_execute_dft_r2c(nplan, input, output); }
+    static void execute_c2r(plan nplan, complex* input, double* output) { fftw_execute_dft_c2r(nplan, input, output); }
+
+    static bool import_wisdom(const char* path) { return fftw_import_wisdom_from_filename(path) != 0; }
+    static bool export_wisdom(const char* path) { return fftw_export_wisdom_to_filename(path) != 0; }
+};
+
+template <>
+struct FFTWApi<long double> {
+
+    using plan = fftwl_plan;
+    using complex = fftwl_complex;
+
+    static complex* alloc(int size) { return fftwl_alloc_complex(size); }
+    static void free(complex* data) { fftwl_free(data); }
+    static void destroy(plan nplan) { fftwl_destroy_plan(nplan); }
+
+    static plan dft(int size, complex* input, complex* output, int sign, unsigned flags) { return fftwl_plan_dft_1d(size, input, output, sign, flags); }
+    static plan r2c(int size, long double* input, complex* output, unsigned flags) { return fftwl_plan_dft_r2c_1d(size, input, output, flags); }
+    static plan c2r(int size, complex* input, long double* output, unsigned flags) { return fftwl_plan_dft_c2r_1d(size, input, output, flags); }
+
+    static void execute_dft(plan nplan, complex* input, complex* output) { fftwl_execute_dft(nplan, input, output); }
+    static void execute_r2c(plan nplan, long double* input, complex* output) { fftwl_execute_dft_r2c(nplan, input, output); }
+    static void execute_c2r(plan nplan, complex* input, long double* output) { fftwl_execute_dft_c2r(nplan, input, output); }
+
+    static bool import_wisdom(const char* path) { return fftwl_import_wisdom_from_filename(path) != 0; }
+    static bool export_wisdom(const char* path) { return fftwl_export_wisdom_to_filename(path) != 0; }
+};
+
+/**
+ * @brief Process-wide cache of FFTW plans
+ *
+ * The FFTW planner is not thread safe,
+ * so all access is done under a lock.
+ * Executing a plan is thread safe when using new-array execution,
+ * so the plans may be shared freely once created.
+ * Each precision has its own planner, and its own cache.
+ *
+ * @tparam T Floating point type to work with
+ */
+template <typename T>
+struct PlanCache {
+
+    using Plan = typename FFTWApi<T>::plan;
+    using Complex = typename FFTWApi<T>::complex;
+
+    /// Lock guarding the planner
+    std::mutex lock;
+
+    /// Plans keyed by (kind, size, sign, in place)
+    std::map<std::tuple<PlanKind, int, int, bool>, Plan> plans;
+
+    ~PlanCache() { this->clear(); }
+
+    /**
+     * @brief Gets a plan, creating it if necessary
+     *
+     * @param kind Kind of transform
+     * @param size Size of the transform
+     * @param sign FFTW_FORWARD or FFTW_BACKWARD
+     * @param inplace true if input and output are the same
+     * @return Plan Plan to use
+     */
+    Plan get(PlanKind kind, int size, int sign, bool inplace) {
+
+        const std::lock_guard<std::mutex> guard(this->lock);
+
+        const auto key = std::make_tuple(kind, size, sign, inplace);
+
+        auto iter = this->plans.find(key);
+
+        if (iter != this->plans.end()) {
+
+            return iter->second;
+        }
+
+        // Create temporary arrays for planning, as measuring destroys them.
+        // These are large enough to hold a complex signal of the full size:
+
+        Complex* input = FFTWApi<T>::alloc(size);
+        Complex* output = inplace ? input : FFTWApi<T>::alloc(size);
+
+        // Plan with unaligned flag, as we execute on arrays we did not allocate:
+
+        const unsigned flags = FFTW_MEASURE | FFTW_UNALIGNED;
+
+        Plan nplan = nullptr;
+
+        switch (kind) {
+
+            case PlanKind::Complex:
+                nplan = FFTWApi<T>::dft(size, input, output, sign, flags);
+                break;
+
+            case PlanKind::RealForward:
+                nplan = FFTWApi<T>::r2c(size, reinterpret_cast<T*>(input), output, flags);
+                break;
+
+            case PlanKind::RealInverse:
+                nplan = FFTWApi<T>::c2r(size, input, reinterpret_cast<T*>(output), flags);
+                break;
+        }
+
+        if (!inplace) {
+
+            FFTWApi<T>::free(output);
+        }
+
+        FFTWApi<T>::free(input);
+
+        this->plans.emplace(key, nplan);
+
+        return nplan;
+    }
+
+    /**
+     * @brief Destroys all plans
+     *
+     */
+    void clear() {
+
+        const std::lock_guard<std::mutex> guard(this->lock);
+
+        for (auto& [key, nplan] : this->plans) {
+
+            FFTWApi<T>::destroy(nplan);
+        }
+
+        this->plans.clear();
+    }
+};
+
+/**
+ * @brief Gets the global plan cache of a precision
+ *
+ * @tparam T Floating point type to work with
+ * @return PlanCache<T>& Global cache
+ */
+template <typename T>
+PlanCache<T>& plan_cache() {
+
+    static PlanCache<T> cache;
+
+    return cache;
+}
+
+/**
+ * @brief Reinterprets complex values as FFTW complex values
+ *
+ * std::complex is guaranteed to have the same layout as FFTW complex types.
+ *
+ * @tparam T Floating point type to work with
+ * @param data Pointer to complex values
+ * @return FFTWApi<T>::complex* Pointer to FFTW complex values
+ */
+template <typename T>
+typename FFTWApi<T>::complex* as_fftw(const std::complex<T>* data) {
+
+    return reinterpret_cast<typename FFTWApi<T>::complex*>(const_cast<std::complex<T>*>(data));
+}
+
+}  // namespace
+
+template <typename T>
+void FFTBackend<T>::prepare(int size) {
+
+    this->fsize = size;
+
+    // Grab each plan we may need:
+
+    auto& cache = plan_cache<T>();
+
+    this->plans[0] = cache.get(PlanKind::Complex, size, FFTW_FORWARD, false);
+    this->plans[1] = cache.get(PlanKind::Complex, size, FFTW_FORWARD, true);
+    this->plans[2] = cache.get(PlanKind::Complex, size, FFTW_BACKWARD, false);
+    this->plans[3] = cache.get(PlanKind::Complex, size, FFTW_BACKWARD, true);
+}
+
+template <typename T>
+void FFTBackend<T>::execute(const std::complex<T>* input, std::complex<T>* output, bool inverse) {
+
+    // Determine the plan to use:
+
+    const bool inplace = input == output;
+
+    auto nplan = static_cast<typename FFTWApi<T>::plan>(this->plans[(inverse ? 2 : 0) + (inplace ? 1 : 0)]);
+
+    // FFTW does not modify the input of out of place complex transforms:
+
+    FFTWApi<T>::execute_dft(nplan, as_fftw<T>(input), as_fftw<T>(output));
+}
+
+template <typename T>
+void FFTBackend<T>::forward(const std::complex<T>* input, std::complex<T>* output) {
+
+    this->execute(input, output, false);
+}
+
+template <typename T>
+void FFTBackend<T>::inverse(const std::complex<T>* input, std::complex<T>* output) {
+
+    this->execute(input, output, true);
+
+    // FFTW does not normalize, so do it here:
+
+    const T norm = T(1) / static_cast<T>(this->fsize);
+
+    std::transform(output, output + this->fsize, output, [norm](const std::complex<T>& val) { return val * norm; });
+}
+
+template <typename T>
+const char* FFTBackend<T>::name() { return "fftw"; }
+
+template <typename T>
+bool FFTBackend<T>::import_wisdom(const std::string& path) {
+
+    const std::lock_guard<std::mutex> guard(plan_cache<T>().lock);
+
+    return FFTWApi<T>::import_wisdom(path.c_str());
+}
+
+template <typename T>
+bool FFTBackend<T>::export_wisdom(const std::string& path) {
+
+    const std::lock_guard<std::mutex> guard(plan_cache<T>().lock);
+
+    return FFTWApi<T>::export_wisdom(path.c_str());
+}
+
+template <typename T>
+void FFTBackend<T>::clear_cache() { plan_cache<T>().clear(); }
+
+template <typename T>
+std::size_t FFTBackend<T>::bytes() const { return 0; }
+
+template <typename T>
+void RealFFTBackend<T>::prepare(int size) {
+
+    this->fsize = size;
+
+    // Grab each plan we may need:
+
+    auto& cache = plan_cache<T>();
+
+    this->plans[0] = cache.get(PlanKind::RealForward, size, FFTW_FORWARD, false);
+    this->plans[1] = cache.get(PlanKind::RealForward, size, FFTW_FORWARD, true);
+    this->plans[2] = cache.get(PlanKind::RealInverse, size, FFTW_BACKWARD, false);
+
+    this->scratch.assign(size / 2 + 1, 0);
+}
+
+template <typename T>
+void RealFFTBackend<T>::forward(const T* input, std::complex<T>* output) {
+
+    // Determine the plan to use:
+
+    const bool inplace = static_cast<const void*>(input) == static_cast<const void*>(output);
+
+    auto nplan = static_cast<typename FFTWApi<T>::plan>(this->plans[inplace ? 1 : 0]);
+
+    FFTWApi<T>::execute_r2c(nplan, const_cast<T*>(input), as_fftw<T>(output));
+}
+
+template <typename T>
+void RealFFTBackend<T>::inverse(const std::complex<T>* input, T* output) {
+
+    // Copy the spectrum, as the inverse destroys its input:
+
+    std::copy_n(input, this->scratch.size(), this->scratch.begin());
+
+    FFTWApi<T>::execute_c2r(static_cast<typename FFTWApi<T>::plan>(this->plans[2]), as_fftw<T>(this->scratch.data()), output);
+
+    // FFTW does not normalize, so do it here:
+
+    const T norm = T(1) / static_cast<T>(this->fsize);
+
+    std::transform(output, output + this->fsize, output, [norm](T val) { return val * norm; });
+}
+
+template <typename T>
+std::size_t RealFFTBackend<T>::bytes() const { return heap_bytes(this->scratch); }
+
+#else
+
+template <typename T>
+void FFTBackend<T>::prepare(int size) {
+
+    this->fsize = size;
+
+    this->plan.prepare(size);
+}
+
+template <typename T>
+void FFTBackend<T>::forward(const std::complex<T>* input, std::complex<T>* output) {
+
+    this->plan.forward(input, output);
+}
+
+template <typename T>
+void FFTBackend<T>::inverse(const std::complex<T>* input, std::complex<T>* output) {
+
+    this->plan.inverse(input, output);
+}
+
+template <typename T>
+const char* FFTBackend<T>::name() { return "maec"; }
+
+template <typename T>
+bool FFTBackend<T>::import_wisdom(const std::string& /*path*/) { return false; }
+
+template <typename T>
+bool FFTBackend<T>::export_wisdom(const std::string& /*path*/) { return false; }
+
+template <typename T>
+void FFTBackend<T>::clear_cache() {}
+
+template <typename T>
+std::size_t FFTBackend<T>::bytes() const { return this->plan.bytes(); }
+
+template <typename T>
+void RealFFTBackend<T>::prepare(int size) {
+
+    this->fsize = size;
+
+    this->plan.prepare(size);
+}
+
+template <typename T>
+void RealFFTBackend<T>::forward(const T* input, std::complex<T>* output) {
+
+    this->plan.forward(input, output);
+}
+
+template <typename T>
+void RealFFTBackend<T>::inverse(const std::complex<T>* input, T* output) {
+
+    this->plan.inverse(input, output);
+}
+
+template <typename T>
+std::size_t RealFFTBackend<T>::bytes() const { return this->plan.bytes(); }
+
+#endif
+
+template class FFTBackend<float>;
+template class FFTBackend<double>;
+template class FFTBackend<long double>;
+
+template class RealFFTBackend<float>;
+template class RealFFTBackend<double>;
+template class RealFFTBackend<long double>;
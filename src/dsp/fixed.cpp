@@ -0,0 +1,307 @@
+/**
+ * @file fixed.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations of fixed point kernels
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "dsp/fixed.hpp"
+
+#include "dsp/target.hpp"
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+template <typename T>
+inline T saturate(int64_t val) {
+
+    if constexpr (sizeof(T) == sizeof(q15_t)) {
+
+        return q15_saturate(val);
+    }
+
+    else {
+
+        return q31_saturate(val);
+    }
+}
+
+template <typename T>
+inline T multiply(T one, T two) {
+
+    if constexpr (sizeof(T) == sizeof(q15_t)) {
+
+        return q15_mul(one, two);
+    }
+
+    else {
+
+        return q31_mul(one, two);
+    }
+}
+
+template <typename T>
+inline void gain_kernel(T* __restrict data, int start, int size, T gain, int shift) {
+
+    for (int i = start; i < size; ++i) {
+
+        data[i] = saturate<T>(static_cast<int64_t>(multiply(data[i], gain)) * (int64_t{1} << shift));
+    }
+}
+
+template <typename T>
+inline void add_kernel(T* __restrict out, const T* __restrict in, int start, int size) {
+
+    for (int i = start; i < size; ++i) {
+
+        out[i] = saturate<T>(static_cast<int64_t>(out[i]) + in[i]);
+    }
+}
+
+template <typename T>
+inline void add_gain_kernel(T* __restrict out, const T* __restrict in, int start, int size, T gain) {
+
+    for (int i = start; i < size; ++i) {
+
+        out[i] = saturate<T>(static_cast<int64_t>(out[i]) + multiply(in[i], gain));
+    }
+}
+
+}  // namespace
+
+#if defined(__ARM_NEON)
+
+// The NEON versions handle full vectors,
+// and leave the tail to the portable loops.
+// vqrdmulh rounds and saturates exactly like q15_mul() and q31_mul().
+
+void fixed_gain(q15_t* data, int size, q15_t gain, int shift) {
+
+    const int16x8_t vgain = vdupq_n_s16(gain);
+    const int16x8_t vshift = vdupq_n_s16(static_cast<int16_t>(shift));
+
+    int i = 0;
+
+    for (; i + 8 <= size; i += 8) {
+
+        vst1q_s16(data + i, vqshlq_s16(vqrdmulhq_s16(vld1q_s16(data + i), vgain), vshift));
+    }
+
+    gain_kernel(data, i, size, gain, shift);
+}
+
+void fixed_gain(q31_t* data, int size, q31_t gain, int shift) {
+
+    const int32x4_t vgain = vdupq_n_s32(gain);
+    const int32x4_t vshift = vdupq_n_s32(shift);
+
+    int i = 0;
+
+    for (; i + 4 <= size; i += 4) {
+
+        vst1q_s32(data + i, vqshlq_s32(vqrdmulhq_s32(vld1q_s32(data + i), vgain), vshift));
+    }
+
+    gain_kernel(data, i, size, gain, shift);
+}
+
+void fixed_mix_add(q15_t* out, const q15_t* in, int size) {
+
+    int i = 0;
+
+    for (; i + 8 <= size; i += 8) {
+
+        vst1q_s16(out + i, vqaddq_s16(vld1q_s16(out + i), vld1q_s16(in + i)));
+    }
+
+    add_kernel(out, in, i, size);
+}
+
+void fixed_mix_add(q31_t* out, const q31_t* in, int size) {
+
+    int i = 0;
+
+    for (; i + 4 <= size; i += 4) {
+
+        vst1q_s32(out + i, vqaddq_s32(vld1q_s32(out + i), vld1q_s32(in + i)));
+    }
+
+    add_kernel(out, in, i, size);
+}
+
+void fixed_mix_add(q15_t* out, const q15_t* in, int size, q15_t gain) {
+
+    const int16x8_t vgain = vdupq_n_s16(gain);
+
+    int i = 0;
+
+    for (; i + 8 <= size; i += 8) {
+
+        vst1q_s16(out + i, vqaddq_s16(vld1q_s16(out + i), vqrdmulhq_s16(vld1q_s16(in + i), vgain)));
+    }
+
+    add_gain_kernel(out, in, i, size, gain);
+}
+
+void fixed_mix_add(q31_t* out, const q31_t* in, int size, q31_t gain) {
+
+    const int32x4_t vgain = vdupq_n_s32(gain);
+
+    int i = 0;
+
+    for (; i + 4 <= size; i += 4) {
+
+        vst1q_s32(out + i, vqaddq_s32(vld1q_s32(out + i), vqrdmulhq_s32(vld1q_s32(in + i), vgain)));
+    }
+
+    add_gain_kernel(out, in, i, size, gain);
+}
+
+int64_t fixed_dot(const q15_t* one, const q15_t* two, int size) {
+
+    // Widen each product to 32 bits, and pairwise accumulate into 64 bits:
+
+    int64x2_t acc = vdupq_n_s64(0);
+
+    int i = 0;
+
+    for (; i + 8 <= size; i += 8) {
+
+        const int16x8_t first = vld1q_s16(one + i);
+        const int16x8_t second = vld1q_s16(two + i);
+
+        acc = vpadalq_s32(acc, vmull_s16(vget_low_s16(first), vget_low_s16(second)));
+        acc = vpadalq_s32(acc, vmull_s16(vget_high_s16(first), vget_high_s16(second)));
+    }
+
+    int64_t sum = vgetq_lane_s64(acc, 0) + vgetq_lane_s64(acc, 1);
+
+    for (; i < size; ++i) {
+
+        sum += static_cast<int32_t>(one[i]) * two[i];
+    }
+
+    return sum;
+}
+
+#else
+
+MAEC_KERNEL_CLONES void fixed_gain(q15_t* data, int size, q15_t gain, int shift) { gain_kernel(data, 0, size, gain, shift); }
+
+MAEC_KERNEL_CLONES void fixed_gain(q31_t* data, int size, q31_t gain, int shift) { gain_kernel(data, 0, size, gain, shift); }
+
+MAEC_KERNEL_CLONES void fixed_mix_add(q15_t* out, const q15_t* in, int size) { add_kernel(out, in, 0, size); }
+
+MAEC_KERNEL_CLONES void fixed_mix_add(q31_t* out, const q31_t* in, int size) { add_kernel(out, in, 0, size); }
+
+MAEC_KERNEL_CLONES void fixed_mix_add(q15_t* out, const q15_t* in, int size, q15_t gain) { add_gain_kernel(out, in, 0, size, gain); }
+
+MAEC_KERNEL_CLONES void fixed_mix_add(q31_t* out, const q31_t* in, int size, q31_t gain) { add_gain_kernel(out, in, 0, size, gain); }
+
+MAEC_KERNEL_CLONES int64_t fixed_dot(const q15_t* one, const q15_t* two, int size) {
+
+    int64_t sum = 0;
+
+    for (int i = 0; i < size; ++i) {
+
+        sum += static_cast<int32_t>(one[i]) * two[i];
+    }
+
+    return sum;
+}
+
+#endif
+
+FixedBiquad fixed_biquad(const BiquadCoefficients<double>& coeff) {
+
+    const double scale = 1 << FIXED_BIQUAD_BITS;
+
+    FixedBiquad out;
+
+    out.b0 = q15_saturate(std::llround(coeff.b0 * scale));
+    out.b1 = q15_saturate(std::llround(coeff.b1 * scale));
+    out.b2 = q15_saturate(std::llround(coeff.b2 * scale));
+    out.a1 = q15_saturate(std::llround(coeff.a1 * scale));
+    out.a2 = q15_saturate(std::llround(coeff.a2 * scale));
+
+    return out;
+}
+
+void fixed_biquad_process(const FixedBiquad& coeff, int32_t* state, const q15_t* input, int size, q15_t* output) {
+
+    const int64_t b0 = coeff.b0, b1 = coeff.b1, b2 = coeff.b2, a1 = coeff.a1, a2 = coeff.a2;
+
+    int64_t x1 = state[0], x2 = state[1], y1 = state[2], y2 = state[3];
+
+    constexpr int64_t half = int64_t{1} << (FIXED_BIQUAD_BITS - 1);
+
+    for (int i = 0; i < size; ++i) {
+
+        const int64_t x0 = input[i];
+
+        const int64_t acc = b0 * x0 + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+
+        const q15_t y0 = q15_saturate((acc + half) >> FIXED_BIQUAD_BITS);
+
+        output[i] = y0;
+
+        x2 = x1;
+        x1 = x0;
+        y2 = y1;
+        y1 = y0;
+    }
+
+    state[0] = static_cast<int32_t>(x1);
+    state[1] = static_cast<int32_t>(x2);
+    state[2] = static_cast<int32_t>(y1);
+    state[3] = static_cast<int32_t>(y2);
+}
+
+void FixedFIR::set_kernel(const std::vector<q15_t>& kernel, int block) {
+
+    this->rkernel.assign(kernel.rbegin(), kernel.rend());
+
+    this->window.assign(std::max(this->size() - 1, 0) + std::max(block, 0), 0);
+}
+
+void FixedFIR::process(const q15_t* in, int size, q15_t* out) {
+
+    const int ksize = this->size();
+    const int hist = std::max(ksize - 1, 0);
+
+    // Ensure the window is large enough:
+
+    if (static_cast<int>(this->window.size()) < hist + size) {
+
+        this->window.resize(hist + size);
+    }
+
+    // Copy the block after the history:
+
+    std::copy_n(in, size, this->window.begin() + hist);
+
+    // Compute each output sample, rounding the Q30 sums back to Q15:
+
+    const q15_t* wdata = this->window.data();
+    const q15_t* kdata = this->rkernel.data();
+
+    constexpr int64_t half = int64_t{1} << 14;
+
+    for (int i = 0; i < size; ++i) {
+
+        out[i] = q15_saturate((fixed_dot(wdata + i, kdata, ksize) + half) >> 15);
+    }
+
+    // Carry the end of the window over as history:
+
+    std::copy(this->window.begin() + size, this->window.begin() + size + hist, this->window.begin());
+}
+
+void FixedFIR::reset() { std::fill(this->window.begin(), this->window.end(), 0); }
@@ -0,0 +1,91 @@
+/**
+ * @file goertzel.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations of Goertzel resonators
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "dsp/goertzel.hpp"
+
+#include <cmath>
+#include <numbers>
+
+#include "dsp/target.hpp"
+
+namespace {
+
+template <typename T>
+inline void goertzel_kernel(const double* __restrict coeff, double* __restrict first, double* __restrict second, int bins, const T* in, int num, std::ptrdiff_t stride) {
+
+    for (int i = 0; i < num; ++i) {
+
+        const auto val = static_cast<double>(in[i * stride]);
+
+        // Every resonator sees the same sample, so this loop vectorizes:
+
+        for (int k = 0; k < bins; ++k) {
+
+            const double next = val + coeff[k] * first[k] - second[k];
+
+            second[k] = first[k];
+            first[k] = next;
+        }
+    }
+}
+
+}  // namespace
+
+MAEC_KERNEL_CLONES void goertzel_run(const double* coeff, double* first, double* second, int bins, const float* in, int num, std::ptrdiff_t stride) { goertzel_kernel(coeff, first, second, bins, in, num, stride); }
+
+MAEC_KERNEL_CLONES void goertzel_run(const double* coeff, double* first, double* second, int bins, const double* in, int num, std::ptrdiff_t stride) { goertzel_kernel(coeff, first, second, bins, in, num, stride); }
+
+void goertzel_run(const double* coeff, double* first, double* second, int bins, const long double* in, int num, std::ptrdiff_t stride) { goertzel_kernel(coeff, first, second, bins, in, num, stride); }
+
+void GoertzelBank::configure(const std::vector<double>& freqs, double rate, int window) {
+
+    this->window = std::max(window, 1);
+
+    this->coeff.resize(freqs.size());
+
+    for (std::size_t k = 0; k < freqs.size(); ++k) {
+
+        this->coeff[k] = 2.0 * std::cos(2.0 * std::numbers::pi * freqs[k] / rate);
+    }
+
+    this->first.assign(freqs.size(), 0);
+    this->second.assign(freqs.size(), 0);
+    this->magnitude.assign(freqs.size(), 0);
+
+    this->filled = 0;
+}
+
+void GoertzelBank::reset() {
+
+    std::ranges::fill(this->first, 0);
+    std::ranges::fill(this->second, 0);
+
+    this->filled = 0;
+}
+
+void GoertzelBank::finish() {
+
+    // Scale so a full scale sine has a magnitude of 1:
+
+    const double scale = 2.0 / this->window;
+
+    for (int k = 0; k < this->bins(); ++k) {
+
+        const double one = this->first[k];
+        const double two = this->second[k];
+
+        const double power = one * one + two * two - this->coeff[k] * one * two;
+
+        this->magnitude[k] = std::sqrt(std::max(power, 0.0)) * scale;
+    }
+
+    this->reset();
+}
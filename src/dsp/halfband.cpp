@@ -0,0 +1,99 @@
+/**
+ * @file halfband.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations of half-band filter kernels
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "dsp/halfband.hpp"
+
+#include <cstddef>
+
+#include "dsp/target.hpp"
+
+namespace {
+
+/// Number of partial sums kept when applying the side taps
+constexpr int halfband_lanes = 8;
+
+/**
+ * @brief Applies the side taps to a window
+ *
+ * Partial sums are kept in lanes so this vectorizes.
+ *
+ * @tparam T Type of samples
+ * @param x Pointer to the window
+ * @param coeffs Pointer to the side taps
+ * @param taps Number of side taps
+ * @return T Dot product of the window and side taps
+ */
+template <typename T>
+inline T halfband_dot(const T* x, const T* coeffs, int taps) {
+
+    T acc[halfband_lanes] = {};
+
+    int i = 0;
+
+    for (; i + halfband_lanes <= taps; i += halfband_lanes) {
+
+        for (int k = 0; k < halfband_lanes; ++k) {
+
+            acc[k] += coeffs[i + k] * x[i + k];
+        }
+    }
+
+    for (; i < taps; ++i) {
+
+        acc[0] += coeffs[i] * x[i];
+    }
+
+    T sum = 0;
+
+    for (int k = 0; k < halfband_lanes; ++k) {
+
+        sum += acc[k];
+    }
+
+    return sum;
+}
+
+template <typename T>
+inline void interpolate_kernel(const T* input, T* output, int num, const T* coeffs, int taps) {
+
+    // The delay branch lines up with the center tap:
+
+    const T* center = input + taps / 2;
+
+    for (int n = 0; n < num; ++n) {
+
+        output[2 * n] = T(2) * halfband_dot(input + n, coeffs, taps);
+        output[2 * n + 1] = center[n];
+    }
+}
+
+template <typename T>
+inline void decimate_kernel(const T* even, const T* odd, T* output, int num, const T* coeffs, int taps) {
+
+    for (int n = 0; n < num; ++n) {
+
+        output[n] = halfband_dot(even + n, coeffs, taps) + T(0.5) * odd[n];
+    }
+}
+
+}  // namespace
+
+MAEC_KERNEL_CLONES void halfband_interpolate(const float* input, float* output, int num, const float* coeffs, int taps) { interpolate_kernel(input, output, num, coeffs, taps); }
+
+MAEC_KERNEL_CLONES void halfband_interpolate(const double* input, double* output, int num, const double* coeffs, int taps) { interpolate_kernel(input, output, num, coeffs, taps); }
+
+void halfband_interpolate(const long double* input, long double* output, int num, const long double* coeffs, int taps) { interpolate_kernel(input, output, num, coeffs, taps); }
+
+MAEC_KERNEL_CLONES void halfband_decimate(const float* even, const float* odd, float* output, int num, const float* coeffs, int taps) { decimate_kernel(even, odd, output, num, coeffs, taps); }
+
+MAEC_KERNEL_CLONES void halfband_decimate(const double* even, const double* odd, double* output, int num, const double* coeffs, int taps) { decimate_kernel(even, odd, output, num, coeffs, taps); }
+
+void halfband_decimate(const long double* even, const long double* odd, long double* output, int num, const long double* coeffs, int taps) { decimate_kernel(even, odd, output, num, coeffs, taps); }
@@ -10,3 +10,419 @@
  */
 
 #include "dsp/iir.hpp"
+
+#include <complex>
+#include <utility>
+
+#include "dsp/target.hpp"
+
+namespace {
+
+/**
+ * @brief Runs a group of interleaved channels through a section
+ *
+ * @tparam T Type of the values
+ * @tparam W Number of channels in the group
+ * @param coeff Coefficients of the section
+ * @param state State of every channel
+ * @param input Pointer to interleaved input data
+ * @param frames Number of frames to process
+ * @param channels Number of channels in each frame
+ * @param first First channel of the group
+ * @param output Pointer to interleaved output data
+ */
+template <typename T, int W>
+inline void biquad_group(const BiquadCoefficients<T>& coeff, T* state, const T* input, int frames, int channels, int first, T* output) {
+
+    const T b0 = coeff.b0, b1 = coeff.b1, b2 = coeff.b2, a1 = coeff.a1, a2 = coeff.a2;
+
+    // Load the state into locals:
+
+    T z1[W];
+    T z2[W];
+
+    for (int l = 0; l < W; ++l) {
+
+        z1[l] = state[first + l];
+        z2[l] = state[channels + first + l];
+    }
+
+    for (int f = 0; f < frames; ++f) {
+
+        const T* x = input + static_cast<std::ptrdiff_t>(f) * channels + first;
+        T* y = output + static_cast<std::ptrdiff_t>(f) * channels + first;
+
+        for (int l = 0; l < W; ++l) {
+
+            const T xv = x[l];
+            const T yv = b0 * xv + z1[l];
+
+            z1[l] = b1 * xv - a1 * yv + z2[l];
+            z2[l] = b2 * xv - a2 * yv;
+
+            y[l] = yv;
+        }
+    }
+
+    // Store the state:
+
+    for (int l = 0; l < W; ++l) {
+
+        state[first + l] = z1[l];
+        state[channels + first + l] = z2[l];
+    }
+}
+
+template <typename T>
+inline void biquad_interleaved_kernel(const BiquadCoefficients<T>& coeff, T* state, const T* input, int frames, int channels, T* output) {
+
+    int c = 0;
+
+    for (; c + 8 <= channels; c += 8) {
+
+        biquad_group<T, 8>(coeff, state, input, frames, channels, c, output);
+    }
+
+    for (; c + 4 <= channels; c += 4) {
+
+        biquad_group<T, 4>(coeff, state, input, frames, channels, c, output);
+    }
+
+    for (; c < channels; ++c) {
+
+        biquad_group<T, 1>(coeff, state, input, frames, channels, c, output);
+    }
+}
+
+/// Complex type used while designing filters
+using cplx = std::complex<double>;
+
+/// Values closer than this to the real axis are treated as real
+const double real_tolerance = 1e-9;
+
+/**
+ * @brief A group of one or two roots that make up a section
+ *
+ */
+struct RootGroup {
+
+    /// Roots in the group
+    cplx first, second;
+
+    /// Number of roots in the group, 1 or 2
+    int count;
+};
+
+/**
+ * @brief Computes the poles of an analog low pass prototype
+ *
+ * The prototype has a cutoff of 1 radian per second.
+ *
+ * @param proto Prototype to compute
+ * @param order Order of the prototype
+ * @param ripple Pass band ripple in decibels
+ * @return std::vector<cplx> Poles in the left half plane
+ */
+std::vector<cplx> prototype_poles(IIRPrototype proto, int order, double ripple) {
+
+    std::vector<cplx> poles;
+
+    // Chebyshev poles lie on an ellipse, Butterworth poles on the unit circle:
+
+    double sigma = 1;
+    double omega = 1;
+
+    if (proto == IIRPrototype::Chebyshev) {
+
+        const double eps = std::sqrt(std::pow(10, ripple / 10) - 1);
+        const double v = std::asinh(1 / eps) / order;
+
+        sigma = std::sinh(v);
+        omega = std::cosh(v);
+    }
+
+    for (int k = 0; k < order; ++k) {
+
+        const double theta = M_PI * (2 * k + 1) / (2 * order);
+
+        poles.emplace_back(-sigma * std::sin(theta), omega * std::cos(theta));
+    }
+
+    return poles;
+}
+
+/**
+ * @brief Maps an analog value to the digital domain
+ *
+ * We use the bilinear transform with a sample period of 1.
+ *
+ * @param s Analog value
+ * @return cplx Digital value
+ */
+cplx bilinear(cplx s) { return (2.0 + s) / (2.0 - s); }
+
+/**
+ * @brief Groups roots into conjugate pairs and real pairs
+ *
+ * Complex roots are paired with their conjugate,
+ * real roots are paired in the order given.
+ * A leftover real root is placed last in its own group.
+ *
+ * @param roots Roots to group, complex roots must have their conjugate present
+ * @return std::vector<RootGroup> Groups of roots
+ */
+std::vector<RootGroup> group_roots(const std::vector<cplx>& roots) {
+
+    std::vector<RootGroup> groups;
+    std::vector<double> reals;
+
+    for (const cplx& root : roots) {
+
+        if (root.imag() > real_tolerance) {
+
+            groups.push_back({root, std::conj(root), 2});
+        }
+
+        else if (root.imag() >= -real_tolerance) {
+
+            reals.push_back(root.real());
+        }
+    }
+
+    for (std::size_t i = 0; i < reals.size(); i += 2) {
+
+        if (i + 1 < reals.size()) {
+
+            groups.push_back({reals[i], reals[i + 1], 2});
+        }
+
+        else {
+
+            groups.push_back({reals[i], 0, 1});
+        }
+    }
+
+    return groups;
+}
+
+/**
+ * @brief Determines the polynomial coefficients of a root group
+ *
+ * @param group Group of roots
+ * @param c1 First order coefficient
+ * @param c2 Second order coefficient
+ */
+void group_polynomial(const RootGroup& group, double& c1, double& c2) {
+
+    if (group.count == 1) {
+
+        c1 = -group.first.real();
+        c2 = 0;
+
+        return;
+    }
+
+    c1 = -(group.first + group.second).real();
+    c2 = (group.first * group.second).real();
+}
+
+/**
+ * @brief Determines the gain of a section at a point on the unit circle
+ *
+ * @param sec Coefficients of the section
+ * @param z Point to evaluate
+ * @return double Magnitude of the response
+ */
+double section_gain(const BiquadCoefficients<double>& sec, cplx z) {
+
+    const cplx zi = 1.0 / z;
+
+    return std::abs((sec.b0 + sec.b1 * zi + sec.b2 * zi * zi) / (1.0 + sec.a1 * zi + sec.a2 * zi * zi));
+}
+
+}  // namespace
+
+std::vector<BiquadCoefficients<double>> iir_design(IIRPrototype proto, FilterType type, int order, double low, double high, double ripple) {
+
+    // Keep cutoffs within the Nyquist frequency:
+
+    low = std::clamp(low, 1e-6, 0.499999);
+    high = std::clamp(high, 1e-6, 0.499999);
+
+    if (low > high && (type == FilterType::BandPass || type == FilterType::BandReject)) {
+
+        std::swap(low, high);
+    }
+
+    // Pre-warp the cutoffs:
+
+    const double wl = 2 * std::tan(M_PI * low);
+    const double wh = 2 * std::tan(M_PI * high);
+    const double w0 = std::sqrt(wl * wh);
+    const double bw = wh - wl;
+
+    // Transform each prototype pole:
+
+    std::vector<cplx> poles;
+    std::vector<cplx> zeros;
+
+    for (const cplx& p : prototype_poles(proto, order, ripple)) {
+
+        switch (type) {
+
+            case FilterType::LowPass:
+
+                poles.push_back(bilinear(p * wh));
+                zeros.emplace_back(-1);
+                break;
+
+            case FilterType::HighPass:
+
+                poles.push_back(bilinear(wl / p));
+                zeros.emplace_back(1);
+                break;
+
+            case FilterType::BandPass: {
+
+                // Roots of s^2 - p * bw * s + w0^2:
+
+                const cplx disc = std::sqrt(p * bw * p * bw - 4 * w0 * w0);
+
+                poles.push_back(bilinear((p * bw + disc) / 2.0));
+                poles.push_back(bilinear((p * bw - disc) / 2.0));
+                zeros.emplace_back(1);
+                zeros.emplace_back(-1);
+                break;
+            }
+
+            case FilterType::BandReject: {
+
+                // Roots of s^2 - (bw / p) * s + w0^2:
+
+                const cplx disc = std::sqrt((bw / p) * (bw / p) - 4 * w0 * w0);
+
+                poles.push_back(bilinear((bw / p + disc) / 2.0));
+                poles.push_back(bilinear((bw / p - disc) / 2.0));
+                zeros.push_back(bilinear(cplx(0, w0)));
+                zeros.push_back(bilinear(cplx(0, -w0)));
+                break;
+            }
+        }
+    }
+
+    // Determine where each section should have unity gain:
+
+    cplx ref = 1;
+
+    if (type == FilterType::HighPass) {
+
+        ref = -1;
+    }
+
+    else if (type == FilterType::BandPass) {
+
+        ref = std::polar(1.0, 2 * std::atan(w0 / 2));
+    }
+
+    // Pair poles and zeros into sections:
+
+    const auto pgroups = group_roots(poles);
+    const auto zgroups = group_roots(zeros);
+
+    std::vector<BiquadCoefficients<double>> sections(pgroups.size());
+
+    for (std::size_t i = 0; i < sections.size(); ++i) {
+
+        auto& sec = sections[i];
+
+        group_polynomial(pgroups[i], sec.a1, sec.a2);
+        group_polynomial(zgroups[i], sec.b1, sec.b2);
+
+        // Normalize the gain:
+
+        const double scale = 1 / section_gain(sec, ref);
+
+        sec.b0 *= scale;
+        sec.b1 *= scale;
+        sec.b2 *= scale;
+    }
+
+    // Even order Chebyshev filters start at the bottom of the ripple:
+
+    if (proto == IIRPrototype::Chebyshev && order % 2 == 0 && !sections.empty()) {
+
+        const double gain = std::pow(10, -ripple / 20);
+
+        sections[0].b0 *= gain;
+        sections[0].b1 *= gain;
+        sections[0].b2 *= gain;
+    }
+
+    return sections;
+}
+
+BiquadCoefficients<double> biquad_design(FilterType type, double freq, double q) {
+
+    // Find the pre-warped cutoff, this is called for every update of a modulated filter,
+    // so we use the fast sine and cosine on the cutoff in turns:
+
+    const double turn = std::clamp(freq, 1e-6, 0.499999);
+    const double cw = fast_cos_turns<MathAccuracy::High>(turn);
+    const double alpha = fast_sin_turns<MathAccuracy::High>(turn) / (2 * std::max(q, 1e-6));
+
+    const double norm = 1 / (1 + alpha);
+
+    BiquadCoefficients<double> sec;
+
+    sec.a1 = -2 * cw * norm;
+    sec.a2 = (1 - alpha) * norm;
+
+    switch (type) {
+
+        case FilterType::HighPass:
+
+            sec.b0 = (1 + cw) / 2 * norm;
+            sec.b1 = -(1 + cw) * norm;
+            sec.b2 = sec.b0;
+
+            break;
+
+        case FilterType::BandPass:
+
+            sec.b0 = alpha * norm;
+            sec.b1 = 0;
+            sec.b2 = -sec.b0;
+
+            break;
+
+        case FilterType::BandReject:
+
+            sec.b0 = norm;
+            sec.b1 = sec.a1;
+            sec.b2 = norm;
+
+            break;
+
+        default:
+
+            sec.b0 = (1 - cw) / 2 * norm;
+            sec.b1 = (1 - cw) * norm;
+            sec.b2 = sec.b0;
+
+            break;
+    }
+
+    return sec;
+}
+
+MAEC_KERNEL_CLONES void biquad_interleaved(const BiquadCoefficients<float>& coeff, float* state, const float* input, int frames, int channels, float* output) {
+    biquad_interleaved_kernel(coeff, state, input, frames, channels, output);
+}
+
+MAEC_KERNEL_CLONES void biquad_interleaved(const BiquadCoefficients<double>& coeff, double* state, const double* input, int frames, int channels, double* output) {
+    biquad_interleaved_kernel(coeff, state, input, frames, channels, output);
+}
+
+void biquad_interleaved(const BiquadCoefficients<long double>& coeff, long double* state, const long double* input, int frames, int channels, long double* output) {
+    biquad_interleaved_kernel(coeff, state, input, frames, channels, output);
+}
@@ -0,0 +1,114 @@
+/**
+ * @file interleave.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations of interleave and deinterleave kernels
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "dsp/interleave.hpp"
+
+#include <algorithm>
+
+#include "dsp/target.hpp"
+
+namespace {
+
+template <typename T>
+inline void interleave_kernel(const T* __restrict in, T* __restrict out, int channels, int frames) {
+
+    // Mono is a plain copy:
+
+    if (channels == 1) {
+
+        std::copy_n(in, frames, out);
+
+        return;
+    }
+
+    // Stereo gets its own loop:
+
+    if (channels == 2) {
+
+        const T* left = in;
+        const T* right = in + frames;
+
+        for (int i = 0; i < frames; ++i) {
+
+            out[2 * i] = left[i];
+            out[(2 * i) + 1] = right[i];
+        }
+
+        return;
+    }
+
+    // Otherwise, read each channel contiguously:
+
+    for (int c = 0; c < channels; ++c) {
+
+        const T* chan = in + (static_cast<std::ptrdiff_t>(c) * frames);
+
+        for (int i = 0; i < frames; ++i) {
+
+            out[(i * channels) + c] = chan[i];
+        }
+    }
+}
+
+template <typename T>
+inline void deinterleave_kernel(const T* __restrict in, T* __restrict out, int channels, int frames) {
+
+    // Mono is a plain copy:
+
+    if (channels == 1) {
+
+        std::copy_n(in, frames, out);
+
+        return;
+    }
+
+    // Stereo gets its own loop:
+
+    if (channels == 2) {
+
+        T* left = out;
+        T* right = out + frames;
+
+        for (int i = 0; i < frames; ++i) {
+
+            left[i] = in[2 * i];
+            right[i] = in[(2 * i) + 1];
+        }
+
+        return;
+    }
+
+    // Otherwise, write each channel contiguously:
+
+    for (int c = 0; c < channels; ++c) {
+
+        T* chan = out + (static_cast<std::ptrdiff_t>(c) * frames);
+
+        for (int i = 0; i < frames; ++i) {
+
+            chan[i] = in[(i * channels) + c];
+        }
+    }
+}
+
+}  // namespace
+
+MAEC_KERNEL_CLONES void interleave(const float* in, float* out, int channels, int frames) { interleave_kernel(in, out, channels, frames); }
+
+MAEC_KERNEL_CLONES void interleave(const double* in, double* out, int channels, int frames) { interleave_kernel(in, out, channels, frames); }
+
+void interleave(const long double* in, long double* out, int channels, int frames) { interleave_kernel(in, out, channels, frames); }
+
+MAEC_KERNEL_CLONES void deinterleave(const float* in, float* out, int channels, int frames) { deinterleave_kernel(in, out, channels, frames); }
+
+MAEC_KERNEL_CLONES void deinterleave(const double* in, double* out, int channels, int frames) { deinterleave_kernel(in, out, channels, frames); }
+
+void deinterleave(const long double* in, long double* out, int channels, int frames) { deinterleave_kernel(in, out, channels, frames); }
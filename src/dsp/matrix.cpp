@@ -0,0 +1,343 @@
+/**
+ * @file matrix.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations of matrix kernels
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "dsp/matrix.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "dsp/target.hpp"
+
+#ifdef MAEC_BLAS
+
+// Not every BLAS installs cblas.h, but the C interface itself is fixed,
+// so we declare the two functions we use:
+
+extern "C" {
+
+void cblas_sgemm(int order, int transa, int transb, int rows, int cols, int inner, float alpha, const float* a, int lda, const float* b, int ldb, float beta, float* c, int ldc);
+
+void cblas_dgemm(int order, int transa, int transb, int rows, int cols, int inner, double alpha, const double* a, int lda, const double* b, int ldb, double beta, double* c, int ldc);
+}
+
+#endif
+
+namespace {
+
+/// Number of rows of b in each tile
+constexpr int TILE_INNER = 32;
+
+/// Number of columns of b in each tile
+constexpr int TILE_COLS = 128;
+
+template <typename T>
+inline T dot_kernel(const T* __restrict avec, const T* __restrict bvec, int num) {
+
+    // Keep independent partial sums, so the adds can run in parallel:
+
+    T sums[8] = {};
+
+    int i = 0;
+
+    for (; i + 8 <= num; i += 8) {
+
+        for (int l = 0; l < 8; ++l) {
+
+            sums[l] += avec[i + l] * bvec[i + l];
+        }
+    }
+
+    for (; i < num; ++i) {
+
+        sums[0] += avec[i] * bvec[i];
+    }
+
+    return ((sums[0] + sums[1]) + (sums[2] + sums[3])) + ((sums[4] + sums[5]) + (sums[6] + sums[7]));
+}
+
+/**
+ * @brief Adds a scaled row to another
+ *
+ * @tparam T Type of the values
+ * @param out Pointer to the row to add to
+ * @param row Pointer to the row to add
+ * @param scale Value to scale the row by
+ * @param num Number of values in each row
+ */
+template <typename T>
+inline void axpy(T* __restrict out, const T* __restrict row, T scale, int num) {
+
+    for (int j = 0; j < num; ++j) {
+
+        out[j] += scale * row[j];
+    }
+}
+
+template <typename T>
+inline void gemm_kernel(MatrixView<T> out, MatrixView<const T> a, MatrixView<const T> b, bool accumulate) {
+
+    // Work on the transpose if it puts the output rows in contiguous memory:
+
+    if (out.cstride != 1 && out.rstride == 1) {
+
+        out = out.transpose();
+        a = std::exchange(b, a.transpose()).transpose();
+    }
+
+    const int inner = a.cols;
+
+    if (!accumulate && inner == 0) {
+
+        for (int i = 0; i < out.rows; ++i) {
+
+            for (int j = 0; j < out.cols; ++j) {
+
+                out.at(i, j) = 0;
+            }
+        }
+
+        return;
+    }
+
+    // Tile of b, and the row being accumulated if the output is not contiguous:
+
+    alignas(64) T tile[TILE_INNER * TILE_COLS];
+    alignas(64) T accum[TILE_COLS];
+
+    const bool contiguous = out.cstride == 1;
+
+    for (int col = 0; col < out.cols; col += TILE_COLS) {
+
+        const int ncols = std::min(TILE_COLS, out.cols - col);
+
+        for (int start = 0; start < inner; start += TILE_INNER) {
+
+            const int ninner = std::min(TILE_INNER, inner - start);
+
+            // Copy the tile of b into contiguous memory:
+
+            for (int p = 0; p < ninner; ++p) {
+
+                T* dest = tile + static_cast<std::ptrdiff_t>(p) * TILE_COLS;
+
+                for (int j = 0; j < ncols; ++j) {
+
+                    dest[j] = b.at(start + p, col + j);
+                }
+            }
+
+            const bool first = start == 0 && !accumulate;
+
+            // Add the tile into each row of the output:
+
+            for (int i = 0; i < out.rows; ++i) {
+
+                T* row = contiguous ? &out.at(i, col) : accum;
+
+                if (first) {
+
+                    std::fill_n(row, ncols, T(0));
+                }
+
+                else if (!contiguous) {
+
+                    for (int j = 0; j < ncols; ++j) {
+
+                        row[j] = out.at(i, col + j);
+                    }
+                }
+
+                for (int p = 0; p < ninner; ++p) {
+
+                    axpy(row, tile + static_cast<std::ptrdiff_t>(p) * TILE_COLS, a.at(i, start + p), ncols);
+                }
+
+                if (!contiguous) {
+
+                    for (int j = 0; j < ncols; ++j) {
+
+                        out.at(i, col + j) = row[j];
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <typename T>
+inline void gemv_kernel(T* out, MatrixView<const T> a, const T* vec, bool accumulate) {
+
+    if (a.rstride == 1) {
+
+        // Columns are contiguous, add each one scaled by the input:
+
+        if (!accumulate) {
+
+            std::fill_n(out, a.rows, T(0));
+        }
+
+        for (int p = 0; p < a.cols; ++p) {
+
+            axpy(out, &a.at(0, p), vec[p], a.rows);
+        }
+
+        return;
+    }
+
+    for (int i = 0; i < a.rows; ++i) {
+
+        T sum = 0;
+
+        if (a.cstride == 1) {
+
+            // Rows are contiguous, take the dot product of each:
+
+            sum = dot_kernel(&a.at(i, 0), vec, a.cols);
+        }
+
+        else {
+
+            for (int p = 0; p < a.cols; ++p) {
+
+                sum += a.at(i, p) * vec[p];
+            }
+        }
+
+        out[i] = accumulate ? out[i] + sum : sum;
+    }
+}
+
+#ifdef MAEC_BLAS
+
+/// Values of the CBLAS enumerations we use
+constexpr int CBLAS_ROW_MAJOR = 101;
+constexpr int CBLAS_NO_TRANS = 111;
+constexpr int CBLAS_TRANS = 112;
+
+/**
+ * @brief Describes a view as a row major BLAS matrix
+ *
+ * @tparam T Type of the values
+ * @param view View to describe
+ * @param trans Set to the transpose flag to use
+ * @param lead Set to the leading dimension to use
+ * @return true If BLAS can read this view
+ * @return false If neither dimension is contiguous
+ */
+template <typename T>
+bool blas_layout(MatrixView<T> view, int& trans, int& lead) {
+
+    if (view.cstride == 1 && view.rstride >= view.cols) {
+
+        trans = CBLAS_NO_TRANS;
+        lead = std::max(static_cast<int>(view.rstride), 1);
+
+        return true;
+    }
+
+    if (view.rstride == 1 && view.cstride >= view.rows) {
+
+        trans = CBLAS_TRANS;
+        lead = std::max(static_cast<int>(view.cstride), 1);
+
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Attempts to compute a product with BLAS
+ *
+ * @tparam T Type of the values
+ * @tparam F Type of the BLAS function
+ * @param func cblas_sgemm or cblas_dgemm
+ * @return true If the product was computed
+ * @return false If BLAS can not handle these views
+ */
+template <typename T, typename F>
+bool blas_gemm(F func, MatrixView<T> out, MatrixView<const T> a, MatrixView<const T> b, bool accumulate) {
+
+    if (out.rows == 0 || out.cols == 0 || a.cols == 0) {
+
+        return false;
+    }
+
+    // BLAS writes row major output, so work on the transpose if we need to:
+
+    if (out.cstride != 1) {
+
+        out = out.transpose();
+        a = std::exchange(b, a.transpose()).transpose();
+    }
+
+    int otrans = 0;
+    int olead = 0;
+    int atrans = 0;
+    int alead = 0;
+    int btrans = 0;
+    int blead = 0;
+
+    if (!blas_layout(out, otrans, olead) || otrans != CBLAS_NO_TRANS || !blas_layout(a, atrans, alead) || !blas_layout(b, btrans, blead)) {
+
+        return false;
+    }
+
+    func(CBLAS_ROW_MAJOR, atrans, btrans, out.rows, out.cols, a.cols, T(1), a.data, alead, b.data, blead, accumulate ? T(1) : T(0), out.data, olead);
+
+    return true;
+}
+
+#endif
+
+}  // namespace
+
+MAEC_KERNEL_CLONES float dot_product(const float* avec, const float* bvec, int num) { return dot_kernel(avec, bvec, num); }
+
+MAEC_KERNEL_CLONES double dot_product(const double* avec, const double* bvec, int num) { return dot_kernel(avec, bvec, num); }
+
+long double dot_product(const long double* avec, const long double* bvec, int num) { return dot_kernel(avec, bvec, num); }
+
+MAEC_KERNEL_CLONES void gemm(MatrixView<float> out, MatrixView<const float> a, MatrixView<const float> b, bool accumulate) {
+
+#ifdef MAEC_BLAS
+
+    if (blas_gemm(cblas_sgemm, out, a, b, accumulate)) {
+
+        return;
+    }
+
+#endif
+
+    gemm_kernel(out, a, b, accumulate);
+}
+
+MAEC_KERNEL_CLONES void gemm(MatrixView<double> out, MatrixView<const double> a, MatrixView<const double> b, bool accumulate) {
+
+#ifdef MAEC_BLAS
+
+    if (blas_gemm(cblas_dgemm, out, a, b, accumulate)) {
+
+        return;
+    }
+
+#endif
+
+    gemm_kernel(out, a, b, accumulate);
+}
+
+void gemm(MatrixView<long double> out, MatrixView<const long double> a, MatrixView<const long double> b, bool accumulate) { gemm_kernel(out, a, b, accumulate); }
+
+MAEC_KERNEL_CLONES void gemv(float* out, MatrixView<const float> a, const float* vec, bool accumulate) { gemv_kernel(out, a, vec, accumulate); }
+
+MAEC_KERNEL_CLONES void gemv(double* out, MatrixView<const double> a, const double* vec, bool accumulate) { gemv_kernel(out, a, vec, accumulate); }
+
+void gemv(long double* out, MatrixView<const long double> a, const long double* vec, bool accumulate) { gemv_kernel(out, a, vec, accumulate); }
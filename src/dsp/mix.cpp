@@ -0,0 +1,63 @@
+/**
+ * @file mix.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations of batch mixing kernels
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "dsp/mix.hpp"
+
+#include "dsp/target.hpp"
+
+namespace {
+
+template <typename T>
+inline void add_kernel(T* __restrict out, const T* __restrict in, int size) {
+
+    for (int i = 0; i < size; ++i) {
+
+        out[i] += in[i];
+    }
+}
+
+template <typename T>
+inline void gain_kernel(T* __restrict out, const T* __restrict in, int size, T gain) {
+
+    for (int i = 0; i < size; ++i) {
+
+        out[i] += in[i] * gain;
+    }
+}
+
+template <typename T>
+inline void window_kernel(T* __restrict out, const T* __restrict in, const T* __restrict window, int size, T gain) {
+
+    for (int i = 0; i < size; ++i) {
+
+        out[i] += in[i] * window[i] * gain;
+    }
+}
+
+}  // namespace
+
+MAEC_KERNEL_CLONES void mix_add(float* out, const float* in, int size) { add_kernel(out, in, size); }
+
+MAEC_KERNEL_CLONES void mix_add(double* out, const double* in, int size) { add_kernel(out, in, size); }
+
+void mix_add(long double* out, const long double* in, int size) { add_kernel(out, in, size); }
+
+MAEC_KERNEL_CLONES void mix_add(float* out, const float* in, int size, float gain) { gain_kernel(out, in, size, gain); }
+
+MAEC_KERNEL_CLONES void mix_add(double* out, const double* in, int size, double gain) { gain_kernel(out, in, size, gain); }
+
+void mix_add(long double* out, const long double* in, int size, long double gain) { gain_kernel(out, in, size, gain); }
+
+MAEC_KERNEL_CLONES void mix_window_add(float* out, const float* in, const float* window, int size, float gain) { window_kernel(out, in, window, size, gain); }
+
+MAEC_KERNEL_CLONES void mix_window_add(double* out, const double* in, const double* window, int size, double gain) { window_kernel(out, in, window, size, gain); }
+
+void mix_window_add(long double* out, const long double* in, const long double* window, int size, long double gain) { window_kernel(out, in, window, size, gain); }
@@ -0,0 +1,183 @@
+/**
+ * @file osc.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations of batch oscillator kernels
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "dsp/osc.hpp"
+
+#include <cmath>
+#include <cstddef>
+
+#include "dsp/target.hpp"
+
+namespace {
+
+/**
+ * @brief Determines the phase of a sample in turns
+ *
+ * We compute the phase directly from the start phase,
+ * and wrap it into [0, 1).
+ *
+ * @param start Starting phase
+ * @param inc Phase increment per sample
+ * @param index Index of the sample
+ * @return double Phase of the sample
+ */
+inline double sample_turn(double start, double inc, int index) {
+
+    const double turn = start + inc * index;
+
+    return turn - std::floor(turn);
+}
+
+template <typename T>
+inline void sine_kernel(T* out, int size, double start, double inc) {
+
+    for (int i = 0; i < size; ++i) {
+
+        out[i] = sine_turns<T>(static_cast<T>(sample_turn(start, inc, i)));
+    }
+}
+
+template <typename T>
+inline void square_kernel(T* out, int size, double start, double inc) {
+
+    for (int i = 0; i < size; ++i) {
+
+        out[i] = sample_turn(start, inc, i) < 0.5 ? T(1) : T(-1);
+    }
+}
+
+template <typename T>
+inline void sawtooth_kernel(T* out, int size, double start, double inc) {
+
+    for (int i = 0; i < size; ++i) {
+
+        out[i] = static_cast<T>(2.0 * sample_turn(start + 0.5, inc, i) - 1.0);
+    }
+}
+
+template <typename T>
+inline void triangle_kernel(T* out, int size, double start, double inc) {
+
+    for (int i = 0; i < size; ++i) {
+
+        out[i] = static_cast<T>(1.0 - 4.0 * std::fabs(sample_turn(start + 0.25, inc, i) - 0.5));
+    }
+}
+
+/**
+ * @brief Advances a phase by one step, wrapping into [0, 1)
+ *
+ * @param phase Phase to advance
+ * @param inc Increment, in (-1, 1)
+ * @return float Next phase
+ */
+inline float bank_step(float phase, float inc) {
+
+    const float next = phase + inc;
+
+    return next - (next >= 1.0F ? 1.0F : 0.0F) + (next < 0.0F ? 1.0F : 0.0F);
+}
+
+template <typename T>
+inline void bank_sum_kernel(float* __restrict phase, const float* __restrict inc, const float* __restrict amp, int voices, T* __restrict out, int size) {
+
+    for (int i = 0; i < size; ++i) {
+
+        // Each lane sums its own voices, so the voice loop has no reduction:
+
+        float lanes[OSC_BANK_LANES] = {};
+
+        for (int v = 0; v < voices; v += OSC_BANK_LANES) {
+
+            for (int l = 0; l < OSC_BANK_LANES; ++l) {
+
+                const float turn = phase[v + l];
+
+                lanes[l] += amp[v + l] * sine_turns<float>(turn);
+
+                phase[v + l] = bank_step(turn, inc[v + l]);
+            }
+        }
+
+        float sum = 0;
+
+        for (const float lane : lanes) {
+
+            sum += lane;
+        }
+
+        out[i] = static_cast<T>(sum);
+    }
+}
+
+template <typename T>
+inline void bank_voices_kernel(float* __restrict phase, const float* __restrict inc, const float* __restrict amp, int voices, T* __restrict out, int size) {
+
+    for (int i = 0; i < size; ++i) {
+
+        T* frame = out + static_cast<std::ptrdiff_t>(i) * voices;
+
+        for (int v = 0; v < voices; ++v) {
+
+            const float turn = phase[v];
+
+            frame[v] = static_cast<T>(amp[v] * sine_turns<float>(turn));
+
+            phase[v] = bank_step(turn, inc[v]);
+        }
+    }
+}
+
+}  // namespace
+
+MAEC_KERNEL_CLONES void osc_sine(float* out, int size, double start, double inc) { sine_kernel(out, size, start, inc); }
+
+MAEC_KERNEL_CLONES void osc_sine(double* out, int size, double start, double inc) { sine_kernel(out, size, start, inc); }
+
+void osc_sine(long double* out, int size, double start, double inc) {
+
+    // Long double is used when precision matters, so use the real thing:
+
+    for (int i = 0; i < size; ++i) {
+
+        out[i] = std::sin(2.0L * M_PI * sample_turn(start, inc, i));
+    }
+}
+
+MAEC_KERNEL_CLONES void osc_square(float* out, int size, double start, double inc) { square_kernel(out, size, start, inc); }
+
+MAEC_KERNEL_CLONES void osc_square(double* out, int size, double start, double inc) { square_kernel(out, size, start, inc); }
+
+void osc_square(long double* out, int size, double start, double inc) { square_kernel(out, size, start, inc); }
+
+MAEC_KERNEL_CLONES void osc_sawtooth(float* out, int size, double start, double inc) { sawtooth_kernel(out, size, start, inc); }
+
+MAEC_KERNEL_CLONES void osc_sawtooth(double* out, int size, double start, double inc) { sawtooth_kernel(out, size, start, inc); }
+
+void osc_sawtooth(long double* out, int size, double start, double inc) { sawtooth_kernel(out, size, start, inc); }
+
+MAEC_KERNEL_CLONES void osc_triangle(float* out, int size, double start, double inc) { triangle_kernel(out, size, start, inc); }
+
+MAEC_KERNEL_CLONES void osc_triangle(double* out, int size, double start, double inc) { triangle_kernel(out, size, start, inc); }
+
+void osc_triangle(long double* out, int size, double start, double inc) { triangle_kernel(out, size, start, inc); }
+
+MAEC_KERNEL_CLONES void osc_bank_sum(float* phase, const float* inc, const float* amp, int voices, float* out, int size) { bank_sum_kernel(phase, inc, amp, voices, out, size); }
+
+MAEC_KERNEL_CLONES void osc_bank_sum(float* phase, const float* inc, const float* amp, int voices, double* out, int size) { bank_sum_kernel(phase, inc, amp, voices, out, size); }
+
+void osc_bank_sum(float* phase, const float* inc, const float* amp, int voices, long double* out, int size) { bank_sum_kernel(phase, inc, amp, voices, out, size); }
+
+MAEC_KERNEL_CLONES void osc_bank_voices(float* phase, const float* inc, const float* amp, int voices, float* out, int size) { bank_voices_kernel(phase, inc, amp, voices, out, size); }
+
+MAEC_KERNEL_CLONES void osc_bank_voices(float* phase, const float* inc, const float* amp, int voices, double* out, int size) { bank_voices_kernel(phase, inc, amp, voices, out, size); }
+
+void osc_bank_voices(float* phase, const float* inc, const float* amp, int voices, long double* out, int size) { bank_voices_kernel(phase, inc, amp, voices, out, size); }
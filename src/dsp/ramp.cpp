@@ -0,0 +1,93 @@
+/**
+ * @file ramp.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations of batch ramp kernels
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "dsp/ramp.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "dsp/denormal.hpp"
+#include "dsp/target.hpp"
+
+namespace {
+
+/// Number of independent lanes in the exponential recurrence
+const int RAMP_LANES = 8;
+
+template <typename T>
+inline void linear_kernel(T* out, int size, double start, double step) {
+
+    for (int i = 0; i < size; ++i) {
+
+        out[i] = static_cast<T>(flush_denormal(start + step * i));
+    }
+}
+
+template <typename T>
+inline void exponential_kernel(T* out, int size, double start, double ratio) {
+
+    // Determine the ratio for each lane, and the ratio to advance all lanes:
+
+    double lanes[RAMP_LANES];
+
+    lanes[0] = 1;
+
+    for (int k = 1; k < RAMP_LANES; ++k) {
+
+        lanes[k] = lanes[k - 1] * ratio;
+    }
+
+    const double advance = lanes[RAMP_LANES - 1] * ratio;
+
+    for (int base = 0; base < size; base += RAMP_ANCHOR) {
+
+        // Re-anchor using the closed form:
+
+        double cur = start * std::pow(ratio, base);
+
+        const int end = std::min(size, base + RAMP_ANCHOR);
+
+        // Fill each group of lanes:
+
+        int i = base;
+
+        for (; i + RAMP_LANES <= end; i += RAMP_LANES) {
+
+            for (int k = 0; k < RAMP_LANES; ++k) {
+
+                out[i + k] = static_cast<T>(flush_denormal(cur * lanes[k]));
+            }
+
+            cur *= advance;
+        }
+
+        // Fill the remainder:
+
+        for (int k = 0; i < end; ++i, ++k) {
+
+            out[i] = static_cast<T>(flush_denormal(cur * lanes[k]));
+        }
+    }
+}
+
+}  // namespace
+
+MAEC_KERNEL_CLONES void ramp_linear(float* out, int size, double start, double step) { linear_kernel(out, size, start, step); }
+
+MAEC_KERNEL_CLONES void ramp_linear(double* out, int size, double start, double step) { linear_kernel(out, size, start, step); }
+
+void ramp_linear(long double* out, int size, double start, double step) { linear_kernel(out, size, start, step); }
+
+MAEC_KERNEL_CLONES void ramp_exponential(float* out, int size, double start, double ratio) { exponential_kernel(out, size, start, ratio); }
+
+MAEC_KERNEL_CLONES void ramp_exponential(double* out, int size, double start, double ratio) { exponential_kernel(out, size, start, ratio); }
+
+void ramp_exponential(long double* out, int size, double start, double ratio) { exponential_kernel(out, size, start, ratio); }
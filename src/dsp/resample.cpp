@@ -0,0 +1,91 @@
+/**
+ * @file resample.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations of polyphase resampling kernels
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "dsp/resample.hpp"
+
+#include <cmath>
+
+#include "dsp/target.hpp"
+
+namespace {
+
+/// Number of partial sums kept when applying a sub-filter
+constexpr int resample_lanes = 8;
+
+template <typename T>
+inline void resample_kernel(const T* input, T* output, int num, double start, double step, const T* table, int taps, int phases) {
+
+    const int half = taps / 2 - 1;
+
+    for (int j = 0; j < num; ++j) {
+
+        // Determine position of this sample:
+
+        const double pos = start + step * j;
+        const double base = std::floor(pos);
+        const double frac = (pos - base) * phases;
+        const int phase = static_cast<int>(frac);
+        const T blend = static_cast<T>(frac - phase);
+
+        const T* x = input + static_cast<std::ptrdiff_t>(base) - half;
+        const T* t0 = table + static_cast<std::ptrdiff_t>(phase) * taps;
+        const T* t1 = t0 + taps;
+
+        // Apply both sub-filters, keeping partial sums in lanes so this vectorizes:
+
+        T acc0[resample_lanes] = {};
+        T acc1[resample_lanes] = {};
+
+        int i = 0;
+
+        for (; i + resample_lanes <= taps; i += resample_lanes) {
+
+            for (int k = 0; k < resample_lanes; ++k) {
+
+                acc0[k] += t0[i + k] * x[i + k];
+                acc1[k] += t1[i + k] * x[i + k];
+            }
+        }
+
+        for (; i < taps; ++i) {
+
+            acc0[0] += t0[i] * x[i];
+            acc1[0] += t1[i] * x[i];
+        }
+
+        T sum0 = 0;
+        T sum1 = 0;
+
+        for (int k = 0; k < resample_lanes; ++k) {
+
+            sum0 += acc0[k];
+            sum1 += acc1[k];
+        }
+
+        // Interpolate between the sub-filters:
+
+        output[j] = sum0 + blend * (sum1 - sum0);
+    }
+}
+
+}  // namespace
+
+MAEC_KERNEL_CLONES void resample(const float* input, float* output, int num, double start, double step, const float* table, int taps, int phases) {
+    resample_kernel(input, output, num, start, step, table, taps, phases);
+}
+
+MAEC_KERNEL_CLONES void resample(const double* input, double* output, int num, double start, double step, const double* table, int taps, int phases) {
+    resample_kernel(input, output, num, start, step, table, taps, phases);
+}
+
+void resample(const long double* input, long double* output, int num, double start, double step, const long double* table, int taps, int phases) {
+    resample_kernel(input, output, num, start, step, table, taps, phases);
+}
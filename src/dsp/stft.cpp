@@ -0,0 +1,113 @@
+/**
+ * @file stft.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations of streaming STFT components
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "dsp/stft.hpp"
+
+#include <algorithm>
+
+void STFTAnalysis::prepare(int size, int hop, WindowType type) {
+
+    this->fsize = size;
+    this->hop_size = hop;
+
+    this->window = window_table<sample_t>(type, size);
+    this->frame.assign(size, 0);
+
+    this->plan.prepare(size);
+}
+
+void STFTAnalysis::analyze(const sample_t* input, std::complex<sample_t>* spectrum) {
+
+    // Window the frame and transform:
+
+    apply_window(input, this->window.data(), this->frame.data(), this->fsize);
+
+    this->plan.forward(this->frame.data(), spectrum);
+}
+
+void STFTSynthesis::prepare(int size, int hop, WindowType type) {
+
+    this->fsize = size;
+    this->hop_size = hop;
+
+    this->window = window_table<sample_t>(type, size);
+    this->frame.assign(size, 0);
+    this->accum.assign(size, 0);
+    this->norm.assign(hop, 0);
+
+    // Sum the power of every window that overlaps each output position:
+
+    for (int i = 0; i < hop; ++i) {
+
+        sample_t total = 0;
+
+        for (int j = i; j < size; j += hop) {
+
+            total += this->window[j] * this->window[j];
+        }
+
+        // Positions no window covers are left alone:
+
+        this->norm[i] = total > 1e-12 ? 1 / total : 1;
+    }
+
+    this->plan.prepare(size);
+}
+
+void STFTSynthesis::synthesize(const std::complex<sample_t>* spectrum, sample_t* output) {
+
+    // Transform back and window:
+
+    this->plan.inverse(spectrum, this->frame.data());
+
+    apply_window(this->frame.data(), this->window.data(), this->frame.data(), this->fsize);
+
+    // Overlap-add into the accumulator:
+
+    for (int i = 0; i < this->fsize; ++i) {
+
+        this->accum[i] += this->frame[i];
+    }
+
+    // Output the finished samples:
+
+    for (int i = 0; i < this->hop_size; ++i) {
+
+        output[i] = this->accum[i] * this->norm[i];
+    }
+
+    // Shift the accumulator:
+
+    std::copy(this->accum.begin() + this->hop_size, this->accum.end(), this->accum.begin());
+    std::fill(this->accum.end() - this->hop_size, this->accum.end(), 0);
+}
+
+void STFT::prepare(int size, int hop, WindowType type) {
+
+    this->analysis.prepare(size, hop, type);
+    this->synthesis.prepare(size, hop, type);
+
+    this->input_frame.assign(size, 0);
+    this->output_hop.assign(hop, 0);
+    this->spectrum.assign(this->bins(), 0);
+
+    this->fill = size - hop;
+}
+
+void STFT::reset() {
+
+    std::ranges::fill(this->input_frame, 0);
+    std::ranges::fill(this->output_hop, 0);
+
+    this->synthesis.reset();
+
+    this->fill = this->size() - this->hop();
+}
@@ -0,0 +1,170 @@
+/**
+ * @file tables.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Compile time tables for transforms and windows
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "dsp/tables.hpp"
+
+namespace {
+
+/// PI to long double precision
+constexpr long double PI = 3.141592653589793238462643383279502884L;
+
+/**
+ * @brief Computes a sine at compile time
+ *
+ * We sum the Taylor series until it stops changing,
+ * which converges quickly for the small angles we use.
+ *
+ * @param x Angle in radians, in [0, PI / 4]
+ * @return long double Sine of the angle
+ */
+constexpr long double series_sin(long double x) {
+
+    long double sum = x;
+    long double term = x;
+
+    for (int n = 1; n < 30; ++n) {
+
+        term *= -x * x / static_cast<long double>((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+
+    return sum;
+}
+
+/**
+ * @brief Computes a cosine at compile time
+ *
+ * @param x Angle in radians, in [0, PI / 4]
+ * @return long double Cosine of the angle
+ */
+constexpr long double series_cos(long double x) {
+
+    long double sum = 1;
+    long double term = 1;
+
+    for (int n = 1; n < 30; ++n) {
+
+        term *= -x * x / static_cast<long double>((2 * n - 1) * (2 * n));
+        sum += term;
+    }
+
+    return sum;
+}
+
+/**
+ * @brief Computes sin(2 * PI * num / den) at compile time
+ *
+ * The angle is reduced with exact integer math,
+ * so only angles in [0, PI / 4] reach the series.
+ *
+ * @param num Numerator of the fraction of a period
+ * @param den Denominator of the fraction of a period
+ * @return long double Sine of the angle
+ */
+constexpr long double turn_sin(long long num, long long den) {
+
+    num %= den;
+
+    if (num < 0) {
+
+        num += den;
+    }
+
+    // Mirror into the first half, and then the first quarter:
+
+    long double sign = 1;
+
+    if (2 * num > den) {
+
+        num = den - num;
+        sign = -1;
+    }
+
+    if (4 * num > den) {
+
+        num = den - 2 * num;
+        den *= 2;
+    }
+
+    // Use the cosine near the top of the quarter:
+
+    if (8 * num > den) {
+
+        return sign * series_cos(2 * PI * static_cast<long double>(den - 4 * num) / static_cast<long double>(4 * den));
+    }
+
+    return sign * series_sin(2 * PI * static_cast<long double>(num) / static_cast<long double>(den));
+}
+
+/**
+ * @brief Computes cos(2 * PI * num / den) at compile time
+ *
+ * @param num Numerator of the fraction of a period
+ * @param den Denominator of the fraction of a period
+ * @return long double Cosine of the angle
+ */
+constexpr long double turn_cos(long long num, long long den) { return turn_sin(4 * num + den, 4 * den); }
+
+constexpr std::array<long double, TABLE_MAX_SIZE / 4 + 1> make_quarter_sine() {
+
+    std::array<long double, TABLE_MAX_SIZE / 4 + 1> out {};
+
+    for (int k = 0; k <= TABLE_MAX_SIZE / 4; ++k) {
+
+        out[k] = turn_sin(k, TABLE_MAX_SIZE);
+    }
+
+    return out;
+}
+
+constexpr std::array<uint16_t, TABLE_MAX_SIZE> make_bit_reverse() {
+
+    std::array<uint16_t, TABLE_MAX_SIZE> out {};
+
+    for (int i = 0; i < TABLE_MAX_SIZE; ++i) {
+
+        int rev = 0;
+
+        for (int b = 0; b < TABLE_MAX_BITS; ++b) {
+
+            rev |= ((i >> b) & 1) << (TABLE_MAX_BITS - 1 - b);
+        }
+
+        out[i] = static_cast<uint16_t>(rev);
+    }
+
+    return out;
+}
+
+constexpr std::array<long double, WINDOW_TABLE_SIZE> make_window_cosine() {
+
+    std::array<long double, WINDOW_TABLE_SIZE> out {};
+
+    int pos = 0;
+
+    for (int size = TABLE_MIN_SIZE; size <= TABLE_MAX_SIZE; size *= 2) {
+
+        for (int n = 0; n < size / 2; ++n) {
+
+            out[pos++] = turn_cos(n, size - 1);
+        }
+    }
+
+    return out;
+}
+
+}  // namespace
+
+constinit const std::array<long double, TABLE_MAX_SIZE / 4 + 1> QUARTER_SINE = make_quarter_sine();
+
+constinit const std::array<uint16_t, TABLE_MAX_SIZE> BIT_REVERSE = make_bit_reverse();
+
+constinit const std::array<long double, WINDOW_TABLE_SIZE> WINDOW_COSINE = make_window_cosine();
@@ -0,0 +1,27 @@
+/**
+ * @file target.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Build helpers for batch kernels
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * This private header contains helpers used when building
+ * the batch kernels in the DSP library.
+ */
+
+#pragma once
+
+/**
+ * @brief Builds a kernel for multiple instruction sets
+ *
+ * When supported, the compiler will generate one version of the function
+ * for each target listed here,
+ * and will pick the best one for the CPU at load time.
+ */
+#if defined(__GNUC__) && defined(__x86_64__) && !defined(__clang__)
+#define MAEC_KERNEL_CLONES __attribute__((target_clones("avx2", "default")))
+#else
+#define MAEC_KERNEL_CLONES
+#endif
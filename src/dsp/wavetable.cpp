@@ -0,0 +1,231 @@
+/**
+ * @file wavetable.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations of band-limited wavetables
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#define _USE_MATH_DEFINES  // NOLINT(bugprone-reserved-identifier): Required to get access to M_PI
+
+#include "dsp/wavetable.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "dsp/target.hpp"
+
+namespace {
+
+/**
+ * @brief Determines the amplitude of a harmonic of a waveform
+ *
+ * These are the sine coefficients of the Fourier series of each waveform.
+ *
+ * @param type Waveform to use
+ * @param harmonic Harmonic number, starting at 1
+ * @return long double Amplitude of the harmonic
+ */
+long double harmonic_amplitude(Waveform type, int harmonic) {
+
+    const auto h = static_cast<long double>(harmonic);
+    const bool odd = (harmonic % 2) == 1;
+
+    switch (type) {
+
+        case Waveform::Square:
+            return odd ? 4 / (M_PIl * h) : 0;
+
+        case Waveform::Sawtooth:
+            return (odd ? 2 : -2) / (M_PIl * h);
+
+        case Waveform::Triangle:
+            return odd ? ((harmonic % 4) == 1 ? 8 : -8) / (M_PIl * M_PIl * h * h) : 0;
+
+        default:
+            return harmonic == 1 ? 1 : 0;
+    }
+}
+
+/**
+ * @brief Process-wide cache of wavetables
+ *
+ * Tables are stored behind pointers,
+ * so the memory never moves once handed out.
+ *
+ * @tparam T Type of the samples
+ */
+template <typename T>
+struct WavetableCache {
+
+    /// Lock guarding the tables
+    std::mutex lock;
+
+    /// Tables keyed by waveform
+    std::map<Waveform, std::unique_ptr<Wavetable<T>>> tables;
+
+    /**
+     * @brief Gets a table, creating it if necessary
+     *
+     * @param type Waveform to get
+     * @return const Wavetable<T>& Shared table
+     */
+    const Wavetable<T>& get(Waveform type) {
+
+        const std::lock_guard<std::mutex> guard(this->lock);
+
+        auto iter = this->tables.find(type);
+
+        if (iter != this->tables.end()) {
+
+            return *(iter->second);
+        }
+
+        // Tables outlive any arena, so never take memory from one:
+
+        const ArenaScope scope(nullptr);
+
+        auto table = std::make_unique<Wavetable<T>>();
+
+        table->data.resize(static_cast<std::size_t>(WAVETABLE_LEVELS) * (WAVETABLE_SIZE + 1));
+
+        // One cycle of a sine, every harmonic is read from this:
+
+        std::vector<long double> sine(WAVETABLE_SIZE);
+
+        for (int i = 0; i < WAVETABLE_SIZE; ++i) {
+
+            sine[i] = std::sin(2 * M_PIl * i / WAVETABLE_SIZE);
+        }
+
+        // Sum the harmonics of each level:
+
+        std::vector<long double> level(WAVETABLE_SIZE);
+
+        for (int k = 0; k < WAVETABLE_LEVELS; ++k) {
+
+            std::ranges::fill(level, 0);
+
+            for (int h = 1; h <= (WAVETABLE_HARMONICS >> k); ++h) {
+
+                const long double amp = harmonic_amplitude(type, h);
+
+                if (amp == 0) {
+
+                    continue;
+                }
+
+                for (int i = 0; i < WAVETABLE_SIZE; ++i) {
+
+                    level[i] += amp * sine[(static_cast<int64_t>(h) * i) % WAVETABLE_SIZE];
+                }
+            }
+
+            // Copy into the table, repeating the first sample at the end:
+
+            T* out = table->data.data() + static_cast<std::ptrdiff_t>(k) * (WAVETABLE_SIZE + 1);
+
+            for (int i = 0; i < WAVETABLE_SIZE; ++i) {
+
+                out[i] = static_cast<T>(level[i]);
+            }
+
+            out[WAVETABLE_SIZE] = out[0];
+        }
+
+        const Wavetable<T>& out = *table;
+
+        this->tables.emplace(type, std::move(table));
+
+        return out;
+    }
+
+    /**
+     * @brief Frees all tables
+     *
+     */
+    void clear() {
+
+        const std::lock_guard<std::mutex> guard(this->lock);
+
+        this->tables.clear();
+    }
+
+    /**
+     * @brief Determines the number of tables
+     *
+     * @return std::size_t Number of tables
+     */
+    std::size_t size() {
+
+        const std::lock_guard<std::mutex> guard(this->lock);
+
+        return this->tables.size();
+    }
+};
+
+/**
+ * @brief Gets the global wavetable cache for a type
+ *
+ * @tparam T Type of the samples
+ * @return WavetableCache<T>& Global cache
+ */
+template <typename T>
+WavetableCache<T>& wavetable_cache() {
+
+    static WavetableCache<T> cache;
+
+    return cache;
+}
+
+template <typename T>
+inline void render_kernel(T* out, int size, const T* table, double start, double inc) {
+
+    for (int i = 0; i < size; ++i) {
+
+        // Determine the position in the table:
+
+        double turn = start + inc * i;
+        turn -= std::floor(turn);
+
+        const double pos = turn * WAVETABLE_SIZE;
+        const auto index = static_cast<int>(pos);
+        const auto frac = static_cast<T>(pos - index);
+
+        // Interpolate between the neighbours:
+
+        out[i] = table[index] + frac * (table[index + 1] - table[index]);
+    }
+}
+
+}  // namespace
+
+template <typename T>
+const Wavetable<T>& wavetable(Waveform type) { return wavetable_cache<T>().get(type); }
+
+template const Wavetable<float>& wavetable<float>(Waveform type);
+template const Wavetable<double>& wavetable<double>(Waveform type);
+template const Wavetable<long double>& wavetable<long double>(Waveform type);
+
+std::size_t wavetable_cache_size() { return wavetable_cache<float>().size() + wavetable_cache<double>().size() + wavetable_cache<long double>().size(); }
+
+void wavetable_cache_clear() {
+
+    wavetable_cache<float>().clear();
+    wavetable_cache<double>().clear();
+    wavetable_cache<long double>().clear();
+}
+
+MAEC_KERNEL_CLONES void wavetable_render(float* out, int size, const float* table, double start, double inc) { render_kernel(out, size, table, start, inc); }
+
+MAEC_KERNEL_CLONES void wavetable_render(double* out, int size, const double* table, double start, double inc) { render_kernel(out, size, table, start, inc); }
+
+void wavetable_render(long double* out, int size, const long double* table, double start, double inc) { render_kernel(out, size, table, start, inc); }
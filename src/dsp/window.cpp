@@ -12,6 +12,149 @@
 #include "dsp/window.hpp"
 
 #include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include "dsp/alloc.hpp"
+#include "dsp/tables.hpp"
+#include "dsp/target.hpp"
+#include "dsp/util.hpp"
+
+namespace {
+
+/**
+ * @brief Process-wide cache of window tables
+ *
+ * Tables are stored behind pointers,
+ * so the memory never moves once handed out.
+ *
+ * @tparam T Type of the coefficients
+ */
+template <typename T>
+struct WindowCache {
+
+    /// Storage type of one table
+    using table_type = std::vector<T, AlignedAllocator<T>>;
+
+    /// Lock guarding the tables
+    std::mutex lock;
+
+    /// Tables keyed by (type, size, parameter)
+    std::map<std::tuple<WindowType, int, double>, std::unique_ptr<table_type>> tables;
+
+    /**
+     * @brief Gets a table, creating it if necessary
+     *
+     * @param type Type of window
+     * @param size Size of the window
+     * @param param Parameter of the window
+     * @return std::span<const T> Window coefficients
+     */
+    std::span<const T> get(WindowType type, int size, double param) {
+
+        const std::lock_guard<std::mutex> guard(this->lock);
+
+        // Rectangle windows ignore the parameter, so share one table:
+
+        if (type == WindowType::Rectangle) {
+
+            param = 0;
+        }
+
+        const auto key = std::make_tuple(type, size, param);
+
+        auto iter = this->tables.find(key);
+
+        if (iter != this->tables.end()) {
+
+            return *(iter->second);
+        }
+
+        // Tables outlive any arena, so never take memory from one:
+
+        const ArenaScope scope(nullptr);
+
+        auto table = std::make_unique<table_type>(size);
+
+        for (int i = 0; i < size; ++i) {
+
+            (*table)[i] = static_cast<T>(window_value(type, i, size, param));
+        }
+
+        const std::span<const T> out = *table;
+
+        this->tables.emplace(key, std::move(table));
+
+        return out;
+    }
+
+    /**
+     * @brief Frees all tables
+     *
+     */
+    void clear() {
+
+        const std::lock_guard<std::mutex> guard(this->lock);
+
+        this->tables.clear();
+    }
+
+    /**
+     * @brief Determines the number of tables
+     *
+     * @return std::size_t Number of tables
+     */
+    std::size_t size() {
+
+        const std::lock_guard<std::mutex> guard(this->lock);
+
+        return this->tables.size();
+    }
+};
+
+/**
+ * @brief Gets the global window cache for a type
+ *
+ * @tparam T Type of the coefficients
+ * @return WindowCache<T>& Global cache
+ */
+template <typename T>
+WindowCache<T>& window_cache() {
+
+    static WindowCache<T> cache;
+
+    return cache;
+}
+
+/**
+ * @brief Computes cos(2 * PI * num / (size - 1))
+ *
+ * Common sizes are looked up in the compile time tables.
+ *
+ * @param num Current value to compute
+ * @param size Size of the window
+ * @return long double Window cosine
+ */
+long double window_cosine(int num, int size) {
+
+    if (window_table_covers(size) && num >= 0 && num < size) {
+
+        return table_window_cosine(num, size);
+    }
+
+    return std::cos(2 * M_PI * num / (size - 1));
+}
+
+template <typename T>
+inline void window_kernel(const T* input, const T* window, T* output, int size) {
+
+    multiply_signals(size, input, window, output);
+}
+
+}  // namespace
 
 long double window_rectangle(int, int) {  //NOLINT: Parameters not used in function
 
@@ -24,7 +167,7 @@ long double window_hann(int num, int size, double a0) {
 
     // Calculate and return:
 
-    return a0 - (1 - a0) * std::cos(2 * M_PI * num / (size - 1));
+    return a0 - (1 - a0) * window_cosine(num, size);
 }
 
 long double window_hamming(int num, int size, double a0) {
@@ -38,8 +181,11 @@ long double window_blackmanc(int num, int size, double alpha) {
 
     // Calculate and return:
 
-    return ((1 - alpha) / 2) - 0.5 * std::cos(2 * M_PI * num / (size - 1)) +
-           (alpha / 2) * std::cos(4 * M_PI * num / (size - 1));
+    // cos(2x) = 2 * cos(x)^2 - 1
+
+    const long double cosine = window_cosine(num, size);
+
+    return ((1 - alpha) / 2) - 0.5 * cosine + (alpha / 2) * (2 * cosine * cosine - 1);
 }
 
 long double window_blackman(int num, int size) {
@@ -48,3 +194,66 @@ long double window_blackman(int num, int size) {
 
     return window_blackmanc(num, size, 0.16);
 }
+
+double window_default(WindowType type) {
+
+    switch (type) {
+
+        case WindowType::Hann:
+            return 0.5;
+
+        case WindowType::Hamming:
+            return 0.54;
+
+        case WindowType::Blackman:
+            return 0.16;
+
+        default:
+            return 0;
+    }
+}
+
+long double window_value(WindowType type, int num, int size, double param) {
+
+    // A window of one value has nothing to taper:
+
+    if (size <= 1) {
+
+        return 1.;
+    }
+
+    switch (type) {
+
+        case WindowType::Hann:
+        case WindowType::Hamming:
+            return window_hann(num, size, param);
+
+        case WindowType::Blackman:
+            return window_blackmanc(num, size, param);
+
+        default:
+            return window_rectangle(num, size);
+    }
+}
+
+template <typename T>
+std::span<const T> window_table(WindowType type, int size, double param) { return window_cache<T>().get(type, size, param); }
+
+template std::span<const float> window_table<float>(WindowType type, int size, double param);
+template std::span<const double> window_table<double>(WindowType type, int size, double param);
+template std::span<const long double> window_table<long double>(WindowType type, int size, double param);
+
+std::size_t window_cache_size() { return window_cache<float>().size() + window_cache<double>().size() + window_cache<long double>().size(); }
+
+void window_cache_clear() {
+
+    window_cache<float>().clear();
+    window_cache<double>().clear();
+    window_cache<long double>().clear();
+}
+
+MAEC_KERNEL_CLONES void apply_window(const float* input, const float* window, float* output, int size) { window_kernel(input, window, output, size); }
+
+MAEC_KERNEL_CLONES void apply_window(const double* input, const double* window, double* output, int size) { window_kernel(input, window, output, size); }
+
+void apply_window(const long double* input, const long double* window, long double* output, int size) { window_kernel(input, window, output, size); }
@@ -0,0 +1,265 @@
+/**
+ * @file dynamics_module.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations for compressors and limiters
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "dynamics_module.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace {
+
+/// Decibels for each doubling of magnitude
+constexpr double DB_MAGNITUDE = 6.020599913279624;
+
+/// Decibels for each doubling of power
+constexpr double DB_POWER = DB_MAGNITUDE / 2;
+
+}  // namespace
+
+int CompressorModule::latency() { return static_cast<int>(std::lround(this->lookahead * this->get_info()->sample_rate)); }
+
+void CompressorModule::info_sync() {
+
+    AudioModule::info_sync();
+
+    this->get_info()->latency = this->latency();
+}
+
+void CompressorModule::footprint(MemoryFootprint& usage) const {
+
+    AudioModule::footprint(usage);
+
+    for (const auto& line : this->lines) {
+
+        usage.state += line.bytes();
+    }
+
+    usage.state += heap_bytes(this->level) + heap_bytes(this->gain) + heap_bytes(this->chan_data) + heap_bytes(this->delayed);
+}
+
+void CompressorModule::start() {
+
+    AudioModule::start();
+
+    this->get_info()->latency = this->latency();
+
+    this->prepare(this->get_info()->channels, this->max_block_size());
+}
+
+void CompressorModule::prepare(int channels, int block) {
+
+    // Create a silent delay for each channel, and a hold of the same length:
+
+    this->delay = this->latency();
+
+    this->lines.assign(static_cast<std::size_t>(std::max(channels, 1)), DelayLine<sample_t>(this->delay, block));
+    this->hold.set_window(static_cast<std::size_t>(this->delay) + 1);
+
+    // Reset the detector:
+
+    this->envelope = 0;
+    this->power = 0;
+    this->reduction = 0;
+    this->quiet = 0;
+
+    // Allocate the scratch space for each block:
+
+    const auto size = static_cast<std::size_t>(block);
+
+    this->level.resize(size);
+    this->gain.resize(size);
+    this->chan_data.resize(size);
+    this->delayed.resize(size);
+}
+
+void CompressorModule::detect(const AudioBuffer& data, int num) {
+
+    const int channels = data.channels();
+    const int frames = std::min(num, static_cast<int>(data.size()) / channels);
+
+    const auto scale = static_cast<sample_t>(1.0 / channels);
+
+    for (int c = 0; c < channels; ++c) {
+
+        // Find the samples of this channel:
+
+        const sample_t* samples = this->chan_data.data();
+
+        if constexpr (AudioBuffer::layout::planar) {
+
+            samples = data.data() + AudioBuffer::layout::offset(c, 0, channels, data.channel_capacity());
+        }
+
+        else {
+
+            const sample_t* source = data.data();
+
+            for (int i = 0; i < frames; ++i) {
+
+                this->chan_data[i] = source[static_cast<std::ptrdiff_t>(i) * channels + c];
+            }
+        }
+
+        // Add them to the level:
+
+        if (this->detector == DynDetector::Peak) {
+
+            dyn_peak(samples, this->level.data(), frames);
+        }
+
+        else {
+
+            dyn_square(samples, this->level.data(), frames, scale);
+        }
+    }
+}
+
+void CompressorModule::process() {
+
+    const int channels = this->buff->channels();
+    const auto frames = static_cast<int>(this->buff->size()) / channels;
+
+    // Ensure we have a delay for each channel, with room for this block:
+
+    if (this->lines.size() != static_cast<std::size_t>(channels) || static_cast<std::size_t>(frames) > this->level.size() || this->delay != this->latency()) {
+
+        this->prepare(channels, std::max(frames, this->max_block_size()));
+    }
+
+    // Determine the smoothing coefficients:
+
+    const double srate = this->get_info()->sample_rate;
+
+    const auto att = static_cast<sample_t>(dyn_coefficient(this->attack, srate));
+    const auto rel = static_cast<sample_t>(dyn_coefficient(this->release, srate));
+    const auto mean = static_cast<sample_t>(dyn_coefficient(this->rms_window, srate));
+
+    const ParamRate rate = this->sidechain.get_rate();
+
+    // Silence in is silence out once the delay has emptied, the detector simply releases:
+
+    if (rate == ParamRate::Constant && this->buff->is_silent() && this->quiet > static_cast<std::size_t>(this->delay)) {
+
+        this->quiet += static_cast<std::size_t>(frames);
+
+        this->envelope *= static_cast<sample_t>(std::pow(rel, frames));
+        this->power *= static_cast<sample_t>(std::pow(mean, frames));
+        this->reduction = this->envelope;
+
+        this->hold.reset();
+
+        return;
+    }
+
+    // Follow the level of the detector input:
+
+    std::fill_n(this->level.begin(), frames, 0);
+
+    if (rate == ParamRate::Audio) {
+
+        const SharedBuffer side = this->sidechain.share();
+
+        this->detect(*side, frames);
+    }
+
+    else if (rate == ParamRate::Control) {
+
+        const std::pair<sample_t, sample_t> control = this->sidechain.get_control();
+
+        for (int i = 0; i < frames; ++i) {
+
+            const sample_t val = std::fabs(control.first + (control.second - control.first) * static_cast<sample_t>(i + 1) / static_cast<sample_t>(frames));
+
+            this->level[i] = this->detector == DynDetector::Peak ? val : val * val;
+        }
+    }
+
+    else {
+
+        this->detect(*(this->buff), frames);
+    }
+
+    if (this->detector == DynDetector::RMS) {
+
+        dyn_smooth(this->level.data(), frames, mean, mean, this->power);
+    }
+
+    // Hold each peak over the lookahead, and determine the smoothed reduction:
+
+    this->hold.process(this->level.data(), frames);
+
+    const double scale = this->detector == DynDetector::Peak ? DB_MAGNITUDE : DB_POWER;
+
+    dyn_reduction(this->level.data(), this->gain.data(), frames, this->curve, static_cast<sample_t>(scale));
+    dyn_smooth(this->gain.data(), frames, att, rel, this->envelope);
+
+    this->reduction = frames > 0 ? *std::min_element(this->gain.begin(), this->gain.begin() + frames) : this->envelope;
+
+    dyn_gain(this->gain.data(), this->level.data(), frames, static_cast<sample_t>(this->curve.makeup));
+
+    // Delay and scale each channel:
+
+    this->buff->clear_constant();
+
+    bool loud = false;
+
+    sample_t state = 0;
+
+    for (int c = 0; c < channels; ++c) {
+
+        sample_t* data = this->chan_data.data();
+
+        if constexpr (AudioBuffer::layout::planar) {
+
+            data = this->buff->data() + AudioBuffer::layout::offset(c, 0, channels, this->buff->channel_capacity());
+        }
+
+        else {
+
+            const sample_t* source = this->buff->data();
+
+            for (int i = 0; i < frames; ++i) {
+
+                data[i] = source[static_cast<std::ptrdiff_t>(i) * channels + c];
+            }
+        }
+
+        for (int i = 0; i < frames; ++i) {
+
+            loud = loud || std::fabs(data[i]) > SILENCE_LEVEL;
+        }
+
+        if (this->delay > 0) {
+
+            this->lines[c].write(data, frames);
+            this->lines[c].read(this->delayed.data(), frames, static_cast<double>(this->delay), DelayInterp::None, frames, state);
+
+            std::copy_n(this->delayed.begin(), frames, data);
+        }
+
+        dyn_apply(data, this->level.data(), frames);
+
+        if constexpr (!AudioBuffer::layout::planar) {
+
+            sample_t* dest = this->buff->data();
+
+            for (int i = 0; i < frames; ++i) {
+
+                dest[static_cast<std::ptrdiff_t>(i) * channels + c] = data[i];
+            }
+        }
+    }
+
+    // Keep track of how long we have only taken in silence:
+
+    this->quiet = loud ? 0 : this->quiet + static_cast<std::size_t>(frames);
+}
@@ -0,0 +1,352 @@
+/**
+ * @file engine.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations for running chains on real-time threads
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "engine.hpp"
+
+#include "chrono.hpp"
+#include "dsp/denormal.hpp"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/// Size of the stack to fault in when locking memory
+constexpr std::size_t stack_prefault = 64 * 1024;
+
+/**
+ * @brief Touches a chunk of the stack
+ *
+ * This ensures the pages are resident before we start processing.
+ */
+void prefault_stack() {
+
+    unsigned char chunk[stack_prefault];
+
+    for (std::size_t i = 0; i < stack_prefault; i += 4096) {
+
+        chunk[i] = 0;
+    }
+
+    // Tell the compiler the chunk is used, so the stores are kept:
+
+    asm volatile("" : : "r"(chunk) : "memory");
+}
+
+}  // namespace
+
+RTStatus apply_rt(const RTConfig& config) {
+
+    RTStatus status;
+
+#ifdef __linux__
+
+    // Lock our memory first, so the rest of our setup is resident:
+
+    if (config.lock_memory && mlockall(MCL_CURRENT | MCL_FUTURE) == 0) {
+
+        status.locked = true;
+
+        prefault_stack();
+    }
+
+    // Pin to the CPU:
+
+    if (config.cpu >= 0 && config.cpu < CPU_SETSIZE) {
+
+        cpu_set_t set;
+
+        CPU_ZERO(&set);
+        CPU_SET(config.cpu, &set);
+
+        status.pinned = pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+    }
+
+    // Request real-time scheduling:
+
+    if (config.priority > 0) {
+
+        sched_param param;
+
+        std::memset(&param, 0, sizeof(param));
+
+        param.sched_priority = std::min(config.priority, sched_get_priority_max(SCHED_FIFO));
+
+        status.scheduled = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+    }
+
+#endif
+
+    return status;
+}
+
+int prepare_chain(AudioModule* sink) {
+
+    std::set<AudioModule*> seen;
+
+    std::vector<AudioModule*> stack = {sink};
+    std::vector<AudioModule*> inputs;
+
+    while (!stack.empty()) {
+
+        AudioModule* mod = stack.back();
+        stack.pop_back();
+
+        if (mod == nullptr || !seen.insert(mod).second) {
+
+            continue;
+        }
+
+        mod->prepare();
+
+        // Modules that must be meta processed as a whole may hide their inputs,
+        // so we follow their backward module instead:
+
+        inputs.clear();
+
+        if (!mod->plan_inputs(inputs) && inputs.empty()) {
+
+            inputs.push_back(mod->get_backward());
+        }
+
+        stack.insert(stack.end(), inputs.begin(), inputs.end());
+    }
+
+    return static_cast<int>(seen.size());
+}
+
+int warm_chain(AudioModule* sink, int blocks) {
+
+    AudioModule* back = sink->get_backward();
+    ChainInfo* chain = sink->get_chain_info();
+
+    if (back == nullptr || chain == nullptr) {
+
+        return 0;
+    }
+
+    // Keep the events, so they are delivered again when we really start:
+
+    const EventQueue events = chain->events;
+    const int64_t sample = chain->sample;
+
+    // Sources output silence, so they are not advanced:
+
+    chain->warming = true;
+
+    int done = 0;
+
+    for (; done < blocks; ++done) {
+
+        back->meta_process();
+
+        BufferPointer block = back->get_buffer();
+
+        if (block != nullptr) {
+
+            chain->pool.reclaim(std::move(block));
+        }
+    }
+
+    chain->warming = false;
+    chain->events = events;
+    chain->sample = sample;
+
+    return done;
+}
+
+void Engine::prepare() {
+
+    if (this->ready.load()) {
+
+        return;
+    }
+
+    const int64_t start = get_time();
+
+    // Sync and start the chain:
+
+    this->sink->meta_info_sync();
+    this->sink->meta_start();
+
+    // Chains over their memory budget are stopped, and never become ready:
+
+    auto* chain = this->sink->get_chain_info();
+
+    if (chain != nullptr && chain->over_budget) {
+
+        return;
+    }
+
+    // Prepare each module:
+
+    this->status.prepared = prepare_chain(this->sink);
+
+    // Fill the buffer pool:
+
+    this->status.prefaulted = 0;
+
+    if (chain != nullptr && this->config.prefault > 0) {
+
+        const int before = static_cast<int>(chain->pool.available());
+
+        chain->pool.reserve(this->config.prefault, chain->buffer_size, chain->channels);
+
+        this->status.prefaulted = static_cast<int>(chain->pool.available()) - before;
+    }
+
+    // Render the warm-up blocks:
+
+    this->status.warmed = this->config.warmup > 0 ? warm_chain(this->sink, this->config.warmup) : 0;
+
+    this->status.prepare_time = get_time() - start;
+
+    this->ready = true;
+}
+
+void Engine::apply() {
+
+    RTStatus applied = apply_rt(this->config);
+
+    applied.prefaulted = this->status.prefaulted;
+    applied.prepared = this->status.prepared;
+    applied.warmed = this->status.warmed;
+    applied.prepare_time = this->status.prepare_time;
+    applied.flushed = this->flush();
+
+    this->status = applied;
+}
+
+bool Engine::chain_done() const {
+
+    auto* chain = this->sink->get_chain_info();
+
+    return chain != nullptr && chain->module_finish >= chain->module_num;
+}
+
+bool Engine::flush() const {
+
+    const auto* chain = this->sink->get_chain_info();
+
+    if (chain != nullptr && chain->flush_denormals) {
+
+        set_flush_to_zero(true);
+    }
+
+    return flush_to_zero();
+}
+
+void Engine::loop(long num) {
+
+    for (long i = 0; (num < 0 || i < num) && this->running.load(std::memory_order_relaxed); ++i) {
+
+        this->sink->meta_process();
+
+        if (this->chain_done()) {
+
+            break;
+        }
+    }
+}
+
+RTStatus Engine::run(long num) {
+
+    // Prepare the chain:
+
+    this->prepare();
+
+    if (!this->ready.load()) {
+
+        return this->status;
+    }
+
+    // Apply our options:
+
+    this->apply();
+
+    // Process the chain:
+
+    this->running = true;
+
+    this->loop(num);
+
+    this->running = false;
+
+    // Stop the chain:
+
+    this->sink->meta_stop();
+
+    this->ready = false;
+
+    return this->status;
+}
+
+void Engine::start() {
+
+    if (this->thread.joinable()) {
+
+        return;
+    }
+
+    // Prepare the chain:
+
+    this->prepare();
+
+    if (!this->ready.load()) {
+
+        return;
+    }
+
+    // Start the processing thread:
+
+    this->running = true;
+
+    this->thread = std::thread([this]() {
+
+        this->apply();
+
+        this->loop(-1);
+
+        this->running = false;
+    });
+}
+
+void Engine::stop() {
+
+    if (this->thread.joinable()) {
+
+        // Stop the thread:
+
+        this->running = false;
+
+        this->thread.join();
+    }
+
+    else if (!this->ready.load()) {
+
+        return;
+    }
+
+    // Stop the chain:
+
+    this->sink->meta_stop();
+
+    this->ready = false;
+}
@@ -9,9 +9,11 @@
  * 
  */
 
+#include <algorithm>
 #include <cmath>
 
 #include "envelope.hpp"
+#include "dsp/ramp.hpp"
 
 int64_t BaseEnvelope::get_time_inc() {
 
@@ -29,6 +31,29 @@ int64_t BaseEnvelope::get_time_inc() {
 
 }
 
+int64_t BaseEnvelope::ramp_length(int64_t size) const {
+
+    // Determine if this envelope is finished:
+
+    if (this->time_diff() <= 0) {
+
+        return 0;
+    }
+
+    // Determine the number of samples before the stop time, rounding up:
+
+    const int64_t left = this->stop_time - this->get_time();
+
+    if (left <= 0) {
+
+        return 0;
+    }
+
+    const int64_t npf = this->timer.get_npf();
+
+    return std::min(size, (left + npf - 1) / npf);
+}
+
 void DurationEnvelope::start() {
 
     // First, set the start time to value from timer:
@@ -50,9 +75,9 @@ void ConstantEnvelope::process() {
 
     this->set_buffer(this->create_buffer());
 
-    // Fill the buffer:
+    // Fill the buffer, marking it as constant:
 
-    std::fill(this->buff->sbegin(), this->buff->send(), this->get_start_value());
+    this->buff->fill_constant(this->get_start_value());
 
     // Set the time:
 
@@ -77,9 +102,16 @@ void SetValue::process() {
 
     // Fill in the buffer:
 
-    std::fill_n(this->buff->ibegin(), initial, this->get_start_value());
+    std::ranges::fill(this->buff->span().first(initial), this->get_start_value());
 
-    std::fill_n(this->buff->ibegin() + initial, after, this->get_stop_value());
+    std::ranges::fill(this->buff->span().subspan(initial, after), this->get_stop_value());
+
+    // Determine if we hold a single value for the whole block:
+
+    if (initial == 0 || after == 0) {
+
+        this->buff->set_constant(initial == 0 ? this->get_stop_value() : this->get_start_value());
+    }
 
     // Set the time:
 
@@ -92,21 +124,39 @@ void ExponentialRamp::process() {
 
     this->set_buffer(this->create_buffer());
 
-    // Iterate over values in buffer:
+    const auto size = static_cast<int64_t>(this->buff->size());
+
+    // Determine the number of samples to ramp:
+
+    const int64_t ramp = this->ramp_length(size);
+
+    if (ramp > 0) {
+
+        // Determine our position and the step per sample, in ramp units:
+
+        const auto diff = static_cast<double>(this->time_diff());
+        const double pos = static_cast<double>(this->get_time() - this->get_start_time()) / diff;
+        const double step = static_cast<double>(this->get_timer()->get_npf()) / diff;
+
+        // Fill the ramp:
+
+        const auto base = static_cast<double>(this->val_divide());
+
+        ramp_exponential(this->buff->data(), static_cast<int>(ramp), this->get_start_value() * std::pow(base, pos), std::pow(base, step));
+    }
+
+    // Hold the stop value for the rest of the block:
 
-    for (auto iter = this->buff->ibegin();
-         static_cast<unsigned int>(iter.get_index()) < this->buff->size();
-         ++iter) {
+    std::fill(this->buff->data() + ramp, this->buff->data() + size, this->get_stop_value());
 
-        // Determine value at current time:
+    if (ramp == 0) {
 
-        *iter = this->get_start_value() *
-                std::pow<long double, long double>(
-                    this->val_divide(),
-                    static_cast<long double>(this->get_time_inc() -
-                                             this->get_start_time()) /
-                        static_cast<long double>(this->time_diff()));
+        this->buff->set_constant(this->get_stop_value());
     }
+
+    // Set the time:
+
+    this->get_timer()->add_sample(static_cast<int>(size));
 }
 
 void LinearRamp::process() {
@@ -115,20 +165,39 @@ void LinearRamp::process() {
 
     this->set_buffer(this->create_buffer());
 
-    // Iterate over values in buffer:
+    const auto size = static_cast<int64_t>(this->buff->size());
+
+    // Determine the number of samples to ramp:
+
+    const int64_t ramp = this->ramp_length(size);
+
+    if (ramp > 0) {
+
+        // Determine our position and the step per sample, in ramp units:
+
+        const auto diff = static_cast<double>(this->time_diff());
+        const double pos = static_cast<double>(this->get_time() - this->get_start_time()) / diff;
+        const double step = static_cast<double>(this->get_timer()->get_npf()) / diff;
+
+        // Fill the ramp:
+
+        const auto vdiff = static_cast<double>(this->val_diff());
+
+        ramp_linear(this->buff->data(), static_cast<int>(ramp), this->get_start_value() + vdiff * pos, vdiff * step);
+    }
+
+    // Hold the stop value for the rest of the block:
 
-    for (auto iter = this->buff->ibegin();
-         static_cast<unsigned int>(iter.get_index()) < this->buff->size();
-         ++iter) {
+    std::fill(this->buff->data() + ramp, this->buff->data() + size, this->get_stop_value());
 
-        // Determine value at current time:
+    if (ramp == 0) {
 
-        *iter = this->get_start_value() +
-                this->val_diff() *
-                    (static_cast<long double>(this->get_time_inc() -
-                                              this->get_start_time()) /
-                     static_cast<long double>(this->time_diff()));
+        this->buff->set_constant(this->get_stop_value());
     }
+
+    // Set the time:
+
+    this->get_timer()->add_sample(static_cast<int>(size));
 }
 
 void ChainEnvelope::add_envelope(BaseEnvelope* env) {
@@ -189,7 +258,7 @@ void ChainEnvelope::create_internal(int index) {
 
     // Create the InternalEnvelope:
 
-    std::unique_ptr<InternalEnvelope> interp = std::make_unique<InternalEnvelope>();
+    ModulePointer<InternalEnvelope> interp = make_module<InternalEnvelope>();
 
     // Determine start value and time:
 
@@ -253,18 +322,36 @@ void ChainEnvelope::process() {
 
     int processed = 0;
 
+    // Determine if each envelope held a single value:
+
+    bool constant = true;
+    sample_t value = 0;
+
     // Iterate until buffer is full:
 
-    while (processed < this->get_info()->out_buffer) {
+    const int size = this->block_size();
+
+    while (processed < size) {
 
-        int num = this->get_info()->out_buffer - processed;
+        int num = size - processed;
 
         // First, determine the number of samples current envelope will output:
 
         if (this->current->get_stop_time() >= 0) {
 
-            num = std::min(num, static_cast<int>(this->current->remaining_samples()));
+            const int64_t left = this->current->remaining_samples();
+
+            // Less than a sample may be left when frames are not a whole number of nanoseconds,
+            // in which case the envelope is done:
+
+            if (left <= 0) {
+
+                this->next_envelope();
+
+                continue;
+            }
 
+            num = std::min(num, static_cast<int>(left));
         }
 
         // Set size of current envelope to num value:
@@ -279,7 +366,20 @@ void ChainEnvelope::process() {
 
         // First, fill it with contents of first envelope:
 
-        std::copy_n(cbuff->ibegin(), num, tbuff->ibegin()+processed);
+        std::ranges::copy(cbuff->span().first(num), tbuff->data() + processed);
+
+        // The block stays constant if every envelope held the same value:
+
+        if (!cbuff->is_constant() || (processed > 0 && cbuff->get_constant() != value)) {
+
+            constant = false;
+        }
+
+        value = cbuff->get_constant();
+
+        // Hand the envelope buffer back:
+
+        this->current->reclaim_buffer(std::move(cbuff));
 
         // Update the number of samples processed:
 
@@ -298,6 +398,11 @@ void ChainEnvelope::process() {
 
     }
 
+    if (constant && processed > 0) {
+
+        tbuff->set_constant(value);
+    }
+
     // Finally, set the buffer:
 
     this->set_buffer(std::move(tbuff));
@@ -307,7 +412,7 @@ void ADSREnvelope::start() {
 
     // Add linear ramp for attack:
 
-    std::unique_ptr<BaseEnvelope> att = std::make_unique<LinearRamp>();
+    ModulePointer<BaseEnvelope> att = make_module<LinearRamp>();
 
     att->set_start_value(0);
     att->set_stop_value(1);
@@ -319,7 +424,7 @@ void ADSREnvelope::start() {
 
     // Add linear ramp for decay:
 
-    std::unique_ptr<BaseEnvelope> dec = std::make_unique<LinearRamp>();
+    ModulePointer<BaseEnvelope> dec = make_module<LinearRamp>();
 
     dec->set_start_value(1);
     dec->set_stop_value(this->sustain);
@@ -331,7 +436,7 @@ void ADSREnvelope::start() {
 
     // Add constant ramp for sustain:
 
-    std::unique_ptr<BaseEnvelope> sus = std::make_unique<ConstantEnvelope>();
+    ModulePointer<BaseEnvelope> sus = make_module<ConstantEnvelope>();
 
     sus->set_start_value(this->sustain);
     sus->set_stop_value(this->sustain);
@@ -341,11 +446,84 @@ void ADSREnvelope::start() {
     this->add_envelope(sus.get());
     this->envs.add_object(sus);
 
-    // 
+    // Begin with the attack:
 
+    this->last = 0;
+
+    ChainEnvelope::start();
+}
+
+void ADSREnvelope::process() {
+
+    // Determine if we have been released:
+
+    const auto state = this->get_state();
+
+    if (state != State::Finishing && state != State::Finished) {
+
+        ChainEnvelope::process();
+
+        // Remember where we are, in case we are released:
+
+        if (this->buff->size() > 0) {
+
+            this->last = this->buff->at(this->buff->size() - 1);
+        }
+
+        return;
+    }
+
+    // Create a buffer for use:
+
+    this->set_buffer(this->create_buffer());
+
+    const auto size = static_cast<int64_t>(this->buff->size());
+
+    // Determine the number of samples left in the release, rounding up:
+
+    const int64_t npf = this->get_timer()->get_npf();
+    const int64_t left = this->release_start + this->release - this->get_time();
+
+    const int64_t ramp = left > 0 ? std::min(size, (left + npf - 1) / npf) : 0;
+
+    if (ramp > 0) {
+
+        // Ramp from the released value down to zero:
+
+        const auto rel = static_cast<double>(this->release);
+        const double pos = static_cast<double>(this->get_time() - this->release_start) / rel;
+        const double step = static_cast<double>(npf) / rel;
+
+        ramp_linear(this->buff->data(), static_cast<int>(ramp), this->release_value * (1 - pos), -this->release_value * step);
+    }
+
+    // The rest of the block is silent:
+
+    std::fill(this->buff->data() + ramp, this->buff->data() + size, 0);
+
+    if (ramp == 0) {
+
+        this->buff->set_constant(0);
+    }
+
+    // Determine if the release completed:
+
+    if (ramp < size && state == State::Finishing) {
+
+        this->done();
+    }
+
+    // Set the time:
+
+    this->get_timer()->add_sample(static_cast<int>(size));
 }
 
 void ADSREnvelope::finish() {
 
-    // Ca
+    BaseModule::finish();
+
+    // Release from the last value we produced:
+
+    this->release_start = this->get_time();
+    this->release_value = this->last;
 }
@@ -0,0 +1,81 @@
+/**
+ * @file event.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations for event queues
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "event.hpp"
+
+#include <algorithm>
+
+#include "audio_module.hpp"
+
+void EventQueue::push(const Event& event) {
+
+    // Find the position after all events at or before this time:
+
+    auto iter = std::upper_bound(this->events.begin(), this->events.end(), event.sample,
+                                 [](int64_t sample, const Event& other) { return sample < other.sample; });
+
+    this->events.insert(iter, event);
+}
+
+int64_t EventQueue::next(const AudioModule* target, int64_t after, int64_t limit) const {
+
+    // Skip events at or before the given time:
+
+    auto iter = std::upper_bound(this->events.begin(), this->events.end(), after,
+                                 [](int64_t sample, const Event& other) { return sample < other.sample; });
+
+    // Find the first event for this module:
+
+    for (; iter != this->events.end() && iter->sample < limit; ++iter) {
+
+        if (iter->target == target) {
+
+            return iter->sample;
+        }
+    }
+
+    return limit;
+}
+
+int EventQueue::dispatch(AudioModule* target, int64_t until) {
+
+    int num = 0;
+
+    // Iterate over events at or before the given time:
+
+    for (std::size_t i = 0; i < this->events.size() && this->events[i].sample <= until;) {
+
+        if (this->events[i].target != target) {
+
+            ++i;
+
+            continue;
+        }
+
+        // Remove the event before handing it over,
+        // the module may schedule more events:
+
+        const Event event = this->events[i];
+
+        this->events.erase(this->events.begin() + static_cast<std::ptrdiff_t>(i));
+
+        target->on_event(event);
+
+        ++num;
+    }
+
+    return num;
+}
+
+void EventQueue::remove(const AudioModule* target) {
+
+    std::erase_if(this->events, [target](const Event& event) { return event.target == target; });
+}
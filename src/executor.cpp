@@ -0,0 +1,351 @@
+/**
+ * @file executor.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations for concurrent processing
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "executor.hpp"
+
+#include <algorithm>
+#include <string>
+
+#include "chrono.hpp"
+#include "dsp/denormal.hpp"
+#include "trace.hpp"
+
+namespace {
+
+/// Node of the worker running on this thread, -1 if not a worker
+thread_local int worker_node = -1;
+
+}  // namespace
+
+WorkerPool::WorkerPool(int threads, bool ftz) : flush(ftz) {
+
+    // Determine the number of threads:
+
+    if (threads <= 0) {
+
+        threads = std::max(static_cast<int>(std::thread::hardware_concurrency()) - 1, 1);
+    }
+
+    // Every worker lives on a single node:
+
+    this->launch(std::vector<int>(static_cast<std::size_t>(threads), 0));
+}
+
+WorkerPool::WorkerPool(const NumaTopology& topo, int per_node, bool ftz) : flush(ftz), topology(topo), pin(true), remote(false) {
+
+    // Place workers on each node, one for each CPU if not given:
+
+    std::vector<int> nodes;
+
+    for (int node = 0; node < this->topology.size(); ++node) {
+
+        const int count = per_node > 0 ? per_node : std::max(static_cast<int>(this->topology.get_cpus(node).size()), 1);
+
+        nodes.insert(nodes.end(), static_cast<std::size_t>(count), node);
+    }
+
+    if (nodes.empty()) {
+
+        nodes.push_back(0);
+    }
+
+    this->launch(nodes);
+}
+
+void WorkerPool::launch(const std::vector<int>& nodes) {
+
+    this->worker_nodes = nodes;
+
+    // Create the queues before starting any worker,
+    // as workers steal from every queue:
+
+    const int count = *std::max_element(nodes.begin(), nodes.end()) + 1;
+
+    this->node_queues.resize(static_cast<std::size_t>(count));
+    this->node_queued = std::vector<std::atomic<int>>(static_cast<std::size_t>(count));
+    this->node_counts.assign(static_cast<std::size_t>(count), 0);
+
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+
+        this->queues.push_back(std::make_unique<Queue>());
+        this->node_queues[nodes[i]].push_back(static_cast<int>(i));
+    }
+
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+
+        this->workers.emplace_back(&WorkerPool::worker_loop, this, static_cast<int>(i));
+    }
+}
+
+WorkerPool::~WorkerPool() {
+
+    // Tell the workers to stop:
+
+    {
+        const std::lock_guard<std::mutex> lock(this->sleep_mutex);
+
+        this->running = false;
+    }
+
+    this->wake.notify_all();
+
+    for (auto& worker : this->workers) {
+
+        worker.join();
+    }
+}
+
+bool WorkerPool::steal(int victim, Task& task) {
+
+    Queue& queue = *(this->queues[victim]);
+
+    const std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (queue.head == queue.tail) {
+
+        return false;
+    }
+
+    task = queue.tasks[queue.head++];
+
+    if (queue.head == queue.tail) {
+
+        queue.head = 0;
+        queue.tail = 0;
+    }
+
+    --(this->queued);
+    --(this->node_queued[this->worker_nodes[victim]]);
+
+    return true;
+}
+
+bool WorkerPool::take(int home, Task& task) {
+
+    // Try our own queue first:
+
+    if (home >= 0) {
+
+        Queue& queue = *(this->queues[home]);
+
+        const std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (queue.head != queue.tail) {
+
+            task = queue.tasks[--queue.tail];
+
+            if (queue.head == queue.tail) {
+
+                queue.head = 0;
+                queue.tail = 0;
+            }
+
+            --(this->queued);
+            --(this->node_queued[this->worker_nodes[home]]);
+
+            return true;
+        }
+    }
+
+    // Steal from the others on our node:
+
+    const int node = home >= 0 ? this->worker_nodes[home] : 0;
+    const std::vector<int>& local = this->node_queues[node];
+    const int lnum = static_cast<int>(local.size());
+
+    const auto start = home >= 0 ? std::find(local.begin(), local.end(), home) - local.begin() : 0;
+
+    for (int i = 1; i <= lnum; ++i) {
+
+        const int victim = local[(start + i) % lnum];
+
+        if (victim != home && this->steal(victim, task)) {
+
+            return true;
+        }
+    }
+
+    // Steal from the other nodes, if we are allowed to:
+
+    if (home >= 0 && !this->remote.load(std::memory_order_relaxed)) {
+
+        return false;
+    }
+
+    const int nnum = this->node_count();
+
+    for (int n = 1; n < nnum; ++n) {
+
+        for (const int victim : this->node_queues[(node + n) % nnum]) {
+
+            if (this->steal(victim, task)) {
+
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void WorkerPool::execute(const Task& task) {
+
+    (*task.func)(task.index);
+
+    this->remaining.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void WorkerPool::worker_loop(int index) {
+
+    // Configure the denormal mode of this worker:
+
+    set_flush_to_zero(this->flush);
+
+    MAEC_TRACE_THREAD("worker " + std::to_string(index));
+
+    // Pin ourselves to our node, so the memory we touch is placed there:
+
+    const int node = this->worker_nodes[index];
+
+    worker_node = node;
+
+    if (this->pin) {
+
+        pin_current_thread(this->topology.get_cpus(node));
+    }
+
+    Task task;
+
+    while (true) {
+
+        // Run tasks while we can find them:
+
+        if (this->take(index, task)) {
+
+            this->execute(task);
+
+            continue;
+        }
+
+        // Nothing to do, sleep until there is:
+
+        std::unique_lock<std::mutex> lock(this->sleep_mutex);
+
+        this->wake.wait(lock, [this, node]() {
+            return !this->running || (this->remote.load(std::memory_order_relaxed) ? this->queued.load() : this->node_queued[node].load()) > 0;
+        });
+
+        if (!this->running) {
+
+            return;
+        }
+    }
+}
+
+bool WorkerPool::run(const std::function<void(int)>& func, int num, int64_t deadline) {
+
+    if (num <= 0) {
+
+        return true;
+    }
+
+    const int64_t start = get_time();
+
+    this->remaining = num;
+
+    // Give each node its range of tasks, and spread each range over the queues of that node:
+
+    std::vector<int>& counts = this->node_counts;
+
+    std::fill(counts.begin(), counts.end(), 0);
+
+    for (int i = 0; i < num; ++i) {
+
+        const int node = this->node_of(i, num);
+        const std::vector<int>& local = this->node_queues[node];
+
+        Queue& queue = *(this->queues[local[counts[node]++ % static_cast<int>(local.size())]]);
+
+        const std::lock_guard<std::mutex> lock(queue.mutex);
+
+        // Grow if room was not reserved for this batch:
+
+        if (queue.tail == queue.tasks.size()) {
+
+            queue.tasks.resize(std::max<std::size_t>(queue.tasks.size() * 2, 16));
+        }
+
+        queue.tasks[queue.tail++] = Task{&func, i};
+    }
+
+    // Wake the workers:
+
+    {
+        const std::lock_guard<std::mutex> lock(this->sleep_mutex);
+
+        for (std::size_t node = 0; node < counts.size(); ++node) {
+
+            this->node_queued[node] += counts[node];
+        }
+
+        this->queued += num;
+    }
+
+    this->wake.notify_all();
+
+    // Help out until the batch is complete:
+
+    Task task;
+
+    while (this->remaining.load(std::memory_order_acquire) > 0) {
+
+        if (this->take(-1, task)) {
+
+            this->execute(task);
+        }
+
+        else {
+
+            std::this_thread::yield();
+        }
+    }
+
+    return deadline <= 0 || get_time() - start <= deadline;
+}
+
+void WorkerPool::reserve(int num) {
+
+    for (auto& queue : this->queues) {
+
+        const std::lock_guard<std::mutex> lock(queue->mutex);
+
+        if (static_cast<int>(queue->tasks.size()) < num) {
+
+            queue->tasks.resize(static_cast<std::size_t>(num));
+        }
+    }
+}
+
+int WorkerPool::capacity() const {
+
+    std::size_t slots = 0;
+
+    for (std::size_t i = 0; i < this->queues.size(); ++i) {
+
+        const std::lock_guard<std::mutex> lock(this->queues[i]->mutex);
+
+        slots = i == 0 ? this->queues[i]->tasks.size() : std::min(slots, this->queues[i]->tasks.size());
+    }
+
+    return static_cast<int>(slots);
+}
+
+int WorkerPool::current_node() { return worker_node; }
@@ -11,8 +11,17 @@
 
 #include "filter_module.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <set>
+#include <tuple>
+#include <utility>
+
 #include "dsp/kernel.hpp"
 #include "dsp/conv.hpp"
+#include "dsp/mix.hpp"
 
 FilterType BaseFilter::get_type() const {
 
@@ -70,14 +79,7 @@ void BaseConvFilter::set_size(int nsize) {
     this->size = nsize;
 }
 
-BufferPointer BaseConvFilter::get_kernel() {
-
-    // Return a pointer to the kernel:
-
-    return std::move(this->kernel);
-}
-
-void BaseConvFilter::set_kernel(BufferPointer nkern) {
+void BaseConvFilter::set_kernel(KernelPointer nkern) {
 
     // Just set the filter kernel:
 
@@ -89,53 +91,244 @@ void BaseConvFilter::start() {
     // Call the kernel generation method:
 
     this->generate_kernel();
+
+    this->quiet = 0;
+
+    this->next_kernel = nullptr;
+    this->next_spectrum = nullptr;
+
+    // Prepare the streaming history if necessary:
+
+    if (this->mode == ConvMode::Streaming) {
+
+        this->fir.set_kernel(this->kernel->data(), static_cast<int>(this->kernel->size()), this->max_block_size());
+    }
+
+    // Cache the kernel spectrum if necessary:
+
+    if (this->mode == ConvMode::OverlapSave) {
+
+        this->ols.set_kernel(this->kernel->data(), static_cast<int>(this->kernel->size()), this->max_block_size());
+    }
 }
 
-void BaseConvFilter::process() {
+bool BaseConvFilter::decayed(const AudioBuffer& input, int64_t tail) {
+
+    if (!input.is_silent()) {
+
+        this->quiet = 0;
+
+        return false;
+    }
+
+    // Determine if everything we remember is silent:
+
+    if (this->quiet >= tail) {
+
+        return true;
+    }
+
+    this->quiet += static_cast<int64_t>(input.size());
+
+    return false;
+}
+
+void BaseConvFilter::footprint(MemoryFootprint& usage) const {
+
+    AudioModule::footprint(usage);
+
+    if (this->kernel != nullptr) {
 
-    // Do convolution operation:
+        usage.kernels += this->kernel->bytes();
+    }
+
+    if (this->next_kernel != nullptr) {
+
+        usage.kernels += this->next_kernel->bytes();
+    }
+
+    if (this->next_spectrum != nullptr) {
+
+        usage.kernels += heap_bytes(*this->next_spectrum);
+    }
+
+    usage.kernels += this->fir.kernel_bytes() + this->ols.kernel_bytes();
+    usage.plans += this->ols.plan_bytes();
+    usage.state += this->fir.bytes() + this->ols.bytes();
+}
+
+void BaseConvFilter::stage_kernel(KernelPointer nkern, SpectrumPointer spec) {
+
+    this->next_kernel = std::move(nkern);
+    this->next_spectrum = std::move(spec);
+}
+
+void BaseConvFilter::fade(const AudioBuffer& input, AudioBuffer& output) {
+
+    if (this->mode == ConvMode::Streaming) {
+
+        this->fir.fade(this->next_kernel->data(), input.data(), static_cast<int>(input.size()), output.data());
+    }
+
+    else {
+
+        this->ols.fade(std::move(this->next_spectrum), input.data(), static_cast<int>(input.size()), output.data());
+    }
 
-    // THIS LINE CAUSES SEG FAULT!
-    // We must find a better way to share the kernel with the DSP functions.
-    // After the first process, the kernel is destroyed,
-    // as it was owned by the convolution function.
-    // I'm thinking maybe we finally hash out the AudioInfo issues?
+    this->kernel = std::move(this->next_kernel);
+
+    this->next_kernel = nullptr;
+    this->next_spectrum = nullptr;
+}
+
+void BaseConvFilter::process() {
 
     // Grab the buffer:
 
     auto ibuff = this->get_buffer();
 
+    // Blocks stand alone in direct convolution, so a new kernel can be swapped in:
+
+    if (this->next_kernel != nullptr && this->mode == ConvMode::Direct) {
+
+        this->kernel = std::move(this->next_kernel);
+        this->next_kernel = nullptr;
+    }
+
+    // Determine if we are keeping state between blocks:
+
+    if (this->mode == ConvMode::Streaming || this->mode == ConvMode::OverlapSave) {
+
+        // Output is the same size as input:
+
+        auto nbuff = this->create_buffer(static_cast<int>(ibuff->size()), 1);
+
+        if (this->next_kernel != nullptr && (this->mode == ConvMode::Streaming || this->next_spectrum != nullptr)) {
+
+            // Fade to the new kernel, even if silent, so it is adopted:
+
+            this->quiet = 0;
+
+            this->fade(*ibuff, *nbuff);
+        }
+
+        else if (this->decayed(*ibuff, static_cast<int64_t>(this->kernel->size()))) {
+
+            // Our history is silent, so the output is too:
+
+            nbuff->set_constant(0);
+        }
+
+        else if (this->mode == ConvMode::Streaming) {
+
+            this->fir.process(ibuff->data(), static_cast<int>(ibuff->size()), nbuff->data());
+        }
+
+        else {
+
+            this->ols.process(ibuff->data(), static_cast<int>(ibuff->size()), nbuff->data());
+        }
+
+        this->reclaim_buffer(std::move(ibuff));
+        this->set_buffer(std::move(nbuff));
+
+        return;
+    }
+
     // Allocate buffer for holding output:
 
     auto nbuff = this->create_buffer(length_conv(ibuff->size(), this->kernel->size()), 1);
 
-    // Run though convolution function:
+    // Run though convolution function, each block stands alone so silence is silence:
 
-    input_conv(ibuff->ibegin(), ibuff->size(), this->kernel->ibegin(), this->kernel->size(), nbuff->ibegin());
+    if (ibuff->is_silent()) {
+
+        nbuff->set_constant(0);
+    }
+
+    else {
+
+        input_conv(ibuff->data(), ibuff->size(), this->kernel->data(), this->kernel->size(), nbuff->data());
+    }
+
+    // Hand the input buffer back:
+
+    this->reclaim_buffer(std::move(ibuff));
 
     // Finally, set the buffer:
 
     this->set_buffer(std::move(nbuff));
 }
 
-void SincFilter::generate_kernel() {
+namespace {
+
+/// Number of cached sinc kernels at which unused kernels are evicted
+constexpr std::size_t SINC_CACHE_LIMIT = 256;
+
+/**
+ * @brief Process-wide cache of sinc kernels
+ */
+struct SincCache {
+
+    /// Lock guarding the kernels
+    std::mutex lock;
+
+    /// Kernels keyed by (type, size, start, stop, window)
+    std::map<std::tuple<FilterType, int, double, double, WindowType>, KernelPointer> kernels;
+};
+
+SincCache& sinc_cache() {
 
-    // Determine how to generate the kernel:
+    static SincCache cache;
+
+    return cache;
+}
+
+/**
+ * @brief Gets the window function used to design kernels
+ *
+ * @param type Type of window
+ * @return window_functiont Window function
+ */
+window_functiont sinc_window(WindowType type) {
+
+    switch (type) {
+
+        case WindowType::Hann:
+            return [](int num, int size) { return window_hann(num, size); };
+
+        case WindowType::Hamming:
+            return [](int num, int size) { return window_hamming(num, size); };
+
+        case WindowType::Blackman:
+            return window_blackman;
+
+        default:
+            return window_rectangle;
+    }
+}
 
-    const auto type = this->get_type();
-    const int final_size = this->get_size();
+/**
+ * @brief Designs a sinc kernel
+ *
+ * @param type Type of filter
+ * @param size Size of the kernel
+ * @param start_ratio Start frequency, as a fraction of the sample rate
+ * @param stop_ratio Stop frequency, as a fraction of the sample rate
+ * @param window Window applied to the kernel
+ * @return BufferPointer New kernel
+ */
+BufferPointer sinc_build(FilterType type, int size, double start_ratio, double stop_ratio, WindowType window) {
 
-    const auto start_ratio = static_cast<double>(this->get_start_freq() / this->get_info()->sample_rate);
-    const auto stop_ratio = static_cast<double>(this->get_stop_freq() / this->get_info()->sample_rate);
+    const window_functiont func = sinc_window(window);
 
     // First, create a buffer for use:
 
-    BufferPointer kern =
-        std::make_unique<AudioBuffer>(this->get_size(), 1);
+    BufferPointer kern = std::make_unique<AudioBuffer>(size, 1);
 
     // First off, just create the sinc kernel:
 
-    sinc_kernel(start_ratio, final_size, kern->ibegin());
+    sinc_kernel(start_ratio, size, kern->data(), func);
 
     // Determine if we are making a high pass filter:
 
@@ -143,31 +336,26 @@ void SincFilter::generate_kernel() {
 
         // Do a spectral inversion to create high pass:
 
-        spectral_inversion(kern->ibegin(), final_size);
+        spectral_inversion(kern->data(), size);
     }
 
     else if (type == FilterType::BandPass || type == FilterType::BandReject) {
 
         // We need to create another kernel:
 
-        AudioBuffer hkern(final_size);
+        AudioBuffer hkern(size);
 
         // Create low pass filter:
 
-        sinc_kernel(stop_ratio, final_size, hkern.ibegin());
+        sinc_kernel(stop_ratio, size, hkern.data(), func);
 
         // Create high pass filter from this kernel:
 
-        spectral_inversion(kern->ibegin(), final_size);
+        spectral_inversion(kern->data(), size);
 
         // Add kernels together to create band-reject:
 
-        for (int i = 0; i < final_size; ++i) {
-
-            // Add values together:
-
-            *(kern->ibegin() + i) = *(kern->ibegin() + i) + *(hkern.ibegin() + i);
-        }
+        mix_add(kern->data(), hkern.data(), size);
 
         // Determine if we should invert:
 
@@ -175,11 +363,688 @@ void SincFilter::generate_kernel() {
 
             // Invert the filter:
 
-            spectral_inversion(kern->ibegin(), final_size);
+            spectral_inversion(kern->data(), size);
         }
     }
 
-    // Finally, set the kernel:
+    return kern;
+}
+
+}  // namespace
+
+KernelPointer sinc_design(FilterType type, int size, double start, double stop, WindowType window) {
+
+    // Only band filters use the stop frequency:
+
+    if (type != FilterType::BandPass && type != FilterType::BandReject) {
+
+        stop = 0;
+    }
+
+    SincCache& cache = sinc_cache();
+
+    const auto key = std::make_tuple(type, size, start, stop, window);
+
+    {
+        const std::lock_guard<std::mutex> guard(cache.lock);
+
+        auto iter = cache.kernels.find(key);
+
+        if (iter != cache.kernels.end()) {
+
+            return iter->second;
+        }
+    }
+
+    // Design outside the lock, so other filters are not held up:
+
+    KernelPointer kern = sinc_build(type, size, start, stop, window);
+
+    const std::lock_guard<std::mutex> guard(cache.lock);
+
+    // Evict kernels no one holds if we have grown too large:
+
+    if (cache.kernels.size() >= SINC_CACHE_LIMIT) {
+
+        std::erase_if(cache.kernels, [](const auto& item) { return item.second.use_count() == 1; });
+    }
+
+    // Another thread may have designed the same kernel, so keep the first:
+
+    return cache.kernels.emplace(key, std::move(kern)).first->second;
+}
+
+std::size_t sinc_cache_size() {
+
+    SincCache& cache = sinc_cache();
+
+    const std::lock_guard<std::mutex> guard(cache.lock);
+
+    return cache.kernels.size();
+}
+
+void sinc_cache_clear() {
+
+    SincCache& cache = sinc_cache();
+
+    const std::lock_guard<std::mutex> guard(cache.lock);
+
+    cache.kernels.clear();
+}
+
+SincFilter::~SincFilter() {
+
+    // Ensure the worker is not left running:
+
+    this->join();
+}
+
+void SincFilter::generate_kernel() {
+
+    const double rate = this->get_info()->sample_rate;
+
+    this->set_kernel(sinc_design(this->get_type(), this->get_size(), this->get_start_freq() / rate, this->get_stop_freq() / rate, this->window));
+}
+
+void SincFilter::start() {
+
+    this->join();
+
+    BaseConvFilter::start();
+
+    if (!this->dynamic) {
+
+        return;
+    }
+
+    // Start the designer from our current frequencies:
+
+    this->target_start = this->get_start_freq();
+    this->target_stop = this->get_stop_freq();
+
+    this->published.reset(Design{});
+    this->published.update();
+
+    this->pending = false;
+    this->running = true;
+
+    this->worker = std::thread([this]() { this->design_loop(); });
+}
+
+void SincFilter::stop() {
+
+    this->join();
+
+    BaseConvFilter::stop();
+}
+
+void SincFilter::process() {
+
+    // Fade to the latest design, if there is one:
+
+    if (this->dynamic && this->published.update()) {
+
+        const Design& next = this->published.read_buffer();
+
+        this->stage_kernel(next.kernel, next.spectrum);
+    }
+
+    BaseConvFilter::process();
+}
+
+void SincFilter::retune(double start, double stop) {
+
+    if (!this->running.load(std::memory_order_acquire)) {
+
+        // Use the frequencies at the next start:
+
+        this->set_start_freq(start);
+        this->set_stop_freq(stop);
+
+        return;
+    }
+
+    this->target_start.store(start, std::memory_order_relaxed);
+    this->target_stop.store(stop, std::memory_order_relaxed);
+
+    this->request();
+}
+
+void SincFilter::request() {
+
+    // Only wake the designer if it has not been woken already:
+
+    if (!this->pending.exchange(true, std::memory_order_acq_rel)) {
+
+        this->wake.release();
+    }
+}
+
+void SincFilter::design_loop() {
+
+    OverlapSave engine;
+
+    while (true) {
+
+        this->wake.acquire();
+
+        // Requests made from here on wake us again:
+
+        this->pending.store(false, std::memory_order_release);
+
+        if (!this->running.load(std::memory_order_acquire)) {
+
+            return;
+        }
+
+        // Design the kernel from the latest frequencies, and its spectrum if needed:
+
+        const double rate = this->get_info()->sample_rate;
+
+        const double start = this->target_start.load(std::memory_order_relaxed);
+        const double stop = this->target_stop.load(std::memory_order_relaxed);
+
+        Design& design = this->published.write_buffer();
+
+        design.kernel = sinc_design(this->get_type(), this->get_size(), start / rate, stop / rate, this->window);
+        design.spectrum = nullptr;
+
+        if (this->get_mode() == ConvMode::OverlapSave) {
+
+            engine.set_kernel(design.kernel->data(), static_cast<int>(design.kernel->size()), this->max_block_size());
+
+            design.spectrum = engine.get_spectrum();
+        }
+
+        this->published.publish();
+
+        this->designs.fetch_add(1, std::memory_order_release);
+    }
+}
+
+void SincFilter::join() {
+
+    if (!this->worker.joinable()) {
+
+        return;
+    }
+
+    this->running = false;
+
+    this->request();
+
+    this->worker.join();
+
+    // Keep the frequencies we were retuned to:
+
+    this->set_start_freq(this->target_start.load(std::memory_order_relaxed));
+    this->set_stop_freq(this->target_stop.load(std::memory_order_relaxed));
+}
+
+void PartitionedConvFilter::start() {
+
+    // Generate the kernel:
+
+    this->generate_kernel();
+
+    // Prepare the engine using the kernel:
+
+    auto kern = this->get_kernel();
+
+    this->engine.set_kernel(kern->data(), static_cast<int>(kern->size()), this->max_block_size());
+}
+
+void PartitionedConvFilter::footprint(MemoryFootprint& usage) const {
+
+    BaseConvFilter::footprint(usage);
+
+    usage.kernels += this->engine.kernel_bytes();
+    usage.plans += this->engine.plan_bytes();
+    usage.state += this->engine.bytes();
+}
+
+void PartitionedConvFilter::process() {
 
-    this->set_kernel(std::move(kern));
+    // Grab the buffer:
+
+    auto ibuff = this->get_buffer();
+
+    // Output is the same size as input:
+
+    auto nbuff = this->create_buffer(static_cast<int>(ibuff->size()), 1);
+
+    // We remember the kernel plus the partition currently in the window:
+
+    const int64_t tail = static_cast<int64_t>(this->get_kernel()->size()) + this->engine.get_partition_size();
+
+    if (this->decayed(*ibuff, tail)) {
+
+        nbuff->set_constant(0);
+    }
+
+    else {
+
+        this->engine.process(ibuff->data(), static_cast<int>(ibuff->size()), nbuff->data());
+    }
+
+    // Hand back input and set output:
+
+    this->reclaim_buffer(std::move(ibuff));
+    this->set_buffer(std::move(nbuff));
+}
+
+const KernelPointer& MultiConvFilter::kernel_of(int channel) const {
+
+    if (channel < static_cast<int>(this->kernels.size()) && this->kernels[channel] != nullptr) {
+
+        return this->kernels[channel];
+    }
+
+    return this->kernel;
+}
+
+void MultiConvFilter::set_channel_kernel(int channel, KernelPointer nkern) {
+
+    if (channel >= static_cast<int>(this->kernels.size())) {
+
+        this->kernels.resize(channel + 1);
+    }
+
+    this->kernels[channel] = std::move(nkern);
+}
+
+void MultiConvFilter::start() {
+
+    const int channels = this->get_info()->channels;
+    const int block = this->max_block_size();
+
+    this->engines.assign(channels, PartitionedConv());
+    this->scratch.assign(static_cast<std::size_t>(channels) * block * 2, 0);
+
+    // Make room for a task for each channel, so processing never allocates:
+
+    if (this->executor != nullptr) {
+
+        this->executor->reserve(channels);
+    }
+
+    this->unique = 0;
+    this->quiet = 0;
+    this->serial = 0;
+
+    for (int c = 0; c < channels; ++c) {
+
+        const KernelPointer& kern = this->kernel_of(c);
+
+        // Share the spectra of an earlier channel with a matching kernel:
+
+        int match = -1;
+
+        for (int o = 0; o < c && match < 0; ++o) {
+
+            const KernelPointer& other = this->kernel_of(o);
+
+            if (other == kern || (other != nullptr && kern != nullptr && std::ranges::equal(other->span(), kern->span()))) {
+
+                match = o;
+            }
+        }
+
+        if (match >= 0) {
+
+            this->engines[c].share_kernel(this->engines[match]);
+
+            continue;
+        }
+
+        // Otherwise, compute the spectra of this kernel:
+
+        if (kern != nullptr) {
+
+            this->engines[c].set_kernel(kern->data(), static_cast<int>(kern->size()), block);
+        }
+
+        else {
+
+            const sample_t unit = 1;
+
+            this->engines[c].set_kernel(&unit, 1, block);
+        }
+
+        ++(this->unique);
+    }
+}
+
+void MultiConvFilter::footprint(MemoryFootprint& usage) const {
+
+    AudioModule::footprint(usage);
+
+    // Count each kernel once, no matter how many channels use it:
+
+    std::set<const AudioBuffer*> seen;
+
+    const auto count = [&](const KernelPointer& kern) {
+
+        if (kern != nullptr && seen.insert(kern.get()).second) {
+
+            usage.kernels += kern->bytes();
+        }
+    };
+
+    count(this->kernel);
+
+    for (const auto& kern : this->kernels) {
+
+        count(kern);
+    }
+
+    for (const auto& engine : this->engines) {
+
+        usage.kernels += engine.kernel_bytes();
+        usage.plans += engine.plan_bytes();
+        usage.state += engine.bytes();
+    }
+
+    usage.state += heap_bytes(this->scratch);
+}
+
+void MultiConvFilter::process_channel(int channel) {
+
+    const int channels = this->buff->channels();
+    const int num = static_cast<int>(this->buff->size()) / channels;
+    const int block = this->engines[channel].get_partition_size();
+
+    sample_t* input = this->scratch.data() + static_cast<std::ptrdiff_t>(channel) * block * 2;
+    sample_t* output = input + block;
+
+    // Gather the channel, convolve, and scatter the result back:
+
+    for (int i = 0; i < num; ++i) {
+
+        input[i] = this->buff->at(channel, i);
+    }
+
+    this->engines[channel].process(input, num, output);
+
+    for (int i = 0; i < num; ++i) {
+
+        this->buff->at(channel, i) = output[i];
+    }
+}
+
+void MultiConvFilter::process() {
+
+    const int channels = static_cast<int>(this->buff->channels());
+
+    // We remember the longest kernel plus the block currently in the window:
+
+    int64_t tail = 0;
+
+    for (const PartitionedConv& engine : this->engines) {
+
+        tail = std::max(tail, static_cast<int64_t>(engine.get_partitions() + 1) * engine.get_partition_size());
+    }
+
+    if (!this->buff->is_silent()) {
+
+        this->quiet = 0;
+    }
+
+    else if (this->quiet >= tail) {
+
+        return;
+    }
+
+    else {
+
+        this->quiet += static_cast<int64_t>(this->buff->size()) / std::max(channels, 1);
+    }
+
+    this->buff->clear_constant();
+
+    const int num = std::min(channels, static_cast<int>(this->engines.size()));
+
+    // Determine if we should process concurrently:
+
+    if (this->executor != nullptr && num > 1 && this->serial == 0) {
+
+        const bool met = this->executor->run([this](int index) { this->process_channel(index); }, num, this->deadline);
+
+        if (!met) {
+
+            // Missed the deadline, fall back to serial processing:
+
+            this->serial = this->backoff;
+        }
+
+        return;
+    }
+
+    if (this->serial > 0) {
+
+        --(this->serial);
+    }
+
+    for (int c = 0; c < num; ++c) {
+
+        this->process_channel(c);
+    }
+}
+
+void BiquadFilter::start() {
+
+    BaseFilter::start();
+
+    // Design the filter for our sample rate:
+
+    if (!this->custom) {
+
+        const double rate = this->get_info()->sample_rate;
+        const bool band = this->get_type() == FilterType::BandPass || this->get_type() == FilterType::BandReject;
+
+        const double low = this->get_start_freq() / rate;
+        const double high = (band ? this->get_stop_freq() : this->get_start_freq()) / rate;
+
+        this->sections = iir_design(this->prototype, this->get_type(), this->order, low, high, this->ripple);
+    }
+
+    this->bank.set_sections(this->sections);
+    this->bank.set_channels(this->get_info()->channels);
+}
+
+void BiquadFilter::process() {
+
+    const int channels = this->buff->channels();
+    const auto frames = static_cast<int>(this->buff->size()) / channels;
+
+    // Ensure we have state for each channel:
+
+    if (channels != this->bank.channels()) {
+
+        this->bank.set_channels(channels);
+    }
+
+    // Silence in is silence out once our tail has decayed:
+
+    if (this->buff->is_silent() && this->bank.settled(static_cast<sample_t>(SILENCE_LEVEL))) {
+
+        this->bank.reset();
+
+        return;
+    }
+
+    this->buff->clear_constant();
+
+    if constexpr (AudioBuffer::layout::planar) {
+
+        for (int c = 0; c < channels; ++c) {
+
+            sample_t* data = this->buff->data() + AudioBuffer::layout::offset(c, 0, channels, this->buff->channel_capacity());
+
+            this->bank.process_channel(c, data, frames, data);
+        }
+    }
+
+    else {
+
+        this->bank.process_interleaved(this->buff->data(), frames, this->buff->data());
+    }
+}
+
+void ModulatedFilter::start() {
+
+    BaseFilter::start();
+
+    const double rate = this->get_info()->sample_rate;
+
+    // Determine the smoothing factor for each update:
+
+    this->alpha = this->smoothing > 0 ? 1 - std::exp(-this->interval / (this->smoothing * rate)) : 1;
+
+    // Prepare the section:
+
+    this->bank.set_sections(std::vector<BiquadCoefficients<double>>{BiquadCoefficients<double>{}});
+    this->bank.set_channels(this->get_info()->channels);
+
+    this->primed = false;
+    this->designed = -1;
+    this->updates = 0;
+
+    if (this->cutoff.get_rate() == ParamRate::Constant) {
+
+        this->retune(this->cutoff.get_constant());
+    }
+
+    else {
+
+        this->retune(this->get_start_freq());
+        this->primed = false;
+    }
+}
+
+void ModulatedFilter::retune(double target) {
+
+    // Smooth towards the target:
+
+    if (this->primed) {
+
+        this->current += (target - this->current) * this->alpha;
+    }
+
+    else {
+
+        this->current = target;
+        this->primed = true;
+    }
+
+    // Only redesign if the cutoff has moved enough to matter:
+
+    if (std::fabs(this->current - this->designed) <= 1e-4 * std::fabs(this->designed)) {
+
+        return;
+    }
+
+    this->designed = this->current;
+
+    this->bank.update_section(0, biquad_design(this->get_type(), this->current / this->get_info()->sample_rate, this->q));
+
+    ++(this->updates);
+}
+
+void ModulatedFilter::process() {
+
+    const int channels = this->buff->channels();
+    const auto frames = static_cast<int>(this->buff->size()) / channels;
+
+    // Ensure we have state for each channel:
+
+    if (channels != this->bank.channels()) {
+
+        this->bank.set_channels(channels);
+    }
+
+    // Grab the cutoff values for this block:
+
+    const ParamRate rate = this->cutoff.get_rate();
+
+    std::pair<sample_t, sample_t> control = {this->cutoff.get_constant(), this->cutoff.get_constant()};
+    SharedBuffer fdata = nullptr;
+
+    if (rate == ParamRate::Control) {
+
+        control = this->cutoff.get_control();
+    }
+
+    else if (rate == ParamRate::Audio) {
+
+        fdata = this->cutoff.share();
+    }
+
+    // Determine if we are working with silence:
+
+    const bool silent = this->buff->is_silent();
+    bool skipped = silent;
+
+    this->buff->clear_constant();
+
+    // Filter each control period:
+
+    for (int pos = 0; pos < frames; pos += this->interval) {
+
+        const int num = std::min(this->interval, frames - pos);
+
+        // Determine the cutoff for this period:
+
+        double target = control.first;
+
+        if (rate == ParamRate::Control) {
+
+            target = control.first + (control.second - control.first) * static_cast<double>(pos + num) / frames;
+        }
+
+        else if (rate == ParamRate::Audio && pos < static_cast<int>(fdata->size() / fdata->channels())) {
+
+            target = fdata->at(0, pos);
+        }
+
+        this->retune(target);
+
+        // Silence in is silence out once our tail has decayed,
+        // we still follow the cutoff so it is current when audio returns:
+
+        if (silent && this->bank.settled(static_cast<sample_t>(SILENCE_LEVEL))) {
+
+            this->bank.reset();
+
+            continue;
+        }
+
+        skipped = false;
+
+        // Filter the period:
+
+        if constexpr (AudioBuffer::layout::planar) {
+
+            for (int c = 0; c < channels; ++c) {
+
+                sample_t* data = this->buff->data() + AudioBuffer::layout::offset(c, pos, channels, this->buff->channel_capacity());
+
+                this->bank.process_channel(c, data, num, data);
+            }
+        }
+
+        else {
+
+            sample_t* data = this->buff->data() + static_cast<std::ptrdiff_t>(pos) * channels;
+
+            this->bank.process_interleaved(data, num, data);
+        }
+    }
+
+    // Determine if we skipped every period, in which case we are still silent:
+
+    if (skipped) {
+
+        this->buff->set_constant(0);
+    }
 }
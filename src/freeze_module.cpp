@@ -0,0 +1,332 @@
+/**
+ * @file freeze_module.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations for freeze modules
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "freeze_module.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+FreezeModule::~FreezeModule() {
+
+    // Ensure the worker is not left running:
+
+    this->join();
+}
+
+void FreezeModule::meta_process() {
+
+    // Collect a finished background render:
+
+    if (this->worker.joinable() && !this->rendering()) {
+
+        this->join();
+    }
+
+    // Determine if the cache must be rendered again:
+
+    if (this->params_changed()) {
+
+        this->valid = false;
+    }
+
+    if (!this->valid && !this->worker.joinable()) {
+
+        if (this->background) {
+
+            this->render_async();
+        }
+
+        else {
+
+            this->freeze();
+        }
+    }
+
+    // Play back the next block:
+
+    const int frames = this->block_size();
+    const int channels = this->get_info()->channels;
+
+    BufferPointer out = this->create_buffer(channels);
+
+    if (this->cache == nullptr) {
+
+        out->fill_constant(0);
+
+        this->set_buffer(std::move(out));
+
+        this->run_process();
+
+        return;
+    }
+
+    const int total = static_cast<int>(this->cache->size()) / std::max(static_cast<int>(this->cache->channels()), 1);
+
+    out->clear_constant();
+
+    int done = 0;
+
+    while (done < frames) {
+
+        // Wrap around, or go silent, at the end of the cache:
+
+        if (this->position >= total) {
+
+            if (!this->loop) {
+
+                for (int c = 0; c < channels; ++c) {
+
+                    for (int i = done; i < frames; ++i) {
+
+                        out->at(c, i) = 0;
+                    }
+                }
+
+                break;
+            }
+
+            this->position = 0;
+        }
+
+        const int num = std::min(frames - done, total - this->position);
+
+        if constexpr (!AudioBuffer::layout::planar) {
+
+            std::copy_n(this->cache->data() + static_cast<std::ptrdiff_t>(this->position) * channels,
+                        static_cast<std::ptrdiff_t>(num) * channels,
+                        out->data() + static_cast<std::ptrdiff_t>(done) * channels);
+        }
+
+        else {
+
+            for (int c = 0; c < channels; ++c) {
+
+                std::copy_n(this->cache->data() + AudioBuffer::layout::offset(c, this->position, channels, this->cache->channel_capacity()), num,
+                            out->data() + AudioBuffer::layout::offset(c, done, channels, out->channel_capacity()));
+            }
+        }
+
+        this->position += num;
+        done += num;
+    }
+
+    if (this->loop && this->position >= total) {
+
+        this->position = 0;
+    }
+
+    this->set_buffer(std::move(out));
+
+    this->run_process();
+}
+
+void FreezeModule::meta_info_sync() {
+
+    // Sync ourselves:
+
+    this->info_sync();
+
+    // Configure the freeze chain from our info:
+
+    const ModuleInfo* info = this->get_info();
+
+    this->freeze_chain.buffer_size = info->out_buffer;
+    this->freeze_chain.channels = info->channels;
+    this->freeze_chain.sample_rate = info->sample_rate;
+
+    // Point everything behind us at the freeze chain:
+
+    std::vector<AudioModule*> stack = {this->get_backward()};
+    std::vector<AudioModule*> inputs;
+
+    while (!stack.empty()) {
+
+        AudioModule* mod = stack.back();
+        stack.pop_back();
+
+        if (mod->get_chain_info() == &(this->freeze_chain)) {
+
+            continue;
+        }
+
+        mod->set_chain_info(&(this->freeze_chain));
+
+        inputs.clear();
+        mod->plan_inputs(inputs);
+
+        stack.insert(stack.end(), inputs.begin(), inputs.end());
+    }
+
+    // Sync the sub-chain:
+
+    this->get_backward()->meta_info_sync();
+
+    // The cache may no longer match our format:
+
+    this->valid = false;
+}
+
+void FreezeModule::prepare() {
+
+    if (this->params_changed() || !this->valid) {
+
+        this->freeze();
+    }
+}
+
+void FreezeModule::meta_stop() {
+
+    // Stop the worker before the modules it processes:
+
+    this->join();
+
+    AudioModule::meta_stop();
+}
+
+bool FreezeModule::plan_inputs([[maybe_unused]] std::vector<AudioModule*>& inputs) {
+
+    // The sub-chain is only processed when we render:
+
+    return false;
+}
+
+void FreezeModule::freeze() {
+
+    this->join();
+
+    this->params_changed();
+
+    this->cache = this->render();
+
+    this->valid = true;
+    this->position = 0;
+
+    ++(this->renders);
+}
+
+void FreezeModule::watch(ModuleParam* param) {
+
+    this->watched.push_back({param, param->get_version()});
+}
+
+void FreezeModule::set_length(int frames) {
+
+    this->length = std::max(frames, 1);
+
+    this->valid = false;
+}
+
+BufferPointer FreezeModule::render() {
+
+    const ModuleInfo* info = this->get_info();
+
+    const int channels = info->channels;
+
+    BufferPointer out = std::make_unique<AudioBuffer>(this->length, channels, info->sample_rate);
+
+    // The sub-chain always renders full blocks:
+
+    this->freeze_chain.frames = 0;
+
+    int done = 0;
+
+    while (done < this->length) {
+
+        this->get_backward()->meta_process();
+
+        BufferPointer block = this->get_backward()->get_buffer();
+
+        const int have = static_cast<int>(block->size()) / std::max(static_cast<int>(block->channels()), 1);
+        const int num = std::min(have, this->length - done);
+        const int chans = std::min(channels, static_cast<int>(block->channels()));
+
+        for (int c = 0; c < chans; ++c) {
+
+            for (int i = 0; i < num; ++i) {
+
+                out->at(c, done + i) = block->at(c, i);
+            }
+        }
+
+        this->freeze_chain.pool.reclaim(std::move(block));
+
+        this->freeze_chain.sample += have;
+
+        // Sub-chains that produce nothing will never fill the cache:
+
+        if (have == 0) {
+
+            break;
+        }
+
+        done += num;
+    }
+
+    return out;
+}
+
+void FreezeModule::render_async() {
+
+    this->join();
+
+    this->params_changed();
+
+    this->busy.store(true, std::memory_order_release);
+
+    this->worker = std::thread([this]() {
+
+        this->pending = this->render();
+
+        this->busy.store(false, std::memory_order_release);
+    });
+}
+
+void FreezeModule::join() {
+
+    if (!this->worker.joinable()) {
+
+        return;
+    }
+
+    this->worker.join();
+
+    // Swap in the new cache, unless it was invalidated while rendering:
+
+    if (this->pending != nullptr) {
+
+        this->cache = std::move(this->pending);
+
+        this->valid = !this->params_changed();
+        this->position = 0;
+
+        ++(this->renders);
+    }
+}
+
+bool FreezeModule::params_changed() {
+
+    bool changed = false;
+
+    for (Watch& watch : this->watched) {
+
+        const uint64_t version = watch.param->get_version();
+
+        if (version != watch.version) {
+
+            watch.version = version;
+
+            changed = true;
+        }
+    }
+
+    return changed;
+}
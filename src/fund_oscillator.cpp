@@ -14,8 +14,10 @@
 #include "fund_oscillator.hpp"
 
 #include <cmath>
+#include <utility>
 
-const long double TWO_PI = 2.0 * M_PI;
+#include "dsp/blep.hpp"
+#include "dsp/osc.hpp"
 
 void SineOscillator::process() {
 
@@ -23,21 +25,19 @@ void SineOscillator::process() {
 
     this->set_buffer(this->create_buffer());
 
-    // Fill the buffer with the sine wave:
+    // Determine the phase in turns, and the increment per sample:
 
-    for (auto iter = this->buff->ibegin();
-         static_cast<unsigned int>(iter.get_index()) < this->buff->size();
-         ++iter) {
+    const double inc = this->get_frequency() / this->buff->get_samplerate();
+    double placeholder = 0.0;
+    const double start = modf(this->get_phase() * inc, &placeholder);
 
-        // Calculate the sine wave:
+    // Fill the buffer with the sine wave:
 
-        *iter = sin(static_cast<double>(TWO_PI * this->get_frequency() * this->get_phase() /
-                                        this->buff->get_samplerate()));
+    osc_sine(this->buff->data(), static_cast<int>(this->buff->size()), start, inc);
 
-        // Increment the phase:
+    // Increment the phase:
 
-        this->inc_phase(1);
-    }
+    this->inc_phase(static_cast<double>(this->buff->size()));
 }
 
 void SquareOscillator::process() {
@@ -46,27 +46,19 @@ void SquareOscillator::process() {
 
     this->set_buffer(this->create_buffer());
 
-    // Create a placeholder:
+    // Determine the phase in turns, and the increment per sample:
 
+    const double inc = this->get_frequency() / this->buff->get_samplerate();
     double placeholder = 0.0;
+    const double start = modf(this->get_phase() * inc, &placeholder);
 
     // Fill the buffer with the square wave:
 
-    for (auto iter = this->buff->ibegin();
-         static_cast<unsigned int>(iter.get_index()) < this->buff->size(); ++iter) {
-
-        // Calculate the square wave:
+    osc_square(this->buff->data(), static_cast<int>(this->buff->size()), start, inc);
 
-        *iter = (modf(static_cast<double>(this->get_frequency() * this->get_phase() /
-                                          this->buff->get_samplerate()),
-                      &placeholder) < 0.5)
-                    ? 1.0
-                    : -1.0;
+    // Increment the phase:
 
-        // Increment the phase:
-
-        this->inc_phase(1);
-    }
+    this->inc_phase(static_cast<double>(this->buff->size()));
 }
 
 void SawtoothOscillator::process() {
@@ -75,28 +67,19 @@ void SawtoothOscillator::process() {
 
     this->set_buffer(this->create_buffer());
 
-    // Create a placeholder:
+    // Determine the phase in turns, and the increment per sample:
 
+    const double inc = this->get_frequency() / this->buff->get_samplerate();
     double placeholder = 0.0;
+    const double start = modf(this->get_phase() * inc, &placeholder);
 
     // Fill the buffer with the sawtooth wave:
 
-    for (auto iter = this->buff->ibegin();
-         static_cast<unsigned int>(iter.get_index()) < this->buff->size();
-         ++iter) {
-
-        // Calculate the sawtooth wave:
-
-        *iter = (2.0 * modf(static_cast<double>(this->get_frequency() * this->get_phase() /
-                                                    this->buff->get_samplerate() +
-                                                0.5),
-                            &placeholder)) -
-                1.0;
+    osc_sawtooth(this->buff->data(), static_cast<int>(this->buff->size()), start, inc);
 
-        // Increment the phase:
+    // Increment the phase:
 
-        this->inc_phase(1);
-    }
+    this->inc_phase(static_cast<double>(this->buff->size()));
 }
 
 void TriangleOscillator::process() {
@@ -105,204 +88,158 @@ void TriangleOscillator::process() {
 
     this->set_buffer(this->create_buffer());
 
-    // Create a placeholder:
+    // Determine the phase in turns, and the increment per sample:
 
+    const double inc = this->get_frequency() / this->buff->get_samplerate();
     double placeholder = 0.0;
+    const double start = modf(this->get_phase() * inc, &placeholder);
 
     // Fill the buffer with the triangle wave:
 
-    for (auto iter = this->buff->ibegin();
-         static_cast<unsigned int>(iter.get_index()) < this->buff->size();
-         ++iter) {
-
-        // Calculate the triangle wave:
-
-        long double temp =
-            modf(static_cast<double>(this->get_frequency() * this->get_phase() /
-                                     this->buff->get_samplerate()),
-                 &placeholder);
-
-        if (temp < 0.25) {
-            temp *= 4.0;
-        }
+    osc_triangle(this->buff->data(), static_cast<int>(this->buff->size()), start, inc);
 
-        else if (temp > 0.75) {
-            temp = (temp - 1.0) * 4.0;
-        }
+    // Increment the phase:
 
-        else {
-            temp = (0.5 - temp) * 4.0;
-        }
-
-        *iter = temp;
-
-        // Increment the phase:
-
-        this->inc_phase(1);
-    }
+    this->inc_phase(static_cast<double>(this->buff->size()));
 }
 
-void ModSineOscillator::process() {
-
-    // Get sample rate:
-
-    auto sampler = this->get_info()->sample_rate;
-
-    // Create a new buffer:
+namespace {
 
-    this->set_buffer(this->create_buffer());
+/**
+ * @brief Computes a single sample of each waveform
+ *
+ * These match the batch kernels in dsp/osc.hpp,
+ * and are used when the frequency changes every sample.
+ * Each takes a phase in turns, wrapped into [0, 1).
+ */
+sample_t sine_wave(double turn) { return static_cast<sample_t>(sine_turns(turn)); }
 
-    // Get the frequency data:
+sample_t square_wave(double turn) { return static_cast<sample_t>(turn < 0.5 ? 1.0 : -1.0); }
 
-    auto fdata = this->get_frequency()->get();
+sample_t sawtooth_wave(double turn) { return static_cast<sample_t>(2.0 * (turn < 0.5 ? turn + 0.5 : turn - 0.5) - 1.0); }
 
-    // Fill the buffer with the sine wave:
+sample_t triangle_wave(double turn) { return static_cast<sample_t>(1.0 - 4.0 * std::fabs((turn < 0.75 ? turn + 0.25 : turn - 0.75) - 0.5)); }
 
-    for (auto iter = this->buff->ibegin();
-         static_cast<unsigned int>(iter.get_index()) < this->buff->size(); ++iter) {
+}  // namespace
 
-        // Determine the current value:
+void ModSineOscillator::process() {
 
-        *iter = sin(this->get_phase() * TWO_PI);
+    this->render_wave(sine_wave, [](sample_t* out, int size, double start, double inc) { osc_sine(out, size, start, inc); });
+}
 
-        // Get current frequency value:
+void ModSquareOscillator::process() {
 
-        auto freqv = fdata->at(iter.get_index());
+    this->render_wave(square_wave, [](sample_t* out, int size, double start, double inc) { osc_square(out, size, start, inc); });
+}
 
-        // Determine the new phase:
+void ModSawtoothOscillator::process() {
 
-        this->inc_phase(freqv * (1 / sampler));
-    }
+    this->render_wave(sawtooth_wave, [](sample_t* out, int size, double start, double inc) { osc_sawtooth(out, size, start, inc); });
 }
 
-void ModSquareOscillator::process() {
+void ModTriangleOscillator::process() {
 
-    // Get sample rate:
+    this->render_wave(triangle_wave, [](sample_t* out, int size, double start, double inc) { osc_triangle(out, size, start, inc); });
+}
 
-    auto sampler = this->get_info()->sample_rate;
+void WavetableOscillator::process() {
 
     // Create a new buffer:
 
     this->set_buffer(this->create_buffer());
 
-    // Get the frequency data:
-
-    auto fdata = this->get_frequency()->get();
-
-    // Create a placeholder:
+    // Determine the phase in turns, and the increment per sample:
 
+    const double inc = this->get_frequency() / this->buff->get_samplerate();
     double placeholder = 0.0;
+    const double start = modf(this->get_phase() * inc, &placeholder);
 
-    // Fill the buffer with the square wave:
-
-    for (auto iter = this->buff->ibegin();
-         (unsigned int)iter.get_index() < this->buff->size(); ++iter) {
+    // Fill the buffer from the level for this frequency:
 
-        // Calculate the square wave:
+    wavetable_render(this->buff->data(), static_cast<int>(this->buff->size()), this->table->level(Wavetable<sample_t>::pick(inc)).data(), start, inc);
 
-        *iter = (modf(static_cast<double>(this->get_phase()),
-                      &placeholder) < 0.5)
-                    ? 1.0
-                    : -1.0;
+    // Increment the phase:
 
-        // Get frequency value:
+    this->inc_phase(static_cast<double>(this->buff->size()));
+}
 
-        auto freqv = fdata->at(iter.get_index());
+void ModWavetableOscillator::process() {
 
-        // Determine the new phase:
+    const Wavetable<sample_t>* wave = this->table;
 
-        this->inc_phase(freqv * (1 / sampler));
-    }
+    this->render_wave(
+        [wave](double turn, double inc) { return wave->sample(turn, inc); },
+        [wave](sample_t* out, int size, double start, double inc) { wavetable_render(out, size, wave->level(Wavetable<sample_t>::pick(inc)).data(), start, inc); });
 }
 
-void ModSawtoothOscillator::process() {
-
-    // Get sample rate:
-
-    auto sampler = this->get_info()->sample_rate;
+void BLEPOscillator::process() {
 
     // Create a new buffer:
 
     this->set_buffer(this->create_buffer());
 
-    // Get frequency data:
-
-    auto fdata = this->get_frequency()->get();
-
-    // Create a placeholder:
+    // Determine the phase in turns, and the increment per sample:
 
+    const double inc = this->get_frequency() / this->buff->get_samplerate();
     double placeholder = 0.0;
+    const double start = modf(this->get_phase() * inc, &placeholder);
 
-    // Fill the buffer with the sawtooth wave:
-
-    for (auto iter = this->buff->ibegin();
-         static_cast<unsigned int>(iter.get_index()) < this->buff->size(); ++iter) {
+    // Fill the buffer with the corrected waveform:
 
-        // Calculate the sawtooth wave:
+    sample_t* out = this->buff->data();
+    const auto size = static_cast<int>(this->buff->size());
 
-        *iter = (2.0 *
-                 modf(static_cast<double>(this->get_phase() + 0.5),
-                      &placeholder)) -1.0;
+    switch (this->type) {
 
-        // Get the frequency value:
+        case Waveform::Square:
+            osc_blep_square(out, size, start, inc);
+            break;
 
-        auto freqv = fdata->at(iter.get_index());
+        case Waveform::Sawtooth:
+            osc_blep_sawtooth(out, size, start, inc);
+            break;
 
-        // Determine the new phase:
+        case Waveform::Triangle:
+            osc_blep_triangle(out, size, start, inc);
+            break;
 
-        this->inc_phase(freqv * (1 / sampler));
+        default:
+            osc_sine(out, size, start, inc);
+            break;
     }
-}
 
-void ModTriangleOscillator::process() {
-
-    // Get sample rate:
-
-    auto sampler = this->get_info()->sample_rate;
-
-    // Create a new buffer:
-
-    this->set_buffer(this->create_buffer());
-
-    // Get frequency data:
+    // Increment the phase:
 
-    auto fdata = this->get_frequency()->get();
-
-    // Create a placeholder:
-
-    double placeholder = 0.0;
-
-    // Fill the buffer with the triangle wave:
-
-    for (auto iter = this->buff->ibegin();
-         static_cast<unsigned int>(iter.get_index()) < this->buff->size(); ++iter) {
-
-        // Calculate the triangle wave:
+    this->inc_phase(static_cast<double>(this->buff->size()));
+}
 
-        long double temp =
-            modf(static_cast<double>(this->get_phase()),
-                 &placeholder);
+void ModBLEPOscillator::process() {
 
-        if (temp < 0.25) {
-            temp *= 4.0;
-        }
+    // Waves take the increment, so the corrections follow the frequency:
 
-        else if (temp > 0.75) {
-            temp = (temp - 1.0) * 4.0;
-        }
+    const auto blep = [this](auto turns, auto kernel) {
 
-        else {
-            temp = (0.5 - temp) * 4.0;
-        }
+        this->render_wave(
+            [turns](double turn, double inc) { return static_cast<sample_t>(turns(turn, blep_width(inc))); },
+            kernel);
+    };
 
-        *iter = temp;
+    switch (this->type) {
 
-        // Get frequency value:
+        case Waveform::Square:
+            blep(blep_square_turns, [](sample_t* out, int size, double start, double inc) { osc_blep_square(out, size, start, inc); });
+            break;
 
-        auto freqv = fdata->at(iter.get_index());
+        case Waveform::Sawtooth:
+            blep(blep_sawtooth_turns, [](sample_t* out, int size, double start, double inc) { osc_blep_sawtooth(out, size, start, inc); });
+            break;
 
-        // Determine the new phase:
+        case Waveform::Triangle:
+            blep(blep_triangle_turns, [](sample_t* out, int size, double start, double inc) { osc_blep_triangle(out, size, start, inc); });
+            break;
 
-        this->inc_phase(freqv * (1 / sampler));
+        default:
+            this->render_wave(sine_wave, [](sample_t* out, int size, double start, double inc) { osc_sine(out, size, start, inc); });
+            break;
     }
 }
@@ -0,0 +1,215 @@
+/**
+ * @file granular.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations of the granular source
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "granular.hpp"
+
+#include <cmath>
+
+#include "dsp/interleave.hpp"
+#include "dsp/mix.hpp"
+
+void GranularSource::start() {
+
+    // Release anything from a previous run:
+
+    this->stop();
+
+    SourceModule::start();
+
+    this->countdown = 0;
+    this->dropped = 0;
+
+    this->sample = this->cache->get(this->path);
+
+    auto* info = this->get_info();
+
+    info->in_buffer = 0;
+
+    if (this->sample == nullptr) {
+
+        return;
+    }
+
+    // Populate our AudioInfo data from the sample:
+
+    const int channels = this->sample->get_channels();
+
+    info->channels = channels;
+    info->sample_rate = this->sample->get_samplerate();
+
+    // Repeat each window coefficient for every channel,
+    // so grains of interleaved frames are one contiguous kernel call:
+
+    const std::span<const sample_t> table = window_table<sample_t>(this->window, this->length);
+
+    this->envelope.resize(static_cast<std::size_t>(this->length) * channels);
+
+    for (int i = 0; i < this->length; ++i) {
+
+        std::fill_n(this->envelope.begin() + static_cast<std::ptrdiff_t>(i) * channels, channels, table[i]);
+    }
+
+    this->grains.reserve(this->max_grains);
+}
+
+void GranularSource::footprint(MemoryFootprint& usage) const {
+
+    AudioModule::footprint(usage);
+
+    if (this->sample != nullptr) {
+
+        usage.samples += this->sample->bytes();
+    }
+
+    usage.kernels += heap_bytes(this->envelope);
+    usage.state += heap_bytes(this->grains) + heap_bytes(this->frames);
+}
+
+void GranularSource::stop() {
+
+    SourceModule::stop();
+
+    this->grains.clear();
+    this->sample.reset();
+}
+
+void GranularSource::process() {
+
+    const int channels = this->sample != nullptr ? this->sample->get_channels() : this->get_info()->channels;
+
+    auto buff = this->create_buffer(channels);
+
+    if (this->sample == nullptr) {
+
+        this->set_buffer(std::move(buff));
+
+        return;
+    }
+
+    const int frames = static_cast<int>(buff->channel_capacity());
+
+    // Determine where the interleaved frames go:
+
+    sample_t* dest = buff->data();
+
+    if constexpr (AudioBuffer::layout::planar) {
+
+        this->frames.resize(static_cast<std::size_t>(frames) * channels);
+
+        dest = this->frames.data();
+    }
+
+    std::fill_n(dest, static_cast<std::ptrdiff_t>(frames) * channels, 0);
+
+    // Start the grains that begin in this block:
+
+    if (this->density > 0) {
+
+        const double interval = this->get_info()->sample_rate / this->density;
+
+        while (this->countdown < frames) {
+
+            this->spawn(static_cast<int>(this->countdown));
+
+            this->countdown += interval;
+        }
+
+        this->countdown -= frames;
+    }
+
+    // Add each grain into the block:
+
+    const sample_t* head = this->sample->get_head();
+    const sample_t* env = this->envelope.data();
+    const auto level = static_cast<sample_t>(this->gain);
+
+    for (std::size_t g = 0; g < this->grains.size();) {
+
+        Grain& grain = this->grains[g];
+
+        const int count = std::min(frames - grain.delay, this->length - grain.offset);
+
+        mix_window_add(dest + static_cast<std::ptrdiff_t>(grain.delay) * channels,
+                       head + (grain.start + grain.offset) * channels,
+                       env + static_cast<std::ptrdiff_t>(grain.offset) * channels,
+                       count * channels, level);
+
+        grain.offset += count;
+        grain.delay = 0;
+
+        // Remove finished grains by moving the last one into their place:
+
+        if (grain.offset >= this->length) {
+
+            grain = this->grains.back();
+            this->grains.pop_back();
+
+            continue;
+        }
+
+        ++g;
+    }
+
+    if constexpr (AudioBuffer::layout::planar) {
+
+        deinterleave(this->frames.data(), buff->data(), channels, frames);
+    }
+
+    this->set_buffer(std::move(buff));
+}
+
+void GranularSource::spawn(int delay) {
+
+    // Grains can only be taken from the decoded frames:
+
+    const int64_t last = this->sample->get_head_frames() - this->length;
+
+    if (last < 0) {
+
+        return;
+    }
+
+    if (static_cast<int>(this->grains.size()) >= this->max_grains) {
+
+        ++(this->dropped);
+
+        return;
+    }
+
+    int64_t start = this->position;
+
+    if (this->spread > 0) {
+
+        start += static_cast<int64_t>(this->random() % static_cast<uint64_t>(2 * this->spread + 1)) - this->spread;
+    }
+
+    Grain grain;
+
+    grain.start = std::clamp<int64_t>(start, 0, last);
+    grain.delay = delay;
+
+    this->grains.push_back(grain);
+}
+
+uint32_t GranularSource::random() {
+
+    // xorshift32, which is plenty for scattering grains:
+
+    uint32_t val = this->seed;
+
+    val ^= val << 13;
+    val ^= val >> 17;
+    val ^= val << 5;
+
+    this->seed = val;
+
+    return val;
+}
@@ -0,0 +1,314 @@
+/**
+ * @file hot_swap.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations for hot swapping patches
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "hot_swap.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base_module.hpp"
+
+AudioModule* Patch::adopt(std::unique_ptr<AudioModule> mod) {
+
+    AudioModule* out = mod.get();
+
+    this->modules.push_back(std::move(mod));
+
+    return out;
+}
+
+HotSwap::~HotSwap() {
+
+    // Free every patch we still hold:
+
+    this->collect();
+
+    dispose(this->next.exchange(nullptr, std::memory_order_acq_rel));
+    dispose(this->current);
+}
+
+void HotSwap::meta_process() {
+
+    // Swap in a pending patch:
+
+    Patch* old = nullptr;
+    Patch* incoming = this->next.exchange(nullptr, std::memory_order_acq_rel);
+
+    if (incoming != nullptr) {
+
+        old = this->current;
+        this->current = incoming;
+
+        this->swapped.fetch_add(1, std::memory_order_release);
+    }
+
+    // Render the current patch:
+
+    BufferPointer out = this->current != nullptr ? this->render_patch(*(this->current)) : nullptr;
+
+    if (out == nullptr) {
+
+        out = this->create_buffer(this->get_info()->channels);
+        out->set_constant(0);
+    }
+
+    // Fade out of the old patch:
+
+    if (old != nullptr && this->crossfade && old->output != nullptr) {
+
+        BufferPointer fade = this->render_patch(*old);
+
+        const int frames = static_cast<int>(out->channel_capacity());
+        const int channels = static_cast<int>(std::min(out->channels(), fade->channels()));
+
+        for (int c = 0; c < channels; ++c) {
+
+            for (int s = 0; s < frames; ++s) {
+
+                const sample_t gain = static_cast<sample_t>(s + 1) / frames;
+
+                out->at(c, s) = fade->at(c, s) + (out->at(c, s) - fade->at(c, s)) * gain;
+            }
+        }
+
+        out->clear_constant();
+
+        old->chain.pool.reclaim(std::move(fade));
+    }
+
+    // Hand the old patch off to be collected:
+
+    if (old != nullptr) {
+
+        old->next = this->retired.load(std::memory_order_relaxed);
+
+        while (!this->retired.compare_exchange_weak(old->next, old, std::memory_order_release, std::memory_order_relaxed)) {}
+    }
+
+    this->set_buffer(std::move(out));
+
+    this->run_process();
+}
+
+void HotSwap::meta_info_sync() {
+
+    // Sync ourselves:
+
+    this->info_sync();
+
+    // Sync the current patch:
+
+    if (this->current != nullptr) {
+
+        this->configure(*(this->current));
+    }
+}
+
+void HotSwap::meta_start() {
+
+    BaseModule::start();
+
+    this->start();
+
+    // Start the current patch if it was stopped:
+
+    if (this->current != nullptr && this->current->output != nullptr) {
+
+        const State state = this->current->output->get_state();
+
+        if (state == State::Created || state == State::Stopped) {
+
+            this->current->output->meta_start();
+        }
+    }
+}
+
+void HotSwap::meta_stop() {
+
+    // Stop the current patch:
+
+    if (this->current != nullptr && this->current->output != nullptr) {
+
+        this->current->output->meta_stop();
+    }
+
+    BaseModule::stop();
+
+    this->stop();
+}
+
+void HotSwap::meta_finish() {
+
+    // Finish the current patch:
+
+    if (this->current != nullptr && this->current->output != nullptr) {
+
+        this->current->output->meta_finish();
+    }
+
+    BaseModule::finish();
+
+    this->finish();
+}
+
+bool HotSwap::plan_inputs([[maybe_unused]] std::vector<AudioModule*>& inputs) {
+
+    // Patches are swapped underneath any plan:
+
+    return false;
+}
+
+void HotSwap::submit(std::unique_ptr<Patch> patch) {
+
+    // An empty patch outputs silence:
+
+    if (patch == nullptr) {
+
+        patch = std::make_unique<Patch>();
+    }
+
+    // Prepare the patch off the audio thread:
+
+    this->configure(*patch);
+
+    if (patch->output != nullptr) {
+
+        patch->output->meta_start();
+
+        patch->chain.pool.reserve(static_cast<int>(patch->size()) + 1, patch->chain.buffer_size, patch->chain.channels);
+    }
+
+    // Publish it, freeing any patch that was never picked up:
+
+    dispose(this->next.exchange(patch.release(), std::memory_order_acq_rel));
+}
+
+int HotSwap::collect() {
+
+    // Take the whole retired list at once:
+
+    Patch* list = this->retired.exchange(nullptr, std::memory_order_acquire);
+
+    int freed = 0;
+
+    while (list != nullptr) {
+
+        Patch* next = list->next;
+
+        dispose(list);
+
+        list = next;
+
+        ++freed;
+    }
+
+    return freed;
+}
+
+void HotSwap::configure(Patch& patch) {
+
+    if (patch.output == nullptr) {
+
+        return;
+    }
+
+    // Configure the patch chain from our info:
+
+    const ModuleInfo* info = this->get_info();
+
+    patch.chain.buffer_size = info->out_buffer;
+    patch.chain.channels = info->channels;
+    patch.chain.sample_rate = info->sample_rate;
+    patch.chain.max_buffer = this->max_block_size();
+    patch.chain.pool.set_capacity(this->max_block_size());
+
+    if (this->get_chain_info() != nullptr) {
+
+        patch.chain.flush_denormals = this->get_chain_info()->flush_denormals;
+    }
+
+    // Point everything in the patch at it:
+
+    std::vector<AudioModule*> stack = {patch.output};
+    std::vector<AudioModule*> inputs;
+
+    while (!stack.empty()) {
+
+        AudioModule* mod = stack.back();
+        stack.pop_back();
+
+        if (mod->get_chain_info() == &(patch.chain)) {
+
+            continue;
+        }
+
+        mod->set_chain_info(&(patch.chain));
+
+        inputs.clear();
+        mod->plan_inputs(inputs);
+
+        stack.insert(stack.end(), inputs.begin(), inputs.end());
+    }
+
+    // Attach the patch to us and sync it:
+
+    patch.output->set_forward(this);
+
+    patch.output->meta_info_sync();
+}
+
+BufferPointer HotSwap::render_patch(Patch& patch) {
+
+    if (patch.output == nullptr) {
+
+        return nullptr;
+    }
+
+    // Render the block, with as many frames as we output:
+
+    patch.chain.frames = this->block_size();
+
+    patch.output->meta_process();
+
+    BufferPointer out = patch.output->get_buffer();
+
+    patch.chain.sample += patch.chain.frames;
+
+    // Trade a buffer back to the patch pool:
+
+    patch.chain.pool.reclaim(this->create_buffer(this->get_info()->channels));
+
+    return out;
+}
+
+void HotSwap::dispose(Patch* patch) {
+
+    if (patch == nullptr) {
+
+        return;
+    }
+
+    // Stop the patch before freeing it:
+
+    if (patch->output != nullptr) {
+
+        const State state = patch->output->get_state();
+
+        if (state != State::Created && state != State::Stopped) {
+
+            patch->output->meta_stop();
+        }
+    }
+
+    delete patch;  // NOLINT(cppcoreguidelines-owning-memory): Patches are passed between threads as raw pointers
+}
@@ -0,0 +1,353 @@
+/**
+ * @file instrument.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations for instrumentation components
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "instrument.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <typeinfo>
+#include <unordered_set>
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+#include "audio_module.hpp"
+
+namespace {
+
+/**
+ * @brief Gets a readable name for the type of a module
+ *
+ * @param mod Module to name
+ * @return std::string Name of the type
+ */
+std::string type_name(const AudioModule& mod) {
+
+    const char* name = typeid(mod).name();
+
+#if defined(__GNUG__)
+
+    // Demangle the name if we can:
+
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+
+    if (status == 0 && demangled != nullptr) {
+
+        std::string out(demangled);
+
+        std::free(demangled);  // NOLINT(cppcoreguidelines-no-malloc): Demangled names are allocated with malloc
+
+        return out;
+    }
+
+#endif
+
+    return name;
+}
+
+/**
+ * @brief Adds a module and everything behind it, in processing order
+ *
+ * @param mod Module to add
+ * @param seen Modules already added
+ * @param out Vector to add modules to
+ */
+void walk(AudioModule* mod, std::unordered_set<AudioModule*>& seen, std::vector<AudioModule*>& out) {  // NOLINT(misc-no-recursion): Valid chains have no cycles
+
+    if (mod == nullptr || !seen.insert(mod).second) {
+
+        return;
+    }
+
+    // Add the modules we pull from first:
+
+    std::vector<AudioModule*> inputs;
+
+    mod->plan_inputs(inputs);
+
+    for (AudioModule* input : inputs) {
+
+        walk(input, seen, out);
+    }
+
+    out.push_back(mod);
+}
+
+}  // namespace
+
+int64_t ModuleReport::percentile(double frac) const {
+
+    const auto target = static_cast<uint64_t>(std::clamp(frac, 0.0, 1.0) * static_cast<double>(this->calls));
+
+    // Find the bucket containing the target call:
+
+    uint64_t total = 0;
+
+    for (int i = 0; i < PROFILE_BUCKETS; ++i) {
+
+        total += this->histogram[i];
+
+        if (total >= std::max<uint64_t>(target, 1)) {
+
+            return int64_t{1} << (i + 1);
+        }
+    }
+
+    return this->max_time;
+}
+
+void ModuleProfile::record(int64_t time, uint64_t allocs, uint64_t bytes, uint64_t buffer) {
+
+    this->calls.fetch_add(1, std::memory_order_relaxed);
+    this->total.fetch_add(time, std::memory_order_relaxed);
+    this->allocations.fetch_add(allocs, std::memory_order_relaxed);
+    this->allocated.fetch_add(bytes, std::memory_order_relaxed);
+    this->buffer.fetch_add(buffer, std::memory_order_relaxed);
+    this->histogram[ModuleProfile::bucket(time)].fetch_add(1, std::memory_order_relaxed);
+
+    // Update the longest call:
+
+    int64_t prev = this->longest.load(std::memory_order_relaxed);
+
+    while (time > prev && !this->longest.compare_exchange_weak(prev, time, std::memory_order_relaxed)) {}
+}
+
+ModuleReport ModuleProfile::report() const {
+
+    ModuleReport out;
+
+    out.calls = this->calls.load(std::memory_order_relaxed);
+    out.total_time = this->total.load(std::memory_order_relaxed);
+    out.max_time = this->longest.load(std::memory_order_relaxed);
+    out.allocations = this->allocations.load(std::memory_order_relaxed);
+    out.allocated_bytes = this->allocated.load(std::memory_order_relaxed);
+    out.buffer_bytes = this->buffer.load(std::memory_order_relaxed);
+
+    for (int i = 0; i < PROFILE_BUCKETS; ++i) {
+
+        out.histogram[i] = this->histogram[i].load(std::memory_order_relaxed);
+    }
+
+    return out;
+}
+
+void ModuleProfile::reset() {
+
+    this->calls.store(0, std::memory_order_relaxed);
+    this->total.store(0, std::memory_order_relaxed);
+    this->longest.store(0, std::memory_order_relaxed);
+    this->allocations.store(0, std::memory_order_relaxed);
+    this->allocated.store(0, std::memory_order_relaxed);
+    this->buffer.store(0, std::memory_order_relaxed);
+
+    for (auto& val : this->histogram) {
+
+        val.store(0, std::memory_order_relaxed);
+    }
+}
+
+int ModuleProfile::bucket(int64_t time) {
+
+    if (time <= 1) {
+
+        return 0;
+    }
+
+    return std::min(PROFILE_BUCKETS - 1, static_cast<int>(std::bit_width(static_cast<uint64_t>(time))) - 1);
+}
+
+int64_t ChainReport::total_time() const {
+
+    int64_t total = 0;
+
+    for (const auto& mod : this->modules) {
+
+        total += mod.total_time;
+    }
+
+    return total;
+}
+
+const ModuleReport* ChainReport::slowest() const {
+
+    const auto iter = std::ranges::max_element(this->modules, {}, &ModuleReport::total_time);
+
+    return iter != this->modules.end() ? &(*iter) : nullptr;
+}
+
+std::string ChainReport::format() const {
+
+    std::string out = "module                                    calls     mean us      p99 us      max us    allocs   buffer KiB\n";
+
+    char line[256];
+
+    for (const auto& mod : this->modules) {
+
+        std::snprintf(line, sizeof(line), "%-40.40s %6llu %11.3f %11.3f %11.3f %9llu %12.1f\n",
+                      mod.type.c_str(),
+                      static_cast<unsigned long long>(mod.calls),
+                      mod.mean_time() / 1000.0,
+                      static_cast<double>(mod.percentile(0.99)) / 1000.0,
+                      static_cast<double>(mod.max_time) / 1000.0,
+                      static_cast<unsigned long long>(mod.allocations),
+                      static_cast<double>(mod.buffer_bytes) / 1024.0);
+
+        out += line;
+    }
+
+    return out;
+}
+
+std::vector<AudioModule*> chain_modules(AudioModule* mod) {
+
+    std::unordered_set<AudioModule*> seen;
+    std::vector<AudioModule*> out;
+
+    walk(mod, seen, out);
+
+    return out;
+}
+
+void instrument_chain(AudioModule* mod, bool enable) {
+
+    for (AudioModule* sub : chain_modules(mod)) {
+
+        sub->set_instrumented(enable);
+    }
+}
+
+ChainReport chain_report(AudioModule* mod) {
+
+    ChainReport out;
+
+    for (AudioModule* sub : chain_modules(mod)) {
+
+        const ModuleProfile* profile = sub->get_profile();
+
+        if (profile == nullptr) {
+
+            continue;
+        }
+
+        ModuleReport report = profile->report();
+
+        report.module = sub;
+        report.type = type_name(*sub);
+
+        out.modules.push_back(std::move(report));
+    }
+
+    return out;
+}
+
+MemoryFootprint& MemoryFootprint::operator+=(const MemoryFootprint& other) {
+
+    this->buffers += other.buffers;
+    this->kernels += other.kernels;
+    this->plans += other.plans;
+    this->samples += other.samples;
+    this->state += other.state;
+
+    return *this;
+}
+
+MemoryFootprint FootprintReport::usage() const {
+
+    MemoryFootprint out;
+
+    for (const auto& mod : this->modules) {
+
+        out += mod.usage;
+    }
+
+    return out;
+}
+
+const ModuleFootprint* FootprintReport::largest() const {
+
+    const auto iter = std::ranges::max_element(this->modules, {}, [](const ModuleFootprint& mod) { return mod.usage.total(); });
+
+    return iter != this->modules.end() ? &(*iter) : nullptr;
+}
+
+std::string FootprintReport::format() const {
+
+    std::string out = "module                                   buffer KiB  kernel KiB    plan KiB  sample KiB   state KiB   total KiB\n";
+
+    char line[256];
+
+    const auto kib = [](std::size_t bytes) { return static_cast<double>(bytes) / 1024.0; };
+
+    const auto row = [&](const char* name, const MemoryFootprint& usage) {
+
+        std::snprintf(line, sizeof(line), "%-40.40s %11.1f %11.1f %11.1f %11.1f %11.1f %11.1f\n",
+                      name,
+                      kib(usage.buffers),
+                      kib(usage.kernels),
+                      kib(usage.plans),
+                      kib(usage.samples),
+                      kib(usage.state),
+                      kib(usage.total()));
+
+        out += line;
+    };
+
+    for (const auto& mod : this->modules) {
+
+        row(mod.type.c_str(), mod.usage);
+    }
+
+    // The pool only holds buffers:
+
+    MemoryFootprint spare;
+
+    spare.buffers = this->pool;
+
+    row("(chain pool)", spare);
+
+    MemoryFootprint sum = this->usage();
+
+    sum.buffers += this->pool;
+
+    row("(total)", sum);
+
+    return out;
+}
+
+FootprintReport chain_footprint(AudioModule* mod) {
+
+    FootprintReport out;
+
+    for (AudioModule* sub : chain_modules(mod)) {
+
+        ModuleFootprint report;
+
+        report.module = sub;
+        report.type = type_name(*sub);
+
+        sub->footprint(report.usage);
+
+        out.modules.push_back(std::move(report));
+    }
+
+    const ChainInfo* chain = mod != nullptr ? mod->get_chain_info() : nullptr;
+
+    if (chain != nullptr) {
+
+        out.pool = chain->pool.bytes();
+    }
+
+    return out;
+}
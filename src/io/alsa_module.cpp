@@ -16,15 +16,31 @@
 #include <alsa/control.h>
 #include <alsa/pcm.h>
 
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
-#include <iostream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "audio_buffer.hpp"
+#include "dsp/convert.hpp"
+#include "dsp/interleave.hpp"
+#include "trace.hpp"
 
 void DeviceInfo::create_device(void** hint, int id) {
 
+    // First, extract the hint values:
+
+    this->read_hint(hint, id);
+
+    // Now, query our device:
+
+    this->update();
+}
+
+void DeviceInfo::read_hint(void** hint, int id) {
+
     // First, set our id:
 
     this->id = id;
@@ -37,8 +53,8 @@ void DeviceInfo::create_device(void** hint, int id) {
 
     // Set name and description:
 
-    this->name = std::string(n);
-    this->description = std::string(descr);
+    this->name = n == nullptr ? std::string() : std::string(n);
+    this->description = descr == nullptr ? std::string() : std::string(descr);
 
     // Determine the IO type:
 
@@ -72,23 +88,6 @@ void DeviceInfo::create_device(void** hint, int id) {
     free(n);
     free(descr);
     free(io);
-
-    // Now, get our device:
-
-    snd_pcm_t* pcm = nullptr;
-
-    int err = snd_pcm_open(&pcm, this->name.c_str(), SND_PCM_STREAM_PLAYBACK, 0);
-
-    if (err != 0) {
-
-        // We have encountered an error, DO NOT CONTINUE!
-
-        this->load_fail = true;
-
-        return;
-    }
-
-    this->update();
 }
 
 void DeviceInfo::update() {
@@ -180,132 +179,143 @@ void DeviceInfo::update() {
     snd_pcm_hw_free(pcm);
 }
 
-int ALSABase::get_device_count() {
+void ALSADeviceCache::ensure() {
 
-    // Define some values:
+    if (!this->valid) {
 
-    void** hints = nullptr;
-    void** n = nullptr;
+        // Clear any old values:
 
-    // Get array of all devices:
+        this->devices.clear();
+        this->loaded.clear();
+        this->names.clear();
 
-    int err = snd_device_name_hint(-1, "pcm", &hints);
+        // Get array of all devices:
 
-    n = hints;
+        void** hints = nullptr;
 
-    // Iterate until we reach the end:
+        if (snd_device_name_hint(-1, "pcm", &hints) == 0) {
 
-    int num = 0;
+            int id = 0;
 
-    for (; *n != nullptr; ++n) {
+            for (void** n = hints; *n != nullptr; ++n, ++id) {
 
-        ++num;
-    }
+                // Extract the hint values, but do not open the device:
 
-    // Free the hints, as they are not needed:
+                DeviceInfo info;
 
-    snd_device_name_free_hint(hints);
+                info.read_hint(n, id);
 
-    // Finally, return the number of devices:
+                this->names.emplace(info.name, id);
+                this->devices.push_back(std::move(info));
+            }
 
-    return num;
-}
+            // Free the hints, as they are not needed:
 
-DeviceInfo ALSABase::get_device_by_id(int index) {
+            snd_device_name_free_hint(hints);
+        }
 
-    // Define some values:
+        this->loaded.assign(this->devices.size(), false);
 
-    void** hints = nullptr;
-    void** n = nullptr;
+        this->valid = true;
+    }
+}
 
-    // Get specific device:
+DeviceInfo ALSADeviceCache::load(int index) {
 
-    int err = snd_device_name_hint(-1, "pcm", &hints);
+    // Ensure the given index is valid:
 
-    // Ensure the given index is within our count:
-    // Note: Using get_device_count() ensures we aren't repeating ourselves.
-    // but is it the most efficient? Probably not...
- 
-    if (index >= this->get_device_count()) {
-        // TODO: DO SOMETHING!
-        // NOT DOING SOMETHING WILL RESULT IN A SEG FAULT!!!!
-    }
+    if (index < 0 || static_cast<std::size_t>(index) >= this->devices.size()) {
 
-    // Otherwise, seek n to the proper value:
+        DeviceInfo info;
 
-    n = hints + index;
+        info.id = index;
+        info.load_fail = true;
 
-    // Create struct and initialize it:
+        return info;
+    }
 
-    DeviceInfo info(n, index);
+    // Query the device if we have not done so:
 
-    // Free the hint:
+    if (!this->loaded[index]) {
 
-    snd_device_name_free_hint(hints);
+        this->devices[index].update();
 
-    // Finally, return the device info:
+        this->loaded[index] = true;
+    }
 
-    return info;
+    return this->devices[index];
 }
 
-DeviceInfo ALSABase::get_device_by_name(const std::string& name) {
+void ALSADeviceCache::refresh() {
 
-    // Define some values:
+    const std::lock_guard<std::mutex> lock(this->mutex);
 
-    void** hints = nullptr;
-    void** n = nullptr;
+    this->valid = false;
 
-    // Get all devices:
+    this->ensure();
+}
+
+int ALSADeviceCache::size() {
 
-    int err = snd_device_name_hint(-1, "pcm", &hints);
+    const std::lock_guard<std::mutex> lock(this->mutex);
 
-    n = hints;
+    this->ensure();
 
-    // Iterate over each device:
+    return static_cast<int>(this->devices.size());
+}
 
-    int id = 0;
-    DeviceInfo info;
+DeviceInfo ALSADeviceCache::get(int index) {
 
-    for (; *n != nullptr; ++n) {
+    const std::lock_guard<std::mutex> lock(this->mutex);
 
-        // Get the name from the hint:
+    this->ensure();
 
-        std::string const hname(snd_device_name_get_hint(*n, "NAME"));
+    return this->load(index);
+}
 
-        // Determine if the name is our target:
+DeviceInfo ALSADeviceCache::find(const std::string& name) {
 
-        if (hname == name) {
+    const std::lock_guard<std::mutex> lock(this->mutex);
 
-            // Found it, break
-            // TODO: Implement some kind of error correction
-            // For now we assume all provided names are valid which is DANGEROUS!
+    this->ensure();
 
-            info = DeviceInfo(n, id);
+    auto iter = this->names.find(name);
 
-            break;
-        }
+    if (iter == this->names.end()) {
 
-        // Increment our index
+        DeviceInfo info;
 
-        ++id;
+        info.name = name;
+        info.load_fail = true;
+
+        return info;
     }
 
-    // Free the hints:
+    return this->load(iter->second);
+}
 
-    snd_device_name_free_hint(hints);
+ALSADeviceCache& ALSABase::get_cache() {
 
-    // Finally, return the device:
+    static ALSADeviceCache cache;
 
-    return info;
+    return cache;
 }
 
-void ALSABase::alsa_start() {
+int ALSABase::get_device_count() { return get_cache().size(); }
+
+DeviceInfo ALSABase::get_device_by_id(int index) { return get_cache().get(index); }
+
+DeviceInfo ALSABase::get_device_by_name(const std::string& name) { return get_cache().find(name); }
+
+void ALSABase::alsa_start(snd_pcm_stream_t dir, int mode) {
 
     // TODO: Implement error checking and correction!
 
     // Create the PCM device:
 
-    int err = snd_pcm_open(&(this->pcm), this->device.name.c_str(), SND_PCM_STREAM_PLAYBACK, 0);
+    this->stream = dir;
+
+    int err = snd_pcm_open(&(this->pcm), this->device.name.c_str(), dir, mode);
 
     // Allocate the hardware parameters:
 
@@ -328,8 +338,26 @@ void ALSABase::alsa_start() {
 
     // Set some non-negotiable values:
 
-    int a = snd_pcm_hw_params_set_access(pcm, params, SND_PCM_ACCESS_RW_INTERLEAVED);
-	int b = snd_pcm_hw_params_set_format(pcm, params, SND_PCM_FORMAT_S16); // THIS FAILS, ONLY WITH FLOAT_64
+    int a = snd_pcm_hw_params_set_access(pcm, params, this->mmap ? SND_PCM_ACCESS_MMAP_INTERLEAVED : SND_PCM_ACCESS_RW_INTERLEAVED);
+
+    // Negotiate the format, preferring the highest resolution:
+
+    snd_pcm_format_t format = SND_PCM_FORMAT_S16_LE;
+    this->device.format = DeviceInfo::Format::S16;
+
+    if (snd_pcm_hw_params_test_format(pcm, params, SND_PCM_FORMAT_FLOAT_LE) == 0) {
+
+        format = SND_PCM_FORMAT_FLOAT_LE;
+        this->device.format = DeviceInfo::Format::F;
+    }
+
+    else if (snd_pcm_hw_params_test_format(pcm, params, SND_PCM_FORMAT_S32_LE) == 0) {
+
+        format = SND_PCM_FORMAT_S32_LE;
+        this->device.format = DeviceInfo::Format::S32;
+    }
+
+	int b = snd_pcm_hw_params_set_format(pcm, params, format);
 	int c = snd_pcm_hw_params_set_channels(pcm, params,  this->device.channels);
 	int d = snd_pcm_hw_params_set_rate(pcm, params, this->device.sample_rate, 0);
     int eee = snd_pcm_hw_params_set_period_size(pcm, params, this->device.period_size, 0);
@@ -362,9 +390,17 @@ void ALSABase::alsa_start() {
 
 void ALSABase::alsa_stop() {
 
-    // Drain the device:
+    // Drain playback devices, there is nothing to wait for when capturing:
+
+    if (this->stream == SND_PCM_STREAM_PLAYBACK) {
+
+        snd_pcm_drain(this->pcm);
+    }
+
+    else {
 
-    snd_pcm_drain(this->pcm);
+        snd_pcm_drop(this->pcm);
+    }
 
     // Close the PCM device:
 
@@ -375,40 +411,355 @@ void ALSABase::alsa_stop() {
     snd_pcm_hw_free(this->pcm);
 }
 
-void ALSASink::process() {
+void ALSASink::convert(const sample_t* input, void* output, std::size_t num) {
+
+    // Determine the format in use:
+
+    switch (this->get_device().format) {
+
+        case DeviceInfo::Format::F:
+
+            convert_float(input, static_cast<float*>(output), num);
+            break;
+
+        case DeviceInfo::Format::S32:
+
+            convert_int32(input, static_cast<int32_t*>(output), num);
+            break;
+
+        default:
+
+            if (this->dither) {
+
+                this->ditherer.process(input, static_cast<int16_t*>(output), num, static_cast<int>(this->get_device().channels));
+            }
+
+            else {
+
+                convert_int16(input, static_cast<int16_t*>(output), num);
+            }
+    }
+}
+
+void ALSASink::convert(const int16_t* input, void* output, std::size_t num) {
+
+    switch (this->get_device().format) {
+
+        case DeviceInfo::Format::F:
+
+            for (std::size_t i = 0; i < num; ++i) {
+
+                static_cast<float*>(output)[i] = static_cast<float>(input[i] / 32767.0);
+            }
 
-    // First, define our temporary vector:
+            break;
+
+        case DeviceInfo::Format::S32:
+
+            for (std::size_t i = 0; i < num; ++i) {
+
+                static_cast<int32_t*>(output)[i] = static_cast<int32_t>(input[i]) * 65536;
+            }
+
+            break;
 
-    std::vector<int16_t> temp(buff->size() * buff->channels());
+        default:
 
-    // Next, squish it:
+            std::copy_n(input, num, static_cast<int16_t*>(output));
+    }
+}
 
-    squish_inter(this->buff.get(), temp.begin(), &mf_int16);
+void ALSASink::write_frames(const void* data, snd_pcm_uframes_t frames) {
 
     // Determine if we need to prepare the device again:
 
     if (this->return_code == -EPIPE) {
 
         // Underrun occurred, prepare the device again:
-        std::cout << "ALSA Underrun (Before)" << std::endl;
 
-        snd_pcm_prepare(this->pcm); 
+        snd_pcm_prepare(this->pcm);
     }
 
-    // Finally, send the data along:
+    // Send the data along:
 
-    this->return_code =
-        snd_pcm_writei(this->pcm, reinterpret_cast<int16_t*>(temp.data()),
-                       static_cast<snd_pcm_uframes_t>(temp.size()));
+    {
+        MAEC_TRACE_SCOPE("io", "snd_pcm_writei");
+
+        this->return_code = static_cast<int>(snd_pcm_writei(this->pcm, data, frames));
+    }
 
     if (this->return_code == -EPIPE) {
-        // Underrun occurred
 
-        std::cout << "ALSA Underrun (After)" << std::endl;
+        // Underrun occurred:
+
+        ++(this->underruns);
+
         snd_pcm_prepare(this->pcm);
     }
 }
 
+template <typename F>
+void ALSASink::mmap_frames(snd_pcm_uframes_t frames, F fill) {
+
+    snd_pcm_uframes_t done = 0;
+
+    while (done < frames) {
+
+        // Determine how much room the device has:
+
+        snd_pcm_sframes_t avail = snd_pcm_avail_update(this->pcm);
+
+        if (avail < 0) {
+
+            // Underrun or suspend, recover:
+
+            ++(this->underruns);
+
+            snd_pcm_recover(this->pcm, static_cast<int>(avail), 1);
+
+            continue;
+        }
+
+        if (avail == 0) {
+
+            // No room, wait for the device:
+
+            snd_pcm_wait(this->pcm, -1);
+
+            continue;
+        }
+
+        // Map the area:
+
+        const snd_pcm_channel_area_t* areas = nullptr;
+        snd_pcm_uframes_t offset = 0;
+        snd_pcm_uframes_t num = frames - done;
+
+        const int err = snd_pcm_mmap_begin(this->pcm, &areas, &offset, &num);
+
+        if (err < 0) {
+
+            snd_pcm_recover(this->pcm, err, 1);
+
+            continue;
+        }
+
+        // Determine the start of the area, interleaved so channel 0 covers all:
+
+        auto* dest = static_cast<void*>(static_cast<unsigned char*>(areas[0].addr) + areas[0].first / 8 + offset * areas[0].step / 8);
+
+        fill(dest, done, num);
+
+        // Hand the frames over to the device:
+
+        const snd_pcm_sframes_t commit = snd_pcm_mmap_commit(this->pcm, offset, num);
+
+        if (commit < 0 || static_cast<snd_pcm_uframes_t>(commit) != num) {
+
+            ++(this->underruns);
+
+            snd_pcm_recover(this->pcm, commit < 0 ? static_cast<int>(commit) : -EPIPE, 1);
+        }
+
+        done += num;
+    }
+}
+
+void ALSASink::process() {
+
+    const std::size_t total = this->buff->size();
+    const std::size_t channels = this->buff->channels();
+
+    const sample_t* src = this->buff->data();
+
+    // Devices expect interleaved samples:
+
+    if constexpr (AudioBuffer::layout::planar) {
+
+        if (this->frames.size() < total) {
+
+            this->frames.resize(total);
+        }
+
+        interleave(src, this->frames.data(), static_cast<int>(channels), static_cast<int>(total / channels));
+
+        src = this->frames.data();
+    }
+
+    this->write(src, total / channels);
+}
+
+void ALSASink::write(const sample_t* data, std::size_t frames) {
+
+    const std::size_t channels = this->get_device().channels;
+    const std::size_t total = frames * channels;
+
+    // Determine if we can convert straight into the device:
+
+    if (this->mmap && !this->threaded) {
+
+        this->mmap_frames(static_cast<snd_pcm_uframes_t>(frames), [this, data, channels](void* dest, snd_pcm_uframes_t done, snd_pcm_uframes_t num) {
+
+            this->convert(data + done * channels, dest, num * channels);
+        });
+
+        return;
+    }
+
+    // Ensure our scratch buffer is large enough:
+
+    const std::size_t bytes = total * this->sample_bytes();
+
+    if (this->temp.size() < bytes) {
+
+        this->temp.resize(bytes);
+    }
+
+    // Next, convert it:
+
+    this->convert(data, this->temp.data(), total);
+
+    this->deliver(bytes, static_cast<snd_pcm_uframes_t>(frames));
+}
+
+void ALSASink::write_fixed(const int16_t* data, std::size_t frames) {
+
+    const std::size_t channels = this->get_device().channels;
+    const std::size_t total = frames * channels;
+
+    // Determine if we can copy straight into the device:
+
+    if (this->mmap && !this->threaded) {
+
+        this->mmap_frames(static_cast<snd_pcm_uframes_t>(frames), [this, data, channels](void* dest, snd_pcm_uframes_t done, snd_pcm_uframes_t num) {
+
+            this->convert(data + done * channels, dest, num * channels);
+        });
+
+        return;
+    }
+
+    const std::size_t bytes = total * this->sample_bytes();
+
+    if (this->temp.size() < bytes) {
+
+        this->temp.resize(bytes);
+    }
+
+    this->convert(data, this->temp.data(), total);
+
+    this->deliver(bytes, static_cast<snd_pcm_uframes_t>(frames));
+}
+
+void ALSASink::deliver(std::size_t bytes, snd_pcm_uframes_t frames) {
+
+    // Determine if we are writing directly:
+
+    if (!this->threaded) {
+
+        this->write_frames(this->temp.data(), frames);
+
+        return;
+    }
+
+    // Otherwise, hand the samples to the audio thread:
+
+    std::size_t done = 0;
+
+    while (done < bytes && this->running.load(std::memory_order_relaxed)) {
+
+        done += this->ring.write(this->temp.begin() + done, bytes - done);
+
+        if (done < bytes) {
+
+            // Ring is full, give the audio thread some time:
+
+            std::this_thread::sleep_for(std::chrono::microseconds(this->get_device().period_time / 4 + 1));
+        }
+    }
+}
+
+void ALSASink::drain_loop() {
+
+    MAEC_TRACE_THREAD("alsa writer");
+
+    const auto device = this->get_device();
+
+    const std::size_t frame = this->sample_bytes() * device.channels;
+    const std::size_t period = device.period_size * frame;
+    const std::size_t fill = period * std::max(this->prefill, 1);
+
+    const auto pause = std::chrono::microseconds(device.period_time / 4 + 1);
+
+    // Allocate buffer for one period:
+
+    std::vector<unsigned char> chunk(period);
+
+    bool primed = false;
+
+    while (this->running.load(std::memory_order_relaxed)) {
+
+        // Wait until we are prefilled:
+
+        if (!primed) {
+
+            if (this->ring.read_available() < fill) {
+
+                std::this_thread::sleep_for(pause);
+
+                continue;
+            }
+
+            primed = true;
+        }
+
+        // Determine if we can read straight into the device:
+
+        if (this->mmap) {
+
+            // Only whole frames can be handed to the device:
+
+            const std::size_t avail = std::min(this->ring.read_available(), period) / frame * frame;
+
+            if (avail == 0) {
+
+                primed = false;
+
+                continue;
+            }
+
+            this->mmap_frames(static_cast<snd_pcm_uframes_t>(avail / frame), [this, frame](void* dest, snd_pcm_uframes_t /*done*/, snd_pcm_uframes_t num) {
+
+                this->ring.read(static_cast<unsigned char*>(dest), num * frame);
+            });
+
+            continue;
+        }
+
+        // Grab a period:
+
+        const std::size_t num = this->ring.read(chunk.begin(), period / frame * frame);
+
+        if (num == 0) {
+
+            // We ran dry, prefill again before continuing:
+
+            primed = false;
+
+            continue;
+        }
+
+        // Write it out:
+
+        this->write_frames(chunk.data(), static_cast<snd_pcm_uframes_t>(num / frame));
+
+        if (this->return_code == -EPIPE) {
+
+            primed = false;
+        }
+    }
+}
+
 void ALSASink::start() {
 
     // First, determine if the device supports output:
@@ -422,13 +773,43 @@ void ALSASink::start() {
     // Next, upcall:
 
     ALSABase::alsa_start();
+
+    // Start the audio thread if necessary:
+
+    if (this->threaded) {
+
+        const auto device = this->get_device();
+
+        // Room for the prefill, plus a full device buffer:
+
+        this->ring.reserve((static_cast<std::size_t>(std::max(this->prefill, 1)) * device.period_size + device.buffer_size) * device.channels * this->sample_bytes());
+
+        this->underruns = 0;
+        this->running = true;
+
+        this->writer = std::thread(&ALSASink::drain_loop, this);
+    }
+}
+
+void ALSASink::stop() {
+
+    // Stop the audio thread:
+
+    if (this->writer.joinable()) {
+
+        this->running = false;
+
+        this->writer.join();
+    }
+
+    this->alsa_stop();
 }
 
 void ALSASink::info_sync() {
 
-    // Set the period number:
+    // Set the period number, adaptive blocks are rendered one at a time:
 
-    this->set_period(this->get_device().period);
+    this->set_period(this->adaptive ? 1 : this->get_device().period);
 
     // Set the desired buffer size:
 
@@ -436,6 +817,257 @@ void ALSASink::info_sync() {
 
     this->get_info()->out_buffer = bsize;
     this->get_info()->in_buffer = bsize;
+
+    // Configure the chain, declaring a device period as the largest block:
+
+    ChainInfo* chain = this->get_chain_info();
+
+    chain->buffer_size = static_cast<int>(bsize);
+    chain->max_buffer = this->adaptive ? static_cast<int>(this->get_device().period_size) : 0;
+    chain->pool.set_capacity(chain->max_block_size());
+}
+
+void ALSASink::meta_process() {
+
+    // Size the block to the room in the device:
+
+    if (this->adaptive && !this->threaded && this->pcm != nullptr) {
+
+        const snd_pcm_sframes_t avail = snd_pcm_avail_update(this->pcm);
+
+        // If the device is full (or in a bad state), render a regular block and let the write wait:
+
+        this->set_frames(avail > 0 ? static_cast<int>(avail) : 0);
+    }
+
+    PeriodSink::meta_process();
+}
+
+void ALSASource::convert(const void* input, sample_t* output, std::size_t num) {
+
+    // Determine the format in use:
+
+    switch (this->get_device().format) {
+
+        case DeviceInfo::Format::F:
+
+            convert_from_float(static_cast<const float*>(input), output, num);
+            break;
+
+        case DeviceInfo::Format::S32:
+
+            convert_from_int32(static_cast<const int32_t*>(input), output, num);
+            break;
+
+        default:
+
+            convert_from_int16(static_cast<const int16_t*>(input), output, num);
+    }
+}
+
+bool ALSASource::ready() {
+
+    const snd_pcm_sframes_t avail = snd_pcm_avail_update(this->pcm);
+
+    if (avail < 0) {
+
+        // Overrun occurred, recover and restart the device:
+
+        ++(this->overruns);
+
+        snd_pcm_recover(this->pcm, static_cast<int>(avail), 1);
+        snd_pcm_start(this->pcm);
+
+        return false;
+    }
+
+    return static_cast<snd_pcm_uframes_t>(avail) >= this->get_device().period_size;
+}
+
+bool ALSASource::wait_period(int wait) {
+
+    while (!this->ready()) {
+
+        // Wait for the device to signal us:
+
+        const int res = poll(this->fds.data(), static_cast<nfds_t>(this->fds.size()), wait);
+
+        if (res == 0) {
+
+            // Timed out:
+
+            return false;
+        }
+
+        if (res < 0) {
+
+            // Interrupted, try again:
+
+            continue;
+        }
+
+        // Determine what happened:
+
+        unsigned short revents = 0;
+
+        snd_pcm_poll_descriptors_revents(this->pcm, this->fds.data(), static_cast<unsigned int>(this->fds.size()), &revents);
+
+        if ((revents & POLLERR) != 0) {
+
+            // Device is in a bad state, let ready() recover it:
+
+            continue;
+        }
+    }
+
+    return true;
+}
+
+void ALSASource::process() {
+
+    const auto device = this->get_device();
+
+    const std::size_t samples = device.period_size * device.channels;
+
+    auto buff = this->create_buffer(static_cast<int>(device.channels));
+
+    // Wait for a period:
+
+    if (this->capture_fail || !this->wait_period(this->timeout)) {
+
+        // Nothing captured, output silence:
+
+        std::ranges::fill(buff->span(), 0);
+
+        this->set_buffer(std::move(buff));
+
+        return;
+    }
+
+    // Ensure our scratch buffer is large enough:
+
+    if (this->temp.size() < samples * this->sample_bytes()) {
+
+        this->temp.resize(samples * this->sample_bytes());
+    }
+
+    // Read the period, this will not block:
+
+    snd_pcm_uframes_t done = 0;
+
+    while (done < device.period_size) {
+
+        const snd_pcm_sframes_t num = snd_pcm_readi(this->pcm, this->temp.data() + done * device.channels * this->sample_bytes(), device.period_size - done);
+
+        if (num == -EAGAIN) {
+
+            // Rest of the period is not here yet:
+
+            this->wait_period(this->timeout);
+
+            continue;
+        }
+
+        if (num < 0) {
+
+            ++(this->overruns);
+
+            snd_pcm_recover(this->pcm, static_cast<int>(num), 1);
+            snd_pcm_start(this->pcm);
+
+            continue;
+        }
+
+        done += static_cast<snd_pcm_uframes_t>(num);
+    }
+
+    // Convert into the buffer:
+
+    const std::size_t num = std::min(samples, static_cast<std::size_t>(buff->size()));
+
+    if constexpr (AudioBuffer::layout::planar) {
+
+        // Convert, then split the channels:
+
+        this->frames.assign(buff->size(), 0);
+
+        this->convert(this->temp.data(), this->frames.data(), num);
+
+        deinterleave(this->frames.data(), buff->data(), static_cast<int>(buff->channels()), static_cast<int>(buff->channel_capacity()));
+    }
+
+    else {
+
+        this->convert(this->temp.data(), buff->data(), num);
+    }
+
+    this->set_buffer(std::move(buff));
+}
+
+void ALSASource::start() {
+
+    this->overruns = 0;
+    this->capture_fail = false;
+
+    // First, determine if the device supports input:
+
+    if (!this->get_device().input) {
+
+        // Nothing to open, we output silence until stopped:
+
+        this->capture_fail = true;
+
+        this->info_sync();
+
+        return;
+    }
+
+    // Open the device for non-blocking capture:
+
+    this->alsa_start(SND_PCM_STREAM_CAPTURE, SND_PCM_NONBLOCK);
+
+    // Update our info with the negotiated values:
+
+    this->info_sync();
+
+    // Grab the poll descriptors:
+
+    const int count = snd_pcm_poll_descriptors_count(this->pcm);
+
+    this->fds.resize(static_cast<std::size_t>(std::max(count, 0)));
+
+    snd_pcm_poll_descriptors(this->pcm, this->fds.data(), static_cast<unsigned int>(this->fds.size()));
+
+    // Finally, start capturing:
+
+    snd_pcm_prepare(this->pcm);
+    snd_pcm_start(this->pcm);
+}
+
+void ALSASource::stop() {
+
+    // The device is only open if we could capture from it:
+
+    if (!this->capture_fail) {
+
+        this->alsa_stop();
+    }
+
+    this->fds.clear();
+}
+
+void ALSASource::info_sync() {
+
+    const auto device = this->get_device();
+
+    // Configure our info using the device:
+
+    auto* info = this->get_info();
+
+    info->channels = static_cast<int>(device.channels);
+    info->sample_rate = device.sample_rate;
+    info->out_buffer = static_cast<int>(device.period_size);
+    info->in_buffer = 0;
 }
 
 #endif
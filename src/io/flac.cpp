@@ -0,0 +1,955 @@
+/**
+ * @file flac.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations for FLAC components
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "io/flac.hpp"
+
+#include <array>
+#include <bit>
+
+#include "dsp/interleave.hpp"
+
+namespace {
+
+/**
+ * @brief Generates a table for a CRC with no reflection
+ *
+ * @tparam T Type of the CRC
+ * @param poly Polynomial of the CRC
+ * @return std::array<T, 256> Value of the CRC for each byte
+ */
+template <typename T>
+constexpr std::array<T, 256> crc_table(T poly) {
+
+    std::array<T, 256> table{};
+
+    constexpr int top = sizeof(T) * 8 - 1;
+
+    for (int i = 0; i < 256; ++i) {
+
+        auto crc = static_cast<T>(i << (top - 7));
+
+        for (int j = 0; j < 8; ++j) {
+
+            crc = static_cast<T>((crc >> top) != 0 ? (crc << 1) ^ poly : crc << 1);
+        }
+
+        table.at(i) = crc;
+    }
+
+    return table;
+}
+
+/// CRC-8 used by frame headers, polynomial x^8 + x^2 + x + 1
+constexpr auto crc8_table = crc_table<uint8_t>(0x07);
+
+/// CRC-16 used by frames, polynomial x^16 + x^15 + x^2 + 1
+constexpr auto crc16_table = crc_table<uint16_t>(0x8005);
+
+/// Block sizes for each block size code, 0 means the size is stored elsewhere
+constexpr std::array<int, 16> block_sizes = {0, 192, 576, 1152, 2304, 4608, 0, 0, 256, 512, 1024, 2048, 4096, 8192, 16384, 32768};
+
+/// Bits per sample for each sample size code, 0 means the size is from the metadata
+constexpr std::array<int, 8> sample_sizes = {0, 8, 12, 0, 16, 20, 24, 32};
+
+/// Coefficients of the fixed predictors
+constexpr std::array<std::array<int64_t, 4>, 5> fixed_coeffs = {{{0, 0, 0, 0}, {1, 0, 0, 0}, {2, -1, 0, 0}, {3, -3, 1, 0}, {4, -6, 4, -1}}};
+
+/// Channel assignment of independent channels with the largest count
+const int max_independent = 7;
+
+/// Channel assignment of left and side channels
+const int left_side = 8;
+
+/// Channel assignment of side and right channels
+const int side_right = 9;
+
+/// Channel assignment of mid and side channels
+const int mid_side = 10;
+
+}  // namespace
+
+void FLACReader::start() {
+
+    // First, start the stream:
+
+    this->stream->start();
+
+    // Reset our state:
+
+    this->input.assign(static_cast<std::size_t>(this->read_size), 0);
+    this->in_pos = 0;
+    this->in_end = 0;
+    this->crc_pos = 0;
+    this->frame_pos = 0;
+    this->eof = false;
+    this->cache = 0;
+    this->cached = 0;
+
+    this->block_frames = 0;
+    this->block_pos = 0;
+    this->decoded = 0;
+    this->errors = 0;
+
+    // Read the metadata, if this is not a FLAC stream then we are done:
+
+    this->ended = !this->read_metadata();
+}
+
+void FLACReader::stop() {
+
+    // Simply stop the stream:
+
+    this->stream->stop();
+}
+
+bool FLACReader::load() {
+
+    if (this->eof) {
+
+        return false;
+    }
+
+    // Keep the current frame, so we can search it again if it is corrupt:
+
+    this->crc_update();
+
+    const std::size_t start = std::min(this->crc_pos, this->frame_pos);
+    const std::size_t keep = this->in_end - start;
+
+    std::copy(this->input.begin() + static_cast<std::ptrdiff_t>(start), this->input.begin() + static_cast<std::ptrdiff_t>(this->in_end), this->input.begin());
+
+    this->in_pos -= start;
+    this->in_end = keep;
+    this->crc_pos -= start;
+    this->frame_pos -= start;
+
+    // Make room if the frame is larger than our input:
+
+    if (this->in_end == this->input.size()) {
+
+        this->input.resize(this->input.size() * 2);
+    }
+
+    // Read as much as we have room for:
+
+    const auto want = static_cast<int>(this->input.size() - this->in_end);
+
+    const int got = this->stream->read_some(reinterpret_cast<char*>(this->input.data() + this->in_end), want);
+
+    this->in_end += static_cast<std::size_t>(std::max(got, 0));
+
+    if (got < want || this->stream->bad()) {
+
+        this->eof = true;
+    }
+
+    return got > 0;
+}
+
+void FLACReader::refill() {
+
+    while (this->cached <= 56) {
+
+        if (this->in_pos >= this->in_end && !this->load()) {
+
+            return;
+        }
+
+        this->cache |= static_cast<uint64_t>(this->input[this->in_pos++]) << (56 - this->cached);
+        this->cached += 8;
+    }
+}
+
+uint32_t FLACReader::read_bits(int num) {
+
+    if (num <= 0) {
+
+        return 0;
+    }
+
+    if (this->cached < num) {
+
+        this->refill();
+
+        // Out of data, pretend the rest is zero:
+
+        if (this->cached < num) {
+
+            const auto val = static_cast<uint32_t>(this->cache >> (64 - num));
+
+            this->cache = 0;
+            this->cached = 0;
+
+            return val;
+        }
+    }
+
+    const auto val = static_cast<uint32_t>(this->cache >> (64 - num));
+
+    this->cache <<= num;
+    this->cached -= num;
+
+    return val;
+}
+
+int64_t FLACReader::read_signed(int num) {
+
+    if (num <= 0) {
+
+        return 0;
+    }
+
+    // Read the top bit separately if the value is too large:
+
+    uint64_t val = 0;
+
+    if (num > 32) {
+
+        val = static_cast<uint64_t>(this->read_bits(num - 32)) << 32;
+
+        val |= this->read_bits(32);
+    }
+
+    else {
+
+        val = this->read_bits(num);
+    }
+
+    // Extend the sign:
+
+    const int shift = 64 - num;
+
+    return static_cast<int64_t>(val << shift) >> shift;
+}
+
+uint32_t FLACReader::read_unary() {
+
+    uint32_t count = 0;
+
+    while (true) {
+
+        if (this->cached == 0) {
+
+            this->refill();
+
+            if (this->cached == 0) {
+
+                return count;
+            }
+        }
+
+        // Count the zeros waiting in the cache:
+
+        const int zeros = std::countl_zero(this->cache);
+
+        if (zeros < this->cached) {
+
+            this->cache <<= zeros + 1;
+            this->cached -= zeros + 1;
+
+            return count + static_cast<uint32_t>(zeros);
+        }
+
+        count += static_cast<uint32_t>(this->cached);
+
+        this->cache = 0;
+        this->cached = 0;
+    }
+}
+
+uint32_t FLACReader::peek_bits(int num) {
+
+    if (this->cached < num) {
+
+        this->refill();
+    }
+
+    return static_cast<uint32_t>(this->cache >> (64 - num));
+}
+
+void FLACReader::crc_update() {
+
+    const std::size_t end = this->consumed();
+
+    for (std::size_t i = this->crc_pos; i < end; ++i) {
+
+        const uint8_t byte = this->input[i];
+
+        this->crc8 = crc8_table.at(this->crc8 ^ byte);
+        this->crc16 = static_cast<uint16_t>((this->crc16 << 8) ^ crc16_table.at(static_cast<uint8_t>(this->crc16 >> 8) ^ byte));
+    }
+
+    this->crc_pos = std::max(this->crc_pos, end);
+}
+
+void FLACReader::rewind(std::size_t pos) {
+
+    this->in_pos = std::min(pos, this->in_end);
+    this->crc_pos = this->in_pos;
+    this->cache = 0;
+    this->cached = 0;
+}
+
+void FLACReader::crc_reset() {
+
+    this->crc_pos = this->consumed();
+    this->frame_pos = this->crc_pos;
+    this->crc8 = 0;
+    this->crc16 = 0;
+}
+
+bool FLACReader::read_metadata() {
+
+    // Ensure this is a FLAC stream:
+
+    if (this->read_bits(32) != 0x664C6143) {
+
+        return false;
+    }
+
+    bool info = false;
+    bool last = false;
+
+    while (!last && !this->exhausted()) {
+
+        // Read the block header:
+
+        last = this->read_bits(1) != 0;
+
+        const uint32_t type = this->read_bits(7);
+        uint32_t length = this->read_bits(24);
+
+        if (type == 0 && length >= 34) {
+
+            // This is the stream info:
+
+            this->read_bits(16);
+            this->read_bits(16);
+            this->read_bits(24);
+            this->read_bits(24);
+
+            this->sample_rate = static_cast<int>(this->read_bits(20));
+            this->channels = static_cast<int>(this->read_bits(3)) + 1;
+            this->bits_per_sample = static_cast<int>(this->read_bits(5)) + 1;
+            this->total_frames = static_cast<int64_t>(this->read_bits(4)) << 32;
+            this->total_frames |= this->read_bits(32);
+
+            // Skip the MD5 signature:
+
+            length -= 18;
+
+            info = true;
+        }
+
+        // Skip the rest of the block, starting with what is in the cache:
+
+        while (length > 0 && this->cached >= 8) {
+
+            this->read_bits(8);
+
+            --length;
+        }
+
+        while (length > 0) {
+
+            this->crc_pos = this->in_pos;
+            this->frame_pos = this->in_pos;
+
+            if (this->in_pos >= this->in_end && !this->load()) {
+
+                return false;
+            }
+
+            const auto step = static_cast<uint32_t>(std::min<std::size_t>(length, this->in_end - this->in_pos));
+
+            this->in_pos += step;
+            length -= step;
+        }
+
+        this->crc_pos = this->consumed();
+        this->frame_pos = this->crc_pos;
+    }
+
+    return info;
+}
+
+bool FLACReader::decode_frame() {
+
+    while (true) {
+
+        // Find the next frame sync code:
+
+        this->align();
+
+        while ((this->peek_bits(16) & 0xFFFE) != 0xFFF8) {
+
+            if (this->exhausted()) {
+
+                return false;
+            }
+
+            this->read_bits(8);
+        }
+
+        this->crc_reset();
+
+        // Read the frame header:
+
+        this->read_bits(16);
+
+        const auto size_code = static_cast<int>(this->read_bits(4));
+        const auto rate_code = static_cast<int>(this->read_bits(4));
+        const auto assignment = static_cast<int>(this->read_bits(4));
+        const auto bits_code = static_cast<int>(this->read_bits(3));
+        const bool reserved = this->read_bits(1) != 0;
+
+        // Skip the frame or sample number, which is coded like UTF-8:
+
+        const uint32_t lead = this->read_bits(8);
+        const int extra = lead < 0x80 ? 0 : std::countl_one(static_cast<uint8_t>(lead)) - 1;
+
+        for (int i = 0; i < extra; ++i) {
+
+            this->read_bits(8);
+        }
+
+        int num = block_sizes.at(size_code);
+
+        if (size_code == 6) {
+
+            num = static_cast<int>(this->read_bits(8)) + 1;
+        }
+
+        else if (size_code == 7) {
+
+            num = static_cast<int>(this->read_bits(16)) + 1;
+        }
+
+        if (rate_code == 12) {
+
+            this->read_bits(8);
+        }
+
+        else if (rate_code == 13 || rate_code == 14) {
+
+            this->read_bits(16);
+        }
+
+        // Check the header:
+
+        this->crc_update();
+
+        const uint8_t expected = this->crc8;
+
+        const auto nchannels = assignment <= max_independent ? assignment + 1 : 2;
+        const int bits = bits_code == 0 ? this->bits_per_sample : sample_sizes.at(bits_code);
+
+        if (this->read_bits(8) != expected || reserved || num == 0 || rate_code == 15 || assignment > mid_side ||
+            bits == 0 || extra > 6 || nchannels != this->channels) {
+
+            // Not a valid header, this may have been data that looked like a sync code:
+
+            this->rewind(this->frame_pos + 1);
+
+            continue;
+        }
+
+        // Decode each subframe:
+
+        this->block.assign(static_cast<std::size_t>(num) * this->channels, 0);
+
+        bool valid = true;
+
+        for (int c = 0; c < this->channels && valid; ++c) {
+
+            // The side channel needs an extra bit:
+
+            const bool side = (assignment == left_side && c == 1) || (assignment == side_right && c == 0) || (assignment == mid_side && c == 1);
+
+            valid = this->decode_subframe(this->block.data() + static_cast<std::ptrdiff_t>(c) * num, num, bits + (side ? 1 : 0));
+        }
+
+        // Check the frame:
+
+        this->align();
+        this->crc_update();
+
+        const uint16_t crc = this->crc16;
+
+        valid = valid && this->read_bits(16) == crc;
+
+        this->block_frames = num;
+        this->block_pos = 0;
+        this->decoded += num;
+
+        if (!valid) {
+
+            // Output silence so the rest of the stream stays in time:
+
+            std::fill(this->block.begin(), this->block.end(), 0);
+
+            ++(this->errors);
+
+            // The corruption may have thrown off our position,
+            // so search for the next frame from the start of this one:
+
+            this->rewind(this->frame_pos + 2);
+
+            return true;
+        }
+
+        // Undo the channel decorrelation:
+
+        int64_t* first = this->block.data();
+        int64_t* second = this->block.data() + num;
+
+        for (int i = 0; i < num && assignment > max_independent; ++i) {
+
+            if (assignment == left_side) {
+
+                second[i] = first[i] - second[i];
+            }
+
+            else if (assignment == side_right) {
+
+                first[i] += second[i];
+            }
+
+            else {
+
+                const int64_t mid = (first[i] * 2) | (second[i] & 1);
+
+                first[i] = (mid + second[i]) >> 1;
+                second[i] = (mid - second[i]) >> 1;
+            }
+        }
+
+        return true;
+    }
+}
+
+bool FLACReader::decode_subframe(int64_t* output, int num, int bits) {
+
+    // Read the subframe header:
+
+    if (this->read_bits(1) != 0) {
+
+        return false;
+    }
+
+    const uint32_t type = this->read_bits(6);
+
+    int wasted = 0;
+
+    if (this->read_bits(1) != 0) {
+
+        wasted = static_cast<int>(this->read_unary()) + 1;
+    }
+
+    bits -= wasted;
+
+    if (bits <= 0) {
+
+        return false;
+    }
+
+    bool valid = true;
+
+    if (type == 0) {
+
+        // Constant value:
+
+        std::fill(output, output + num, this->read_signed(bits));
+    }
+
+    else if (type == 1) {
+
+        // Verbatim samples:
+
+        for (int i = 0; i < num; ++i) {
+
+            output[i] = this->read_signed(bits);
+        }
+    }
+
+    else if (type >= 8 && type <= 12) {
+
+        // Fixed predictor:
+
+        const auto order = static_cast<int>(type - 8);
+
+        if (order > num) {
+
+            return false;
+        }
+
+        for (int i = 0; i < order; ++i) {
+
+            output[i] = this->read_signed(bits);
+        }
+
+        valid = this->decode_residual(output, num, fixed_coeffs.at(order).data(), order, 0);
+    }
+
+    else if (type >= 32) {
+
+        // Linear predictor:
+
+        const auto order = static_cast<int>(type - 31);
+
+        if (order > num) {
+
+            return false;
+        }
+
+        for (int i = 0; i < order; ++i) {
+
+            output[i] = this->read_signed(bits);
+        }
+
+        const auto precision = static_cast<int>(this->read_bits(4)) + 1;
+        const auto shift = static_cast<int>(this->read_signed(5));
+
+        if (precision == 16 || shift < 0) {
+
+            return false;
+        }
+
+        std::array<int64_t, 32> coeffs{};
+
+        for (int i = 0; i < order; ++i) {
+
+            coeffs.at(i) = this->read_signed(precision);
+        }
+
+        valid = this->decode_residual(output, num, coeffs.data(), order, shift);
+    }
+
+    else {
+
+        // Reserved subframe type:
+
+        return false;
+    }
+
+    // Restore the wasted bits:
+
+    if (wasted > 0) {
+
+        for (int i = 0; i < num; ++i) {
+
+            output[i] *= int64_t{1} << wasted;
+        }
+    }
+
+    return valid;
+}
+
+bool FLACReader::decode_residual(int64_t* output, int num, const int64_t* coeffs, int order, int shift) {
+
+    // Read the coding method:
+
+    const uint32_t method = this->read_bits(2);
+
+    if (method > 1) {
+
+        return false;
+    }
+
+    const int param_bits = method == 0 ? 4 : 5;
+    const uint32_t escape = method == 0 ? 15 : 31;
+
+    const auto partition_order = static_cast<int>(this->read_bits(4));
+    const int partitions = 1 << partition_order;
+
+    if ((num % partitions) != 0 || (num >> partition_order) < order) {
+
+        return false;
+    }
+
+    // Decode the residual of each partition:
+
+    int pos = order;
+
+    for (int p = 0; p < partitions; ++p) {
+
+        const int end = (p + 1) * (num >> partition_order);
+
+        const uint32_t param = this->read_bits(param_bits);
+
+        if (param == escape) {
+
+            // Residuals are stored as plain values:
+
+            const auto width = static_cast<int>(this->read_bits(5));
+
+            for (; pos < end; ++pos) {
+
+                output[pos] = this->read_signed(width);
+            }
+
+            continue;
+        }
+
+        const auto k = static_cast<int>(param);
+
+        for (; pos < end; ++pos) {
+
+            // Read the Rice coded value:
+
+            const uint64_t quotient = this->read_unary();
+            const uint64_t folded = (quotient << k) | this->read_bits(k);
+
+            output[pos] = static_cast<int64_t>(folded >> 1) ^ -static_cast<int64_t>(folded & 1);
+        }
+    }
+
+    // Apply the predictor:
+
+    for (int i = order; i < num; ++i) {
+
+        int64_t sum = 0;
+
+        for (int j = 0; j < order; ++j) {
+
+            sum += coeffs[j] * output[i - 1 - j];
+        }
+
+        output[i] += sum >> shift;
+    }
+
+    return true;
+}
+
+BufferPointer FLACReader::get_data() {
+
+    // Define the BufferPointer to return:
+
+    BufferPointer bpoint = std::make_unique<AudioBuffer>(this->buffer_size, this->get_channels());
+
+    bpoint->set_samplerate(this->get_samplerate());
+
+    // Samples are produced in interleaved order,
+    // so planar buffers are filled from scratch space:
+
+    sample_t* dest = bpoint->data();
+
+    if constexpr (AudioBuffer::layout::planar) {
+
+        this->frames.assign(bpoint->size(), 0);
+
+        dest = this->frames.data();
+    }
+
+    // Samples are scaled like the PCM decoders:
+
+    const double scale = 1.0 / static_cast<double>((int64_t{1} << (std::max(this->bits_per_sample, 2) - 1)) - 1);
+
+    int written = 0;
+
+    while (written < this->buffer_size) {
+
+        // Decode the next frame if we have used this one:
+
+        if (this->block_pos >= this->block_frames) {
+
+            if (this->ended || !this->decode_frame()) {
+
+                this->ended = true;
+
+                break;
+            }
+
+            if (this->total_frames > 0 && this->decoded >= this->total_frames) {
+
+                this->ended = true;
+            }
+        }
+
+        // Copy as many frames as we can:
+
+        const int count = std::min(this->buffer_size - written, this->block_frames - this->block_pos);
+
+        for (int c = 0; c < this->channels; ++c) {
+
+            const int64_t* src = this->block.data() + static_cast<std::ptrdiff_t>(c) * this->block_frames + this->block_pos;
+
+            for (int i = 0; i < count; ++i) {
+
+                dest[static_cast<std::ptrdiff_t>(written + i) * this->channels + c] = static_cast<sample_t>(static_cast<double>(src[i]) * scale);
+            }
+        }
+
+        written += count;
+        this->block_pos += count;
+    }
+
+    if constexpr (AudioBuffer::layout::planar) {
+
+        deinterleave(this->frames.data(), bpoint->data(), this->get_channels(), this->buffer_size);
+    }
+
+    return bpoint;
+}
+
+FLACSource::~FLACSource() {
+
+    // Ensure the decoding thread is not left running:
+
+    if (this->worker.joinable()) {
+
+        this->stop();
+    }
+}
+
+void FLACSource::start() {
+
+    SourceModule::start();
+
+    // Start the FLAC reader:
+
+    FLACReader::start();
+
+    // Populate our AudioInfo data from the stream info:
+
+    auto* info = this->get_info();
+
+    info->channels = this->get_channels();
+    info->in_buffer = 0;
+    info->sample_rate = this->get_samplerate();
+
+    FLACReader::set_buffer_size(info->out_buffer);
+
+    // Start the decoding thread if necessary:
+
+    if (this->prefetch <= 0 || this->worker.joinable()) {
+
+        return;
+    }
+
+    this->ahead.reserve(this->prefetch);
+
+    this->taken.store(0, std::memory_order_relaxed);
+    this->underruns.store(0, std::memory_order_relaxed);
+    this->drained.store(false, std::memory_order_relaxed);
+    this->running.store(true, std::memory_order_release);
+
+    this->worker = std::thread(&FLACSource::run, this);
+}
+
+void FLACSource::stop() {
+
+    SourceModule::stop();
+
+    // Stop the decoding thread before the reader it uses:
+
+    if (this->worker.joinable()) {
+
+        this->running.store(false, std::memory_order_release);
+
+        this->taken.fetch_add(1, std::memory_order_release);
+        this->taken.notify_one();
+
+        this->worker.join();
+
+        // Drop any blocks left in the queue:
+
+        BufferPointer buff;
+
+        while (this->ahead.pop(buff)) {
+
+            buff.reset();
+        }
+    }
+
+    // Stop the FLAC reader:
+
+    FLACReader::stop();
+}
+
+void FLACSource::process() {
+
+    // If we are not prefetching, decode directly:
+
+    if (!this->worker.joinable()) {
+
+        this->set_buffer(FLACReader::get_data());
+
+        return;
+    }
+
+    // Take the next block:
+
+    BufferPointer buff;
+
+    if (this->ahead.pop(buff)) {
+
+        this->taken.fetch_add(1, std::memory_order_release);
+        this->taken.notify_one();
+
+        this->set_buffer(std::move(buff));
+
+        return;
+    }
+
+    // Nothing ready, determine if this is an underrun:
+
+    if (!this->drained.load(std::memory_order_acquire)) {
+
+        this->underruns.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Output silence rather than waiting:
+
+    this->set_buffer(this->create_buffer(FLACReader::get_channels()));
+}
+
+bool FLACSource::finished() const {
+
+    if (!this->worker.joinable()) {
+
+        return FLACReader::done();
+    }
+
+    return this->drained.load(std::memory_order_acquire) && this->ahead.read_available() == 0;
+}
+
+void FLACSource::run() {
+
+    while (this->running.load(std::memory_order_acquire)) {
+
+        // Determine if the queue is full:
+
+        const uint64_t seen = this->taken.load(std::memory_order_acquire);
+
+        if (this->ahead.write_available() == 0) {
+
+            this->taken.wait(seen, std::memory_order_acquire);
+
+            continue;
+        }
+
+        // Determine if there is anything left to decode:
+
+        if (FLACReader::done()) {
+
+            this->drained.store(true, std::memory_order_release);
+
+            this->taken.wait(seen, std::memory_order_acquire);
+
+            continue;
+        }
+
+        // Decode the next block:
+
+        this->ahead.push(FLACReader::get_data());
+    }
+}
@@ -0,0 +1,476 @@
+/**
+ * @file jack_module.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations for JACK input and output
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#ifdef JACK_F
+
+#include "io/jack_module.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "audio_buffer.hpp"
+#include "dsp/denormal.hpp"
+
+namespace {
+
+/**
+ * @brief Copies one channel of a buffer into a JACK port buffer
+ *
+ * Planar float buffers are copied straight across,
+ * anything else is converted as it is written.
+ *
+ * @param buff Buffer to read from
+ * @param channel Channel to read
+ * @param frames Number of frames to copy
+ * @param output Port buffer to write to
+ */
+void write_channel(const AudioBuffer& buff, int channel, int frames, jack_default_audio_sample_t* output) {
+
+    const auto channels = static_cast<std::ptrdiff_t>(buff.channels());
+
+    if constexpr (AudioBuffer::layout::planar) {
+
+        const sample_t* src = buff.data() + channel * static_cast<std::ptrdiff_t>(buff.channel_capacity());
+
+        std::transform(src, src + frames, output, [](sample_t val) { return static_cast<jack_default_audio_sample_t>(val); });
+    }
+
+    else {
+
+        const sample_t* src = buff.data() + channel;
+
+        for (int i = 0; i < frames; ++i) {
+
+            output[i] = static_cast<jack_default_audio_sample_t>(src[i * channels]);
+        }
+    }
+}
+
+/**
+ * @brief Copies a JACK port buffer into one channel of a buffer
+ *
+ * @param input Port buffer to read from
+ * @param frames Number of frames to copy
+ * @param buff Buffer to write to
+ * @param channel Channel to write
+ */
+void read_channel(const jack_default_audio_sample_t* input, int frames, AudioBuffer& buff, int channel) {
+
+    const auto channels = static_cast<std::ptrdiff_t>(buff.channels());
+
+    if constexpr (AudioBuffer::layout::planar) {
+
+        sample_t* dest = buff.data() + channel * static_cast<std::ptrdiff_t>(buff.channel_capacity());
+
+        std::transform(input, input + frames, dest, [](jack_default_audio_sample_t val) { return static_cast<sample_t>(val); });
+    }
+
+    else {
+
+        sample_t* dest = buff.data() + channel;
+
+        for (int i = 0; i < frames; ++i) {
+
+            dest[i * channels] = static_cast<sample_t>(input[i]);
+        }
+    }
+}
+
+}  // namespace
+
+JACKSink::~JACKSink() {
+
+    // Detach our sources, they can no longer use our client:
+
+    for (JACKSource* src : this->sources) {
+
+        src->ports.clear();
+        src->host = nullptr;
+    }
+
+    this->close();
+}
+
+int JACKSink::process_callback(jack_nframes_t nframes, void* arg) {
+
+    static_cast<JACKSink*>(arg)->render(nframes);
+
+    return 0;
+}
+
+void JACKSink::thread_callback(void* arg) {
+
+    const ChainInfo* chain = static_cast<JACKSink*>(arg)->get_chain_info();
+
+    if (chain != nullptr && chain->flush_denormals) {
+
+        set_flush_to_zero(true);
+    }
+}
+
+int JACKSink::xrun_callback(void* arg) {
+
+    static_cast<JACKSink*>(arg)->xruns.fetch_add(1, std::memory_order_relaxed);
+
+    return 0;
+}
+
+void JACKSink::shutdown_callback(void* arg) {
+
+    auto* sink = static_cast<JACKSink*>(arg);
+
+    sink->running.store(false, std::memory_order_relaxed);
+    sink->shutdown.store(true, std::memory_order_relaxed);
+}
+
+void JACKSink::render(jack_nframes_t nframes) {
+
+    this->period = nframes;
+
+    if (!this->running.load(std::memory_order_acquire)) {
+
+        // Not rendering, output silence:
+
+        for (jack_port_t* port : this->ports) {
+
+            auto* out = static_cast<jack_default_audio_sample_t*>(jack_port_get_buffer(port, nframes));
+
+            std::fill_n(out, nframes, 0.0F);
+        }
+
+        return;
+    }
+
+    // Render exactly the frames asked for, up to the largest block we declared:
+
+    this->set_frames(std::min(static_cast<int>(nframes), this->capacity));
+
+    if (this->compiled) {
+
+        this->plan.process();
+    }
+
+    else {
+
+        PeriodSink::meta_process();
+    }
+}
+
+void JACKSink::process() {
+
+    const int frames = this->block_size();
+
+    const int channels = static_cast<int>(this->buff->channels());
+
+    for (int c = 0; c < static_cast<int>(this->ports.size()); ++c) {
+
+        auto* out = static_cast<jack_default_audio_sample_t*>(jack_port_get_buffer(this->ports[c], this->period));
+
+        // Write the channel, or silence if the buffer has fewer channels than us:
+
+        const int num = c < channels ? std::min(frames, static_cast<int>(this->period)) : 0;
+
+        if (num > 0) {
+
+            write_channel(*(this->buff), c, num, out);
+        }
+
+        // Pad anything past the largest block with silence:
+
+        std::fill(out + num, out + this->period, 0.0F);
+    }
+}
+
+bool JACKSink::open() {
+
+    if (this->client != nullptr) {
+
+        return true;
+    }
+
+    // Open the client, never starting a server:
+
+    jack_status_t status{};
+
+    if (this->server.empty()) {
+
+        this->client = jack_client_open(this->name.c_str(), JackNoStartServer, &status);
+    }
+
+    else {
+
+        this->client = jack_client_open(this->name.c_str(), static_cast<jack_options_t>(JackNoStartServer | JackServerName), &status, this->server.c_str());
+    }
+
+    if (this->client == nullptr) {
+
+        return false;
+    }
+
+    // The server may have given us a unique name:
+
+    this->name = jack_get_client_name(this->client);
+
+    // Register our callbacks, these may not be changed once active:
+
+    jack_set_process_callback(this->client, &JACKSink::process_callback, this);
+    jack_set_thread_init_callback(this->client, &JACKSink::thread_callback, this);
+    jack_set_xrun_callback(this->client, &JACKSink::xrun_callback, this);
+    jack_on_shutdown(this->client, &JACKSink::shutdown_callback, this);
+
+    this->shutdown = false;
+
+    return true;
+}
+
+void JACKSink::close() {
+
+    if (this->client == nullptr) {
+
+        return;
+    }
+
+    this->stop();
+
+    jack_client_close(this->client);
+
+    this->client = nullptr;
+
+    this->ports.clear();
+
+    for (JACKSource* src : this->sources) {
+
+        src->ports.clear();
+    }
+}
+
+void JACKSink::info_sync() {
+
+    // Rendered one period at a time:
+
+    this->set_period(1);
+
+    if (this->open()) {
+
+        // Configure the chain from the server, declaring the server period as the largest block:
+
+        ChainInfo* chain = this->get_chain_info();
+
+        const auto size = static_cast<int>(jack_get_buffer_size(this->client));
+
+        chain->sample_rate = static_cast<double>(jack_get_sample_rate(this->client));
+        chain->buffer_size = size;
+        chain->max_buffer = size;
+        chain->frames = 0;
+
+        this->capacity = size;
+
+        // Register an output port for each channel:
+
+        while (static_cast<int>(this->ports.size()) < chain->channels) {
+
+            const std::string pname = "out_" + std::to_string(this->ports.size() + 1);
+
+            jack_port_t* port = jack_port_register(this->client, pname.c_str(), JACK_DEFAULT_AUDIO_TYPE, JackPortIsOutput, 0);
+
+            if (port == nullptr) {
+
+                break;
+            }
+
+            this->ports.push_back(port);
+        }
+
+        while (static_cast<int>(this->ports.size()) > chain->channels) {
+
+            jack_port_unregister(this->client, this->ports.back());
+
+            this->ports.pop_back();
+        }
+    }
+
+    // Configure our info and the pool:
+
+    SinkModule::info_sync();
+}
+
+void JACKSink::start() {
+
+    if (this->client == nullptr || this->running) {
+
+        return;
+    }
+
+    // Compile the chain before the callback can see it:
+
+    if (this->compiled) {
+
+        this->plan.compile(this);
+    }
+
+    this->xruns = 0;
+
+    this->running.store(true, std::memory_order_release);
+
+    if (jack_activate(this->client) != 0) {
+
+        this->running = false;
+
+        return;
+    }
+
+    // Ports may only be connected once we are active:
+
+    if (this->autoconnect) {
+
+        this->connect_physical(this->ports, true);
+    }
+
+    for (JACKSource* src : this->sources) {
+
+        if (src->autoconnect) {
+
+            this->connect_physical(src->ports, false);
+        }
+    }
+}
+
+void JACKSink::stop() {
+
+    if (this->client == nullptr || !this->running) {
+
+        return;
+    }
+
+    // Once deactivated, the callback will not run again:
+
+    jack_deactivate(this->client);
+
+    this->running = false;
+
+    this->set_frames(0);
+}
+
+void JACKSink::connect_physical(const std::vector<jack_port_t*>& own, bool output) {
+
+    // Outputs connect to physical inputs, and the other way around:
+
+    const unsigned long flags = JackPortIsPhysical | (output ? JackPortIsInput : JackPortIsOutput);
+
+    const char** physical = jack_get_ports(this->client, nullptr, JACK_DEFAULT_AUDIO_TYPE, flags);
+
+    if (physical == nullptr) {
+
+        return;
+    }
+
+    for (std::size_t i = 0; i < own.size() && physical[i] != nullptr; ++i) {
+
+        const char* mine = jack_port_name(own[i]);
+
+        if (output) {
+
+            jack_connect(this->client, mine, physical[i]);
+        }
+
+        else {
+
+            jack_connect(this->client, physical[i], mine);
+        }
+    }
+
+    jack_free(static_cast<void*>(physical));
+}
+
+void JACKSource::unregister() {
+
+    if (this->host == nullptr) {
+
+        return;
+    }
+
+    if (this->host->client != nullptr) {
+
+        for (jack_port_t* port : this->ports) {
+
+            jack_port_unregister(this->host->client, port);
+        }
+    }
+
+    this->ports.clear();
+
+    std::erase(this->host->sources, this);
+}
+
+void JACKSource::process() {
+
+    auto buff = this->create_buffer(this->channels);
+
+    const int frames = std::min({this->block_size(), static_cast<int>(buff->channel_capacity()), static_cast<int>(this->host->period)});
+
+    // Channels without a port are silent:
+
+    if (static_cast<int>(this->ports.size()) < this->channels) {
+
+        std::ranges::fill(buff->span(), 0);
+    }
+
+    for (int c = 0; c < static_cast<int>(this->ports.size()); ++c) {
+
+        const auto* in = static_cast<const jack_default_audio_sample_t*>(jack_port_get_buffer(this->ports[c], this->host->period));
+
+        read_channel(in, frames, *buff, c);
+    }
+
+    this->set_buffer(std::move(buff));
+}
+
+void JACKSource::info_sync() {
+
+    if (this->host != nullptr && this->host->client != nullptr) {
+
+        // Attach ourselves to the sink:
+
+        if (std::ranges::find(this->host->sources, this) == this->host->sources.end()) {
+
+            this->host->sources.push_back(this);
+        }
+
+        // Register an input port for each channel:
+
+        const std::string prefix = "in_" + std::to_string(std::ranges::find(this->host->sources, this) - this->host->sources.begin() + 1) + "_";
+
+        while (static_cast<int>(this->ports.size()) < this->channels) {
+
+            const std::string pname = prefix + std::to_string(this->ports.size() + 1);
+
+            jack_port_t* port = jack_port_register(this->host->client, pname.c_str(), JACK_DEFAULT_AUDIO_TYPE, JackPortIsInput, 0);
+
+            if (port == nullptr) {
+
+                break;
+            }
+
+            this->ports.push_back(port);
+        }
+    }
+
+    // Configure our info from the chain:
+
+    SourceModule::info_sync();
+
+    this->get_info()->channels = this->channels;
+    this->get_info()->in_buffer = 0;
+}
+
+#endif
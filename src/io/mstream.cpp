@@ -11,6 +11,11 @@
 
 #include "io/mstream.hpp"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <algorithm>
 #include <iterator>
 
@@ -25,40 +30,82 @@ void CharIStream::read(char* byts, int num) {
     this->index += num;
 }
 
-void CharOStream::write(char* byts, int num) {
+int CharIStream::read_some(char* byts, int num) {
 
-    // Offset to use when determining back insertion:
+    // Clamp to the bytes we have left:
 
-    std::size_t offset = 0;
+    const std::size_t left = this->index < this->arr.size() ? this->arr.size() - this->index : 0;
+    const std::size_t count = std::min(left, static_cast<std::size_t>(num));
 
-    // Determine if we need to overwrite instead of push_back:
+    this->read(byts, static_cast<int>(count));
 
-    if (this->index < this->arr.size()) {
+    if (count < static_cast<std::size_t>(num)) {
 
-        // Determine the max value to copy to:
+        this->stop();
+    }
 
-        const std::size_t max = std::min(this->index + num, this->arr.size());
+    return static_cast<int>(count);
+}
 
-        // Determine offset value:
+void CharOStream::write(char* byts, int num) {
 
-        offset = max - this->index;
+    const auto count = static_cast<std::size_t>(num);
+    const auto* src = reinterpret_cast<const unsigned char*>(byts);
 
-        // Copy values over:
+    // Determine how many values overwrite existing data:
 
-        std::copy_n(byts, max - this->index, this->arr.begin() + this->index);
+    const std::size_t overlap = this->index < this->arr.size() ? std::min(count, this->arr.size() - this->index) : 0;
 
-        // Increment index to max value:
+    std::copy_n(src, overlap, this->arr.begin() + static_cast<std::ptrdiff_t>(this->index));
 
-        this->index = max;
-    }
+    // Add the rest to the end, growing geometrically:
+
+    if (overlap < count) {
+
+        const std::size_t need = this->arr.size() + count - overlap;
 
-    // Do some back insertions:
+        if (need > this->arr.capacity()) {
 
-    std::copy_n(byts + offset, num - offset, std::back_inserter(this->arr));
+            this->arr.reserve(std::max(need, this->arr.capacity() * 2));
+        }
+
+        this->arr.insert(this->arr.end(), src + overlap, src + count);
+    }
 
     // Configure index:
 
-    this->index += num - offset;
+    this->index += count;
+}
+
+void SpanIStream::read(char* byts, int num) {
+
+    // Read what we can, and zero the rest:
+
+    const int count = this->read_some(byts, num);
+
+    std::fill_n(byts + count, num - count, 0);
+}
+
+int SpanIStream::read_some(char* byts, int num) {
+
+    // Determine the number of bytes we can copy:
+
+    const std::size_t count = std::min(this->data.size() - this->index, static_cast<std::size_t>(num));
+
+    // Copy the contents over:
+
+    std::copy_n(this->data.begin() + static_cast<std::ptrdiff_t>(this->index), count, byts);
+
+    this->index += count;
+
+    // Determine if we read off the end:
+
+    if (count < static_cast<std::size_t>(num)) {
+
+        this->stop();
+    }
+
+    return static_cast<int>(count);
 }
 
 void FIStream::read(char* byts, int num) {
@@ -76,6 +123,24 @@ void FIStream::read(char* byts, int num) {
     }
 }
 
+int FIStream::read_some(char* byts, int num) {
+
+    // Read the data:
+
+    get_stream()->read(byts, num);
+
+    const auto count = static_cast<int>(get_stream()->gcount());
+
+    // Determine if we reached the end:
+
+    if (!BaseFStream::good()) {
+
+        this->stop();
+    }
+
+    return count;
+}
+
 void FIStream::start() {
 
     // Call parent start method:
@@ -152,3 +217,539 @@ void FOStream::stop() {
 
     close();
 }
+
+void MMapIStream::read(char* byts, int num) {
+
+    // Read what we can, and zero the rest:
+
+    const int count = this->read_some(byts, num);
+
+    std::fill_n(byts + count, num - count, 0);
+}
+
+int MMapIStream::read_some(char* byts, int num) {
+
+    // Determine the number of bytes we can copy:
+
+    const std::size_t avail = this->map_size - this->index;
+    const std::size_t count = std::min(avail, static_cast<std::size_t>(num));
+
+    // Copy the contents over:
+
+    std::copy_n(this->map + this->index, count, byts);
+
+    this->index += count;
+
+    // Determine if we read off the end:
+
+    if (count < static_cast<std::size_t>(num)) {
+
+        this->stop();
+    }
+
+    return static_cast<int>(count);
+}
+
+void MMapIStream::start() {
+
+    // Call parent start method:
+
+    BaseMIStream::start();
+
+    // Open the file:
+
+    this->fd = ::open(this->filepath.c_str(), O_RDONLY);
+
+    struct stat info {};
+
+    if (this->fd < 0 || ::fstat(this->fd, &info) != 0) {
+
+        // Unable to open, set error state:
+
+        this->unmap();
+
+        this->set_state(BaseMStream::mstate::err);
+
+        return;
+    }
+
+    this->map_size = static_cast<std::size_t>(info.st_size);
+    this->index = 0;
+
+    // Empty files can't be mapped, but are still valid:
+
+    if (this->map_size == 0) {
+
+        return;
+    }
+
+    // Map the file:
+
+    void* addr = ::mmap(nullptr, this->map_size, PROT_READ, MAP_PRIVATE, this->fd, 0);
+
+    if (addr == MAP_FAILED) {
+
+        // Unable to map, set error state:
+
+        this->unmap();
+
+        this->set_state(BaseMStream::mstate::err);
+
+        return;
+    }
+
+    this->map = static_cast<const char*>(addr);
+
+    // We mostly read front to back, let the kernel read ahead:
+
+    ::madvise(addr, this->map_size, MADV_SEQUENTIAL);
+}
+
+void MMapIStream::stop() {
+
+    // Call parent stop method:
+
+    BaseMIStream::stop();
+
+    // Release the mapping:
+
+    this->unmap();
+}
+
+void MMapIStream::unmap() {
+
+    // Unmap the file:
+
+    if (this->map != nullptr) {
+
+        ::munmap(const_cast<char*>(this->map), this->map_size);
+    }
+
+    // Close the file:
+
+    if (this->fd >= 0) {
+
+        ::close(this->fd);
+    }
+
+    this->map = nullptr;
+    this->map_size = 0;
+    this->index = 0;
+    this->fd = -1;
+}
+
+void AsyncFOStream::seek(int pos) {
+
+    // Hand over what we have, and wait for it to be written:
+
+    if (this->fill > 0) {
+
+        this->submit();
+    }
+
+    this->drain();
+
+    this->position = pos;
+}
+
+void AsyncFOStream::write(char* byts, int num) {
+
+    // Determine if the background thread has failed:
+
+    if (this->failed.load(std::memory_order_relaxed) || this->fd < 0) {
+
+        this->set_state(BaseMStream::mstate::err);
+
+        return;
+    }
+
+    auto left = static_cast<std::size_t>(num);
+
+    while (left > 0) {
+
+        // Copy as much as we can into the current chunk:
+
+        const std::size_t count = std::min(left, this->chunk_size - this->fill);
+
+        std::copy_n(byts, count, this->memory.data() + this->current * this->chunk_size + this->fill);
+
+        this->fill += count;
+        byts += count;
+        left -= count;
+
+        // Hand over the chunk if it is full:
+
+        if (this->fill == this->chunk_size) {
+
+            this->submit();
+        }
+    }
+}
+
+void AsyncFOStream::start() {
+
+    // Call parent start method:
+
+    BaseMOStream::start();
+
+    // Open the file, falling back if O_DIRECT is not supported:
+
+    const int flags = O_WRONLY | O_CREAT | O_TRUNC;
+
+    this->fd = -1;
+
+#ifdef O_DIRECT
+    if (this->direct) {
+
+        this->fd = ::open(this->filepath.c_str(), flags | O_DIRECT, 0644);
+    }
+#endif
+
+    if (this->fd < 0) {
+
+        this->fd = ::open(this->filepath.c_str(), flags, 0644);
+    }
+
+    if (this->fd < 0) {
+
+        // Unable to open, set error state:
+
+        this->set_state(BaseMStream::mstate::err);
+
+        return;
+    }
+
+    // Allocate the chunks, all of them start out empty:
+
+    this->memory.assign(this->chunk_size * this->chunk_num, 0);
+
+    this->full.reserve(this->chunk_num);
+    this->empty.reserve(this->chunk_num);
+
+    for (int i = 1; i < this->chunk_num; ++i) {
+
+        this->empty.push(std::move(i));
+    }
+
+    this->current = 0;
+    this->fill = 0;
+    this->position = 0;
+
+    this->failed.store(false, std::memory_order_relaxed);
+    this->submitted.store(0, std::memory_order_relaxed);
+    this->written.store(0, std::memory_order_relaxed);
+    this->running.store(true, std::memory_order_release);
+
+    this->worker = std::thread(&AsyncFOStream::run, this);
+}
+
+void AsyncFOStream::stop() {
+
+    // Call parent stop method:
+
+    BaseMOStream::stop();
+
+    // Write everything and close:
+
+    this->close();
+}
+
+void AsyncFOStream::submit() {
+
+    // Hand the chunk to the background thread:
+
+    this->full.push(Pending{this->current, this->position, this->fill});
+
+    this->position += static_cast<int64_t>(this->fill);
+    this->fill = 0;
+
+    this->submitted.fetch_add(1, std::memory_order_release);
+    this->submitted.notify_one();
+
+    // Grab a free chunk, waiting if the disk is behind:
+
+    while (!this->empty.pop(this->current)) {
+
+        const uint64_t done = this->written.load(std::memory_order_acquire);
+
+        if (this->empty.read_available() > 0) {
+
+            continue;
+        }
+
+        this->written.wait(done, std::memory_order_acquire);
+    }
+}
+
+void AsyncFOStream::drain() {
+
+    // Wait for the background thread to catch up:
+
+    const uint64_t target = this->submitted.load(std::memory_order_relaxed);
+
+    uint64_t done = this->written.load(std::memory_order_acquire);
+
+    while (done < target) {
+
+        this->written.wait(done, std::memory_order_acquire);
+
+        done = this->written.load(std::memory_order_acquire);
+    }
+}
+
+void AsyncFOStream::close() {
+
+    if (!this->worker.joinable()) {
+
+        return;
+    }
+
+    // Write what is left:
+
+    if (this->fill > 0) {
+
+        this->submit();
+    }
+
+    this->drain();
+
+    // Stop the background thread:
+
+    this->running.store(false, std::memory_order_release);
+
+    this->submitted.fetch_add(1, std::memory_order_release);
+    this->submitted.notify_one();
+
+    this->worker.join();
+
+    // Close the file:
+
+    ::close(this->fd);
+
+    this->fd = -1;
+}
+
+void AsyncFOStream::run() {
+
+    uint64_t seen = 0;
+
+    // Determine if we can still write directly:
+
+    bool aligned = this->direct;
+
+    while (true) {
+
+        // Wait for chunks to be submitted:
+
+        this->submitted.wait(seen, std::memory_order_acquire);
+
+        seen = this->submitted.load(std::memory_order_acquire);
+
+        Pending pend;
+
+        while (this->full.pop(pend)) {
+
+            const char* data = this->memory.data() + pend.index * this->chunk_size;
+
+#ifdef O_DIRECT
+            // Unaligned writes can't be done directly:
+
+            if (aligned && (pend.size % chunk_align != 0 || pend.offset % chunk_align != 0)) {
+
+                ::fcntl(this->fd, F_SETFL, ::fcntl(this->fd, F_GETFL) & ~O_DIRECT);
+
+                aligned = false;
+            }
+#endif
+
+            // Write the chunk:
+
+            std::size_t done = 0;
+
+            while (done < pend.size) {
+
+                const ssize_t res = ::pwrite(this->fd, data + done, pend.size - done, pend.offset + static_cast<int64_t>(done));
+
+                if (res <= 0) {
+
+                    this->failed.store(true, std::memory_order_relaxed);
+
+                    break;
+                }
+
+                done += static_cast<std::size_t>(res);
+            }
+
+            // Hand the chunk back:
+
+            this->empty.push(std::move(pend.index));
+
+            this->written.fetch_add(1, std::memory_order_release);
+            this->written.notify_one();
+        }
+
+        if (!this->running.load(std::memory_order_acquire)) {
+
+            return;
+        }
+    }
+}
+
+std::span<const char> BufferedIStream::peek(std::size_t num) {
+
+    // Determine if we need more bytes:
+
+    if (this->fill - this->pos < num && !this->ended) {
+
+        // Move the remaining bytes to the front:
+
+        std::copy(this->window.begin() + static_cast<std::ptrdiff_t>(this->pos),
+                  this->window.begin() + static_cast<std::ptrdiff_t>(this->fill), this->window.begin());
+
+        this->base += this->pos;
+        this->fill -= this->pos;
+        this->pos = 0;
+
+        // Grow the window if it is too small:
+
+        if (this->window.size() < num) {
+
+            this->window.resize(num);
+        }
+
+        // Refill in one large read:
+
+        const int want = static_cast<int>(this->window.size() - this->fill);
+        const int got = this->inner->read_some(this->window.data() + this->fill, want);
+
+        this->fill += static_cast<std::size_t>(got);
+
+        if (got < want) {
+
+            this->ended = true;
+        }
+    }
+
+    return {this->window.data() + this->pos, std::min(num, this->fill - this->pos)};
+}
+
+void BufferedIStream::seek(int pos) {
+
+    const auto target = static_cast<std::size_t>(std::max(pos, 0));
+
+    // Determine if the position is in the window:
+
+    if (target >= this->base && target <= this->base + this->fill) {
+
+        this->pos = target - this->base;
+
+        return;
+    }
+
+    // Seek the wrapped stream and discard the window:
+
+    this->inner->seek(pos);
+
+    this->base = target;
+    this->pos = 0;
+    this->fill = 0;
+    this->ended = this->inner->bad();
+}
+
+void BufferedIStream::read(char* byts, int num) {
+
+    // Read what we can, and zero the rest:
+
+    const int count = this->read_some(byts, num);
+
+    std::fill_n(byts + count, num - count, 0);
+}
+
+int BufferedIStream::read_some(char* byts, int num) {
+
+    const auto want = static_cast<std::size_t>(num);
+
+    std::size_t count = 0;
+
+    // Large reads skip the window:
+
+    if (want >= this->window.size()) {
+
+        count = this->fill - this->pos;
+
+        std::copy_n(this->window.data() + this->pos, count, byts);
+
+        this->base += this->fill;
+        this->pos = 0;
+        this->fill = 0;
+
+        if (!this->ended) {
+
+            const int got = this->inner->read_some(byts + count, static_cast<int>(want - count));
+
+            this->base += static_cast<std::size_t>(got);
+            this->ended = got < static_cast<int>(want - count);
+
+            count += static_cast<std::size_t>(got);
+        }
+    }
+
+    else {
+
+        // Copy from the window:
+
+        const std::span<const char> avail = this->peek(want);
+
+        std::copy(avail.begin(), avail.end(), byts);
+
+        this->consume(avail.size());
+
+        count = avail.size();
+    }
+
+    // Determine if we read off the end:
+
+    if (count < want) {
+
+        this->stop();
+    }
+
+    return static_cast<int>(count);
+}
+
+void BufferedIStream::start() {
+
+    // Call parent start method:
+
+    BaseMIStream::start();
+
+    // Start the wrapped stream:
+
+    this->inner->start();
+
+    if (this->inner->get_state() == BaseMStream::mstate::err) {
+
+        this->set_state(BaseMStream::mstate::err);
+    }
+
+    if (this->window.empty()) {
+
+        this->window.resize(default_window);
+    }
+
+    this->base = 0;
+    this->pos = 0;
+    this->fill = 0;
+    this->ended = false;
+}
+
+void BufferedIStream::stop() {
+
+    // Call parent stop method:
+
+    BaseMIStream::stop();
+
+    // Stop the wrapped stream:
+
+    this->inner->stop();
+}
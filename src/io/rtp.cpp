@@ -0,0 +1,679 @@
+/**
+ * @file rtp.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations for RTP streaming
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "io/rtp.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <random>
+#include <utility>
+
+#include "audio_buffer.hpp"
+#include "chrono.hpp"
+#include "dsp/interleave.hpp"
+
+namespace {
+
+/// Size of the space given to each received datagram
+constexpr int rtp_stride = 2048;
+
+/// Version of RTP we speak
+constexpr int rtp_version = 2;
+
+/**
+ * @brief Writes a big endian 16 bit value
+ *
+ * @param data Pointer to destination
+ * @param val Value to write
+ */
+void put16(char* data, uint16_t val) {
+
+    data[0] = static_cast<char>(val >> 8);
+    data[1] = static_cast<char>(val);
+}
+
+/**
+ * @brief Writes a big endian 32 bit value
+ *
+ * @param data Pointer to destination
+ * @param val Value to write
+ */
+void put32(char* data, uint32_t val) {
+
+    put16(data, static_cast<uint16_t>(val >> 16));
+    put16(data + 2, static_cast<uint16_t>(val));
+}
+
+/**
+ * @brief Reads a big endian 16 bit value
+ *
+ * @param data Pointer to source
+ * @return uint16_t Value read
+ */
+uint16_t get16(const char* data) { return static_cast<uint16_t>((static_cast<unsigned char>(data[0]) << 8) | static_cast<unsigned char>(data[1])); }
+
+/**
+ * @brief Reads a big endian 32 bit value
+ *
+ * @param data Pointer to source
+ * @return uint32_t Value read
+ */
+uint32_t get32(const char* data) { return (static_cast<uint32_t>(get16(data)) << 16) | get16(data + 2); }
+
+}  // namespace
+
+void RTPHeader::write(char* data) const {
+
+    data[0] = static_cast<char>(rtp_version << 6);
+    data[1] = static_cast<char>((this->marker ? 0x80 : 0) | (this->payload & 0x7F));
+
+    put16(data + 2, this->sequence);
+    put32(data + 4, this->timestamp);
+    put32(data + 8, this->ssrc);
+}
+
+int RTPHeader::read(const char* data, int num, int* payload_size) {
+
+    if (num < size) {
+
+        return -1;
+    }
+
+    const auto first = static_cast<unsigned char>(data[0]);
+
+    if ((first >> 6) != rtp_version) {
+
+        return -1;
+    }
+
+    this->marker = (static_cast<unsigned char>(data[1]) & 0x80) != 0;
+    this->payload = static_cast<uint8_t>(data[1] & 0x7F);
+    this->sequence = get16(data + 2);
+    this->timestamp = get32(data + 4);
+    this->ssrc = get32(data + 8);
+
+    // Skip contributing sources:
+
+    int offset = size + 4 * (first & 0x0F);
+
+    // Skip the extension:
+
+    if ((first & 0x10) != 0) {
+
+        if (offset + 4 > num) {
+
+            return -1;
+        }
+
+        offset += 4 + 4 * get16(data + offset + 2);
+    }
+
+    // Remove any padding:
+
+    int end = num;
+
+    if ((first & 0x20) != 0) {
+
+        end -= static_cast<unsigned char>(data[num - 1]);
+    }
+
+    if (offset > end) {
+
+        return -1;
+    }
+
+    *payload_size = end - offset;
+
+    return offset;
+}
+
+void RTPJitterBuffer::configure(int num, int channels, int max_frames, double rate) {
+
+    this->count = std::bit_ceil(static_cast<uint32_t>(std::max(num, 2)));
+    this->channels = std::max(channels, 1);
+    this->max_frames = std::max(max_frames, 1);
+    this->rate = rate;
+
+    this->slots = std::make_unique<Slot[]>(this->count);
+
+    for (uint32_t i = 0; i < this->count; ++i) {
+
+        this->slots[i].samples.resize(static_cast<std::size_t>(this->max_frames) * this->channels);
+    }
+
+    this->reset();
+}
+
+void RTPJitterBuffer::set_delay(int min_frames, int max_frames) {
+
+    this->min_delay = std::max(min_frames, 0);
+    this->max_delay = std::max(max_frames, this->min_delay);
+}
+
+void RTPJitterBuffer::reset() {
+
+    for (uint32_t i = 0; i < this->count; ++i) {
+
+        this->slots[i].tag.store(0, std::memory_order_relaxed);
+    }
+
+    this->primed = false;
+    this->next = 0;
+    this->newest = 0;
+    this->resync = false;
+    this->packet_frames = 0;
+    this->jitter = 0;
+    this->lost = 0;
+    this->late = 0;
+    this->skipped = 0;
+    this->underruns = 0;
+
+    this->highest = 0;
+    this->buffering = true;
+    this->offset = 0;
+}
+
+int RTPJitterBuffer::buffered() const {
+
+    if (!this->primed.load(std::memory_order_acquire)) {
+
+        return 0;
+    }
+
+    const auto depth = static_cast<int32_t>(this->newest.load(std::memory_order_acquire) - this->next.load(std::memory_order_acquire) + 1);
+
+    return std::max(depth, 0) * this->packet_frames.load(std::memory_order_relaxed);
+}
+
+int RTPJitterBuffer::target() const {
+
+    // Three times the jitter covers nearly all of the variation in delay:
+
+    const auto extra = static_cast<int>(std::lround(3 * this->get_jitter()));
+
+    return std::clamp(this->min_delay + extra, std::max(this->min_delay, this->packet_frames.load(std::memory_order_relaxed)), std::max(this->max_delay, 1));
+}
+
+bool RTPJitterBuffer::push(uint16_t sequence, uint32_t timestamp, PCMFormat format, const char* payload, std::size_t bytes, int64_t arrival) {
+
+    if (this->slots == nullptr) {
+
+        return false;
+    }
+
+    const std::size_t width = pcm_width(format) * this->channels;
+
+    if (width == 0) {
+
+        return false;
+    }
+
+    const int frames = std::min(static_cast<int>(bytes / width), this->max_frames);
+
+    if (frames == 0) {
+
+        return false;
+    }
+
+    const bool first = !this->primed.load(std::memory_order_relaxed);
+
+    // Extend the sequence number, so it does not wrap:
+
+    const uint32_t ext = first ? sequence : this->highest + static_cast<int16_t>(sequence - static_cast<uint16_t>(this->highest));
+
+    if (!first) {
+
+        const auto ahead = static_cast<int32_t>(ext - this->next.load(std::memory_order_acquire));
+
+        // The sender jumped (or restarted), ask the reader to start over from here:
+
+        if (ahead >= static_cast<int32_t>(this->count) || ahead < -static_cast<int32_t>(this->count)) {
+
+            this->highest = ext;
+            this->newest.store(ext, std::memory_order_release);
+
+            this->resync_to.store(ext + 1, std::memory_order_relaxed);
+            this->resync.store(true, std::memory_order_release);
+
+            return false;
+        }
+
+        if (ahead < 0) {
+
+            this->late.fetch_add(1, std::memory_order_relaxed);
+
+            return false;
+        }
+    }
+
+    Slot& slot = this->slots[ext & (this->count - 1)];
+
+    // Ignore duplicates, the reader may be using the slot:
+
+    if (slot.tag.load(std::memory_order_relaxed) == ext + 1) {
+
+        return false;
+    }
+
+    // Decode into the slot and publish it:
+
+    slot.frames = frames;
+
+    pcm_decode(format, payload, slot.samples.data(), static_cast<std::size_t>(frames) * this->channels, true);
+
+    slot.tag.store(ext + 1, std::memory_order_release);
+
+    // Estimate the jitter, in frames:
+
+    const double when = static_cast<double>(arrival) * this->rate / 1e9;
+
+    if (!first) {
+
+        const double diff = (when - this->last_arrival) - static_cast<int32_t>(timestamp - this->last_timestamp);
+
+        const double prev = this->get_jitter();
+
+        this->jitter.store(prev + (std::fabs(diff) - prev) / 16, std::memory_order_relaxed);
+    }
+
+    this->last_arrival = when;
+    this->last_timestamp = timestamp;
+
+    if (frames > this->packet_frames.load(std::memory_order_relaxed)) {
+
+        this->packet_frames.store(frames, std::memory_order_relaxed);
+    }
+
+    if (first || static_cast<int32_t>(ext - this->highest) > 0) {
+
+        this->highest = ext;
+        this->newest.store(ext, std::memory_order_release);
+    }
+
+    if (first) {
+
+        this->next.store(ext, std::memory_order_relaxed);
+        this->primed.store(true, std::memory_order_release);
+    }
+
+    return true;
+}
+
+int RTPJitterBuffer::pop(sample_t* output, int frames) {
+
+    const std::size_t width = this->channels;
+
+    int done = 0;
+    int real = 0;
+
+    if (this->primed.load(std::memory_order_acquire)) {
+
+        // Move to where the writer asked us to:
+
+        if (this->resync.load(std::memory_order_acquire)) {
+
+            this->resync.store(false, std::memory_order_relaxed);
+
+            this->next.store(this->resync_to.load(std::memory_order_relaxed), std::memory_order_release);
+            this->offset = 0;
+            this->buffering = true;
+        }
+
+        uint32_t cur = this->next.load(std::memory_order_relaxed);
+
+        const int pframes = std::max(this->packet_frames.load(std::memory_order_relaxed), 1);
+        const int goal = this->target();
+
+        // Skip a packet if we have far too much buffered, at most once per call so the delay shrinks gently:
+
+        const auto ahead = static_cast<int32_t>(this->newest.load(std::memory_order_acquire) - cur + 1) * pframes - this->offset;
+
+        if (!this->buffering && this->offset == 0 && ahead > 2 * goal + 2 * pframes && this->slots[cur & (this->count - 1)].tag.load(std::memory_order_acquire) == cur + 1) {
+
+            this->skipped.fetch_add(1, std::memory_order_relaxed);
+
+            this->next.store(++cur, std::memory_order_release);
+        }
+
+        while (done < frames) {
+
+            const uint32_t top = this->newest.load(std::memory_order_acquire);
+            const int depth = static_cast<int32_t>(top - cur + 1) * pframes - this->offset;
+
+            // Wait until we reach the target delay:
+
+            if (this->buffering) {
+
+                if (depth < goal) {
+
+                    break;
+                }
+
+                this->buffering = false;
+            }
+
+            Slot& slot = this->slots[cur & (this->count - 1)];
+
+            if (slot.tag.load(std::memory_order_acquire) == cur + 1) {
+
+                // Copy what we can from this packet:
+
+                const int num = std::min(slot.frames - this->offset, frames - done);
+
+                std::copy_n(slot.samples.data() + this->offset * width, num * width, output + done * width);
+
+                this->offset += num;
+                done += num;
+                real += num;
+
+                if (this->offset >= slot.frames) {
+
+                    this->offset = 0;
+                    this->next.store(++cur, std::memory_order_release);
+                }
+            }
+
+            else if (static_cast<int32_t>(top - cur) > 0) {
+
+                // This packet never arrived, but later ones did, conceal it with silence:
+
+                const int num = std::min(pframes - this->offset, frames - done);
+
+                std::fill_n(output + done * width, num * width, 0);
+
+                this->offset += num;
+                done += num;
+
+                if (this->offset >= pframes) {
+
+                    this->lost.fetch_add(1, std::memory_order_relaxed);
+
+                    this->offset = 0;
+                    this->next.store(++cur, std::memory_order_release);
+                }
+            }
+
+            else {
+
+                // Out of packets, rebuffer:
+
+                this->underruns.fetch_add(1, std::memory_order_relaxed);
+
+                this->buffering = true;
+
+                break;
+            }
+        }
+    }
+
+    // Anything we could not fill is silent:
+
+    std::fill(output + done * width, output + frames * width, 0);
+
+    return real;
+}
+
+RTPSink::RTPSink(const std::string& host, int port) : stream(host, port) {
+
+    // Random starting values, as recommended by RFC 3550:
+
+    std::random_device dev;
+
+    this->header.sequence = static_cast<uint16_t>(dev());
+    this->header.timestamp = dev();
+    this->header.ssrc = dev();
+}
+
+int RTPSink::get_packet_frames(int channels) const {
+
+    const auto width = static_cast<int>(pcm_width(this->format)) * std::max(channels, 1);
+
+    return std::clamp(RTPSink::MAX_PAYLOAD / std::max(width, 1), 1, this->packet_frames);
+}
+
+void RTPSink::prepare(int channels, int frames) {
+
+    const int pframes = this->get_packet_frames(channels);
+    const int count = (frames + pframes - 1) / pframes + 1;
+
+    const std::size_t stride = RTPHeader::size + static_cast<std::size_t>(pframes) * channels * pcm_width(this->format);
+
+    if (this->data.size() < stride * count) {
+
+        this->data.resize(stride * count);
+    }
+
+    if (static_cast<int>(this->ptrs.size()) < count) {
+
+        this->ptrs.resize(count);
+        this->sizes.resize(count);
+    }
+
+    // Room for the frames we carried, plus a block:
+
+    const std::size_t staged = static_cast<std::size_t>(frames + pframes) * channels;
+
+    if (this->inter.size() < staged) {
+
+        this->inter.resize(staged);
+    }
+
+    this->stream.reserve(count);
+}
+
+void RTPSink::process() {
+
+    const int channels = static_cast<int>(this->buff->channels());
+    const int frames = static_cast<int>(this->buff->channel_capacity());
+
+    this->prepare(channels, frames);
+
+    // Frames we carried are no good if the channels changed:
+
+    if (channels != this->staged_channels) {
+
+        this->carried = 0;
+        this->staged_channels = channels;
+    }
+
+    // Packets hold interleaved frames, so stage the block after the frames we carried:
+
+    sample_t* stage = this->inter.data();
+    sample_t* tail = stage + static_cast<std::ptrdiff_t>(this->carried) * channels;
+
+    if constexpr (AudioBuffer::layout::planar) {
+
+        interleave(this->buff->data(), tail, channels, frames);
+    }
+
+    else {
+
+        std::copy_n(this->buff->data(), static_cast<std::size_t>(frames) * channels, tail);
+    }
+
+    // Split the staged frames into full packets:
+
+    const int pframes = this->get_packet_frames(channels);
+    const int total = this->carried + frames;
+    const int count = total / pframes;
+
+    const std::size_t width = pcm_width(this->format) * channels;
+    const std::size_t stride = RTPHeader::size + pframes * width;
+
+    for (int i = 0; i < count; ++i) {
+
+        char* packet = this->data.data() + i * stride;
+
+        this->header.write(packet);
+
+        pcm_encode(this->format, stage + static_cast<std::ptrdiff_t>(i) * pframes * channels, packet + RTPHeader::size, static_cast<std::size_t>(pframes) * channels, true);
+
+        this->ptrs[i] = packet;
+        this->sizes[i] = static_cast<int>(stride);
+
+        this->header.marker = false;
+        ++(this->header.sequence);
+        this->header.timestamp += static_cast<uint32_t>(pframes);
+    }
+
+    // Send them all at once:
+
+    this->stream.write_batch(this->ptrs.data(), this->sizes.data(), count);
+
+    this->packets += count;
+
+    // Carry the rest to the next block:
+
+    this->carried = total - count * pframes;
+
+    std::copy_n(stage + static_cast<std::ptrdiff_t>(count) * pframes * channels, static_cast<std::size_t>(this->carried) * channels, stage);
+}
+
+void RTPSink::start() {
+
+    this->stream.start();
+
+    // The first packet starts a talkspurt:
+
+    this->header.marker = true;
+    this->packets = 0;
+    this->carried = 0;
+
+    this->prepare(this->get_info()->channels, this->max_block_size());
+}
+
+void RTPSink::stop() { this->stream.stop(); }
+
+void RTPSource::process() {
+
+    auto buff = this->create_buffer(this->channels);
+
+    const int frames = static_cast<int>(buff->channel_capacity());
+
+    if constexpr (AudioBuffer::layout::planar) {
+
+        if (this->inter.size() < static_cast<std::size_t>(frames) * this->channels) {
+
+            this->inter.resize(static_cast<std::size_t>(frames) * this->channels);
+        }
+
+        this->jitter.pop(this->inter.data(), frames);
+
+        deinterleave(this->inter.data(), buff->data(), this->channels, frames);
+    }
+
+    else {
+
+        this->jitter.pop(buff->data(), frames);
+    }
+
+    this->set_buffer(std::move(buff));
+}
+
+void RTPSource::info_sync() {
+
+    SourceModule::info_sync();
+
+    this->get_info()->channels = this->channels;
+    this->get_info()->in_buffer = 0;
+}
+
+void RTPSource::start() {
+
+    this->stop();
+
+    // Packets can hold as many frames as fit in the payload at 16 bits:
+
+    const int max_frames = RTPSink::MAX_PAYLOAD / (2 * std::max(this->channels, 1));
+
+    this->jitter.configure(this->slots, this->channels, max_frames, this->get_info()->sample_rate);
+
+    if (AudioBuffer::layout::planar) {
+
+        this->inter.resize(static_cast<std::size_t>(this->max_block_size()) * this->channels);
+    }
+
+    this->packets = 0;
+
+    this->stream.start();
+
+    if (this->stream.bad()) {
+
+        return;
+    }
+
+    this->running = true;
+
+    this->receiver = std::thread(&RTPSource::run, this);
+}
+
+void RTPSource::stop() {
+
+    if (this->receiver.joinable()) {
+
+        this->running = false;
+
+        this->receiver.join();
+    }
+
+    this->stream.stop();
+}
+
+void RTPSource::run() {
+
+    std::vector<char> data(static_cast<std::size_t>(this->batch) * rtp_stride);
+    std::vector<int> sizes(this->batch);
+
+    this->stream.reserve(this->batch);
+
+    bool locked = false;
+    uint32_t ssrc = 0;
+
+    while (this->running.load(std::memory_order_relaxed)) {
+
+        const int got = this->stream.read_batch(data.data(), rtp_stride, sizes.data(), this->batch);
+
+        const int64_t now = get_time();
+
+        for (int i = 0; i < got; ++i) {
+
+            const char* packet = data.data() + static_cast<std::ptrdiff_t>(i) * rtp_stride;
+
+            RTPHeader head;
+            int size = 0;
+
+            const int offset = head.read(packet, sizes[i], &size);
+
+            if (offset < 0 || (this->payload >= 0 && head.payload != this->payload)) {
+
+                continue;
+            }
+
+            // Lock on to the first stream we see:
+
+            if (!locked) {
+
+                ssrc = head.ssrc;
+                locked = true;
+            }
+
+            if (head.ssrc != ssrc) {
+
+                continue;
+            }
+
+            this->packets.fetch_add(1, std::memory_order_relaxed);
+
+            this->jitter.push(head.sequence, head.timestamp, this->format, packet + offset, static_cast<std::size_t>(size), now);
+        }
+    }
+}
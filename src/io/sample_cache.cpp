@@ -0,0 +1,504 @@
+/**
+ * @file sample_cache.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations for the sample cache
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "io/sample_cache.hpp"
+
+#include <algorithm>
+
+#include "dsp/interleave.hpp"
+#include "io/wav.hpp"
+
+namespace {
+
+/// Number of frames the streaming thread decodes at once
+const int64_t stream_chunk = 4096;
+
+}  // namespace
+
+int64_t CachedSample::decode(int64_t frame, int64_t num, sample_t* output) const {
+
+    // Determine the number of frames we can decode:
+
+    const int64_t count = std::clamp<int64_t>(this->frames - frame, 0, num);
+
+    if (count == 0) {
+
+        return 0;
+    }
+
+    const auto samples = static_cast<std::size_t>(count * this->channels);
+
+    // Copy from the decoded frames if we have them:
+
+    if (frame + count <= this->head_frames) {
+
+        std::copy_n(this->head.data() + frame * this->channels, samples, output);
+
+        return count;
+    }
+
+    // Otherwise, decode straight from the mapping:
+
+    if (this->data == nullptr) {
+
+        return 0;
+    }
+
+    pcm_decode(this->format, this->data + frame * this->blockalign, output, samples);
+
+    return count;
+}
+
+int SampleCache::Stream::read(sample_t* output, int num) {
+
+    const int channels = this->sample->get_channels();
+
+    const auto got = this->ring.read(output, static_cast<std::size_t>(num) * channels);
+
+    // Let the streaming thread top us up:
+
+    this->cache->wake();
+
+    return static_cast<int>(got / channels);
+}
+
+SampleCache::~SampleCache() {
+
+    // Stop the streaming thread:
+
+    if (this->streamer.joinable()) {
+
+        this->running.store(false, std::memory_order_release);
+
+        this->wake();
+
+        this->streamer.join();
+    }
+}
+
+std::shared_ptr<const CachedSample> SampleCache::get(const std::string& path) {
+
+    // Determine if we already have this sample:
+
+    {
+        const std::lock_guard<std::mutex> guard(this->lock);
+
+        auto iter = this->entries.find(path);
+
+        if (iter != this->entries.end()) {
+
+            // Mark as most recently used:
+
+            this->order.splice(this->order.begin(), this->order, iter->second.pos);
+
+            this->hits.fetch_add(1, std::memory_order_relaxed);
+
+            return iter->second.sample;
+        }
+    }
+
+    // Load the sample without holding the lock, as this may take a while:
+
+    this->misses.fetch_add(1, std::memory_order_relaxed);
+
+    auto sample = this->load(path);
+
+    if (sample == nullptr) {
+
+        return nullptr;
+    }
+
+    const std::lock_guard<std::mutex> guard(this->lock);
+
+    // Someone else may have loaded it in the meantime, if so use theirs:
+
+    auto iter = this->entries.find(path);
+
+    if (iter != this->entries.end()) {
+
+        this->order.splice(this->order.begin(), this->order, iter->second.pos);
+
+        return iter->second.sample;
+    }
+
+    // Add the sample as most recently used:
+
+    this->order.push_front(path);
+    this->entries.emplace(path, Entry{sample, this->order.begin()});
+
+    this->memory += sample->bytes();
+
+    // Make room for it:
+
+    this->evict(this->budget);
+
+    return sample;
+}
+
+std::shared_ptr<CachedSample> SampleCache::load(const std::string& path) const {
+
+    auto sample = std::make_shared<CachedSample>();
+
+    sample->path = path;
+    sample->map = std::make_unique<MMapIStream>(path);
+
+    // Parse the headers and find the data chunk:
+
+    WaveReader reader(sample->map.get());
+
+    reader.start();
+    reader.seek_frame(0);
+
+    const char* base = sample->map->contiguous();
+
+    if (base == nullptr || sample->map->bad() || reader.get_data_start() == 0) {
+
+        return nullptr;
+    }
+
+    sample->format = pcm_format(reader.get_bits_per_sample(), reader.get_format() == 3);
+    sample->channels = reader.get_channels();
+    sample->sample_rate = reader.get_samplerate();
+    sample->blockalign = reader.get_blockalign();
+
+    if (pcm_width(sample->format) == 0 || sample->channels <= 0 || sample->blockalign <= 0) {
+
+        return nullptr;
+    }
+
+    // Truncated files claim more frames than they hold:
+
+    const auto stored = static_cast<int64_t>(sample->map->length() - reader.get_data_start()) / sample->blockalign;
+
+    sample->frames = std::min(reader.get_frames(), stored);
+    sample->data = base + reader.get_data_start();
+
+    // Decode everything if it is small, otherwise just the attack:
+
+    const auto decoded = static_cast<std::size_t>(sample->frames * sample->channels) * sizeof(sample_t);
+
+    sample->head_frames = decoded <= this->threshold ? sample->frames :
+        std::min<int64_t>(sample->frames, static_cast<int64_t>(this->preload) * sample->sample_rate / 1000);
+
+    sample->head.resize(static_cast<std::size_t>(sample->head_frames * sample->channels));
+
+    pcm_decode(sample->format, sample->data, sample->head.data(), sample->head.size());
+
+    // Release the mapping if we never stream from it:
+
+    if (sample->complete()) {
+
+        sample->data = nullptr;
+        sample->map.reset();
+    }
+
+    return sample;
+}
+
+void SampleCache::evict(std::size_t limit) {
+
+    // Walk from the least recently used sample:
+
+    auto iter = this->order.end();
+
+    while (this->memory > limit && iter != this->order.begin()) {
+
+        --iter;
+
+        auto entry = this->entries.find(*iter);
+
+        // Samples that are being used elsewhere are kept:
+
+        if (entry->second.sample.use_count() > 1) {
+
+            continue;
+        }
+
+        this->memory -= entry->second.sample->bytes();
+
+        this->entries.erase(entry);
+
+        iter = this->order.erase(iter);
+
+        this->evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+std::shared_ptr<SampleCache::Stream> SampleCache::open_stream(std::shared_ptr<const CachedSample> sample) {
+
+    auto stream = std::make_shared<Stream>();
+
+    const int channels = sample->get_channels();
+
+    stream->cache = this;
+    stream->next = sample->get_head_frames();
+    stream->sample = std::move(sample);
+    stream->ring.reserve(static_cast<std::size_t>(this->ahead) * channels);
+    stream->drained.store(stream->next >= stream->sample->get_frames(), std::memory_order_relaxed);
+
+    {
+        const std::lock_guard<std::mutex> guard(this->lock);
+
+        this->streams.push_back(stream);
+
+        // Start the streaming thread if necessary:
+
+        if (!this->streamer.joinable()) {
+
+            this->running.store(true, std::memory_order_release);
+
+            this->streamer = std::thread(&SampleCache::run, this);
+        }
+    }
+
+    this->wake();
+
+    return stream;
+}
+
+void SampleCache::close_stream(const std::shared_ptr<Stream>& stream) {
+
+    const std::lock_guard<std::mutex> guard(this->lock);
+
+    std::erase(this->streams, stream);
+}
+
+void SampleCache::set_budget(std::size_t limit) {
+
+    const std::lock_guard<std::mutex> guard(this->lock);
+
+    this->budget = limit;
+
+    this->evict(this->budget);
+}
+
+std::size_t SampleCache::get_memory() const {
+
+    const std::lock_guard<std::mutex> guard(this->lock);
+
+    return this->memory;
+}
+
+std::size_t SampleCache::size() const {
+
+    const std::lock_guard<std::mutex> guard(this->lock);
+
+    return this->entries.size();
+}
+
+void SampleCache::clear() {
+
+    const std::lock_guard<std::mutex> guard(this->lock);
+
+    this->evict(0);
+}
+
+void SampleCache::wake() {
+
+    this->wakes.fetch_add(1, std::memory_order_release);
+    this->wakes.notify_one();
+}
+
+void SampleCache::run() {
+
+    std::vector<std::shared_ptr<Stream>> active;
+    std::vector<sample_t> scratch;
+
+    while (this->running.load(std::memory_order_acquire)) {
+
+        const uint64_t seen = this->wakes.load(std::memory_order_acquire);
+
+        // Take a copy of the streams, so we decode without the lock:
+
+        {
+            const std::lock_guard<std::mutex> guard(this->lock);
+
+            active = this->streams;
+        }
+
+        bool work = false;
+
+        for (const auto& stream : active) {
+
+            if (stream->finished()) {
+
+                continue;
+            }
+
+            const CachedSample& sample = *(stream->sample);
+
+            const int channels = sample.get_channels();
+
+            // Determine how many frames we have room for:
+
+            const auto room = static_cast<int64_t>(stream->ring.write_available() / channels);
+
+            const int64_t num = std::min({room, stream_chunk, sample.get_frames() - stream->next});
+
+            if (num <= 0) {
+
+                continue;
+            }
+
+            scratch.resize(static_cast<std::size_t>(num * channels));
+
+            const int64_t got = sample.decode(stream->next, num, scratch.data());
+
+            stream->ring.write(scratch.data(), static_cast<std::size_t>(got * channels));
+            stream->next += got;
+
+            if (got == 0 || stream->next >= sample.get_frames()) {
+
+                stream->drained.store(true, std::memory_order_release);
+            }
+
+            work = true;
+        }
+
+        active.clear();
+
+        // Sleep until a source reads, or a stream is opened:
+
+        if (!work) {
+
+            this->wakes.wait(seen, std::memory_order_acquire);
+        }
+    }
+}
+
+void SampleSource::footprint(MemoryFootprint& usage) const {
+
+    AudioModule::footprint(usage);
+
+    if (this->sample != nullptr) {
+
+        usage.samples += this->sample->bytes();
+    }
+
+    if (this->stream != nullptr) {
+
+        usage.state += this->stream->bytes();
+    }
+
+    usage.state += heap_bytes(this->frames);
+}
+
+void SampleSource::start() {
+
+    // Release anything from a previous run:
+
+    this->stop();
+
+    SourceModule::start();
+
+    this->position = 0;
+    this->underruns = 0;
+
+    this->sample = this->cache->get(this->path);
+
+    auto* info = this->get_info();
+
+    info->in_buffer = 0;
+
+    if (this->sample == nullptr) {
+
+        return;
+    }
+
+    // Populate our AudioInfo data from the sample:
+
+    info->channels = this->sample->get_channels();
+    info->sample_rate = this->sample->get_samplerate();
+
+    // Stream the rest if we only have the attack:
+
+    if (!this->sample->complete()) {
+
+        this->stream = this->cache->open_stream(this->sample);
+    }
+}
+
+void SampleSource::stop() {
+
+    SourceModule::stop();
+
+    if (this->stream != nullptr) {
+
+        this->cache->close_stream(this->stream);
+
+        this->stream.reset();
+    }
+
+    this->sample.reset();
+}
+
+void SampleSource::process() {
+
+    const int channels = this->sample != nullptr ? this->sample->get_channels() : this->get_info()->channels;
+
+    auto buff = this->create_buffer(channels);
+
+    if (this->sample == nullptr) {
+
+        this->set_buffer(std::move(buff));
+
+        return;
+    }
+
+    const int frames = static_cast<int>(buff->channel_capacity());
+
+    // Determine where the interleaved frames go:
+
+    sample_t* dest = buff->data();
+
+    if constexpr (AudioBuffer::layout::planar) {
+
+        this->frames.assign(static_cast<std::size_t>(frames) * channels, 0);
+
+        dest = this->frames.data();
+    }
+
+    // Copy what we can from the decoded frames:
+
+    const int64_t head = std::clamp<int64_t>(this->sample->get_head_frames() - this->position, 0, frames);
+
+    int done = static_cast<int>(this->sample->decode(this->position, head, dest));
+
+    this->position += done;
+
+    // Read the rest from the stream:
+
+    if (done < frames && this->stream != nullptr) {
+
+        const int got = this->stream->read(dest + static_cast<std::ptrdiff_t>(done) * channels, frames - done);
+
+        this->position += got;
+        done += got;
+
+        // Determine if this is an underrun:
+
+        if (done < frames && this->position < this->sample->get_frames()) {
+
+            ++(this->underruns);
+        }
+    }
+
+    // Pad with silence:
+
+    std::fill(dest + static_cast<std::ptrdiff_t>(done) * channels, dest + static_cast<std::ptrdiff_t>(frames) * channels, 0);
+
+    if constexpr (AudioBuffer::layout::planar) {
+
+        deinterleave(this->frames.data(), buff->data(), channels, frames);
+    }
+
+    this->set_buffer(std::move(buff));
+}
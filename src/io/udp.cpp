@@ -0,0 +1,391 @@
+/**
+ * @file udp.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations for UDP mstreams
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "io/udp.hpp"
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+void UDPOStream::write(char* byts, int num) {
+
+    if (this->fd < 0) {
+
+        return;
+    }
+
+    if (sendto(this->fd, byts, static_cast<std::size_t>(num), 0, reinterpret_cast<const sockaddr*>(&(this->dest)), this->dest_len) < 0) {
+
+        ++(this->errors);
+    }
+}
+
+int UDPOStream::write_batch(char* const* datagrams, const int* sizes, int num) {
+
+    if (this->fd < 0 || num <= 0) {
+
+        return 0;
+    }
+
+    this->reserve(num);
+
+    for (int i = 0; i < num; ++i) {
+
+        this->iovs[i].iov_base = datagrams[i];
+        this->iovs[i].iov_len = static_cast<std::size_t>(sizes[i]);
+    }
+
+#ifdef __linux__
+
+    // Send the whole batch with as few calls as possible:
+
+    for (int i = 0; i < num; ++i) {
+
+        msghdr& hdr = this->msgs[i].msg_hdr;
+
+        hdr = msghdr{};
+        hdr.msg_name = &(this->dest);
+        hdr.msg_namelen = this->dest_len;
+        hdr.msg_iov = &(this->iovs[i]);
+        hdr.msg_iovlen = 1;
+    }
+
+    int sent = 0;
+    int failed = 0;
+
+    while (sent < num) {
+
+        const int done = sendmmsg(this->fd, this->msgs.data() + sent, static_cast<unsigned int>(num - sent), 0);
+
+        if (done <= 0) {
+
+            // Skip the datagram that failed, and try the rest:
+
+            ++failed;
+            ++sent;
+
+            continue;
+        }
+
+        sent += done;
+    }
+
+    this->errors += failed;
+
+    return num - failed;
+
+#else
+
+    int sent = 0;
+
+    for (int i = 0; i < num; ++i) {
+
+        if (sendto(this->fd, this->iovs[i].iov_base, this->iovs[i].iov_len, 0, reinterpret_cast<const sockaddr*>(&(this->dest)), this->dest_len) < 0) {
+
+            ++(this->errors);
+
+            continue;
+        }
+
+        ++sent;
+    }
+
+    return sent;
+
+#endif
+}
+
+void UDPOStream::reserve(int num) {
+
+    const auto size = static_cast<std::size_t>(std::max(num, 0));
+
+    if (this->iovs.size() < size) {
+
+        this->iovs.resize(size);
+
+#ifdef __linux__
+
+        this->msgs.resize(size);
+
+#endif
+    }
+}
+
+void UDPOStream::start() {
+
+    this->close();
+
+    // Resolve the destination:
+
+    addrinfo hints{};
+
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+
+    addrinfo* res = nullptr;
+
+    const std::string service = std::to_string(this->port);
+
+    if (getaddrinfo(this->host.c_str(), service.c_str(), &hints, &res) != 0 || res == nullptr) {
+
+        this->set_state(err);
+
+        return;
+    }
+
+    std::memcpy(&(this->dest), res->ai_addr, res->ai_addrlen);
+    this->dest_len = res->ai_addrlen;
+
+    this->fd = socket(res->ai_family, SOCK_DGRAM, 0);
+
+    freeaddrinfo(res);
+
+    if (this->fd < 0) {
+
+        this->set_state(err);
+
+        return;
+    }
+
+    // Configure the socket, these are only hints so failures are ignored:
+
+    if (this->dest.ss_family == AF_INET) {
+
+        setsockopt(this->fd, IPPROTO_IP, IP_MULTICAST_TTL, &(this->ttl), sizeof(this->ttl));
+
+        if (this->dscp >= 0) {
+
+            const int tos = this->dscp << 2;
+
+            setsockopt(this->fd, IPPROTO_IP, IP_TOS, &tos, sizeof(tos));
+        }
+    }
+
+    else if (this->dest.ss_family == AF_INET6) {
+
+        setsockopt(this->fd, IPPROTO_IPV6, IPV6_MULTICAST_HOPS, &(this->ttl), sizeof(this->ttl));
+
+        if (this->dscp >= 0) {
+
+            const int tclass = this->dscp << 2;
+
+            setsockopt(this->fd, IPPROTO_IPV6, IPV6_TCLASS, &tclass, sizeof(tclass));
+        }
+    }
+
+    this->errors = 0;
+
+    BaseMOStream::start();
+}
+
+void UDPOStream::stop() {
+
+    this->close();
+
+    BaseMOStream::stop();
+}
+
+void UDPOStream::close() {
+
+    if (this->fd >= 0) {
+
+        ::close(this->fd);
+
+        this->fd = -1;
+    }
+}
+
+bool UDPIStream::wait() {
+
+    pollfd pfd{this->fd, POLLIN, 0};
+
+    return poll(&pfd, 1, this->timeout) > 0 && (pfd.revents & POLLIN) != 0;
+}
+
+void UDPIStream::read(char* byts, int num) {
+
+    const int got = this->read_some(byts, num);
+
+    std::fill(byts + got, byts + num, 0);
+}
+
+int UDPIStream::read_some(char* byts, int num) {
+
+    if (this->fd < 0 || !this->wait()) {
+
+        return 0;
+    }
+
+    const ssize_t got = recv(this->fd, byts, static_cast<std::size_t>(num), 0);
+
+    return got > 0 ? static_cast<int>(std::min<ssize_t>(got, num)) : 0;
+}
+
+int UDPIStream::read_batch(char* byts, int stride, int* sizes, int num) {
+
+    if (this->fd < 0 || num <= 0 || !this->wait()) {
+
+        return 0;
+    }
+
+    this->reserve(num);
+
+    for (int i = 0; i < num; ++i) {
+
+        this->iovs[i].iov_base = byts + static_cast<std::ptrdiff_t>(i) * stride;
+        this->iovs[i].iov_len = static_cast<std::size_t>(stride);
+    }
+
+#ifdef __linux__
+
+    // Take every datagram that is waiting, up to the batch size:
+
+    for (int i = 0; i < num; ++i) {
+
+        msghdr& hdr = this->msgs[i].msg_hdr;
+
+        hdr = msghdr{};
+        hdr.msg_iov = &(this->iovs[i]);
+        hdr.msg_iovlen = 1;
+    }
+
+    const int got = recvmmsg(this->fd, this->msgs.data(), static_cast<unsigned int>(num), MSG_DONTWAIT, nullptr);
+
+    for (int i = 0; i < got; ++i) {
+
+        sizes[i] = static_cast<int>(this->msgs[i].msg_len);
+    }
+
+    return std::max(got, 0);
+
+#else
+
+    int got = 0;
+
+    while (got < num) {
+
+        const ssize_t size = recv(this->fd, this->iovs[got].iov_base, this->iovs[got].iov_len, MSG_DONTWAIT);
+
+        if (size < 0) {
+
+            break;
+        }
+
+        sizes[got++] = static_cast<int>(size);
+    }
+
+    return got;
+
+#endif
+}
+
+void UDPIStream::reserve(int num) {
+
+    const auto size = static_cast<std::size_t>(std::max(num, 0));
+
+    if (this->iovs.size() < size) {
+
+        this->iovs.resize(size);
+
+#ifdef __linux__
+
+        this->msgs.resize(size);
+
+#endif
+    }
+}
+
+void UDPIStream::start() {
+
+    this->close();
+
+    this->fd = socket(AF_INET, SOCK_DGRAM, 0);
+
+    if (this->fd < 0) {
+
+        this->set_state(err);
+
+        return;
+    }
+
+    // Allow other receivers of the same group to bind the port:
+
+    const int reuse = 1;
+
+    setsockopt(this->fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    // Bind to the port on every interface:
+
+    sockaddr_in addr{};
+
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(this->port));
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+
+    if (bind(this->fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) {
+
+        this->close();
+        this->set_state(err);
+
+        return;
+    }
+
+    // Determine the port we were given:
+
+    socklen_t len = sizeof(addr);
+
+    if (getsockname(this->fd, reinterpret_cast<sockaddr*>(&addr), &len) == 0) {
+
+        this->port = ntohs(addr.sin_port);
+    }
+
+    // Join the group if necessary:
+
+    if (!this->group.empty()) {
+
+        ip_mreq req{};
+
+        req.imr_interface.s_addr = htonl(INADDR_ANY);
+
+        if (inet_pton(AF_INET, this->group.c_str(), &(req.imr_multiaddr)) != 1 || setsockopt(this->fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &req, sizeof(req)) != 0) {
+
+            this->close();
+            this->set_state(err);
+
+            return;
+        }
+    }
+
+    BaseMIStream::start();
+}
+
+void UDPIStream::stop() {
+
+    this->close();
+
+    BaseMIStream::stop();
+}
+
+void UDPIStream::close() {
+
+    if (this->fd >= 0) {
+
+        ::close(this->fd);
+
+        this->fd = -1;
+    }
+}
@@ -9,10 +9,17 @@
  * 
  */
 
+#include <algorithm>
+#include <chrono>
+#include <span>
+#include <thread>
 #include <vector>
 
 #include "io/wav.hpp"
 #include "audio_buffer.hpp"
+#include "dsp/convert.hpp"
+#include "dsp/interleave.hpp"
+#include "trace.hpp"
 
 void ChunkHeader::decode(BaseMIStream& stream) {
 
@@ -209,20 +216,17 @@ void WaveReader::start() {
 
     this->set_size(head.chunk_size + 8);
 
-    // Next, read the format chunk
-    // TODO: Is it always guaranteed that format will always be second chunk?
+    // Next, find the format chunk
+    // Some files have chunks before it (such as space reserved for RF64),
+    // so skip anything else:
 
-    ChunkHeader chead;
-
-    this->read_chunk_header(chead);
+    this->read_chunk_header(this->head);
 
-    // Determine this chunk is a format chunk:
+    while (this->head.chunk_id != "fmt " && !this->done()) {
 
-    if (chead.chunk_id != "fmt ") {
+        this->skip_chunk();
 
-        // This chunk is not format chunk
-        // TODO: Gotta do something here
-        int dhd = 0;
+        this->read_chunk_header(this->head);
     }
 
     // Read the wave format chunk
@@ -273,19 +277,8 @@ void WaveReader::read_format_chunk(WavFormat& chunk) {
     this->total_read += 16;
 }
 
-BufferPointer WaveReader::get_data() {
-
-    // Define the BufferPointer to return:
-
-    BufferPointer bpoint = std::make_unique<AudioBuffer>(
-        this->buffer_size,
-        this->get_channels());
-
-    // Also set the sample rate:
-
-    bpoint->set_samplerate(this->get_samplerate());
-
-    // Define some variables:
+template <typename T>
+int WaveReader::read_samples(T* dest) {
 
     int read = 0;
 
@@ -302,34 +295,14 @@ BufferPointer WaveReader::get_data() {
 
             if (this->head.chunk_id != "data") {
 
-                // Create UnknownChunk:
-
-                UnknownChunk chunk(this->head.chunk_size);
-
-                // Not a data chunk, read data into an unknown chunk:
+                // Not a data chunk, skip it:
 
-                this->stream->read(chunk.data.data(), this->head.chunk_size);
-
-                // Also copy over other pieces of info:
-
-                chunk.chunk_id = head.chunk_id;
-                chunk.chunk_size = head.chunk_size;
-
-                // We are past this weird chunk! Continue
-                // TODO: Should we save these chunks somewhere?
-
-                this->total_read += this->head.chunk_size;
+                this->skip_chunk();
 
                 continue;
             }
 
-            // Set our reading chunk status:
-
-            this->needs_chunk = false;
-
-            // Set the number of bytes read from this chunk:
-
-            this->chunk_read = 0;
+            this->enter_data();
         }
 
         // Determine which processing pathway to utilize:
@@ -368,11 +341,29 @@ BufferPointer WaveReader::get_data() {
             to_read = buffer_bytes;
         }
 
-        // Read data into vector:
+        // Find the bytes to decode:
+
+        const char* src = this->stream->contiguous();
+
+        if (src != nullptr) {
+
+            // Decode straight from the stream contents:
+
+            src += this->total_read;
+
+            this->stream->seek(static_cast<int>(this->total_read) + to_read);
+        }
+
+        else {
+
+            // Read data into scratch space:
 
-        std::vector<char> tdata(to_read);
+            this->raw.resize(to_read);
 
-        this->stream->read(tdata.data(), to_read);
+            this->stream->read(this->raw.data(), to_read);
+
+            src = this->raw.data();
+        }
 
         this->total_read += to_read;
 
@@ -380,53 +371,56 @@ BufferPointer WaveReader::get_data() {
 
         this->chunk_read += to_read;
 
-        // Determine which type to read in:
+        // Decode the samples:
 
-        if (this->get_bits_per_sample() == 16) {
+        read += this->decode(src, to_read, dest + read);
+    }
 
-            // We are reading in 16 bit ints:
+    // Determine if we need to close the file (reached end):
 
-            for (int i = 0; i < static_cast<int>(tdata.size() / 2); ++i) {
+    if (this->total_read >= this->get_size()) {
 
-                // Read this int16:
+        // Stop this WaveReader
 
-                auto val = char_int16(tdata.begin() +
-                                      static_cast<int64_t>(i) * 2);
+        this->stop();
+    }
 
-                // Convert to mf:
+    return read;
+}
 
-                auto mf_val = int16_mf(val);
+BufferPointer WaveReader::get_data() {
 
-                // Add value to final vector:
+    MAEC_TRACE_SCOPE("io", "WaveReader::get_data");
 
-                bpoint->at(read++) = mf_val;
-            }
-        }
+    // Define the BufferPointer to return:
 
-        else if (this->get_bits_per_sample() == 8) {
+    BufferPointer bpoint = std::make_unique<AudioBuffer>(
+        this->buffer_size,
+        this->get_channels());
 
-            // We are reading in unsigned chars
+    // Also set the sample rate:
 
-            for (char i : tdata) {
+    bpoint->set_samplerate(this->get_samplerate());
 
-                // Convert into mf:
+    // Samples are decoded in interleaved order,
+    // so planar buffers are decoded into scratch space first:
 
-                const long double val = uchar_mf(i);
+    sample_t* dest = bpoint->data();
 
-                // Add to buffer:
+    if constexpr (AudioBuffer::layout::planar) {
 
-                bpoint->at(read++) = val;
-            }
-        }
+        this->frames.assign(bpoint->size(), 0);
+
+        dest = this->frames.data();
     }
 
-    // Determine if we need to close the file (reached end):
+    this->read_samples(dest);
 
-    if (this->total_read >= static_cast<u_int32_t>(this->get_size())) {
+    // Split the channels if necessary:
 
-        // Stop this WaveReader
+    if constexpr (AudioBuffer::layout::planar) {
 
-        this->stop();
+        deinterleave(dest, bpoint->data(), this->get_channels(), this->buffer_size);
     }
 
     // Finally, return buffer pointer:
@@ -434,8 +428,156 @@ BufferPointer WaveReader::get_data() {
     return bpoint;
 }
 
+int WaveReader::get_data(int16_t* dest) {
+
+    MAEC_TRACE_SCOPE("io", "WaveReader::get_data");
+
+    const int read = this->read_samples(dest);
+
+    // Fill the rest with silence:
+
+    std::fill(dest + read, dest + this->buffer_size * this->get_channels(), 0);
+
+    return read;
+}
+
+void WaveReader::seek_frame(int64_t frame) {
+
+    // Find the data chunk if we have not already:
+
+    while (this->data_start == 0 && !this->done()) {
+
+        this->read_chunk_header(this->head);
+
+        if (this->head.chunk_id != "data") {
+
+            this->skip_chunk();
+
+            continue;
+        }
+
+        this->enter_data();
+    }
+
+    // Ensure we can actually seek:
+
+    if (this->data_start == 0 || this->stream->bad()) {
+
+        return;
+    }
+
+    // Determine the byte offset of the frame:
+
+    const int64_t offset = std::clamp<int64_t>(frame, 0, this->get_frames()) * this->get_blockalign();
+
+    // Seek the stream and configure our state:
+
+    this->stream->seek(static_cast<int>(this->data_start + offset));
+
+    this->head.chunk_id = "data";
+    this->head.chunk_size = static_cast<uint32_t>(this->data_size);
+    this->total_read = this->data_start + static_cast<uint32_t>(offset);
+    this->chunk_read = static_cast<int>(offset);
+    this->needs_chunk = offset >= this->data_size;
+}
+
+void WaveReader::skip_chunk() {
+
+    // Determine if we can just seek past this chunk:
+
+    if (this->stream->contiguous() != nullptr) {
+
+        this->stream->seek(static_cast<int>(this->total_read + this->head.chunk_size));
+    }
+
+    else {
+
+        // Create UnknownChunk:
+
+        UnknownChunk chunk(this->head.chunk_size);
+
+        // Read data into an unknown chunk:
+
+        this->stream->read(chunk.data.data(), this->head.chunk_size);
+
+        // Also copy over other pieces of info:
+
+        chunk.chunk_id = head.chunk_id;
+        chunk.chunk_size = head.chunk_size;
+
+        // TODO: Should we save these chunks somewhere?
+    }
+
+    // We are past this weird chunk!
+
+    this->total_read += this->head.chunk_size;
+}
+
+void WaveReader::enter_data() {
+
+    // Record the first data chunk:
+
+    if (this->data_start == 0) {
+
+        this->data_start = this->total_read;
+        this->data_size = this->head.chunk_size;
+    }
+
+    // Set our reading chunk status:
+
+    this->needs_chunk = false;
+
+    // Set the number of bytes read from this chunk:
+
+    this->chunk_read = 0;
+}
+
+int WaveReader::decode(const char* src, int bytes, sample_t* dest) const {
+
+    // Determine the format of the samples:
+
+    const PCMFormat format = pcm_format(this->get_bits_per_sample(), this->get_format() == 3);
+
+    const auto width = static_cast<int>(pcm_width(format));
+
+    if (width == 0) {
+
+        return 0;
+    }
+
+    // Decode the samples:
+
+    const int num = bytes / width;
+
+    pcm_decode(format, src, dest, num);
+
+    return num;
+}
+
+int WaveReader::decode(const char* src, int bytes, int16_t* dest) const {
+
+    const PCMFormat format = pcm_format(this->get_bits_per_sample(), this->get_format() == 3);
+
+    const auto width = static_cast<int>(pcm_width(format));
+
+    if (width == 0) {
+
+        return 0;
+    }
+
+    const int num = bytes / width;
+
+    pcm_decode(format, src, dest, num);
+
+    return num;
+}
+
 void WaveWriter::start() {
 
+    // Reset our size:
+
+    this->set_size(0);
+
     // First, create the wave header:
 
     WavHeader whead;
@@ -448,6 +590,24 @@ void WaveWriter::start() {
 
     this->increment_size(whead.size());
 
+    // Reserve space for a ds64 chunk if necessary:
+
+    if (this->rf64 != never) {
+
+        ChunkHeader junk;
+
+        junk.chunk_id = "JUNK";
+        junk.chunk_size = ds64_size;
+
+        junk.encode(*stream);
+
+        std::array<char, ds64_size> blank = {};
+
+        this->stream->write(blank.data(), blank.size());
+
+        this->increment_size(junk.size() + ds64_size);
+    }
+
     // Next, create format chunk:
 
     WavFormat wformat;
@@ -471,6 +631,8 @@ void WaveWriter::start() {
 
     // Write header for audio data:
 
+    this->data_offset = this->get_size();
+
     ChunkHeader chead;
 
     chead.chunk_id = "data";
@@ -487,38 +649,71 @@ void WaveWriter::start() {
 
 void WaveWriter::stop() {
 
-    std::array<char, 4> sout = {};
+    std::array<char, 8> sout = {};
 
-    // Determine if we need to correct wave header size:
+    // Determine if we have written our headers:
 
-    if (this->get_size() >= 12) {
+    if (this->get_size() < this->data_offset + ChunkHeader::size()) {
 
-        // Set total size of file:
+        this->stream->stop();
 
-        this->stream->seek(4);
+        return;
+    }
+
+    const int64_t riff_size = this->get_size() - 8;
+    const int64_t data_size = this->get_size() - this->data_offset - ChunkHeader::size();
+
+    // Determine if we need to write an RF64 file:
 
-        // Encode the total size:
+    const bool large = riff_size > UINT32_MAX;
 
-        uint32_char(this->get_size() - 8, sout.begin());
+    if (this->rf64 == always || (this->rf64 == reserve && large)) {
 
-        // Write to file:
+        // Convert the header:
 
+        this->stream->seek(0);
+
+        std::copy_n("RF64", 4, sout.begin());
+        uint32_char(UINT32_MAX, sout.begin() + 4);
+
+        this->stream->write(sout.begin(), 8);
+
+        // Convert the reserved chunk into a ds64 chunk:
+
+        std::array<char, ChunkHeader::size() + ds64_size> ds64 = {};
+
+        std::copy_n("ds64", 4, ds64.begin());
+        uint32_char(ds64_size, ds64.begin() + 4);
+        uint64_char(riff_size, ds64.begin() + 8);
+        uint64_char(data_size, ds64.begin() + 16);
+        uint64_char(this->get_blockalign() > 0 ? data_size / this->get_blockalign() : 0, ds64.begin() + 24);
+
+        this->stream->seek(WavHeader::size());
+        this->stream->write(ds64.data(), ds64.size());
+
+        // Mark the data size as being in the ds64 chunk:
+
+        uint32_char(UINT32_MAX, sout.begin());
+
+        this->stream->seek(static_cast<int>(this->data_offset + 4));
         this->stream->write(sout.begin(), 4);
     }
 
-    // Determine if we need to correct data header size:
+    else {
+
+        // Set total size of file:
 
-    if (this->get_size() >= 36) {
+        this->stream->seek(4);
 
-        // Seek to final data chunk:
+        uint32_char(static_cast<uint32_t>(std::min<int64_t>(riff_size, UINT32_MAX)), sout.begin());
 
-        this->stream->seek(40);
+        this->stream->write(sout.begin(), 4);
 
-        // Encode data chunk size:
+        // Set size of data chunk:
 
-        uint32_char(this->get_size() - WavHeader::size() - WavFormat::size() - ChunkHeader::size(), sout.begin());
+        this->stream->seek(static_cast<int>(this->data_offset + 4));
 
-        // Write to file:
+        uint32_char(static_cast<uint32_t>(std::min<int64_t>(data_size, UINT32_MAX)), sout.begin());
 
         this->stream->write(sout.begin(), 4);
     }
@@ -530,45 +725,116 @@ void WaveWriter::stop() {
 
 void WaveWriter::write_data(BufferPointer data) {
 
-    // Create vector of data to write:
+    // Write every frame:
+
+    this->write_frames(*data, static_cast<int>(data->size() / data->channels()));
+}
 
-    std::vector<char> odata(data->size() * this->get_bytes_per_sample());
+void WaveWriter::write_frames(const AudioBuffer& data, int num) {
 
-    // Determine which encoding path to go down:
+    const auto channels = static_cast<int>(data.channels());
+    const auto count = static_cast<std::size_t>(num) * channels;
 
-    if (this->get_bits_per_sample() == 16) {
+    // Make room for the encoded data:
 
-        // We are working with 16bit ints,
-        // Iterate over the number of samples:
+    this->raw.resize(count * this->get_bytes_per_sample());
 
-        for (auto iter = data->ibegin(); iter < data->iend(); ++iter) {
+    // Wave data is interleaved, so join planar channels first:
 
-            int16_char(mf_int16(*iter), odata.begin() + iter.get_index() * this->get_bytes_per_sample());
-        }
+    const sample_t* samples = data.data();
+
+    if constexpr (AudioBuffer::layout::planar) {
+
+        this->frames.resize(static_cast<std::size_t>(channels) * data.channel_capacity());
+
+        interleave(data.data(), this->frames.data(), channels, static_cast<int>(data.channel_capacity()));
+
+        samples = this->frames.data();
     }
 
-    else if (this->get_bits_per_sample() == 8) {
+    // Encode the samples, dithering 16 bit data if requested:
 
-        // We are working with 8bit ints,
-        // Iterate over the number of samples:
+    const PCMFormat format = pcm_format(this->get_bits_per_sample(), this->get_format() == 3);
 
-        for (auto iter = data->ibegin(); iter < data->iend(); ++iter) {
+    if (this->dither && format == PCMFormat::s16) {
 
-            odata[iter.get_index()] = static_cast<char>(mf_uchar(*iter));
-        }
+        this->quantized.resize(count);
+
+        this->ditherer.process(samples, this->quantized.data(), count, channels);
+
+        pcm_encode(format, this->quantized.data(), this->raw.data(), count);
+    }
+
+    else {
+
+        pcm_encode(format, samples, this->raw.data(), count);
     }
 
     // Finally, write audio data to mstream:
 
-    this->stream->write(odata.data(), odata.size());
+    this->stream->write(this->raw.data(), static_cast<int>(this->raw.size()));
 
     // Add to total written:
 
-    this->increment_size(odata.size());
+    this->increment_size(static_cast<int64_t>(this->raw.size()));
+}
+
+void WaveSink::start() {
+
+    SinkModule::start();
+
+    // Configure the wave data from our info:
+
+    this->set_channels(this->get_info()->channels);
+    this->set_samplerate(static_cast<int>(this->get_info()->sample_rate));
+
+    this->written = 0;
+
+    WaveWriter::start();
+}
+
+void WaveSink::stop() {
+
+    WaveWriter::stop();
+
+    SinkModule::stop();
+}
+
+void WaveSink::process() {
+
+    int64_t num = static_cast<int64_t>(this->buff->size() / this->buff->channels());
+
+    // Only write up to our limit:
+
+    if (this->limit >= 0) {
+
+        num = std::min(num, this->limit - this->written);
+    }
+
+    if (num <= 0) {
+
+        return;
+    }
+
+    this->write_frames(*this->buff, static_cast<int>(num));
+
+    this->written += num;
+}
+
+WaveSource::~WaveSource() {
+
+    // Ensure the prefetch thread is not left running:
+
+    if (this->worker.joinable()) {
+
+        this->stop();
+    }
 }
 
 void WaveSource::start() {
 
+    SourceModule::start();
+
     // Start the wave reader:
 
     WaveReader::start();
@@ -584,10 +850,49 @@ void WaveSource::start() {
     // Use buffer size from AUdioInfo:
 
     WaveReader::set_buffer_size(info->out_buffer);
+
+    // Start the prefetch thread if necessary:
+
+    if (this->prefetch <= 0 || this->worker.joinable()) {
+
+        return;
+    }
+
+    this->ahead.reserve(this->prefetch);
+
+    this->taken.store(0, std::memory_order_relaxed);
+    this->underruns.store(0, std::memory_order_relaxed);
+    this->drained.store(false, std::memory_order_relaxed);
+    this->running.store(true, std::memory_order_release);
+
+    this->worker = std::thread(&WaveSource::run, this);
 }
 
 void WaveSource::stop() {
 
+    SourceModule::stop();
+
+    // Stop the prefetch thread before the reader it uses:
+
+    if (this->worker.joinable()) {
+
+        this->running.store(false, std::memory_order_release);
+
+        this->taken.fetch_add(1, std::memory_order_release);
+        this->taken.notify_one();
+
+        this->worker.join();
+
+        // Drop any blocks left in the queue:
+
+        BufferPointer buff;
+
+        while (this->ahead.pop(buff)) {
+
+            buff.reset();
+        }
+    }
+
     // Stop the wave reader:
 
     WaveReader::stop();
@@ -595,11 +900,79 @@ void WaveSource::stop() {
 
 void WaveSource::process() {
 
-    // Ask the WaveReader to generate AudioBuffer:
+    // If we are not prefetching, read directly:
+
+    if (!this->worker.joinable()) {
+
+        this->set_buffer(WaveReader::get_data());
+
+        return;
+    }
+
+    // Take the next block:
+
+    BufferPointer buff;
 
-    auto buff = WaveReader::get_data();
+    if (this->ahead.pop(buff)) {
 
-    // Set our buffer:
+        this->taken.fetch_add(1, std::memory_order_release);
+        this->taken.notify_one();
 
-    this->set_buffer(std::move(buff));
+        this->set_buffer(std::move(buff));
+
+        return;
+    }
+
+    // Nothing ready, determine if this is an underrun:
+
+    if (!this->drained.load(std::memory_order_acquire)) {
+
+        this->underruns.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Output silence rather than waiting:
+
+    this->set_buffer(this->create_buffer(WaveReader::get_channels()));
+}
+
+void WaveSource::prepare() {
+
+    while (this->worker.joinable() && this->ahead.write_available() > 0 && !this->drained.load(std::memory_order_acquire)) {
+
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+}
+
+void WaveSource::run() {
+
+    MAEC_TRACE_THREAD("wave reader");
+
+    while (this->running.load(std::memory_order_acquire)) {
+
+        // Determine if the queue is full:
+
+        const uint64_t seen = this->taken.load(std::memory_order_acquire);
+
+        if (this->ahead.write_available() == 0) {
+
+            this->taken.wait(seen, std::memory_order_acquire);
+
+            continue;
+        }
+
+        // Determine if there is anything left to read:
+
+        if (WaveReader::done()) {
+
+            this->drained.store(true, std::memory_order_release);
+
+            this->taken.wait(seen, std::memory_order_acquire);
+
+            continue;
+        }
+
+        // Decode the next block:
+
+        this->ahead.push(WaveReader::get_data());
+    }
 }
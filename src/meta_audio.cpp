@@ -9,6 +9,7 @@
  * 
  */
 
+#include <algorithm>
 #include <cmath>
 
 #include "meta_audio.hpp"
@@ -21,7 +22,9 @@ void Counter::process() {
 
     // Increment the number of samples encountered:
 
-    this->m_samples += static_cast<int>(this->buff->size()) * this->buff->channels();
+    const AudioBuffer* input = this->input_buffer();
+
+    this->m_samples += static_cast<int>(input->size()) * input->channels();
 }
 
 void LatencyModule::reset() {
@@ -33,6 +36,14 @@ void LatencyModule::reset() {
     this->total_operation_latency = 0;
     this->total_operation_time = 0;
 
+    this->worst_time = 0;
+    this->last_start = 0;
+    this->last_expected = 0;
+    this->operation_jitter = 0;
+    this->worst_jitter = 0;
+    this->total_jitter = 0;
+    this->jitter_num = 0;
+
     // Reset chain timer:
 
     this->timer.reset();
@@ -48,6 +59,21 @@ void LatencyModule::meta_process() {
 
     const int64_t start = get_time();
 
+    // Determine the jitter since the last operation:
+
+    if (this->last_start != 0) {
+
+        const int64_t delta = (start - this->last_start) - this->last_expected;
+
+        this->operation_jitter = delta < 0 ? -delta : delta;
+        this->worst_jitter = std::max(this->worst_jitter, this->operation_jitter);
+        this->total_jitter += this->operation_jitter;
+
+        ++(this->jitter_num);
+    }
+
+    this->last_start = start;
+
     // Call the module behind us:
 
     this->get_backward()->meta_process();
@@ -82,9 +108,13 @@ void LatencyModule::meta_process() {
 
     this->total_operation_time += this->operation_time;
 
+    this->worst_time = std::max(this->worst_time, this->operation_time);
+
     // Determine the latency:
 
-    this->operation_latency = this->operation_time - this->timer.get_time(samples);
+    this->last_expected = this->timer.get_time(samples);
+
+    this->operation_latency = this->operation_time - this->last_expected;
 
     // Add to total latency:
 
@@ -92,7 +122,7 @@ void LatencyModule::meta_process() {
 
     // Call the processing module of our own:
 
-    this->process();
+    this->run_process();
 }
 
 void BufferModule::process() {
@@ -103,7 +133,7 @@ void BufferModule::process() {
 
     // Next, fill it using the contents of our old buffer:
 
-    std::copy(this->gbuff->ibegin(), this->gbuff->iend(), this->buff->ibegin());
+    std::ranges::copy(this->gbuff->span(), this->buff->data());
 
 }
 
@@ -113,7 +143,9 @@ void UniformBuffer::process() {
 
     this->set_buffer(this->create_buffer());
 
-    while (this->index < this->get_info()->out_buffer) {
+    const int size = this->block_size();
+
+    while (this->index < size) {
 
         // Determine if in buffer is out of values:
 
@@ -136,11 +168,11 @@ void UniformBuffer::process() {
 
         // Determine the number of samples yet to fill:
 
-        int remaining = std::min(this->get_info()->out_buffer - this->index, static_cast<int>(this->ibuff->size()) - this->iindex);
+        int remaining = std::min(size - this->index, static_cast<int>(this->ibuff->size()) - this->iindex);
 
         // Fill the current buffer with this value:
 
-        std::copy_n(this->ibuff->ibegin() + this->iindex, remaining, this->buff->ibegin() + this->index);
+        std::ranges::copy(this->ibuff->span().subspan(this->iindex, remaining), this->buff->data() + this->index);
 
         // Update values and move on:
 
@@ -159,7 +191,7 @@ void ConstModule::process() {
 
     this->set_buffer(this->create_buffer());
 
-    // Fill the buffer with the value:
+    // Fill the buffer with the value, marking it as constant:
 
-    std::fill(this->buff->sbegin(), this->buff->send(), this->value);
+    this->buff->fill_constant(this->value);
 }
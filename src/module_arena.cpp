@@ -0,0 +1,105 @@
+/**
+ * @file module_arena.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations of module arenas
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "module_arena.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include "chain_plan.hpp"
+
+namespace {
+
+/// Current module arena of each thread
+thread_local ModuleArena* current_modules = nullptr;
+
+}  // namespace
+
+ModuleArena::Scope::Scope(ModuleArena* arena) : previous(current_modules), previous_buffers(HugePageArena::current()) {
+
+    current_modules = arena;
+
+    HugePageArena::set_current(arena != nullptr ? &(arena->memory) : nullptr);
+}
+
+ModuleArena::Scope::~Scope() {
+
+    current_modules = this->previous;
+
+    HugePageArena::set_current(this->previous_buffers);
+}
+
+void ModuleArena::clear() {
+
+    // Destroy in reverse order, so objects go before anything they were built from:
+
+    for (auto iter = this->owned.rbegin(); iter != this->owned.rend(); ++iter) {
+
+        iter->destroy(iter->ptr);
+    }
+
+    this->owned.clear();
+    this->memory.reset();
+}
+
+bool ModuleArena::in_order(const ChainPlan& plan) const {
+
+    // Find the objects in the arena, which are in order of address:
+
+    std::vector<const Owned*> objects;
+
+    for (const Owned& obj : this->owned) {
+
+        if (obj.arena) {
+
+            objects.push_back(&obj);
+        }
+    }
+
+    // Ensure the object holding each module never moves backwards:
+
+    std::size_t last = 0;
+
+    for (int i = 0; i < plan.size(); ++i) {
+
+        const auto* mod = reinterpret_cast<const unsigned char*>(plan.get_module(i));
+
+        auto iter = std::upper_bound(objects.begin(), objects.end(), mod, [](const unsigned char* addr, const Owned* obj) {
+            return std::less<const void*>()(addr, obj->ptr);
+        });
+
+        if (iter == objects.begin()) {
+
+            continue;
+        }
+
+        const Owned* holder = *(iter - 1);
+
+        if (!std::less<const void*>()(mod, static_cast<const unsigned char*>(holder->ptr) + holder->size)) {
+
+            continue;
+        }
+
+        const auto index = static_cast<std::size_t>(iter - objects.begin());
+
+        if (index < last) {
+
+            return false;
+        }
+
+        last = index;
+    }
+
+    return true;
+}
+
+ModuleArena* ModuleArena::current() { return current_modules; }
@@ -10,29 +10,124 @@
  */
 
 #include <algorithm>
+#include <cstddef>
 #include "module_mixer.hpp"
 
+#include "dsp/alloc.hpp"
+#include "dsp/mix.hpp"
+
+
+void ModuleMixDown::process_input(int index) {
+
+    AudioModule* mod = this->in[index];
+
+    // Process the subtree behind the input:
+
+    mod->meta_process();
+
+    // Store the buffer in its slot:
+
+    this->buffs[index] = mod->get_buffer();
+}
 
 void ModuleMixDown::meta_process() {
 
-    // Iterate over each module in our list:
+    const int num = static_cast<int>(this->in.size());
+
+    // Sub-chains follow our chain for this block:
+
+    const ChainInfo* chain = this->get_chain_info();
+
+    for (auto& sub : this->chains) {
+
+        if (sub == nullptr) {
+
+            continue;
+        }
+
+        sub->frames = this->block_size();
+
+        if (chain != nullptr) {
+
+            sub->sample = chain->sample;
+            sub->warming = chain->warming;
+        }
+    }
+
+    // Determine if we should process concurrently:
+
+    if (this->executor != nullptr && num > 1 && this->serial == 0) {
+
+        const bool met = this->executor->run([this](int index) { this->process_input(index); }, num, this->deadline);
+
+        if (!met) {
+
+            // Missed the deadline, fall back to serial processing:
 
-    for (auto &mod : this->in) {
+            this->serial = this->backoff;
+        }
+    }
+
+    else {
 
-        // Call the processing module of each:
+        if (this->serial > 0) {
 
-        mod->process();
+            --(this->serial);
+        }
 
-        // Add the buffer to our own:
+        // Iterate over each module in our list:
 
-        this->buffs.push_back(std::move(mod->get_buffer()));
+        for (int i = 0; i < num; ++i) {
 
+            this->process_input(i);
+        }
     }
 
     // Finally, call our processing method:
 
-    this->process();
+    this->run_process();
+
+}
+
+void ModuleMixDown::step() {
+
+    const int num = static_cast<int>(this->in.size());
+
+    // Grab the buffer of each input:
+
+    for (int i = 0; i < num; ++i) {
+
+        this->buffs[i] = this->in[i]->get_buffer();
+    }
+
+    this->run_process();
+}
+
+void ModuleMixDown::footprint(MemoryFootprint& usage) const {
+
+    AudioModule::footprint(usage);
+
+    for (const auto& buff : this->buffs) {
+
+        if (buff != nullptr) {
+
+            usage.buffers += buff->bytes();
+        }
+    }
+
+    usage.state += heap_bytes(this->buffs) + heap_bytes(this->gains);
+}
+
+bool ModuleMixDown::plan_inputs(std::vector<AudioModule*>& inputs) {
+
+    if (this->executor != nullptr) {
+
+        return false;
+    }
+
+    inputs.insert(inputs.end(), this->in.begin(), this->in.end());
 
+    return true;
 }
 
 AudioModule* ModuleMixDown::bind(AudioModule* mod) {
@@ -41,25 +136,202 @@ AudioModule* ModuleMixDown::bind(AudioModule* mod) {
 
     this->in.push_back(mod);
 
+    // Create a slot for the input:
+
+    this->buffs.emplace_back();
+    this->gains.push_back(1.0);
+
+    // We are in front of the input, and share our chain with it:
+
+    mod->set_forward(this);
+    mod->set_chain_info(this->get_chain_info());
+
     return mod;
 }
 
+void ModuleMixDown::share_chain(int index, ChainInfo* target) {
+
+    std::vector<AudioModule*> stack = {this->in[index]};
+    std::vector<AudioModule*> inputs;
+
+    while (!stack.empty()) {
+
+        AudioModule* mod = stack.back();
+        stack.pop_back();
+
+        if (mod == nullptr || mod->get_chain_info() == target) {
+
+            continue;
+        }
+
+        mod->set_chain_info(target);
+
+        // Find the modules behind this one:
+
+        inputs.clear();
+        mod->plan_inputs(inputs);
+
+        stack.insert(stack.end(), inputs.begin(), inputs.end());
+    }
+}
+
+void ModuleMixDown::meta_info_sync() {  // NOLINT(misc-no-recursion): No recursion cycles present, valid chains eventually end
+
+    // Sync ourselves:
+
+    this->info_sync();
+
+    ChainInfo* chain = this->get_chain_info();
+
+    const int num = static_cast<int>(this->in.size());
+
+    // Make room for a task for each input, so processing never allocates:
+
+    if (this->executor != nullptr) {
+
+        this->executor->reserve(num);
+    }
+
+    if (this->executor != nullptr && chain != nullptr && static_cast<int>(this->chains.size()) < num) {
+
+        this->chains.resize(num);
+    }
+
+    for (int i = 0; i < num; ++i) {
+
+        ChainInfo* target = chain;
+
+        if (this->executor != nullptr && chain != nullptr) {
+
+            // Concurrent subtrees get a sub-chain of their own, configured from our info:
+
+            if (this->chains[i] == nullptr) {
+
+                this->chains[i] = std::make_unique<ChainInfo>();
+            }
+
+            ChainInfo& sub = *(this->chains[i]);
+            const ModuleInfo* info = this->get_info();
+
+            sub.buffer_size = info->out_buffer;
+            sub.max_buffer = this->max_block_size();
+            sub.channels = info->channels;
+            sub.sample_rate = info->sample_rate;
+            sub.flush_denormals = chain->flush_denormals;
+            sub.pool.set_capacity(this->max_block_size());
+
+            target = &sub;
+        }
+
+        // Point the subtree at its chain, then sync it:
+
+        if (target != nullptr) {
+
+            this->share_chain(i, target);
+        }
+
+        this->in[i]->meta_info_sync();
+    }
+}
+
+void ModuleMixDown::meta_start() {  // NOLINT(misc-no-recursion): No recursion cycles present, valid chains eventually end
+
+    // Start each input:
+
+    for (AudioModule* mod : this->in) {
+
+        mod->meta_start();
+    }
+
+    // Start ourselves:
+
+    BaseModule::start();
+
+    this->start();
+}
+
+void ModuleMixDown::meta_stop() {  // NOLINT(misc-no-recursion): No recursion cycles present, valid chains eventually end
+
+    // Stop each input:
+
+    for (AudioModule* mod : this->in) {
+
+        mod->meta_stop();
+    }
+
+    // Stop ourselves:
+
+    BaseModule::stop();
+
+    this->stop();
+}
+
 void ModuleMixDown::process() {
 
     // Create a new buffer:
 
     std::unique_ptr<AudioBuffer> fbuff = create_buffer();
 
-    // Iterate over each buffer:
+    const int size = static_cast<int>(fbuff->size());
+
+    // Determine if every input is constant, so the mix is too:
+
+    bool constant = true;
+    sample_t value = 0;
+
+    // Iterate over each input slot:
 
-    for (auto &b : this->buffs) {
+    for (std::size_t i = 0; i < this->buffs.size(); ++i) {
 
-        // Iterate over each value in the buffer:
+        BufferPointer& b = this->buffs[i];
 
-        for(auto iter = b->sbegin(); (unsigned int)iter.get_index() < b->size(); ++iter) {
+        if (b == nullptr) {
 
-            *(fbuff->sbegin()+iter) += *iter;
+            continue;
         }
+
+        const int num = std::min(size, static_cast<int>(b->size()));
+        const double gain = this->gains[i];
+
+        // Silent inputs add nothing, so skip them:
+
+        if (b->is_silent()) {
+
+            this->in[i]->reclaim_buffer(std::move(b));
+
+            continue;
+        }
+
+        if (b->is_constant() && num == size) {
+
+            value += b->get_constant() * static_cast<sample_t>(gain);
+        }
+
+        else {
+
+            constant = false;
+        }
+
+        // Accumulate the buffer:
+
+        if (gain == 1.0) {
+
+            mix_add(fbuff->data(), b->data(), num);
+        }
+
+        else {
+
+            mix_add(fbuff->data(), b->data(), num, static_cast<sample_t>(gain));
+        }
+
+        // Hand the input buffer back to the chain of the input, this empties the slot:
+
+        this->in[i]->reclaim_buffer(std::move(b));
+    }
+
+    if (constant) {
+
+        fbuff->set_constant(value);
     }
 
     // Set our buffer to the new buffer:
@@ -75,15 +347,100 @@ void ModuleMixUp::set_forward(AudioModule* mod) {
     this->out.push_back(mod);
 }
 
+void ModuleMixUp::footprint(MemoryFootprint& usage) const {
+
+    AudioModule::footprint(usage);
+
+    for (const auto& slot : this->slots) {
+
+        if (slot != nullptr) {
+
+            usage.buffers += slot->bytes();
+        }
+    }
+}
+
 std::unique_ptr<AudioBuffer> ModuleMixUp::get_buffer() {
 
+    // Determine the buffer to copy:
+
+    const AudioBuffer* source = this->buff != nullptr ? this->buff.get() : (this->current >= 0 ? this->slots[this->current].get() : nullptr);
+
+    if (source == nullptr) {
+
+        return nullptr;
+    }
+
     // Get a buffer to work with:
 
     std::unique_ptr<AudioBuffer> tbuff = this->create_buffer();
 
-    std::copy(this->buff->sbegin(), this->buff->send(), tbuff->sbegin());
+    std::copy_n(source->data(), std::min(source->size(), tbuff->size()), tbuff->data());
+
+    if (source->is_constant() && source->size() == tbuff->size()) {
+
+        tbuff->set_constant(source->get_constant());
+    }
 
     // Finally, return the buffer:
 
     return tbuff;
 }
+
+SharedBuffer ModuleMixUp::share_buffer() {
+
+    // Move a new buffer into a slot:
+
+    if (this->buff != nullptr) {
+
+        // Find a slot no one is holding:
+
+        int free = -1;
+
+        for (int i = 0; i < static_cast<int>(this->slots.size()); ++i) {
+
+            if (this->slots[i].use_count() == 1) {
+
+                free = i;
+
+                break;
+            }
+        }
+
+        if (free < 0) {
+
+            this->slots.push_back(std::make_shared<AudioBuffer>());
+
+            free = static_cast<int>(this->slots.size()) - 1;
+        }
+
+        // Swap the contents, and hand back the old storage:
+
+        std::swap(*(this->slots[free]), *(this->buff));
+
+        this->reclaim_buffer(std::move(this->buff));
+
+        this->current = free;
+    }
+
+    if (this->current < 0) {
+
+        return nullptr;
+    }
+
+    return this->slots[this->current];
+}
+
+void MultiMix::footprint(MemoryFootprint& usage) const {
+
+    ModuleMixDown::footprint(usage);
+    ModuleMixUp::footprint(usage);
+
+    // Both count the buffer we are holding, so take one back:
+
+    MemoryFootprint held;
+
+    AudioModule::footprint(held);
+
+    usage.buffers -= held.buffers;
+}
@@ -11,7 +11,9 @@
 
 #include "module_param.hpp"
 
+#include <algorithm>
 #include <memory>
+#include <utility>
 
 #include "audio_buffer.hpp"
 #include "audio_module.hpp"
@@ -19,16 +21,225 @@
 
 BufferPointer ModuleParam::get() {
 
-    // First, meta process:
+    // If no one shares our module, we can hand over the buffer itself:
 
-    this->meta_process();
+    if (this->leader == nullptr && this->followers == 0) {
 
-    // Next, return buffer:
+        // First, meta process if a compiled chain has not done so:
 
-    return this->get_buffer();
+        if (!this->planned) {
+
+            this->meta_process();
+        }
+
+        // Next, return buffer:
+
+        return this->get_buffer();
+    }
+
+    // Otherwise, copy the shared block:
+
+    const SharedBuffer shared = this->share();
+
+    if (shared == nullptr) {
+
+        return nullptr;
+    }
+
+    const int channels = std::max(static_cast<int>(shared->channels()), 1);
+
+    BufferPointer out = this->get_chain_info()->pool.get(static_cast<int>(shared->size()) / channels, channels, shared->get_samplerate());
+
+    std::copy_n(shared->data(), std::min(shared->size(), out->size()), out->data());
+
+    if (shared->is_constant()) {
+
+        out->set_constant(shared->get_constant());
+    }
+
+    return out;
+}
+
+SharedBuffer ModuleParam::share() {
+
+    // Blocks are keyed on the chain of the module reading us:
+
+    AudioModule* reader = this->get_forward();
+
+    const ChainInfo* chain = reader != nullptr ? reader->get_chain_info() : nullptr;
+
+    if (this->leader != nullptr) {
+
+        return this->leader->share_block(chain);
+    }
+
+    return this->share_block(chain);
+}
+
+SharedBuffer ModuleParam::share_block(const ChainInfo* chain) {
+
+    // Return the current block if it is for this time, and someone else may read it:
+
+    if (chain != nullptr && this->followers > 0 && this->current >= 0 && chain == this->block_chain && chain->sample == this->block_sample) {
+
+        return this->slots[this->current];
+    }
+
+    // Render the block if a compiled chain has not done so:
+
+    if (!this->planned) {
+
+        this->meta_process();
+    }
+
+    BufferPointer data = this->get_buffer();
+
+    if (data != nullptr) {
+
+        // Find a slot no one is holding:
+
+        int free = -1;
+
+        for (int i = 0; i < static_cast<int>(this->slots.size()); ++i) {
+
+            if (this->slots[i].use_count() == 1) {
+
+                free = i;
+
+                break;
+            }
+        }
+
+        if (free < 0) {
+
+            this->slots.push_back(std::make_shared<AudioBuffer>());
+
+            free = static_cast<int>(this->slots.size()) - 1;
+        }
+
+        // Swap the contents, and hand back the old storage:
+
+        std::swap(*(this->slots[free]), *data);
+
+        this->reclaim_buffer(std::move(data));
+
+        this->current = free;
+    }
+
+    this->block_chain = chain;
+    this->block_sample = chain != nullptr ? chain->sample : 0;
+
+    if (this->current < 0) {
+
+        return nullptr;
+    }
+
+    return this->slots[this->current];
+}
+
+AudioModule* ModuleParam::bind(AudioModule* mod) {
+
+    ++(this->version);
+
+    // Stop following our previous leader:
+
+    if (this->leader != nullptr) {
+
+        --(this->leader->followers);
+
+        this->leader = nullptr;
+    }
+
+    // Follow the parameter already reading this module:
+
+    auto* lead = dynamic_cast<ModuleParam*>(mod->get_forward());
+
+    if (lead != nullptr && lead != this) {
+
+        this->leader = lead->leader != nullptr ? lead->leader : lead;
+
+        ++(this->leader->followers);
+
+        // Leave the module pointed at the leader:
+
+        ChainInfo* chain = mod->get_chain_info();
+
+        SinkModule::bind(mod);
+
+        mod->set_forward(lead);
+        mod->set_chain_info(chain);
+
+        return mod;
+    }
+
+    return SinkModule::bind(mod);
+}
+
+void ModuleParam::meta_info_sync() {
+
+    if (this->leader != nullptr) {
+
+        this->info_sync();
+
+        return;
+    }
+
+    SinkModule::meta_info_sync();
+}
+
+void ModuleParam::meta_start() {
+
+    if (this->leader != nullptr) {
+
+        BaseModule::start();
+
+        this->start();
+
+        return;
+    }
+
+    SinkModule::meta_start();
+}
+
+void ModuleParam::meta_stop() {
+
+    if (this->leader != nullptr) {
+
+        BaseModule::stop();
+
+        this->stop();
+
+        return;
+    }
+
+    SinkModule::meta_stop();
+}
+
+void ModuleParam::step() {
+
+    // Our leader takes the buffer of our module:
+
+    if (this->leader != nullptr) {
+
+        return;
+    }
+
+    SinkModule::step();
 }
 
-void ModuleParam::set_constant(long double val) {
+bool ModuleParam::plan_inputs(std::vector<AudioModule*>& inputs) {
+
+    if (this->leader != nullptr) {
+
+        inputs.push_back(this->leader);
+
+        return true;
+    }
+
+    return SinkModule::plan_inputs(inputs);
+}
+
+void ModuleParam::set_constant(sample_t val) {
 
     // Set the underlying value:
 
@@ -36,11 +247,41 @@ void ModuleParam::set_constant(long double val) {
 
     // Set the constant module:
 
-    this->const_mod = std::make_unique<ConstModule>(val);
+    this->const_mod = make_module<ConstModule>(val);
 
     this->bind(this->const_mod.get());
 }
 
+ParamRate ModuleParam::get_rate() const {
+
+    // Determine if we are still using our constant module:
+
+    if (this->const_mod != nullptr && this->get_backward() == this->const_mod.get()) {
+
+        return ParamRate::Constant;
+    }
+
+    return this->rate;
+}
+
+std::pair<sample_t, sample_t> ModuleParam::get_control() {
+
+    // Generate the next value:
+
+    const SharedBuffer data = this->share();
+
+    const sample_t next = data != nullptr && data->size() > 0 ? data->at(0) : this->last_control;
+
+    // Determine the starting value:
+
+    const sample_t start = this->primed ? this->last_control : next;
+
+    this->last_control = next;
+    this->primed = true;
+
+    return {start, next};
+}
+
 void ModuleParam::conf_mod(AudioModule* mod) {
 
     // Set module as forward:
@@ -56,6 +297,14 @@ void ModuleParam::conf_mod(AudioModule* mod) {
     chain_info->channels = conf_info->channels;
     chain_info->sample_rate = conf_info->sample_rate;
 
+    // Control rate chains generate one value per block:
+
+    if (this->get_rate() == ParamRate::Control) {
+
+        chain_info->buffer_size = 1;
+        chain_info->sample_rate = conf_info->sample_rate / std::max(conf_info->in_buffer, 1);
+    }
+
     // Preform chain info sync:
 
     this->meta_info_sync();
@@ -0,0 +1,138 @@
+/**
+ * @file numa.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations for NUMA aware processing
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "numa.hpp"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+NumaTopology NumaTopology::detect() {
+
+    std::vector<std::vector<int>> found;
+
+#ifdef __linux__
+
+    // Read each node until one is missing:
+
+    for (int node = 0;; ++node) {
+
+        std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+
+        if (!file) {
+
+            break;
+        }
+
+        std::string list;
+
+        std::getline(file, list);
+
+        // Nodes with only memory have no CPUs to run on:
+
+        std::vector<int> cpus = parse_cpu_list(list);
+
+        if (!cpus.empty()) {
+
+            found.push_back(std::move(cpus));
+        }
+    }
+
+#endif
+
+    // Fall back to one node with every CPU:
+
+    if (found.empty()) {
+
+        std::vector<int> cpus(std::max(static_cast<int>(std::thread::hardware_concurrency()), 1));
+
+        for (std::size_t i = 0; i < cpus.size(); ++i) {
+
+            cpus[i] = static_cast<int>(i);
+        }
+
+        found.push_back(std::move(cpus));
+    }
+
+    return NumaTopology(std::move(found));
+}
+
+std::vector<int> parse_cpu_list(const std::string& list) {
+
+    std::vector<int> cpus;
+
+    std::stringstream stream(list);
+    std::string range;
+
+    while (std::getline(stream, range, ',')) {
+
+        // Each entry is a single CPU, or a range:
+
+        const std::size_t dash = range.find('-');
+
+        try {
+
+            const int first = std::stoi(range.substr(0, dash));
+            const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+
+            for (int cpu = first; cpu <= last; ++cpu) {
+
+                cpus.push_back(cpu);
+            }
+        }
+
+        catch (const std::exception&) {
+
+            continue;
+        }
+    }
+
+    return cpus;
+}
+
+bool pin_current_thread(const std::vector<int>& cpus) {
+
+#ifdef __linux__
+
+    cpu_set_t set;
+
+    CPU_ZERO(&set);
+
+    bool any = false;
+
+    for (const int cpu : cpus) {
+
+        if (cpu >= 0 && cpu < CPU_SETSIZE) {
+
+            CPU_SET(cpu, &set);
+
+            any = true;
+        }
+    }
+
+    return any && pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+
+#else
+
+    (void)cpus;
+
+    return false;
+
+#endif
+}
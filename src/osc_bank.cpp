@@ -0,0 +1,142 @@
+/**
+ * @file osc_bank.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations of the oscillator bank
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "osc_bank.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "dsp/interleave.hpp"
+#include "dsp/osc.hpp"
+
+void OscillatorBank::process() {
+
+    const double sampler = this->get_info()->sample_rate;
+
+    if (this->dirty || sampler != this->rate) {
+
+        this->update(sampler);
+    }
+
+    const int frames = this->block_size();
+    const int voices = this->get_voices();
+
+    if (this->output == Output::Sum) {
+
+        // Sum every voice into one channel:
+
+        this->set_buffer(this->create_buffer());
+
+        osc_bank_sum(this->phase.data(), this->inc.data(), this->amp.data(), static_cast<int>(this->phase.size()), this->buff->data(), frames);
+
+        return;
+    }
+
+    // Write each voice to its own channel:
+
+    this->set_buffer(this->create_buffer(voices));
+
+    if constexpr (!AudioBuffer::layout::planar) {
+
+        osc_bank_voices(this->phase.data(), this->inc.data(), this->amp.data(), voices, this->buff->data(), frames);
+    }
+
+    else {
+
+        this->scratch.resize(static_cast<std::size_t>(frames) * voices);
+
+        osc_bank_voices(this->phase.data(), this->inc.data(), this->amp.data(), voices, this->scratch.data(), frames);
+
+        deinterleave(this->scratch.data(), this->buff->data(), voices, frames);
+    }
+}
+
+void OscillatorBank::set_voices(int num) {
+
+    num = std::max(num, 0);
+
+    // Pad the kernel arrays to a whole number of lanes:
+
+    const int padded = (num + OSC_BANK_LANES - 1) / OSC_BANK_LANES * OSC_BANK_LANES;
+
+    this->freq.resize(num, 0);
+    this->level.resize(num, 0);
+
+    this->phase.resize(padded, 0);
+    this->inc.resize(padded, 0);
+    this->amp.resize(padded, 0);
+
+    // Voices past the end are silent padding:
+
+    std::fill(this->phase.begin() + num, this->phase.end(), 0.0F);
+
+    this->dirty = true;
+}
+
+void OscillatorBank::set_frequency(int voice, double hertz) {
+
+    this->freq.at(voice) = hertz;
+
+    this->dirty = true;
+}
+
+void OscillatorBank::set_amplitude(int voice, double amp) {
+
+    this->level.at(voice) = amp;
+
+    this->dirty = true;
+}
+
+void OscillatorBank::set_phase(int voice, double turns) {
+
+    this->phase.at(voice) = static_cast<float>(turns - std::floor(turns));
+}
+
+void OscillatorBank::set_harmonics(double fundamental, const std::vector<double>& amps) {
+
+    const int num = static_cast<int>(amps.size());
+
+    this->set_voices(num);
+
+    for (int k = 0; k < num; ++k) {
+
+        this->freq[k] = fundamental * (k + 1);
+        this->level[k] = amps[k];
+    }
+
+    std::fill(this->phase.begin(), this->phase.end(), 0.0F);
+}
+
+void OscillatorBank::update(double sampler) {
+
+    const int voices = this->get_voices();
+
+    for (int v = 0; v < voices; ++v) {
+
+        const double step = this->freq[v] / sampler;
+
+        // Mute voices that would alias:
+
+        const bool audible = std::fabs(step) < 0.5;
+
+        this->inc[v] = audible ? static_cast<float>(step) : 0.0F;
+        this->amp[v] = audible ? static_cast<float>(this->level[v]) : 0.0F;
+    }
+
+    for (std::size_t v = voices; v < this->inc.size(); ++v) {
+
+        this->inc[v] = 0.0F;
+        this->amp[v] = 0.0F;
+    }
+
+    this->rate = sampler;
+    this->dirty = false;
+}
@@ -0,0 +1,355 @@
+/**
+ * @file oversample_module.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations for oversampling modules
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "oversample_module.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "dsp/interleave.hpp"
+
+void OversampleModule::process() {
+
+    auto in = this->get_buffer();
+
+    const int channels = static_cast<int>(in->channels());
+    const int frames = static_cast<int>(in->channel_capacity());
+    const int factor = this->get_factor();
+    const int hframes = frames * factor;
+
+    this->prepare(channels, frames);
+
+    // Split the channels if necessary:
+
+    const sample_t* src = in->data();
+
+    if constexpr (!AudioBuffer::layout::planar) {
+
+        deinterleave(in->data(), this->low.data(), channels, frames);
+
+        src = this->low.data();
+    }
+
+    // Upsample each channel into a buffer from the sub-chain pool:
+
+    BufferPointer hbuff = this->inner_chain.pool.get(hframes, channels, this->inner_chain.sample_rate);
+
+    sample_t* hdest = AudioBuffer::layout::planar ? hbuff->data() : this->high.data();
+
+    for (int c = 0; c < channels; ++c) {
+
+        this->upsample(c, src + static_cast<std::ptrdiff_t>(c) * frames, frames, hdest + static_cast<std::ptrdiff_t>(c) * hframes);
+    }
+
+    if constexpr (!AudioBuffer::layout::planar) {
+
+        interleave(this->high.data(), hbuff->data(), channels, hframes);
+    }
+
+    this->reclaim_buffer(std::move(in));
+
+    // Process the sub-chain with as many frames as we were given:
+
+    BufferPointer hout = std::move(hbuff);
+
+    if (this->front != nullptr) {
+
+        this->inner_chain.frames = hframes;
+
+        this->port.set_buffer(std::move(hout));
+
+        this->front->meta_process();
+
+        hout = this->front->get_buffer();
+    }
+
+    this->inner_chain.sample += hframes;
+
+    // Split the channels of the result if necessary:
+
+    const sample_t* hsrc = hout->data();
+
+    if constexpr (!AudioBuffer::layout::planar) {
+
+        deinterleave(hout->data(), this->high.data(), channels, hframes);
+
+        hsrc = this->high.data();
+    }
+
+    // Decimate each channel back to our rate:
+
+    BufferPointer out = this->create_buffer(channels);
+
+    sample_t* dest = AudioBuffer::layout::planar ? out->data() : this->low.data();
+
+    for (int c = 0; c < channels; ++c) {
+
+        this->downsample(c, hsrc + static_cast<std::ptrdiff_t>(c) * hframes, frames, dest + static_cast<std::ptrdiff_t>(c) * frames);
+    }
+
+    if constexpr (!AudioBuffer::layout::planar) {
+
+        interleave(this->low.data(), out->data(), channels, frames);
+    }
+
+    this->inner_chain.pool.reclaim(std::move(hout));
+
+    this->set_buffer(std::move(out));
+}
+
+void OversampleModule::info_sync() {
+
+    AudioModule::info_sync();
+
+    this->get_info()->latency = this->latency();
+}
+
+void OversampleModule::meta_info_sync() {  // NOLINT(misc-no-recursion): No recursion cycles present, valid chains eventually end
+
+    // Sync ourselves:
+
+    this->info_sync();
+
+    if (this->front != nullptr) {
+
+        const int factor = this->get_factor();
+
+        // Configure the sub-chain from our info:
+
+        const ModuleInfo* info = this->get_info();
+
+        this->inner_chain.buffer_size = info->out_buffer * factor;
+        this->inner_chain.max_buffer = this->max_block_size() * factor;
+        this->inner_chain.channels = info->channels;
+        this->inner_chain.sample_rate = info->sample_rate * factor;
+        this->inner_chain.pool.set_capacity(this->inner_chain.max_block_size());
+
+        if (this->get_chain_info() != nullptr) {
+
+            this->inner_chain.flush_denormals = this->get_chain_info()->flush_denormals;
+        }
+
+        // The port describes the higher rate to the sub-chain:
+
+        ModuleInfo pinfo(this->inner_chain);
+
+        this->port.set_info(pinfo);
+
+        // Point everything in the sub-chain at the inner chain:
+
+        std::vector<AudioModule*> stack = {this->front};
+        std::vector<AudioModule*> inputs;
+
+        while (!stack.empty()) {
+
+            AudioModule* mod = stack.back();
+            stack.pop_back();
+
+            if (mod->get_chain_info() == &(this->inner_chain)) {
+
+                continue;
+            }
+
+            mod->set_chain_info(&(this->inner_chain));
+
+            inputs.clear();
+            mod->plan_inputs(inputs);
+
+            stack.insert(stack.end(), inputs.begin(), inputs.end());
+        }
+
+        // Sync the sub-chain:
+
+        this->front->meta_info_sync();
+
+        // Prepare for the channels we expect:
+
+        this->prepared = 0;
+        this->prepare(info->channels, this->max_block_size());
+    }
+
+    // Sync the modules behind us:
+
+    this->get_backward()->meta_info_sync();
+}
+
+void OversampleModule::meta_start() {  // NOLINT(misc-no-recursion): No recursion cycles present, valid chains eventually end
+
+    if (this->front != nullptr) {
+
+        this->front->meta_start();
+    }
+
+    AudioModule::meta_start();
+}
+
+void OversampleModule::meta_stop() {  // NOLINT(misc-no-recursion): No recursion cycles present, valid chains eventually end
+
+    if (this->front != nullptr) {
+
+        this->front->meta_stop();
+    }
+
+    AudioModule::meta_stop();
+}
+
+void OversampleModule::footprint(MemoryFootprint& usage) const {
+
+    AudioModule::footprint(usage);
+
+    for (const auto& filter : this->filters) {
+
+        usage.kernels += filter.bytes();
+    }
+
+    usage.state += heap_bytes(this->low) + heap_bytes(this->high) + heap_bytes(this->ping) + heap_bytes(this->pong);
+}
+
+void OversampleModule::start() {
+
+    // Design the filters and clear their history:
+
+    this->prepared = 0;
+
+    this->prepare(this->get_info()->channels, this->max_block_size());
+}
+
+void OversampleModule::set_chain(AudioModule* mfront, AudioModule* mback) {
+
+    this->front = mfront;
+    this->back = mback;
+
+    // Attach the sub-chain to the port on both ends:
+
+    this->back->bind(&(this->port));
+    this->front->set_forward(&(this->port));
+}
+
+void OversampleModule::set_factor(int factor) {
+
+    // Round down to a power of 2:
+
+    const auto clamped = static_cast<unsigned int>(std::clamp(factor, 1, MAX_FACTOR));
+
+    this->stages = std::bit_width(clamped) - 1;
+}
+
+int OversampleModule::get_taps(int stage) const {
+
+    const int num = std::max(this->taps >> stage, MIN_TAPS);
+
+    return num + (num % 2);
+}
+
+int OversampleModule::latency() const {
+
+    // Each stage delays by taps - 1 samples at its rate, once on the way up and once on the way down:
+
+    double delay = 0;
+
+    for (int s = 0; s < this->stages; ++s) {
+
+        delay += 2.0 * (this->get_taps(s) - 1) / (2 << s);
+    }
+
+    return static_cast<int>(std::lround(delay));
+}
+
+void OversampleModule::upsample(int channel, const sample_t* input, int frames, sample_t* output) {
+
+    if (this->stages == 0) {
+
+        std::copy_n(input, frames, output);
+
+        return;
+    }
+
+    const sample_t* src = input;
+    int num = frames;
+
+    for (int s = 0; s < this->stages; ++s) {
+
+        // Last stage writes straight to the output:
+
+        sample_t* dest = s == this->stages - 1 ? output : (s % 2 == 0 ? this->ping.data() : this->pong.data());
+
+        this->filters[static_cast<std::size_t>(s) * this->prepared + channel].interpolate(src, num, dest);
+
+        src = dest;
+        num *= 2;
+    }
+}
+
+void OversampleModule::downsample(int channel, const sample_t* input, int frames, sample_t* output) {
+
+    if (this->stages == 0) {
+
+        std::copy_n(input, frames, output);
+
+        return;
+    }
+
+    const sample_t* src = input;
+    int num = frames << this->stages;
+
+    for (int s = this->stages - 1; s >= 0; --s) {
+
+        // Last stage writes straight to the output:
+
+        sample_t* dest = s == 0 ? output : (s % 2 == 0 ? this->ping.data() : this->pong.data());
+
+        num /= 2;
+
+        this->filters[static_cast<std::size_t>(s) * this->prepared + channel].decimate(src, num, dest);
+
+        src = dest;
+    }
+}
+
+void OversampleModule::prepare(int channels, int frames) {
+
+    const int factor = this->get_factor();
+    const int block = std::max(frames, 1);
+
+    // Design the filters if the channels changed:
+
+    if (this->prepared != channels) {
+
+        this->filters.clear();
+
+        for (int s = 0; s < this->stages; ++s) {
+
+            for (int c = 0; c < channels; ++c) {
+
+                this->filters.emplace_back(this->get_taps(s));
+                this->filters.back().reserve(block << s);
+            }
+        }
+
+        this->prepared = channels;
+    }
+
+    // Ensure the scratch space is large enough:
+
+    const auto low_size = static_cast<std::size_t>(block) * channels;
+    const auto high_size = low_size * factor;
+
+    if (this->low.size() < low_size) {
+
+        this->low.resize(low_size);
+        this->high.resize(high_size);
+        this->ping.resize(high_size / channels);
+        this->pong.resize(high_size / channels);
+    }
+}
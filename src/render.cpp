@@ -0,0 +1,113 @@
+/**
+ * @file render.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations for offline rendering components
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "render.hpp"
+
+#include <functional>
+
+#include "chrono.hpp"
+
+double RenderReport::duration() const {
+
+    double total = 0;
+
+    for (const auto& job : this->jobs) {
+
+        total += job.duration;
+    }
+
+    return total;
+}
+
+int OfflineRenderer::add_job(const RenderJob& job) {
+
+    this->jobs.push_back(job);
+
+    return static_cast<int>(this->jobs.size()) - 1;
+}
+
+RenderReport OfflineRenderer::run() {
+
+    RenderReport report;
+
+    report.jobs.resize(this->jobs.size());
+
+    // Render each job, storing the results by index:
+
+    const std::function<void(int)> task = [this, &report](int index) { report.jobs[index] = this->render(this->jobs[index]); };
+
+    const int64_t start = get_time();
+
+    if (this->pool != nullptr) {
+
+        this->pool->run(task, this->num_jobs());
+    }
+
+    else {
+
+        for (int i = 0; i < this->num_jobs(); ++i) {
+
+            task(i);
+        }
+    }
+
+    report.time = get_time() - start;
+
+    return report;
+}
+
+RenderResult OfflineRenderer::render(const RenderJob& job) const {
+
+    RenderResult result;
+
+    // Create the sink for this job:
+
+    WaveSink sink(job.stream);
+
+    sink.set_bits_per_sample(this->floats ? 32 : this->bits);
+    sink.set_format(this->floats ? 3 : 1);
+    sink.set_limit(job.frames);
+
+    auto* chain = sink.get_chain_info();
+
+    chain->buffer_size = this->block;
+    chain->channels = job.channels;
+    chain->sample_rate = job.sample_rate;
+
+    sink.bind(job.mod);
+
+    // Sync and start the chain:
+
+    const int64_t start = get_time();
+
+    sink.meta_info_sync();
+    sink.meta_start();
+
+    // Render until we are full, or the chain is done:
+
+    while (!sink.full()) {
+
+        sink.meta_process();
+
+        if (chain->module_finish >= chain->module_num) {
+
+            break;
+        }
+    }
+
+    sink.meta_stop();
+
+    result.time = get_time() - start;
+    result.frames = sink.get_written();
+    result.duration = static_cast<double>(result.frames) / job.sample_rate;
+
+    return result;
+}
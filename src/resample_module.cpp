@@ -0,0 +1,211 @@
+/**
+ * @file resample_module.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations for resample modules
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "resample_module.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "dsp/interleave.hpp"
+#include "dsp/resample.hpp"
+
+void ResampleModule::meta_process() {
+
+    // Ensure we know the input format:
+
+    if (this->history.empty()) {
+
+        this->pull();
+    }
+
+    const int frames = this->block_size();
+    const auto channels = static_cast<int>(this->history.size());
+    const double step = 1.0 / this->ratio;
+
+    // Pull until we have the samples needed for the last output:
+
+    const auto needed = static_cast<std::size_t>(std::floor(this->position + (frames - 1) * step)) + this->taps / 2 + 1;
+
+    while (this->history.front().size() < needed) {
+
+        this->pull();
+    }
+
+    // Resample each channel:
+
+    BufferPointer out = this->create_buffer(channels);
+
+    out->set_samplerate(this->output_rate);
+
+    this->scratch.resize(static_cast<std::size_t>(frames) * channels);
+
+    for (int c = 0; c < channels; ++c) {
+
+        sample_t* dest = AudioBuffer::layout::planar ?
+            out->data() + AudioBuffer::layout::offset(c, 0, channels, out->channel_capacity()) :
+            this->scratch.data() + static_cast<std::ptrdiff_t>(c) * frames;
+
+        resample(this->history[c].data(), dest, frames, this->position, step, this->table.data(), this->taps, this->phases);
+    }
+
+    if constexpr (!AudioBuffer::layout::planar) {
+
+        interleave(this->scratch.data(), out->data(), channels, frames);
+    }
+
+    // Discard the samples we no longer need:
+
+    this->position += frames * step;
+
+    const auto drop = static_cast<std::ptrdiff_t>(std::floor(this->position)) - (this->taps / 2 - 1);
+
+    if (drop > 0) {
+
+        for (auto& hist : this->history) {
+
+            hist.erase(hist.begin(), hist.begin() + drop);
+        }
+
+        this->position -= static_cast<double>(drop);
+    }
+
+    this->set_buffer(std::move(out));
+
+    this->run_process();
+}
+
+void ResampleModule::meta_info_sync() {
+
+    // Sync ourselves:
+
+    this->info_sync();
+
+    this->output_rate = this->get_info()->sample_rate;
+
+    // Modules behind us work at the input rate:
+
+    if (this->input_rate > 0) {
+
+        this->get_info()->sample_rate = this->input_rate;
+    }
+
+    this->get_backward()->meta_info_sync();
+}
+
+void ResampleModule::footprint(MemoryFootprint& usage) const {
+
+    AudioModule::footprint(usage);
+
+    usage.kernels += heap_bytes(this->table);
+
+    for (const auto& hist : this->history) {
+
+        usage.state += heap_bytes(hist);
+    }
+
+    usage.state += heap_bytes(this->scratch);
+}
+
+void ResampleModule::start() {
+
+    AudioModule::start();
+
+    // Discard any old samples:
+
+    this->history.clear();
+    this->current_rate = 0;
+}
+
+bool ResampleModule::plan_inputs([[maybe_unused]] std::vector<AudioModule*>& inputs) {
+
+    // We process the modules behind us:
+
+    return false;
+}
+
+void ResampleModule::pull() {
+
+    // Grab a block:
+
+    this->get_backward()->meta_process();
+
+    BufferPointer in = this->get_backward()->get_buffer();
+
+    const auto channels = static_cast<int>(in->channels());
+    const auto frames = static_cast<int>(in->channel_capacity());
+
+    // Determine the rate of the block:
+
+    double rate = this->input_rate > 0 ? this->input_rate : in->get_samplerate();
+
+    if (rate <= 0) {
+
+        rate = this->output_rate;
+    }
+
+    // Rebuild the table if the rate has changed:
+
+    if (rate != this->current_rate) {
+
+        this->current_rate = rate;
+        this->ratio = this->output_rate / rate;
+
+        this->table.resize(static_cast<std::size_t>(this->phases + 1) * this->taps);
+
+        polyphase_table(resample_cutoff(this->ratio, this->taps), this->taps, this->phases, this->table.begin());
+    }
+
+    // Configure the history if this is the first block:
+
+    if (this->history.size() != static_cast<std::size_t>(channels)) {
+
+        // Leading zeros place the first output on the first input sample:
+
+        const int lead = this->taps / 2 - 1;
+
+        this->history.assign(channels, std::vector<sample_t>(lead, 0));
+        this->position = lead;
+
+        // Reserve room so appending does not allocate:
+
+        const auto room = static_cast<std::size_t>(this->taps + (this->max_block_size() / this->ratio) + 2 * this->max_block_size() + 2);
+
+        for (auto& hist : this->history) {
+
+            hist.reserve(room);
+        }
+    }
+
+    // Split channels if necessary:
+
+    const sample_t* src = in->data();
+
+    if constexpr (!AudioBuffer::layout::planar) {
+
+        this->scratch.resize(static_cast<std::size_t>(frames) * channels);
+
+        deinterleave(in->data(), this->scratch.data(), channels, frames);
+
+        src = this->scratch.data();
+    }
+
+    // Add each channel to the history:
+
+    for (int c = 0; c < channels; ++c) {
+
+        const sample_t* chan = src + static_cast<std::ptrdiff_t>(c) * frames;
+
+        this->history[c].insert(this->history[c].end(), chan, chan + frames);
+    }
+
+    this->reclaim_buffer(std::move(in));
+}
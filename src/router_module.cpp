@@ -0,0 +1,145 @@
+/**
+ * @file router_module.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations for the channel router
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "router_module.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "dsp/mix.hpp"
+
+void ChannelRouter::process() {
+
+    const int channels = this->buff->channels();
+    const int frames = static_cast<int>(this->buff->size()) / channels;
+    const int used = std::min(channels, this->inputs());
+
+    // Create the output buffer, pulling from the chain pool if we can:
+
+    auto obuff = this->get_chain_info() != nullptr ? this->get_chain_info()->pool.get(frames, this->outputs(), this->buff->get_samplerate())
+                                                   : std::make_unique<AudioBuffer>(frames, this->outputs(), this->buff->get_samplerate());
+
+    const auto oview = matrix_view(*obuff);
+
+    MatrixView<const sample_t> iview = matrix_view(*this->buff);
+
+    iview.rows = used;
+
+    if (this->buff->is_silent()) {
+
+        // Silence routes to silence:
+
+        std::fill(obuff->data(), obuff->data() + obuff->size(), sample_t(0));
+
+        obuff->set_constant(0);
+    }
+
+    else if (this->is_sparse()) {
+
+        // Only visit the non-zero gains:
+
+        std::fill(obuff->data(), obuff->data() + obuff->size(), sample_t(0));
+
+        for (const Route& route : this->routes) {
+
+            if (route.input >= used) {
+
+                continue;
+            }
+
+            sample_t* out = &oview.at(route.output, 0);
+            const sample_t* in = &iview.at(route.input, 0);
+
+            if constexpr (AudioBuffer::layout::planar) {
+
+                mix_add(out, in, frames, route.gain);
+            }
+
+            else {
+
+                for (int i = 0; i < frames; ++i) {
+
+                    out[i * oview.cstride] += route.gain * in[i * iview.cstride];
+                }
+            }
+        }
+    }
+
+    else {
+
+        // Apply the whole matrix:
+
+        MatrixView<const sample_t> gview = matrix_view(this->gains);
+
+        gview.cols = used;
+
+        gemm(oview, gview, iview);
+    }
+
+    this->set_buffer(std::move(obuff));
+}
+
+void ChannelRouter::info_sync() {
+
+    AudioModule::info_sync();
+
+    // Ask for one channel per input:
+
+    this->get_info()->channels = this->inputs();
+}
+
+void ChannelRouter::set_size(int inputs, int outputs) {
+
+    this->gains = Buffer<sample_t>(std::max(inputs, 0), std::max(outputs, 1));
+
+    std::fill(this->gains.data(), this->gains.data() + this->gains.size(), sample_t(0));
+
+    this->routes.clear();
+    this->routes.reserve(this->gains.size());
+}
+
+void ChannelRouter::set_gain(int output, int input, sample_t gain) {
+
+    this->gains.at(output, input) = gain;
+
+    this->update_routes();
+}
+
+void ChannelRouter::set_identity() {
+
+    std::fill(this->gains.data(), this->gains.data() + this->gains.size(), sample_t(0));
+
+    for (int i = 0; i < std::min(this->inputs(), this->outputs()); ++i) {
+
+        this->gains.at(i, i) = 1;
+    }
+
+    this->update_routes();
+}
+
+void ChannelRouter::update_routes() {
+
+    // Capacity was reserved when sized, so this never allocates:
+
+    this->routes.clear();
+
+    for (int o = 0; o < this->outputs(); ++o) {
+
+        for (int i = 0; i < this->inputs(); ++i) {
+
+            if (this->gains.at(o, i) != 0) {
+
+                this->routes.push_back({o, i, this->gains.at(o, i)});
+            }
+        }
+    }
+}
@@ -11,29 +11,157 @@
 
 #include "sink_module.hpp"
 
+#include <algorithm>
+#include <typeinfo>
+
+#include "dsp/denormal.hpp"
+#include "instrument.hpp"
+#include "trace.hpp"
+
 void SinkModule::info_sync() {
 
     // Configure the AudioInfo:
 
     this->get_info()->from_chain(this->chain_instance);
+
+    // Make room for the largest block:
+
+    this->chain_instance.pool.set_capacity(this->chain_instance.max_block_size());
+}
+
+void SinkModule::meta_start() {
+
+    // Flush denormals on this thread if necessary:
+
+    const ChainInfo* chain = this->get_chain_info();
+
+    this->flushed = flush_to_zero();
+
+    if (chain != nullptr && chain->flush_denormals) {
+
+        set_flush_to_zero(true);
+    }
+
+    // Start the chain:
+
+    AudioModule::meta_start();
+
+    // Enforce the memory budget, if there is one:
+
+    ChainInfo* info = this->get_chain_info();
+
+    if (info == nullptr) {
+
+        return;
+    }
+
+    info->over_budget = false;
+
+    if (info->memory_budget == 0) {
+
+        return;
+    }
+
+    info->memory_used = chain_footprint(this).total();
+    info->over_budget = info->memory_used > info->memory_budget;
+
+    if (info->over_budget) {
+
+        this->meta_stop();
+    }
+}
+
+void SinkModule::meta_stop() {
+
+    // Stop the chain:
+
+    AudioModule::meta_stop();
+
+    // Restore the denormal mode:
+
+    set_flush_to_zero(this->flushed);
 }
 
+void SinkModule::step() {
+
+    // Process the incoming buffer:
+
+    AudioModule::step();
+
+    // Advance the chain time:
+
+    this->chain_instance.sample += this->block_size();
+}
+
+void SinkModule::set_frames(int num) { this->chain_instance.frames = std::clamp(num, 0, this->chain_instance.max_block_size()); }
+
 void PeriodSink::meta_process() {
 
+    MAEC_TRACE_SCOPE("meta_process", typeid(*this).name());
+
+    int64_t render = 0;
+
     // Iterate a number of times based upon our period
 
     for (int i = 0; i < this->periods; ++i) {
 
         // Call the module behind us:
 
+        const int64_t start = get_time();
+
         this->get_backward()->meta_process();
 
-        // Claim it's buffer
+        render += get_time() - start;
+
+        // Claim it's buffer and process:
+
+        this->step();
+    }
+
+    this->record_render(render, this->block_size() * this->periods);
+}
+
+void PeriodSink::record_render(int64_t time, int frames) {
 
-        buff = this->get_backward()->get_buffer();
+    // Determine the duration of the audio we rendered:
 
-        // Process ? :
+    this->timer.set_samplerate(std::max(static_cast<int>(this->get_info()->sample_rate), 1));
 
-        this->process();
+    const int64_t budget = this->timer.get_npf() * frames;
+
+    if (budget <= 0) {
+
+        return;
+    }
+
+    const double current = static_cast<double>(time) / static_cast<double>(budget);
+
+    // Update the statistics:
+
+    const uint64_t count = this->blocks.fetch_add(1, std::memory_order_relaxed);
+
+    this->load.store(current, std::memory_order_relaxed);
+    this->average.store(count == 0 ? current : this->average.load(std::memory_order_relaxed) * 0.9 + current * 0.1, std::memory_order_relaxed);
+    this->peak.store(std::max(this->peak.load(std::memory_order_relaxed), current), std::memory_order_relaxed);
+
+    if (current > 1) {
+
+        this->misses.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Let someone know if we are overloaded:
+
+    if (this->overload && current >= this->threshold) {
+
+        this->overload(*this, current);
     }
 }
+
+void PeriodSink::reset_load() {
+
+    this->load.store(0, std::memory_order_relaxed);
+    this->average.store(0, std::memory_order_relaxed);
+    this->peak.store(0, std::memory_order_relaxed);
+    this->blocks.store(0, std::memory_order_relaxed);
+    this->misses.store(0, std::memory_order_relaxed);
+}
@@ -11,9 +11,25 @@
 
 #include "source_module.hpp"
 
+#include <algorithm>
+
 void SourceModule::meta_process() {
 
+    // Output zeros while warming up, leaving our state alone.
+    // The block is not marked as silent, so the modules after us still do their work:
+
+    if (this->get_chain_info() != nullptr && this->get_chain_info()->warming) {
+
+        this->set_buffer(this->create_buffer(this->get_info()->channels));
+
+        std::fill_n(this->buff->data(), this->buff->size(), 0);
+
+        this->buff->clear_constant();
+
+        return;
+    }
+
     // Call the processing module of our own:
 
-    this->process();
+    this->run_process();
 }
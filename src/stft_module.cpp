@@ -0,0 +1,126 @@
+/**
+ * @file stft_module.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations for STFT modules
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "stft_module.hpp"
+
+#include <algorithm>
+
+#include "dsp/interleave.hpp"
+
+void STFTModule::process() {
+
+    const int channels = this->buff->channels();
+    const auto frames = static_cast<int>(this->buff->size()) / channels;
+
+    // Ensure we have an STFT for each channel:
+
+    if (static_cast<int>(this->engines.size()) != channels) {
+
+        this->prepare(channels);
+    }
+
+    // Spectral processing may produce anything from silence:
+
+    this->buff->clear_constant();
+
+    // Split the channels if necessary:
+
+    if constexpr (!AudioBuffer::layout::planar) {
+
+        this->scratch.resize(this->buff->size());
+
+        deinterleave(this->buff->data(), this->scratch.data(), channels, frames);
+    }
+
+    // Stream each channel:
+
+    for (int c = 0; c < channels; ++c) {
+
+        sample_t* data = AudioBuffer::layout::planar ?
+            this->buff->data() + AudioBuffer::layout::offset(c, 0, channels, this->buff->channel_capacity()) :
+            this->scratch.data() + static_cast<std::ptrdiff_t>(c) * frames;
+
+        this->engines[c].process(data, frames, data, [this, c](std::span<std::complex<sample_t>> spectrum) { this->process_spectrum(spectrum, c); });
+    }
+
+    // Join the channels if necessary:
+
+    if constexpr (!AudioBuffer::layout::planar) {
+
+        interleave(this->scratch.data(), this->buff->data(), channels, frames);
+    }
+}
+
+void STFTModule::footprint(MemoryFootprint& usage) const {
+
+    AudioModule::footprint(usage);
+
+    for (const auto& engine : this->engines) {
+
+        usage.plans += engine.plan_bytes();
+        usage.state += engine.bytes();
+    }
+
+    usage.state += heap_bytes(this->scratch);
+}
+
+void STFTModule::start() {
+
+    AudioModule::start();
+
+    // Prepare for the channels we expect:
+
+    this->prepare(this->get_info()->channels);
+
+    this->get_info()->latency = this->latency();
+}
+
+void STFTModule::info_sync() {
+
+    AudioModule::info_sync();
+
+    this->get_info()->latency = this->latency();
+}
+
+void STFTModule::process_spectrum(std::span<std::complex<sample_t>> spectrum, int channel) {
+
+    if (this->callback) {
+
+        this->callback(spectrum, channel);
+    }
+}
+
+void STFTModule::set_size(int num) {
+
+    this->size = std::max(2, num + (num % 2));
+    this->hop = std::min(this->hop, this->size);
+
+    this->get_info()->latency = this->latency();
+}
+
+void STFTModule::set_hop(int num) {
+
+    this->hop = std::clamp(num, 1, this->size);
+
+    this->get_info()->latency = this->latency();
+}
+
+void STFTModule::prepare(int channels) {
+
+    this->engines.resize(channels);
+
+    for (auto& engine : this->engines) {
+
+        engine.prepare(this->size, this->hop, this->window);
+    }
+
+    this->scratch.reserve(static_cast<std::size_t>(this->max_block_size()) * channels);
+}
@@ -0,0 +1,241 @@
+/**
+ * @file thread_bridge.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations for thread bridges
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "thread_bridge.hpp"
+
+#include <utility>
+
+ThreadBridge::~ThreadBridge() {
+
+    // Ensure the worker is not left running:
+
+    this->stop();
+}
+
+void ThreadBridge::meta_process() {
+
+    // If we are not threaded, process directly:
+
+    if (!this->threaded()) {
+
+        this->bridge_chain.frames = this->block_size();
+
+        this->get_backward()->meta_process();
+
+        this->set_buffer(this->get_backward()->get_buffer());
+
+        this->run_process();
+
+        return;
+    }
+
+    BufferPointer out = nullptr;
+
+    // Collect the block requested last time:
+
+    if (this->received < this->requested.load(std::memory_order_relaxed)) {
+
+        const uint64_t target = this->received + 1;
+
+        uint64_t have = this->completed.load(std::memory_order_acquire);
+
+        while (have < target) {
+
+            this->completed.wait(have, std::memory_order_acquire);
+
+            have = this->completed.load(std::memory_order_acquire);
+        }
+
+        this->ready.pop(out);
+
+        ++(this->received);
+
+        // Trade a buffer back to the worker pool:
+
+        BufferPointer spare = this->create_buffer();
+
+        if (!this->spent.push(std::move(spare))) {
+
+            this->reclaim_buffer(std::move(spare));
+        }
+    }
+
+    // First block is silence:
+
+    if (out == nullptr) {
+
+        out = this->create_buffer();
+    }
+
+    // Request the next block:
+
+    this->requested.fetch_add(1, std::memory_order_release);
+    this->requested.notify_one();
+
+    this->set_buffer(std::move(out));
+
+    this->run_process();
+}
+
+void ThreadBridge::meta_info_sync() {
+
+    // Sync ourselves:
+
+    this->info_sync();
+
+    // Configure the bridge chain from our info:
+
+    const ModuleInfo* info = this->get_info();
+
+    this->bridge_chain.buffer_size = info->out_buffer;
+    this->bridge_chain.channels = info->channels;
+    this->bridge_chain.sample_rate = info->sample_rate;
+
+    // Point everything behind us at the bridge chain:
+
+    std::vector<AudioModule*> stack = {this->get_backward()};
+    std::vector<AudioModule*> inputs;
+
+    while (!stack.empty()) {
+
+        AudioModule* mod = stack.back();
+        stack.pop_back();
+
+        if (mod->get_chain_info() == &(this->bridge_chain)) {
+
+            continue;
+        }
+
+        mod->set_chain_info(&(this->bridge_chain));
+
+        inputs.clear();
+        mod->plan_inputs(inputs);
+
+        stack.insert(stack.end(), inputs.begin(), inputs.end());
+    }
+
+    // Sync the sub-chain:
+
+    this->get_backward()->meta_info_sync();
+}
+
+void ThreadBridge::meta_stop() {
+
+    // Stop the worker before the modules it processes:
+
+    this->stop();
+
+    AudioModule::meta_stop();
+}
+
+void ThreadBridge::start() {
+
+    BaseModule::start();
+
+    if (this->threaded()) {
+
+        return;
+    }
+
+    // The worker always renders full blocks:
+
+    this->bridge_chain.frames = 0;
+
+    // Reset the block counts:
+
+    this->requested.store(0, std::memory_order_relaxed);
+    this->completed.store(0, std::memory_order_relaxed);
+    this->received = 0;
+
+    // Start the worker:
+
+    this->running.store(true, std::memory_order_release);
+
+    this->worker = std::thread(&ThreadBridge::run, this);
+}
+
+void ThreadBridge::stop() {
+
+    BaseModule::stop();
+
+    if (!this->worker.joinable()) {
+
+        return;
+    }
+
+    // Wake the worker up and wait for it to leave:
+
+    this->running.store(false, std::memory_order_release);
+
+    this->requested.fetch_add(1, std::memory_order_release);
+    this->requested.notify_one();
+
+    this->worker.join();
+
+    // Drop anything still in flight:
+
+    BufferPointer buff;
+
+    while (this->ready.pop(buff) || this->spent.pop(buff)) {
+
+        buff.reset();
+    }
+}
+
+bool ThreadBridge::plan_inputs([[maybe_unused]] std::vector<AudioModule*>& inputs) {
+
+    // The worker processes the modules behind us:
+
+    return false;
+}
+
+void ThreadBridge::run() {
+
+    uint64_t done = 0;
+
+    while (true) {
+
+        // Wait for a block to be requested:
+
+        this->requested.wait(done, std::memory_order_acquire);
+
+        if (!this->running.load(std::memory_order_acquire)) {
+
+            return;
+        }
+
+        // Take back any buffers we were given:
+
+        BufferPointer spare;
+
+        while (this->spent.pop(spare)) {
+
+            this->bridge_chain.pool.reclaim(std::move(spare));
+        }
+
+        // Render the block:
+
+        this->get_backward()->meta_process();
+
+        BufferPointer out = this->get_backward()->get_buffer();
+
+        this->bridge_chain.sample += this->bridge_chain.buffer_size;
+
+        this->ready.push(std::move(out));
+
+        // Report that we are done:
+
+        ++done;
+
+        this->completed.store(done, std::memory_order_release);
+        this->completed.notify_one();
+    }
+}
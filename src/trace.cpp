@@ -0,0 +1,397 @@
+/**
+ * @file trace.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations for tracing components
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "trace.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <utility>
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+#include "chrono.hpp"
+
+namespace {
+
+/**
+ * @brief Every ring that has been created
+ *
+ */
+struct TraceRegistry {
+
+    /// Guards everything here
+    std::mutex lock;
+
+    /// Rings of every thread that has recorded
+    std::vector<std::shared_ptr<TraceRing>> rings;
+
+    /// Capacity of new rings
+    std::size_t capacity = 1U << 14U;
+
+    /// Set if events are recorded
+    std::atomic<bool> enabled{true};
+};
+
+TraceRegistry& registry() {
+
+    static TraceRegistry reg;
+
+    return reg;
+}
+
+/**
+ * @brief Gets a readable version of a name
+ *
+ * Type names from typeid() are demangled,
+ * anything else is returned as is.
+ *
+ * @param name Name to read
+ * @return std::string Readable name
+ */
+std::string readable(const char* name) {
+
+    if (name == nullptr) {
+
+        return "";
+    }
+
+#if defined(__GNUG__)
+
+    // Only class names are mangled, which start with a length or a nested name:
+
+    if ((name[0] >= '0' && name[0] <= '9') || name[0] == 'N') {
+
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+
+        if (status == 0 && demangled != nullptr) {
+
+            std::string out(demangled);
+
+            std::free(demangled);  // NOLINT(cppcoreguidelines-no-malloc): Demangled names are allocated with malloc
+
+            return out;
+        }
+    }
+
+#endif
+
+    return name;
+}
+
+/**
+ * @brief Writes a JSON string
+ *
+ * @param out Stream to write to
+ * @param str String to write
+ */
+void write_string(std::ostream& out, const std::string& str) {
+
+    out << '"';
+
+    for (const char chr : str) {
+
+        if (chr == '"' || chr == '\\') {
+
+            out << '\\' << chr;
+        }
+
+        else if (static_cast<unsigned char>(chr) < 0x20) {
+
+            out << ' ';
+        }
+
+        else {
+
+            out << chr;
+        }
+    }
+
+    out << '"';
+}
+
+/**
+ * @brief Drops events that can't be paired
+ *
+ * Ends whose begin was overwritten, and begins that have not ended yet, are removed.
+ *
+ * @param events Events of a single thread, oldest first
+ */
+void balance(std::vector<TraceEvent>& events) {
+
+    std::vector<bool> keep(events.size(), true);
+    std::vector<std::size_t> open;
+
+    for (std::size_t i = 0; i < events.size(); ++i) {
+
+        if (events[i].phase == TraceEvent::Phase::Begin) {
+
+            open.push_back(i);
+        }
+
+        else if (open.empty()) {
+
+            keep[i] = false;
+        }
+
+        else {
+
+            open.pop_back();
+        }
+    }
+
+    for (const std::size_t i : open) {
+
+        keep[i] = false;
+    }
+
+    std::size_t next = 0;
+
+    for (std::size_t i = 0; i < events.size(); ++i) {
+
+        if (keep[i]) {
+
+            events[next++] = events[i];
+        }
+    }
+
+    events.resize(next);
+}
+
+}  // namespace
+
+TraceRing::TraceRing(std::size_t capacity, int tid) : slots(std::bit_ceil(std::max<std::size_t>(capacity, 2))), tid(tid) {
+
+    this->mask = this->slots.size() - 1;
+}
+
+std::vector<TraceEvent> TraceRing::snapshot() const {
+
+    const uint64_t cap = this->slots.size();
+    const uint64_t end = this->head.load(std::memory_order_acquire);
+    const uint64_t first = std::max(this->start.load(std::memory_order_acquire), end > cap ? end - cap : 0);
+
+    std::vector<TraceEvent> events;
+
+    events.reserve(end - first);
+
+    for (uint64_t i = first; i < end; ++i) {
+
+        const Slot& slot = this->slots[i & this->mask];
+
+        events.push_back({slot.name.load(std::memory_order_relaxed),
+                          slot.category.load(std::memory_order_relaxed),
+                          slot.time.load(std::memory_order_relaxed),
+                          slot.phase.load(std::memory_order_relaxed)});
+    }
+
+    // Drop anything the writer may have overwritten while we copied,
+    // including the slot it may be writing now:
+
+    const uint64_t after = this->head.load(std::memory_order_acquire);
+    const uint64_t valid = after + 1 > cap ? after + 1 - cap : 0;
+
+    if (valid > first) {
+
+        events.erase(events.begin(), events.begin() + static_cast<std::ptrdiff_t>(std::min(valid - first, end - first)));
+    }
+
+    return events;
+}
+
+std::size_t TraceRing::size() const {
+
+    const uint64_t end = this->head.load(std::memory_order_acquire);
+    const uint64_t cap = this->slots.size();
+
+    return end - std::max(this->start.load(std::memory_order_acquire), end > cap ? end - cap : 0);
+}
+
+void TraceRing::set_name(std::string name) {
+
+    const std::lock_guard<std::mutex> guard(registry().lock);
+
+    this->thread_name = std::move(name);
+}
+
+std::string TraceRing::get_name() const {
+
+    const std::lock_guard<std::mutex> guard(registry().lock);
+
+    return this->thread_name;
+}
+
+TraceRing& thread_trace_ring() {
+
+    thread_local TraceRing* ring = nullptr;
+
+    if (ring == nullptr) {
+
+        TraceRegistry& reg = registry();
+
+        const std::lock_guard<std::mutex> guard(reg.lock);
+
+        reg.rings.push_back(std::make_shared<TraceRing>(reg.capacity, static_cast<int>(reg.rings.size()) + 1));
+
+        ring = reg.rings.back().get();
+    }
+
+    return *ring;
+}
+
+void set_trace_capacity(std::size_t capacity) {
+
+    const std::lock_guard<std::mutex> guard(registry().lock);
+
+    registry().capacity = capacity;
+}
+
+void set_tracing(bool enable) { registry().enabled.store(enable, std::memory_order_relaxed); }
+
+bool tracing() { return registry().enabled.load(std::memory_order_relaxed); }
+
+void clear_trace() {
+
+    TraceRegistry& reg = registry();
+
+    const std::lock_guard<std::mutex> guard(reg.lock);
+
+    for (const auto& ring : reg.rings) {
+
+        ring->clear();
+    }
+}
+
+void write_chrome_trace(std::ostream& out) {
+
+    TraceRegistry& reg = registry();
+
+    // Take a snapshot of every ring:
+
+    std::vector<std::shared_ptr<TraceRing>> rings;
+
+    {
+        const std::lock_guard<std::mutex> guard(reg.lock);
+
+        rings = reg.rings;
+    }
+
+    std::vector<std::vector<TraceEvent>> events;
+
+    int64_t origin = std::numeric_limits<int64_t>::max();
+
+    for (const auto& ring : rings) {
+
+        events.push_back(ring->snapshot());
+
+        balance(events.back());
+
+        if (!events.back().empty()) {
+
+            origin = std::min(origin, events.back().front().time);
+        }
+    }
+
+    // Write the events:
+
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+    bool first = true;
+
+    const auto separate = [&]() {
+
+        if (!first) {
+
+            out << ',';
+        }
+
+        first = false;
+    };
+
+    for (std::size_t i = 0; i < rings.size(); ++i) {
+
+        const int tid = rings[i]->get_tid();
+        const std::string thread = rings[i]->get_name();
+
+        if (!thread.empty()) {
+
+            separate();
+
+            out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid << ",\"args\":{\"name\":";
+
+            write_string(out, thread);
+
+            out << "}}";
+        }
+
+        for (const TraceEvent& event : events[i]) {
+
+            const int64_t time = event.time - origin;
+
+            separate();
+
+            out << "{\"name\":";
+
+            write_string(out, readable(event.name));
+
+            out << ",\"cat\":";
+
+            write_string(out, event.category != nullptr ? event.category : "");
+
+            out << ",\"ph\":\"" << (event.phase == TraceEvent::Phase::Begin ? 'B' : 'E') << "\"";
+
+            // Chrome traces are in microseconds:
+
+            const int64_t frac = time % 1000;
+
+            out << ",\"ts\":" << time / 1000 << '.' << (frac < 100 ? "0" : "") << (frac < 10 ? "0" : "") << frac;
+
+            out << ",\"pid\":1,\"tid\":" << tid << '}';
+        }
+    }
+
+    out << "]}";
+}
+
+std::string chrome_trace() {
+
+    std::ostringstream out;
+
+    write_chrome_trace(out);
+
+    return out.str();
+}
+
+TraceScope::TraceScope(const char* category, const char* name) : name(name), category(category) {
+
+    if (!tracing()) {
+
+        return;
+    }
+
+    this->ring = &thread_trace_ring();
+
+    this->ring->push(name, category, get_time(), TraceEvent::Phase::Begin);
+}
+
+TraceScope::~TraceScope() {
+
+    if (this->ring != nullptr) {
+
+        this->ring->push(this->name, this->category, get_time(), TraceEvent::Phase::End);
+    }
+}
@@ -0,0 +1,378 @@
+/**
+ * @file voice.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Implementations for polyphonic voices
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "voice.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace {
+
+/**
+ * @brief Determines if a voice envelope has finished
+ *
+ * @param voice Voice to check
+ * @return true If the voice is finished
+ * @return false If the voice is still playing
+ */
+bool voice_finished(const Voice& voice) {
+
+    const auto state = voice.envelope->get_state();
+
+    return state == BaseModule::State::Finished || state == BaseModule::State::Stopped;
+}
+
+}  // namespace
+
+int VoiceManager::add_voice(AudioModule* output, BaseModule* envelope) {
+
+    Voice voice;
+
+    voice.output = output;
+    voice.envelope = envelope != nullptr ? envelope : output;
+
+    this->voices.push_back(voice);
+
+    return static_cast<int>(this->voices.size()) - 1;
+}
+
+int VoiceManager::active_voices() const {
+
+    return static_cast<int>(std::count_if(this->voices.begin(), this->voices.end(), [](const Voice& voice) { return voice.active; }));
+}
+
+Voice* VoiceManager::pick_voice() {
+
+    if (this->voices.empty()) {
+
+        return nullptr;
+    }
+
+    // Use a voice that is not playing if we can:
+
+    if (this->limit == 0 || this->active_voices() < this->limit) {
+
+        for (auto& voice : this->voices) {
+
+            if (!voice.active) {
+
+                return &voice;
+            }
+        }
+    }
+
+    // With a limit, only steal from the voices that are playing:
+
+    if (this->limit > 0) {
+
+        Voice* victim = this->pick_victim();
+
+        if (victim != nullptr) {
+
+            ++(this->stolen);
+
+            return victim;
+        }
+    }
+
+    // Otherwise, steal a voice:
+
+    ++(this->stolen);
+
+    if (this->steal == StealMode::Quietest) {
+
+        return &*std::min_element(this->voices.begin(), this->voices.end(), [](const Voice& first, const Voice& second) {
+            return first.level < second.level || (first.level == second.level && first.age < second.age);
+        });
+    }
+
+    return &*std::min_element(this->voices.begin(), this->voices.end(), [](const Voice& first, const Voice& second) { return first.age < second.age; });
+}
+
+Voice* VoiceManager::pick_victim() {
+
+    Voice* victim = nullptr;
+
+    for (auto& voice : this->voices) {
+
+        if (!voice.active) {
+
+            continue;
+        }
+
+        if (victim == nullptr) {
+
+            victim = &voice;
+
+            continue;
+        }
+
+        // Released voices go first:
+
+        if (voice.held != victim->held) {
+
+            if (!voice.held) {
+
+                victim = &voice;
+            }
+
+            continue;
+        }
+
+        // Otherwise use the steal mode:
+
+        const bool better = this->steal == StealMode::Quietest ?
+            voice.level < victim->level || (voice.level == victim->level && voice.age < victim->age) :
+            voice.age < victim->age;
+
+        if (better) {
+
+            victim = &voice;
+        }
+    }
+
+    return victim;
+}
+
+int VoiceManager::shed_voices(int num) {
+
+    int shed = 0;
+
+    for (; shed < num; ++shed) {
+
+        Voice* voice = this->pick_victim();
+
+        if (voice == nullptr) {
+
+            break;
+        }
+
+        // Stop the voice:
+
+        voice->active = false;
+        voice->held = false;
+        voice->level = 0;
+
+        voice->output->meta_stop();
+
+        ++(this->stolen);
+    }
+
+    return shed;
+}
+
+Voice* VoiceManager::note_on(int note, double velocity) {
+
+    Voice* voice = this->pick_voice();
+
+    if (voice == nullptr) {
+
+        return nullptr;
+    }
+
+    // Configure the voice:
+
+    voice->note = note;
+    voice->age = ++(this->triggered);
+    voice->level = 0;
+    voice->held = true;
+    voice->active = true;
+
+    if (this->trigger) {
+
+        this->trigger(*voice, note, velocity);
+    }
+
+    // Start the voice chain:
+
+    voice->output->meta_start();
+
+    return voice;
+}
+
+void VoiceManager::note_off(int note) {
+
+    for (auto& voice : this->voices) {
+
+        if (!voice.held || voice.note != note) {
+
+            continue;
+        }
+
+        voice.held = false;
+
+        // Release the voice:
+
+        if (this->release) {
+
+            this->release(voice);
+        }
+
+        else {
+
+            voice.envelope->finish();
+        }
+    }
+}
+
+void VoiceManager::process() {
+
+    // Voices render as many frames as we do, and warm up with us:
+
+    this->voice_chain.frames = this->block_size();
+
+    if (this->get_chain_info() != nullptr) {
+
+        this->voice_chain.warming = this->get_chain_info()->warming;
+    }
+
+    // Create a buffer to mix into:
+
+    this->set_buffer(this->create_buffer());
+
+    const int size = static_cast<int>(this->buff->size());
+    sample_t* out = this->buff->data();
+
+    for (auto& voice : this->voices) {
+
+        if (!voice.active) {
+
+            continue;
+        }
+
+        // Skip voices that have finished:
+
+        if (voice_finished(voice)) {
+
+            voice.active = false;
+            voice.level = 0;
+
+            continue;
+        }
+
+        // Process the voice:
+
+        voice.output->meta_process();
+
+        auto vbuff = voice.output->get_buffer();
+
+        // Silent voices add nothing:
+
+        if (vbuff->is_silent()) {
+
+            voice.level = 0;
+
+            voice.output->reclaim_buffer(std::move(vbuff));
+
+            if (voice_finished(voice)) {
+
+                voice.active = false;
+            }
+
+            continue;
+        }
+
+        const sample_t* data = vbuff->data();
+        const int num = std::min(size, static_cast<int>(vbuff->size()));
+
+        // Sum the voice, and determine its level:
+
+        sample_t peak = 0;
+
+        for (int i = 0; i < num; ++i) {
+
+            out[i] += data[i];
+            peak = std::max(peak, static_cast<sample_t>(std::fabs(data[i])));
+        }
+
+        voice.level = peak;
+
+        voice.output->reclaim_buffer(std::move(vbuff));
+
+        // Determine if the voice finished during this block:
+
+        if (voice_finished(voice)) {
+
+            voice.active = false;
+        }
+    }
+}
+
+void VoiceManager::share_chain(Voice& voice) {
+
+    std::vector<AudioModule*> stack = {voice.output};
+    std::vector<AudioModule*> inputs;
+
+    while (!stack.empty()) {
+
+        AudioModule* mod = stack.back();
+        stack.pop_back();
+
+        if (mod->get_chain_info() == nullptr) {
+
+            mod->set_chain_info(&(this->voice_chain));
+        }
+
+        // Find the modules behind this one:
+
+        inputs.clear();
+        mod->plan_inputs(inputs);
+
+        stack.insert(stack.end(), inputs.begin(), inputs.end());
+    }
+}
+
+void VoiceManager::meta_info_sync() {
+
+    // Sync ourselves:
+
+    this->info_sync();
+
+    // Configure the voice chain info from our info:
+
+    const ModuleInfo* info = this->get_info();
+
+    this->voice_chain.buffer_size = info->out_buffer;
+    this->voice_chain.channels = info->channels;
+    this->voice_chain.sample_rate = info->sample_rate;
+    this->voice_chain.max_buffer = this->max_block_size();
+    this->voice_chain.pool.set_capacity(this->max_block_size());
+
+    // Sync each voice chain:
+
+    for (auto& voice : this->voices) {
+
+        this->share_chain(voice);
+
+        voice.output->set_forward(this);
+        voice.output->meta_info_sync();
+    }
+}
+
+void VoiceManager::meta_stop() {
+
+    // Stop any voices that are playing:
+
+    for (auto& voice : this->voices) {
+
+        if (voice.active) {
+
+            voice.output->meta_stop();
+
+            voice.active = false;
+        }
+    }
+
+    // Stop ourselves:
+
+    SourceModule::meta_stop();
+}
@@ -84,6 +84,34 @@ TEST_CASE("AmplitudeScale Test", "[amp]") {
             REQUIRE_THAT(*iter, Catch::Matchers::WithinAbs(0.5, 0.0001));
         }
     }
+
+    SECTION("Fold", "Ensures constant buffers are folded into a new constant") {
+
+        ConstModule osc(0.5);
+
+        amp.set_value(3);
+        amp.bind(&osc);
+
+        amp.meta_process();
+
+        auto buff = amp.get_buffer();
+
+        REQUIRE(buff->is_constant());
+        REQUIRE_THAT(buff->get_constant(), Catch::Matchers::WithinAbs(1.5, 0.0001));
+
+        for (auto val : *buff) {
+
+            REQUIRE_THAT(val, Catch::Matchers::WithinAbs(1.5, 0.0001));
+        }
+
+        // Scaled silence is still silence:
+
+        osc.set_value(0);
+
+        amp.meta_process();
+
+        REQUIRE(amp.get_buffer()->is_silent());
+    }
 }
 
 TEST_CASE("AmplitudeAdd Test", "[amp]") {
@@ -119,4 +147,24 @@ TEST_CASE("AmplitudeAdd Test", "[amp]") {
             REQUIRE_THAT(*iter, Catch::Matchers::WithinAbs(1.5, 0.0001));
         }
     }
+
+    SECTION("Fold", "Ensures constant buffers are folded into a new constant") {
+
+        ConstModule osc(0);
+
+        amp.bind(&osc);
+
+        amp.meta_process();
+
+        auto buff = amp.get_buffer();
+
+        REQUIRE(buff->is_constant());
+        REQUIRE(!buff->is_silent());
+        REQUIRE_THAT(buff->get_constant(), Catch::Matchers::WithinAbs(0.5, 0.0001));
+
+        for (auto val : *buff) {
+
+            REQUIRE_THAT(val, Catch::Matchers::WithinAbs(0.5, 0.0001));
+        }
+    }
 }
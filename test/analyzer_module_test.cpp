@@ -0,0 +1,200 @@
+/**
+ * @file analyzer_module_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for analyzer modules
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "analyzer_module.hpp"
+#include "dsp/denormal.hpp"
+#include "fund_oscillator.hpp"
+#include "sink_module.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+TEST_CASE("SpectrumAnalyzer Test", "[analyzer]") {
+
+    // Started sinks flush denormals, restore the mode of this thread once we are done:
+
+    const FlushToZeroScope ftz(flush_to_zero());
+
+    // Place the sine in the center of a bin:
+
+    const double freq = 44100.0 * 32 / 1024;
+
+    SineOscillator osc(freq);
+    SpectrumAnalyzer analyzer(1024, 256);
+    PeriodSink sink;
+
+    analyzer.bind(&osc);
+    sink.bind(&analyzer);
+
+    sink.meta_info_sync();
+
+    SECTION("Config", "Ensures the analyzer is configured correctly") {
+
+        REQUIRE(analyzer.get_size() == 1024);
+        REQUIRE(analyzer.get_hop() == 256);
+        REQUIRE(analyzer.bins() == 513);
+        REQUIRE(analyzer.in_place());
+
+        analyzer.set_size(127);
+
+        REQUIRE(analyzer.get_size() == 128);
+        REQUIRE(analyzer.get_hop() == 128);
+    }
+
+    SECTION("Measure", "Ensures spectra and levels are measured") {
+
+        sink.meta_start();
+
+        // Reference output, to ensure we pass audio along untouched:
+
+        SineOscillator ref(freq);
+        PeriodSink rsink;
+
+        rsink.bind(&ref);
+        rsink.meta_info_sync();
+        rsink.meta_start();
+
+        // Nothing is published until the first frame is full:
+
+        sink.meta_process();
+        rsink.meta_process();
+
+        REQUIRE(!analyzer.poll());
+
+        for (int i = 0; i < 10; ++i) {
+
+            sink.meta_process();
+            rsink.meta_process();
+
+            REQUIRE(std::ranges::equal(sink.get_buffer()->span(), rsink.get_buffer()->span()));
+        }
+
+        REQUIRE(analyzer.poll());
+        REQUIRE(!analyzer.poll());
+
+        const auto& snap = analyzer.snapshot();
+
+        REQUIRE(snap.channels == 1);
+        REQUIRE(snap.bins == 513);
+        REQUIRE(snap.sequence == 8);
+        REQUIRE(snap.sample == 11 * 440);
+
+        auto mag = snap.channel(0);
+
+        REQUIRE(std::ranges::max_element(mag) - mag.begin() == 32);
+        REQUIRE_THAT(mag[32], Catch::Matchers::WithinAbs(1, 1e-3));
+        REQUIRE(mag[100] < 1e-4);
+
+        REQUIRE_THAT(snap.peak.at(0), Catch::Matchers::WithinAbs(1, 1e-2));
+        REQUIRE_THAT(snap.rms.at(0), Catch::Matchers::WithinAbs(std::sqrt(0.5), 1e-2));
+    }
+
+    SECTION("Threaded", "Ensures a reader can poll while audio is processed") {
+
+        sink.meta_start();
+
+        std::atomic<bool> running = true;
+        uint64_t last = 0;
+        bool consistent = true;
+        int seen = 0;
+
+        std::thread reader([&]() {
+
+            while (running.load()) {
+
+                if (analyzer.poll()) {
+
+                    const auto& snap = analyzer.snapshot();
+
+                    consistent = consistent && (seen == 0 || snap.sequence > last) && snap.magnitude.size() == 513;
+
+                    last = snap.sequence;
+                    ++seen;
+                }
+            }
+        });
+
+        for (int i = 0; i < 2000; ++i) {
+
+            sink.meta_process();
+        }
+
+        running = false;
+
+        reader.join();
+
+        REQUIRE(consistent);
+        REQUIRE(seen > 0);
+    }
+}
+
+TEST_CASE("ToneDetector Test", "[analyzer]") {
+
+    // Started sinks flush denormals, restore the mode of this thread once we are done:
+
+    const FlushToZeroScope ftz(flush_to_zero());
+
+    SineOscillator osc(1000);
+    ToneDetector detector({500, 1000, 2000}, 2205);
+    PeriodSink sink;
+
+    detector.bind(&osc);
+    sink.bind(&detector);
+
+    sink.meta_info_sync();
+
+    SECTION("Config", "Ensures the detector is configured correctly") {
+
+        REQUIRE(detector.get_window() == 2205);
+        REQUIRE(detector.get_frequencies().size() == 3);
+        REQUIRE(detector.in_place());
+
+        detector.set_window(0);
+
+        REQUIRE(detector.get_window() == 1);
+    }
+
+    SECTION("Measure", "Ensures only the present tone is detected") {
+
+        sink.meta_start();
+
+        // Nothing is published until the first window is full:
+
+        sink.meta_process();
+
+        REQUIRE(!detector.poll());
+
+        for (int i = 0; i < 5; ++i) {
+
+            sink.meta_process();
+        }
+
+        REQUIRE(detector.poll());
+
+        const auto& snap = detector.snapshot();
+
+        REQUIRE(snap.channels == 1);
+        REQUIRE(snap.bins == 3);
+        REQUIRE(snap.sequence == 0);
+        REQUIRE(snap.frequencies.at(1) == 1000);
+
+        auto mag = snap.channel(0);
+
+        REQUIRE_THAT(mag[1], Catch::Matchers::WithinAbs(1, 1e-2));
+        REQUIRE(mag[0] < 1e-2);
+        REQUIRE(mag[2] < 1e-2);
+    }
+}
@@ -50,11 +50,11 @@ TEST_CASE("Conversion", "[byte]") {
 
     // Values to test:
 
-    long double const min = -1.;
-    long double const hmin = -0.5;
-    long double const zero = 0;
-    long double const hmax = 0.5;
-    long double const max = 1.;
+    sample_t const min = -1.;
+    sample_t const hmin = -0.5;
+    sample_t const zero = 0;
+    sample_t const hmax = 0.5;
+    sample_t const max = 1.;
 
     SECTION("Converts", "Conversion functions from mf to others") {
 
@@ -139,8 +139,8 @@ TEST_CASE("Squishers", "[buff][byte]") {
 
     // Define some buffers:
 
-    std::array<long double, 9> idata = {1, 4, 7, 2, 5, 8, 3, 6, 9};
-    std::array<long double, 9> sidata = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    std::array<sample_t, 9> idata = {1, 4, 7, 2, 5, 8, 3, 6, 9};
+    std::array<sample_t, 9> sidata = {1, 2, 3, 4, 5, 6, 7, 8, 9};
 
     // Copy to AudioBuffer:
 
@@ -150,7 +150,7 @@ TEST_CASE("Squishers", "[buff][byte]") {
 
     // Define output buffer:
 
-    std::array<long double, 9> odata = {};
+    std::array<sample_t, 9> odata = {};
 
     SECTION("Inter", "Ensures interleaved squishers work correctly") {
 
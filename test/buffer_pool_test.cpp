@@ -0,0 +1,121 @@
+/**
+ * @file buffer_pool_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for buffer pools
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "buffer_pool.hpp"
+#include "dsp/denormal.hpp"
+#include "fund_oscillator.hpp"
+#include "sink_module.hpp"
+
+TEST_CASE("BufferPool Test", "[pool]") {
+
+    // Started sinks flush denormals, restore the mode of this thread once we are done:
+
+    const FlushToZeroScope ftz(flush_to_zero());
+
+    BufferPool pool;
+
+    SECTION("Get", "Ensures we can get buffers of the correct size") {
+
+        auto buff = pool.get(10, 2, 123);
+
+        REQUIRE(buff->size() == 20);
+        REQUIRE(buff->channels() == 2);
+        REQUIRE(buff->get_samplerate() == 123);
+        REQUIRE(pool.allocations() == 1);
+    }
+
+    SECTION("Reclaim", "Ensures reclaimed buffers are reused and zeroed") {
+
+        auto buff = pool.get(10, 1, 44100);
+
+        // Dirty the buffer:
+
+        std::fill(buff->ibegin(), buff->iend(), 5);
+
+        auto* addr = buff.get();
+
+        pool.reclaim(std::move(buff));
+
+        REQUIRE(pool.available() == 1);
+
+        // Get a buffer with a different shape:
+
+        auto nbuff = pool.get(5, 2, 48000);
+
+        REQUIRE(nbuff.get() == addr);
+        REQUIRE(nbuff->size() == 10);
+        REQUIRE(nbuff->channels() == 2);
+        REQUIRE(nbuff->get_samplerate() == 48000);
+        REQUIRE(pool.allocations() == 1);
+        REQUIRE(pool.available() == 0);
+
+        for (auto val : *nbuff) {
+
+            REQUIRE(val == 0);
+        }
+    }
+
+    SECTION("Max", "Ensures the pool does not grow past the max") {
+
+        pool.set_max(2);
+
+        pool.reserve(5, 10, 1);
+
+        REQUIRE(pool.available() == 2);
+
+        pool.reclaim(pool.get(10, 1, 44100));
+        pool.reclaim(std::make_unique<AudioBuffer>(10, 1));
+
+        REQUIRE(pool.available() == 2);
+
+        pool.set_max(1);
+
+        REQUIRE(pool.available() == 1);
+
+        pool.clear();
+
+        REQUIRE(pool.available() == 0);
+    }
+
+    SECTION("Chain", "Ensures a steady state chain does no allocations") {
+
+        SineOscillator osc;
+        PeriodSink sink;
+
+        sink.bind(&osc);
+
+        sink.meta_info_sync();
+        sink.meta_start();
+
+        // Process a few times to warm the pool up:
+
+        sink.meta_process();
+        sink.meta_process();
+
+        auto* cpool = &(sink.get_chain_info()->pool);
+
+        const int allocs = cpool->allocations();
+
+        // Process many more times:
+
+        for (int i = 0; i < 100; ++i) {
+
+            sink.meta_process();
+        }
+
+        REQUIRE(cpool->allocations() == allocs);
+    }
+}
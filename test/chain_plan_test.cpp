@@ -0,0 +1,258 @@
+/**
+ * @file chain_plan_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for compiled execution plans
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+#include "amp_module.hpp"
+#include "chain_plan.hpp"
+#include "dsp/denormal.hpp"
+#include "fund_oscillator.hpp"
+#include "meta_audio.hpp"
+#include "module_mixer.hpp"
+#include "sink_module.hpp"
+
+namespace {
+
+/**
+ * @brief A modulated chain used for comparing results
+ */
+struct ModChain {
+
+    SineOscillator lfo;
+    ModSineOscillator osc;
+    AmplitudeScale amp{0.5};
+    PeriodSink sink;
+
+    ModChain() {
+
+        sink.bind(&amp);
+        amp.bind(&osc);
+
+        osc.get_frequency()->bind(&lfo);
+
+        sink.set_period(2);
+
+        sink.meta_info_sync();
+        sink.meta_start();
+    }
+};
+
+}  // namespace
+
+TEST_CASE("ChainPlan Test", "[plan]") {
+
+    // Started sinks flush denormals, restore the mode of this thread once we are done:
+
+    const FlushToZeroScope ftz(flush_to_zero());
+
+    SECTION("Schedule", "Ensures modules are scheduled after their inputs") {
+
+        ModChain chain;
+
+        ChainPlan plan(&chain.sink);
+
+        // lfo, param, osc, amp, sink:
+
+        REQUIRE(plan.size() == 5);
+        REQUIRE(plan.get_module(0) == &chain.lfo);
+        REQUIRE(plan.get_module(1) == chain.osc.get_frequency());
+        REQUIRE(plan.get_module(2) == &chain.osc);
+        REQUIRE(plan.get_module(3) == &chain.amp);
+        REQUIRE(plan.get_module(4) == &chain.sink);
+        REQUIRE(plan.get_front() == &chain.sink);
+        REQUIRE(chain.osc.get_frequency()->is_planned());
+    }
+
+    SECTION("Release", "Ensures parameters process themselves once the plan is gone") {
+
+        ModChain chain;
+
+        {
+            ChainPlan plan(&chain.sink);
+        }
+
+        REQUIRE(!chain.osc.get_frequency()->is_planned());
+    }
+
+    SECTION("Process", "Ensures compiled results match recursive results") {
+
+        ModChain rec;
+        ModChain comp;
+
+        ChainPlan plan(&comp.sink);
+
+        for (int i = 0; i < 5; ++i) {
+
+            rec.sink.meta_process();
+            plan.process();
+
+            auto rbuff = rec.sink.get_buffer();
+            auto cbuff = comp.sink.get_buffer();
+
+            REQUIRE(rbuff->size() == cbuff->size());
+            REQUIRE(std::vector<sample_t>(rbuff->ibegin(), rbuff->iend()) == std::vector<sample_t>(cbuff->ibegin(), cbuff->iend()));
+        }
+    }
+
+    SECTION("Load", "Ensures the load of each block is reported to the sink") {
+
+        ModChain chain;
+
+        ChainPlan plan(&chain.sink);
+
+        plan.process();
+        plan.process();
+
+        REQUIRE(chain.sink.get_blocks() == 2);
+        REQUIRE(chain.sink.get_load() > 0);
+    }
+
+    SECTION("Shared", "Ensures modules reachable through many paths are processed once") {
+
+        ConstModule src(0.25);
+        Counter count;
+        ModuleMixUp up;
+        AmplitudeScale left(1);
+        AmplitudeScale right(1);
+        ModuleMixDown down;
+
+        count.bind(&src);
+        up.bind(&count);
+        left.bind(&up);
+        right.bind(&up);
+        down.bind(&left);
+        down.bind(&right);
+
+        ChainPlan plan(&down);
+
+        REQUIRE(plan.size() == 6);
+
+        plan.process();
+        plan.process();
+
+        REQUIRE(count.processed() == 2);
+
+        auto buff = down.get_buffer();
+
+        for (auto val : *buff) {
+
+            REQUIRE(val == static_cast<sample_t>(0.5));
+        }
+    }
+
+    SECTION("Opaque", "Ensures modules that can't be flattened are meta processed") {
+
+        SineOscillator osc;
+        LatencyModule late;
+        PeriodSink sink;
+
+        sink.bind(&late);
+        late.bind(&osc);
+
+        sink.meta_info_sync();
+        sink.meta_start();
+
+        ChainPlan plan(&sink);
+
+        REQUIRE(plan.size() == 2);
+        REQUIRE(plan.is_opaque(0));
+        REQUIRE(!plan.is_opaque(1));
+
+        plan.process();
+
+        REQUIRE(late.processed() == 1);
+        REQUIRE(sink.get_buffer() != nullptr);
+    }
+
+    SECTION("Liveness", "Ensures buffer lifetimes are determined correctly") {
+
+        // In place modules continue the same buffer:
+
+        SineOscillator osc;
+        std::vector<AmplitudeScale> amps(200);
+        PeriodSink sink;
+
+        sink.bind(&amps.back());
+
+        for (std::size_t i = amps.size() - 1; i > 0; --i) {
+
+            amps[i].bind(&amps[i - 1]);
+        }
+
+        amps.front().bind(&osc);
+
+        sink.meta_info_sync();
+        sink.meta_start();
+
+        ChainPlan plan(&sink);
+
+        REQUIRE(plan.size() == 202);
+        REQUIRE(plan.buffer_count() == 1);
+        REQUIRE(plan.peak_buffers() == 1);
+        REQUIRE(plan.get_buffer_id(201) == plan.get_buffer_id(0));
+        REQUIRE(plan.get_last_use(0) == 1);
+
+        // The pool holds our working set, so processing does not allocate:
+
+        auto* pool = &(sink.get_chain_info()->pool);
+
+        plan.process();
+        plan.process();
+
+        const int allocs = pool->allocations();
+
+        for (int i = 0; i < 10; ++i) {
+
+            plan.process();
+        }
+
+        REQUIRE(pool->allocations() == allocs);
+    }
+
+    SECTION("Shared Liveness", "Ensures buffers read by many modules live until the last reader") {
+
+        ConstModule src(0.25);
+        Counter count;
+        ModuleMixUp up;
+        AmplitudeScale left(1);
+        AmplitudeScale right(1);
+        ModuleMixDown down;
+
+        count.bind(&src);
+        up.bind(&count);
+        left.bind(&up);
+        right.bind(&up);
+        down.bind(&left);
+        down.bind(&right);
+
+        ChainPlan plan(&down);
+
+        // src, count and up share a buffer, the others are copies or sums:
+
+        REQUIRE(plan.buffer_count() == 4);
+        REQUIRE(plan.get_buffer_id(0) == plan.get_buffer_id(2));
+        REQUIRE(plan.get_last_use(2) == 4);
+        REQUIRE(plan.peak_buffers() == 3);
+
+        // Processing is unaffected by releasing the mix up buffer early:
+
+        plan.process();
+
+        auto buff = down.get_buffer();
+
+        for (auto val : *buff) {
+
+            REQUIRE(val == static_cast<sample_t>(0.5));
+        }
+    }
+}
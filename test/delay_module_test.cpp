@@ -0,0 +1,139 @@
+/**
+ * @file delay_module_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for the delay module
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <memory>
+#include <vector>
+
+#include "delay_module.hpp"
+#include "meta_audio.hpp"
+
+TEST_CASE("DelayModule Test", "[delay]") {
+
+    const int channels = 2;
+    const int frames = 64;
+
+    // Delay in whole samples:
+
+    const int echo = 100;
+
+    DelayModule delay(static_cast<double>(echo) / SAMPLE_RATE);
+
+    delay.get_info()->channels = channels;
+    delay.get_info()->in_buffer = frames;
+    delay.set_max_delay(0.01);
+
+    // Runs an impulse through, returning the first channel of the output:
+
+    auto run = [&](int blocks) {
+
+        std::vector<sample_t> out;
+
+        for (int block = 0; block < blocks; ++block) {
+
+            auto buff = std::make_unique<AudioBuffer>(frames, channels);
+
+            if (block == 0) {
+
+                buff->at(0, 0) = 1;
+                buff->at(1, 0) = -1;
+            }
+
+            delay.set_buffer(std::move(buff));
+            delay.process();
+
+            auto result = delay.get_buffer();
+
+            for (int f = 0; f < frames; ++f) {
+
+                out.push_back(result->at(0, f));
+
+                REQUIRE_THAT(result->at(1, f), Catch::Matchers::WithinAbs(-result->at(0, f), 1e-6));
+            }
+        }
+
+        return out;
+    };
+
+    SECTION("Echo", "Ensures a single tap delays an impulse") {
+
+        delay.start();
+
+        auto out = run(4);
+
+        for (std::size_t i = 0; i < out.size(); ++i) {
+
+            REQUIRE_THAT(out[i], Catch::Matchers::WithinAbs(i == echo ? 1 : 0, 1e-6));
+        }
+    }
+
+    SECTION("Taps", "Ensures every tap reads from the same line") {
+
+        delay.set_tap(0, {static_cast<double>(echo) / SAMPLE_RATE, 0.5, 1});
+        delay.add_tap(3.0 / SAMPLE_RATE, 0.25);
+
+        REQUIRE(delay.get_taps().size() == 2);
+
+        delay.set_mix(0.5);
+        delay.start();
+
+        auto out = run(4);
+
+        for (std::size_t i = 0; i < out.size(); ++i) {
+
+            double expected = i == 0 ? 0.5 : 0;
+
+            expected += i == 3 ? 0.125 : 0;
+            expected += i == echo ? 0.25 : 0;
+
+            REQUIRE_THAT(out[i], Catch::Matchers::WithinAbs(expected, 1e-6));
+        }
+    }
+
+    SECTION("Feedback", "Ensures the wet signal is fed back into the line") {
+
+        delay.set_feedback(0.5);
+        delay.start();
+
+        auto out = run(8);
+
+        for (std::size_t i = 0; i < out.size(); ++i) {
+
+            double expected = 0;
+
+            if (i > 0 && i % echo == 0) {
+
+                expected = std::pow(0.5, static_cast<double>(i / echo) - 1);
+            }
+
+            REQUIRE_THAT(out[i], Catch::Matchers::WithinAbs(expected, 1e-6));
+        }
+    }
+
+    SECTION("Modulated", "Ensures modulation moves the delay of each tap") {
+
+        ConstModule source(static_cast<sample_t>(-50.0 / SAMPLE_RATE));
+
+        delay.get_modulation()->bind(&source);
+        delay.get_modulation()->conf_mod(&delay);
+
+        delay.start();
+
+        auto out = run(4);
+
+        for (std::size_t i = 0; i < out.size(); ++i) {
+
+            REQUIRE_THAT(out[i], Catch::Matchers::WithinAbs(i == echo - 50 ? 1 : 0, 1e-4));
+        }
+    }
+}
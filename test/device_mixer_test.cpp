@@ -0,0 +1,252 @@
+/**
+ * @file device_mixer_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for the device mixer
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "device_mixer.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "dsp/denormal.hpp"
+#include "meta_audio.hpp"
+
+TEST_CASE("DeviceMixer Test", "[mixer]") {
+
+    // Started sinks flush denormals, restore the mode of this thread once we are done:
+
+    const FlushToZeroScope ftz(flush_to_zero());
+
+    DeviceMixer mixer(1, BUFF_SIZE);
+
+    std::vector<sample_t> captured;
+
+    mixer.set_output([&captured](const sample_t* data, int frames) { captured.insert(captured.end(), data, data + frames); });
+
+    ConstModule first(0.25);
+    ConstModule second(0.5);
+
+    MixerSink sink1(mixer);
+    MixerSink sink2(mixer);
+
+    sink1.bind(&first);
+    sink2.bind(&second);
+
+    SECTION("Attach", "Ensures sinks attach when started, and detach when stopped") {
+
+        REQUIRE(mixer.clients() == 0);
+
+        sink1.meta_start();
+        sink2.meta_start();
+
+        REQUIRE(mixer.clients() == 2);
+        REQUIRE(sink1.get_client() != nullptr);
+
+        sink1.meta_stop();
+
+        REQUIRE(mixer.clients() == 1);
+        REQUIRE(sink1.get_client() == nullptr);
+
+        sink2.meta_stop();
+
+        REQUIRE(mixer.clients() == 0);
+
+        // Every slot can be taken, and no more:
+
+        std::vector<std::shared_ptr<DeviceMixer::Client>> clients;
+
+        for (int i = 0; i < DeviceMixer::MAX_CLIENTS; ++i) {
+
+            clients.push_back(mixer.attach(BUFF_SIZE));
+
+            REQUIRE(clients.back() != nullptr);
+        }
+
+        REQUIRE(mixer.attach(BUFF_SIZE) == nullptr);
+    }
+
+    SECTION("Mix", "Ensures queued periods are summed, and missing periods are silent") {
+
+        sink1.meta_start();
+        sink2.meta_start();
+
+        sink1.meta_process();
+        sink2.meta_process();
+
+        REQUIRE(mixer.mix() == 2);
+        REQUIRE(static_cast<int>(captured.size()) == BUFF_SIZE);
+
+        for (const sample_t val : captured) {
+
+            REQUIRE_THAT(val, Catch::Matchers::WithinAbs(0.75, 0.0001));
+        }
+
+        REQUIRE(sink1.get_client()->get_underruns() == 0);
+
+        // Only the first chain renders this time:
+
+        sink1.meta_process();
+
+        mixer.mix();
+
+        REQUIRE_THAT(captured.back(), Catch::Matchers::WithinAbs(0.25, 0.0001));
+        REQUIRE(sink1.get_client()->get_underruns() == 0);
+        REQUIRE(sink2.get_client()->get_underruns() == 1);
+
+        sink1.meta_stop();
+        sink2.meta_stop();
+    }
+
+    SECTION("Gain", "Ensures the gain of each client is applied") {
+
+        std::shared_ptr<DeviceMixer::Client> client = mixer.attach(BUFF_SIZE);
+
+        const std::vector<sample_t> ones(BUFF_SIZE, 1);
+
+        client->set_gain(0.5);
+
+        REQUIRE(client->write(ones.data(), BUFF_SIZE) == BUFF_SIZE);
+        REQUIRE(client->queued() == BUFF_SIZE);
+
+        // Writes stop once the ring is full:
+
+        const int space = client->space();
+
+        REQUIRE(space < BUFF_SIZE);
+        REQUIRE(client->write(ones.data(), BUFF_SIZE) == space);
+        REQUIRE(client->space() == 0);
+
+        mixer.mix();
+
+        REQUIRE_THAT(captured.front(), Catch::Matchers::WithinAbs(0.5, 0.0001));
+
+        mixer.detach(client);
+    }
+
+    SECTION("Frames", "Ensures frames are never split when the ring does not hold whole frames") {
+
+        DeviceMixer multi(3, 4);
+
+        std::vector<sample_t> output;
+
+        multi.set_output([&output](const sample_t* data, int frames) { output.insert(output.end(), data, data + static_cast<std::ptrdiff_t>(frames) * 3); });
+
+        // Three channels of four frames do not divide the ring capacity:
+
+        std::shared_ptr<DeviceMixer::Client> client = multi.attach(4);
+
+        REQUIRE(client->space() == 5);
+
+        std::vector<sample_t> frames;
+
+        for (int i = 0; i < 8; ++i) {
+
+            frames.insert(frames.end(), {0, 1, 2});
+        }
+
+        for (int i = 0; i < 4; ++i) {
+
+            int done = 0;
+
+            while (done < 8) {
+
+                done += client->write(frames.data() + static_cast<std::ptrdiff_t>(done) * 3, 8 - done);
+
+                multi.mix();
+            }
+        }
+
+        // A partial period is padded with silent frames, each frame must stay aligned:
+
+        REQUIRE(output.size() % 3 == 0);
+
+        int found = 0;
+
+        for (std::size_t i = 0; i < output.size(); i += 3) {
+
+            if (output[i + 1] == 0 && output[i + 2] == 0) {
+
+                continue;
+            }
+
+            REQUIRE(output[i] == 0);
+            REQUIRE(output[i + 1] == 1);
+            REQUIRE(output[i + 2] == 2);
+
+            ++found;
+        }
+
+        REQUIRE(found == 32);
+
+        multi.detach(client);
+    }
+
+    SECTION("Threaded", "Ensures chains rendering on their own threads are all mixed") {
+
+        const int blocks = 20;
+
+        sink1.meta_start();
+        sink2.meta_start();
+
+        mixer.start();
+
+        REQUIRE(mixer.is_running());
+
+        std::thread chain1([&sink1]() {
+
+            for (int i = 0; i < blocks; ++i) {
+
+                sink1.meta_process();
+            }
+        });
+
+        std::thread chain2([&sink2]() {
+
+            for (int i = 0; i < blocks; ++i) {
+
+                sink2.meta_process();
+            }
+        });
+
+        chain1.join();
+        chain2.join();
+
+        // Wait for the mixer to drain the rings:
+
+        while (sink1.get_client()->queued() > 0 || sink2.get_client()->queued() > 0) {
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        mixer.stop();
+
+        REQUIRE(!mixer.is_running());
+        REQUIRE(sink1.get_dropped() == 0);
+        REQUIRE(sink2.get_dropped() == 0);
+
+        // Periods we timed out on are silent, so the total is what both chains rendered:
+
+        double total = 0;
+
+        for (const sample_t val : captured) {
+
+            total += val;
+        }
+
+        REQUIRE(mixer.get_periods() >= blocks);
+        REQUIRE_THAT(total, Catch::Matchers::WithinAbs(0.75 * blocks * BUFF_SIZE, 0.01));
+
+        sink1.meta_stop();
+        sink2.meta_stop();
+    }
+}
@@ -0,0 +1,98 @@
+/**
+ * @file alloc_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for aligned allocators and arenas
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "dsp/alloc.hpp"
+#include "audio_buffer.hpp"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Determines if a pointer is aligned to BUFFER_ALIGN
+ */
+bool is_aligned(const void* ptr) { return reinterpret_cast<std::uintptr_t>(ptr) % BUFFER_ALIGN == 0; }
+
+}  // namespace
+
+TEST_CASE("Aligned Allocator Test", "[alloc][dsp]") {
+
+    SECTION("Size", "Ensures sizes are padded to the vector width") {
+
+        REQUIRE(aligned_width<float>() == 16);
+        REQUIRE(aligned_width<double>() == 8);
+
+        REQUIRE(aligned_size<float>(0) == 0);
+        REQUIRE(aligned_size<float>(1) == 16);
+        REQUIRE(aligned_size<float>(16) == 16);
+        REQUIRE(aligned_size<float>(17) == 32);
+    }
+
+    SECTION("Align", "Ensures buffers are aligned") {
+
+        for (int size = 1; size < 100; size += 7) {
+
+            AudioBuffer buff(size, 2);
+
+            REQUIRE(is_aligned(buff.data()));
+        }
+
+        std::vector<float, AlignedAllocator<float>> vect(3);
+
+        REQUIRE(is_aligned(vect.data()));
+    }
+
+    SECTION("Arena", "Ensures buffers in an arena scope use the arena") {
+
+        HugePageArena arena(1 << 20);
+
+        REQUIRE(arena.capacity() >= 1 << 20);
+
+        {
+            ArenaScope scope(&arena);
+
+            AudioBuffer buff(100, 2);
+
+            REQUIRE(arena.owns(buff.data()));
+            REQUIRE(is_aligned(buff.data()));
+            REQUIRE(arena.allocated() >= 200 * sizeof(sample_t));
+
+            // Ensure moved buffers keep their storage:
+
+            AudioBuffer moved = std::move(buff);
+
+            REQUIRE(arena.owns(moved.data()));
+        }
+
+        // Buffers outside the scope use normal memory:
+
+        AudioBuffer buff(100, 2);
+
+        REQUIRE(!arena.owns(buff.data()));
+        REQUIRE(HugePageArena::current() == nullptr);
+    }
+
+    SECTION("Full", "Ensures a full arena falls back to normal memory") {
+
+        HugePageArena arena(1);
+
+        ArenaScope scope(&arena);
+
+        AudioBuffer buff(static_cast<int>(arena.capacity()), 1);
+
+        REQUIRE(!arena.owns(buff.data()));
+        REQUIRE(is_aligned(buff.data()));
+    }
+}
@@ -0,0 +1,205 @@
+/**
+ * @file blep_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for PolyBLEP oscillator kernels
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "dsp/blep.hpp"
+#include "dsp/osc.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+namespace {
+
+// Size of each test block
+const int blep_test_size = 4096;
+
+// Phase values to test with, high enough that aliasing is obvious
+const double blep_start = 0.3;
+const double blep_inc = 5000.0 / 44100.0;
+
+/**
+ * @brief Measures the fraction of energy that is aliasing
+ *
+ * The fundamental sits exactly on a bin of the block,
+ * so every harmonic below the Nyquist frequency does too.
+ * Anything left over after removing them has folded back from above the Nyquist frequency.
+ *
+ * @param data Block to measure
+ * @param fund Bin of the fundamental
+ * @return double Fraction of the energy outside the harmonics
+ */
+double alias_fraction(const std::vector<double>& data, int fund) {
+
+    const auto size = static_cast<int>(data.size());
+
+    double total = 0;
+
+    for (const double val : data) {
+
+        total += val * val;
+    }
+
+    double harmonics = 0;
+
+    for (int bin = fund; bin < size / 2; bin += fund) {
+
+        std::complex<double> sum = 0;
+
+        for (int i = 0; i < size; ++i) {
+
+            sum += data[i] * std::polar(1.0, -2 * M_PI * bin * i / size);
+        }
+
+        harmonics += 2 * std::norm(sum) / size;
+    }
+
+    return (total - harmonics) / total;
+}
+
+}  // namespace
+
+TEST_CASE("PolyBLEP Kernel Test", "[osc][blep][dsp]") {
+
+    SECTION("Corrections", "Ensures the corrections bridge each discontinuity") {
+
+        const double width = 0.1;
+
+        // A step from -1 to 1 is met halfway from either side:
+
+        REQUIRE_THAT(poly_blep(0.0, width), Catch::Matchers::WithinAbs(-1, 1e-12));
+        REQUIRE_THAT(poly_blep(1.0 - 1e-12, width), Catch::Matchers::WithinAbs(1, 1e-9));
+
+        // Corners are lifted by a sixth of the slope change:
+
+        REQUIRE_THAT(poly_blamp(0.0, width), Catch::Matchers::WithinAbs(1.0 / 6, 1e-12));
+        REQUIRE_THAT(poly_blamp(1.0 - 1e-12, width), Catch::Matchers::WithinAbs(1.0 / 6, 1e-9));
+
+        // Nothing changes further away:
+
+        for (int i = 0; i < 100; ++i) {
+
+            const double turn = i / 100.0;
+
+            if (turn > width && turn < 1 - width) {
+
+                REQUIRE(poly_blep(turn, width) == 0);
+                REQUIRE(poly_blamp(turn, width) == 0);
+            }
+        }
+
+        REQUIRE(blep_width(0) > 0);
+        REQUIRE(blep_width(-0.9) == 0.25);
+    }
+
+    SECTION("Naive", "Ensures only samples near a discontinuity are changed") {
+
+        std::vector<double> naive(blep_test_size);
+        std::vector<double> blep(blep_test_size);
+
+        const auto check = [&](double offset, double spacing) {
+
+            for (int i = 0; i < blep_test_size; ++i) {
+
+                // Distance to the closest discontinuity in turns:
+
+                double turn = blep_start + offset + blep_inc * i;
+                turn = std::fmod(turn - std::floor(turn), spacing);
+
+                const double dist = std::min(turn, spacing - turn);
+
+                if (dist > blep_inc) {
+
+                    REQUIRE_THAT(blep[i], Catch::Matchers::WithinAbs(naive[i], 1e-9));
+                }
+            }
+        };
+
+        osc_square(naive.data(), blep_test_size, blep_start, blep_inc);
+        osc_blep_square(blep.data(), blep_test_size, blep_start, blep_inc);
+
+        check(0, 0.5);
+
+        osc_sawtooth(naive.data(), blep_test_size, blep_start, blep_inc);
+        osc_blep_sawtooth(blep.data(), blep_test_size, blep_start, blep_inc);
+
+        check(0.5, 1);
+
+        osc_triangle(naive.data(), blep_test_size, blep_start, blep_inc);
+        osc_blep_triangle(blep.data(), blep_test_size, blep_start, blep_inc);
+
+        check(0.25, 0.5);
+    }
+
+    SECTION("Aliasing", "Ensures most of the aliasing is removed") {
+
+        // A fundamental of 300 bins is about 3.2 kHz at 44.1 kHz:
+
+        const int fund = 300;
+        const double inc = static_cast<double>(fund) / blep_test_size;
+
+        std::vector<double> naive(blep_test_size);
+        std::vector<double> blep(blep_test_size);
+
+        osc_square(naive.data(), blep_test_size, blep_start, inc);
+        osc_blep_square(blep.data(), blep_test_size, blep_start, inc);
+
+        REQUIRE(alias_fraction(blep, fund) < 0.1 * alias_fraction(naive, fund));
+
+        osc_sawtooth(naive.data(), blep_test_size, blep_start, inc);
+        osc_blep_sawtooth(blep.data(), blep_test_size, blep_start, inc);
+
+        REQUIRE(alias_fraction(blep, fund) < 0.1 * alias_fraction(naive, fund));
+
+        osc_triangle(naive.data(), blep_test_size, blep_start, inc);
+        osc_blep_triangle(blep.data(), blep_test_size, blep_start, inc);
+
+        REQUIRE(alias_fraction(blep, fund) < 0.2 * alias_fraction(naive, fund));
+    }
+
+    SECTION("Turns", "Ensures the kernels match the single sample functions") {
+
+        std::vector<float> fdata(blep_test_size);
+        std::vector<long double> ldata(blep_test_size);
+
+        const double width = blep_width(blep_inc);
+
+        const auto check = [&](auto turns) {
+
+            for (int i = 0; i < blep_test_size; ++i) {
+
+                double turn = blep_start + blep_inc * i;
+                turn -= std::floor(turn);
+
+                REQUIRE_THAT(fdata[i], Catch::Matchers::WithinAbs(turns(turn, width), 1e-6));
+                REQUIRE_THAT(static_cast<double>(ldata[i]), Catch::Matchers::WithinAbs(turns(turn, width), 1e-12));
+            }
+        };
+
+        osc_blep_square(fdata.data(), blep_test_size, blep_start, blep_inc);
+        osc_blep_square(ldata.data(), blep_test_size, blep_start, blep_inc);
+
+        check(blep_square_turns);
+
+        osc_blep_sawtooth(fdata.data(), blep_test_size, blep_start, blep_inc);
+        osc_blep_sawtooth(ldata.data(), blep_test_size, blep_start, blep_inc);
+
+        check(blep_sawtooth_turns);
+
+        osc_blep_triangle(fdata.data(), blep_test_size, blep_start, blep_inc);
+        osc_blep_triangle(ldata.data(), blep_test_size, blep_start, blep_inc);
+
+        check(blep_triangle_turns);
+    }
+}
@@ -776,6 +776,50 @@ TEST_CASE("Base Buffer Test", "[buff]") {
         REQUIRE(buff.get_samplerate() == 123456);
     }
 
+    SECTION("Constant", "Ensures the constant hint can be set, copied and cleared") {
+
+        BaseBuffer<CONT, long double> buff(10, 1);
+
+        // Contents are unknown by default:
+
+        REQUIRE(!buff.is_constant());
+        REQUIRE(!buff.is_silent());
+
+        // Filling marks the buffer:
+
+        buff.fill_constant(0.5);
+
+        REQUIRE(buff.is_constant());
+        REQUIRE(!buff.is_silent());
+        REQUIRE(buff.get_constant() == 0.5);
+        REQUIRE(std::all_of(buff.begin(), buff.end(), [](long double val) { return val == 0.5; }));
+
+        // Copies keep the hint:
+
+        BaseBuffer<CONT, long double> copy(buff);
+
+        REQUIRE(copy.is_constant());
+
+        // Silence is a constant of zero:
+
+        buff.fill_constant(0);
+
+        REQUIRE(buff.is_silent());
+
+        // Clearing leaves the contents alone:
+
+        buff.clear_constant();
+
+        REQUIRE(!buff.is_constant());
+        REQUIRE(buff.size() == 10);
+
+        // Assigning new contents clears the hint:
+
+        copy.assign(CONT(10));
+
+        REQUIRE(!copy.is_constant());
+    }
+
     SECTION("Channel Size", "Ensures the channels can be get/set") {
 
         // Create a buffer with 10 samples and 5 channels:
@@ -1814,6 +1858,24 @@ TEST_CASE("Dynamic Buffer Test", "[buff]") {
             REQUIRE(iter.get_index() == 14);
         }
     }
+
+    SECTION("Span", "Ensures the span views the underlying data") {
+
+        Buffer<long double> buff(chan1, 2);
+
+        auto view = buff.span();
+
+        REQUIRE(view.data() == buff.data());
+        REQUIRE(view.size() == buff.size());
+
+        view[3] = 99;
+
+        REQUIRE(buff.at(3) == 99);
+
+        const Buffer<long double>& cbuff = buff;
+
+        REQUIRE(cbuff.span().data() == buff.data());
+    }
 }
  
 TEST_CASE("Static Buffer Test", "[buff]") {
@@ -2378,6 +2440,91 @@ TEST_CASE("Static Buffer Test", "[buff]") {
     }
 }
 
+TEST_CASE("Planar Buffer Test", "[buff]") {
+
+    // Create a planar buffer with 3 channels:
+
+    Buffer<long double, Planar> buff(10, 3);
+
+    for (int c = 0; c < 3; ++c) {
+
+        for (int i = 0; i < 10; ++i) {
+
+            buff.at(c, i) = (c * 10) + i;
+        }
+    }
+
+    SECTION("Layout", "Ensures each channel is contiguous") {
+
+        for (int i = 0; i < 30; ++i) {
+
+            REQUIRE(buff.data()[i] == i);
+        }
+
+        REQUIRE(buff.channel_data(1) == buff.data() + 10);
+        REQUIRE(buff.channel_data(2)[3] == 23);
+    }
+
+    SECTION("Sequential Iterator", "Ensures sequential iteration matches storage order") {
+
+        int index = 0;
+
+        for (auto iter = buff.sbegin(); iter != buff.send(); ++iter) {
+
+            REQUIRE(*iter == index++);
+        }
+    }
+
+    SECTION("Interleaved Iterator", "Ensures interleaved iteration is still interleaved") {
+
+        auto iter = buff.ibegin();
+
+        for (int i = 0; i < 10; ++i) {
+
+            for (int c = 0; c < 3; ++c) {
+
+                REQUIRE(iter.get_channel() == c);
+                REQUIRE(iter.get_sample() == i);
+                REQUIRE(*iter == (c * 10) + i);
+
+                ++iter;
+            }
+        }
+
+        REQUIRE(iter == buff.iend());
+    }
+
+    SECTION("Channel Span", "Ensures channel views cover each channel") {
+
+        for (int c = 0; c < 3; ++c) {
+
+            auto chan = buff.channel_span(c);
+
+            REQUIRE(chan.size() == 10);
+
+            for (int i = 0; i < 10; ++i) {
+
+                REQUIRE(chan[i] == (c * 10) + i);
+            }
+        }
+    }
+
+    SECTION("Iterator Write", "Ensures iterators write to the correct place") {
+
+        auto iter = buff.ibegin();
+
+        iter.set_position(2, 4);
+
+        *iter = 99;
+
+        REQUIRE(buff.channel_data(2)[4] == 99);
+
+        std::fill(buff.ibegin(), buff.iend(), 5);
+
+        REQUIRE(std::all_of(buff.data(), buff.data() + buff.size(), [](long double val) { return val == 5; }));
+    }
+}
+
 TEST_CASE("Ring Buffer Test", "[buff][ring]") {
 
     SECTION("Construct", "Ensures the ring buffer can be constructed") {
@@ -12,6 +12,9 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 
+#include <algorithm>
+#include <limits>
+
 #include "dsp/conv.hpp"
 
 // Sample data to test convolution
@@ -41,12 +44,16 @@ TEST_CASE("Convolution Test", "[conv][dsp]") {
 
     // Create buffers:
 
-    BufferPointer binput = std::make_unique<AudioBuffer>(input);
-    BufferPointer bkernel = std::make_unique<AudioBuffer>(kernel);
+    BufferPointer binput = std::make_unique<AudioBuffer>(input.begin(), input.end());
+    BufferPointer bkernel = std::make_unique<AudioBuffer>(kernel.begin(), kernel.end());
 
     // Create buffer of results:
 
-    AudioBuffer buff(length_conv(input.size(), kernel.size()));
+    Buffer<long double> buff(length_conv(input.size(), kernel.size()));
+
+    // Tolerance to use when working with AudioBuffers:
+
+    const double btol = std::max<double>(1e-10, std::numeric_limits<sample_t>::epsilon() * 64);
 
     SECTION("Input Side", "Tests for the input side algorithm") {
 
@@ -90,7 +97,7 @@ TEST_CASE("Convolution Test", "[conv][dsp]") {
 
             for (auto iter = buff->ibegin(); iter != buff->iend(); ++iter) {
 
-                REQUIRE_THAT(*iter, Catch::Matchers::WithinAbs(output.at(iter.get_index()), 1e-10));
+                REQUIRE_THAT(*iter, Catch::Matchers::WithinAbs(output.at(iter.get_index()), btol));
             }
         }
     }
@@ -137,7 +144,7 @@ TEST_CASE("Convolution Test", "[conv][dsp]") {
 
             for (auto iter = buff->ibegin(); iter != buff->iend(); ++iter) {
 
-                REQUIRE_THAT(*iter, Catch::Matchers::WithinAbs(output.at(iter.get_index()), 1e-10));
+                REQUIRE_THAT(*iter, Catch::Matchers::WithinAbs(output.at(iter.get_index()), btol));
             }
         }
     }
@@ -152,13 +159,247 @@ TEST_CASE("Convolution Test", "[conv][dsp]") {
 
         // Do operation:
 
-        //conv_fft(finput.begin(), finput.size(), fkernel.begin(), fkernel.size(), buff.begin());
+        conv_fft(finput.begin(), static_cast<int>(finput.size()), fkernel.begin(), static_cast<int>(fkernel.size()), buff.begin());
 
         // Check that output matches expected:
 
         for (int i = 0; i < size; ++i) {
 
-            //REQUIRE_THAT(buff.at(i), Catch::Matchers::WithinAbs(foutput.at(i), 1e-10));
+            REQUIRE_THAT(buff.at(i), Catch::Matchers::WithinAbs(foutput.at(i), 1e-10));
+        }
+    }
+}
+
+TEST_CASE("StreamFIR Test", "[conv][dsp]") {
+
+    // Compute expected full convolution:
+
+    std::vector<long double> expected(length_conv(finput.size(), fkernel.size()));
+
+    input_conv(finput.begin(), finput.size(), fkernel.begin(), fkernel.size(), expected.begin());
+
+    SECTION("Dot", "Ensures the dot product is correct") {
+
+        const std::vector<double> aval = {1, 2, 3, 4, 5, 6, 7};
+        const std::vector<double> bval = {7, 6, 5, 4, 3, 2, 1};
+
+        REQUIRE(fir_dot(aval.data(), bval.data(), 7) == 84);
+        REQUIRE(fir_dot(aval.data(), bval.data(), 3) == 34);
+        REQUIRE(fir_dot(aval.data(), bval.data(), 0) == 0);
+    }
+
+    SECTION("Streaming", "Ensures block processing matches direct convolution") {
+
+        for (int block : {1, 7, 16, 64}) {
+
+            StreamFIR<long double> fir(fkernel.begin(), static_cast<int>(fkernel.size()), block);
+
+            REQUIRE(fir.history() == static_cast<int>(fkernel.size()) - 1);
+
+            std::vector<long double> output(finput.size());
+
+            // Process in chunks of the block size:
+
+            for (std::size_t done = 0; done < finput.size(); done += block) {
+
+                const int num = std::min<int>(block, static_cast<int>(finput.size() - done));
+
+                fir.process(finput.begin() + done, num, output.begin() + done);
+            }
+
+            for (std::size_t i = 0; i < output.size(); ++i) {
+
+                REQUIRE_THAT(output.at(i), Catch::Matchers::WithinAbs(expected.at(i), 1e-10));
+            }
+        }
+    }
+
+    SECTION("Reset", "Ensures history is cleared upon reset") {
+
+        StreamFIR<long double> fir(fkernel.begin(), static_cast<int>(fkernel.size()), 32);
+
+        std::vector<long double> output(finput.size());
+
+        fir.process(finput.begin(), static_cast<int>(finput.size()), output.begin());
+
+        fir.reset();
+
+        fir.process(finput.begin(), static_cast<int>(finput.size()), output.begin());
+
+        for (std::size_t i = 0; i < output.size(); ++i) {
+
+            REQUIRE_THAT(output.at(i), Catch::Matchers::WithinAbs(expected.at(i), 1e-10));
+        }
+    }
+}
+
+TEST_CASE("OverlapSave Test", "[conv][dsp]") {
+
+    // Engines work in sample precision, and the output reaches the tens of thousands:
+
+    const double ftol = std::max<double>(1e-6, std::numeric_limits<sample_t>::epsilon() * 1e6);
+
+    // Compute expected full convolution:
+
+    std::vector<long double> expected(length_conv(finput.size(), fkernel.size()));
+
+    input_conv(finput.begin(), finput.size(), fkernel.begin(), fkernel.size(), expected.begin());
+
+    SECTION("Prepare", "Ensures FFT and block sizes are correct") {
+
+        OverlapSave ols(fkernel.begin(), static_cast<int>(fkernel.size()), 16);
+
+        // 16 + 32 - 1 = 47, next power of two is 64:
+
+        REQUIRE(ols.get_fft_size() == 64);
+        REQUIRE(ols.get_block_size() == 33);
+    }
+
+    SECTION("Streaming", "Ensures block processing matches direct convolution") {
+
+        for (int block : {1, 7, 16, 64}) {
+
+            OverlapSave ols(fkernel.begin(), static_cast<int>(fkernel.size()), block);
+
+            std::vector<long double> output(finput.size());
+
+            // Process in chunks of the block size:
+
+            for (std::size_t done = 0; done < finput.size(); done += block) {
+
+                const int num = std::min<int>(block, static_cast<int>(finput.size() - done));
+
+                ols.process(finput.begin() + done, num, output.begin() + done);
+            }
+
+            // The first input size samples should match:
+
+            for (std::size_t i = 0; i < output.size(); ++i) {
+
+                REQUIRE_THAT(output.at(i), Catch::Matchers::WithinAbs(expected.at(i), ftol));
+            }
+        }
+    }
+
+    SECTION("Reset", "Ensures history is cleared upon reset") {
+
+        OverlapSave ols(fkernel.begin(), static_cast<int>(fkernel.size()), 32);
+
+        std::vector<long double> output(finput.size());
+
+        ols.process(finput.begin(), static_cast<int>(finput.size()), output.begin());
+
+        ols.reset();
+
+        ols.process(finput.begin(), static_cast<int>(finput.size()), output.begin());
+
+        for (std::size_t i = 0; i < output.size(); ++i) {
+
+            REQUIRE_THAT(output.at(i), Catch::Matchers::WithinAbs(expected.at(i), ftol));
+        }
+    }
+    SECTION("Share", "Ensures engines can share a kernel spectrum") {
+
+        OverlapSave ols(fkernel.begin(), static_cast<int>(fkernel.size()), 16);
+        OverlapSave other;
+
+        other.share_kernel(ols);
+
+        REQUIRE(other.get_spectrum() == ols.get_spectrum());
+        REQUIRE(other.get_fft_size() == ols.get_fft_size());
+        REQUIRE(other.get_block_size() == ols.get_block_size());
+
+        std::vector<long double> output(finput.size());
+
+        other.process(finput.begin(), static_cast<int>(finput.size()), output.begin());
+
+        for (std::size_t i = 0; i < output.size(); ++i) {
+
+            REQUIRE_THAT(output.at(i), Catch::Matchers::WithinAbs(expected.at(i), ftol));
+        }
+    }
+}
+
+TEST_CASE("PartitionedConv Test", "[conv][dsp]") {
+
+    // Engines work in sample precision, and the output reaches the tens of thousands:
+
+    const double ftol = std::max<double>(1e-6, std::numeric_limits<sample_t>::epsilon() * 1e6);
+
+    // Compute expected full convolution:
+
+    std::vector<long double> expected(length_conv(finput.size(), fkernel.size()));
+
+    input_conv(finput.begin(), finput.size(), fkernel.begin(), fkernel.size(), expected.begin());
+
+    SECTION("Prepare", "Ensures partition count is correct") {
+
+        PartitionedConv conv(fkernel.begin(), static_cast<int>(fkernel.size()), 8);
+
+        REQUIRE(conv.get_partition_size() == 8);
+        REQUIRE(conv.get_partitions() == 4);
+
+        PartitionedConv conv2(fkernel.begin(), 30, 8);
+
+        REQUIRE(conv2.get_partitions() == 4);
+    }
+
+    SECTION("Streaming", "Ensures partitioned processing matches direct convolution") {
+
+        for (int block : {1, 4, 8, 16, 64}) {
+
+            PartitionedConv conv(fkernel.begin(), static_cast<int>(fkernel.size()), block);
+
+            std::vector<long double> output(finput.size());
+
+            for (std::size_t done = 0; done < finput.size(); done += block) {
+
+                conv.process(finput.begin() + done, block, output.begin() + done);
+            }
+
+            for (std::size_t i = 0; i < output.size(); ++i) {
+
+                REQUIRE_THAT(output.at(i), Catch::Matchers::WithinAbs(expected.at(i), ftol));
+            }
+
+            // Reset and ensure output is identical:
+
+            conv.reset();
+
+            std::vector<long double> routput(finput.size());
+
+            conv.process(finput.begin(), static_cast<int>(finput.size()), routput.begin());
+
+            for (std::size_t i = 0; i < output.size(); ++i) {
+
+                REQUIRE_THAT(routput.at(i), Catch::Matchers::WithinAbs(expected.at(i), ftol));
+            }
+        }
+    }
+    SECTION("Partial", "Ensures blocks smaller than a partition are processed") {
+
+        PartitionedConv conv(fkernel.begin(), static_cast<int>(fkernel.size()), 8);
+
+        std::vector<long double> output(finput.size());
+
+        // Process uneven blocks, most of which straddle partitions:
+
+        int done = 0;
+        int block = 1;
+
+        while (done < static_cast<int>(finput.size())) {
+
+            const int num = std::min(block, static_cast<int>(finput.size()) - done);
+
+            conv.process(finput.begin() + done, num, output.begin() + done);
+
+            done += num;
+            block = (block * 5) % 11 + 1;
+        }
+
+        for (std::size_t i = 0; i < output.size(); ++i) {
+
+            REQUIRE_THAT(output.at(i), Catch::Matchers::WithinAbs(expected.at(i), ftol));
         }
     }
 }
@@ -0,0 +1,315 @@
+/**
+ * @file convert_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for batch sample format converters
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "dsp/convert.hpp"
+
+// Samples to convert, including out of range values
+const std::vector<sample_t> convert_input = {0, 0.5, -0.5, 1, -1, 2, -2, 0.25};
+
+TEST_CASE("Convert Test", "[convert][dsp]") {
+
+    const std::size_t num = convert_input.size();
+
+    SECTION("Float", "Ensures float conversion is correct") {
+
+        std::vector<float> out(num);
+
+        convert_float(convert_input.data(), out.data(), num);
+
+        for (std::size_t i = 0; i < num; ++i) {
+
+            REQUIRE_THAT(out.at(i), Catch::Matchers::WithinAbs(convert_input.at(i), 1e-6));
+        }
+    }
+
+    SECTION("Int16", "Ensures 16 bit conversion clamps and rounds") {
+
+        std::vector<int16_t> out(num);
+
+        convert_int16(convert_input.data(), out.data(), num);
+
+        REQUIRE(out == std::vector<int16_t>{0, 16384, -16384, 32767, -32767, 32767, -32767, 8192});
+    }
+
+    SECTION("Int32", "Ensures 32 bit conversion clamps and rounds") {
+
+        std::vector<int32_t> out(num);
+
+        convert_int32(convert_input.data(), out.data(), num);
+
+        REQUIRE(out.at(0) == 0);
+        REQUIRE(out.at(1) == 1073741824);
+        REQUIRE(out.at(3) == 2147483647);
+        REQUIRE(out.at(6) == -2147483647);
+    }
+
+    SECTION("Dither", "Ensures dither stays within one LSB") {
+
+        std::vector<int16_t> plain(num);
+        std::vector<int16_t> out(num);
+
+        uint32_t state = 12345;
+
+        convert_int16(convert_input.data(), plain.data(), num);
+
+        for (int j = 0; j < 100; ++j) {
+
+            convert_int16_dither(convert_input.data(), out.data(), num, state);
+
+            for (std::size_t i = 0; i < num; ++i) {
+
+                REQUIRE(std::abs(out.at(i) - plain.at(i)) <= 1);
+            }
+        }
+
+        REQUIRE(state != 12345);
+    }
+
+    SECTION("Dither Lanes", "Ensures vectorized dither stays within one LSB and averages out") {
+
+        // A value halfway between two steps, over more than one vector of lanes:
+
+        const std::size_t size = DITHER_LANES * 100 + 3;
+
+        const std::vector<sample_t> half(size, static_cast<sample_t>(100.5 / 32767.0));
+        std::vector<int16_t> out(size);
+
+        Dither dither(12345);
+
+        dither.process(half.data(), out.data(), size);
+
+        double sum = 0;
+
+        for (const int16_t val : out) {
+
+            REQUIRE(val >= 99);
+            REQUIRE(val <= 102);
+
+            sum += val;
+        }
+
+        REQUIRE_THAT(sum / size, Catch::Matchers::WithinAbs(100.5, 0.1));
+
+        // Clamping must still apply:
+
+        dither.process(convert_input.data(), out.data(), num);
+
+        REQUIRE(out.at(5) >= 32766);
+        REQUIRE(out.at(6) <= -32766);
+    }
+
+    SECTION("Noise Shaping", "Ensures shaped noise moves to high frequencies") {
+
+        const std::size_t size = 4096;
+
+        const std::vector<sample_t> quiet(size, static_cast<sample_t>(0.3 / 32767.0));
+
+        std::vector<int16_t> flat(size);
+        std::vector<int16_t> shaped(size);
+
+        Dither plain(7);
+        Dither shaper(7, NoiseShaping::SecondOrder);
+
+        REQUIRE(shaper.get_shaping() == NoiseShaping::SecondOrder);
+
+        plain.process(quiet.data(), flat.data(), size);
+        shaper.process(quiet.data(), shaped.data(), size);
+
+        // Compare the error after a moving average (a crude low pass):
+
+        const auto low = [&](const std::vector<int16_t>& data) {
+
+            double energy = 0;
+
+            for (std::size_t i = 8; i < size; ++i) {
+
+                double avg = 0;
+
+                for (std::size_t k = 0; k < 8; ++k) {
+
+                    avg += data.at(i - k) - 0.3;
+                }
+
+                energy += (avg / 8) * (avg / 8);
+            }
+
+            return energy;
+        };
+
+        REQUIRE(low(shaped) < low(flat));
+
+        // The average value is kept:
+
+        double sum = 0;
+
+        for (const int16_t val : shaped) {
+
+            REQUIRE(std::abs(val) <= 6);
+
+            sum += val;
+        }
+
+        REQUIRE_THAT(sum / size, Catch::Matchers::WithinAbs(0.3, 0.05));
+    }
+
+    SECTION("From", "Ensures conversions back into mf samples are correct") {
+
+        std::vector<int16_t> s16(num);
+        std::vector<int32_t> s32(num);
+        std::vector<float> flt(num);
+
+        convert_int16(convert_input.data(), s16.data(), num);
+        convert_int32(convert_input.data(), s32.data(), num);
+        convert_float(convert_input.data(), flt.data(), num);
+
+        std::vector<sample_t> b16(num);
+        std::vector<sample_t> b32(num);
+        std::vector<sample_t> bflt(num);
+
+        convert_from_int16(s16.data(), b16.data(), num);
+        convert_from_int32(s32.data(), b32.data(), num);
+        convert_from_float(flt.data(), bflt.data(), num);
+
+        for (std::size_t i = 0; i < num; ++i) {
+
+            const double expected = std::max(-1.0, std::min(1.0, static_cast<double>(convert_input.at(i))));
+
+            REQUIRE_THAT(b16.at(i), Catch::Matchers::WithinAbs(expected, 1.0 / 32767));
+            REQUIRE_THAT(b32.at(i), Catch::Matchers::WithinAbs(expected, 1e-6));
+            REQUIRE_THAT(bflt.at(i), Catch::Matchers::WithinAbs(convert_input.at(i), 1e-6));
+        }
+    }
+}
+
+TEST_CASE("PCM Test", "[convert][dsp]") {
+
+    const std::size_t num = convert_input.size();
+
+    SECTION("Format", "Ensures PCM formats are determined correctly") {
+
+        REQUIRE(pcm_format(8, false) == PCMFormat::u8);
+        REQUIRE(pcm_format(16, false) == PCMFormat::s16);
+        REQUIRE(pcm_format(24, false) == PCMFormat::s24);
+        REQUIRE(pcm_format(32, false) == PCMFormat::s32);
+        REQUIRE(pcm_format(32, true) == PCMFormat::f32);
+        REQUIRE(pcm_format(12, false) == PCMFormat::none);
+        REQUIRE(pcm_format(64, true) == PCMFormat::none);
+
+        REQUIRE(pcm_width(PCMFormat::u8) == 1);
+        REQUIRE(pcm_width(PCMFormat::s24) == 3);
+        REQUIRE(pcm_width(PCMFormat::f32) == 4);
+        REQUIRE(pcm_width(PCMFormat::none) == 0);
+    }
+
+    SECTION("Bytes", "Ensures samples are laid out in the correct byte order") {
+
+        const std::vector<sample_t> input = {-1.0};
+
+        std::vector<char> little(3);
+        std::vector<char> big(3);
+
+        pcm_encode(PCMFormat::s24, input.data(), little.data(), 1);
+        pcm_encode(PCMFormat::s24, input.data(), big.data(), 1, true);
+
+        // -8388607 is 0x800001 in 24 bits:
+
+        REQUIRE(static_cast<unsigned char>(little.at(0)) == 0x01);
+        REQUIRE(static_cast<unsigned char>(little.at(1)) == 0x00);
+        REQUIRE(static_cast<unsigned char>(little.at(2)) == 0x80);
+
+        REQUIRE(static_cast<unsigned char>(big.at(0)) == 0x80);
+        REQUIRE(static_cast<unsigned char>(big.at(2)) == 0x01);
+    }
+
+    SECTION("Round Trip", "Ensures every format survives encoding and decoding") {
+
+        const std::vector<PCMFormat> formats = {PCMFormat::u8, PCMFormat::s16, PCMFormat::s24, PCMFormat::s32, PCMFormat::f32};
+        const std::vector<double> tolerance = {1.0 / 127, 1.0 / 32767, 1.0 / 8388607, 1e-6, 1e-6};
+
+        for (std::size_t f = 0; f < formats.size(); ++f) {
+
+            for (const bool big : {false, true}) {
+
+                std::vector<char> raw(num * pcm_width(formats.at(f)));
+                std::vector<sample_t> out(num);
+
+                pcm_encode(formats.at(f), convert_input.data(), raw.data(), num, big);
+                pcm_decode(formats.at(f), raw.data(), out.data(), num, big);
+
+                for (std::size_t i = 0; i < num; ++i) {
+
+                    // Floats are not clamped:
+
+                    const double expected = formats.at(f) == PCMFormat::f32 ? convert_input.at(i) :
+                        std::max(-1.0, std::min(1.0, static_cast<double>(convert_input.at(i))));
+
+                    REQUIRE_THAT(out.at(i), Catch::Matchers::WithinAbs(expected, tolerance.at(f)));
+                }
+            }
+        }
+    }
+
+    SECTION("16 Bit", "Ensures 16 bit samples are coded without floating point") {
+
+        const std::vector<int16_t> input = {-32768, -12345, -1, 0, 1, 255, 12345, 32767};
+
+        const std::vector<PCMFormat> formats = {PCMFormat::u8, PCMFormat::s16, PCMFormat::s24, PCMFormat::s32, PCMFormat::f32};
+
+        for (const PCMFormat format : formats) {
+
+            for (const bool big : {false, true}) {
+
+                std::vector<char> raw(input.size() * pcm_width(format));
+                std::vector<int16_t> out(input.size());
+
+                pcm_encode(format, input.data(), raw.data(), input.size(), big);
+                pcm_decode(format, raw.data(), out.data(), input.size(), big);
+
+                for (std::size_t i = 0; i < input.size(); ++i) {
+
+                    // Only 8 bits lose precision:
+
+                    if (format == PCMFormat::u8) {
+
+                        REQUIRE(std::abs(out.at(i) - input.at(i)) <= 256);
+                    }
+
+                    else if (format == PCMFormat::f32) {
+
+                        REQUIRE(out.at(i) == std::max<int16_t>(input.at(i), -32767));
+                    }
+
+                    else {
+
+                        REQUIRE(out.at(i) == input.at(i));
+                    }
+                }
+            }
+        }
+
+        // 16 bit samples are copied byte for byte:
+
+        std::vector<char> raw(2);
+
+        pcm_encode(PCMFormat::s16, input.data() + 1, raw.data(), 1);
+
+        REQUIRE(static_cast<unsigned char>(raw.at(0)) == 0xC7);
+        REQUIRE(static_cast<unsigned char>(raw.at(1)) == 0xCF);
+    }
+}
@@ -0,0 +1,170 @@
+/**
+ * @file delay_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for delay lines
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include "dsp/delay.hpp"
+
+TEST_CASE("DelayLine Test", "[delay][dsp]") {
+
+    const int block = 16;
+
+    DelayLine<double> line(40, block);
+
+    // Ramp input, so interpolated values are easy to predict:
+
+    std::vector<double> input(block);
+    std::vector<double> output(block);
+
+    double state = 0;
+
+    auto feed = [&](int start) {
+
+        for (int i = 0; i < block; ++i) {
+
+            input[i] = start + i;
+        }
+
+        line.write(input.data(), block);
+    };
+
+    SECTION("Capacity", "Ensures capacity is a power of two with room for the delay and a block") {
+
+        REQUIRE(line.capacity() == 64);
+        REQUIRE(line.get_max_delay() == 40);
+        REQUIRE(line.get_max_block() == block);
+    }
+
+    SECTION("Impulse", "Ensures whole delays move an impulse by the delay") {
+
+        std::vector<double> impulse(block, 0);
+
+        impulse[0] = 1;
+
+        line.write(impulse.data(), block);
+        line.read(output.data(), block, 5.0, DelayInterp::None, block, state);
+
+        for (int i = 0; i < block; ++i) {
+
+            REQUIRE(output[i] == (i == 5 ? 1 : 0));
+        }
+    }
+
+    SECTION("Linear", "Ensures linear interpolation lands between samples") {
+
+        feed(100);
+        feed(100 + block);
+
+        line.read(output.data(), block, 3.25, DelayInterp::Linear, block, state);
+
+        for (int i = 0; i < block; ++i) {
+
+            REQUIRE_THAT(output[i], Catch::Matchers::WithinAbs(100 + block + i - 3.25, 1e-9));
+        }
+    }
+
+    SECTION("Cubic", "Ensures cubic interpolation is exact on ramps and whole delays") {
+
+        feed(100);
+        feed(100 + block);
+
+        line.read(output.data(), block, 7.0, DelayInterp::Cubic, block, state);
+
+        for (int i = 0; i < block; ++i) {
+
+            REQUIRE_THAT(output[i], Catch::Matchers::WithinAbs(100 + block + i - 7, 1e-9));
+        }
+
+        line.read(output.data(), block, 7.6, DelayInterp::Cubic, block, state);
+
+        for (int i = 0; i < block; ++i) {
+
+            REQUIRE_THAT(output[i], Catch::Matchers::WithinAbs(100 + block + i - 7.6, 1e-9));
+        }
+    }
+
+    SECTION("Allpass", "Ensures allpass interpolation converges on ramps") {
+
+        for (int b = 0; b < 4; ++b) {
+
+            feed(b * block);
+
+            line.read(output.data(), block, 4.3, DelayInterp::Allpass, block, state);
+        }
+
+        // Allpass filters delay a ramp by exactly the fractional delay once settled:
+
+        REQUIRE_THAT(output[block - 1], Catch::Matchers::WithinAbs(4 * block - 1 - 4.3, 1e-6));
+    }
+
+    SECTION("Wrap", "Ensures reads are correct across many wraps of the line") {
+
+        for (int b = 0; b < 20; ++b) {
+
+            feed(b * block);
+
+            line.read(output.data(), block, 37.5, DelayInterp::Linear, block, state);
+
+            if (b < 3) {
+
+                continue;
+            }
+
+            for (int i = 0; i < block; ++i) {
+
+                REQUIRE_THAT(output[i], Catch::Matchers::WithinAbs(b * block + i - 37.5, 1e-9));
+            }
+        }
+    }
+
+    SECTION("Gather", "Ensures per sample delays match fixed delays") {
+
+        std::vector<double> delays(block, 9.4);
+        std::vector<double> expected(block);
+
+        for (const DelayInterp interp : {DelayInterp::None, DelayInterp::Linear, DelayInterp::Cubic, DelayInterp::Allpass}) {
+
+            for (int b = 0; b < 6; ++b) {
+
+                feed(b * block * 3);
+
+                double fixed_state = state;
+
+                line.read(expected.data(), block, 9.4, interp, block, fixed_state);
+                line.read(output.data(), block, delays.data(), interp, block, state);
+
+                for (int i = 0; i < block; ++i) {
+
+                    REQUIRE_THAT(output[i], Catch::Matchers::WithinAbs(expected[i], 1e-9));
+                }
+            }
+        }
+    }
+
+    SECTION("Feedback", "Ensures blocks can be read before they are written") {
+
+        feed(100);
+        feed(100 + block);
+
+        // The next block starts at 132, read it before writing:
+
+        line.read(output.data(), block, static_cast<double>(block), DelayInterp::Linear, 0, state);
+
+        for (int i = 0; i < block; ++i) {
+
+            REQUIRE_THAT(output[i], Catch::Matchers::WithinAbs(100 + block + i, 1e-9));
+        }
+    }
+}
@@ -0,0 +1,98 @@
+/**
+ * @file denormal_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for denormal components
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "dsp/denormal.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "dsp/iir.hpp"
+
+TEST_CASE("Denormal Test", "[denormal][dsp]") {
+
+    SECTION("Flush", "Ensures small values are flushed in software") {
+
+        REQUIRE(flush_denormal(1e-31) == 0);
+        REQUIRE(flush_denormal(-1e-31F) == 0);
+        REQUIRE(flush_denormal(1e-29) == 1e-29);
+        REQUIRE(flush_denormal(0.5L) == 0.5L);
+
+        std::vector<double> vals = {1, 1e-40, -1e-35, 0.25};
+
+        flush_denormals(vals);
+
+        REQUIRE(vals == std::vector<double>{1, 0, 0, 0.25});
+    }
+
+#if defined(__x86_64__) || defined(__i386__) || defined(__aarch64__)
+
+    SECTION("Mode", "Ensures the thread mode can be set and restored") {
+
+        const bool before = flush_to_zero();
+
+        {
+            const FlushToZeroScope scope;
+
+            REQUIRE(flush_to_zero());
+
+            // Results that would be denormal become zero:
+
+            volatile float tiny = std::numeric_limits<float>::min();
+            volatile float half = tiny / 4;
+
+            REQUIRE(half == 0);
+        }
+
+        REQUIRE(flush_to_zero() == before);
+
+        REQUIRE(set_flush_to_zero(false) == before);
+        REQUIRE(!flush_to_zero());
+
+        set_flush_to_zero(before);
+    }
+
+#endif
+
+    SECTION("Filter State", "Ensures decayed filter state settles at zero") {
+
+        for (const bool flush : {true, false}) {
+
+            BiquadCascade<long double> filter;
+
+            filter.set_sections(iir_design(IIRPrototype::Butterworth, FilterType::LowPass, 2, 0.01, 0.01));
+            filter.set_flush(flush);
+
+            REQUIRE(filter.get_flush() == flush);
+
+            // Ring the filter, then let it decay:
+
+            std::vector<long double> data(4096, 0);
+
+            data[0] = 1;
+
+            filter.process(data.data(), static_cast<int>(data.size()));
+
+            for (int i = 0; i < 4; ++i) {
+
+                std::ranges::fill(data, 0);
+
+                filter.process(data.data(), static_cast<int>(data.size()));
+            }
+
+            // Only flushed filters reach exactly zero:
+
+            REQUIRE((data.back() == 0) == flush);
+        }
+    }
+}
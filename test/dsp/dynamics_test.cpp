@@ -0,0 +1,140 @@
+/**
+ * @file dynamics_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for dynamics kernels
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "dsp/dynamics.hpp"
+
+TEST_CASE("Dynamics Kernel Test", "[dynamics][dsp]") {
+
+    SECTION("Detect", "Ensures peaks and power are followed over every channel") {
+
+        const std::vector<double> left = {0.5, -0.25, 0, -1};
+        const std::vector<double> right = {-0.75, 0.5, 0.125, 0.5};
+
+        std::vector<double> level(4, 0);
+
+        dyn_peak(left.data(), level.data(), 4);
+        dyn_peak(right.data(), level.data(), 4);
+
+        REQUIRE(level == std::vector<double>{0.75, 0.5, 0.125, 1});
+
+        std::vector<double> power(4, 0);
+
+        dyn_square(left.data(), power.data(), 4, 0.5);
+        dyn_square(right.data(), power.data(), 4, 0.5);
+
+        for (int i = 0; i < 4; ++i) {
+
+            REQUIRE_THAT(power[i], Catch::Matchers::WithinAbs((left[i] * left[i] + right[i] * right[i]) / 2, 1e-12));
+        }
+    }
+
+    SECTION("Curve", "Ensures the gain curve reduces levels above the threshold") {
+
+        const double db = 20 * std::log10(2.0);
+
+        // Levels at 0 dB, -12 dB and -24 dB:
+
+        const std::vector<double> level = {1, 0.25118864315095801, 0.063095734448019331};
+
+        std::vector<double> out(3);
+
+        DynCurve curve;
+
+        curve.threshold = -18;
+        curve.ratio = 4;
+
+        dyn_reduction(level.data(), out.data(), 3, curve, db);
+
+        REQUIRE_THAT(out[0], Catch::Matchers::WithinAbs(-13.5, 1e-5));
+        REQUIRE_THAT(out[1], Catch::Matchers::WithinAbs(-4.5, 1e-5));
+        REQUIRE_THAT(out[2], Catch::Matchers::WithinAbs(0, 1e-12));
+
+        // Infinite ratios hold the level at the threshold:
+
+        curve.ratio = std::numeric_limits<double>::infinity();
+
+        dyn_reduction(level.data(), out.data(), 3, curve, db);
+
+        REQUIRE_THAT(out[0], Catch::Matchers::WithinAbs(-18, 1e-5));
+        REQUIRE_THAT(out[1], Catch::Matchers::WithinAbs(-6, 1e-5));
+
+        // Soft knees bend the curve around the threshold:
+
+        curve.ratio = 4;
+        curve.threshold = -12;
+        curve.knee = 6;
+
+        dyn_reduction(level.data(), out.data(), 3, curve, db);
+
+        REQUIRE_THAT(out[0], Catch::Matchers::WithinAbs(-9, 1e-5));
+        REQUIRE_THAT(out[1], Catch::Matchers::WithinAbs(-0.75 * 9 / 12, 1e-5));
+        REQUIRE_THAT(out[2], Catch::Matchers::WithinAbs(0, 1e-12));
+    }
+
+    SECTION("Smooth", "Ensures falling values attack and rising values release") {
+
+        std::vector<double> data = {-10, -10, 0, 0};
+
+        double state = 0;
+
+        dyn_smooth(data.data(), 4, 0.5, 0.75, state);
+
+        REQUIRE_THAT(data[0], Catch::Matchers::WithinAbs(-5, 1e-12));
+        REQUIRE_THAT(data[1], Catch::Matchers::WithinAbs(-7.5, 1e-12));
+        REQUIRE_THAT(data[2], Catch::Matchers::WithinAbs(-5.625, 1e-12));
+        REQUIRE_THAT(data[3], Catch::Matchers::WithinAbs(-4.21875, 1e-12));
+        REQUIRE(state == data[3]);
+
+        REQUIRE_THAT(dyn_coefficient(0.001, 1000), Catch::Matchers::WithinAbs(std::exp(-1.0), 1e-12));
+        REQUIRE(dyn_coefficient(0, 1000) == 0);
+    }
+
+    SECTION("Gain", "Ensures gains are converted from dB and applied") {
+
+        const std::vector<double> db = {0, -20 * std::log10(2.0), -26};
+
+        std::vector<double> gain(3);
+
+        dyn_gain(db.data(), gain.data(), 3, 6);
+
+        REQUIRE_THAT(gain[0], Catch::Matchers::WithinRel(std::pow(10, 0.3), 1e-6));
+        REQUIRE_THAT(gain[1], Catch::Matchers::WithinRel(std::pow(10, 0.3) / 2, 1e-6));
+        REQUIRE_THAT(gain[2], Catch::Matchers::WithinRel(0.1, 1e-6));
+
+        std::vector<double> data = {1, 2, -3};
+
+        dyn_apply(data.data(), gain.data(), 3);
+
+        REQUIRE_THAT(data[2], Catch::Matchers::WithinRel(-0.3, 1e-6));
+    }
+
+    SECTION("Hold", "Ensures each value is the largest of its window") {
+
+        PeakHold<double> hold(3);
+
+        std::vector<double> data = {0, 5, 1, 2, 0, 0, 3, 4, 1, 0, 0};
+        const std::vector<double> expected = {0, 5, 5, 5, 2, 2, 3, 4, 4, 4, 1};
+
+        // Split over two blocks, the window carries across:
+
+        hold.process(data.data(), 4);
+        hold.process(data.data() + 4, 7);
+
+        REQUIRE(data == expected);
+    }
+}
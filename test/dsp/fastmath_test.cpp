@@ -0,0 +1,118 @@
+/**
+ * @file fastmath_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for fast math approximations
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+#include <limits>
+
+#include "dsp/denormal.hpp"
+#include "dsp/fastmath.hpp"
+
+/**
+ * @brief Ensures each function is within its documented error bound
+ *
+ * @tparam A Accuracy to test
+ * @param sin_err Maximum absolute error of sine
+ * @param exp_err Maximum relative error of exp2
+ * @param log_err Maximum absolute error of log2
+ * @param tanh_err Maximum absolute error of tanh
+ */
+template <MathAccuracy A>
+void check_bounds(double sin_err, double exp_err, double log_err, double tanh_err) {
+
+    const int points = 20000;
+
+    for (int i = 0; i <= points; ++i) {
+
+        const double turn = -2 + 4.0 * i / points;
+
+        REQUIRE_THAT(fast_sin_turns<A>(turn), Catch::Matchers::WithinAbs(std::sin(2 * M_PI * turn), sin_err));
+        REQUIRE_THAT(fast_cos_turns<A>(turn), Catch::Matchers::WithinAbs(std::cos(2 * M_PI * turn), sin_err));
+
+        const double x = -40 + 80.0 * i / points;
+
+        REQUIRE_THAT(fast_exp2<A>(x) / std::exp2(x), Catch::Matchers::WithinAbs(1, exp_err));
+
+        const double pos = 1e-3 * std::pow(1e6, static_cast<double>(i) / points);
+
+        REQUIRE_THAT(fast_log2<A>(pos), Catch::Matchers::WithinAbs(std::log2(pos), log_err));
+
+        const double t = -8 + 16.0 * i / points;
+
+        REQUIRE_THAT(fast_tanh<A>(t), Catch::Matchers::WithinAbs(std::tanh(t), tanh_err));
+    }
+}
+
+TEST_CASE("Fast Math Test", "[fastmath][dsp]") {
+
+    SECTION("Low", "Ensures low accuracy functions are within bounds") {
+
+        check_bounds<MathAccuracy::Low>(6.9e-5, 7.6e-5, 5.6e-6, 9.7e-5);
+    }
+
+    SECTION("Medium", "Ensures medium accuracy functions are within bounds") {
+
+        check_bounds<MathAccuracy::Medium>(6.0e-7, 7.7e-8, 3.0e-8, 4.0e-8);
+    }
+
+    SECTION("High", "Ensures high accuracy functions are within bounds") {
+
+        check_bounds<MathAccuracy::High>(2.7e-11, 4.2e-11, 2.1e-12, 1.7e-10);
+    }
+
+    SECTION("Float", "Ensures float versions match double versions") {
+
+        for (int i = 0; i <= 1000; ++i) {
+
+            const float x = -4 + 8.0F * static_cast<float>(i) / 1000;
+
+            REQUIRE_THAT(fast_exp2(x), Catch::Matchers::WithinRel(fast_exp2(static_cast<double>(x)), 1e-6));
+            REQUIRE_THAT(fast_sin_turns(x), Catch::Matchers::WithinAbs(fast_sin_turns(static_cast<double>(x)), 1e-6));
+            REQUIRE_THAT(fast_tanh(x), Catch::Matchers::WithinAbs(fast_tanh(static_cast<double>(x)), 1e-6));
+
+            if (x > 0) {
+
+                REQUIRE_THAT(fast_log2(x), Catch::Matchers::WithinAbs(fast_log2(static_cast<double>(x)), 1e-6));
+            }
+        }
+    }
+
+    SECTION("Range", "Ensures exponents are clamped to normal numbers") {
+
+        REQUIRE(fast_exp2(-1000.0F) >= std::numeric_limits<float>::min());
+        REQUIRE(fast_exp2(-1000.0) >= std::numeric_limits<double>::min());
+        REQUIRE(fast_exp2<MathAccuracy::Low>(-1000.0F) >= std::numeric_limits<float>::min());
+
+        // Small values must survive denormals being flushed:
+
+        {
+            const FlushToZeroScope scope;
+
+            REQUIRE(fast_exp2(-1000.0F) > 0);
+        }
+        REQUIRE(std::isfinite(fast_exp2(1000.0F)));
+        REQUIRE(fast_tanh(100.0F) == 1);
+        REQUIRE(fast_tanh(-100.0F) == -1);
+        REQUIRE(fast_log2(1.0) == 0);
+    }
+
+    SECTION("Table", "Ensures the sine table is within bounds") {
+
+        for (int i = 0; i <= 20000; ++i) {
+
+            const double turn = -2 + 4.0 * i / 20000;
+
+            REQUIRE_THAT(sine_table_turns(turn), Catch::Matchers::WithinAbs(std::sin(2 * M_PI * turn), 3.3e-7));
+        }
+    }
+}
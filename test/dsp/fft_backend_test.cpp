@@ -0,0 +1,148 @@
+/**
+ * @file fft_backend_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for the FFT backend
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+#include <complex>
+#include <string>
+#include <vector>
+
+#include "audio_buffer.hpp"
+#include "dsp/fft_backend.hpp"
+
+TEST_CASE("FFTBackend Test", "[ft][dsp]") {
+
+    const int size = 48;
+
+    // Create some data to transform:
+
+    std::vector<std::complex<long double>> idata(size);
+
+    for (int i = 0; i < size; ++i) {
+
+        idata.at(i) = std::complex<long double>(std::sin(i * 0.3L), std::cos(i * 0.7L));
+    }
+
+    FFTBackend<long double> backend(size);
+
+    SECTION("Name", "Ensures the backend is named") {
+
+        const std::string name = FFTBackend<long double>::name();
+
+        REQUIRE((name == "fftw" || name == "maec"));
+        REQUIRE(backend.size() == size);
+    }
+
+    SECTION("Forward", "Ensures the forward transform matches the in-tree plan") {
+
+        std::vector<std::complex<long double>> out(size);
+        std::vector<std::complex<long double>> expected(size);
+
+        backend.forward(idata.data(), out.data());
+
+        FFTPlan<long double>(size).forward(idata.begin(), expected.begin());
+
+        for (int i = 0; i < size; ++i) {
+
+            REQUIRE_THAT(out.at(i).real(), Catch::Matchers::WithinAbs(expected.at(i).real(), 1e-10));
+            REQUIRE_THAT(out.at(i).imag(), Catch::Matchers::WithinAbs(expected.at(i).imag(), 1e-10));
+        }
+    }
+
+    SECTION("In Place", "Ensures in place transforms can be inverted") {
+
+        std::vector<std::complex<long double>> data(idata);
+
+        backend.forward(data.data(), data.data());
+        backend.inverse(data.data(), data.data());
+
+        for (int i = 0; i < size; ++i) {
+
+            REQUIRE_THAT(data.at(i).real(), Catch::Matchers::WithinAbs(idata.at(i).real(), 1e-10));
+            REQUIRE_THAT(data.at(i).imag(), Catch::Matchers::WithinAbs(idata.at(i).imag(), 1e-10));
+        }
+    }
+}
+
+TEST_CASE("RealFFTBackend Test", "[ft][dsp]") {
+
+    const int size = 64;
+
+    // Create some data to transform:
+
+    std::vector<long double> idata(size);
+
+    for (int i = 0; i < size; ++i) {
+
+        idata.at(i) = std::sin(i * 0.3L) + std::cos(i * 0.05L);
+    }
+
+    RealFFTBackend<long double> backend(size);
+
+    SECTION("Forward", "Ensures the real transform matches the complex transform") {
+
+        std::vector<std::complex<long double>> out(size / 2 + 1);
+        std::vector<std::complex<long double>> expected(idata.begin(), idata.end());
+
+        backend.forward(idata.data(), out.data());
+
+        FFTBackend<long double>(size).forward(expected.data(), expected.data());
+
+        for (int i = 0; i <= size / 2; ++i) {
+
+            REQUIRE_THAT(out.at(i).real(), Catch::Matchers::WithinAbs(expected.at(i).real(), 1e-10));
+            REQUIRE_THAT(out.at(i).imag(), Catch::Matchers::WithinAbs(expected.at(i).imag(), 1e-10));
+        }
+    }
+
+    SECTION("Inverse", "Ensures the real transform can be inverted") {
+
+        std::vector<std::complex<long double>> spec(size / 2 + 1);
+        std::vector<long double> out(size);
+
+        backend.forward(idata.data(), spec.data());
+        backend.inverse(spec.data(), out.data());
+
+        for (int i = 0; i < size; ++i) {
+
+            REQUIRE_THAT(out.at(i), Catch::Matchers::WithinAbs(idata.at(i), 1e-10));
+        }
+    }
+
+    SECTION("Sample Precision", "Ensures the backend for sample_t matches the long double backend") {
+
+        const std::vector<sample_t> sdata(idata.begin(), idata.end());
+
+        std::vector<std::complex<long double>> expected(size / 2 + 1);
+        std::vector<std::complex<sample_t>> spec(size / 2 + 1);
+        std::vector<sample_t> out(size);
+
+        RealFFTBackend<sample_t> sbackend(size);
+
+        backend.forward(idata.data(), expected.data());
+        sbackend.forward(sdata.data(), spec.data());
+
+        for (int i = 0; i <= size / 2; ++i) {
+
+            REQUIRE_THAT(spec.at(i).real(), Catch::Matchers::WithinAbs(expected.at(i).real(), 1e-4));
+            REQUIRE_THAT(spec.at(i).imag(), Catch::Matchers::WithinAbs(expected.at(i).imag(), 1e-4));
+        }
+
+        sbackend.inverse(spec.data(), out.data());
+
+        for (int i = 0; i < size; ++i) {
+
+            REQUIRE_THAT(out.at(i), Catch::Matchers::WithinAbs(sdata.at(i), 1e-5));
+        }
+    }
+}
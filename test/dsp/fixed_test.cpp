@@ -0,0 +1,219 @@
+/**
+ * @file fixed_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for fixed point kernels
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "dsp/fixed.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "dsp/const.hpp"
+#include "dsp/iir.hpp"
+
+// Size of each test block, not a multiple of the vector width
+const int fixed_test_size = 1001;
+
+TEST_CASE("Fixed Point Test", "[fixed][dsp]") {
+
+    SECTION("Conversion", "Ensures values are converted and saturated") {
+
+        REQUIRE(to_q15(0.5) == 16384);
+        REQUIRE(to_q15(-1.0) == -32768);
+        REQUIRE(to_q15(1.0) == 32767);
+        REQUIRE(to_q15(4.0) == 32767);
+        REQUIRE(to_q31(-1.0) == -2147483647 - 1);
+        REQUIRE(to_q31(1.0) == 2147483647);
+
+        REQUIRE(from_q15(16384) == 0.5);
+        REQUIRE(from_q31(-1073741824) == -0.5);
+
+        REQUIRE(q15_mul(16384, 16384) == 8192);
+        REQUIRE(q15_mul(-32768, -32768) == 32767);
+        REQUIRE(q31_mul(to_q31(0.5), to_q31(-0.5)) == to_q31(-0.25));
+    }
+
+    SECTION("Gain", "Ensures blocks are scaled and saturated") {
+
+        std::vector<q15_t> data(fixed_test_size);
+        std::vector<q31_t> wide(fixed_test_size);
+
+        for (int i = 0; i < fixed_test_size; ++i) {
+
+            data.at(i) = static_cast<q15_t>(i * 50 - 20000);
+            wide.at(i) = static_cast<q31_t>(data.at(i)) * 65536;
+        }
+
+        const std::vector<q15_t> orig = data;
+
+        // 0.75 * 2 is a gain of 1.5:
+
+        fixed_gain(data.data(), fixed_test_size, to_q15(0.75), 1);
+        fixed_gain(wide.data(), fixed_test_size, to_q31(0.75), 1);
+
+        for (int i = 0; i < fixed_test_size; ++i) {
+
+            const q15_t expected = q15_saturate(static_cast<int64_t>(q15_mul(orig.at(i), to_q15(0.75))) * 2);
+
+            REQUIRE(data.at(i) == expected);
+            REQUIRE(std::abs(wide.at(i) / 65536 - expected) <= 1);
+        }
+
+        // Large values should clip:
+
+        REQUIRE(data.front() == -30000);
+        REQUIRE(data.back() == 32767);
+    }
+
+    SECTION("Mix", "Ensures blocks are added and saturated") {
+
+        std::vector<q15_t> out(fixed_test_size, 30000);
+        std::vector<q15_t> in(fixed_test_size);
+
+        for (int i = 0; i < fixed_test_size; ++i) {
+
+            in.at(i) = static_cast<q15_t>(i * 4);
+        }
+
+        std::vector<q15_t> scaled = out;
+        std::vector<q31_t> wide(fixed_test_size, 30000 * 65536);
+        std::vector<q31_t> win(fixed_test_size);
+
+        for (int i = 0; i < fixed_test_size; ++i) {
+
+            win.at(i) = static_cast<q31_t>(in.at(i)) * 65536;
+        }
+
+        fixed_mix_add(out.data(), in.data(), fixed_test_size);
+        fixed_mix_add(scaled.data(), in.data(), fixed_test_size, to_q15(0.5));
+        fixed_mix_add(wide.data(), win.data(), fixed_test_size);
+
+        for (int i = 0; i < fixed_test_size; ++i) {
+
+            REQUIRE(out.at(i) == std::min(30000 + i * 4, 32767));
+            REQUIRE(scaled.at(i) == std::min(30000 + i * 2, 32767));
+            REQUIRE(wide.at(i) == q31_saturate((30000 + int64_t{i} * 4) * 65536));
+        }
+    }
+
+    SECTION("Biquad", "Ensures the fixed point section follows the floating point one") {
+
+        const BiquadCoefficients<double> coeff = biquad_design(FilterType::LowPass, 0.05);
+
+        const FixedBiquad fixed = fixed_biquad(coeff);
+
+        std::vector<double> in(fixed_test_size);
+        std::vector<q15_t> fin(fixed_test_size);
+
+        for (int i = 0; i < fixed_test_size; ++i) {
+
+            in.at(i) = 0.5 * std::sin(i * 0.03) + 0.25 * std::sin(i * 1.3);
+            fin.at(i) = to_q15(in.at(i));
+        }
+
+        std::vector<double> out(fixed_test_size);
+        std::vector<q15_t> fout(fixed_test_size);
+
+        double state[2] = {0, 0};
+        int32_t fstate[4] = {0, 0, 0, 0};
+
+        biquad_process(coeff, state, in.data(), fixed_test_size, out.data());
+
+        // Process in two blocks to check the state is carried:
+
+        fixed_biquad_process(fixed, fstate, fin.data(), 500, fout.data());
+        fixed_biquad_process(fixed, fstate, fin.data() + 500, fixed_test_size - 500, fout.data() + 500);
+
+        for (int i = 0; i < fixed_test_size; ++i) {
+
+            REQUIRE(std::abs(from_q15(fout.at(i)) - out.at(i)) < 0.01);
+        }
+    }
+
+    SECTION("Dot", "Ensures dot products are accumulated without overflow") {
+
+        std::vector<q15_t> one(fixed_test_size, -32768);
+        std::vector<q15_t> two(fixed_test_size, -32768);
+
+        REQUIRE(fixed_dot(one.data(), two.data(), fixed_test_size) == int64_t{fixed_test_size} << 30);
+
+        two.at(7) = 100;
+
+        REQUIRE(fixed_dot(one.data(), two.data(), fixed_test_size) == (int64_t{fixed_test_size - 1} << 30) - 3276800);
+    }
+
+    SECTION("FIR", "Ensures the fixed point FIR matches direct convolution") {
+
+        const std::vector<q15_t> kernel = {to_q15(0.5), to_q15(0.25), to_q15(-0.125), to_q15(0.0625)};
+
+        std::vector<q15_t> in(fixed_test_size);
+
+        for (int i = 0; i < fixed_test_size; ++i) {
+
+            in.at(i) = static_cast<q15_t>((i * 7919) % 20000 - 10000);
+        }
+
+        FixedFIR fir(kernel, 128);
+
+        REQUIRE(fir.size() == 4);
+
+        // Process in uneven blocks, in place:
+
+        std::vector<q15_t> out = in;
+
+        for (int start = 0; start < fixed_test_size; start += 300) {
+
+            const int num = std::min(300, fixed_test_size - start);
+
+            fir.process(out.data() + start, num, out.data() + start);
+        }
+
+        for (int i = 0; i < fixed_test_size; ++i) {
+
+            int64_t sum = 0;
+
+            for (int k = 0; k < 4 && k <= i; ++k) {
+
+                sum += static_cast<int64_t>(kernel.at(k)) * in.at(i - k);
+            }
+
+            REQUIRE(out.at(i) == q15_saturate((sum + (1 << 14)) >> 15));
+        }
+
+        // Reset should clear the history:
+
+        fir.reset();
+
+        std::vector<q15_t> impulse(4, 0);
+        impulse.at(0) = 32767;
+
+        fir.process(impulse.data(), 4, impulse.data());
+
+        REQUIRE(impulse.at(0) == q15_mul(32767, kernel.at(0)));
+        REQUIRE(impulse.at(3) == q15_mul(32767, kernel.at(3)));
+    }
+
+    SECTION("Buffer", "Ensures fixed point buffers can be used like audio buffers") {
+
+        Q15Buffer buff(64, 2);
+
+        REQUIRE(buff.size() == 128);
+
+        buff.at(1, 3) = 1000;
+
+        REQUIRE(buff.at(1, 3) == 1000);
+
+        fixed_gain(buff.data(), static_cast<int>(buff.size()), to_q15(0.5));
+
+        REQUIRE(buff.at(1, 3) == 500);
+    }
+}
@@ -546,9 +546,13 @@ TEST_CASE("FFT2", "[ft][dsp]") {
 
             std::vector<long double> out(osize);
 
+            // The inverse works in place on its input, so give it a copy:
+
+            std::vector<std::complex<long double>> spec(ft2_output);
+
             // Send data through real iFFT function:
 
-            ifft_r_radix2(ft2_output.begin(), size, out.begin());
+            ifft_r_radix2(spec.begin(), size, out.begin());
 
             // Ensure output matches input:
 
@@ -561,3 +565,160 @@ TEST_CASE("FFT2", "[ft][dsp]") {
         }
     }
 }
+
+TEST_CASE("FFTPlan", "[ft][dsp]") {
+
+    SECTION("Factors", "Ensures sizes are factored into the correct stages") {
+
+        REQUIRE(FFTPlan<>(64).get_factors() == std::vector<int>{4, 4, 4});
+        REQUIRE(FFTPlan<>(32).get_factors() == std::vector<int>{4, 4, 2});
+        REQUIRE(FFTPlan<>(60).get_factors() == std::vector<int>{4, 3, 5});
+        REQUIRE(FFTPlan<>(49).get_factors() == std::vector<int>{7, 7});
+    }
+
+    SECTION("Known", "Ensures the plan works on known data") {
+
+        FFTPlan<> plan(static_cast<int>(cft_data.size()));
+
+        std::vector<std::complex<long double>> out(cft_data.size());
+
+        plan.forward(cft_data.begin(), out.begin());
+
+        for (std::size_t i = 0; i < out.size(); ++i) {
+
+            compare_complex(out.at(i), cft_output.at(i));
+        }
+    }
+
+    SECTION("Random", "Ensures the plan matches a naive DFT for many sizes") {
+
+        for (int size : {1, 2, 3, 4, 5, 6, 7, 8, 12, 15, 16, 30, 49, 60, 64, 100, 128, 1000}) {
+
+            std::vector<std::complex<long double>> idata(size);
+
+            rand_complex(size, idata.begin());
+
+            // Compute the naive DFT:
+
+            std::vector<std::complex<long double>> expected(size);
+
+            for (int k = 0; k < size; ++k) {
+
+                for (int i = 0; i < size; ++i) {
+
+                    expected.at(k) += idata.at(i) * twiddle<long double>((k * i) % size, size);
+                }
+            }
+
+            // Compute via the plan, in place:
+
+            FFTPlan<> plan(size);
+
+            std::vector<std::complex<long double>> out(idata);
+
+            plan.forward(out.begin(), out.begin());
+
+            for (int i = 0; i < size; ++i) {
+
+                compare_complex(out.at(i), expected.at(i));
+            }
+
+            // Ensure we can invert:
+
+            plan.inverse(out.begin(), out.begin());
+
+            for (int i = 0; i < size; ++i) {
+
+                compare_complex(out.at(i), idata.at(i));
+            }
+        }
+    }
+
+    SECTION("Float", "Ensures the plan works with single precision") {
+
+        FFTPlan<float> plan(48);
+
+        std::vector<std::complex<float>> idata(48);
+
+        for (int i = 0; i < 48; ++i) {
+
+            idata.at(i) = std::complex<float>(std::sin(i * 0.3F), std::cos(i * 0.7F));
+        }
+
+        std::vector<std::complex<float>> out(48);
+
+        plan.forward(idata.begin(), out.begin());
+        plan.inverse(out.begin(), out.begin());
+
+        for (int i = 0; i < 48; ++i) {
+
+            REQUIRE_THAT(out.at(i).real(), Catch::Matchers::WithinAbs(idata.at(i).real(), 1e-5));
+            REQUIRE_THAT(out.at(i).imag(), Catch::Matchers::WithinAbs(idata.at(i).imag(), 1e-5));
+        }
+    }
+}
+
+TEST_CASE("RealFFTPlan", "[ft][dsp]") {
+
+    SECTION("Known", "Ensures the plan works on known data") {
+
+        const int size = static_cast<int>(ft2_data.size());
+
+        RealFFTPlan<> plan(size);
+
+        // Keep our own copy of the expected spectrum:
+
+        const std::vector<std::complex<long double>> expected(ft2_output);
+
+        std::vector<std::complex<long double>> out(length_ft(size));
+
+        plan.forward(ft2_data.data(), out.data());
+
+        for (std::size_t i = 0; i < out.size(); ++i) {
+
+            compare_complex(out.at(i), expected.at(i));
+        }
+    }
+
+    SECTION("Random", "Ensures the plan matches the complex FFT for many sizes") {
+
+        for (int size : {2, 4, 6, 10, 16, 24, 30, 64, 100, 256, 1000}) {
+
+            std::vector<long double> idata(size);
+
+            rand_real(size, idata.begin());
+
+            // Compute the expected spectrum via the complex plan:
+
+            std::vector<std::complex<long double>> expected(idata.begin(), idata.end());
+
+            FFTPlan<>(size).forward(expected.begin(), expected.begin());
+
+            // Compute the real FFT in place:
+
+            RealFFTPlan<> plan(size);
+
+            std::vector<long double> data(size + 2);
+
+            std::copy(idata.begin(), idata.end(), data.begin());
+
+            auto* spec = reinterpret_cast<std::complex<long double>*>(data.data());
+
+            plan.forward(data.data(), spec);
+
+            for (int i = 0; i <= size / 2; ++i) {
+
+                compare_complex(spec[i], expected.at(i));
+            }
+
+            // Ensure we can invert in place:
+
+            plan.inverse(spec, data.data());
+
+            for (int i = 0; i < size; ++i) {
+
+                REQUIRE_THAT(data.at(i), Catch::Matchers::WithinAbs(idata.at(i), 1e-10));
+            }
+        }
+    }
+}
@@ -0,0 +1,116 @@
+/**
+ * @file goertzel_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for Goertzel resonators
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+#include <complex>
+#include <numbers>
+#include <vector>
+
+#include "dsp/goertzel.hpp"
+
+TEST_CASE("Goertzel Test", "[goertzel][dsp]") {
+
+    const double rate = 8000;
+    const int window = 400;
+
+    // Frequencies that complete whole periods in the window:
+
+    const std::vector<double> freqs = {400, 1000, 1020, 2500};
+
+    std::vector<float> sine(window * 2);
+
+    for (int i = 0; i < window * 2; ++i) {
+
+        sine[i] = static_cast<float>(0.5 * std::sin(2 * std::numbers::pi * 1000 * i / rate));
+    }
+
+    SECTION("Kernel", "Ensures the kernel matches the DFT of a frequency") {
+
+        const int num = 64;
+        const double w = 2 * std::numbers::pi * 5 / num;
+
+        std::vector<double> data(num);
+
+        for (int i = 0; i < num; ++i) {
+
+            data[i] = std::cos(0.3 * i) + 0.25 * std::sin(1.7 * i);
+        }
+
+        std::complex<double> ref = 0;
+
+        for (int i = 0; i < num; ++i) {
+
+            ref += data[i] * std::polar(1.0, -w * i);
+        }
+
+        double coeff = 2 * std::cos(w);
+        double first = 0;
+        double second = 0;
+
+        goertzel_run(&coeff, &first, &second, 1, data.data(), num);
+
+        const double power = first * first + second * second - coeff * first * second;
+
+        REQUIRE_THAT(std::sqrt(power), Catch::Matchers::WithinRel(std::abs(ref), 1e-9));
+    }
+
+    SECTION("Bank", "Ensures each frequency is measured over a window") {
+
+        GoertzelBank bank(freqs, rate, window);
+
+        REQUIRE(bank.bins() == 4);
+        REQUIRE(bank.get_window() == window);
+
+        // Feed a partial window:
+
+        REQUIRE(bank.process(sine.data(), 100) == 0);
+        REQUIRE(bank.get_filled() == 100);
+
+        // Finish the window, and start the next:
+
+        REQUIRE(bank.process(sine.data() + 100, window) == 1);
+        REQUIRE(bank.get_filled() == 100);
+
+        const auto& mag = bank.magnitudes();
+
+        REQUIRE_THAT(mag[1], Catch::Matchers::WithinAbs(0.5, 1e-3));
+        REQUIRE(mag[0] < 1e-3);
+        REQUIRE(mag[2] < 1e-3);
+        REQUIRE(mag[3] < 1e-3);
+
+        bank.reset();
+
+        REQUIRE(bank.get_filled() == 0);
+        REQUIRE_THAT(bank.magnitudes()[1], Catch::Matchers::WithinAbs(0.5, 1e-3));
+    }
+
+    SECTION("Stride", "Ensures interleaved channels can be measured") {
+
+        std::vector<double> frames(window * 2, 0);
+
+        for (int i = 0; i < window; ++i) {
+
+            frames[i * 2 + 1] = sine[i];
+        }
+
+        GoertzelBank left(freqs, rate, window);
+        GoertzelBank right(freqs, rate, window);
+
+        REQUIRE(left.process(frames.data(), window, 2) == 1);
+        REQUIRE(right.process(frames.data() + 1, window, 2) == 1);
+
+        REQUIRE(left.magnitudes()[1] < 1e-9);
+        REQUIRE_THAT(right.magnitudes()[1], Catch::Matchers::WithinAbs(0.5, 1e-3));
+    }
+}
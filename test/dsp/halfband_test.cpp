@@ -0,0 +1,112 @@
+/**
+ * @file halfband_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for half-band filters
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include "dsp/halfband.hpp"
+
+// Side taps used in tests
+const int halfband_taps = 16;
+
+TEST_CASE("Halfband Test", "[halfband][dsp]") {
+
+    HalfbandFIR<double> filter(halfband_taps);
+
+    const int delay = filter.delay();
+
+    SECTION("Kernel", "Ensures the side taps are symmetric and sum to half") {
+
+        const auto& coeffs = filter.get_coeffs();
+
+        REQUIRE(filter.get_taps() == halfband_taps);
+        REQUIRE(delay == halfband_taps - 1);
+
+        double sum = 0;
+
+        for (int k = 0; k < halfband_taps; ++k) {
+
+            REQUIRE_THAT(coeffs.at(k), Catch::Matchers::WithinAbs(coeffs.at(halfband_taps - 1 - k), 1e-12));
+            REQUIRE(coeffs.at(k) != 0);
+
+            sum += coeffs.at(k);
+        }
+
+        REQUIRE_THAT(sum, Catch::Matchers::WithinAbs(0.5, 1e-12));
+
+        // Odd taps are rounded up:
+
+        REQUIRE(HalfbandFIR<double>(7).get_taps() == 8);
+    }
+
+    SECTION("Interpolate", "Ensures a slow sine is doubled in rate") {
+
+        const double freq = 0.02;
+
+        std::vector<double> input(256);
+
+        for (int i = 0; i < input.size(); ++i) {
+
+            input.at(i) = std::sin(2 * M_PI * freq * i);
+        }
+
+        // Process in uneven blocks:
+
+        std::vector<double> output(input.size() * 2);
+
+        filter.interpolate(input.data(), 100, output.data());
+        filter.interpolate(input.data() + 100, 156, output.data() + 200);
+
+        // Output m sits at input position (m - delay) / 2:
+
+        for (int m = 2 * delay; m < output.size(); ++m) {
+
+            REQUIRE_THAT(output.at(m), Catch::Matchers::WithinAbs(std::sin(M_PI * freq * (m - delay)), 1e-3));
+        }
+    }
+
+    SECTION("Decimate", "Ensures slow sines are kept and fast sines are removed") {
+
+        std::vector<double> slow(512);
+        std::vector<double> fast(512);
+
+        for (int i = 0; i < slow.size(); ++i) {
+
+            slow.at(i) = std::sin(2 * M_PI * 0.01 * i);
+            fast.at(i) = std::sin(2 * M_PI * 0.4 * i);
+        }
+
+        std::vector<double> out(256);
+
+        filter.decimate(slow.data(), 128, out.data());
+        filter.decimate(slow.data() + 256, 128, out.data() + 128);
+
+        // Output n sits at input position 2n - delay:
+
+        for (int n = delay; n < out.size(); ++n) {
+
+            REQUIRE_THAT(out.at(n), Catch::Matchers::WithinAbs(std::sin(2 * M_PI * 0.01 * (2 * n - delay)), 1e-3));
+        }
+
+        // Fast sines are above the new Nyquist frequency:
+
+        filter.reset();
+        filter.decimate(fast.data(), 256, out.data());
+
+        for (int n = delay; n < out.size(); ++n) {
+
+            REQUIRE(std::fabs(out.at(n)) < 1e-2);
+        }
+    }
+}
@@ -0,0 +1,306 @@
+/**
+ * @file iir_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for IIR components
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "dsp/iir.hpp"
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+/**
+ * @brief Determines the gain of a cascade at a frequency
+ *
+ * @tparam T Type of the cascade
+ * @param filter Cascade to evaluate
+ * @param frac Frequency as a fraction of the sample rate
+ * @return double Magnitude of the response
+ */
+template <typename T>
+double cascade_gain(const BiquadCascade<T>& filter, double frac) {
+
+    const std::complex<double> zi = std::polar(1.0, -2 * M_PI * frac);
+
+    std::complex<double> total = 1;
+
+    for (int i = 0; i < filter.num_sections(); ++i) {
+
+        const auto& sec = filter.get_section(i);
+
+        total *= (sec.b0 + sec.b1 * zi + sec.b2 * zi * zi) / (1.0 + sec.a1 * zi + sec.a2 * zi * zi);
+    }
+
+    return std::abs(total);
+}
+
+TEST_CASE("IIR Test", "[iir][dsp]") {
+
+    SECTION("Butterworth Low Pass", "Ensures low pass Butterworth filters are designed correctly") {
+
+        for (const int order : {1, 2, 3, 4, 5, 8}) {
+
+            ButterworthFilter<double> filter;
+
+            filter.set_type(FilterType::LowPass);
+            filter.set_order(order);
+            filter.set_frac_high(0.1);
+            filter.generate_coefficients();
+
+            REQUIRE(filter.num_sections() == (order + 1) / 2);
+
+            REQUIRE_THAT(cascade_gain(filter, 0), Catch::Matchers::WithinAbs(1, 1e-9));
+            REQUIRE_THAT(cascade_gain(filter, 0.1), Catch::Matchers::WithinAbs(std::sqrt(0.5), 1e-6));
+            REQUIRE(cascade_gain(filter, 0.4) < std::pow(0.5, order));
+        }
+    }
+
+    SECTION("Butterworth High Pass", "Ensures high pass Butterworth filters are designed correctly") {
+
+        ButterworthFilter<double> filter;
+
+        filter.set_type(FilterType::HighPass);
+        filter.set_order(5);
+        filter.set_frac_low(0.2);
+        filter.generate_coefficients();
+
+        REQUIRE_THAT(cascade_gain(filter, 0.5), Catch::Matchers::WithinAbs(1, 1e-9));
+        REQUIRE_THAT(cascade_gain(filter, 0.2), Catch::Matchers::WithinAbs(std::sqrt(0.5), 1e-6));
+        REQUIRE(cascade_gain(filter, 0.01) < 1e-6);
+    }
+
+    SECTION("Butterworth Band", "Ensures band Butterworth filters are designed correctly") {
+
+        ButterworthFilter<double> filter;
+
+        filter.set_type(FilterType::BandPass);
+        filter.set_order(3);
+        filter.set_frac_low(0.1);
+        filter.set_frac_high(0.2);
+        filter.generate_coefficients();
+
+        REQUIRE(filter.num_sections() == 3);
+
+        REQUIRE_THAT(cascade_gain(filter, 0.1), Catch::Matchers::WithinAbs(std::sqrt(0.5), 1e-6));
+        REQUIRE_THAT(cascade_gain(filter, 0.2), Catch::Matchers::WithinAbs(std::sqrt(0.5), 1e-6));
+        REQUIRE(cascade_gain(filter, 0.01) < 1e-3);
+        REQUIRE(cascade_gain(filter, 0.45) < 1e-3);
+
+        filter.set_type(FilterType::BandReject);
+        filter.generate_coefficients();
+
+        REQUIRE_THAT(cascade_gain(filter, 0), Catch::Matchers::WithinAbs(1, 1e-9));
+        REQUIRE_THAT(cascade_gain(filter, 0.5), Catch::Matchers::WithinAbs(1, 1e-9));
+        REQUIRE_THAT(cascade_gain(filter, 0.1), Catch::Matchers::WithinAbs(std::sqrt(0.5), 1e-6));
+        REQUIRE(cascade_gain(filter, std::atan(std::sqrt(std::tan(M_PI * 0.1) * std::tan(M_PI * 0.2))) / M_PI) < 1e-6);
+    }
+
+    SECTION("Chebyshev", "Ensures Chebyshev filters ripple within the pass band") {
+
+        for (const int order : {3, 4}) {
+
+            ChebyshevFilter<double> filter;
+
+            filter.set_type(FilterType::LowPass);
+            filter.set_order(order);
+            filter.set_ripple(1);
+            filter.set_frac_high(0.1);
+            filter.generate_coefficients();
+
+            const double floor = std::pow(10, -1.0 / 20);
+
+            for (double frac = 0; frac <= 0.1; frac += 0.001) {
+
+                const double gain = cascade_gain(filter, frac);
+
+                REQUIRE(gain < 1 + 1e-9);
+                REQUIRE(gain > floor - 1e-9);
+            }
+
+            REQUIRE_THAT(cascade_gain(filter, 0.1), Catch::Matchers::WithinAbs(floor, 1e-6));
+
+            // Sharper than a Butterworth of the same order:
+
+            ButterworthFilter<double> butter;
+
+            butter.set_order(order);
+            butter.set_frac_high(0.1);
+            butter.generate_coefficients();
+
+            REQUIRE(cascade_gain(filter, 0.2) < cascade_gain(butter, 0.2));
+        }
+    }
+
+    SECTION("Blocks", "Ensures state is carried across blocks") {
+
+        ButterworthFilter<float> whole;
+
+        whole.set_order(6);
+        whole.set_frac_high(0.05);
+        whole.generate_coefficients();
+
+        ButterworthFilter<float> split = whole;
+
+        std::vector<float> input(1000);
+
+        for (std::size_t i = 0; i < input.size(); ++i) {
+
+            input.at(i) = static_cast<float>(std::sin(1.5 * static_cast<double>(i)) + std::sin(0.01 * static_cast<double>(i)));
+        }
+
+        std::vector<float> first(input.size());
+        std::vector<float> second(input);
+
+        whole.process(input.data(), 1000, first.data());
+
+        split.process(second.data(), 333);
+        split.process(second.data() + 333, 667);
+
+        REQUIRE(first == second);
+
+        // The high frequency should be removed, leaving a slow signal:
+
+        for (std::size_t i = 500; i < input.size(); ++i) {
+
+            REQUIRE(std::fabs(first.at(i) - first.at(i - 1)) < 0.02);
+        }
+
+        whole.reset();
+
+        std::vector<float> again(input.size());
+
+        whole.process(input.data(), 1000, again.data());
+
+        REQUIRE(again == first);
+    }
+
+    SECTION("Bank", "Ensures channel parallel filtering matches single channel filtering") {
+
+        const auto sections = iir_design(IIRPrototype::Butterworth, FilterType::LowPass, 4, 0, 0.1);
+
+        // Use enough channels for every group size:
+
+        const int channels = 15;
+        const int frames = 300;
+
+        std::vector<float> input(static_cast<std::size_t>(channels) * frames);
+
+        for (int f = 0; f < frames; ++f) {
+
+            for (int c = 0; c < channels; ++c) {
+
+                input.at(f * channels + c) = static_cast<float>(std::sin(0.1 * (c + 1) * f));
+            }
+        }
+
+        BiquadBank<float> bank;
+
+        bank.set_sections(sections);
+        bank.set_channels(channels);
+
+        REQUIRE(bank.num_sections() == 2);
+        REQUIRE(bank.channels() == channels);
+
+        // Process in two blocks, in place:
+
+        std::vector<float> output(input);
+
+        bank.process_interleaved(output.data(), 100, output.data());
+        bank.process_interleaved(output.data() + 100 * channels, 200, output.data() + 100 * channels);
+
+        for (int c = 0; c < channels; ++c) {
+
+            BiquadCascade<float> single;
+
+            single.set_sections(sections);
+
+            std::vector<float> chan(frames);
+
+            for (int f = 0; f < frames; ++f) {
+
+                chan.at(f) = input.at(f * channels + c);
+            }
+
+            single.process(chan.data(), frames);
+
+            for (int f = 0; f < frames; ++f) {
+
+                REQUIRE_THAT(output.at(f * channels + c), Catch::Matchers::WithinAbs(chan.at(f), 1e-6));
+            }
+        }
+
+        // Single channel processing should match too:
+
+        BiquadBank<float> planar;
+
+        planar.set_sections(sections);
+        planar.set_channels(2);
+
+        std::vector<float> first(frames);
+        std::vector<float> expected(frames);
+
+        for (int f = 0; f < frames; ++f) {
+
+            first.at(f) = input.at(f * channels + 1);
+        }
+
+        BiquadCascade<float> single;
+
+        single.set_sections(sections);
+        single.process(first.data(), frames, expected.data());
+
+        planar.process_channel(1, first.data(), 150, first.data());
+        planar.process_channel(1, first.data() + 150, 150, first.data() + 150);
+
+        REQUIRE(first == expected);
+    }
+
+    SECTION("Single Section", "Ensures closed form sections are designed correctly") {
+
+        BiquadCascade<double> low;
+        BiquadCascade<double> high;
+
+        low.set_sections(std::vector<BiquadCoefficients<double>>{biquad_design(FilterType::LowPass, 0.1)});
+        high.set_sections(std::vector<BiquadCoefficients<double>>{biquad_design(FilterType::HighPass, 0.1)});
+
+        REQUIRE_THAT(cascade_gain(low, 0.0), Catch::Matchers::WithinAbs(1.0, 1e-9));
+        REQUIRE_THAT(cascade_gain(low, 0.1), Catch::Matchers::WithinAbs(M_SQRT1_2, 1e-9));
+        REQUIRE_THAT(cascade_gain(high, 0.5), Catch::Matchers::WithinAbs(1.0, 1e-9));
+        REQUIRE_THAT(cascade_gain(high, 0.1), Catch::Matchers::WithinAbs(M_SQRT1_2, 1e-9));
+
+        // Band filters should pass and reject the center:
+
+        BiquadCascade<double> band;
+        BiquadCascade<double> notch;
+
+        band.set_sections(std::vector<BiquadCoefficients<double>>{biquad_design(FilterType::BandPass, 0.2, 2)});
+        notch.set_sections(std::vector<BiquadCoefficients<double>>{biquad_design(FilterType::BandReject, 0.2, 2)});
+
+        REQUIRE_THAT(cascade_gain(band, 0.2), Catch::Matchers::WithinAbs(1.0, 1e-9));
+        REQUIRE_THAT(cascade_gain(notch, 0.2), Catch::Matchers::WithinAbs(0.0, 1e-9));
+    }
+
+    SECTION("Single Pole", "Ensures single pole filters are generated") {
+
+        SinglePole<double> filter;
+
+        filter.set_type(FilterType::LowPass);
+        filter.set_frac_high(0.05);
+        filter.generate_coefficients();
+
+        std::vector<double> data(2000, 1.0);
+
+        filter.process(data.begin(), 2000);
+
+        REQUIRE_THAT(data.back(), Catch::Matchers::WithinAbs(1, 1e-9));
+    }
+}
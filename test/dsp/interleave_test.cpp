@@ -0,0 +1,67 @@
+/**
+ * @file interleave_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for interleave kernels
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "dsp/interleave.hpp"
+
+#include <string>
+#include <vector>
+
+// Number of samples in each channel
+const int interleave_frames = 37;
+
+TEST_CASE("Interleave Kernel Test", "[interleave][dsp]") {
+
+    for (int channels = 1; channels <= 5; ++channels) {
+
+        const int total = channels * interleave_frames;
+
+        // Create planar data, value encodes position:
+
+        std::vector<float> planar(total);
+
+        for (int c = 0; c < channels; ++c) {
+
+            for (int i = 0; i < interleave_frames; ++i) {
+
+                planar.at((c * interleave_frames) + i) = static_cast<float>((c * 1000) + i);
+            }
+        }
+
+        SECTION("Interleave " + std::to_string(channels), "Ensures planar data is interleaved") {
+
+            std::vector<float> out(total);
+
+            interleave(planar.data(), out.data(), channels, interleave_frames);
+
+            for (int i = 0; i < interleave_frames; ++i) {
+
+                for (int c = 0; c < channels; ++c) {
+
+                    REQUIRE(out.at((i * channels) + c) == static_cast<float>((c * 1000) + i));
+                }
+            }
+        }
+
+        SECTION("Round Trip " + std::to_string(channels), "Ensures deinterleaving undoes interleaving") {
+
+            std::vector<double> dplanar(planar.begin(), planar.end());
+            std::vector<double> inter(total);
+            std::vector<double> out(total);
+
+            interleave(dplanar.data(), inter.data(), channels, interleave_frames);
+            deinterleave(inter.data(), out.data(), channels, interleave_frames);
+
+            REQUIRE(out == dplanar);
+        }
+    }
+}
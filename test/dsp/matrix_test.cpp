@@ -0,0 +1,296 @@
+/**
+ * @file matrix_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for matrix operations
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "dsp/matrix.hpp"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Fills a buffer with values that are easy to check
+ *
+ * @tparam B Type of buffer
+ * @param buff Buffer to fill
+ * @param seed Offset of the values
+ */
+template <typename B>
+void fill_matrix(B& buff, int seed) {
+
+    for (int r = 0; r < static_cast<int>(buff.channels()); ++r) {
+
+        for (int c = 0; c < static_cast<int>(buff.channel_capacity()); ++c) {
+
+            buff.at(r, c) = std::sin((r * 7) + (c * 3) + seed);
+        }
+    }
+}
+
+/**
+ * @brief Ensures a product was computed correctly
+ *
+ * We compute each value with a naive triple loop.
+ *
+ * @tparam O Type of output view
+ * @tparam A Type of left view
+ * @tparam B Type of right view
+ * @param out Computed product
+ * @param a Left matrix
+ * @param b Right matrix
+ * @param base Values the output held before the product, nullptr if replaced
+ * @param tol Tolerance of each value
+ */
+template <typename O, typename A, typename B>
+void check_product(O out, A a, B b, const std::vector<double>* base, double tol) {
+
+    for (int r = 0; r < out.rows; ++r) {
+
+        for (int c = 0; c < out.cols; ++c) {
+
+            double expected = base != nullptr ? base->at((static_cast<std::size_t>(r) * out.cols) + c) : 0;
+
+            for (int i = 0; i < a.cols; ++i) {
+
+                expected += static_cast<double>(a.at(r, i)) * static_cast<double>(b.at(i, c));
+            }
+
+            REQUIRE_THAT(static_cast<double>(out.at(r, c)), Catch::Matchers::WithinAbs(expected, tol));
+        }
+    }
+}
+
+/**
+ * @brief Multiplies buffers of every layout and checks the result
+ *
+ * The sizes cross the tile boundaries of gemm().
+ *
+ * @tparam T Type of the values
+ * @tparam L Layout of the buffers
+ * @param tol Tolerance of each value
+ */
+template <typename T, typename L>
+void check_layout(double tol) {
+
+    Buffer<T, L> abuff(70, 37);
+    Buffer<T, L> bbuff(300, 70);
+    Buffer<T, L> out(300, 37);
+
+    fill_matrix(abuff, 0);
+    fill_matrix(bbuff, 1);
+    fill_matrix(out, 2);
+
+    // Remember the old output:
+
+    std::vector<double> base;
+
+    for (int r = 0; r < 37; ++r) {
+
+        for (int c = 0; c < 300; ++c) {
+
+            base.push_back(static_cast<double>(out.at(r, c)));
+        }
+    }
+
+    const auto oview = matrix_view(out);
+    const MatrixView<const T> aview = matrix_view(abuff);
+    const MatrixView<const T> bview = matrix_view(bbuff);
+
+    gemm(oview, aview, bview, true);
+
+    check_product(oview, aview, bview, &base, tol);
+
+    gemm(oview, aview, bview);
+
+    check_product(oview, aview, bview, nullptr, tol);
+}
+
+}  // namespace
+
+TEST_CASE("Matrix Test", "[matrix][dsp]") {
+
+    SECTION("Dot Product", "Ensures dot products keep the type of the values") {
+
+        std::vector<double> avec(37);
+        std::vector<double> bvec(37);
+
+        double expected = 0;
+
+        for (int i = 0; i < 37; ++i) {
+
+            avec[i] = 0.25 * i;
+            bvec[i] = 0.5;
+
+            expected += avec[i] * bvec[i];
+        }
+
+        REQUIRE_THAT(dot_product(avec.begin(), bvec.begin(), 37), Catch::Matchers::WithinAbs(expected, 1e-12));
+        REQUIRE_THAT(dot_product(avec.data(), bvec.data(), 37), Catch::Matchers::WithinAbs(expected, 1e-12));
+        REQUIRE(dot_product(avec.data(), bvec.data(), 0) == 0);
+    }
+
+    SECTION("Mult", "Ensures buffers are multiplied correctly") {
+
+        const std::vector<double> avals = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+        const std::vector<double> bvals = {10, 20, 30, 40, 50, 60, 70, 80, 90};
+
+        Buffer<double> abuff(3, 3);
+        Buffer<double> bbuff(3, 3);
+
+        Buffer<int> aint(3, 3);
+        Buffer<int> bint(3, 3);
+
+        for (int r = 0; r < 3; ++r) {
+
+            for (int c = 0; c < 3; ++c) {
+
+                abuff.at(r, c) = avals[(r * 3) + c];
+                bbuff.at(r, c) = bvals[(r * 3) + c];
+
+                aint.at(r, c) = static_cast<int>(avals[(r * 3) + c]);
+                bint.at(r, c) = static_cast<int>(bvals[(r * 3) + c]);
+            }
+        }
+
+        Buffer<double> out;
+        Buffer<int> oint;
+
+        matrix_mult(abuff, bbuff, out);
+        matrix_mult(aint, bint, oint);
+
+        REQUIRE(out.channels() == 3);
+        REQUIRE(out.channel_capacity() == 3);
+
+        REQUIRE(out.at(0, 0) == 300);
+        REQUIRE(out.at(2, 1) == 1260);
+        REQUIRE(oint.at(0, 0) == 300);
+        REQUIRE(oint.at(2, 1) == 1260);
+    }
+
+    SECTION("Channels", "Ensures a matrix of gains can be applied to a block") {
+
+        // Downmix three channels into two:
+
+        Buffer<double> gains(3, 2);
+
+        gains.at(0, 0) = 1;
+        gains.at(0, 2) = 0.5;
+        gains.at(1, 1) = 1;
+        gains.at(1, 2) = 0.5;
+
+        Buffer<double> in(16, 3);
+
+        fill_matrix(in, 0);
+
+        Buffer<double> out;
+
+        matrix_mult(gains, in, out);
+
+        REQUIRE(out.channels() == 2);
+        REQUIRE(out.channel_capacity() == 16);
+
+        for (int i = 0; i < 16; ++i) {
+
+            REQUIRE_THAT(out.at(0, i), Catch::Matchers::WithinAbs(in.at(0, i) + (0.5 * in.at(2, i)), 1e-12));
+            REQUIRE_THAT(out.at(1, i), Catch::Matchers::WithinAbs(in.at(1, i) + (0.5 * in.at(2, i)), 1e-12));
+        }
+    }
+
+    SECTION("Layouts", "Ensures products are correct for every layout and type") {
+
+        check_layout<float, Interleaved>(1e-3);
+        check_layout<float, Planar>(1e-3);
+        check_layout<double, Interleaved>(1e-10);
+        check_layout<double, Planar>(1e-10);
+        check_layout<long double, Interleaved>(1e-10);
+        check_layout<long double, Planar>(1e-10);
+    }
+
+    SECTION("Mixed", "Ensures products of views with different layouts are correct") {
+
+        Buffer<double, Planar> abuff(20, 9);
+        Buffer<double> bbuff(5, 20);
+        Buffer<double, Planar> out(9, 5);
+
+        fill_matrix(abuff, 0);
+        fill_matrix(bbuff, 1);
+
+        // Multiply by the transpose of the output, written through a transposed view:
+
+        const MatrixView<const double> aview = matrix_view(abuff);
+        const MatrixView<const double> bview = matrix_view(bbuff);
+        const auto oview = matrix_view(out).transpose();
+
+        gemm(oview, aview, bview);
+
+        check_product(oview, aview, bview, nullptr, 1e-10);
+
+        // Views with no contiguous dimension:
+
+        std::vector<double> data(4 * 9 * 20);
+
+        const MatrixView<const double> strided{data.data(), 9, 20, 80, 4};
+
+        for (int r = 0; r < 9; ++r) {
+
+            for (int c = 0; c < 20; ++c) {
+
+                data[(r * 80) + (c * 4)] = std::cos(r + c);
+            }
+        }
+
+        gemm(oview, strided, bview);
+
+        check_product(oview, strided, bview, nullptr, 1e-10);
+    }
+
+    SECTION("GEMV", "Ensures matrix vector products are correct") {
+
+        Buffer<double> interleaved(24, 13);
+        Buffer<double, Planar> planar(24, 13);
+
+        fill_matrix(interleaved, 0);
+        fill_matrix(planar, 0);
+
+        std::vector<double> vec(24);
+
+        for (int i = 0; i < 24; ++i) {
+
+            vec[i] = std::cos(i);
+        }
+
+        for (const MatrixView<const double> view : {MatrixView<const double>(matrix_view(interleaved)), MatrixView<const double>(matrix_view(planar))}) {
+
+            std::vector<double> out(13, 1);
+
+            gemv(out.data(), view, vec.data(), true);
+
+            for (int r = 0; r < 13; ++r) {
+
+                double expected = 1;
+
+                for (int c = 0; c < 24; ++c) {
+
+                    expected += view.at(r, c) * vec[c];
+                }
+
+                REQUIRE_THAT(out[r], Catch::Matchers::WithinAbs(expected, 1e-10));
+            }
+
+            gemv(out.data(), view, vec.data());
+
+            REQUIRE_THAT(out[3], Catch::Matchers::WithinAbs(dot_product(&planar.at(3, 0), vec.data(), 24), 1e-10));
+        }
+    }
+}
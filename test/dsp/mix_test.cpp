@@ -0,0 +1,51 @@
+/**
+ * @file mix_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for batch mixing kernels
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "dsp/mix.hpp"
+
+#include <vector>
+
+// Size of each test block, not a multiple of the vector width
+const int mix_test_size = 1001;
+
+TEST_CASE("Mix Kernel Test", "[mix][dsp]") {
+
+    std::vector<float> out(mix_test_size);
+    std::vector<float> in(mix_test_size);
+
+    for (int i = 0; i < mix_test_size; ++i) {
+
+        out.at(i) = static_cast<float>(i);
+        in.at(i) = 2;
+    }
+
+    SECTION("Add", "Ensures blocks are added correctly") {
+
+        mix_add(out.data(), in.data(), mix_test_size);
+
+        for (int i = 0; i < mix_test_size; ++i) {
+
+            REQUIRE(out.at(i) == static_cast<float>(i + 2));
+        }
+    }
+
+    SECTION("Gain", "Ensures blocks are scaled and added correctly") {
+
+        mix_add(out.data(), in.data(), mix_test_size, 0.5F);
+
+        for (int i = 0; i < mix_test_size; ++i) {
+
+            REQUIRE(out.at(i) == static_cast<float>(i + 1));
+        }
+    }
+}
@@ -0,0 +1,101 @@
+/**
+ * @file osc_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for batch oscillator kernels
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "dsp/osc.hpp"
+
+#include <cmath>
+#include <vector>
+
+// Size of each test block
+const int osc_test_size = 1000;
+
+// Phase values to test with
+const double osc_start = 0.3;
+const double osc_inc = 440.0 / 44100.0;
+
+TEST_CASE("Oscillator Kernel Test", "[osc][dsp]") {
+
+    SECTION("SineTurns", "Ensures the sine approximation is accurate") {
+
+        for (int i = -2000; i < 2000; ++i) {
+
+            const double turn = i / 997.0;
+
+            REQUIRE_THAT(sine_turns(turn), Catch::Matchers::WithinAbs(std::sin(2 * M_PI * turn), 1e-7));
+        }
+    }
+
+    SECTION("Sine", "Ensures the sine kernel is correct") {
+
+        std::vector<float> fdata(osc_test_size);
+        std::vector<double> ddata(osc_test_size);
+
+        osc_sine(fdata.data(), osc_test_size, osc_start, osc_inc);
+        osc_sine(ddata.data(), osc_test_size, osc_start, osc_inc);
+
+        for (int i = 0; i < osc_test_size; ++i) {
+
+            const double expected = std::sin(2 * M_PI * (osc_start + osc_inc * i));
+
+            REQUIRE_THAT(fdata.at(i), Catch::Matchers::WithinAbs(expected, 1e-6));
+            REQUIRE_THAT(ddata.at(i), Catch::Matchers::WithinAbs(expected, 1e-7));
+        }
+    }
+
+    SECTION("Square", "Ensures the square kernel is correct") {
+
+        std::vector<float> data(osc_test_size);
+
+        osc_square(data.data(), osc_test_size, osc_start, osc_inc);
+
+        for (int i = 0; i < osc_test_size; ++i) {
+
+            double placeholder = 0;
+            const double turn = modf(osc_start + osc_inc * i, &placeholder);
+
+            REQUIRE(data.at(i) == (turn < 0.5 ? 1.0 : -1.0));
+        }
+    }
+
+    SECTION("Sawtooth", "Ensures the sawtooth kernel is correct") {
+
+        std::vector<double> data(osc_test_size);
+
+        osc_sawtooth(data.data(), osc_test_size, 0, osc_inc);
+
+        // Ensure key points are correct:
+
+        REQUIRE_THAT(data.at(0), Catch::Matchers::WithinAbs(0, 1e-10));
+
+        std::vector<double> quarter(3);
+
+        osc_sawtooth(quarter.data(), 3, 0, 0.25);
+
+        REQUIRE_THAT(quarter.at(1), Catch::Matchers::WithinAbs(0.5, 1e-10));
+        REQUIRE_THAT(quarter.at(2), Catch::Matchers::WithinAbs(-1, 1e-10));
+    }
+
+    SECTION("Triangle", "Ensures the triangle kernel is correct") {
+
+        std::vector<double> data(5);
+
+        osc_triangle(data.data(), 5, 0, 0.25);
+
+        REQUIRE_THAT(data.at(0), Catch::Matchers::WithinAbs(0, 1e-10));
+        REQUIRE_THAT(data.at(1), Catch::Matchers::WithinAbs(1, 1e-10));
+        REQUIRE_THAT(data.at(2), Catch::Matchers::WithinAbs(0, 1e-10));
+        REQUIRE_THAT(data.at(3), Catch::Matchers::WithinAbs(-1, 1e-10));
+        REQUIRE_THAT(data.at(4), Catch::Matchers::WithinAbs(0, 1e-10));
+    }
+}
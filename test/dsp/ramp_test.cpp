@@ -0,0 +1,65 @@
+/**
+ * @file ramp_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for batch ramp kernels
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "dsp/ramp.hpp"
+
+#include <cmath>
+#include <vector>
+
+// Size of each test block, not a multiple of the anchor or lane count
+const int ramp_test_size = 1003;
+
+TEST_CASE("Ramp Kernel Test", "[ramp][dsp]") {
+
+    SECTION("Linear", "Ensures the linear kernel is correct") {
+
+        std::vector<double> data(ramp_test_size);
+
+        ramp_linear(data.data(), ramp_test_size, 0.25, 0.001);
+
+        for (int i = 0; i < ramp_test_size; ++i) {
+
+            REQUIRE_THAT(data.at(i), Catch::Matchers::WithinAbs(0.25 + 0.001 * i, 1e-12));
+        }
+    }
+
+    SECTION("Exponential", "Ensures the exponential kernel is correct") {
+
+        std::vector<double> data(ramp_test_size);
+
+        const double ratio = std::pow(1e6, 1.0 / ramp_test_size);
+
+        ramp_exponential(data.data(), ramp_test_size, 1e-6, ratio);
+
+        for (int i = 0; i < ramp_test_size; ++i) {
+
+            const double expected = 1e-6 * std::pow(ratio, i);
+
+            REQUIRE_THAT(data.at(i), Catch::Matchers::WithinRel(expected, 1e-12));
+        }
+    }
+
+    SECTION("Drift", "Ensures long exponential ramps do not drift") {
+
+        const int size = 1000000;
+
+        std::vector<float> data(size);
+
+        const double ratio = std::pow(0.001, 1.0 / size);
+
+        ramp_exponential(data.data(), size, 1, ratio);
+
+        REQUIRE_THAT(data.back(), Catch::Matchers::WithinRel(std::pow(ratio, size - 1), 1e-6));
+    }
+}
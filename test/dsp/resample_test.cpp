@@ -0,0 +1,96 @@
+/**
+ * @file resample_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for polyphase resampling kernels
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include "dsp/resample.hpp"
+
+// Size of filter used in tests
+const int resample_taps = 32;
+const int resample_phases = 64;
+
+TEST_CASE("Resample Kernel Test", "[resample][dsp]") {
+
+    std::vector<double> table((resample_phases + 1) * resample_taps);
+
+    polyphase_table(resample_cutoff(1.0, resample_taps), resample_taps, resample_phases, table.begin());
+
+    SECTION("Table", "Ensures each sub-filter has unity gain") {
+
+        for (int p = 0; p <= resample_phases; ++p) {
+
+            double sum = 0;
+
+            for (int i = 0; i < resample_taps; ++i) {
+
+                sum += table.at(p * resample_taps + i);
+            }
+
+            REQUIRE_THAT(sum, Catch::Matchers::WithinAbs(1.0, 1e-3));
+        }
+    }
+
+    SECTION("Cutoff", "Ensures the cutoff is below the lower Nyquist frequency") {
+
+        REQUIRE(resample_cutoff(1.5, resample_taps) < 0.5);
+        REQUIRE(resample_cutoff(0.5, resample_taps) < 0.25);
+    }
+
+    SECTION("Integer Positions", "Ensures samples at integer positions are passed through") {
+
+        std::vector<double> input(100);
+
+        for (int i = 0; i < input.size(); ++i) {
+
+            input.at(i) = std::sin(i * 0.3);
+        }
+
+        std::vector<double> output(20);
+
+        resample(input.data(), output.data(), 20, 40, 1.0, table.data(), resample_taps, resample_phases);
+
+        for (int i = 0; i < output.size(); ++i) {
+
+            REQUIRE_THAT(output.at(i), Catch::Matchers::WithinAbs(input.at(40 + i), 1e-3));
+        }
+    }
+
+    SECTION("Fractional Positions", "Ensures a sine is interpolated at any position") {
+
+        const double freq = 0.05;
+
+        std::vector<float> input(200);
+
+        for (int i = 0; i < input.size(); ++i) {
+
+            input.at(i) = static_cast<float>(std::sin(2 * M_PI * freq * i));
+        }
+
+        std::vector<float> table_f(table.begin(), table.end());
+        std::vector<float> output(100);
+
+        const double start = 40.123;
+        const double step = 44100.0 / 48000.0;
+
+        resample(input.data(), output.data(), 100, start, step, table_f.data(), resample_taps, resample_phases);
+
+        for (int i = 0; i < output.size(); ++i) {
+
+            const double expected = std::sin(2 * M_PI * freq * (start + step * i));
+
+            REQUIRE_THAT(output.at(i), Catch::Matchers::WithinAbs(expected, 2e-3));
+        }
+    }
+}
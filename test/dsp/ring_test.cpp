@@ -0,0 +1,284 @@
+/**
+ * @file ring_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for lock-free ring buffers
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "dsp/ring.hpp"
+
+TEST_CASE("SPSCRing Test", "[ring][dsp]") {
+
+    SPSCRing<int> ring(10);
+
+    SECTION("Capacity", "Ensures capacity is rounded to a power of two") {
+
+        REQUIRE(ring.capacity() == 16);
+        REQUIRE(ring.read_available() == 0);
+        REQUIRE(ring.write_available() == 16);
+    }
+
+    SECTION("Wrap", "Ensures values are read back in order across the wrap") {
+
+        std::vector<int> input(12);
+        std::vector<int> output(12);
+
+        std::iota(input.begin(), input.end(), 0);
+
+        // Move the positions near the end:
+
+        REQUIRE(ring.write(input.begin(), 12) == 12);
+        REQUIRE(ring.read(output.begin(), 12) == 12);
+
+        // Write across the wrap:
+
+        std::iota(input.begin(), input.end(), 100);
+
+        REQUIRE(ring.write(input.begin(), 12) == 12);
+        REQUIRE(ring.read_available() == 12);
+        REQUIRE(ring.read(output.begin(), 12) == 12);
+
+        REQUIRE(output == input);
+    }
+
+    SECTION("Full", "Ensures we never overwrite unread data") {
+
+        std::vector<int> input(20, 5);
+        std::vector<int> output(20);
+
+        REQUIRE(ring.write(input.begin(), 20) == 16);
+        REQUIRE(ring.write_available() == 0);
+        REQUIRE(ring.write(input.begin(), 1) == 0);
+
+        REQUIRE(ring.read(output.begin(), 20) == 16);
+        REQUIRE(ring.read(output.begin(), 1) == 0);
+    }
+
+    SECTION("Threaded", "Ensures data passes between threads intact") {
+
+        const int total = 20000;
+
+        std::thread producer([&ring]() {
+
+            int next = 0;
+
+            while (next < total) {
+
+                std::vector<int> chunk(7);
+
+                std::iota(chunk.begin(), chunk.end(), next);
+
+                const int num = std::min(7, total - next);
+
+                const int done = static_cast<int>(ring.write(chunk.begin(), num));
+
+                if (done == 0) {
+
+                    std::this_thread::yield();
+                }
+
+                next += done;
+            }
+        });
+
+        int expected = 0;
+        bool ordered = true;
+
+        while (expected < total) {
+
+            std::vector<int> chunk(5);
+
+            const auto num = ring.read(chunk.begin(), 5);
+
+            if (num == 0) {
+
+                std::this_thread::yield();
+            }
+
+            for (std::size_t i = 0; i < num; ++i) {
+
+                ordered = ordered && chunk.at(i) == expected++;
+            }
+        }
+
+        producer.join();
+
+        REQUIRE(ordered);
+    }
+}
+
+TEST_CASE("MPSCRing Test", "[ring][dsp]") {
+
+    MPSCRing<int> ring(10);
+
+    SECTION("Capacity", "Ensures capacity is rounded to a power of two") {
+
+        REQUIRE(ring.capacity() == 16);
+        REQUIRE(ring.read_available() == 0);
+    }
+
+    SECTION("Order", "Ensures values are read back in order and never overwritten") {
+
+        int val = 0;
+
+        for (int lap = 0; lap < 3; ++lap) {
+
+            for (int i = 0; i < 16; ++i) {
+
+                REQUIRE(ring.push(i + (lap * 100)));
+            }
+
+            REQUIRE(!ring.push(99));
+
+            for (int i = 0; i < 16; ++i) {
+
+                REQUIRE(ring.pop(val));
+                REQUIRE(val == i + (lap * 100));
+            }
+
+            REQUIRE(!ring.pop(val));
+        }
+    }
+
+    SECTION("Move", "Ensures move only values can be passed") {
+
+        MPSCRing<std::unique_ptr<int>> mring(2);
+
+        REQUIRE(mring.push(std::make_unique<int>(5)));
+
+        std::unique_ptr<int> out;
+
+        REQUIRE(mring.pop(out));
+        REQUIRE(*out == 5);
+    }
+
+    SECTION("Threads", "Ensures many producers can write at once") {
+
+        const int producers = 4;
+        const int num = 10000;
+
+        std::vector<std::thread> threads;
+
+        for (int p = 0; p < producers; ++p) {
+
+            threads.emplace_back([&ring, p]() {
+
+                for (int i = 0; i < num; ++i) {
+
+                    // Encode the producer and sequence:
+
+                    while (!ring.push((p * num) + i)) {
+
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        // Read everything, ensuring each producer is in order:
+
+        std::vector<int> last(producers, -1);
+
+        int total = 0;
+        int val = 0;
+
+        while (total < producers * num) {
+
+            if (!ring.pop(val)) {
+
+                std::this_thread::yield();
+
+                continue;
+            }
+
+            const int prod = val / num;
+            const int seq = val % num;
+
+            REQUIRE(seq == last.at(prod) + 1);
+
+            last.at(prod) = seq;
+
+            ++total;
+        }
+
+        for (auto& thread : threads) {
+
+            thread.join();
+        }
+
+        REQUIRE(last == std::vector<int>(producers, num - 1));
+    }
+}
+
+TEST_CASE("TripleBuffer Test", "[ring][dsp]") {
+
+    TripleBuffer<std::vector<int>> buff(std::vector<int>(16, -1));
+
+    SECTION("Latest", "Ensures the reader picks up the latest value") {
+
+        REQUIRE(!buff.update());
+        REQUIRE(buff.read_buffer().at(0) == -1);
+
+        for (int i = 0; i < 3; ++i) {
+
+            std::ranges::fill(buff.write_buffer(), i);
+            buff.publish();
+        }
+
+        REQUIRE(buff.update());
+        REQUIRE(buff.read_buffer().at(0) == 2);
+
+        // Nothing new was published:
+
+        REQUIRE(!buff.update());
+        REQUIRE(buff.read_buffer().at(0) == 2);
+    }
+
+    SECTION("Threaded", "Ensures values are never torn and always move forward") {
+
+        const int total = 20000;
+
+        std::thread producer([&buff]() {
+
+            for (int i = 0; i < total; ++i) {
+
+                std::ranges::fill(buff.write_buffer(), i);
+                buff.publish();
+            }
+        });
+
+        int last = -1;
+        bool consistent = true;
+
+        while (last < total - 1) {
+
+            if (!buff.update()) {
+
+                std::this_thread::yield();
+                continue;
+            }
+
+            const auto& val = buff.read_buffer();
+
+            consistent = consistent && val.front() > last && std::ranges::all_of(val, [&val](int num) { return num == val.front(); });
+
+            last = val.front();
+        }
+
+        producer.join();
+
+        REQUIRE(consistent);
+    }
+}
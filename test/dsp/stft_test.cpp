@@ -0,0 +1,112 @@
+/**
+ * @file stft_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for streaming STFT components
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "dsp/stft.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <vector>
+
+TEST_CASE("STFT Test", "[stft][dsp]") {
+
+    // Create a test signal:
+
+    std::vector<double> input(4000);
+
+    for (std::size_t i = 0; i < input.size(); ++i) {
+
+        input.at(i) = std::sin(0.05 * static_cast<double>(i)) + 0.3 * std::cos(0.31 * static_cast<double>(i));
+    }
+
+    SECTION("Reconstruct", "Ensures an unaltered signal is reconstructed exactly") {
+
+        const double tol = std::max<double>(1e-9, std::numeric_limits<sample_t>::epsilon() * 64);
+
+        for (const auto type : {WindowType::Hann, WindowType::Hamming, WindowType::Blackman}) {
+
+            for (const int hop : {32, 64, 128}) {
+
+                STFT stft(256, hop, type);
+
+                REQUIRE(stft.latency() == 256);
+
+                std::vector<double> output(input.size());
+
+                stft.process(input.begin(), static_cast<int>(input.size()), output.begin(), [](std::span<std::complex<sample_t>>) {});
+
+                for (std::size_t i = 0; i < output.size(); ++i) {
+
+                    const double expected = i < static_cast<std::size_t>(stft.latency()) ? 0 : input.at(i - stft.latency());
+
+                    REQUIRE_THAT(output.at(i), Catch::Matchers::WithinAbs(expected, tol));
+                }
+            }
+        }
+    }
+
+    SECTION("Block Size", "Ensures the output does not depend on the block size") {
+
+        STFT whole(128, 32);
+        STFT split(128, 32);
+
+        std::vector<double> first(input.size());
+        std::vector<double> second(input);
+
+        whole.process(input.begin(), static_cast<int>(input.size()), first.begin(), [](std::span<std::complex<sample_t>>) {});
+
+        // Process uneven blocks in place:
+
+        int done = 0;
+        int block = 1;
+
+        while (done < static_cast<int>(second.size())) {
+
+            const int num = std::min(block, static_cast<int>(second.size()) - done);
+
+            split.process(second.begin() + done, num, second.begin() + done, [](std::span<std::complex<sample_t>>) {});
+
+            done += num;
+            block = (block * 7) % 101 + 1;
+        }
+
+        REQUIRE(first == second);
+    }
+
+    SECTION("Callback", "Ensures spectra can be altered") {
+
+        STFT stft(256, 64);
+
+        int frames = 0;
+
+        std::vector<double> output(input.size());
+
+        stft.process(input.begin(), static_cast<int>(input.size()), output.begin(), [&frames](std::span<std::complex<sample_t>> spec) {
+
+            REQUIRE(spec.size() == 129);
+
+            ++frames;
+
+            std::ranges::fill(spec, 0);
+        });
+
+        REQUIRE(frames == static_cast<int>(input.size()) / 64);
+
+        for (const double val : output) {
+
+            REQUIRE_THAT(val, Catch::Matchers::WithinAbs(0, 1e-12));
+        }
+    }
+}
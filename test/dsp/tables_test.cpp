@@ -0,0 +1,107 @@
+/**
+ * @file tables_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for compile time tables
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+#include <complex>
+#include <numeric>
+#include <vector>
+
+#include "dsp/ft.hpp"
+#include "dsp/tables.hpp"
+#include "dsp/util.hpp"
+#include "dsp/window.hpp"
+
+TEST_CASE("Table Test", "[tables][dsp]") {
+
+    SECTION("Cover", "Ensures only supported sizes are covered") {
+
+        REQUIRE(table_covers(1));
+        REQUIRE(table_covers(128));
+        REQUIRE(table_covers(8192));
+        REQUIRE(!table_covers(0));
+        REQUIRE(!table_covers(384));
+        REQUIRE(!table_covers(16384));
+
+        REQUIRE(window_table_covers(256));
+        REQUIRE(window_table_covers(8192));
+        REQUIRE(!window_table_covers(128));
+        REQUIRE(!window_table_covers(1000));
+    }
+
+    SECTION("Twiddle", "Ensures twiddle factors match computed values") {
+
+        for (int size : {2, 64, 256, 8192}) {
+
+            for (int k = 0; k < size; k += std::max(size / 64, 1)) {
+
+                const std::complex<long double> ref = std::polar(1.0L, -2.0L * M_PIl * k / size);
+                const std::complex<long double> val = table_twiddle<long double>(k, size);
+
+                REQUIRE_THAT(static_cast<double>(val.real()), Catch::Matchers::WithinAbs(static_cast<double>(ref.real()), 1e-15));
+                REQUIRE_THAT(static_cast<double>(val.imag()), Catch::Matchers::WithinAbs(static_cast<double>(ref.imag()), 1e-15));
+
+                // Backward factors are the conjugate:
+
+                REQUIRE(table_twiddle<long double>(k, size, 1) == std::conj(val));
+            }
+        }
+    }
+
+    SECTION("Reverse", "Ensures bit reversal matches the iterative reversal") {
+
+        for (int size : {4, 256, 8192}) {
+
+            const int bits = std::countr_zero(static_cast<unsigned>(size));
+
+            for (int i = 0; i < size; ++i) {
+
+                int rev = 0;
+
+                for (int b = 0; b < bits; ++b) {
+
+                    rev |= ((i >> b) & 1) << (bits - 1 - b);
+                }
+
+                REQUIRE(table_bit_reverse(i, size) == rev);
+            }
+
+            std::vector<int> data(size);
+
+            std::iota(data.begin(), data.end(), 0);
+
+            bit_reverse(size, data.begin());
+
+            REQUIRE(data[1] == size / 2);
+            REQUIRE(data[size - 1] == size - 1);
+        }
+    }
+
+    SECTION("Window", "Ensures window cosines match computed values") {
+
+        for (int size = TABLE_MIN_SIZE; size <= TABLE_MAX_SIZE; size *= 2) {
+
+            for (int n = 0; n < size; n += 7) {
+
+                REQUIRE_THAT(static_cast<double>(table_window_cosine(n, size)), Catch::Matchers::WithinAbs(std::cos(2 * M_PI * n / (size - 1)), 1e-13));
+            }
+
+            REQUIRE(table_window_cosine(size - 1, size) == 1);
+        }
+
+        // Covered windows agree with the window equations:
+
+        REQUIRE_THAT(static_cast<double>(window_hann(100, 1024)), Catch::Matchers::WithinAbs(0.5 - 0.5 * std::cos(2 * M_PI * 100 / 1023), 1e-13));
+        REQUIRE_THAT(static_cast<double>(window_blackman(100, 1024)), Catch::Matchers::WithinAbs(0.42 - 0.5 * std::cos(2 * M_PI * 100 / 1023) + 0.08 * std::cos(4 * M_PI * 100 / 1023), 1e-13));
+    }
+}
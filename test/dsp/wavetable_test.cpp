@@ -0,0 +1,155 @@
+/**
+ * @file wavetable_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for band-limited wavetables
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "dsp/wavetable.hpp"
+
+#include <cmath>
+#include <complex>
+#include <span>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Measures the amplitude of a harmonic in a level
+ *
+ * @param table Level to measure
+ * @param harmonic Harmonic to measure
+ * @return double Amplitude of the harmonic
+ */
+double harmonic_level(std::span<const double> table, int harmonic) {
+
+    std::complex<double> sum = 0;
+
+    for (int i = 0; i < WAVETABLE_SIZE; ++i) {
+
+        sum += table[i] * std::polar(1.0, -2 * M_PI * harmonic * i / WAVETABLE_SIZE);
+    }
+
+    return 2 * std::abs(sum) / WAVETABLE_SIZE;
+}
+
+}  // namespace
+
+TEST_CASE("Wavetable Test", "[wavetable][dsp]") {
+
+    SECTION("Pick", "Ensures levels keep harmonics below the Nyquist frequency") {
+
+        REQUIRE(Wavetable<double>::pick(0) == 0);
+        REQUIRE(Wavetable<double>::pick(20.0 / 44100) == 0);
+        REQUIRE(Wavetable<double>::pick(0.5) == WAVETABLE_LEVELS - 1);
+        REQUIRE(Wavetable<double>::pick(0.9) == WAVETABLE_LEVELS - 1);
+
+        for (int i = 1; i < 2000; ++i) {
+
+            const double inc = i / 4000.0;
+            const int level = Wavetable<double>::pick(inc);
+
+            // Highest harmonic is below Nyquist:
+
+            REQUIRE(((WAVETABLE_HARMONICS >> level) * inc <= 0.5 || level == WAVETABLE_LEVELS - 1));
+
+            // The level before would have gone past it:
+
+            if (level > 0) {
+
+                REQUIRE((WAVETABLE_HARMONICS >> (level - 1)) * inc > 0.5);
+            }
+        }
+    }
+
+    SECTION("Shared", "Ensures tables are built once and shared") {
+
+        wavetable_cache_clear();
+
+        const auto& table = wavetable<double>(Waveform::Square);
+        const auto& again = wavetable<double>(Waveform::Square);
+
+        REQUIRE(&table == &again);
+        REQUIRE(wavetable_cache_size() == 1);
+
+        wavetable<float>(Waveform::Square);
+
+        REQUIRE(wavetable_cache_size() == 2);
+    }
+
+    SECTION("Sine", "Ensures every level of the sine table is a sine") {
+
+        const auto& table = wavetable<double>(Waveform::Sine);
+
+        for (int k = 0; k < WAVETABLE_LEVELS; ++k) {
+
+            auto level = table.level(k);
+
+            REQUIRE(level.size() == WAVETABLE_SIZE + 1);
+            REQUIRE(level[WAVETABLE_SIZE] == level[0]);
+
+            for (int i = 0; i < WAVETABLE_SIZE; i += 37) {
+
+                REQUIRE_THAT(level[i], Catch::Matchers::WithinAbs(std::sin(2 * M_PI * i / WAVETABLE_SIZE), 1e-12));
+            }
+        }
+    }
+
+    SECTION("Band Limited", "Ensures each level only holds its harmonics") {
+
+        const auto& table = wavetable<double>(Waveform::Sawtooth);
+
+        for (int k : {0, 4, 8}) {
+
+            const int top = WAVETABLE_HARMONICS >> k;
+
+            auto level = table.level(k);
+
+            REQUIRE_THAT(harmonic_level(level, 1), Catch::Matchers::WithinAbs(2 / M_PI, 1e-9));
+            REQUIRE_THAT(harmonic_level(level, top), Catch::Matchers::WithinAbs(2 / (M_PI * top), 1e-9));
+            REQUIRE_THAT(harmonic_level(level, top + 1), Catch::Matchers::WithinAbs(0, 1e-9));
+        }
+
+        // Square and triangle only hold odd harmonics:
+
+        auto square = wavetable<double>(Waveform::Square).level(0);
+        auto triangle = wavetable<double>(Waveform::Triangle).level(0);
+
+        REQUIRE_THAT(harmonic_level(square, 3), Catch::Matchers::WithinAbs(4 / (3 * M_PI), 1e-9));
+        REQUIRE_THAT(harmonic_level(square, 2), Catch::Matchers::WithinAbs(0, 1e-9));
+        REQUIRE_THAT(harmonic_level(triangle, 3), Catch::Matchers::WithinAbs(8 / (9 * M_PI * M_PI), 1e-9));
+        REQUIRE_THAT(harmonic_level(triangle, 4), Catch::Matchers::WithinAbs(0, 1e-9));
+    }
+
+    SECTION("Render", "Ensures the kernel interpolates the table") {
+
+        const double start = 0.3;
+        const double inc = 440.0 / 44100.0;
+        const int size = 1000;
+
+        const auto& table = wavetable<double>(Waveform::Sine);
+        const auto& ftable = wavetable<float>(Waveform::Sine);
+
+        std::vector<double> ddata(size);
+        std::vector<float> fdata(size);
+
+        wavetable_render(ddata.data(), size, table.level(0).data(), start, inc);
+        wavetable_render(fdata.data(), size, ftable.level(0).data(), start, inc);
+
+        for (int i = 0; i < size; ++i) {
+
+            const double turn = start + inc * i;
+
+            REQUIRE_THAT(ddata[i], Catch::Matchers::WithinAbs(std::sin(2 * M_PI * turn), 1e-6));
+            REQUIRE_THAT(fdata[i], Catch::Matchers::WithinAbs(std::sin(2 * M_PI * turn), 1e-6));
+            REQUIRE_THAT(table.sample(turn - std::floor(turn), inc), Catch::Matchers::WithinAbs(ddata[i], 1e-12));
+        }
+    }
+}
@@ -14,8 +14,11 @@
 
 #include "dsp/window.hpp"
 
+#include <cstdint>
 #include <vector>
 
+#include "dsp/alloc.hpp"
+
 // Known test data
 
 const int window_test_size = 50;
@@ -65,3 +68,70 @@ TEST_CASE("Window Test", "[win]") {
         }
     }
 }
+
+TEST_CASE("Window Table Test", "[win]") {
+
+    SECTION("Values", "Ensures tables match the window functions") {
+
+        auto blackman = window_table<double>(WindowType::Blackman, window_test_size);
+        auto hann = window_table<double>(WindowType::Hann, window_test_size);
+        auto hamming = window_table<double>(WindowType::Hamming, window_test_size);
+        auto rect = window_table<float>(WindowType::Rectangle, window_test_size);
+
+        REQUIRE(blackman.size() == window_test_size);
+
+        for (int i = 0; i < window_test_size; ++i) {
+
+            REQUIRE_THAT(blackman[i], Catch::Matchers::WithinAbs(blackman_data.at(i), 0.0000001));
+            REQUIRE_THAT(hann[i], Catch::Matchers::WithinAbs(hann_data.at(i), 0.0000001));
+            REQUIRE_THAT(hamming[i], Catch::Matchers::WithinAbs(hamming_data.at(i), 0.0000001));
+            REQUIRE(rect[i] == 1.0F);
+        }
+    }
+
+    SECTION("Cache", "Ensures tables are shared and aligned") {
+
+        window_cache_clear();
+
+        auto first = window_table<float>(WindowType::Hann, 512);
+        auto second = window_table<float>(WindowType::Hann, 512, 0.5);
+        auto other = window_table<float>(WindowType::Hann, 512, 0.54);
+
+        // Same key gives the same memory:
+
+        REQUIRE(first.data() == second.data());
+        REQUIRE(first.data() != other.data());
+        REQUIRE(window_cache_size() == 2);
+
+        // Rectangle tables ignore the parameter:
+
+        REQUIRE(window_table<float>(WindowType::Rectangle, 64, 1).data() == window_table<float>(WindowType::Rectangle, 64, 2).data());
+
+        REQUIRE(reinterpret_cast<std::uintptr_t>(first.data()) % BUFFER_ALIGN == 0);
+
+        window_cache_clear();
+
+        REQUIRE(window_cache_size() == 0);
+    }
+
+    SECTION("Apply", "Ensures windows are applied to data") {
+
+        std::vector<float> data(window_test_size, 2.0F);
+        std::vector<float> out(window_test_size);
+
+        auto table = window_table<float>(WindowType::Blackman, window_test_size);
+
+        apply_window(data.data(), table.data(), out.data(), window_test_size);
+
+        for (int i = 0; i < window_test_size; ++i) {
+
+            REQUIRE_THAT(out.at(i), Catch::Matchers::WithinAbs(2 * blackman_data.at(i), 0.000001));
+        }
+
+        // In place should work too:
+
+        apply_window(data.data(), table.data(), data.data(), window_test_size);
+
+        REQUIRE(data == out);
+    }
+}
@@ -0,0 +1,155 @@
+/**
+ * @file dynamics_module_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for compressors and limiters
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "dynamics_module.hpp"
+#include "meta_audio.hpp"
+
+TEST_CASE("CompressorModule Test", "[dynamics]") {
+
+    const int channels = 2;
+    const int frames = 64;
+
+    // Runs blocks of the given values through a module, returning the first channel of the output:
+
+    auto run = [&](CompressorModule& comp, const std::vector<sample_t>& input) {
+
+        std::vector<sample_t> out;
+
+        for (std::size_t start = 0; start < input.size(); start += frames) {
+
+            auto buff = std::make_unique<AudioBuffer>(frames, channels);
+
+            for (int f = 0; f < frames; ++f) {
+
+                buff->at(0, f) = input[start + f];
+                buff->at(1, f) = -input[start + f];
+            }
+
+            comp.set_buffer(std::move(buff));
+            comp.process();
+
+            auto result = comp.get_buffer();
+
+            for (int f = 0; f < frames; ++f) {
+
+                out.push_back(result->at(0, f));
+
+                REQUIRE_THAT(result->at(1, f), Catch::Matchers::WithinAbs(-result->at(0, f), 1e-6));
+            }
+        }
+
+        return out;
+    };
+
+    SECTION("Static", "Ensures steady levels above the threshold are reduced by the ratio") {
+
+        CompressorModule comp(-6, 2, 0, 0);
+
+        comp.get_info()->channels = channels;
+        comp.get_info()->in_buffer = frames;
+        comp.start();
+
+        // 0 dB is 6 dB over, so it should come out 3 dB down:
+
+        auto out = run(comp, std::vector<sample_t>(frames * 2, 1));
+
+        for (const sample_t val : out) {
+
+            REQUIRE_THAT(val, Catch::Matchers::WithinAbs(std::pow(10, -3.0 / 20), 1e-5));
+        }
+
+        REQUIRE_THAT(comp.get_reduction(), Catch::Matchers::WithinAbs(-3, 1e-4));
+
+        // Levels below the threshold pass untouched:
+
+        out = run(comp, std::vector<sample_t>(frames, 0.25));
+
+        REQUIRE_THAT(out.back(), Catch::Matchers::WithinAbs(0.25, 1e-5));
+    }
+
+    SECTION("Release", "Ensures the gain recovers over the release time") {
+
+        CompressorModule comp(-20, 10, 0, 0.001);
+
+        comp.get_info()->channels = channels;
+        comp.get_info()->in_buffer = frames;
+        comp.start();
+
+        run(comp, std::vector<sample_t>(frames, 1));
+
+        // After a loud block, quiet audio starts reduced and recovers:
+
+        auto out = run(comp, std::vector<sample_t>(frames * 8, 0.01));
+
+        REQUIRE(out.front() < 0.005);
+        REQUIRE(out[10] > out.front());
+        REQUIRE_THAT(out.back(), Catch::Matchers::WithinAbs(0.01, 1e-4));
+    }
+
+    SECTION("Limiter", "Ensures peaks never pass the ceiling, and are delayed by the lookahead") {
+
+        LimiterModule limit(-6, 0.05, 32.0 / SAMPLE_RATE);
+
+        limit.get_info()->channels = channels;
+        limit.get_info()->in_buffer = frames;
+        limit.start();
+
+        REQUIRE(limit.latency() == 32);
+        REQUIRE(limit.get_info()->latency == 32);
+
+        std::vector<sample_t> input(frames * 4, 0.1);
+
+        input[100] = 1;
+        input[150] = 2;
+
+        auto out = run(limit, input);
+
+        const double ceiling = std::pow(10, -6.0 / 20);
+
+        for (const sample_t val : out) {
+
+            REQUIRE(std::fabs(val) <= ceiling * 1.01);
+        }
+
+        // Peaks come out after the lookahead, turned down:
+
+        REQUIRE(out[132] > 0.45);
+        REQUIRE(out[182] > 0.45);
+        REQUIRE_THAT(out[20], Catch::Matchers::WithinAbs(0, 1e-6));
+        REQUIRE_THAT(out[40], Catch::Matchers::WithinAbs(0.1, 1e-5));
+    }
+
+    SECTION("Sidechain", "Ensures the sidechain drives the detector") {
+
+        CompressorModule comp(-12, 100, 0, 0);
+
+        ConstModule side(1);
+
+        comp.get_sidechain()->bind(&side);
+        comp.get_info()->channels = channels;
+        comp.get_info()->in_buffer = frames;
+        comp.get_sidechain()->conf_mod(&comp);
+        comp.start();
+
+        // A quiet input is ducked under the loud sidechain:
+
+        auto out = run(comp, std::vector<sample_t>(frames, 0.1));
+
+        REQUIRE_THAT(out.back(), Catch::Matchers::WithinAbs(0.1 * std::pow(10, -12 * 0.99 / 20), 1e-4));
+    }
+}
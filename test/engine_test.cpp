@@ -0,0 +1,263 @@
+/**
+ * @file engine_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for real-time chain engines
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <thread>
+
+#include "engine.hpp"
+#include "dsp/denormal.hpp"
+#include "filter_module.hpp"
+#include "fund_oscillator.hpp"
+#include "meta_audio.hpp"
+#include "module_mixer.hpp"
+#include "sink_module.hpp"
+
+TEST_CASE("Engine Test", "[engine]") {
+
+    // Started sinks flush denormals, restore the mode of this thread once we are done:
+
+    const FlushToZeroScope ftz(flush_to_zero());
+
+    SineOscillator osc;
+    LatencyModule late;
+    PeriodSink sink;
+
+    sink.bind(&late);
+    late.bind(&osc);
+
+    Engine engine(&sink);
+
+    SECTION("Default", "Ensures the default options do nothing") {
+
+        const RTStatus status = apply_rt(RTConfig());
+
+        REQUIRE(!status.scheduled);
+        REQUIRE(!status.pinned);
+        REQUIRE(!status.locked);
+        REQUIRE(status.prefaulted == 0);
+    }
+
+    SECTION("Run", "Ensures we can run a chain on the calling thread") {
+
+        RTConfig config;
+
+        config.prefault = 4;
+
+        engine.set_config(config);
+
+        const RTStatus status = engine.run(10);
+
+        REQUIRE(status.prefaulted == 4);
+#if defined(__x86_64__) || defined(__i386__) || defined(__aarch64__)
+        REQUIRE(status.flushed);
+#endif
+        REQUIRE(late.processed() == 10);
+        REQUIRE(late.max_time() >= late.time());
+        REQUIRE(!engine.is_running());
+    }
+
+    SECTION("Prepare", "Ensures the chain can be prepared and warmed up before running") {
+
+        RTConfig config;
+
+        config.warmup = 3;
+
+        engine.set_config(config);
+
+        REQUIRE(!engine.is_ready());
+
+        engine.prepare();
+
+        REQUIRE(engine.is_ready());
+
+        RTStatus status = engine.get_status();
+
+        REQUIRE(status.prepared == 3);
+        REQUIRE(status.warmed == 3);
+        REQUIRE(status.prepare_time > 0);
+
+        // Warm-up blocks never reach the sink, or advance the chain:
+
+        REQUIRE(late.processed() == 3);
+        REQUIRE(sink.get_chain_info()->sample == 0);
+
+        // Preparing again does nothing:
+
+        engine.prepare();
+
+        REQUIRE(late.processed() == 3);
+
+        // Running uses the prepared chain:
+
+        status = engine.run(5);
+
+        REQUIRE(status.warmed == 3);
+        REQUIRE(late.processed() == 8);
+        REQUIRE(!engine.is_ready());
+    }
+
+    SECTION("Unused", "Ensures a prepared chain is stopped without running") {
+
+        engine.prepare();
+
+        REQUIRE(engine.is_ready());
+
+        engine.stop();
+
+        REQUIRE(!engine.is_ready());
+    }
+
+    SECTION("Warm Start", "Ensures warm-up blocks do not alter the output") {
+
+        // Build a matching chain that is never warmed:
+
+        SineOscillator cosc(440);
+        BiquadFilter cfilt(FilterType::LowPass, 2000, 0, 2);
+        LatencyModule clate;
+        PeriodSink csink;
+
+        csink.bind(&clate)->bind(&cfilt)->bind(&cosc);
+
+        BiquadFilter filt(FilterType::LowPass, 2000, 0, 2);
+
+        late.bind(&filt)->bind(&osc);
+
+        osc.set_frequency(440);
+
+        sink.meta_info_sync();
+        sink.meta_start();
+
+        csink.meta_info_sync();
+        csink.meta_start();
+
+        REQUIRE(warm_chain(&sink, 3) == 3);
+        REQUIRE(late.processed() == 3);
+
+        // The blocks after warming must match the cold chain:
+
+        for (int block = 0; block < 3; ++block) {
+
+            late.meta_process();
+            clate.meta_process();
+
+            auto warm = late.get_buffer();
+            auto cold = clate.get_buffer();
+
+            REQUIRE(warm->size() == cold->size());
+
+            for (std::size_t i = 0; i < warm->size(); ++i) {
+
+                REQUIRE(warm->at(i) == cold->at(i));
+            }
+        }
+
+        sink.meta_stop();
+        csink.meta_stop();
+    }
+
+    SECTION("Warm Mixer", "Ensures warm-up does not alter sources behind a mixer") {
+
+        WorkerPool pool(2);
+
+        for (const bool concurrent : {false, true}) {
+
+            // Build the warmed chain, and a matching cold chain:
+
+            SineOscillator osc1(440);
+            SineOscillator osc2(220);
+            BiquadFilter filt(FilterType::LowPass, 2000, 0, 2);
+            ModuleMixDown mix;
+            PeriodSink msink;
+
+            SineOscillator cosc1(440);
+            SineOscillator cosc2(220);
+            BiquadFilter cfilt(FilterType::LowPass, 2000, 0, 2);
+            ModuleMixDown cmix;
+            PeriodSink csink;
+
+            msink.bind(&mix);
+            mix.bind(&osc1);
+            mix.bind(&filt)->bind(&osc2);
+
+            csink.bind(&cmix);
+            cmix.bind(&cosc1);
+            cmix.bind(&cfilt)->bind(&cosc2);
+
+            if (concurrent) {
+
+                mix.set_executor(&pool);
+                cmix.set_executor(&pool);
+            }
+
+            msink.meta_info_sync();
+            msink.meta_start();
+
+            csink.meta_info_sync();
+            csink.meta_start();
+
+            REQUIRE(warm_chain(&msink, 3) == 3);
+
+            // The blocks after warming must match the cold chain:
+
+            for (int block = 0; block < 3; ++block) {
+
+                mix.meta_process();
+                cmix.meta_process();
+
+                auto warm = mix.get_buffer();
+                auto cold = cmix.get_buffer();
+
+                REQUIRE(warm->size() == cold->size());
+
+                for (std::size_t i = 0; i < warm->size(); ++i) {
+
+                    REQUIRE(warm->at(i) == cold->at(i));
+                }
+            }
+
+            msink.meta_stop();
+            csink.meta_stop();
+        }
+    }
+
+#ifdef __linux__
+
+    SECTION("Pin", "Ensures we can pin a thread to a CPU") {
+
+        RTConfig config;
+
+        config.cpu = 0;
+
+        engine.set_config(config);
+
+        REQUIRE(engine.run(1).pinned);
+    }
+
+#endif
+
+    SECTION("Thread", "Ensures we can run a chain on a dedicated thread") {
+
+        engine.start();
+
+        REQUIRE(engine.is_running());
+
+        // Give the thread some time to process:
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+        engine.stop();
+
+        REQUIRE(!engine.is_running());
+        REQUIRE(late.processed() > 0);
+    }
+}
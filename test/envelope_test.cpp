@@ -13,6 +13,7 @@
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 
 #include <cmath>
+#include <limits>
 
 #include "envelope.hpp"
 
@@ -170,7 +171,7 @@ TEST_CASE("ConstantEnvelope Test", "[env]") {
 
         // Set the start value:
 
-        const long double value = 0.5;
+        const sample_t value = 0.5;
 
         cnst.set_start_value(value);
 
@@ -190,6 +191,11 @@ TEST_CASE("ConstantEnvelope Test", "[env]") {
 
         REQUIRE(440 == buff->size());
 
+        // Ensure the buffer is marked as constant:
+
+        REQUIRE(buff->is_constant());
+        REQUIRE(buff->get_constant() == value);
+
         // Ensure values are correct:
 
         for (auto& val : *buff) {
@@ -240,7 +246,7 @@ TEST_CASE("ExponentialRamp Test", "[env]") {
 
         // Final value to ramp to:
 
-        const long double final_value = 1;
+        const sample_t final_value = 1;
 
         // Set some values:
 
@@ -250,8 +256,8 @@ TEST_CASE("ExponentialRamp Test", "[env]") {
         exp.get_info()->out_buffer = 1000;
         exp.get_timer()->set_samplerate(1000);
 
-        long double last = -1;
-        long double delta = 0;
+        sample_t last = -1;
+        sample_t delta = 0;
 
         for (int i = 0; i < seconds; ++i) {
 
@@ -299,7 +305,7 @@ TEST_CASE("ExponentialRamp Test", "[env]") {
 
         // Final value to ramp to:
 
-        const long double final_value = 1;
+        const sample_t final_value = 1;
 
         // Set some values:
 
@@ -309,8 +315,8 @@ TEST_CASE("ExponentialRamp Test", "[env]") {
         exp.get_info()->out_buffer = 5000;
         exp.get_timer()->set_samplerate(1000);
 
-        long double last = -1;
-        long double delta = 0;
+        sample_t last = -1;
+        sample_t delta = 0;
 
         for (int i = 0; i < seconds / 5; ++i) {
 
@@ -330,7 +336,10 @@ TEST_CASE("ExponentialRamp Test", "[env]") {
 
                 REQUIRE(*iter > last);
 
-                if (last != -1) {
+                // Deltas this small can only be resolved
+                // when working with double precision or greater:
+
+                if (last != -1 && std::numeric_limits<sample_t>::digits >= std::numeric_limits<double>::digits) {
 
                     // Ensure delta is correct, should always be bigger:
                     // Not a super great way to ensure this ramp is truly
@@ -350,6 +359,49 @@ TEST_CASE("ExponentialRamp Test", "[env]") {
 
         REQUIRE_THAT(last, Catch::Matchers::WithinAbs(final_value, 0.05));
     }
+
+    SECTION("Closed Form", "Ensures values match the closed form across blocks") {
+
+        exp.set_start_value(0.01);
+        exp.set_stop_time(NANO);
+        exp.set_stop_value(1);
+        exp.get_info()->out_buffer = 100;
+        exp.get_timer()->set_samplerate(1000);
+
+        for (int block = 0; block < 10; ++block) {
+
+            exp.meta_process();
+
+            auto buff = exp.get_buffer();
+
+            for (int i = 0; i < 100; ++i) {
+
+                const double t = (block * 100 + i) / 1000.0;
+
+                REQUIRE_THAT(buff->at(i), Catch::Matchers::WithinRel(0.01 * std::pow(100.0, t), 1e-5));
+            }
+        }
+    }
+
+    SECTION("Finished", "Ensures the stop value is held once finished") {
+
+        exp.set_start_value(0.01);
+        exp.set_stop_time(NANO / 10);
+        exp.set_stop_value(1);
+        exp.get_info()->out_buffer = 150;
+        exp.get_timer()->set_samplerate(1000);
+
+        exp.meta_process();
+
+        auto buff = exp.get_buffer();
+
+        REQUIRE(buff->at(99) < 1);
+
+        for (int i = 100; i < 150; ++i) {
+
+            REQUIRE(buff->at(i) == 1);
+        }
+    }
 }
 
 TEST_CASE("LinearRamp Test", "[env]") {
@@ -370,7 +422,7 @@ TEST_CASE("LinearRamp Test", "[env]") {
 
         // Final value to ramp to:
 
-        const long double final_value = 1;
+        const sample_t final_value = 1;
 
         // Set some values:
 
@@ -380,8 +432,8 @@ TEST_CASE("LinearRamp Test", "[env]") {
         lin.get_info()->out_buffer = 1000;
         lin.get_timer()->set_samplerate(1000);
 
-        long double last = 0;
-        long double delta = 0;
+        sample_t last = 0;
+        sample_t delta = 0;
 
         for (int i = 0; i < seconds; ++i) {
 
@@ -431,7 +483,7 @@ TEST_CASE("LinearRamp Test", "[env]") {
 
         // Final value to ramp to:
 
-        const long double final_value = 1;
+        const sample_t final_value = 1;
 
         // Set some values:
 
@@ -441,8 +493,8 @@ TEST_CASE("LinearRamp Test", "[env]") {
         lin.get_info()->out_buffer = 5000;
         lin.get_timer()->set_samplerate(1000);
 
-        long double last = 0;
-        long double delta = 0;
+        sample_t last = 0;
+        sample_t delta = 0;
 
         for (int i = 0; i < seconds / 5; ++i) {
 
@@ -479,6 +531,26 @@ TEST_CASE("LinearRamp Test", "[env]") {
 
         REQUIRE_THAT(last, Catch::Matchers::WithinAbs(final_value, 0.05));
     }
+
+    SECTION("Finished", "Ensures the stop value is held once finished") {
+
+        lin.set_start_value(0);
+        lin.set_stop_time(NANO / 10);
+        lin.set_stop_value(1);
+        lin.get_info()->out_buffer = 150;
+        lin.get_timer()->set_samplerate(1000);
+
+        lin.meta_process();
+
+        auto buff = lin.get_buffer();
+
+        REQUIRE_THAT(buff->at(50), Catch::Matchers::WithinAbs(0.5, 1e-6));
+
+        for (int i = 100; i < 150; ++i) {
+
+            REQUIRE(buff->at(i) == 1);
+        }
+    }
 }
 
 TEST_CASE("SetValue Test", "[env]") {
@@ -499,7 +571,7 @@ TEST_CASE("SetValue Test", "[env]") {
 
         // Final value to ramp to:
 
-        const long double final_value = 1;
+        const sample_t final_value = 1;
 
         // Set some values:
 
@@ -549,7 +621,7 @@ TEST_CASE("SetValue Test", "[env]") {
 
         // Final value to ramp to:
 
-        const long double final_value = 1;
+        const sample_t final_value = 1;
 
         // Set some values:
 
@@ -927,14 +999,14 @@ TEST_CASE("ChainEnvelope", "[env]") {
         const int64_t time3_start = 0;
         const int64_t time3_stop = 0;
 
-        const long double value1_start = 0;
-        const long double value1_stop = 0;
+        const sample_t value1_start = 0;
+        const sample_t value1_stop = 0;
 
-        const long double value2_start = 0;
-        const long double value2_stop = 0;
+        const sample_t value2_start = 0;
+        const sample_t value2_stop = 0;
 
-        const long double value3_start = 0;
-        const long double value3_stop = 0;
+        const sample_t value3_start = 0;
+        const sample_t value3_stop = 0;
 
         const int loops = std::ceil(
             time3_stop / sample_rate);  // By default, we loop until complete
@@ -1019,3 +1091,126 @@ TEST_CASE("ChainEnvelope", "[env]") {
         }
     }
 }
+
+TEST_CASE("ADSREnvelope Test", "[env]") {
+
+    ADSREnvelope env(NANO, NANO * 2, 0.5, NANO);
+
+    env.get_timer()->set_samplerate(100);
+    env.get_info()->out_buffer = 100;
+
+    SECTION("Start", "Ensures we begin with the attack") {
+
+        env.start();
+
+        REQUIRE(env.get_current() != nullptr);
+        REQUIRE(env.get_current()->get_stop_value() == 1);
+    }
+
+    SECTION("Stages", "Ensures we ramp through the attack and decay to the sustain") {
+
+        env.start();
+
+        // Attack ramps up to one:
+
+        env.meta_process();
+
+        auto buff = env.get_buffer();
+
+        REQUIRE_THAT(buff->at(0), Catch::Matchers::WithinAbs(0, 0.0001));
+        REQUIRE(buff->at(99) > buff->at(50));
+        REQUIRE(buff->at(50) > buff->at(0));
+
+        // Decay ramps down to the sustain:
+
+        env.meta_process();
+
+        buff = env.get_buffer();
+
+        REQUIRE_THAT(buff->at(0), Catch::Matchers::WithinAbs(1, 0.0001));
+        REQUIRE(buff->at(99) < buff->at(0));
+
+        // Sustain holds:
+
+        env.meta_process();
+
+        buff = env.get_buffer();
+
+        for (auto val : *buff) {
+
+            REQUIRE_THAT(val, Catch::Matchers::WithinAbs(0.5, 0.0001));
+        }
+    }
+
+    SECTION("Release", "Ensures we ramp to zero once finished, then stay silent") {
+
+        env.start();
+
+        // Run through the attack and decay:
+
+        env.meta_process();
+        env.meta_process();
+
+        REQUIRE(!env.get_buffer()->is_constant());
+
+        // Sustain holds a single value:
+
+        env.meta_process();
+
+        auto buff = env.get_buffer();
+
+        REQUIRE(buff->is_constant());
+        REQUIRE_THAT(buff->get_constant(), Catch::Matchers::WithinAbs(0.5, 0.0001));
+
+        // Release ramps down to zero:
+
+        env.finish();
+
+        REQUIRE(env.get_state() == BaseModule::State::Finishing);
+
+        env.meta_process();
+
+        buff = env.get_buffer();
+
+        REQUIRE(!buff->is_constant());
+        REQUIRE_THAT(buff->at(0), Catch::Matchers::WithinAbs(0.5, 0.0001));
+        REQUIRE_THAT(buff->at(50), Catch::Matchers::WithinAbs(0.25, 0.0001));
+        REQUIRE(buff->at(99) < buff->at(50));
+
+        // Once the release is over, we are done and silent:
+
+        env.meta_process();
+
+        buff = env.get_buffer();
+
+        REQUIRE(buff->is_silent());
+        REQUIRE(env.get_state() == BaseModule::State::Finished);
+
+        for (auto val : *buff) {
+
+            REQUIRE(val == 0);
+        }
+    }
+
+    SECTION("Fractional", "Ensures stages end when frames are not a whole number of nanoseconds") {
+
+        ADSREnvelope fenv(NANO / 100, NANO / 5, 0.4, NANO / 4);
+
+        fenv.get_timer()->set_samplerate(48000);
+        fenv.get_info()->out_buffer = 256;
+
+        fenv.start();
+
+        for (int i = 0; i < 64; ++i) {
+
+            fenv.meta_process();
+        }
+
+        auto buff = fenv.get_buffer();
+
+        for (auto val : *buff) {
+
+            REQUIRE_THAT(val, Catch::Matchers::WithinAbs(0.4, 0.0001));
+        }
+    }
+}
@@ -0,0 +1,152 @@
+/**
+ * @file event_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for chain events
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+#include "amp_module.hpp"
+#include "dsp/denormal.hpp"
+#include "event.hpp"
+#include "meta_audio.hpp"
+#include "sink_module.hpp"
+
+namespace {
+
+/**
+ * @brief Module that records the events it receives
+ */
+class EventRecorder : public AudioModule {
+
+    public:
+
+        /// Events we have received
+        std::vector<Event> received;
+
+        void on_event(const Event& event) override { this->received.push_back(event); }
+};
+
+}  // namespace
+
+TEST_CASE("EventQueue Test", "[event]") {
+
+    EventQueue queue;
+
+    EventRecorder mod1;
+    EventRecorder mod2;
+
+    SECTION("Order", "Ensures events are dispatched in time order") {
+
+        queue.push(Event{20, &mod1, EventType::Parameter, 0, 2});
+        queue.push(Event{10, &mod1, EventType::Parameter, 0, 1});
+        queue.push(Event{20, &mod1, EventType::Parameter, 0, 3});
+        queue.push(Event{15, &mod2, EventType::NoteOn, 0, 0});
+
+        REQUIRE(queue.size() == 4);
+
+        REQUIRE(queue.dispatch(&mod1, 30) == 3);
+
+        REQUIRE(mod1.received.size() == 3);
+        REQUIRE(mod1.received.at(0).value == 1);
+        REQUIRE(mod1.received.at(1).value == 2);
+        REQUIRE(mod1.received.at(2).value == 3);
+
+        // Other modules should not be touched:
+
+        REQUIRE(mod2.received.empty());
+        REQUIRE(queue.size() == 1);
+    }
+
+    SECTION("Next", "Ensures the next event for a module is found") {
+
+        queue.push(Event{5, &mod2, EventType::NoteOn, 0, 0});
+        queue.push(Event{10, &mod1, EventType::NoteOn, 0, 0});
+
+        REQUIRE(queue.next(&mod1, 0, 100) == 10);
+        REQUIRE(queue.next(&mod1, 10, 100) == 100);
+        REQUIRE(queue.next(&mod1, 0, 8) == 8);
+        REQUIRE(queue.next(&mod2, 0, 100) == 5);
+    }
+
+    SECTION("Remove", "Ensures events for a module can be removed") {
+
+        queue.push(Event{5, &mod2, EventType::NoteOn, 0, 0});
+        queue.push(Event{10, &mod1, EventType::NoteOn, 0, 0});
+
+        queue.remove(&mod1);
+
+        REQUIRE(queue.size() == 1);
+        REQUIRE(queue.next(&mod1, 0, 100) == 100);
+    }
+}
+
+TEST_CASE("Chain Event Test", "[event]") {
+
+    // Started sinks flush denormals, restore the mode of this thread once we are done:
+
+    const FlushToZeroScope ftz(flush_to_zero());
+
+    ConstModule source(1);
+    AmplitudeScale scale(1);
+    PeriodSink sink;
+
+    sink.bind(&scale);
+    scale.bind(&source);
+
+    sink.get_chain_info()->buffer_size = 100;
+
+    sink.meta_info_sync();
+    sink.meta_start();
+
+    SECTION("Split", "Ensures events take effect on the correct sample") {
+
+        scale.schedule(EventType::Parameter, 30, 0, 0.5);
+        scale.schedule(EventType::Parameter, 150, 0, 2);
+
+        sink.meta_process();
+
+        auto buff = sink.get_buffer();
+
+        for (int i = 0; i < 100; ++i) {
+
+            REQUIRE(buff->at(i) == (i < 30 ? 1 : 0.5));
+        }
+
+        REQUIRE(sink.get_chain_info()->sample == 100);
+
+        sink.meta_process();
+
+        buff = sink.get_buffer();
+
+        for (int i = 0; i < 100; ++i) {
+
+            REQUIRE(buff->at(i) == (i < 50 ? 0.5 : 2));
+        }
+
+        REQUIRE(sink.get_chain_info()->events.empty());
+    }
+
+    SECTION("Late", "Ensures events in the past are handled at the start of the block") {
+
+        sink.meta_process();
+
+        scale.schedule(EventType::Parameter, 10, 0, 0.25);
+
+        sink.meta_process();
+
+        auto buff = sink.get_buffer();
+
+        for (auto val : *buff) {
+
+            REQUIRE(val == 0.25);
+        }
+    }
+}
@@ -0,0 +1,791 @@
+/**
+ * @file filter_module_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for filter modules
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "filter_module.hpp"
+#include "meta_audio.hpp"
+
+// Kernel to test with
+const std::vector<sample_t> filter_kernel = {0.5, 0.25, -0.125, 0.0625, 1, -1, 0.3};
+
+// Input to test with
+const std::vector<sample_t> filter_input = {1, -2, 3, 4, -5, 6, 7, 8, -9, 10, 11, 12, -13, 14, 15, 16};
+
+TEST_CASE("BaseConvFilter Test", "[filter]") {
+
+    BaseConvFilter filt;
+
+    filt.set_kernel(std::make_unique<AudioBuffer>(filter_kernel.begin(), filter_kernel.end()));
+
+    // Determine expected output:
+
+    std::vector<sample_t> expected(length_conv(filter_input.size(), filter_kernel.size()));
+
+    input_conv(filter_input.begin(), filter_input.size(), filter_kernel.begin(), filter_kernel.size(), expected.begin());
+
+    SECTION("Mode", "Ensures the mode getter/setter is correct") {
+
+        REQUIRE(filt.get_mode() == ConvMode::Direct);
+
+        filt.set_mode(ConvMode::OverlapSave);
+
+        REQUIRE(filt.get_mode() == ConvMode::OverlapSave);
+    }
+
+    SECTION("Direct", "Ensures direct convolution outputs the full result") {
+
+        filt.start();
+
+        filt.set_buffer(std::make_unique<AudioBuffer>(filter_input.begin(), filter_input.end()));
+        filt.process();
+
+        auto buff = filt.get_buffer();
+
+        REQUIRE(buff->size() == expected.size());
+
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+
+            REQUIRE_THAT(buff->at(i), Catch::Matchers::WithinAbs(expected.at(i), 1e-4));
+        }
+    }
+
+    SECTION("Streaming", "Ensures streaming filtering carries the tail between blocks") {
+
+        const int block = 3;
+
+        filt.set_mode(ConvMode::Streaming);
+        filt.get_info()->in_buffer = block;
+        filt.start();
+
+        std::size_t done = 0;
+
+        while (done < filter_input.size()) {
+
+            // Send the block through the filter, last block may be smaller:
+
+            const std::size_t num = std::min<std::size_t>(block, filter_input.size() - done);
+
+            filt.set_buffer(std::make_unique<AudioBuffer>(filter_input.begin() + done, filter_input.begin() + done + num));
+            filt.process();
+
+            auto buff = filt.get_buffer();
+
+            // Ensure block is the correct size and value:
+
+            REQUIRE(buff->size() == num);
+
+            for (std::size_t i = 0; i < num; ++i) {
+
+                REQUIRE_THAT(buff->at(i), Catch::Matchers::WithinAbs(expected.at(done + i), 1e-4));
+            }
+
+            done += num;
+        }
+    }
+
+    SECTION("OverlapSave", "Ensures overlap-save filtering streams blocks correctly") {
+
+        const int block = 4;
+
+        filt.set_mode(ConvMode::OverlapSave);
+        filt.get_info()->in_buffer = block;
+        filt.start();
+
+        for (std::size_t done = 0; done < filter_input.size(); done += block) {
+
+            // Send the block through the filter:
+
+            filt.set_buffer(std::make_unique<AudioBuffer>(filter_input.begin() + done, filter_input.begin() + done + block));
+            filt.process();
+
+            auto buff = filt.get_buffer();
+
+            // Ensure block is the correct size and value:
+
+            REQUIRE(buff->size() == block);
+
+            for (int i = 0; i < block; ++i) {
+
+                REQUIRE_THAT(buff->at(i), Catch::Matchers::WithinAbs(expected.at(done + i), 1e-4));
+            }
+        }
+    }
+
+    SECTION("Tail", "Ensures silence is skipped once the tail has decayed") {
+
+        const int block = 4;
+
+        filt.set_mode(ConvMode::Streaming);
+        filt.get_info()->in_buffer = block;
+        filt.start();
+
+        for (std::size_t done = 0; done < filter_input.size(); done += block) {
+
+            filt.set_buffer(std::make_unique<AudioBuffer>(filter_input.begin() + done, filter_input.begin() + done + block));
+            filt.process();
+        }
+
+        // The tail rings out over the first silent blocks:
+
+        const int tail = static_cast<int>(filter_kernel.size());
+
+        for (int done = 0; done < tail + block; done += block) {
+
+            auto silence = std::make_unique<AudioBuffer>(block);
+
+            silence->fill_constant(0);
+
+            filt.set_buffer(std::move(silence));
+            filt.process();
+
+            auto buff = filt.get_buffer();
+
+            // Ensure we only mark the output once the tail has passed:
+
+            REQUIRE(buff->is_silent() == (done >= tail));
+
+            for (int i = 0; i < block; ++i) {
+
+                const std::size_t index = filter_input.size() + done + i;
+                const sample_t want = index < expected.size() ? expected.at(index) : 0;
+
+                REQUIRE_THAT(buff->at(i), Catch::Matchers::WithinAbs(want, 1e-4));
+            }
+        }
+
+        // Sound after the silence picks up where we left off:
+
+        filt.set_buffer(std::make_unique<AudioBuffer>(filter_input.begin(), filter_input.begin() + block));
+        filt.process();
+
+        auto buff = filt.get_buffer();
+
+        REQUIRE(!buff->is_constant());
+
+        for (int i = 0; i < block; ++i) {
+
+            REQUIRE_THAT(buff->at(i), Catch::Matchers::WithinAbs(expected.at(i), 1e-4));
+        }
+    }
+
+    SECTION("Shared", "Ensures many filters can share one kernel") {
+
+        BaseConvFilter other;
+
+        other.set_kernel(filt.get_kernel());
+
+        // Kernel should be retained and shared:
+
+        REQUIRE(filt.get_kernel() == other.get_kernel());
+        REQUIRE(filt.get_kernel().use_count() == 3);
+
+        // Process multiple times, ensuring kernel is not lost:
+
+        filt.start();
+        other.start();
+
+        for (int i = 0; i < 3; ++i) {
+
+            for (auto* fil : {&filt, &other}) {
+
+                fil->set_buffer(std::make_unique<AudioBuffer>(filter_input.begin(), filter_input.end()));
+                fil->process();
+
+                auto buff = fil->get_buffer();
+
+                REQUIRE(buff->size() == expected.size());
+
+                for (std::size_t j = 0; j < expected.size(); ++j) {
+
+                    REQUIRE_THAT(buff->at(j), Catch::Matchers::WithinAbs(expected.at(j), 1e-4));
+                }
+            }
+        }
+
+        REQUIRE(filt.get_kernel() != nullptr);
+    }
+}
+
+TEST_CASE("SincFilter Test", "[filter]") {
+
+    const double rate = 44100;
+
+    SincFilter filt;
+
+    filt.set_type(FilterType::LowPass);
+    filt.set_start_freq(rate / 8);
+    filt.set_size(31);
+    filt.set_mode(ConvMode::Streaming);
+
+    sinc_cache_clear();
+
+    SECTION("Design", "Ensures kernels are designed and shared") {
+
+        filt.start();
+
+        // Low pass kernels are normalized:
+
+        auto kern = filt.get_kernel();
+
+        REQUIRE(kern->size() == 31);
+
+        sample_t sum = 0;
+
+        for (auto val : kern->span()) {
+
+            sum += val;
+        }
+
+        REQUIRE_THAT(sum, Catch::Matchers::WithinAbs(1, 1e-4));
+
+        // Another filter with the same design shares the kernel:
+
+        SincFilter other;
+
+        other.set_type(FilterType::LowPass);
+        other.set_start_freq(rate / 8);
+        other.set_size(31);
+        other.start();
+
+        REQUIRE(other.get_kernel() == kern);
+        REQUIRE(sinc_cache_size() == 1);
+
+        // A different window is a different design:
+
+        other.set_window(WindowType::Hann);
+        other.start();
+
+        REQUIRE(other.get_kernel() != kern);
+        REQUIRE(sinc_cache_size() == 2);
+
+        sinc_cache_clear();
+
+        REQUIRE(sinc_cache_size() == 0);
+        REQUIRE(kern->size() == 31);
+    }
+
+    SECTION("Retune", "Ensures retuning when stopped is used at the next start") {
+
+        filt.retune(rate / 4, 0);
+
+        REQUIRE(filt.get_start_freq() == rate / 4);
+
+        filt.start();
+
+        REQUIRE(filt.get_kernel() == sinc_design(FilterType::LowPass, 31, 0.25, 0));
+    }
+
+    auto sweep = [&](ConvMode mode) {
+
+        filt.set_mode(mode);
+        filt.set_dynamic(true);
+
+        filt.get_info()->in_buffer = 64;
+        filt.get_info()->out_buffer = 64;
+
+        filt.start();
+
+        auto block = [&]() {
+
+            auto buff = std::make_unique<AudioBuffer>(64, 1);
+
+            for (int i = 0; i < 64; ++i) {
+
+                buff->at(i) = static_cast<sample_t>(i % 7) / 7;
+            }
+
+            filt.set_buffer(std::move(buff));
+            filt.process();
+        };
+
+        block();
+
+        auto first = filt.get_kernel();
+
+        filt.retune(rate / 16, 0);
+
+        while (filt.get_designs() == 0) {
+
+            std::this_thread::yield();
+        }
+
+        // The next block fades to the new kernel:
+
+        block();
+
+        REQUIRE(filt.get_kernel() != first);
+        REQUIRE(filt.get_kernel() == sinc_design(FilterType::LowPass, 31, 1.0 / 16, 0));
+
+        // Output matches a filter started with the new design:
+
+        SincFilter ref;
+
+        ref.set_type(FilterType::LowPass);
+        ref.set_start_freq(rate / 16);
+        ref.set_size(31);
+        ref.set_mode(mode);
+        ref.get_info()->in_buffer = 64;
+        ref.get_info()->out_buffer = 64;
+        ref.start();
+
+        for (int b = 0; b < 3; ++b) {
+
+            auto input = std::make_unique<AudioBuffer>(64, 1);
+
+            for (int i = 0; i < 64; ++i) {
+
+                input->at(i) = static_cast<sample_t>(i % 7) / 7;
+            }
+
+            ref.set_buffer(std::make_unique<AudioBuffer>(*input));
+            ref.process();
+
+            filt.set_buffer(std::move(input));
+            filt.process();
+        }
+
+        auto out = filt.get_buffer();
+        auto expected = ref.get_buffer();
+
+        for (int i = 0; i < 64; ++i) {
+
+            REQUIRE_THAT(out->at(i), Catch::Matchers::WithinAbs(expected->at(i), 1e-4));
+        }
+
+        filt.stop();
+
+        // Stopping keeps the retuned frequency:
+
+        REQUIRE(filt.get_start_freq() == rate / 16);
+    };
+
+    SECTION("Streaming", "Ensures streaming filters fade to new designs") {
+
+        sweep(ConvMode::Streaming);
+    }
+
+    SECTION("OverlapSave", "Ensures overlap-save filters fade to new designs") {
+
+        sweep(ConvMode::OverlapSave);
+    }
+}
+
+TEST_CASE("PartitionedConvFilter Test", "[filter]") {
+
+    PartitionedConvFilter filt;
+
+    filt.set_kernel(std::make_unique<AudioBuffer>(filter_kernel.begin(), filter_kernel.end()));
+
+    // Determine expected output:
+
+    std::vector<sample_t> expected(length_conv(filter_input.size(), filter_kernel.size()));
+
+    input_conv(filter_input.begin(), filter_input.size(), filter_kernel.begin(), filter_kernel.size(), expected.begin());
+
+    SECTION("Streaming", "Ensures full blocks are convolved") {
+
+        const int block = 2;
+
+        filt.get_info()->in_buffer = block;
+        filt.get_info()->out_buffer = block;
+        filt.start();
+
+        REQUIRE(filt.get_partitions() == 4);
+
+        for (std::size_t done = 0; done < filter_input.size(); done += block) {
+
+            // Send the block through the filter:
+
+            filt.set_buffer(std::make_unique<AudioBuffer>(filter_input.begin() + done, filter_input.begin() + done + block));
+            filt.process();
+
+            auto buff = filt.get_buffer();
+
+            REQUIRE(buff->size() == block);
+
+            for (int i = 0; i < block; ++i) {
+
+                REQUIRE_THAT(buff->at(i), Catch::Matchers::WithinAbs(expected.at(done + i), 1e-4));
+            }
+        }
+    }
+
+    SECTION("Variable", "Ensures blocks smaller than the buffer size are convolved") {
+
+        filt.get_info()->in_buffer = 4;
+        filt.get_info()->out_buffer = 4;
+        filt.start();
+
+        REQUIRE(filt.get_partitions() == 2);
+
+        const std::vector<int> sizes = {1, 3, 2, 4, 1, 1, 4};
+
+        std::size_t done = 0;
+
+        for (const int size : sizes) {
+
+            // Send the block through the filter:
+
+            filt.set_buffer(std::make_unique<AudioBuffer>(filter_input.begin() + done, filter_input.begin() + done + size));
+            filt.process();
+
+            auto buff = filt.get_buffer();
+
+            REQUIRE(buff->size() == static_cast<std::size_t>(size));
+
+            for (int i = 0; i < size; ++i) {
+
+                REQUIRE_THAT(buff->at(i), Catch::Matchers::WithinAbs(expected.at(done + i), 1e-4));
+            }
+
+            done += size;
+        }
+
+        REQUIRE(done == filter_input.size());
+    }
+}
+
+TEST_CASE("MultiConvFilter Test", "[filter]") {
+
+    const int channels = 4;
+
+    MultiConvFilter filt;
+
+    // Channels 0 and 2 use the default, 1 and 3 use matching kernels:
+
+    const std::vector<sample_t> other = {1, -0.5, 0.25};
+
+    filt.set_kernel(std::make_unique<AudioBuffer>(filter_kernel.begin(), filter_kernel.end()));
+    filt.set_channel_kernel(1, std::make_unique<AudioBuffer>(other.begin(), other.end()));
+    filt.set_channel_kernel(3, std::make_unique<AudioBuffer>(other.begin(), other.end()));
+
+    filt.get_info()->channels = channels;
+
+    // Determine expected output of each kernel:
+
+    std::vector<sample_t> first(length_conv(filter_input.size(), filter_kernel.size()));
+    std::vector<sample_t> second(length_conv(filter_input.size(), other.size()));
+
+    input_conv(filter_input.begin(), filter_input.size(), filter_kernel.begin(), filter_kernel.size(), first.begin());
+    input_conv(filter_input.begin(), filter_input.size(), other.begin(), other.size(), second.begin());
+
+    // Runs blocks of the given sizes through a filter with the given buffer size:
+
+    auto run = [&](int size, const std::vector<int>& blocks) {
+
+        filt.get_info()->in_buffer = size;
+        filt.get_info()->out_buffer = size;
+        filt.start();
+
+        REQUIRE(filt.get_unique_kernels() == 2);
+        REQUIRE(filt.get_partitions(0) == (static_cast<int>(filter_kernel.size()) + size - 1) / size);
+        REQUIRE(filt.get_partitions(1) == (static_cast<int>(other.size()) + size - 1) / size);
+
+        std::size_t done = 0;
+
+        for (const int block : blocks) {
+
+            // Each channel is scaled by its index plus one:
+
+            auto buff = std::make_unique<AudioBuffer>(block, channels);
+
+            for (int c = 0; c < channels; ++c) {
+
+                for (int i = 0; i < block; ++i) {
+
+                    buff->at(c, i) = filter_input.at(done + i) * static_cast<sample_t>(c + 1);
+                }
+            }
+
+            filt.set_buffer(std::move(buff));
+            filt.process();
+
+            auto out = filt.get_buffer();
+
+            for (int c = 0; c < channels; ++c) {
+
+                const auto& expected = c % 2 == 0 ? first : second;
+
+                for (int i = 0; i < block; ++i) {
+
+                    REQUIRE_THAT(out->at(c, i), Catch::Matchers::WithinAbs(expected.at(done + i) * (c + 1), 1e-3));
+                }
+            }
+
+            done += block;
+        }
+
+        REQUIRE(done == filter_input.size());
+    };
+
+    const std::vector<int> full(filter_input.size() / 2, 2);
+    const std::vector<int> partial = {1, 3, 2, 4, 1, 1, 4};
+
+    SECTION("Serial", "Ensures each channel is convolved with its kernel") {
+
+        run(2, full);
+    }
+
+    SECTION("Variable", "Ensures blocks smaller than the buffer size are convolved") {
+
+        run(4, partial);
+    }
+
+    SECTION("Concurrent", "Ensures channels can be convolved on a pool") {
+
+        WorkerPool pool(2);
+
+        filt.set_executor(&pool);
+
+        run(2, full);
+        run(4, partial);
+
+        REQUIRE(filt.get_executor() == &pool);
+    }
+}
+
+TEST_CASE("BiquadFilter Test", "[filter]") {
+
+    const int channels = 6;
+    const int frames = 256;
+
+    BiquadFilter filt(FilterType::HighPass, 2000, 0, 4);
+
+    filt.get_info()->channels = channels;
+
+    SECTION("Config", "Ensures the design parameters are kept") {
+
+        REQUIRE(filt.get_order() == 4);
+        REQUIRE(filt.get_prototype() == IIRPrototype::Butterworth);
+        REQUIRE(filt.in_place());
+
+        filt.set_prototype(IIRPrototype::Chebyshev);
+        filt.set_ripple(0.5);
+
+        REQUIRE(filt.get_prototype() == IIRPrototype::Chebyshev);
+        REQUIRE(filt.get_ripple() == 0.5);
+
+        filt.start();
+
+        REQUIRE(filt.get_sections().size() == 2);
+    }
+
+    SECTION("Channels", "Ensures every channel is filtered with its own state") {
+
+        filt.start();
+
+        const auto sections = iir_design(IIRPrototype::Butterworth, FilterType::HighPass, 4, 2000.0 / SAMPLE_RATE, 2000.0 / SAMPLE_RATE);
+
+        std::vector<BiquadCascade<sample_t>> refs(channels);
+
+        for (auto& ref : refs) {
+
+            ref.set_sections(sections);
+        }
+
+        for (int block = 0; block < 3; ++block) {
+
+            auto buff = std::make_unique<AudioBuffer>(frames, channels);
+
+            std::vector<std::vector<sample_t>> expected(channels, std::vector<sample_t>(frames));
+
+            for (int c = 0; c < channels; ++c) {
+
+                for (int f = 0; f < frames; ++f) {
+
+                    const auto val = static_cast<sample_t>(std::sin(0.05 * (c + 1) * (block * frames + f)));
+
+                    buff->at(c, f) = val;
+                    expected[c][f] = val;
+                }
+
+                refs[c].process(expected[c].data(), frames);
+            }
+
+            filt.set_buffer(std::move(buff));
+            filt.process();
+
+            auto out = filt.get_buffer();
+
+            for (int c = 0; c < channels; ++c) {
+
+                for (int f = 0; f < frames; ++f) {
+
+                    REQUIRE_THAT(out->at(c, f), Catch::Matchers::WithinAbs(expected[c][f], 1e-5));
+                }
+            }
+        }
+    }
+
+    SECTION("Silence", "Ensures silence is passed through once the filter has rung out") {
+
+        filt.start();
+
+        auto buff = std::make_unique<AudioBuffer>(frames, channels);
+
+        std::ranges::fill(buff->span(), 1);
+
+        filt.set_buffer(std::move(buff));
+        filt.process();
+
+        // Feed silence until the tail decays:
+
+        bool silent = false;
+
+        for (int block = 0; block < 64 && !silent; ++block) {
+
+            auto quiet = std::make_unique<AudioBuffer>(frames, channels);
+
+            quiet->fill_constant(0);
+
+            filt.set_buffer(std::move(quiet));
+            filt.process();
+
+            auto out = filt.get_buffer();
+
+            silent = out->is_silent();
+
+            // The tail must still be present until we mark silence:
+
+            if (block == 0) {
+
+                REQUIRE(!silent);
+                REQUIRE(std::ranges::any_of(out->span(), [](sample_t val) { return val != 0; }));
+            }
+        }
+
+        REQUIRE(silent);
+    }
+}
+
+TEST_CASE("ModulatedFilter Test", "[filter]") {
+
+    const int channels = 2;
+    const int frames = 128;
+
+    ModulatedFilter filt(FilterType::LowPass, 1000);
+
+    filt.get_info()->channels = channels;
+    filt.get_info()->in_buffer = frames;
+
+    SECTION("Constant", "Ensures constant cutoffs are designed once") {
+
+        filt.start();
+
+        REQUIRE(filt.get_updates() == 1);
+        REQUIRE(filt.get_current() == 1000);
+
+        BiquadCascade<sample_t> ref;
+
+        ref.set_sections(std::vector<BiquadCoefficients<double>>{biquad_design(FilterType::LowPass, 1000.0 / SAMPLE_RATE)});
+
+        for (int block = 0; block < 3; ++block) {
+
+            auto buff = std::make_unique<AudioBuffer>(frames, channels);
+
+            std::vector<sample_t> expected(frames);
+
+            for (int f = 0; f < frames; ++f) {
+
+                const auto val = static_cast<sample_t>(std::sin(0.3 * (block * frames + f)));
+
+                buff->at(0, f) = val;
+                buff->at(1, f) = val;
+                expected[f] = val;
+            }
+
+            ref.process(expected.data(), frames);
+
+            filt.set_buffer(std::move(buff));
+            filt.process();
+
+            auto out = filt.get_buffer();
+
+            for (int f = 0; f < frames; ++f) {
+
+                REQUIRE_THAT(out->at(0, f), Catch::Matchers::WithinAbs(expected[f], 1e-5));
+                REQUIRE_THAT(out->at(1, f), Catch::Matchers::WithinAbs(expected[f], 1e-5));
+            }
+        }
+
+        REQUIRE(filt.get_updates() == 1);
+    }
+
+    SECTION("Modulated", "Ensures modulated cutoffs are smoothed, and only redesigned when moving") {
+
+        ConstModule source(500);
+
+        filt.get_cutoff()->bind(&source);
+        filt.get_cutoff()->conf_mod(&filt);
+
+        filt.set_interval(16);
+        filt.set_smoothing(0.002);
+        filt.start();
+
+        auto run = [&]() {
+
+            filt.set_buffer(std::make_unique<AudioBuffer>(frames, channels));
+            filt.process();
+            filt.get_buffer();
+        };
+
+        // First value is jumped to directly:
+
+        run();
+
+        REQUIRE(filt.get_current() == 500);
+
+        const auto settled = filt.get_updates();
+
+        run();
+
+        REQUIRE(filt.get_updates() == settled);
+
+        // Changes should be approached gradually:
+
+        source.set_value(2000);
+
+        double last = filt.get_current();
+
+        for (int block = 0; block < 4; ++block) {
+
+            run();
+
+            REQUIRE(filt.get_current() > last);
+            REQUIRE(filt.get_current() < 2000);
+
+            last = filt.get_current();
+        }
+
+        // Eventually we settle, and stop redesigning:
+
+        for (int block = 0; block < 50; ++block) {
+
+            run();
+        }
+
+        REQUIRE_THAT(filt.get_current(), Catch::Matchers::WithinRel(2000.0, 1e-3));
+
+        const auto done = filt.get_updates();
+
+        run();
+
+        REQUIRE(filt.get_updates() == done);
+    }
+}
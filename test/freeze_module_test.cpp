@@ -0,0 +1,164 @@
+/**
+ * @file freeze_module_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for freeze modules
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "freeze_module.hpp"
+#include "meta_audio.hpp"
+#include "module_param.hpp"
+#include "sink_module.hpp"
+
+#include <thread>
+#include <vector>
+
+TEST_CASE("FreezeModule Test", "[freeze]") {
+
+    ConstModule osc(0.5);
+    Counter count;
+    FreezeModule freeze;
+    PeriodSink sink;
+
+    count.bind(&osc);
+    freeze.bind(&count);
+    sink.bind(&freeze);
+
+    sink.meta_info_sync();
+
+    const int size = freeze.get_info()->out_buffer;
+
+    SECTION("Chain", "Ensures the sub-chain uses the freeze chain") {
+
+        REQUIRE(osc.get_chain_info() == freeze.get_freeze_chain());
+        REQUIRE(count.get_chain_info() == freeze.get_freeze_chain());
+
+        std::vector<AudioModule*> inputs;
+
+        REQUIRE(!freeze.plan_inputs(inputs));
+        REQUIRE(inputs.empty());
+    }
+
+    SECTION("Playback", "Ensures the sub-chain is rendered once") {
+
+        freeze.set_length(size * 2);
+
+        for (int i = 0; i < 10; ++i) {
+
+            freeze.meta_process();
+
+            auto buff = freeze.get_buffer();
+
+            REQUIRE(static_cast<int>(buff->size()) == size);
+
+            for (auto val : *buff) {
+
+                REQUIRE_THAT(val, Catch::Matchers::WithinAbs(0.5, 0.0001));
+            }
+        }
+
+        REQUIRE(freeze.frozen());
+        REQUIRE(freeze.get_renders() == 1);
+        REQUIRE(count.processed() == 2);
+    }
+
+    SECTION("Prepare", "Ensures the cache can be rendered before processing") {
+
+        freeze.set_length(size);
+
+        freeze.prepare();
+
+        REQUIRE(freeze.frozen());
+        REQUIRE(freeze.get_renders() == 1);
+
+        // The first block should not render again:
+
+        freeze.meta_process();
+
+        REQUIRE(freeze.get_renders() == 1);
+
+        freeze.prepare();
+
+        REQUIRE(freeze.get_renders() == 1);
+    }
+
+    SECTION("Once", "Ensures we go silent after the cache when not looping") {
+
+        freeze.set_length(size / 2);
+        freeze.set_loop(false);
+
+        freeze.meta_process();
+
+        auto buff = freeze.get_buffer();
+
+        for (int i = 0; i < size; ++i) {
+
+            REQUIRE_THAT(buff->at(i), Catch::Matchers::WithinAbs(i < size / 2 ? 0.5 : 0, 0.0001));
+        }
+
+        REQUIRE(freeze.tell() == size / 2);
+    }
+
+    SECTION("Loop", "Ensures the cache wraps around") {
+
+        osc.set_value(0.25);
+
+        freeze.set_length(3);
+
+        freeze.meta_process();
+
+        REQUIRE(freeze.tell() == size % 3);
+        REQUIRE_THAT(freeze.get_buffer()->at(size - 1), Catch::Matchers::WithinAbs(0.25, 0.0001));
+    }
+
+    SECTION("Param", "Ensures changing a watched parameter renders again") {
+
+        ModuleParam param(1);
+
+        freeze.watch(&param);
+
+        freeze.meta_process();
+        freeze.meta_process();
+
+        REQUIRE(freeze.get_renders() == 1);
+
+        const uint64_t version = param.get_version();
+
+        param.set_constant(2);
+
+        REQUIRE(param.get_version() > version);
+
+        freeze.meta_process();
+
+        REQUIRE(freeze.get_renders() == 2);
+    }
+
+    SECTION("Background", "Ensures a worker can render the cache") {
+
+        freeze.set_background(true);
+
+        freeze.meta_process();
+
+        // Without a previous cache, we output silence:
+
+        REQUIRE(freeze.get_buffer()->is_silent());
+
+        while (freeze.rendering()) {
+
+            std::this_thread::yield();
+        }
+
+        freeze.meta_process();
+
+        REQUIRE(freeze.frozen());
+        REQUIRE(freeze.get_renders() == 1);
+        REQUIRE_THAT(freeze.get_buffer()->at(0), Catch::Matchers::WithinAbs(0.5, 0.0001));
+    }
+}
@@ -0,0 +1,123 @@
+/**
+ * @file granular_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for the granular source
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "granular.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cstdio>
+#include <string>
+
+#include "io/wave_fixture.hpp"
+
+TEST_CASE("GranularSource Test", "[granular]") {
+
+    const std::string path = "GRANULAR_TEST.wav";
+
+    write_wave(path, 1000, 8000);
+
+    SampleCache cache;
+
+    GranularSource gran(cache, path);
+
+    // Grains of 100 frames, every 100 frames, at 8 kHz:
+
+    gran.set_grain_length(100);
+    gran.set_density(80);
+
+    SECTION("Start", "Ensures the sample is fetched and the format is copied") {
+
+        gran.start();
+
+        REQUIRE(gran.get_sample() != nullptr);
+        REQUIRE(gran.get_info()->sample_rate == 8000);
+        REQUIRE(gran.get_info()->channels == 1);
+
+        gran.stop();
+
+        REQUIRE(gran.get_sample() == nullptr);
+    }
+
+    SECTION("Playback", "Ensures back to back rectangle grains reproduce the sample") {
+
+        gran.set_window(WindowType::Rectangle);
+        gran.set_position(250);
+
+        gran.start();
+
+        int index = 0;
+
+        for (int block = 0; block < 4; ++block) {
+
+            gran.meta_process();
+
+            BufferPointer buff = gran.get_buffer();
+
+            for (std::size_t i = 0; i < buff->size(); ++i, ++index) {
+
+                REQUIRE_THAT(buff->at(static_cast<int>(i)), Catch::Matchers::WithinAbs(frame_value(250 + index % 100), 0.0001));
+            }
+        }
+
+        REQUIRE(gran.get_active() == 1);
+        REQUIRE(gran.get_dropped() == 0);
+    }
+
+    SECTION("Overlap", "Ensures overlapping grains are summed, and the pool is enforced") {
+
+        gran.set_density(160);
+        gran.set_spread(300);
+        gran.set_position(500);
+
+        gran.start();
+
+        gran.meta_process();
+
+        REQUIRE(gran.get_active() == 2);
+
+        // Windows bring each grain in from silence:
+
+        BufferPointer buff = gran.get_buffer();
+
+        REQUIRE_THAT(buff->at(0), Catch::Matchers::WithinAbs(0, 0.0001));
+
+        // A pool of one grain must drop every other grain:
+
+        gran.set_max_grains(1);
+        gran.start();
+
+        for (int block = 0; block < 10; ++block) {
+
+            gran.meta_process();
+            gran.get_buffer();
+        }
+
+        REQUIRE(gran.get_active() <= 1);
+        REQUIRE(gran.get_dropped() > 0);
+    }
+
+    SECTION("Short", "Ensures samples shorter than a grain play silence") {
+
+        gran.set_grain_length(5000);
+
+        gran.start();
+        gran.meta_process();
+
+        BufferPointer buff = gran.get_buffer();
+
+        REQUIRE(gran.get_active() == 0);
+        REQUIRE(buff->at(3) == 0);
+    }
+
+    gran.stop();
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,218 @@
+/**
+ * @file hot_swap_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for hot swapping patches
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "hot_swap.hpp"
+#include "meta_audio.hpp"
+#include "sink_module.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Creates a patch that outputs a constant
+ *
+ * @param value Value to output
+ * @param count Set to the counter in the patch
+ * @return std::unique_ptr<Patch> New patch
+ */
+std::unique_ptr<Patch> const_patch(double value, Counter** count = nullptr) {
+
+    auto patch = std::make_unique<Patch>();
+
+    auto* osc = patch->add<ConstModule>(value);
+    auto* counter = patch->add<Counter>();
+
+    counter->bind(osc);
+
+    patch->set_output(counter);
+
+    if (count != nullptr) {
+
+        *count = counter;
+    }
+
+    return patch;
+}
+
+}  // namespace
+
+TEST_CASE("HotSwap Test", "[swap][thread]") {
+
+    HotSwap swap;
+    PeriodSink sink;
+
+    sink.bind(&swap);
+
+    sink.meta_info_sync();
+    swap.meta_start();
+
+    SECTION("Empty", "Ensures we output silence without a patch") {
+
+        std::vector<AudioModule*> inputs;
+
+        REQUIRE(!swap.plan_inputs(inputs));
+        REQUIRE(inputs.empty());
+
+        swap.meta_process();
+
+        auto buff = swap.get_buffer();
+
+        REQUIRE(buff->is_silent());
+
+        for (auto val : *buff) {
+
+            REQUIRE(val == 0);
+        }
+    }
+
+    SECTION("Swap", "Ensures patches are swapped at the next block") {
+
+        swap.set_crossfade(false);
+
+        Counter* first = nullptr;
+
+        swap.submit(const_patch(0.5, &first));
+
+        REQUIRE(swap.pending());
+        REQUIRE(first->get_state() == BaseModule::State::Started);
+        REQUIRE(first->get_chain_info() != sink.get_chain_info());
+        REQUIRE(first->get_forward() == &swap);
+
+        swap.meta_process();
+
+        REQUIRE(!swap.pending());
+        REQUIRE(swap.swaps() == 1);
+
+        auto buff = swap.get_buffer();
+
+        for (auto val : *buff) {
+
+            REQUIRE_THAT(val, Catch::Matchers::WithinAbs(0.5, 0.0001));
+        }
+
+        // Nothing to collect yet:
+
+        REQUIRE(swap.collect() == 0);
+
+        swap.submit(const_patch(0.25));
+
+        // The old patch is still in use until the next block:
+
+        REQUIRE(first->processed() == 1);
+
+        swap.meta_process();
+
+        buff = swap.get_buffer();
+
+        for (auto val : *buff) {
+
+            REQUIRE_THAT(val, Catch::Matchers::WithinAbs(0.25, 0.0001));
+        }
+
+        REQUIRE(swap.swaps() == 2);
+        REQUIRE(swap.collect() == 1);
+        REQUIRE(swap.collect() == 0);
+    }
+
+    SECTION("Pending", "Ensures only the last submitted patch is used") {
+
+        swap.set_crossfade(false);
+
+        swap.submit(const_patch(0.5));
+        swap.submit(const_patch(0.25));
+
+        swap.meta_process();
+
+        auto buff = swap.get_buffer();
+
+        for (auto val : *buff) {
+
+            REQUIRE_THAT(val, Catch::Matchers::WithinAbs(0.25, 0.0001));
+        }
+
+        REQUIRE(swap.swaps() == 1);
+        REQUIRE(swap.collect() == 0);
+    }
+
+    SECTION("Crossfade", "Ensures we fade between patches over one block") {
+
+        swap.submit(const_patch(1.0));
+
+        swap.meta_process();
+        swap.release_buffer();
+
+        swap.submit(nullptr);
+
+        swap.meta_process();
+
+        auto buff = swap.get_buffer();
+
+        const int frames = static_cast<int>(buff->channel_capacity());
+
+        for (int i = 0; i < frames; ++i) {
+
+            REQUIRE_THAT(buff->at(0, i), Catch::Matchers::WithinAbs(1.0 - static_cast<double>(i + 1) / frames, 0.0001));
+        }
+
+        // Empty patch is silent from now on:
+
+        swap.meta_process();
+
+        REQUIRE(swap.get_buffer()->is_silent());
+        REQUIRE(swap.collect() == 1);
+    }
+
+    SECTION("Pool", "Ensures we do not allocate in the steady state") {
+
+        ChainInfo& chain = *sink.get_chain_info();
+
+        swap.submit(const_patch(0.5));
+
+        for (int i = 0; i < 5; ++i) {
+
+            swap.meta_process();
+            swap.release_buffer();
+        }
+
+        const int allocs = swap.get_chain_info()->pool.allocations();
+        const int main_allocs = chain.pool.allocations();
+
+        for (int i = 0; i < 50; ++i) {
+
+            swap.meta_process();
+            swap.release_buffer();
+        }
+
+        REQUIRE(swap.get_chain_info()->pool.allocations() == allocs);
+        REQUIRE(chain.pool.allocations() == main_allocs);
+    }
+
+    SECTION("Stop", "Ensures collected and current patches are stopped") {
+
+        Counter* count = nullptr;
+
+        swap.submit(const_patch(0.5, &count));
+        swap.meta_process();
+
+        swap.meta_stop();
+
+        REQUIRE(count->get_state() == BaseModule::State::Stopped);
+
+        swap.meta_start();
+
+        REQUIRE(count->get_state() == BaseModule::State::Started);
+    }
+}
@@ -0,0 +1,227 @@
+/**
+ * @file instrument_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for instrumentation components
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <thread>
+#include <vector>
+
+#include "amp_module.hpp"
+#include "engine.hpp"
+#include "instrument.hpp"
+#include "meta_audio.hpp"
+#include "module_mixer.hpp"
+#include "sink_module.hpp"
+#include "stft_module.hpp"
+
+TEST_CASE("Instrument Test", "[instrument]") {
+
+    SECTION("Histogram", "Ensures times are sorted into the correct buckets") {
+
+        REQUIRE(ModuleProfile::bucket(0) == 0);
+        REQUIRE(ModuleProfile::bucket(1) == 0);
+        REQUIRE(ModuleProfile::bucket(3) == 1);
+        REQUIRE(ModuleProfile::bucket(1024) == 10);
+        REQUIRE(ModuleProfile::bucket(INT64_MAX) == PROFILE_BUCKETS - 1);
+
+        ModuleProfile profile;
+
+        for (int i = 0; i < 99; ++i) {
+
+            profile.record(100, 0, 0, 8);
+        }
+
+        profile.record(5000, 2, 64, 8);
+
+        const ModuleReport report = profile.report();
+
+        REQUIRE(report.calls == 100);
+        REQUIRE(report.total_time == 99 * 100 + 5000);
+        REQUIRE(report.max_time == 5000);
+        REQUIRE(report.allocations == 2);
+        REQUIRE(report.allocated_bytes == 64);
+        REQUIRE(report.buffer_bytes == 800);
+        REQUIRE(report.histogram[6] == 99);
+        REQUIRE(report.histogram[12] == 1);
+        REQUIRE(report.percentile(0.5) == 128);
+        REQUIRE(report.percentile(1.0) == 8192);
+
+        profile.reset();
+
+        REQUIRE(profile.report().calls == 0);
+    }
+
+    SECTION("Threads", "Ensures many threads can record at once") {
+
+        ModuleProfile profile;
+
+        std::vector<std::thread> threads;
+
+        for (int t = 0; t < 4; ++t) {
+
+            threads.emplace_back([&profile, t]() {
+
+                for (int i = 0; i < 1000; ++i) {
+
+                    profile.record(t + 1, 1, 0, 0);
+                }
+            });
+        }
+
+        for (auto& thread : threads) {
+
+            thread.join();
+        }
+
+        REQUIRE(profile.report().calls == 4000);
+        REQUIRE(profile.report().allocations == 4000);
+        REQUIRE(profile.report().max_time == 4);
+    }
+
+    SECTION("Chain", "Ensures every module in a chain is measured") {
+
+        ConstModule osc1(0.25);
+        ConstModule osc2(0.5);
+        ModuleMixDown mix;
+        AmplitudeScale amp(0.5);
+
+        mix.bind(&osc1);
+        mix.bind(&osc2);
+        amp.bind(&mix);
+
+        // Modules should be found in processing order:
+
+        const auto mods = chain_modules(&amp);
+
+        REQUIRE(mods.size() == 4);
+        REQUIRE(mods.back() == &amp);
+        REQUIRE(mods[2] == &mix);
+
+        // Uninstrumented modules are skipped:
+
+        REQUIRE(chain_report(&amp).modules.empty());
+
+        instrument_chain(&amp);
+
+        for (int i = 0; i < 5; ++i) {
+
+            amp.meta_process();
+            amp.get_buffer();
+        }
+
+        const ChainReport report = chain_report(&amp);
+
+        REQUIRE(report.modules.size() == 4);
+
+        for (const auto& mod : report.modules) {
+
+            REQUIRE(mod.calls == 5);
+            REQUIRE(mod.buffer_bytes == report.modules.front().buffer_bytes);
+        }
+
+        REQUIRE(report.modules.back().module == &amp);
+        REQUIRE(report.modules.back().type == "AmplitudeScale");
+        REQUIRE(report.modules.back().buffer_bytes > 0);
+
+        // Sources allocate a new buffer for each call:
+
+        REQUIRE(report.modules.front().allocations >= 5);
+
+        REQUIRE(report.slowest() != nullptr);
+        REQUIRE(report.total_time() >= report.slowest()->total_time);
+        REQUIRE(!report.format().empty());
+
+        instrument_chain(&amp, false);
+
+        REQUIRE(amp.get_profile() == nullptr);
+    }
+
+    SECTION("Footprint", "Ensures the memory held by each module in a chain is measured") {
+
+        ConstModule osc(0.25);
+        STFTModule stft(512, 128);
+        SinkModule sink;
+
+        stft.bind(&osc);
+        sink.bind(&stft);
+
+        sink.meta_info_sync();
+        sink.meta_start();
+
+        const FootprintReport report = chain_footprint(&sink);
+
+        REQUIRE(report.modules.size() == 3);
+        REQUIRE(report.modules.back().module == &sink);
+
+        // The transforms and frames of the STFT should dominate:
+
+        const ModuleFootprint* largest = report.largest();
+
+        REQUIRE(largest != nullptr);
+        REQUIRE(largest->module == &stft);
+        REQUIRE(largest->usage.plans > 0);
+        REQUIRE(largest->usage.state > 0);
+        REQUIRE(largest->usage.samples == 0);
+
+        REQUIRE(report.total() == report.usage().total() + report.pool);
+        REQUIRE(!report.format().empty());
+
+        // Buffers held between blocks are counted:
+
+        sink.get_chain_info()->pool.reserve(2, BUFF_SIZE, 1);
+
+        REQUIRE(chain_footprint(&sink).pool >= 2 * BUFF_SIZE * sizeof(sample_t));
+
+        sink.meta_stop();
+    }
+
+    SECTION("Budget", "Ensures chains over their memory budget are refused at start") {
+
+        ConstModule osc(0.25);
+        STFTModule stft(512, 128);
+        SinkModule sink;
+
+        stft.bind(&osc);
+        sink.bind(&stft);
+
+        ChainInfo* chain = sink.get_chain_info();
+
+        chain->memory_budget = 1024;
+
+        sink.meta_info_sync();
+        sink.meta_start();
+
+        REQUIRE(chain->over_budget);
+        REQUIRE(chain->memory_used > chain->memory_budget);
+        REQUIRE(sink.get_state() == AudioModule::State::Stopped);
+        REQUIRE(stft.get_state() == AudioModule::State::Stopped);
+
+        // The engine never runs a chain over budget:
+
+        Engine engine(&sink);
+
+        engine.run(5);
+
+        REQUIRE(!engine.is_ready());
+        REQUIRE(chain->sample == 0);
+
+        // A larger budget lets the chain start:
+
+        chain->memory_budget = chain->memory_used;
+
+        sink.meta_start();
+
+        REQUIRE(!chain->over_budget);
+        REQUIRE(sink.get_state() == AudioModule::State::Started);
+
+        sink.meta_stop();
+    }
+}
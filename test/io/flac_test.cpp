@@ -0,0 +1,554 @@
+/**
+ * @file flac_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for FLAC components
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "io/flac.hpp"
+#include "io/mstream.hpp"
+
+namespace {
+
+/// Number of frames in our test stream
+const int flac_frames = 868;
+
+/// Number of frames in each full FLAC frame
+const int flac_block = 256;
+
+/**
+ * @brief Writes bits most significant first
+ */
+class BitWriter {
+
+    public:
+
+        /**
+         * @brief Writes an unsigned value
+         *
+         * @param val Value to write
+         * @param num Number of bits to write
+         */
+        void write(uint64_t val, int num) {
+
+            for (int i = num - 1; i >= 0; --i) {
+
+                this->bit(((val >> i) & 1) != 0);
+            }
+        }
+
+        /**
+         * @brief Writes a Rice coded value
+         *
+         * @param val Signed value to write
+         * @param k Rice parameter
+         */
+        void rice(int64_t val, int k) {
+
+            const auto folded = static_cast<uint64_t>((val << 1) ^ (val >> 63));
+
+            for (uint64_t i = 0; i < (folded >> k); ++i) {
+
+                this->bit(false);
+            }
+
+            this->bit(true);
+            this->write(folded, k);
+        }
+
+        /**
+         * @brief Pads with zeros to the next byte
+         */
+        void align() {
+
+            while (this->used != 0) {
+
+                this->bit(false);
+            }
+        }
+
+        /// Bytes written so far
+        std::vector<unsigned char> bytes;
+
+    private:
+
+        /**
+         * @brief Writes a single bit
+         *
+         * @param set Value of the bit
+         */
+        void bit(bool set) {
+
+            if (this->used == 0) {
+
+                this->bytes.push_back(0);
+            }
+
+            if (set) {
+
+                this->bytes.back() = static_cast<unsigned char>(this->bytes.back() | (0x80 >> this->used));
+            }
+
+            this->used = (this->used + 1) % 8;
+        }
+
+        /// Number of bits used in the last byte
+        int used = 0;
+};
+
+/**
+ * @brief Computes a CRC without reflection, one bit at a time
+ *
+ * @param bytes Bytes to compute the CRC of
+ * @param start Index of the first byte
+ * @param width Width of the CRC in bits
+ * @param poly Polynomial of the CRC
+ * @return uint32_t Value of the CRC
+ */
+uint32_t slow_crc(const std::vector<unsigned char>& bytes, std::size_t start, int width, uint32_t poly) {
+
+    uint32_t crc = 0;
+
+    const uint32_t mask = (1U << width) - 1;
+
+    for (std::size_t i = start; i < bytes.size(); ++i) {
+
+        crc ^= static_cast<uint32_t>(static_cast<unsigned char>(bytes[i])) << (width - 8);
+
+        for (int j = 0; j < 8; ++j) {
+
+            crc = ((crc >> (width - 1)) & 1) != 0 ? ((crc << 1) ^ poly) & mask : (crc << 1) & mask;
+        }
+    }
+
+    return crc;
+}
+
+/**
+ * @brief Gets the left channel of our test signal
+ *
+ * @param frame Frame to determine
+ * @return int64_t Sample value
+ */
+int64_t left_value(int frame) {
+
+    if (frame >= 3 * flac_block) {
+
+        return 4 * (frame % 50) + 5;
+    }
+
+    return std::lround(8000 * std::sin(0.05 * frame));
+}
+
+/**
+ * @brief Gets the right channel of our test signal
+ *
+ * @param frame Frame to determine
+ * @return int64_t Sample value
+ */
+int64_t right_value(int frame) {
+
+    if (frame >= 3 * flac_block) {
+
+        return 4 * (frame % 50);
+    }
+
+    return std::lround(-12000 * std::cos(0.031 * frame)) + (frame % 7);
+}
+
+/**
+ * @brief Writes residuals with a single Rice parameter
+ *
+ * @param bits Writer to use
+ * @param samples Samples of the subframe
+ * @param coeffs Predictor coefficients
+ * @param shift Shift applied to the prediction
+ * @param partition_order Partition order to use
+ * @param escape Determines if the first partition is stored as plain values
+ */
+void write_residual(BitWriter& bits, const std::vector<int64_t>& samples, const std::vector<int64_t>& coeffs, int shift, int partition_order, bool escape) {
+
+    const auto order = static_cast<int>(coeffs.size());
+    const auto num = static_cast<int>(samples.size());
+    const int per = num >> partition_order;
+
+    bits.write(0, 2);
+    bits.write(static_cast<uint64_t>(partition_order), 4);
+
+    for (int p = 0; p < (1 << partition_order); ++p) {
+
+        const bool plain = escape && p == 0;
+
+        bits.write(plain ? 15 : 4, 4);
+
+        if (plain) {
+
+            bits.write(20, 5);
+        }
+
+        for (int i = std::max(p * per, order); i < (p + 1) * per; ++i) {
+
+            int64_t sum = 0;
+
+            for (int j = 0; j < order; ++j) {
+
+                sum += coeffs[j] * samples[i - 1 - j];
+            }
+
+            const int64_t res = samples[i] - (sum >> shift);
+
+            if (plain) {
+
+                bits.write(static_cast<uint64_t>(res), 20);
+            }
+
+            else {
+
+                bits.rice(res, 4);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Writes a subframe with a predictor
+ *
+ * @param bits Writer to use
+ * @param samples Samples of the subframe
+ * @param width Bits per sample of the subframe
+ * @param type Type of the subframe
+ * @param coeffs Predictor coefficients
+ * @param precision Precision of LPC coefficients, 0 for fixed predictors
+ * @param shift Shift applied to the prediction
+ * @param escape Determines if the first partition is stored as plain values
+ */
+void write_predicted(BitWriter& bits, const std::vector<int64_t>& samples, int width, int type,
+                     const std::vector<int64_t>& coeffs, int precision, int shift, bool escape) {
+
+    bits.write(0, 1);
+    bits.write(static_cast<uint64_t>(type), 6);
+    bits.write(0, 1);
+
+    for (std::size_t i = 0; i < coeffs.size(); ++i) {
+
+        bits.write(static_cast<uint64_t>(samples[i]), width);
+    }
+
+    if (precision > 0) {
+
+        bits.write(static_cast<uint64_t>(precision - 1), 4);
+        bits.write(static_cast<uint64_t>(shift), 5);
+
+        for (auto coeff : coeffs) {
+
+            bits.write(static_cast<uint64_t>(coeff), precision);
+        }
+    }
+
+    write_residual(bits, samples, coeffs, shift, 1, escape);
+}
+
+/**
+ * @brief Writes a verbatim subframe
+ *
+ * @param bits Writer to use
+ * @param samples Samples of the subframe
+ * @param width Bits per sample of the subframe
+ * @param wasted Number of wasted bits
+ */
+void write_verbatim(BitWriter& bits, const std::vector<int64_t>& samples, int width, int wasted) {
+
+    bits.write(0, 1);
+    bits.write(1, 6);
+    bits.write(wasted > 0 ? 1 : 0, 1);
+
+    if (wasted > 0) {
+
+        bits.write(1, wasted);
+    }
+
+    for (auto val : samples) {
+
+        bits.write(static_cast<uint64_t>(val >> wasted), width - wasted);
+    }
+}
+
+/**
+ * @brief Creates a stereo 16 bit FLAC stream of our test signal
+ *
+ * Each FLAC frame uses a different channel assignment and subframe types.
+ *
+ * @param mid Index of the first byte of the second frame's subframes
+ * @return std::vector<unsigned char> Bytes of the stream
+ */
+std::vector<unsigned char> create_flac(std::size_t* mid = nullptr) {
+
+    BitWriter bits;
+
+    // Write the marker and stream info:
+
+    bits.write(0x664C6143, 32);
+
+    bits.write(0, 1);
+    bits.write(0, 7);
+    bits.write(34, 24);
+
+    bits.write(flac_block, 16);
+    bits.write(flac_block, 16);
+    bits.write(0, 24);
+    bits.write(0, 24);
+    bits.write(44100, 20);
+    bits.write(1, 3);
+    bits.write(15, 5);
+    bits.write(flac_frames, 36);
+    bits.write(0, 64);
+    bits.write(0, 64);
+
+    // Then some padding, which should be skipped:
+
+    bits.write(1, 1);
+    bits.write(1, 7);
+    bits.write(10, 24);
+    bits.write(0, 80);
+
+    for (int frame = 0; frame * flac_block < flac_frames; ++frame) {
+
+        const int start = frame * flac_block;
+        const int num = std::min(flac_block, flac_frames - start);
+
+        std::vector<int64_t> left(num);
+        std::vector<int64_t> right(num);
+        std::vector<int64_t> side(num);
+        std::vector<int64_t> center(num);
+
+        for (int i = 0; i < num; ++i) {
+
+            left[i] = left_value(start + i);
+            right[i] = right_value(start + i);
+            side[i] = left[i] - right[i];
+            center[i] = (left[i] + right[i]) >> 1;
+        }
+
+        // Write the frame header:
+
+        const std::size_t head = bits.bytes.size();
+
+        const std::array<int, 4> assignments = {1, 8, 10, 9};
+
+        bits.write(0xFFF8, 16);
+        bits.write(7, 4);
+        bits.write(0, 4);
+        bits.write(static_cast<uint64_t>(assignments.at(frame)), 4);
+        bits.write(4, 3);
+        bits.write(0, 1);
+        bits.write(static_cast<uint64_t>(frame), 8);
+        bits.write(static_cast<uint64_t>(num - 1), 16);
+        bits.write(slow_crc(bits.bytes, head, 8, 0x07), 8);
+
+        if (frame == 1 && mid != nullptr) {
+
+            *mid = bits.bytes.size();
+        }
+
+        // Write the subframes:
+
+        if (frame == 0) {
+
+            write_predicted(bits, left, 16, 10, {2, -1}, 0, 0, false);
+            write_verbatim(bits, right, 16, 0);
+        }
+
+        else if (frame == 1) {
+
+            write_predicted(bits, left, 16, 33, {4, -2}, 4, 1, false);
+            write_predicted(bits, side, 17, 9, {1}, 0, 0, true);
+        }
+
+        else if (frame == 2) {
+
+            write_predicted(bits, center, 16, 11, {3, -3, 1}, 0, 0, false);
+            write_verbatim(bits, side, 17, 0);
+        }
+
+        else {
+
+            // Side is constant, and right has wasted bits:
+
+            bits.write(0, 8);
+            bits.write(5, 17);
+
+            write_verbatim(bits, right, 16, 2);
+        }
+
+        bits.align();
+        bits.write(slow_crc(bits.bytes, head, 16, 0x8005), 16);
+    }
+
+    return bits.bytes;
+}
+
+/**
+ * @brief Reads every frame of a FLAC stream
+ *
+ * @param reader Reader to use, which has been started
+ * @return std::vector<sample_t> Interleaved samples
+ */
+std::vector<sample_t> read_all(FLACReader& reader) {
+
+    std::vector<sample_t> samples;
+
+    reader.set_buffer_size(100);
+
+    while (!reader.done()) {
+
+        auto data = reader.get_data();
+
+        REQUIRE(data->channels() == 2);
+
+        samples.insert(samples.end(), data->data(), data->data() + data->size());
+    }
+
+    return samples;
+}
+
+}  // namespace
+
+TEST_CASE("FLACReader Test", "[io][flac]") {
+
+    CharIStream stream;
+
+    stream.get_array() = create_flac();
+
+    FLACReader reader(&stream);
+
+    SECTION("Metadata", "Ensures the stream info is read") {
+
+        reader.start();
+
+        REQUIRE(reader.get_channels() == 2);
+        REQUIRE(reader.get_samplerate() == 44100);
+        REQUIRE(reader.get_bits_per_sample() == 16);
+        REQUIRE(reader.get_frames() == flac_frames);
+        REQUIRE_FALSE(reader.done());
+    }
+
+    SECTION("Decode", "Ensures every subframe type and channel assignment is decoded") {
+
+        // Read a few bytes at a time, so frames span many reads:
+
+        reader.set_read_size(64);
+        reader.start();
+
+        auto samples = read_all(reader);
+
+        REQUIRE(samples.size() == 900 * 2);
+        REQUIRE(reader.get_errors() == 0);
+
+        for (int i = 0; i < flac_frames; ++i) {
+
+            REQUIRE_THAT(samples.at(i * 2), Catch::Matchers::WithinAbs(left_value(i) / 32767.0, 1e-6));
+            REQUIRE_THAT(samples.at(i * 2 + 1), Catch::Matchers::WithinAbs(right_value(i) / 32767.0, 1e-6));
+        }
+
+        // The rest is padding:
+
+        for (std::size_t i = flac_frames * 2; i < samples.size(); ++i) {
+
+            REQUIRE(samples.at(i) == 0);
+        }
+    }
+
+    SECTION("Corrupt", "Ensures corrupt frames are replaced with silence") {
+
+        std::size_t mid = 0;
+
+        stream.get_array() = create_flac(&mid);
+        stream.get_array().at(mid + 20) ^= 0x10;
+
+        reader.start();
+
+        auto samples = read_all(reader);
+
+        REQUIRE(reader.get_errors() == 1);
+
+        for (int i = 0; i < flac_frames; ++i) {
+
+            const bool bad = i >= flac_block && i < 2 * flac_block;
+
+            REQUIRE_THAT(samples.at(i * 2), Catch::Matchers::WithinAbs(bad ? 0 : left_value(i) / 32767.0, 1e-6));
+        }
+    }
+
+    SECTION("Invalid", "Ensures streams that are not FLAC are rejected") {
+
+        stream.get_array() = {'R', 'I', 'F', 'F', 0, 0, 0, 0};
+
+        reader.start();
+
+        REQUIRE(reader.done());
+    }
+}
+
+TEST_CASE("FLACSource Test", "[io][flac]") {
+
+    CharIStream stream;
+
+    stream.get_array() = create_flac();
+
+    FLACSource source(&stream);
+
+    source.get_info()->out_buffer = 100;
+
+    REQUIRE(source.get_prefetch() > 0);
+
+    source.start();
+
+    REQUIRE(source.get_info()->channels == 2);
+    REQUIRE(source.get_info()->sample_rate == 44100);
+
+    int frame = 0;
+    uint64_t silent = 0;
+
+    while (!source.finished()) {
+
+        const uint64_t before = source.get_underruns();
+
+        source.process();
+
+        auto data = source.get_buffer();
+
+        // Silence means the decoding thread is behind:
+
+        if (source.get_underruns() != before) {
+
+            ++silent;
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+            continue;
+        }
+
+        for (int i = 0; i < 100 && frame < flac_frames; ++i, ++frame) {
+
+            REQUIRE_THAT(data->data()[i * 2], Catch::Matchers::WithinAbs(left_value(frame) / 32767.0, 1e-6));
+        }
+    }
+
+    REQUIRE(frame == flac_frames);
+    REQUIRE(source.get_underruns() == silent);
+
+    source.stop();
+}
@@ -11,7 +11,10 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
 #include <array>
+#include <cstdio>
+#include <vector>
 
 #include "io/mstream.hpp"
 
@@ -201,6 +204,67 @@ TEST_CASE("Char mstream", "[io][mstream]") {
                 REQUIRE(i - 4 == stream.get_array().at(i));
             }
         }
+
+        SECTION("Bulk", "Ensures many small writes are correct") {
+
+            CharOStream stream;
+
+            stream.reserve(16);
+
+            for (int i = 0; i < 1000; ++i) {
+
+                stream.write(data.begin() + i % 5, 5 - i % 5);
+            }
+
+            // Ensure each write was added in order:
+
+            std::size_t pos = 0;
+
+            for (int i = 0; i < 1000; ++i) {
+
+                for (int j = i % 5; j < 5; ++j) {
+
+                    REQUIRE(stream.get_array().at(pos++) == data.at(j));
+                }
+            }
+
+            REQUIRE(pos == stream.get_array().size());
+        }
+    }
+}
+
+TEST_CASE("Span mstream", "[io][mstream]") {
+
+    const std::array<char, 6> mem = {0, 1, 2, 3, 4, 5};
+
+    SpanIStream stream(mem);
+
+    SECTION("Borrowed", "Ensures the memory is not copied") {
+
+        REQUIRE(stream.contiguous() == mem.data());
+        REQUIRE(stream.length() == mem.size());
+        REQUIRE(stream.get_span().data() == mem.data());
+    }
+
+    SECTION("Read", "Ensures we can read and seek") {
+
+        std::array<char, 3> out{};
+
+        stream.seek(2);
+        stream.read(out.data(), 3);
+
+        for (int i = 0; i < out.size(); ++i) {
+
+            REQUIRE(out.at(i) == i + 2);
+        }
+
+        // Reading past the end zeros and stops:
+
+        stream.read(out.data(), 3);
+
+        REQUIRE(out.at(0) == 5);
+        REQUIRE(out.at(1) == 0);
+        REQUIRE(stream.get_state() == SpanIStream::mstate::stopped);
     }
 }
 
@@ -225,9 +289,8 @@ TEST_CASE("File mstream", "[io][mstream]") {
         REQUIRE(ostream.get_path() == path);
     }
 
-    // Start components:
+    // Start the output, the input is started once the file is written:
 
-    istream.start();
     ostream.start();
 
     SECTION("Write to file", "Ensures we can write to a file") {
@@ -249,6 +312,8 @@ TEST_CASE("File mstream", "[io][mstream]") {
 
             // Read content:
 
+            istream.start();
+
             istream.read(ind.begin(), cont.size()+1);
 
             // Ensure istream is closed:
@@ -268,5 +333,282 @@ TEST_CASE("File mstream", "[io][mstream]") {
 
     // Delete file:
 
-    //std::remove(path.c_str());
+    std::remove(path.c_str());
+}
+
+TEST_CASE("MMap mstream", "[io][mstream]") {
+
+    // Write a file to map:
+
+    std::string path = "MSTREAM_MMAP_TEST.txt";
+
+    std::array<char, 5> cont = {1, 2, 3, 4, 5};
+
+    FOStream ostream;
+
+    ostream.set_path(path);
+    ostream.start();
+    ostream.write(cont.begin(), cont.size());
+    ostream.stop();
+
+    // Create the mapped stream:
+
+    MMapIStream istream(path);
+
+    SECTION("Get path", "Ensures we can retrieve a path to a file") {
+
+        REQUIRE(istream.get_path() == path);
+    }
+
+    SECTION("Bad path", "Ensures a missing file puts the stream in the error state") {
+
+        istream.set_path("MSTREAM_MMAP_MISSING.txt");
+
+        istream.start();
+
+        REQUIRE(istream.get_state() == MMapIStream::mstate::err);
+        REQUIRE(istream.contiguous() == nullptr);
+    }
+
+    istream.start();
+
+    SECTION("Contiguous", "Ensures the mapped contents are exposed") {
+
+        REQUIRE(istream.length() == cont.size());
+        REQUIRE(istream.contiguous() != nullptr);
+
+        for (int i = 0; i < cont.size(); ++i) {
+
+            REQUIRE(istream.contiguous()[i] == cont.at(i));
+        }
+    }
+
+    SECTION("Seek", "Ensures we can read from any position") {
+
+        std::array<char, 2> ind = {};
+
+        istream.seek(3);
+        istream.read(ind.begin(), ind.size());
+
+        REQUIRE(ind.at(0) == 4);
+        REQUIRE(ind.at(1) == 5);
+
+        istream.seek(1);
+        istream.read(ind.begin(), ind.size());
+
+        REQUIRE(ind.at(0) == 2);
+        REQUIRE(ind.at(1) == 3);
+    }
+
+    SECTION("Read from file", "Ensures reading past the end stops the stream") {
+
+        std::array<char, cont.size() + 1> ind = {};
+        ind.back() = 9;
+
+        istream.read(ind.begin(), ind.size());
+
+        REQUIRE(istream.get_state() == MMapIStream::mstate::stopped);
+        REQUIRE(istream.contiguous() == nullptr);
+        REQUIRE(ind.back() == 0);
+
+        for (int i = 0; i < cont.size(); ++i) {
+
+            REQUIRE(ind.at(i) == cont.at(i));
+        }
+    }
+
+    // Delete file:
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Async File mstream", "[io][mstream]") {
+
+    std::string path = "MSTREAM_ASYNC_TEST.txt";
+
+    AsyncFOStream ostream(path);
+
+    REQUIRE(ostream.get_path() == path);
+
+    // Create content to write:
+
+    std::vector<char> cont(10000);
+
+    for (std::size_t i = 0; i < cont.size(); ++i) {
+
+        cont.at(i) = static_cast<char>(i * 7);
+    }
+
+    SECTION("Small Chunks", "Ensures writes spanning many chunks are correct") {
+
+        ostream.set_chunks(8, 2);
+
+        REQUIRE(ostream.get_chunk_size() == 8);
+    }
+
+    SECTION("Direct", "Ensures writes bypassing the page cache are correct") {
+
+        ostream.set_chunks(AsyncFOStream::chunk_align, 3);
+        ostream.set_direct(true);
+
+        REQUIRE(ostream.get_direct());
+    }
+
+    ostream.start();
+
+    REQUIRE(ostream.good());
+
+    // Write in uneven pieces:
+
+    std::size_t pos = 0;
+    int piece = 1;
+
+    while (pos < cont.size()) {
+
+        const int num = std::min(piece, static_cast<int>(cont.size() - pos));
+
+        ostream.write(cont.data() + pos, num);
+
+        pos += num;
+        piece = piece * 3 % 1000 + 1;
+    }
+
+    // Patch the start of the file:
+
+    std::array<char, 4> patch = {9, 9, 9, 9};
+
+    ostream.seek(2);
+    ostream.write(patch.begin(), patch.size());
+
+    std::copy_n(patch.begin(), patch.size(), cont.begin() + 2);
+
+    ostream.stop();
+
+    // Read the contents back:
+
+    MMapIStream istream(path);
+
+    istream.start();
+
+    REQUIRE(istream.length() == cont.size());
+
+    for (std::size_t i = 0; i < cont.size(); ++i) {
+
+        REQUIRE(istream.contiguous()[i] == cont.at(i));
+    }
+
+    // Delete file:
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Buffered mstream", "[io][mstream]") {
+
+    // Create content to buffer:
+
+    CharIStream source;
+
+    for (int i = 0; i < 100; ++i) {
+
+        source.get_array().push_back(static_cast<unsigned char>(i));
+    }
+
+    // Use a tiny window so we refill often:
+
+    BufferedIStream stream(&source, 8);
+
+    REQUIRE(stream.get_stream() == &source);
+    REQUIRE(stream.get_window() == 8);
+
+    stream.start();
+
+    SECTION("Peek", "Ensures we can inspect bytes without consuming them") {
+
+        auto view = stream.peek(4);
+
+        REQUIRE(view.size() == 4);
+        REQUIRE(view[0] == 0);
+        REQUIRE(view[3] == 3);
+
+        // Peeking again should give the same bytes:
+
+        REQUIRE(stream.peek(2)[0] == 0);
+
+        stream.consume(3);
+
+        // Peeking more than the window should grow it:
+
+        view = stream.peek(20);
+
+        REQUIRE(view.size() == 20);
+
+        for (int i = 0; i < 20; ++i) {
+
+            REQUIRE(view[i] == i + 3);
+        }
+    }
+
+    SECTION("Read", "Ensures reads spanning many refills are correct") {
+
+        std::array<char, 3> small{};
+        std::array<char, 30> large{};
+
+        int expected = 0;
+
+        while (expected + small.size() + large.size() <= 100) {
+
+            stream.read(small.data(), small.size());
+
+            for (const char val : small) {
+
+                REQUIRE(val == expected++);
+            }
+
+            stream.read(large.data(), large.size());
+
+            for (const char val : large) {
+
+                REQUIRE(val == expected++);
+            }
+        }
+
+        REQUIRE(stream.good());
+
+        // Reading past the end zeros and stops:
+
+        std::array<char, 40> rest{};
+
+        REQUIRE(stream.read_some(rest.data(), rest.size()) == 100 - expected);
+        REQUIRE(rest.at(0) == expected);
+        REQUIRE(stream.get_state() == BufferedIStream::mstate::stopped);
+    }
+
+    SECTION("Seek", "Ensures we can seek within and outside the window") {
+
+        std::array<char, 2> out{};
+
+        stream.read(out.data(), out.size());
+
+        // Within the window:
+
+        stream.seek(5);
+        stream.read(out.data(), out.size());
+
+        REQUIRE(out.at(0) == 5);
+
+        // Outside the window:
+
+        stream.seek(90);
+        stream.read(out.data(), out.size());
+
+        REQUIRE(out.at(0) == 90);
+        REQUIRE(out.at(1) == 91);
+
+        // And back again:
+
+        stream.seek(1);
+        stream.read(out.data(), out.size());
+
+        REQUIRE(out.at(0) == 1);
+    }
 }
@@ -0,0 +1,262 @@
+/**
+ * @file rtp_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for RTP streaming components
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "io/rtp.hpp"
+#include "io/udp.hpp"
+#include "meta_audio.hpp"
+#include "sink_module.hpp"
+
+namespace {
+
+/// Frames in each test packet
+const int rtp_frames = 4;
+
+/**
+ * @brief Pushes a mono L16 packet filled with a value
+ *
+ * @param jitter Jitter buffer to push into
+ * @param seq Sequence number of the packet
+ * @param val Value of every sample
+ * @return true If the packet was buffered
+ */
+bool push_packet(RTPJitterBuffer& jitter, uint16_t seq, sample_t val) {
+
+    std::array<sample_t, rtp_frames> samples{};
+    std::array<char, rtp_frames * 2> payload{};
+
+    samples.fill(val);
+
+    pcm_encode(PCMFormat::s16, samples.data(), payload.data(), samples.size(), true);
+
+    return jitter.push(seq, seq * rtp_frames, PCMFormat::s16, payload.data(), payload.size(), static_cast<int64_t>(seq) * 83333);
+}
+
+}  // namespace
+
+TEST_CASE("RTPHeader Test", "[io][rtp]") {
+
+    RTPHeader head;
+
+    head.payload = 97;
+    head.marker = true;
+    head.sequence = 0xABCD;
+    head.timestamp = 0x12345678;
+    head.ssrc = 0xDEADBEEF;
+
+    std::array<char, 32> packet{};
+
+    head.write(packet.data());
+
+    SECTION("Round Trip", "Ensures headers are read back as written") {
+
+        RTPHeader other;
+        int size = 0;
+
+        REQUIRE(other.read(packet.data(), 20, &size) == RTPHeader::size);
+        REQUIRE(size == 8);
+
+        REQUIRE(other.payload == 97);
+        REQUIRE(other.marker);
+        REQUIRE(other.sequence == 0xABCD);
+        REQUIRE(other.timestamp == 0x12345678);
+        REQUIRE(other.ssrc == 0xDEADBEEF);
+    }
+
+    SECTION("Skip", "Ensures contributing sources and padding are skipped") {
+
+        // One contributing source, and 4 bytes of padding:
+
+        packet[0] = static_cast<char>(packet[0] | 0x20 | 0x01);
+        packet[23] = 4;
+
+        RTPHeader other;
+        int size = 0;
+
+        REQUIRE(other.read(packet.data(), 24, &size) == RTPHeader::size + 4);
+        REQUIRE(size == 4);
+    }
+
+    SECTION("Invalid", "Ensures packets that are not RTP are rejected") {
+
+        RTPHeader other;
+        int size = 0;
+
+        REQUIRE(other.read(packet.data(), 8, &size) == -1);
+
+        packet[0] = 0;
+
+        REQUIRE(other.read(packet.data(), 20, &size) == -1);
+    }
+}
+
+TEST_CASE("RTPJitterBuffer Test", "[io][rtp]") {
+
+    RTPJitterBuffer jitter;
+
+    jitter.configure(8, 1, rtp_frames, 48000);
+    jitter.set_delay(2 * rtp_frames, 2 * rtp_frames);
+
+    std::vector<sample_t> out(rtp_frames);
+
+    SECTION("Buffering", "Ensures playout waits for the target delay") {
+
+        REQUIRE(jitter.pop(out.data(), rtp_frames) == 0);
+
+        push_packet(jitter, 100, 0.5);
+
+        REQUIRE(jitter.pop(out.data(), rtp_frames) == 0);
+        REQUIRE(out.at(0) == 0);
+
+        push_packet(jitter, 101, 0.25);
+
+        REQUIRE(jitter.buffered() == 2 * rtp_frames);
+        REQUIRE(jitter.pop(out.data(), rtp_frames) == rtp_frames);
+        REQUIRE_THAT(out.at(0), Catch::Matchers::WithinAbs(0.5, 1e-4));
+    }
+
+    SECTION("Reorder", "Ensures packets are played in sequence order") {
+
+        push_packet(jitter, 10, 0.1);
+        push_packet(jitter, 12, 0.3);
+        push_packet(jitter, 11, 0.2);
+
+        for (sample_t val : {0.1, 0.2, 0.3}) {
+
+            REQUIRE(jitter.pop(out.data(), rtp_frames) == rtp_frames);
+            REQUIRE_THAT(out.at(rtp_frames - 1), Catch::Matchers::WithinAbs(val, 1e-4));
+        }
+
+        // Late packets are discarded:
+
+        REQUIRE_FALSE(push_packet(jitter, 11, 0.2));
+        REQUIRE(jitter.get_late() == 1);
+    }
+
+    SECTION("Loss", "Ensures missing packets are concealed and we rebuffer when empty") {
+
+        push_packet(jitter, 0, 0.5);
+        push_packet(jitter, 2, 0.5);
+
+        REQUIRE(jitter.pop(out.data(), rtp_frames) == rtp_frames);
+
+        // Packet 1 never arrives:
+
+        REQUIRE(jitter.pop(out.data(), rtp_frames) == 0);
+        REQUIRE(out.at(0) == 0);
+        REQUIRE(jitter.get_lost() == 1);
+
+        REQUIRE(jitter.pop(out.data(), rtp_frames) == rtp_frames);
+
+        // Nothing left:
+
+        REQUIRE(jitter.pop(out.data(), rtp_frames) == 0);
+        REQUIRE(jitter.get_underruns() == 1);
+    }
+
+    SECTION("Skip", "Ensures we skip packets when far too much is buffered") {
+
+        for (int i = 0; i < 8; ++i) {
+
+            push_packet(jitter, i, 0.1 * i);
+        }
+
+        REQUIRE(jitter.pop(out.data(), rtp_frames) == rtp_frames);
+        REQUIRE(jitter.get_skipped() == 0);
+
+        // Packet 1 is skipped:
+
+        REQUIRE(jitter.pop(out.data(), rtp_frames) == rtp_frames);
+        REQUIRE(jitter.get_skipped() == 1);
+        REQUIRE_THAT(out.at(0), Catch::Matchers::WithinAbs(0.2, 1e-4));
+    }
+
+    SECTION("Wrap", "Ensures sequence numbers wrap around") {
+
+        push_packet(jitter, 0xFFFF, 0.1);
+        push_packet(jitter, 0, 0.2);
+
+        REQUIRE(jitter.pop(out.data(), rtp_frames) == rtp_frames);
+        REQUIRE(jitter.pop(out.data(), rtp_frames) == rtp_frames);
+        REQUIRE_THAT(out.at(0), Catch::Matchers::WithinAbs(0.2, 1e-4));
+    }
+}
+
+TEST_CASE("RTP Stream Test", "[io][rtp]") {
+
+    // Receive on a free port:
+
+    RTPSource source(0, 1);
+    PeriodSink psink;
+
+    psink.bind(&source);
+
+    source.set_delay(48, 480);
+
+    psink.meta_info_sync();
+    psink.meta_start();
+
+    REQUIRE(source.get_stream()->good());
+
+    // Stream to it:
+
+    ConstModule value(0.25);
+    RTPSink sink("127.0.0.1", source.get_stream()->get_port());
+
+    sink.bind(&value);
+
+    sink.meta_info_sync();
+    sink.meta_start();
+
+    const int blocks = 4;
+    const int frames = sink.get_info()->out_buffer;
+    const int expected = blocks * frames / 48;
+
+    for (int i = 0; i < blocks; ++i) {
+
+        sink.meta_process();
+    }
+
+    // Every packet is full, leftover frames wait for the next block:
+
+    REQUIRE(sink.get_packets() == expected);
+
+    // Wait for the packets to arrive:
+
+    for (int i = 0; i < 200 && source.get_packets() < expected; ++i) {
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    REQUIRE(source.get_packets() == expected);
+
+    source.meta_process();
+
+    auto buff = source.get_buffer();
+
+    REQUIRE(buff->channels() == 1);
+
+    for (auto val : *buff) {
+
+        REQUIRE_THAT(val, Catch::Matchers::WithinAbs(0.25, 1e-5));
+    }
+
+    sink.meta_stop();
+    psink.meta_stop();
+}
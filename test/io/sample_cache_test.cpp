@@ -0,0 +1,153 @@
+/**
+ * @file sample_cache_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for the sample cache
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#include "io/sample_cache.hpp"
+#include "io/wav.hpp"
+#include "sink_module.hpp"
+#include "wave_fixture.hpp"
+
+TEST_CASE("SampleCache Test", "[io][sample_cache]") {
+
+    const std::string first = "SAMPLE_CACHE_FIRST.wav";
+    const std::string second = "SAMPLE_CACHE_SECOND.wav";
+    const std::string third = "SAMPLE_CACHE_THIRD.wav";
+
+    write_wave(first, 1000, 8000);
+    write_wave(second, 1000, 8000);
+    write_wave(third, 1000, 8000);
+
+    SampleCache cache;
+
+    SECTION("Shared", "Ensures samples are loaded once and shared") {
+
+        auto sample = cache.get(first);
+
+        REQUIRE(sample != nullptr);
+        REQUIRE(sample->complete());
+        REQUIRE(sample->get_frames() == 1000);
+        REQUIRE(sample->get_samplerate() == 8000);
+        REQUIRE(sample->get_channels() == 1);
+
+        REQUIRE(cache.get(first) == sample);
+        REQUIRE(cache.get_misses() == 1);
+        REQUIRE(cache.get_hits() == 1);
+        REQUIRE(cache.get_memory() == 1000 * sizeof(sample_t));
+
+        REQUIRE_THAT(sample->get_head()[250], Catch::Matchers::WithinAbs(frame_value(250), 1e-4));
+
+        // Files that can't be loaded are not cached:
+
+        REQUIRE(cache.get("SAMPLE_CACHE_MISSING.wav") == nullptr);
+        REQUIRE(cache.size() == 1);
+    }
+
+    SECTION("Eviction", "Ensures the least recently used samples are evicted") {
+
+        cache.set_budget(2 * 1000 * sizeof(sample_t));
+
+        auto held = cache.get(first);
+
+        cache.get(second);
+
+        REQUIRE(cache.size() == 2);
+
+        // The first sample is older, but still in use:
+
+        auto last = cache.get(third);
+
+        REQUIRE(cache.size() == 2);
+        REQUIRE(cache.get_evictions() == 1);
+
+        REQUIRE(cache.get(first) == held);
+        REQUIRE(cache.get_misses() == 3);
+
+        // Once released, it can go:
+
+        held.reset();
+
+        cache.set_budget(1000 * sizeof(sample_t));
+
+        REQUIRE(cache.size() == 1);
+        REQUIRE(cache.get(third) == last);
+    }
+
+    SECTION("Streamed", "Ensures large samples play their attack and stream the rest") {
+
+        // Only keep the first 10 milliseconds:
+
+        cache.set_threshold(0);
+        cache.set_preload(10);
+
+        SampleSource source(cache, first);
+        SampleSource other(cache, first);
+        PeriodSink sink;
+
+        sink.bind(&source);
+
+        sink.meta_info_sync();
+        sink.meta_start();
+
+        // Both sources share the attack:
+
+        other.start();
+
+        REQUIRE(source.get_sample() == other.get_sample());
+        REQUIRE(source.get_sample()->get_head_frames() == 80);
+        REQUIRE(cache.get_memory() == 80 * sizeof(sample_t));
+
+        // Wait for the whole tail to be streamed:
+
+        REQUIRE(source.get_stream() != nullptr);
+
+        for (int i = 0; i < 200 && !source.get_stream()->finished(); ++i) {
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+
+        REQUIRE(source.get_stream()->finished());
+
+        int frame = 0;
+
+        while (!source.done()) {
+
+            source.meta_process();
+
+            auto buff = source.get_buffer();
+
+            for (auto val : *buff) {
+
+                const sample_t expected = frame < 1000 ? frame_value(frame) : 0;
+
+                REQUIRE_THAT(val, Catch::Matchers::WithinAbs(expected, 1e-4));
+
+                ++frame;
+            }
+        }
+
+        REQUIRE(frame >= 1000);
+        REQUIRE(source.get_underruns() == 0);
+
+        sink.meta_stop();
+        other.stop();
+    }
+
+    std::remove(first.c_str());
+    std::remove(second.c_str());
+    std::remove(third.c_str());
+}
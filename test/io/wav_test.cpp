@@ -17,8 +17,11 @@
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
 #include <memory>
+#include <chrono>
 #include <random>
+#include <thread>
 #include <utility>
 
 #include "audio_buffer.hpp"
@@ -764,6 +767,55 @@ TEST_CASE("Wave Writer", "[io][wav]") {
         }
     }
 
+    SECTION("16bit Dither", "Ensures dithered 16bit files stay within one LSB") {
+
+        CharOStream stream;
+
+        wav.set_stream(&stream);
+
+        wav.set_bits_per_sample(16);
+        wav.set_samplerate(48000);
+        wav.set_channels(2);
+        wav.set_dither(true);
+        wav.set_noise_shaping(NoiseShaping::FirstOrder);
+
+        REQUIRE(wav.get_dither());
+        REQUIRE(wav.get_noise_shaping() == NoiseShaping::FirstOrder);
+
+        wav.start();
+
+        BufferPointer buff = std::make_unique<AudioBuffer>(data_wavs.size() / 2, 2);
+
+        for (int i = 0; i < data_wavs.size(); ++i) {
+
+            buff->at(i) = int16_mf(data_wavs.at(i));
+        }
+
+        wav.write_data(std::move(buff));
+
+        wav.stop();
+
+        // The header must match, and each sample may move by the dither:
+
+        REQUIRE(stream.get_array().size() == wavs.get_array().size());
+
+        const std::size_t start = wavs.get_array().size() - data_wavs.size() * 2;
+
+        for (std::size_t i = 0; i < start; ++i) {
+
+            REQUIRE(wavs.get_array().at(i) == stream.get_array().at(i));
+        }
+
+        for (std::size_t i = 0; i < data_wavs.size(); ++i) {
+
+            const unsigned char* byts = stream.get_array().data() + start + i * 2;
+
+            const auto val = static_cast<int16_t>(byts[0] | (byts[1] << 8));
+
+            REQUIRE(std::abs(val - data_wavs.at(i)) <= 2);
+        }
+    }
+
     SECTION("8bit Wave", "Ensures we can create wave files of 8bit integers") {
 
         // We use the wave file examples for this test!
@@ -932,7 +984,7 @@ TEST_CASE("Random Wave", "[io][wav]") {
 
         // Create the frame:
 
-        const long double frame = uchar_mf(gdist(gen));
+        const sample_t frame = uchar_mf(gdist(gen));
 
         *iter = frame;
         backup.at(iter.get_index()) = frame;
@@ -1002,3 +1054,364 @@ TEST_CASE("Random Wave", "[io][wav]") {
         REQUIRE_THAT(outb->at(i), Catch::Matchers::WithinAbs(backup.at(i), 0.0001));
     }
 }
+
+TEST_CASE("Wave Random Access", "[io][wav]") {
+
+    WaveReader wav;
+
+    SECTION("Seek Frame", "Ensures we can start reading from any frame") {
+
+        auto swave = jwavs;
+
+        wav.set_stream(&swave);
+        wav.start();
+
+        // Frame count is unknown until we find the data:
+
+        REQUIRE(wav.get_frames() == 0);
+
+        wav.seek_frame(3);
+
+        REQUIRE(wav.get_frames() == 5);
+
+        // Read the remaining frames:
+
+        wav.set_buffer_size(2);
+
+        auto data = wav.get_data();
+
+        for (int i = 0; i < 4; ++i) {
+
+            REQUIRE(int16_mf(data_wavs.at(6 + i)) == data->at(i));
+        }
+
+        // Go back to the start and read again:
+
+        wav.seek_frame(0);
+
+        data = wav.get_data();
+
+        for (int i = 0; i < 4; ++i) {
+
+            REQUIRE(int16_mf(data_wavs.at(i)) == data->at(i));
+        }
+
+        // Seeking past the end should give us silence:
+
+        wav.seek_frame(50);
+
+        data = wav.get_data();
+
+        REQUIRE(data->at(0) == 0);
+    }
+
+    SECTION("Fixed Point", "Ensures 16 bit samples are read without conversion") {
+
+        auto swave = jwavs;
+
+        wav.set_stream(&swave);
+        wav.start();
+
+        wav.set_buffer_size(3);
+
+        std::vector<int16_t> data(6);
+
+        REQUIRE(wav.get_data(data.data()) == 6);
+
+        for (int i = 0; i < 6; ++i) {
+
+            REQUIRE(data.at(i) == data_wavs.at(i));
+        }
+
+        // The end of the file is padded with silence:
+
+        REQUIRE(wav.get_data(data.data()) == 4);
+
+        for (int i = 0; i < 4; ++i) {
+
+            REQUIRE(data.at(i) == data_wavs.at(6 + i));
+        }
+
+        REQUIRE(data.at(4) == 0);
+        REQUIRE(data.at(5) == 0);
+    }
+
+    SECTION("Mapped File", "Ensures wave files can be decoded from a memory mapping") {
+
+        // Write the interrupting junk file to disk:
+
+        std::string path = "WAVE_MMAP_TEST.wav";
+
+        auto jwave = jiwavs;
+
+        FOStream ostream;
+
+        ostream.set_path(path);
+        ostream.start();
+        ostream.write(reinterpret_cast<char*>(jwave.get_array().data()), static_cast<int>(jwave.get_array().size()));
+        ostream.stop();
+
+        // Map and read the file:
+
+        MMapIStream istream(path);
+
+        wav.set_stream(&istream);
+        wav.start();
+
+        REQUIRE(wav.get_channels() == 2);
+        REQUIRE(wav.get_bits_per_sample() == 16);
+
+        wav.set_buffer_size(10);
+
+        auto data = wav.get_data();
+
+        for (int i = 0; i < 20; ++i) {
+
+            REQUIRE(int16_mf(data_wavji.at(i)) == data->at(i));
+        }
+
+        // We should be done with the file:
+
+        REQUIRE(wav.done());
+
+        // Read the same file without a mapping:
+
+        FIStream fstream;
+
+        fstream.set_path(path);
+
+        WaveReader fwav(&fstream);
+
+        fwav.start();
+        fwav.set_buffer_size(10);
+
+        auto fdata = fwav.get_data();
+
+        for (int i = 0; i < 20; ++i) {
+
+            REQUIRE(fdata->at(i) == data->at(i));
+        }
+
+        // Read the same file through a buffer:
+
+        FIStream bfstream;
+
+        bfstream.set_path(path);
+
+        BufferedIStream buffered(&bfstream, 16);
+
+        WaveReader bwav(&buffered);
+
+        bwav.start();
+        bwav.set_buffer_size(3);
+
+        for (int block = 0; block < 4; ++block) {
+
+            auto bdata = bwav.get_data();
+
+            for (int i = 0; i < 6 && block * 6 + i < 20; ++i) {
+
+                REQUIRE(bdata->at(i) == data->at(block * 6 + i));
+            }
+        }
+
+        REQUIRE(bwav.done());
+
+        // Delete file:
+
+        std::remove(path.c_str());
+    }
+
+    SECTION("Borrowed Memory", "Ensures wave files can be decoded from memory we don't own") {
+
+        const std::vector<unsigned char> mem = jiwavs.get_array();
+
+        SpanIStream istream(mem);
+
+        wav.set_stream(&istream);
+        wav.start();
+        wav.set_buffer_size(10);
+
+        auto data = wav.get_data();
+
+        for (int i = 0; i < 20; ++i) {
+
+            REQUIRE(int16_mf(data_wavji.at(i)) == data->at(i));
+        }
+    }
+}
+
+TEST_CASE("Wave Source", "[io][wav]") {
+
+    // Create a source for the interrupting junk file:
+
+    auto jwave = jiwavs;
+
+    WaveSource source(&jwave);
+
+    source.get_info()->out_buffer = 2;
+
+    SECTION("Synchronous", "Ensures blocks are read when processed") {
+
+        source.start();
+
+        for (int block = 0; block < 5; ++block) {
+
+            source.process();
+
+            auto data = source.get_buffer();
+
+            REQUIRE(data->channels() == 2);
+
+            for (int i = 0; i < 4; ++i) {
+
+                REQUIRE(int16_mf(data_wavji.at(block * 4 + i)) == data->at(i));
+            }
+        }
+
+        source.stop();
+    }
+
+    SECTION("Prefetch", "Ensures blocks are read ahead on another thread") {
+
+        source.set_prefetch(2);
+
+        REQUIRE(source.get_prefetch() == 2);
+
+        source.start();
+
+        int block = 0;
+        uint64_t silent = 0;
+
+        while (block < 5) {
+
+            source.process();
+
+            auto data = source.get_buffer();
+
+            REQUIRE(data->channels() == 2);
+
+            // Silence means the prefetch thread is behind:
+
+            if (data->at(0) == 0) {
+
+                ++silent;
+
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+                continue;
+            }
+
+            for (int i = 0; i < 4; ++i) {
+
+                REQUIRE(int16_mf(data_wavji.at(block * 4 + i)) == data->at(i));
+            }
+
+            ++block;
+        }
+
+        REQUIRE(source.get_underruns() == silent);
+
+        // Past the end we should get silence:
+
+        source.process();
+
+        REQUIRE(source.get_buffer()->at(0) == 0);
+
+        source.stop();
+    }
+}
+
+TEST_CASE("RF64 Wave", "[io][wav]") {
+
+    // Create a writer with the standard wave parameters:
+
+    CharOStream stream;
+
+    WaveWriter wav;
+
+    wav.set_stream(&stream);
+    wav.set_bits_per_sample(16);
+    wav.set_samplerate(48000);
+    wav.set_channels(2);
+
+    BufferPointer buff = std::make_unique<AudioBuffer>(data_wavs.size());
+
+    for (int i = 0; i < data_wavs.size(); ++i) {
+
+        buff->at(i) = int16_mf(data_wavs.at(i));
+    }
+
+    SECTION("Reserve", "Ensures small files with reserved space are standard wave files") {
+
+        wav.set_rf64(WaveWriter::reserve);
+
+        REQUIRE(wav.get_rf64() == WaveWriter::reserve);
+
+        wav.start();
+        wav.write_data(std::move(buff));
+        wav.stop();
+
+        // Read the file back, the reserved space should be skipped:
+
+        CharIStream istream;
+
+        istream.get_array() = stream.get_array();
+
+        WaveReader rwav(&istream);
+
+        rwav.start();
+
+        REQUIRE(rwav.get_size() == 56 + 8 + 36);
+
+        rwav.set_buffer_size(5);
+
+        auto data = rwav.get_data();
+
+        for (int i = 0; i < data_wavs.size(); ++i) {
+
+            REQUIRE(int16_mf(data_wavs.at(i)) == data->at(i));
+        }
+    }
+
+    SECTION("Always", "Ensures RF64 headers are written") {
+
+        wav.set_rf64(WaveWriter::always);
+
+        wav.start();
+        wav.write_data(std::move(buff));
+        wav.stop();
+
+        auto& arr = stream.get_array();
+
+        // Reads a little endian value from the output:
+
+        auto value = [&arr](std::size_t pos, int bytes) {
+
+            uint64_t val = 0;
+
+            for (int i = bytes - 1; i >= 0; --i) {
+
+                val = (val << 8) | arr.at(pos + i);
+            }
+
+            return val;
+        };
+
+        REQUIRE(std::string(arr.begin(), arr.begin() + 4) == "RF64");
+        REQUIRE(value(4, 4) == UINT32_MAX);
+
+        // ds64 chunk:
+
+        REQUIRE(std::string(arr.begin() + 12, arr.begin() + 16) == "ds64");
+        REQUIRE(value(16, 4) == 28);
+        REQUIRE(value(20, 8) == arr.size() - 8);
+        REQUIRE(value(28, 8) == 20);
+        REQUIRE(value(36, 8) == 5);
+
+        // Data chunk:
+
+        REQUIRE(std::string(arr.begin() + 72, arr.begin() + 76) == "data");
+        REQUIRE(value(76, 4) == UINT32_MAX);
+    }
+}
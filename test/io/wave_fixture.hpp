@@ -0,0 +1,61 @@
+/**
+ * @file wave_fixture.hpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Wave files shared by tests that load samples from disk
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "audio_buffer.hpp"
+#include "io/wav.hpp"
+
+/**
+ * @brief Determines the value of a frame in our test files
+ *
+ * @param frame Frame to determine
+ * @return sample_t Value of the frame
+ */
+inline sample_t frame_value(int frame) { return static_cast<sample_t>((frame % 200) - 100) / 128; }
+
+/**
+ * @brief Writes a mono 16 bit wave file
+ *
+ * Frame i of the file holds frame_value(i).
+ *
+ * @param path Path to the file
+ * @param frames Number of frames to write
+ * @param rate Sample rate of the file
+ */
+inline void write_wave(const std::string& path, int frames, int rate) {
+
+    FOStream stream;
+
+    stream.set_path(path);
+    stream.start();
+
+    WaveWriter wav;
+
+    wav.set_stream(&stream);
+    wav.set_bits_per_sample(16);
+    wav.set_samplerate(rate);
+    wav.set_channels(1);
+
+    BufferPointer buff = std::make_unique<AudioBuffer>(frames);
+
+    for (int i = 0; i < frames; ++i) {
+
+        buff->at(i) = frame_value(i);
+    }
+
+    wav.start();
+    wav.write_data(std::move(buff));
+    wav.stop();
+}
@@ -12,6 +12,8 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 
+#include <algorithm>
+
 #include "meta_audio.hpp"
 #include "fund_oscillator.hpp"
 
@@ -151,6 +153,28 @@ TEST_CASE("MetaLatency Test", "[meta]") {
         REQUIRE(late.total_latency() == late.total_time() - late.expected());
     }
 
+    SECTION("Jitter", "Ensures our understanding of the jitter is accurate") {
+
+        // No jitter can be measured with one operation:
+
+        REQUIRE(0 == late.jitter());
+        REQUIRE(0 == late.average_jitter());
+        REQUIRE(late.time() == late.max_time());
+
+        // Meta process twice more:
+
+        late.meta_process();
+
+        const int64_t first = late.jitter();
+
+        late.meta_process();
+
+        REQUIRE(0 <= late.jitter());
+        REQUIRE(std::max(first, late.jitter()) == late.max_jitter());
+        REQUIRE((first + late.jitter()) / 2 == late.average_jitter());
+        REQUIRE(late.time() <= late.max_time());
+    }
+
     SECTION("Reset", "Ensures we can be reset") {
 
         // Reset the module:
@@ -167,6 +191,11 @@ TEST_CASE("MetaLatency Test", "[meta]") {
         REQUIRE(0 == late.total_latency());
         REQUIRE(0 == late.average_latency());
         REQUIRE(0 == late.sum_latency());
+
+        REQUIRE(0 == late.max_time());
+        REQUIRE(0 == late.jitter());
+        REQUIRE(0 == late.max_jitter());
+        REQUIRE(0 == late.average_jitter());
     }
 }
 
@@ -178,7 +207,7 @@ TEST_CASE("MetaBuffer Test", "[meta]") {
 
     // Create a dummy buffer:
 
-    std::vector<long double> data = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    std::vector<sample_t> data = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
 
     AudioBuffer rep(data);
 
@@ -295,7 +324,7 @@ TEST_CASE("UniformBuffer Test", "[meta]") {
 
         // Loop a certain number of times:
 
-        long double last = 0;
+        sample_t last = 0;
 
         // Create buffer:
 
@@ -0,0 +1,166 @@
+/**
+ * @file module_arena_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for module arenas
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+#include "amp_module.hpp"
+#include "chain_plan.hpp"
+#include "dsp/denormal.hpp"
+#include "fund_oscillator.hpp"
+#include "module_arena.hpp"
+#include "sink_module.hpp"
+#include "utils.hpp"
+
+namespace {
+
+/**
+ * @brief Records the order objects are destroyed in
+ */
+struct Tracked {
+
+    /// Order of destruction
+    std::vector<int>* order = nullptr;
+
+    /// ID of this object
+    int id = 0;
+
+    Tracked(std::vector<int>* ord, int num) : order(ord), id(num) {}
+
+    ~Tracked() { this->order->push_back(this->id); }
+};
+
+}  // namespace
+
+TEST_CASE("ModuleArena Test", "[arena]") {
+
+    // Started sinks flush denormals, restore the mode of this thread once we are done:
+
+    const FlushToZeroScope ftz(flush_to_zero());
+
+    ModuleArena arena(1 << 20);
+
+    SECTION("Create", "Ensures objects are placed one after the other") {
+
+        auto* first = arena.create<SineOscillator>(440);
+        auto* second = arena.create<AmplitudeScale>(0.5);
+
+        REQUIRE(arena.size() == 2);
+        REQUIRE(arena.owns(first));
+        REQUIRE(arena.owns(second));
+        REQUIRE(static_cast<void*>(second) > static_cast<void*>(first));
+        REQUIRE(arena.allocated() >= sizeof(SineOscillator) + sizeof(AmplitudeScale));
+    }
+
+    SECTION("Destroy", "Ensures objects are destroyed in reverse order") {
+
+        std::vector<int> order;
+
+        arena.create<Tracked>(&order, 1);
+        arena.create<Tracked>(&order, 2);
+        arena.create<Tracked>(&order, 3);
+
+        arena.clear();
+
+        REQUIRE(order == std::vector<int>{3, 2, 1});
+        REQUIRE(arena.size() == 0);
+        REQUIRE(arena.allocated() == 0);
+    }
+
+    SECTION("Full", "Ensures objects are created on the heap once the arena is full") {
+
+        ModuleArena small(1);
+
+        std::vector<int> order;
+
+        while (small.allocated() + sizeof(Tracked) <= small.capacity()) {
+
+            small.create<Tracked>(&order, 0);
+        }
+
+        auto* extra = small.create<Tracked>(&order, 1);
+
+        REQUIRE(!small.owns(extra));
+
+        small.clear();
+
+        REQUIRE(order.front() == 1);
+    }
+
+    SECTION("Scope", "Ensures buffers and created objects use the arena in scope") {
+
+        {
+            auto scope = arena.scope();
+
+            REQUIRE(ModuleArena::current() == &arena);
+
+            auto buff = AudioModule::create_buffer(64, 1);
+
+            REQUIRE(arena.owns(buff->data()));
+
+            ModulePointer<ConstModule> mod = make_module<ConstModule>(0.5);
+
+            REQUIRE(arena.owns(mod.get()));
+
+            Collection<AudioModule> coll;
+
+            REQUIRE(arena.owns(coll.create_object<AmplitudeScale>(0.5)));
+        }
+
+        REQUIRE(ModuleArena::current() == nullptr);
+
+        ModulePointer<ConstModule> mod = make_module<ConstModule>(0.5);
+
+        REQUIRE(!arena.owns(mod.get()));
+    }
+
+    SECTION("Order", "Ensures chains built from the source are laid out in order") {
+
+        auto scope = arena.scope();
+
+        SineOscillator lfo(2);
+
+        auto* osc = arena.create<ModSineOscillator>(440);
+        auto* amp = arena.create<AmplitudeScale>(0.5);
+        auto* sink = arena.create<PeriodSink>();
+
+        sink->bind(amp);
+        amp->bind(osc);
+        osc->get_frequency()->bind(&lfo);
+
+        sink->meta_info_sync();
+        sink->meta_start();
+
+        ChainPlan plan(sink);
+
+        REQUIRE(arena.in_order(plan));
+
+        // Chains built from the sink are processed backwards:
+
+        auto* rsink = arena.create<PeriodSink>();
+        auto* ramp = arena.create<AmplitudeScale>(0.5);
+        auto* rosc = arena.create<SineOscillator>(440);
+
+        rsink->bind(ramp);
+        ramp->bind(rosc);
+
+        rsink->meta_info_sync();
+        rsink->meta_start();
+
+        ChainPlan reverse(rsink);
+
+        REQUIRE(!arena.in_order(reverse));
+
+        sink->meta_stop();
+        rsink->meta_stop();
+    }
+}
@@ -12,8 +12,17 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "dsp/denormal.hpp"
+#include "executor.hpp"
+#include "fund_oscillator.hpp"
 #include "module_mixer.hpp"
 #include "meta_audio.hpp"
+#include "sink_module.hpp"
 
 TEST_CASE("ModuleMixUp Tests", "[mixer]") {
 
@@ -79,10 +88,96 @@ TEST_CASE("ModuleMixUp Tests", "[mixer]") {
             REQUIRE_THAT(item, Catch::Matchers::WithinAbs(0.50, 0.0001));
         }
     }
+
+    SECTION("Share", "Ensures read only modules share one buffer") {
+
+        ConstModule osc(0.25);
+
+        mix.bind(&osc);
+
+        // Create the read only modules:
+
+        std::vector<Counter> counters(16);
+
+        for (auto& counter : counters) {
+
+            counter.bind(&mix);
+        }
+
+        ChainInfo chain;
+
+        mix.set_chain_info(&chain);
+        osc.set_chain_info(&chain);
+
+        for (auto& counter : counters) {
+
+            counter.set_chain_info(&chain);
+        }
+
+        // Warm up the shared slots:
+
+        for (int i = 0; i < 2; ++i) {
+
+            mix.meta_process();
+
+            for (auto& counter : counters) {
+
+                counter.step();
+            }
+        }
+
+        const int allocs = chain.pool.allocations();
+
+        for (int i = 0; i < 10; ++i) {
+
+            mix.meta_process();
+
+            // Every counter should see the same buffer:
+
+            SharedBuffer shared = mix.share_buffer();
+
+            for (auto& counter : counters) {
+
+                counter.step();
+            }
+
+            REQUIRE(shared.use_count() == 18);
+        }
+
+        // Ensure nothing was copied:
+
+        REQUIRE(chain.pool.allocations() == allocs);
+
+        for (auto& counter : counters) {
+
+            REQUIRE(counter.processed() == 12);
+            REQUIRE(counter.samples() == 12 * mix.get_info()->out_buffer);
+        }
+
+        // Ensure a module that takes the buffer gets its own copy:
+
+        std::unique_ptr<AudioBuffer> buff = counters.at(0).get_buffer();
+
+        REQUIRE(buff != nullptr);
+        REQUIRE(buff->data() != mix.share_buffer()->data());
+
+        std::fill(buff->ibegin(), buff->iend(), 1);
+
+        SharedBuffer shared = mix.share_buffer();
+
+        for (std::size_t i = 0; i < shared->size(); ++i) {
+
+            REQUIRE_THAT(shared->data()[i], Catch::Matchers::WithinAbs(0.25, 0.0001));
+        }
+    }
 }
 
 TEST_CASE("ModuleMixDown Tests", "[mixer]") {
 
+    // Started sinks flush denormals, restore the mode of this thread once we are done:
+
+    const FlushToZeroScope ftz(flush_to_zero());
+
     // Create the mixer:
 
     ModuleMixDown mix;
@@ -133,6 +228,393 @@ TEST_CASE("ModuleMixDown Tests", "[mixer]") {
             REQUIRE_THAT(item, Catch::Matchers::WithinAbs(0.5, 0.0001));
         }
     }
+
+    SECTION("Silence", "Ensures silent inputs are skipped and constant mixes are marked") {
+
+        ConstModule osc1(0.25);
+        ConstModule osc2(0);
+        SineOscillator osc3(440);
+
+        mix.bind(&osc1);
+        mix.bind(&osc2);
+
+        mix.set_gain(0, 2);
+
+        mix.meta_process();
+
+        auto buff = mix.get_buffer();
+
+        REQUIRE(buff->is_constant());
+        REQUIRE_THAT(buff->get_constant(), Catch::Matchers::WithinAbs(0.5, 0.0001));
+
+        for (auto item : *buff) {
+
+            REQUIRE_THAT(item, Catch::Matchers::WithinAbs(0.5, 0.0001));
+        }
+
+        // Any input that changes makes the mix unknown:
+
+        mix.bind(&osc3);
+
+        mix.meta_process();
+
+        REQUIRE(!mix.get_buffer()->is_constant());
+    }
+
+    SECTION("Gain", "Ensures each input is scaled by its gain") {
+
+        ConstModule osc1(0.25);
+        ConstModule osc2(0.5);
+
+        mix.bind(&osc1);
+        mix.bind(&osc2);
+
+        REQUIRE(mix.get_gain(0) == 1.0);
+
+        mix.set_gain(1, 0.5);
+
+        mix.meta_process();
+
+        auto buff = mix.get_buffer();
+
+        for (auto item : *buff) {
+
+            REQUIRE_THAT(item, Catch::Matchers::WithinAbs(0.5, 0.0001));
+        }
+    }
+
+    SECTION("Chain", "Ensures inputs are synced, started and stopped with the chain") {
+
+        ConstModule osc1(0.25);
+        ConstModule osc2(0.25);
+        SinkModule sink;
+
+        sink.get_chain_info()->buffer_size = 128;
+
+        sink.bind(&mix);
+        mix.bind(&osc1);
+        mix.bind(&osc2);
+
+        sink.meta_info_sync();
+
+        REQUIRE(osc1.get_info()->out_buffer == 128);
+        REQUIRE(osc2.get_info()->out_buffer == 128);
+
+        sink.meta_start();
+
+        REQUIRE(osc1.get_state() == BaseModule::State::Started);
+        REQUIRE(osc2.get_state() == BaseModule::State::Started);
+
+        sink.meta_process();
+
+        REQUIRE(sink.get_buffer()->size() == 128);
+
+        sink.meta_stop();
+
+        REQUIRE(osc1.get_state() == BaseModule::State::Stopped);
+        REQUIRE(osc2.get_state() == BaseModule::State::Stopped);
+    }
+
+    SECTION("Bus", "Ensures a large bus does not allocate in the steady state") {
+
+        std::vector<ConstModule> inputs(64);
+
+        SinkModule sink;
+
+        sink.bind(&mix);
+
+        for (auto& input : inputs) {
+
+            input.set_value(1);
+
+            mix.bind(&input);
+        }
+
+        ChainInfo* chain = sink.get_chain_info();
+
+        chain->pool.set_max(128);
+
+        sink.meta_info_sync();
+        sink.meta_start();
+
+        // Inputs share the chain of the mixer:
+
+        for (const auto& input : inputs) {
+
+            REQUIRE(input.get_chain_info() == chain);
+        }
+
+        // Warm up the pool, the sink holds a block while the next is mixed:
+
+        sink.meta_process();
+        sink.meta_process();
+
+        const int allocs = chain->pool.allocations();
+
+        for (int i = 0; i < 100; ++i) {
+
+            sink.meta_process();
+        }
+
+        REQUIRE(chain->pool.allocations() == allocs);
+
+        sink.meta_stop();
+    }
+}
+
+TEST_CASE("WorkerPool Tests", "[mixer][executor]") {
+
+    WorkerPool pool(2);
+
+    SECTION("Run", "Ensures every task is run exactly once") {
+
+        REQUIRE(pool.size() == 2);
+
+        std::vector<int> out(100, 0);
+
+        const bool met = pool.run([&out](int index) { out.at(index) += index; }, 100);
+
+        REQUIRE(met);
+
+        for (int i = 0; i < 100; ++i) {
+
+            REQUIRE(out.at(i) == i);
+        }
+    }
+
+    SECTION("Reserve", "Ensures reserved batches run without growing the queues") {
+
+        pool.reserve(100);
+
+        const int slots = pool.capacity();
+
+        REQUIRE(slots >= 100);
+
+        std::vector<int> out(100, 0);
+
+        for (int i = 0; i < 10; ++i) {
+
+            pool.run([&out](int index) { out.at(index) += 1; }, 100);
+        }
+
+        REQUIRE(out == std::vector<int>(100, 10));
+        REQUIRE(pool.capacity() == slots);
+
+        // Larger batches still run, and grow the queues:
+
+        std::vector<int> big(1000, 0);
+
+        pool.run([&big](int index) { big.at(index) = index; }, 1000);
+
+        for (int i = 0; i < 1000; ++i) {
+
+            REQUIRE(big.at(i) == i);
+        }
+
+        REQUIRE(pool.capacity() >= slots);
+    }
+
+    SECTION("Deadline", "Ensures missed deadlines are reported") {
+
+        std::vector<int> out(4, 0);
+
+        const bool met = pool.run([&out](int index) {
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+            out.at(index) = 1;
+        }, 4, 1);
+
+        REQUIRE(!met);
+        REQUIRE(out == std::vector<int>{1, 1, 1, 1});
+    }
+}
+
+TEST_CASE("NUMA WorkerPool Tests", "[mixer][executor][numa]") {
+
+    SECTION("Parse", "Ensures CPU lists are parsed") {
+
+        REQUIRE(parse_cpu_list("0-3,8,10-11\n") == std::vector<int>{0, 1, 2, 3, 8, 10, 11});
+        REQUIRE(parse_cpu_list("").empty());
+        REQUIRE(parse_cpu_list("bad").empty());
+    }
+
+    SECTION("Detect", "Ensures the topology of this machine has at least one node with CPUs") {
+
+        const NumaTopology topo = NumaTopology::detect();
+
+        REQUIRE(topo.size() >= 1);
+
+        for (int node = 0; node < topo.size(); ++node) {
+
+            REQUIRE(!topo.get_cpus(node).empty());
+        }
+    }
+
+    SECTION("Partition", "Ensures tasks run once, on the node they are partitioned to") {
+
+        // Pretend CPU 0 is two nodes:
+
+        WorkerPool pool(NumaTopology({{0}, {0}}), 1);
+
+        REQUIRE(pool.size() == 2);
+        REQUIRE(pool.node_count() == 2);
+        REQUIRE(pool.get_node(0) == 0);
+        REQUIRE(pool.get_node(1) == 1);
+        REQUIRE(!pool.get_remote_stealing());
+        REQUIRE(WorkerPool::current_node() == -1);
+
+        const int num = 50;
+
+        std::vector<int> out(num, 0);
+        std::vector<int> nodes(num, 0);
+
+        pool.run([&](int index) {
+
+            out.at(index) += 1;
+            nodes.at(index) = WorkerPool::current_node();
+        }, num);
+
+        for (int i = 0; i < num; ++i) {
+
+            REQUIRE(out.at(i) == 1);
+            REQUIRE(pool.node_of(i, num) == (i < num / 2 ? 0 : 1));
+
+            // Tasks run by the submitter have no node:
+
+            REQUIRE((nodes.at(i) == -1 || nodes.at(i) == pool.node_of(i, num)));
+        }
+
+        pool.set_remote_stealing(true);
+
+        std::fill(out.begin(), out.end(), 0);
+
+        pool.run([&](int index) { out.at(index) += 1; }, num);
+
+        REQUIRE(out == std::vector<int>(num, 1));
+    }
+}
+
+TEST_CASE("ModuleMixDown Parallel Tests", "[mixer][executor]") {
+
+    // Started sinks flush denormals, restore the mode of this thread once we are done:
+
+    const FlushToZeroScope ftz(flush_to_zero());
+
+    WorkerPool pool(2);
+
+    // Create independent subtrees:
+
+    ConstModule osc1(0.125);
+    ConstModule osc2(0.25);
+    ConstModule osc3(0.5);
+
+    Counter count1;
+    Counter count2;
+    Counter count3;
+
+    count1.bind(&osc1);
+    count2.bind(&osc2);
+    count3.bind(&osc3);
+
+    ModuleMixDown mix;
+
+    mix.bind(&count1);
+    mix.bind(&count2);
+    mix.bind(&count3);
+
+    mix.set_executor(&pool);
+
+    SECTION("Process", "Ensures concurrent results match serial results") {
+
+        for (int i = 0; i < 10; ++i) {
+
+            mix.meta_process();
+
+            auto buff = mix.get_buffer();
+
+            for (auto item : *buff) {
+
+                REQUIRE(item == static_cast<sample_t>(0.875));
+            }
+        }
+
+        REQUIRE(count1.processed() == 10);
+        REQUIRE(count2.processed() == 10);
+        REQUIRE(count3.processed() == 10);
+    }
+
+    SECTION("Fallback", "Ensures we fall back to serial processing after a missed deadline") {
+
+        mix.set_deadline(1);
+        mix.set_backoff(2);
+
+        // Any real work will miss a one nanosecond deadline:
+
+        mix.meta_process();
+
+        REQUIRE(mix.is_fallback());
+
+        mix.meta_process();
+        mix.meta_process();
+
+        REQUIRE(!mix.is_fallback());
+
+        auto buff = mix.get_buffer();
+
+        for (auto item : *buff) {
+
+            REQUIRE(item == static_cast<sample_t>(0.875));
+        }
+
+        REQUIRE(count1.processed() == 3);
+    }
+
+    SECTION("Chain", "Ensures each input gets a sub-chain that follows the chain") {
+
+        SinkModule sink;
+
+        sink.bind(&mix);
+
+        ChainInfo* chain = sink.get_chain_info();
+
+        sink.meta_info_sync();
+        sink.meta_start();
+
+        // Syncing reserves a task for each input:
+
+        REQUIRE(pool.capacity() >= 3);
+
+        // Each subtree has its own chain:
+
+        const ChainInfo* sub1 = count1.get_chain_info();
+        const ChainInfo* sub2 = count2.get_chain_info();
+
+        REQUIRE(sub1 != nullptr);
+        REQUIRE(sub2 != nullptr);
+        REQUIRE(sub1 != chain);
+        REQUIRE(sub1 != sub2);
+        REQUIRE(osc1.get_chain_info() == sub1);
+        REQUIRE(sub1->buffer_size == chain->buffer_size);
+
+        // Sub-chains follow the time of the chain, and keep their buffers pooled:
+
+        sink.meta_process();
+        sink.meta_process();
+
+        const int allocs = sub1->pool.allocations();
+
+        for (int i = 0; i < 10; ++i) {
+
+            sink.meta_process();
+
+            REQUIRE(sub1->sample == chain->sample - chain->buffer_size);
+        }
+
+        REQUIRE(sub1->pool.allocations() == allocs);
+
+        sink.meta_stop();
+    }
 }
 
 TEST_CASE("MultiMix Tests", "[mixer]") {
@@ -0,0 +1,132 @@
+/**
+ * @file osc_bank_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for the oscillator bank
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "osc_bank.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <memory>
+#include <numbers>
+#include <vector>
+
+#include "audio_buffer.hpp"
+
+/**
+ * @brief Determines the ideal value of a sine voice
+ *
+ * @param freq Frequency in hertz
+ * @param amp Amplitude
+ * @param index Index of the sample
+ * @param rate Sample rate in hertz
+ * @return double Value of the voice
+ */
+double bank_ideal(double freq, double amp, int index, double rate) { return amp * std::sin(2 * std::numbers::pi * freq * index / rate); }
+
+TEST_CASE("OscillatorBank Test", "[osc]") {
+
+    OscillatorBank bank(3);
+
+    const double rate = bank.get_info()->sample_rate;
+
+    SECTION("Default Values", "Ensures the constructor has proper default values") {
+
+        REQUIRE(bank.get_voices() == 3);
+        REQUIRE(bank.get_output() == OscillatorBank::Output::Sum);
+        REQUIRE(bank.get_frequency(2) == 0);
+        REQUIRE(bank.get_amplitude(2) == 0);
+    }
+
+    SECTION("Sum", "Ensures voices are summed into one channel across blocks") {
+
+        bank.set_frequency(0, 440);
+        bank.set_amplitude(0, 0.5);
+        bank.set_frequency(1, 1000);
+        bank.set_amplitude(1, 0.25);
+        bank.set_frequency(2, 3000);
+        bank.set_amplitude(2, 0.125);
+
+        int index = 0;
+
+        for (int block = 0; block < 3; ++block) {
+
+            bank.meta_process();
+
+            std::unique_ptr<AudioBuffer> buff = bank.get_buffer();
+
+            REQUIRE(buff->channels() == 1);
+            REQUIRE(static_cast<int>(buff->size()) == bank.get_info()->out_buffer);
+
+            for (std::size_t i = 0; i < buff->size(); ++i, ++index) {
+
+                const double expected = bank_ideal(440, 0.5, index, rate) + bank_ideal(1000, 0.25, index, rate) + bank_ideal(3000, 0.125, index, rate);
+
+                REQUIRE_THAT(buff->at(static_cast<int>(i)), Catch::Matchers::WithinAbs(expected, 0.001));
+            }
+        }
+    }
+
+    SECTION("Voices", "Ensures each voice is written to its own channel") {
+
+        bank.set_output(OscillatorBank::Output::Voices);
+
+        for (int v = 0; v < 3; ++v) {
+
+            bank.set_frequency(v, 200.0 * (v + 1));
+            bank.set_amplitude(v, 1.0);
+        }
+
+        bank.set_phase(1, 0.25);
+
+        bank.meta_process();
+
+        std::unique_ptr<AudioBuffer> buff = bank.get_buffer();
+
+        REQUIRE(buff->channels() == 3);
+
+        const int frames = static_cast<int>(buff->size()) / 3;
+
+        for (int i = 0; i < frames; ++i) {
+
+            REQUIRE_THAT(buff->at(0, i), Catch::Matchers::WithinAbs(bank_ideal(200, 1, i, rate), 0.001));
+            REQUIRE_THAT(buff->at(1, i), Catch::Matchers::WithinAbs(std::cos(2 * std::numbers::pi * 400 * i / rate), 0.001));
+            REQUIRE_THAT(buff->at(2, i), Catch::Matchers::WithinAbs(bank_ideal(600, 1, i, rate), 0.001));
+        }
+    }
+
+    SECTION("Harmonics", "Ensures harmonic series are built, and partials above Nyquist are muted") {
+
+        // 40 partials of 1 kHz, most of which are above Nyquist:
+
+        const std::vector<double> amps(40, 0.01);
+
+        bank.set_harmonics(1000, amps);
+
+        REQUIRE(bank.get_voices() == 40);
+        REQUIRE(bank.get_frequency(9) == 10000);
+
+        bank.meta_process();
+
+        std::unique_ptr<AudioBuffer> buff = bank.get_buffer();
+
+        for (std::size_t i = 0; i < buff->size(); ++i) {
+
+            double expected = 0;
+
+            for (int k = 1; k * 1000 < rate / 2; ++k) {
+
+                expected += bank_ideal(1000.0 * k, 0.01, static_cast<int>(i), rate);
+            }
+
+            REQUIRE_THAT(buff->at(static_cast<int>(i)), Catch::Matchers::WithinAbs(expected, 0.001));
+        }
+    }
+}
@@ -0,0 +1,171 @@
+/**
+ * @file oversample_module_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for oversampling modules
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "oversample_module.hpp"
+#include "fund_oscillator.hpp"
+#include "meta_audio.hpp"
+#include "sink_module.hpp"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Squares each sample
+ *
+ * This doubles the frequency of a sine,
+ * which aliases if the result is past the Nyquist frequency.
+ */
+class Square : public AudioModule {
+
+    public:
+
+        void process() override {
+
+            for (auto& val : *(this->buff)) {
+
+                val *= val;
+            }
+        }
+
+        bool in_place() const override { return true; }
+};
+
+}  // namespace
+
+TEST_CASE("OversampleModule Test", "[oversample]") {
+
+    SineOscillator osc(15000);
+    OversampleModule over(4);
+    Counter count;
+    PeriodSink sink;
+
+    over.bind(&osc);
+    sink.bind(&over);
+
+    over.set_chain(&count, &count);
+
+    sink.get_chain_info()->sample_rate = 48000;
+
+    sink.meta_info_sync();
+
+    SECTION("Config", "Ensures the sub-chain runs at the higher rate") {
+
+        REQUIRE(over.get_factor() == 4);
+        REQUIRE(over.get_stages() == 2);
+        REQUIRE(over.get_taps(0) == 32);
+        REQUIRE(over.get_taps(1) == 16);
+
+        REQUIRE(count.get_chain_info() == over.get_inner_chain());
+        REQUIRE(count.get_info()->sample_rate == 48000 * 4);
+        REQUIRE(count.get_info()->out_buffer == over.get_info()->out_buffer * 4);
+        REQUIRE(osc.get_info()->sample_rate == 48000);
+
+        // 31 samples at 2x, and 15 samples at 4x, on the way up and down:
+
+        REQUIRE(over.latency() == 39);
+        REQUIRE(over.get_info()->latency == 39);
+
+        // Factors are rounded down to a power of 2:
+
+        over.set_factor(6);
+
+        REQUIRE(over.get_factor() == 4);
+
+        over.set_factor(100);
+
+        REQUIRE(over.get_factor() == OversampleModule::MAX_FACTOR);
+    }
+
+    SECTION("Process", "Ensures the sub-chain is given blocks at the higher rate") {
+
+        sink.meta_start();
+
+        over.meta_process();
+
+        auto buff = over.get_buffer();
+
+        REQUIRE(buff->size() == static_cast<std::size_t>(over.get_info()->out_buffer));
+        REQUIRE(count.processed() == 1);
+        REQUIRE(count.samples() == over.get_info()->out_buffer * 4);
+        REQUIRE(over.get_inner_chain()->sample == over.get_info()->out_buffer * 4);
+
+        sink.meta_stop();
+    }
+
+    SECTION("Aliasing", "Ensures harmonics past the Nyquist frequency are removed") {
+
+        // Squaring a 15 kHz sine gives 0.5 plus a 30 kHz sine, which aliases to 18 kHz at 48 kHz:
+
+        Square square;
+
+        over.set_chain(&square, &square);
+
+        sink.meta_info_sync();
+        sink.meta_start();
+
+        double error = 0;
+
+        for (int i = 0; i < 8; ++i) {
+
+            over.meta_process();
+
+            auto buff = over.get_buffer();
+
+            // Wait for the filters to fill:
+
+            if (i < 2) {
+
+                continue;
+            }
+
+            for (auto val : *buff) {
+
+                error = std::max(error, std::fabs(static_cast<double>(val) - 0.5));
+            }
+        }
+
+        sink.meta_stop();
+
+        REQUIRE(error < 0.05);
+    }
+
+    SECTION("Pool", "Ensures we do not allocate in the steady state") {
+
+        ChainInfo& chain = *sink.get_chain_info();
+
+        sink.meta_start();
+
+        for (int i = 0; i < 5; ++i) {
+
+            over.meta_process();
+            over.release_buffer();
+        }
+
+        const int allocs = over.get_inner_chain()->pool.allocations();
+        const int main_allocs = chain.pool.allocations();
+
+        for (int i = 0; i < 50; ++i) {
+
+            over.meta_process();
+            over.release_buffer();
+        }
+
+        sink.meta_stop();
+
+        REQUIRE(over.get_inner_chain()->pool.allocations() == allocs);
+        REQUIRE(chain.pool.allocations() == main_allocs);
+    }
+}
@@ -13,10 +13,12 @@
 #include <catch2/matchers/catch_matchers.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 #include <memory>
+#include <tuple>
 #include <vector>
 
 #include "audio_buffer.hpp"
 #include "audio_module.hpp"
+#include "dsp/denormal.hpp"
 #include "meta_audio.hpp"
 #include "module_param.hpp"
 #include "sink_module.hpp"
@@ -93,7 +95,7 @@ TEST_CASE("Module Parameter Tests", "[param]") {
 
         // Dummy data to utilize
 
-        std::vector<long double> data = {1,2,3,4,5,6,7,8,9,10};
+        std::vector<sample_t> data = {1,2,3,4,5,6,7,8,9,10};
 
         // Create a module to use:
 
@@ -137,8 +139,149 @@ TEST_CASE("Module Parameter Tests", "[param]") {
     }
 }
 
+TEST_CASE("Parameter Rate Test", "[param]") {
+
+    SECTION("Rate", "Ensures the rate is determined correctly") {
+
+        ModuleParam param(5.0);
+
+        REQUIRE(param.get_rate() == ParamRate::Constant);
+        REQUIRE(param.get_constant() == 5.0);
+
+        ConstModule mod(3.0);
+
+        param.bind(&mod);
+
+        REQUIRE(param.get_rate() == ParamRate::Audio);
+
+        param.set_rate(ParamRate::Control);
+
+        REQUIRE(param.get_rate() == ParamRate::Control);
+
+        param.set_constant(2.0);
+
+        REQUIRE(param.get_rate() == ParamRate::Constant);
+    }
+
+    SECTION("Control", "Ensures control rate parameters generate one value per block") {
+
+        AudioModule mod;
+
+        mod.get_info()->in_buffer = 100;
+        mod.get_info()->sample_rate = 1000;
+
+        // Use a buffer, so we can change each value:
+
+        std::vector<sample_t> data = {1};
+        AudioBuffer buff(data);
+        BufferModule src(&buff);
+        ModuleParam param(&src);
+
+        param.set_rate(ParamRate::Control);
+        param.conf_mod(&mod);
+
+        REQUIRE(param.get_chain_info()->buffer_size == 1);
+        REQUIRE(param.get_chain_info()->sample_rate == 10);
+
+        auto [start, end] = param.get_control();
+
+        REQUIRE(start == 1);
+        REQUIRE(end == 1);
+
+        buff.at(0) = 4;
+
+        std::tie(start, end) = param.get_control();
+
+        REQUIRE(start == 1);
+        REQUIRE(end == 4);
+    }
+}
+
+TEST_CASE("Shared Parameter Test", "[param]") {
+
+    ConstModule osc(2.0);
+    Counter count;
+
+    count.bind(&osc);
+
+    ModuleParam first(&count);
+    ModuleParam second(&count);
+
+    // Read both parameters from the same chain:
+
+    ChainInfo chain;
+    AudioModule reader;
+
+    reader.set_chain_info(&chain);
+
+    first.conf_mod(&reader);
+    second.conf_mod(&reader);
+
+    SECTION("Leader", "Ensures the second parameter follows the first") {
+
+        REQUIRE(first.get_leader() == nullptr);
+        REQUIRE(second.get_leader() == &first);
+        REQUIRE(count.get_forward() == &first);
+
+        std::vector<AudioModule*> inputs;
+
+        second.plan_inputs(inputs);
+
+        REQUIRE(inputs.size() == 1);
+        REQUIRE(inputs[0] == &first);
+    }
+
+    SECTION("Memo", "Ensures the module is rendered once per block") {
+
+        const SharedBuffer one = first.share();
+        const SharedBuffer two = second.share();
+
+        REQUIRE(one == two);
+        REQUIRE(count.processed() == 1);
+
+        // A copy is made for get():
+
+        auto copy = second.get();
+
+        REQUIRE(count.processed() == 1);
+        REQUIRE(copy->size() == one->size());
+
+        for (auto val : *copy) {
+
+            REQUIRE_THAT(val, Catch::Matchers::WithinAbs(2.0, 0.0001));
+        }
+
+        // The next block is rendered again:
+
+        chain.sample += static_cast<int64_t>(one->size());
+
+        second.share();
+        first.share();
+
+        REQUIRE(count.processed() == 2);
+    }
+
+    SECTION("Rebind", "Ensures followers stop following when rebound") {
+
+        second.set_constant(1.0);
+
+        REQUIRE(second.get_leader() == nullptr);
+
+        first.share();
+        first.share();
+
+        // Without followers, each call renders:
+
+        REQUIRE(count.processed() == 2);
+    }
+}
+
 TEST_CASE("BaseParamTest", "[param]") {
 
+    // Started sinks flush denormals, restore the mode of this thread once we are done:
+
+    const FlushToZeroScope ftz(flush_to_zero());
+
     // Create the parameters:
 
     ModuleParam par1(0.);
@@ -269,6 +412,10 @@ TEST_CASE("BaseParamTest", "[param]") {
 
 TEST_CASE("ParamModule Test", "[param][mod]") {
 
+    // Started sinks flush denormals, restore the mode of this thread once we are done:
+
+    const FlushToZeroScope ftz(flush_to_zero());
+
     // Create the parameters:
 
     ModuleParam par1(0.);
@@ -409,6 +556,10 @@ TEST_CASE("ParamModule Test", "[param][mod]") {
 
 TEST_CASE("ParamSink Test", "[param][mod][sink]") {
 
+    // Started sinks flush denormals, restore the mode of this thread once we are done:
+
+    const FlushToZeroScope ftz(flush_to_zero());
+
     // Create the parameters:
 
     ModuleParam par1(0.);
@@ -545,6 +696,10 @@ TEST_CASE("ParamSink Test", "[param][mod][sink]") {
 
 TEST_CASE("ParamSource Test", "[param][mod][source]") {
 
+    // Started sinks flush denormals, restore the mode of this thread once we are done:
+
+    const FlushToZeroScope ftz(flush_to_zero());
+
     // Create the parameters:
 
     ModuleParam par1(0.);
@@ -0,0 +1,153 @@
+/**
+ * @file render_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for offline rendering components
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <vector>
+
+#include "executor.hpp"
+#include "fund_oscillator.hpp"
+#include "io/mstream.hpp"
+#include "meta_audio.hpp"
+#include "render.hpp"
+#include "source_module.hpp"
+
+namespace {
+
+/**
+ * @brief Source that outputs every channel of the chain
+ *
+ * Each channel is filled with its index plus one, scaled down.
+ */
+class ChannelSource : public SourceModule {
+
+    public:
+
+        void process() override {
+
+            const int channels = this->get_info()->channels;
+
+            this->set_buffer(this->create_buffer(channels));
+
+            const auto frames = static_cast<int>(this->buff->size()) / channels;
+
+            for (int c = 0; c < channels; ++c) {
+
+                for (int f = 0; f < frames; ++f) {
+
+                    this->buff->at(c, f) = static_cast<sample_t>(0.25 * (c + 1));
+                }
+            }
+        }
+};
+
+}  // namespace
+
+TEST_CASE("OfflineRenderer Test", "[render]") {
+
+    // Size of the wave header we write:
+
+    const std::size_t header = 44;
+
+    SECTION("Config", "Ensures the render parameters are kept") {
+
+        OfflineRenderer render(4096);
+
+        REQUIRE(render.get_block_size() == 4096);
+        REQUIRE(render.get_bits_per_sample() == 16);
+        REQUIRE(!render.get_float());
+        REQUIRE(render.get_pool() == nullptr);
+
+        render.set_block_size(0);
+
+        REQUIRE(render.get_block_size() == 1);
+    }
+
+    SECTION("Serial", "Ensures jobs are rendered and trimmed to length") {
+
+        OfflineRenderer render(4096);
+
+        ConstModule mono(0.5);
+        ChannelSource stereo;
+
+        CharOStream out1;
+        CharOStream out2;
+
+        REQUIRE(render.add_job({&mono, &out1, 10000, 1, 48000}) == 0);
+        REQUIRE(render.add_job({&stereo, &out2, 5000, 2, 44100}) == 1);
+
+        const RenderReport report = render.run();
+
+        REQUIRE(report.jobs.size() == 2);
+        REQUIRE(report.jobs[0].frames == 10000);
+        REQUIRE(report.jobs[1].frames == 5000);
+        REQUIRE(report.jobs[0].duration == 10000.0 / 48000);
+        REQUIRE(report.duration() == report.jobs[0].duration + report.jobs[1].duration);
+        REQUIRE(report.realtime() > 0);
+        REQUIRE(report.jobs[0].realtime() > 0);
+
+        REQUIRE(out1.get_array().size() == header + 10000 * 2);
+        REQUIRE(out2.get_array().size() == header + 5000 * 2 * 2);
+
+        // Values should be written as 16 bit values:
+
+        auto value = [](CharOStream& out, std::size_t index) {
+            const auto& arr = out.get_array();
+            return static_cast<int16_t>(arr[header + index * 2] | (arr[header + index * 2 + 1] << 8));
+        };
+
+        REQUIRE(value(out1, 0) == 16384);
+        REQUIRE(value(out2, 0) == 8192);
+        REQUIRE(value(out2, 1) == 16384);
+        REQUIRE(value(out2, 9999) == 16384);
+    }
+
+    SECTION("Parallel", "Ensures parallel rendering matches serial rendering") {
+
+        const int jobs = 6;
+
+        std::array<SineOscillator, jobs> serial_oscs;
+        std::array<SineOscillator, jobs> parallel_oscs;
+
+        // Oscillators output a single channel:
+        std::array<CharOStream, jobs> serial_out;
+        std::array<CharOStream, jobs> parallel_out;
+
+        OfflineRenderer serial(1024);
+        OfflineRenderer parallel(1024);
+
+        WorkerPool pool(3);
+
+        parallel.set_pool(&pool);
+        serial.set_float(true);
+        parallel.set_float(true);
+
+        for (int i = 0; i < jobs; ++i) {
+
+            serial_oscs[i].set_frequency(100.0 * (i + 1));
+            parallel_oscs[i].set_frequency(100.0 * (i + 1));
+
+            serial.add_job({&serial_oscs[i], &serial_out[i], 3000 + i * 100});
+            parallel.add_job({&parallel_oscs[i], &parallel_out[i], 3000 + i * 100});
+        }
+
+        const RenderReport sreport = serial.run();
+        const RenderReport preport = parallel.run();
+
+        for (int i = 0; i < jobs; ++i) {
+
+            REQUIRE(preport.jobs[i].frames == sreport.jobs[i].frames);
+            REQUIRE(parallel_out[i].get_array() == serial_out[i].get_array());
+            REQUIRE(parallel_out[i].get_array().size() == header + static_cast<std::size_t>(3000 + i * 100) * 4);
+        }
+    }
+}
@@ -0,0 +1,87 @@
+/**
+ * @file resample_module_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for resample modules
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "resample_module.hpp"
+#include "fund_oscillator.hpp"
+#include "sink_module.hpp"
+
+#include <cmath>
+#include <vector>
+
+TEST_CASE("ResampleModule Test", "[resample]") {
+
+    SineOscillator osc(1000);
+    ResampleModule resamp;
+    PeriodSink sink;
+
+    resamp.bind(&osc);
+    sink.bind(&resamp);
+
+    resamp.set_input_rate(44100);
+
+    sink.get_chain_info()->sample_rate = 48000;
+
+    sink.meta_info_sync();
+
+    SECTION("Config", "Ensures rates are configured correctly") {
+
+        REQUIRE(resamp.get_input_rate() == 44100);
+        REQUIRE(resamp.get_output_rate() == 48000);
+        REQUIRE(osc.get_info()->sample_rate == 44100);
+
+        resamp.set_taps(31);
+
+        REQUIRE(resamp.get_taps() == 32);
+        REQUIRE(resamp.latency() == 16);
+
+        resamp.set_phases(128);
+
+        REQUIRE(resamp.get_phases() == 128);
+
+        std::vector<AudioModule*> inputs;
+
+        REQUIRE(!resamp.plan_inputs(inputs));
+        REQUIRE(inputs.empty());
+    }
+
+    SECTION("Convert", "Ensures a sine is converted to the output rate") {
+
+        resamp.meta_start();
+
+        std::vector<sample_t> out;
+
+        for (int i = 0; i < 10; ++i) {
+
+            resamp.meta_process();
+
+            auto buff = resamp.get_buffer();
+
+            REQUIRE(buff->get_samplerate() == 48000);
+            REQUIRE(buff->channel_capacity() == resamp.get_info()->out_buffer);
+
+            out.insert(out.end(), buff->data(), buff->data() + buff->size());
+        }
+
+        REQUIRE_THAT(resamp.get_ratio(), Catch::Matchers::WithinAbs(48000.0 / 44100.0, 1e-9));
+
+        // Skip the start, where the filter sees the sine starting:
+
+        for (std::size_t i = 100; i < out.size(); ++i) {
+
+            const double expected = std::sin(2 * M_PI * 1000 * static_cast<double>(i) / 48000);
+
+            REQUIRE_THAT(out.at(i), Catch::Matchers::WithinAbs(expected, 1e-3));
+        }
+    }
+}
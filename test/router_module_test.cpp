@@ -0,0 +1,194 @@
+/**
+ * @file router_module_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for the channel router
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "router_module.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cmath>
+#include <memory>
+
+#include "meta_audio.hpp"
+#include "sink_module.hpp"
+
+namespace {
+
+/**
+ * @brief Creates a buffer with a different signal in each channel
+ *
+ * @param channels Number of channels
+ * @param size Number of samples in each channel
+ * @return std::unique_ptr<AudioBuffer> New buffer
+ */
+std::unique_ptr<AudioBuffer> route_input(int channels, int size) {
+
+    auto buff = std::make_unique<AudioBuffer>(size, channels);
+
+    for (int c = 0; c < channels; ++c) {
+
+        for (int i = 0; i < size; ++i) {
+
+            buff->at(c, i) = static_cast<sample_t>(std::sin((c * 5) + (i * 0.1)));
+        }
+    }
+
+    return buff;
+}
+
+/**
+ * @brief Routes a buffer through a router
+ *
+ * @param router Router to use
+ * @param input Buffer to route
+ * @return std::unique_ptr<AudioBuffer> Routed buffer
+ */
+std::unique_ptr<AudioBuffer> route(ChannelRouter& router, std::unique_ptr<AudioBuffer> input) {
+
+    router.set_buffer(std::move(input));
+    router.process();
+
+    return router.get_buffer();
+}
+
+/**
+ * @brief Ensures a router produced the product of its gains and the input
+ *
+ * @param router Router that produced the output
+ * @param input Buffer that was routed
+ * @param output Routed buffer
+ */
+void check_routes(const ChannelRouter& router, const AudioBuffer& input, const AudioBuffer& output) {
+
+    REQUIRE(static_cast<int>(output.channels()) == router.outputs());
+    REQUIRE(output.channel_capacity() == input.channel_capacity());
+
+    for (int o = 0; o < router.outputs(); ++o) {
+
+        for (int i = 0; i < static_cast<int>(input.channel_capacity()); ++i) {
+
+            sample_t expected = 0;
+
+            for (int c = 0; c < std::min(router.inputs(), static_cast<int>(input.channels())); ++c) {
+
+                expected += router.get_gain(o, c) * input.at(c, i);
+            }
+
+            REQUIRE_THAT(output.at(o, i), Catch::Matchers::WithinAbs(expected, 1e-5));
+        }
+    }
+}
+
+}  // namespace
+
+TEST_CASE("ChannelRouter Test", "[router]") {
+
+    SECTION("Default Values", "Ensures the constructor has proper default values") {
+
+        ChannelRouter router;
+
+        REQUIRE(router.inputs() == 1);
+        REQUIRE(router.outputs() == 1);
+        REQUIRE(router.get_gain(0, 0) == 1);
+
+        ChannelRouter sized(6, 2);
+
+        REQUIRE(sized.inputs() == 6);
+        REQUIRE(sized.outputs() == 2);
+        REQUIRE(sized.get_routes().empty());
+    }
+
+    SECTION("Downmix", "Ensures sparse matrices are applied correctly") {
+
+        // L, R, C to stereo:
+
+        ChannelRouter router(3, 2);
+
+        router.set_gain(0, 0, 1);
+        router.set_gain(1, 1, 1);
+        router.set_gain(0, 2, 0.707);
+        router.set_gain(1, 2, 0.707);
+
+        REQUIRE(router.get_routes().size() == 4);
+        REQUIRE(router.is_sparse() == false);
+
+        router.set_gain(1, 2, 0);
+
+        REQUIRE(router.get_routes().size() == 3);
+        REQUIRE(router.is_sparse());
+
+        auto input = route_input(3, 100);
+        auto copy = std::make_unique<AudioBuffer>(*input);
+
+        auto output = route(router, std::move(input));
+
+        check_routes(router, *copy, *output);
+    }
+
+    SECTION("Dense", "Ensures dense matrices are applied correctly") {
+
+        ChannelRouter router(16, 12);
+
+        for (int o = 0; o < 12; ++o) {
+
+            for (int i = 0; i < 16; ++i) {
+
+                router.set_gain(o, i, static_cast<sample_t>(std::cos(o + (i * 3))));
+            }
+        }
+
+        REQUIRE(router.is_sparse() == false);
+
+        auto input = route_input(16, 300);
+        auto copy = std::make_unique<AudioBuffer>(*input);
+
+        auto output = route(router, std::move(input));
+
+        check_routes(router, *copy, *output);
+    }
+
+    SECTION("Missing", "Ensures missing input channels are silent") {
+
+        ChannelRouter router(4, 4);
+
+        router.set_identity();
+
+        REQUIRE(router.get_routes().size() == 4);
+
+        auto input = route_input(2, 50);
+        auto copy = std::make_unique<AudioBuffer>(*input);
+
+        auto output = route(router, std::move(input));
+
+        check_routes(router, *copy, *output);
+
+        for (int i = 0; i < 50; ++i) {
+
+            REQUIRE(output->at(3, i) == 0);
+        }
+    }
+
+    SECTION("Info", "Ensures we ask for one channel per input") {
+
+        SinkModule sink;
+        ChannelRouter router(6, 2);
+        ConstModule source(1);
+
+        sink.get_chain_info()->channels = 2;
+
+        sink.bind(&router);
+        router.bind(&source);
+
+        sink.meta_info_sync();
+
+        REQUIRE(source.get_info()->channels == 6);
+    }
+}
@@ -11,9 +11,36 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "dsp/denormal.hpp"
 #include "sink_module.hpp"
 #include "meta_audio.hpp"
 
+namespace {
+
+/**
+ * @brief Module that takes a while to process
+ *
+ * We sleep for a set amount of time,
+ * and then pass the buffer along.
+ */
+class SlowModule : public AudioModule {
+
+    public:
+
+        /// Time to sleep for each block
+        std::chrono::nanoseconds delay{0};
+
+        void process() override { std::this_thread::sleep_for(this->delay); }
+
+        bool in_place() const override { return true; }
+};
+
+}  // namespace
+
 TEST_CASE("SinkModule Test", "[sink]") {
 
     // Create a SinkModule:
@@ -50,6 +77,41 @@ TEST_CASE("SinkModule Test", "[sink]") {
         
         REQUIRE(sink.get_chain_info() != nullptr);
     }
+
+#if defined(__x86_64__) || defined(__i386__) || defined(__aarch64__)
+
+    SECTION("Denormals", "Ensures denormals are flushed while the chain runs") {
+
+        ConstModule cnst;
+
+        sink.bind(&cnst);
+
+        const bool before = set_flush_to_zero(false);
+
+        REQUIRE(sink.get_chain_info()->flush_denormals);
+
+        sink.meta_start();
+
+        REQUIRE(flush_to_zero());
+
+        sink.meta_stop();
+
+        REQUIRE(!flush_to_zero());
+
+        // Chains may keep denormals:
+
+        sink.get_chain_info()->flush_denormals = false;
+
+        sink.meta_start();
+
+        REQUIRE(!flush_to_zero());
+
+        sink.meta_stop();
+
+        set_flush_to_zero(before);
+    }
+
+#endif
 }
 
 TEST_CASE("PeriodSink", "[sink]") {
@@ -115,4 +177,108 @@ TEST_CASE("PeriodSink", "[sink]") {
         REQUIRE(count.samples() == info->out_buffer * sink.get_period());
         REQUIRE(count.processed() == sink.get_period());
     }
+
+    SECTION("Frames", "Ensures blocks follow the requested frame count") {
+
+        ConstModule oconst(5);
+        Counter count;
+
+        sink.bind(&count)->bind(&oconst);
+
+        // Declare the largest block before syncing:
+
+        auto* chain = sink.get_chain_info();
+
+        chain->buffer_size = 128;
+        chain->max_buffer = 512;
+
+        sink.meta_info_sync();
+
+        REQUIRE(chain->pool.get_capacity() == 512);
+
+        // Full blocks by default:
+
+        sink.meta_process();
+
+        REQUIRE(count.samples() == 128);
+        REQUIRE(chain->sample == 128);
+
+        // Warm up the pool with the largest block:
+
+        sink.set_frames(512);
+        sink.meta_process();
+
+        const int allocs = chain->pool.allocations();
+
+        const std::vector<int> sizes = {32, 512, 7, 300, 1000, 0};
+        const std::vector<int> expected = {32, 512, 7, 300, 512, 128};
+
+        int64_t time = chain->sample;
+
+        for (std::size_t i = 0; i < sizes.size(); ++i) {
+
+            count.reset();
+
+            sink.set_frames(sizes[i]);
+            sink.meta_process();
+
+            time += expected[i];
+
+            REQUIRE(count.samples() == expected[i]);
+            REQUIRE(chain->sample == time);
+        }
+
+        REQUIRE(chain->pool.allocations() == allocs);
+    }
+
+    SECTION("Load", "Ensures the DSP load and deadline misses are measured") {
+
+        ConstModule oconst(5);
+        SlowModule slow;
+
+        sink.bind(&slow)->bind(&oconst);
+
+        sink.meta_info_sync();
+
+        // Determine the duration of a block:
+
+        const auto* info = sink.get_info();
+        const auto duration = std::chrono::nanoseconds(static_cast<int64_t>(1e9 * info->in_buffer / info->sample_rate));
+
+        // Fast blocks should not miss:
+
+        sink.meta_process();
+
+        REQUIRE(sink.get_blocks() == 1);
+        REQUIRE(sink.get_misses() == 0);
+        REQUIRE(sink.get_load() < 1);
+
+        // Slow blocks should miss, and invoke the callback:
+
+        int called = 0;
+        double reported = 0;
+
+        sink.set_overload([&called, &reported](PeriodSink& /*sink*/, double load) {
+            ++called;
+            reported = load;
+        });
+
+        slow.delay = duration * 2;
+
+        sink.meta_process();
+
+        REQUIRE(sink.get_blocks() == 2);
+        REQUIRE(sink.get_misses() == 1);
+        REQUIRE(sink.get_load() > 1);
+        REQUIRE(sink.get_peak_load() == sink.get_load());
+        REQUIRE(sink.get_average_load() < sink.get_load());
+        REQUIRE(called == 1);
+        REQUIRE(reported == sink.get_load());
+
+        sink.reset_load();
+
+        REQUIRE(sink.get_blocks() == 0);
+        REQUIRE(sink.get_misses() == 0);
+        REQUIRE(sink.get_peak_load() == 0);
+    }
 }
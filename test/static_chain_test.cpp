@@ -0,0 +1,252 @@
+/**
+ * @file static_chain_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for chains fused at compile time
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <span>
+#include <vector>
+
+#include "amp_module.hpp"
+#include "dsp/denormal.hpp"
+#include "fund_oscillator.hpp"
+#include "sink_module.hpp"
+#include "static_chain.hpp"
+
+namespace {
+
+/**
+ * @brief Compares a fused chain against the same dynamic chain
+ *
+ * @tparam Osc Oscillator to use
+ */
+template <typename Osc>
+void compare_chain() {
+
+    // Dynamic chain:
+
+    Osc osc(440);
+    AmplitudeScale scale(0.5);
+    AmplitudeAdd add(0.25);
+    PeriodSink sink;
+
+    sink.bind(&add);
+    add.bind(&scale);
+    scale.bind(&osc);
+
+    sink.meta_info_sync();
+    sink.meta_start();
+
+    // Fused chain:
+
+    StaticChain<Osc, AmplitudeScale, AmplitudeAdd> chain;
+
+    chain.template get<0>().set_frequency(440);
+    chain.template get<1>().set_value(0.5);
+    chain.template get<2>().set_value(0.25);
+
+    for (int block = 0; block < 4; ++block) {
+
+        sink.meta_process();
+
+        auto buff = sink.get_buffer();
+
+        std::vector<sample_t> fused(buff->size());
+
+        chain.fill(fused.data(), static_cast<int>(fused.size()), buff->get_samplerate());
+
+        for (std::size_t i = 0; i < fused.size(); ++i) {
+
+            REQUIRE_THAT(fused.at(i), Catch::Matchers::WithinAbs(buff->at(static_cast<int>(i)), 1e-5));
+        }
+    }
+}
+
+/**
+ * @brief Compares a fused chain with a block size against one without
+ *
+ * @tparam Osc Oscillator to use
+ */
+template <typename Osc>
+void compare_block_chain() {
+
+    StaticChain<Osc, AmplitudeScale, AmplitudeAdd> chain;
+    StaticBlockChain<32, Osc, AmplitudeScale, AmplitudeAdd> block;
+
+    chain.template get<0>().set_frequency(440);
+    chain.template get<1>().set_value(0.5);
+    chain.template get<2>().set_value(0.25);
+
+    block.template get<0>().set_frequency(440);
+    block.template get<1>().set_value(0.5);
+    block.template get<2>().set_value(0.25);
+
+    // Use sizes that are and are not multiples of the block size:
+
+    for (const int size : {64, 100, 7, 25, 32, 90}) {
+
+        std::vector<sample_t> expected(size);
+        std::vector<sample_t> output(size);
+
+        chain.fill(expected.data(), size, SAMPLE_RATE);
+        block.fill(output.data(), size, SAMPLE_RATE);
+
+        for (int i = 0; i < size; ++i) {
+
+            REQUIRE_THAT(output.at(i), Catch::Matchers::WithinAbs(expected.at(i), 1e-5));
+        }
+    }
+}
+
+/**
+ * @brief Module that doubles its input, counting the blocks it is given
+ */
+struct BlockDoubler {
+
+    /// Number of blocks processed
+    int blocks = 0;
+
+    sample_t fused_tick(sample_t input) const { return 2 * input; }
+
+    template <std::size_t N>
+    void fused_block(std::span<sample_t, N> data) {
+
+        for (auto& val : data) {
+
+            val *= 2;
+        }
+
+        ++(this->blocks);
+    }
+};
+
+}  // namespace
+
+TEST_CASE("StaticChain Test", "[static][chain]") {
+
+    // Started sinks flush denormals, restore the mode of this thread once we are done:
+
+    const FlushToZeroScope ftz(flush_to_zero());
+
+    SECTION("Size", "Ensures the number of modules is correct") {
+
+        REQUIRE(StaticChain<SineOscillator, AmplitudeScale>::size() == 2);
+    }
+
+    SECTION("Sine", "Ensures a fused sine chain matches the dynamic chain") { compare_chain<SineOscillator>(); }
+
+    SECTION("Square", "Ensures a fused square chain matches the dynamic chain") { compare_chain<SquareOscillator>(); }
+
+    SECTION("Sawtooth", "Ensures a fused sawtooth chain matches the dynamic chain") { compare_chain<SawtoothOscillator>(); }
+
+    SECTION("Triangle", "Ensures a fused triangle chain matches the dynamic chain") { compare_chain<TriangleOscillator>(); }
+
+    SECTION("Bind", "Ensures a fused chain can be bound into a dynamic chain") {
+
+        StaticChain<SineOscillator, AmplitudeScale> chain;
+
+        chain.get<0>().set_frequency(440);
+        chain.get<1>().set_value(0);
+
+        PeriodSink sink;
+
+        sink.bind(&chain);
+
+        sink.meta_info_sync();
+        sink.meta_start();
+        sink.meta_process();
+
+        auto buff = sink.get_buffer();
+
+        REQUIRE(buff->size() > 0);
+
+        for (auto val : *buff) {
+
+            REQUIRE(val == 0);
+        }
+    }
+}
+
+TEST_CASE("StaticBlockChain Test", "[static][chain]") {
+
+    // Started sinks flush denormals, restore the mode of this thread once we are done:
+
+    const FlushToZeroScope ftz(flush_to_zero());
+
+    SECTION("Size", "Ensures the sizes are correct") {
+
+        REQUIRE(StaticBlockChain<64, SineOscillator, AmplitudeScale>::size() == 2);
+        REQUIRE(StaticBlockChain<64, SineOscillator, AmplitudeScale>::block_size() == 64);
+    }
+
+    SECTION("Sine", "Ensures a sine block chain matches the fused chain") { compare_block_chain<SineOscillator>(); }
+
+    SECTION("Square", "Ensures a square block chain matches the fused chain") { compare_block_chain<SquareOscillator>(); }
+
+    SECTION("Sawtooth", "Ensures a sawtooth block chain matches the fused chain") { compare_block_chain<SawtoothOscillator>(); }
+
+    SECTION("Triangle", "Ensures a triangle block chain matches the fused chain") { compare_block_chain<TriangleOscillator>(); }
+
+    SECTION("Block", "Ensures modules with a block interface are given whole blocks") {
+
+        StaticBlockChain<16, AmplitudeAdd, BlockDoubler> chain;
+
+        chain.get<0>().set_value(0.25);
+
+        StaticBuffer<sample_t, 16> out;
+
+        chain.fill_block(std::span<sample_t, 16>(out.data(), 16), SAMPLE_RATE);
+
+        REQUIRE(chain.get<1>().blocks == 1);
+
+        for (auto val : out) {
+
+            REQUIRE(val == static_cast<sample_t>(0.5));
+        }
+
+        // Partial blocks are generated whole:
+
+        std::vector<sample_t> partial(40);
+
+        chain.fill(partial.data(), static_cast<int>(partial.size()), SAMPLE_RATE);
+
+        REQUIRE(chain.get<1>().blocks == 4);
+
+        chain.fill(partial.data(), 8, SAMPLE_RATE);
+
+        REQUIRE(chain.get<1>().blocks == 4);
+    }
+
+    SECTION("Bind", "Ensures a block chain can be bound into a dynamic chain") {
+
+        StaticBlockChain<32, SineOscillator, AmplitudeScale> chain;
+
+        chain.get<0>().set_frequency(440);
+        chain.get<1>().set_value(0);
+
+        PeriodSink sink;
+
+        sink.bind(&chain);
+
+        sink.meta_info_sync();
+        sink.meta_start();
+        sink.meta_process();
+
+        auto buff = sink.get_buffer();
+
+        REQUIRE(buff->size() > 0);
+
+        for (auto val : *buff) {
+
+            REQUIRE(val == 0);
+        }
+    }
+}
@@ -0,0 +1,119 @@
+/**
+ * @file stft_module_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for STFT modules
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "stft_module.hpp"
+#include "fund_oscillator.hpp"
+#include "sink_module.hpp"
+
+#include <complex>
+#include <vector>
+
+TEST_CASE("STFTModule Test", "[stft]") {
+
+    SineOscillator osc(1000);
+    STFTModule stft(512, 128);
+    PeriodSink sink;
+
+    stft.bind(&osc);
+    sink.bind(&stft);
+
+    sink.meta_info_sync();
+
+    SECTION("Config", "Ensures the module is configured correctly") {
+
+        REQUIRE(stft.get_size() == 512);
+        REQUIRE(stft.get_hop() == 128);
+        REQUIRE(stft.bins() == 257);
+        REQUIRE(stft.latency() == 512);
+        REQUIRE(stft.get_info()->latency == 512);
+        REQUIRE(stft.in_place());
+
+        // Latency belongs to us alone:
+
+        REQUIRE(osc.get_info()->latency == 0);
+
+        stft.set_hop(1000);
+
+        REQUIRE(stft.get_hop() == 512);
+
+        stft.set_size(255);
+
+        REQUIRE(stft.get_size() == 256);
+        REQUIRE(stft.get_hop() == 256);
+        REQUIRE(stft.get_info()->latency == 256);
+    }
+
+    SECTION("Passthrough", "Ensures audio passes through delayed by the latency") {
+
+        SineOscillator ref(1000);
+        PeriodSink rsink;
+
+        rsink.bind(&ref);
+        rsink.meta_info_sync();
+
+        stft.meta_start();
+        ref.meta_start();
+
+        std::vector<sample_t> out;
+        std::vector<sample_t> expected;
+
+        for (int i = 0; i < 20; ++i) {
+
+            stft.meta_process();
+            ref.meta_process();
+
+            auto buff = stft.get_buffer();
+            auto rbuff = ref.get_buffer();
+
+            out.insert(out.end(), buff->data(), buff->data() + buff->size());
+            expected.insert(expected.end(), rbuff->data(), rbuff->data() + rbuff->size());
+        }
+
+        for (std::size_t i = stft.latency(); i < out.size(); ++i) {
+
+            REQUIRE_THAT(out.at(i), Catch::Matchers::WithinAbs(expected.at(i - stft.latency()), 1e-5));
+        }
+    }
+
+    SECTION("Callback", "Ensures the callback sees every frame") {
+
+        int frames = 0;
+
+        stft.set_callback([&frames](std::span<std::complex<sample_t>> spectrum, int channel) {
+
+            REQUIRE(spectrum.size() == 257);
+            REQUIRE(channel == 0);
+
+            ++frames;
+
+            std::ranges::fill(spectrum, 0);
+        });
+
+        stft.meta_start();
+
+        for (int i = 0; i < 4; ++i) {
+
+            stft.meta_process();
+
+            auto buff = stft.get_buffer();
+
+            for (const sample_t val : buff->span()) {
+
+                REQUIRE_THAT(val, Catch::Matchers::WithinAbs(0, 1e-6));
+            }
+        }
+
+        REQUIRE(frames == 4 * stft.get_info()->out_buffer / 128);
+    }
+}
@@ -0,0 +1,131 @@
+/**
+ * @file thread_bridge_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for thread bridges
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "thread_bridge.hpp"
+#include "meta_audio.hpp"
+#include "sink_module.hpp"
+
+#include <vector>
+
+TEST_CASE("ThreadBridge Test", "[bridge][thread]") {
+
+    ConstModule osc(0.5);
+    Counter count;
+    ThreadBridge bridge;
+    PeriodSink sink;
+
+    count.bind(&osc);
+    bridge.bind(&count);
+    sink.bind(&bridge);
+
+    sink.meta_info_sync();
+
+    SECTION("Chain", "Ensures the sub-chain uses the bridge chain") {
+
+        REQUIRE(bridge.get_chain_info() == sink.get_chain_info());
+        REQUIRE(osc.get_chain_info() == bridge.get_bridge_chain());
+        REQUIRE(count.get_chain_info() == bridge.get_bridge_chain());
+
+        std::vector<AudioModule*> inputs;
+
+        REQUIRE(!bridge.plan_inputs(inputs));
+        REQUIRE(inputs.empty());
+    }
+
+    SECTION("Inline", "Ensures we process directly when not started") {
+
+        REQUIRE(!bridge.threaded());
+        REQUIRE(bridge.latency() == 0);
+
+        bridge.meta_process();
+
+        auto buff = bridge.get_buffer();
+
+        for (auto val : *buff) {
+
+            REQUIRE_THAT(val, Catch::Matchers::WithinAbs(0.5, 0.0001));
+        }
+
+        REQUIRE(count.processed() == 1);
+    }
+
+    SECTION("Threaded", "Ensures blocks are one block late when threaded") {
+
+        bridge.meta_start();
+
+        REQUIRE(bridge.threaded());
+        REQUIRE(bridge.latency() == bridge.get_info()->out_buffer);
+
+        // First block is silence:
+
+        bridge.meta_process();
+
+        auto first = bridge.get_buffer();
+
+        for (auto val : *first) {
+
+            REQUIRE(val == 0);
+        }
+
+        // Following blocks are rendered by the worker:
+
+        for (int i = 0; i < 20; ++i) {
+
+            bridge.meta_process();
+
+            auto buff = bridge.get_buffer();
+
+            for (auto val : *buff) {
+
+                REQUIRE_THAT(val, Catch::Matchers::WithinAbs(0.5, 0.0001));
+            }
+        }
+
+        bridge.meta_stop();
+
+        REQUIRE(!bridge.threaded());
+
+        // One block was still requested when we stopped:
+
+        REQUIRE((count.processed() == 20 || count.processed() == 21));
+        REQUIRE(bridge.get_bridge_chain()->sample == static_cast<int64_t>(count.processed()) * bridge.get_info()->out_buffer);
+    }
+
+    SECTION("Pool", "Ensures the worker does not allocate in the steady state") {
+
+        ChainInfo& chain = *sink.get_chain_info();
+
+        bridge.meta_start();
+
+        for (int i = 0; i < 5; ++i) {
+
+            bridge.meta_process();
+            bridge.release_buffer();
+        }
+
+        const int allocs = bridge.get_bridge_chain()->pool.allocations();
+        const int main_allocs = chain.pool.allocations();
+
+        for (int i = 0; i < 50; ++i) {
+
+            bridge.meta_process();
+            bridge.release_buffer();
+        }
+
+        bridge.meta_stop();
+
+        REQUIRE(bridge.get_bridge_chain()->pool.allocations() == allocs);
+        REQUIRE(chain.pool.allocations() == main_allocs);
+    }
+}
@@ -0,0 +1,161 @@
+/**
+ * @file trace_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for tracing components
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "trace.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <thread>
+
+#include "meta_audio.hpp"
+#include "sink_module.hpp"
+
+TEST_CASE("TraceRing Test", "[trace]") {
+
+    TraceRing ring(5, 1);
+
+    SECTION("Capacity", "Ensures the capacity is rounded up to a power of two") {
+
+        REQUIRE(ring.capacity() == 8);
+        REQUIRE(ring.size() == 0);
+    }
+
+    SECTION("Push", "Ensures events are held in order") {
+
+        ring.push("a", "test", 1, TraceEvent::Phase::Begin);
+        ring.push("a", "test", 2, TraceEvent::Phase::End);
+
+        const auto events = ring.snapshot();
+
+        REQUIRE(events.size() == 2);
+        REQUIRE(std::string(events[0].name) == "a");
+        REQUIRE(events[0].time == 1);
+        REQUIRE(events[0].phase == TraceEvent::Phase::Begin);
+        REQUIRE(events[1].time == 2);
+        REQUIRE(events[1].phase == TraceEvent::Phase::End);
+    }
+
+    SECTION("Wrap", "Ensures the oldest events are overwritten") {
+
+        for (int i = 0; i < 20; ++i) {
+
+            ring.push("a", "test", i, TraceEvent::Phase::Begin);
+        }
+
+        const auto events = ring.snapshot();
+
+        // The slot after the newest event may be in use by the writer, so it is dropped:
+
+        REQUIRE(events.size() == 7);
+        REQUIRE(events.front().time == 13);
+        REQUIRE(events.back().time == 19);
+    }
+
+    SECTION("Clear", "Ensures cleared events are forgotten") {
+
+        ring.push("a", "test", 1, TraceEvent::Phase::Begin);
+
+        ring.clear();
+
+        REQUIRE(ring.size() == 0);
+        REQUIRE(ring.snapshot().empty());
+
+        ring.push("b", "test", 2, TraceEvent::Phase::Begin);
+
+        REQUIRE(ring.snapshot().size() == 1);
+    }
+}
+
+TEST_CASE("Chrome Trace Test", "[trace]") {
+
+    clear_trace();
+
+    SECTION("Scope", "Ensures scopes record balanced events") {
+
+        {
+            const TraceScope outer("test", "outer");
+            const TraceScope inner("test", "inner");
+        }
+
+        const std::string json = chrome_trace();
+
+        REQUIRE(json.starts_with("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+        REQUIRE(json.find("\"name\":\"outer\",\"cat\":\"test\",\"ph\":\"B\"") != std::string::npos);
+        REQUIRE(json.find("\"name\":\"inner\",\"cat\":\"test\",\"ph\":\"E\"") != std::string::npos);
+    }
+
+    SECTION("Disabled", "Ensures nothing is recorded when tracing is off") {
+
+        set_tracing(false);
+
+        {
+            const TraceScope scope("test", "hidden");
+        }
+
+        set_tracing(true);
+
+        REQUIRE(chrome_trace().find("hidden") == std::string::npos);
+    }
+
+    SECTION("Unbalanced", "Ensures events that can't be paired are dropped") {
+
+        TraceRing& ring = thread_trace_ring();
+
+        ring.push("orphan", "test", 1, TraceEvent::Phase::End);
+        ring.push("open", "test", 2, TraceEvent::Phase::Begin);
+
+        const std::string json = chrome_trace();
+
+        REQUIRE(json.find("orphan") == std::string::npos);
+        REQUIRE(json.find("open") == std::string::npos);
+
+        ring.clear();
+    }
+
+    SECTION("Threads", "Ensures each thread has its own ring and name") {
+
+        std::thread thread([]() {
+
+            thread_trace_ring().set_name("helper");
+
+            const TraceScope scope("test", "threaded");
+        });
+
+        thread.join();
+
+        const std::string json = chrome_trace();
+
+        REQUIRE(json.find("\"args\":{\"name\":\"helper\"}") != std::string::npos);
+        REQUIRE(json.find("threaded") != std::string::npos);
+    }
+
+#ifdef MAEC_TRACE
+
+    SECTION("Chain", "Ensures rendering a chain records each module") {
+
+        PeriodSink sink;
+        ConstModule oconst(5);
+        Counter count;
+
+        sink.bind(&count)->bind(&oconst);
+
+        sink.meta_process();
+
+        const std::string json = chrome_trace();
+
+        REQUIRE(json.find("\"cat\":\"meta_process\"") != std::string::npos);
+        REQUIRE(json.find("\"name\":\"Counter\",\"cat\":\"process\"") != std::string::npos);
+    }
+
+#endif
+
+    clear_trace();
+}
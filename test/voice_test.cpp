@@ -0,0 +1,233 @@
+/**
+ * @file voice_test.cpp
+ * @author Owen Cochell (owencochell@gmail.com)
+ * @brief Tests for polyphonic voices
+ * @version 0.1
+ * @date 2026-10-14
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+
+#include "dsp/denormal.hpp"
+#include "sink_module.hpp"
+#include "voice.hpp"
+
+namespace {
+
+/**
+ * @brief Simple voice for testing
+ *
+ * We output a constant value,
+ * and finish a number of blocks after being released.
+ */
+class TestVoice : public SourceModule {
+
+    public:
+
+        /// Value to output
+        sample_t value = 1;
+
+        /// Number of blocks to play after release
+        int tail = 1;
+
+        /// Number of blocks left after release, -1 if not released
+        int left = -1;
+
+        /// Number of times we have been processed
+        int processed = 0;
+
+        void start() override {
+
+            SourceModule::start();
+
+            this->left = -1;
+        }
+
+        void finish() override {
+
+            BaseModule::finish();
+
+            this->left = this->tail;
+        }
+
+        void process() override {
+
+            ++(this->processed);
+
+            this->set_buffer(this->create_buffer());
+
+            std::fill(this->buff->ibegin(), this->buff->iend(), this->value);
+
+            if (this->left > 0 && --(this->left) == 0) {
+
+                this->done();
+            }
+        }
+};
+
+}  // namespace
+
+TEST_CASE("VoiceManager Test", "[voice]") {
+
+    // Started sinks flush denormals, restore the mode of this thread once we are done:
+
+    const FlushToZeroScope ftz(flush_to_zero());
+
+    std::array<TestVoice, 4> voices;
+
+    VoiceManager manager;
+    PeriodSink sink;
+
+    for (auto& voice : voices) {
+
+        manager.add_voice(&voice);
+    }
+
+    sink.bind(&manager);
+
+    sink.meta_info_sync();
+    sink.meta_start();
+
+    SECTION("Idle", "Ensures idle voices are not processed") {
+
+        sink.meta_process();
+
+        auto buff = sink.get_buffer();
+
+        for (auto val : *buff) {
+
+            REQUIRE(val == 0);
+        }
+
+        for (auto& voice : voices) {
+
+            REQUIRE(voice.processed == 0);
+        }
+    }
+
+    SECTION("Mix", "Ensures active voices are mixed together") {
+
+        manager.note_on(60);
+        manager.note_on(64);
+
+        REQUIRE(manager.active_voices() == 2);
+
+        sink.meta_process();
+
+        auto buff = sink.get_buffer();
+
+        for (auto val : *buff) {
+
+            REQUIRE(val == 2);
+        }
+
+        REQUIRE(voices.at(0).processed == 1);
+        REQUIRE(voices.at(1).processed == 1);
+        REQUIRE(voices.at(2).processed == 0);
+    }
+
+    SECTION("Release", "Ensures finished voices are no longer processed") {
+
+        manager.note_on(60);
+
+        sink.meta_process();
+
+        manager.note_off(60);
+
+        // Voice plays out its tail:
+
+        sink.meta_process();
+
+        REQUIRE(manager.active_voices() == 0);
+
+        sink.meta_process();
+        sink.meta_process();
+
+        REQUIRE(voices.at(0).processed == 2);
+
+        // The chain we are a part of should not be affected:
+
+        REQUIRE(sink.get_chain_info()->module_finish == 0);
+    }
+
+    SECTION("Steal Oldest", "Ensures the oldest voice is stolen") {
+
+        for (int i = 0; i < 4; ++i) {
+
+            manager.note_on(60 + i);
+        }
+
+        Voice* voice = manager.note_on(70);
+
+        REQUIRE(voice == &manager.get_voice(0));
+        REQUIRE(voice->note == 70);
+        REQUIRE(manager.stolen_voices() == 1);
+    }
+
+    SECTION("Steal Quietest", "Ensures the quietest voice is stolen") {
+
+        manager.set_steal_mode(VoiceManager::StealMode::Quietest);
+        manager.set_trigger([](Voice& voice, int /*note*/, double velocity) {
+            dynamic_cast<TestVoice*>(voice.output)->value = static_cast<sample_t>(velocity);
+        });
+
+        manager.note_on(60, 1);
+        manager.note_on(61, 0.5);
+        manager.note_on(62, 0.25);
+        manager.note_on(63, 0.75);
+
+        sink.meta_process();
+
+        Voice* voice = manager.note_on(70);
+
+        REQUIRE(voice == &manager.get_voice(2));
+    }
+
+    SECTION("Limit", "Ensures the voice limit is respected") {
+
+        manager.set_voice_limit(2);
+
+        manager.note_on(60);
+        manager.note_on(61);
+
+        Voice* voice = manager.note_on(62);
+
+        REQUIRE(voice == &manager.get_voice(0));
+        REQUIRE(manager.active_voices() == 2);
+        REQUIRE(manager.stolen_voices() == 1);
+    }
+
+    SECTION("Shed", "Ensures voices are shed when the chain overloads") {
+
+        for (int i = 0; i < 4; ++i) {
+
+            manager.note_on(60 + i);
+        }
+
+        // Released voices should go first:
+
+        manager.note_off(62);
+
+        REQUIRE(manager.shed_voices(1) == 1);
+        REQUIRE(!manager.get_voice(2).active);
+        REQUIRE(manager.active_voices() == 3);
+
+        // Shed a voice every block:
+
+        sink.set_overload([&manager](PeriodSink& /*sink*/, double /*load*/) { manager.shed_voices(1); }, 0);
+
+        sink.meta_process();
+
+        REQUIRE(manager.active_voices() == 2);
+        REQUIRE(!manager.get_voice(0).active);
+
+        REQUIRE(manager.shed_voices(5) == 2);
+        REQUIRE(manager.stolen_voices() == 4);
+    }
+}